@@ -23,6 +23,7 @@ package org.opendavinci.generator
 import java.util.ArrayList
 import java.util.HashMap
 import java.util.Iterator
+import java.util.TreeMap
 import org.eclipse.emf.ecore.resource.Resource
 import org.eclipse.xtext.generator.IFileSystemAccess
 import org.eclipse.xtext.generator.IGenerator
@@ -76,15 +77,28 @@ class CANDataModelGenerator implements IGenerator {
 			includedClasses.add(messageMapping.mappingName.toString().replaceAll("\\.", "/"))
 		}
 		
+		// Dispatch table: CAN identifier --> members of CanMapping that need this CAN message.
+		val dispatchTable = new TreeMap<Long, ArrayList<String>>
+		for (messageMapping : resource.allContents.toIterable.filter(typeof(CANMessageMapping))) {
+			val className = messageMapping.mappingName.toString().split('\\.').last
+			for (id : collectCANIDs(messageMapping, mapOfDefinedCANMessages)) {
+				val key = Long.decode(id)
+				if (!dispatchTable.containsKey(key)) {
+					dispatchTable.put(key, new ArrayList<String>)
+				}
+				dispatchTable.get(key).add("m_" + className.toFirstLower)
+			}
+		}
+
 		fsa.generateFile("include/GeneratedHeaders_" + generatedHeadersFile + ".h", generateSuperHeaderFileContent(generatedHeadersFile, includedClasses, odvdIncludedFiles))
-		fsa.generateFile("src/GeneratedHeaders_" + generatedHeadersFile + ".cpp", generateSuperImplementationFileContent(generatedHeadersFile, includedClasses))
+		fsa.generateFile("src/GeneratedHeaders_" + generatedHeadersFile + ".cpp", generateSuperImplementationFileContent(generatedHeadersFile, includedClasses, dispatchTable))
 		
 		var ArrayList<CANMessageTesting> tests=new ArrayList<CANMessageTesting>(resource.allContents.toIterable.filter(typeof(CANMessageTesting)).toList);
 		
 		// Next, generate the code for the actual mapping.
 		for (messageMapping : resource.allContents.toIterable.filter(typeof(CANMessageMapping))) {
 			fsa.generateFile("include/generated/" + messageMapping.mappingName.toString().replaceAll("\\.", "/") + ".h", 
-			    generateHeaderFileContent(generatedHeadersFile, odvdIncludedFiles, messageMapping))
+			    generateHeaderFileContent(generatedHeadersFile, odvdIncludedFiles, messageMapping, mapOfDefinedCANMessages))
 			fsa.generateFile("src/generated/" + messageMapping.mappingName.toString().replaceAll("\\.", "/") + ".cpp", 
 				generateImplementationFileContent(messageMapping, "generated", mapOfDefinedCANMessages))
 			fsa.generateFile("testsuites/" + messageMapping.mappingName.toString().replaceAll("\\.", "_") + "TestSuite.h", 
@@ -146,6 +160,28 @@ class CANDataModelGenerator implements IGenerator {
 	    return null
 	}
 
+	/* This method collects the CAN identifiers needed by a mapping in the order of its signals. */
+	def collectCANIDs(CANMessageMapping mapping, HashMap<String, CANMessageDescription> canMessages) {
+		val canIDs = new ArrayList<String>
+		for (currentMapping : mapping.signalMappings) {
+			val canSignal = findSignal(canMessages, currentMapping.cansignalname)
+			if (canSignal != null && slotOf(canIDs, canSignal.m_CANID) < 0) {
+				canIDs.add(canSignal.m_CANID)
+			}
+		}
+		return canIDs
+	}
+
+	/* This method returns the payload slot of a CAN identifier within the needed CAN identifiers. */
+	def slotOf(ArrayList<String> canIDs, String canID) {
+		for (var int i = 0; i < canIDs.size; i++) {
+			if (canIDs.get(i).compareToIgnoreCase(canID) == 0) {
+				return i
+			}
+		}
+		return -1
+	}
+
 	/* This method collects the name of the needed odvd headers. */
 	def extractOdvdHeaders(Iterable<ODVDFile> iter) {
 		val odvdHeaders =  new ArrayList<String>
@@ -225,6 +261,14 @@ namespace canmapping {
              */
             vector<odcore::data::Container> mapNext(const ::automotive::GenericCANMessage &gcm);
 
+            /**
+             * This method returns the identifiers of all CAN messages that
+             * are needed by the mappings (e.g. to configure CAN filters).
+             *
+             * @return CAN identifiers.
+             */
+            static vector<uint64_t> getIdentifiers();
+
         private:
         
 			«FOR include : includedClasses»
@@ -236,11 +280,20 @@ namespace canmapping {
 
 } // canmapping
 
+/**
+ * This function returns the identifiers of all CAN messages that are
+ * needed by the mappings when this library is loaded dynamically
+ * (e.g. by odcanproxy to configure its CAN filter).
+ *
+ * @param identifiers CAN identifiers.
+ */
+extern "C" void getCanMappingIdentifiers(std::vector<uint64_t> &identifiers);
+
 #endif /*GENERATEDHEADERS_«generatedHeadersFile.toUpperCase()»_H_*/
 '''
 
     /* This method generates the super implementation file content. */
-	def generateSuperImplementationFileContent(String generatedHeadersFile, ArrayList<String> includedClasses) '''
+	def generateSuperImplementationFileContent(String generatedHeadersFile, ArrayList<String> includedClasses, TreeMap<Long, ArrayList<String>> dispatchTable) '''
 /*
  * This software is open source. Please see COPYING and AUTHORS for further information.
  *
@@ -278,25 +331,46 @@ namespace canmapping {
     vector<odcore::data::Container> CanMapping::mapNext(const ::automotive::GenericCANMessage &gcm) {
         vector<odcore::data::Container> listOfContainers;
 
-        // Traverse all defined mappings and check whether a new high-level message could be fully decoded.
-	    «FOR member:members»
-	    {
-	    	odcore::data::Container container = «member.substring(0,member.indexOf(" ()"))».decode(gcm);
-	    	if (container.getDataType() != odcore::data::Container::UNDEFINEDDATA)
-	    	{
-	    		listOfContainers.push_back(container);
-	    	}
-	    }
-	    «ENDFOR»
+        // Only traverse the mappings that need this CAN message and check whether a new high-level message could be fully decoded.
+        switch(gcm.getIdentifier())
+        {
+        «FOR entry : dispatchTable.entrySet»
+            case 0x«Long.toHexString(entry.key)» :
+            «FOR member : entry.value»
+            {
+                odcore::data::Container container = «member».decode(gcm);
+                if (container.getDataType() != odcore::data::Container::UNDEFINEDDATA)
+                {
+                    listOfContainers.push_back(container);
+                }
+            }
+            «ENDFOR»
+            break;
+
+        «ENDFOR»
+            default : break; // no mapping needs this CAN message
+        }
 
         return listOfContainers;
     }
 
+    vector<uint64_t> CanMapping::getIdentifiers() {
+        vector<uint64_t> identifiers;
+        «FOR entry : dispatchTable.entrySet»
+        identifiers.push_back(0x«Long.toHexString(entry.key)»);
+        «ENDFOR»
+        return identifiers;
+    }
+
 } // canmapping
+
+extern "C" void getCanMappingIdentifiers(std::vector<uint64_t> &identifiers) {
+    identifiers = canmapping::CanMapping::getIdentifiers();
+}
 '''
 
 // this method generates the header file body
-	def generateHeaderFileBody(String className, CANMessageMapping mapping) '''
+	def generateHeaderFileBody(String className, CANMessageMapping mapping, ArrayList<String> canIDs) '''
     using namespace std;
 
     class «className» : public odcore::data::SerializableData, public odcore::base::Visitable {
@@ -417,8 +491,11 @@ namespace canmapping {
         	double m_«capitalizedName.toFirstLower»;
         	«ENDFOR»
         	
-        	std::map<uint64_t,uint64_t> m_payloads;
-            std::map<uint64_t,uint8_t> m_lengths;
+        	// Payload slots for the needed CAN messages in the order of m_neededCanMessages.
+        	uint64_t m_payloads[«Math.max(1, canIDs.size)»];
+        	uint8_t m_lengths[«Math.max(1, canIDs.size)»];
+        	bool m_received[«Math.max(1, canIDs.size)»];
+        	uint32_t m_numberOfReceivedPayloads;
         	std::vector<uint64_t> m_neededCanMessages;
         	uint64_t m_index;
         	
@@ -428,18 +505,18 @@ namespace canmapping {
     
 	'''
 
-	def generateHeaderFileNSs(String[] namespaces, int i, CANMessageMapping mapping) '''
+	def generateHeaderFileNSs(String[] namespaces, int i, CANMessageMapping mapping, ArrayList<String> canIDs) '''
 	«IF namespaces.size>i+1»
 	namespace «namespaces.get(i)» {
-		«generateHeaderFileNSs(namespaces, i+1, mapping)»
+		«generateHeaderFileNSs(namespaces, i+1, mapping, canIDs)»
 	} // end of namespace "«namespaces.get(i)»"
 	«ELSE»
-	«generateHeaderFileBody(namespaces.get(i), mapping)»
+	«generateHeaderFileBody(namespaces.get(i), mapping, canIDs)»
 	«ENDIF»
 	'''
 
     /* This method generates the header file content. */
-	def generateHeaderFileContent(String generatedHeadersFile, ArrayList<String> odvdIncludedFiles, CANMessageMapping mapping) '''
+	def generateHeaderFileContent(String generatedHeadersFile, ArrayList<String> odvdIncludedFiles, CANMessageMapping mapping, HashMap<String, CANMessageDescription> canMessages) '''
 /*
  * This software is open source. Please see COPYING and AUTHORS for further information.
  *
@@ -457,6 +534,7 @@ namespace canmapping {
 #include <opendavinci/odcore/data/SerializableData.h>
 
 #include "odcantools/CANMessage.h"
+#include "odcantools/CANSignalDecoder.h"
 
 «FOR odvd : odvdIncludedFiles»
 «odvd»
@@ -464,10 +542,11 @@ namespace canmapping {
 
 namespace canmapping {
 	«var String[] classNames = mapping.mappingName.toString.split('\\.')»
+	«var ArrayList<String> canIDs = collectCANIDs(mapping, canMessages)»
 	«IF classNames.size>1»
-		«generateHeaderFileNSs(classNames, 0, mapping)»
+		«generateHeaderFileNSs(classNames, 0, mapping, canIDs)»
 	«ELSE»
-		«generateHeaderFileBody(classNames.get(0), mapping)»
+		«generateHeaderFileBody(classNames.get(0), mapping, canIDs)»
 	«ENDIF»
 } // end of namespace canmapping
 
@@ -511,7 +590,9 @@ namespace canmapping {
 		m_«capitalizedName.toFirstLower»(0.0),
 		«ENDFOR»
 		m_payloads(),
-        m_lengths(),
+		m_lengths(),
+		m_received(),
+		m_numberOfReceivedPayloads(0),
 		m_neededCanMessages(),
 		m_index(0),
 		«"m_"+mapping.mappingName.toFirstLower.replaceAll("\\.", "_")»()
@@ -546,7 +627,9 @@ namespace canmapping {
 		odcore::base::Visitable(),
 		«FOR initialization:initializations»«initialization+","+'\n'»«ENDFOR»
 		m_payloads(),
-	    m_lengths(),
+		m_lengths(),
+		m_received(),
+		m_numberOfReceivedPayloads(0),
 		m_neededCanMessages(),
 		m_index(0),
 		«"m_"+mapping.mappingName.toFirstLower.replaceAll("\\.", "_")»()
@@ -794,6 +877,7 @@ namespace canmapping {
 
 		bool reset=false;
 		«ENDIF»
+		int32_t slot=-1;
 		switch(gcm.getIdentifier())
 		{
     	«FOR id : canIDs /* multiple canIDs supported */»
@@ -801,17 +885,15 @@ namespace canmapping {
     		case «id» : 
     		«IF mapping.unordered!=null && mapping.unordered.compareTo("unordered")==0»
 
-	    	// since the order doesn't matter, store the payload in a map for future use replacing the current content held there
-	    	m_payloads[«id»] = gcm.getData();
-	    	m_lengths[«id»] = gcm.getLength();
+	    	// since the order doesn't matter, store the payload in its slot for future use replacing the current content held there
+	    	slot=«canIDs.indexOf(id)»;
     		«ELSE»
 
 	    	// since the order matters:
 	    	if(m_neededCanMessages.at(m_index) == «id») // if we got the expected message
 	    	{
-	    		// Store the payload in a map for future use replacing the current content
-	    	m_payloads[«id»] = gcm.getData();
-	    	m_lengths[«id»] = gcm.getLength();
+	    		// Store the payload in its slot for future use replacing the current content
+	    		slot=«canIDs.indexOf(id)»;
 	    		// modularly increase the internal index
 	    		(m_index==m_neededCanMessages.size()-1) ? m_index=0 : ++m_index;
 	    	}
@@ -828,27 +910,32 @@ namespace canmapping {
 
 		if(reset)
 		{		
-			// reset the payloads and lengths map
-			while(! m_payloads.empty())
-				m_payloads.erase(m_payloads.begin());
-		while(! m_lengths.empty())
-		    m_lengths.erase(m_lengths.begin());
+			// reset the received payloads
+			for(uint32_t i=0; i<«canIDs.size»; i++)
+				m_received[i]=false;
+			m_numberOfReceivedPayloads=0;
 			// reset the internal index
 			m_index=0;
 		}
 		«ENDIF»
+		if(slot>=0)
+		{
+			m_payloads[slot] = gcm.getData();
+			m_lengths[slot] = gcm.getLength();
+			if(!m_received[slot])
+			{
+				m_received[slot]=true;
+				++m_numberOfReceivedPayloads;
+			}
+		}
+
 		// if we don't have all the needed CAN messages, return 
-		if(m_payloads.size()!=m_neededCanMessages.size())
+		if(m_numberOfReceivedPayloads!=m_neededCanMessages.size())
 			return c;
 
 		// Create a generic message.
 		odcore::reflection::Message message;
 
-        «var String cmNamePrefix="CM_"»
-        «FOR id : canIDs /* multiple canIDs supported */»
-        ::automotive::odcantools::CANMessage «cmNamePrefix+id»(«id»,m_lengths[«id»],m_payloads[«id»]);
-        «ENDFOR»
-
 		«FOR currentSignalInMapping : mapping.signalMappings»
 			«var CANSignalDescription CurrentCANSignal=findSignal(canMessages,currentSignalInMapping.cansignalname)»
 			«IF CurrentCANSignal!=null /*if the signal exists*/»
@@ -863,20 +950,11 @@ namespace canmapping {
 
 			// addressing signal «currentSignalInMapping.cansignalname» : «currentSignalInMapping.signalIdentifier»
 			{
-				// Add the CAN signal to the CAN message
-                «IF CurrentCANSignal.m_signed.toLowerCase().compareTo("unsigned")==0» 
-                ::automotive::odcantools::Signedness sign=::automotive::odcantools::Signedness::UNSIGNED;
-                «ELSE»
-                ::automotive::odcantools::Signedness sign=::automotive::odcantools::Signedness::SIGNED;
-                «ENDIF»
-                «IF CurrentCANSignal.m_endian.toLowerCase().compareTo("big")==0» 
-                ::automotive::odcantools::Endianness endian=::automotive::odcantools::Endianness::BIG;
-                «ELSE»
-                ::automotive::odcantools::Endianness endian=::automotive::odcantools::Endianness::LITTLE;
-                «ENDIF»
-				::automotive::odcantools::CANSignal «currentSignalInMapping.cansignalname.replaceAll("\\.","_")»(«CurrentCANSignal.m_startBit»,«CurrentCANSignal.m_length»,sign,endian,«CurrentCANSignal.m_multiplyBy»,«CurrentCANSignal.m_add»,«CurrentCANSignal.m_rangeStart»,«CurrentCANSignal.m_rangeEnd»);
-                «cmNamePrefix+CurrentCANSignal.m_CANID».addSignal(«currentSignalInMapping.signalIdentifier»,«currentSignalInMapping.cansignalname.replaceAll("\\.","_")»);
-                «memberVarName»=«cmNamePrefix+CurrentCANSignal.m_CANID».decodeSignal(«currentSignalInMapping.signalIdentifier»);
+				// Extract the CAN signal from the payload of CAN message «CurrentCANSignal.m_CANID» using shifts and masks known at compile time.
+                «var int slot=slotOf(canIDs, CurrentCANSignal.m_CANID)»
+                «var String sign=if (CurrentCANSignal.m_signed.toLowerCase().compareTo("unsigned")==0) "UNSIGNED" else "SIGNED"»
+                «var String endian=if (CurrentCANSignal.m_endian.toLowerCase().compareTo("big")==0) "BIG" else "LITTLE"»
+                «memberVarName»=::automotive::odcantools::CANSignalDecoder<«CurrentCANSignal.m_startBit»,«CurrentCANSignal.m_length»,::automotive::odcantools::Signedness::«sign»,::automotive::odcantools::Endianness::«endian»>::decode(m_payloads[«slot»],m_lengths[«slot»],«CurrentCANSignal.m_multiplyBy»,«CurrentCANSignal.m_add»,«CurrentCANSignal.m_rangeStart»,«CurrentCANSignal.m_rangeEnd»);
 
 				// Create a field for a generic message.
 				odcore::reflection::Field<double> *f = new odcore::reflection::Field<double>(«memberVarName»);
@@ -0,0 +1,160 @@
+/**
+ * libodcantools - Library to wrap a CAN interface.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CANSIGNALDECODER_H_
+#define CANSIGNALDECODER_H_
+
+#include <stdint.h>
+
+#include "CANMessage.h"
+
+namespace automotive {
+    namespace odcantools {
+
+        /**
+         * This class provides helper functions to compute the layout of a
+         * CAN signal at compile time.
+         */
+        class CANSignalLayout {
+            public:
+                /**
+                 * @param length Length of the signal in bits.
+                 * @return Mask covering the signal's bits.
+                 */
+                static constexpr uint64_t mask(const uint32_t length) {
+                    return (length >= 64) ? ~static_cast<uint64_t>(0) : ((static_cast<uint64_t>(1) << (length % 64)) - 1);
+                }
+
+                /**
+                 * This method computes the position of the least significant
+                 * bit of a signal (counting from byte 0, bit 0) analogously to
+                 * CANMessage::getLSBPosition(...).
+                 *
+                 * @param startBit Start bit as specified in the .can file.
+                 * @param length Length of the signal in bits.
+                 * @param endianness Endianness of the signal.
+                 * @return Position of the least significant bit.
+                 */
+                static constexpr int32_t lsbPosition(const int32_t startBit, const int32_t length, const Endianness endianness) {
+                    // For "Motorola Forward MSB", the signal continues at the
+                    // previous bits of the same byte and then in the next byte.
+                    return (Endianness::LITTLE == endianness) ? startBit :
+                           ( ((startBit % 8) >= (length - 1)) ? (startBit - (length - 1)) :
+                             ( (startBit / 8 + ((length - 1 - (startBit % 8)) + 7) / 8) * 8
+                               + (startBit % 8) - (length - 1) + 8 * (((length - 1 - (startBit % 8)) + 7) / 8) ) );
+                }
+        };
+
+        /**
+         * This class decodes a CAN signal whose layout is known at compile
+         * time directly from the uint64_t payload of a GenericCANMessage
+         * using only shifts and masks. It yields the same values as
+         * CANMessage::decodeSignal(...) without creating a CANMessage and
+         * copying its payload into byte vectors.
+         *
+         * Example for a 16 bit unsigned little endian signal at bit 8:
+         *
+         * double v = CANSignalDecoder<8, 16, UNSIGNED, LITTLE>::decode(gcm.getData(), gcm.getLength(), 0.01, 0, 0, 0);
+         */
+        template<uint8_t START_BIT, uint8_t LENGTH, Signedness SIGNEDNESS, Endianness ENDIANNESS>
+        class CANSignalDecoder {
+            public:
+                static constexpr uint64_t MASK = CANSignalLayout::mask(LENGTH);
+                static constexpr int32_t LSB_POSITION = CANSignalLayout::lsbPosition(START_BIT, LENGTH, ENDIANNESS);
+
+                /**
+                 * This method extracts the raw value of the signal.
+                 *
+                 * @param data Payload as stored in GenericCANMessage.
+                 * @param length Number of payload bytes.
+                 * @return Raw value (sign-extended for signed signals).
+                 */
+                static inline int64_t extractRawSignal(const uint64_t &data, const uint8_t &length) {
+                    const uint32_t BYTES = (length > 8) ? 8 : length;
+                    // Payload limited to the given number of bytes; byte 0 is the most significant one.
+                    const uint64_t PAYLOAD = (0 == BYTES) ? 0 : (data & CANSignalLayout::mask(8 * BYTES));
+
+                    uint64_t value = 0;
+                    if (Endianness::LITTLE == ENDIANNESS) {
+                        // Reverse the byte order so that byte 0 becomes the least significant one.
+                        const uint64_t SWAPPED = (0 == BYTES) ? 0 : (swapBytes(PAYLOAD) >> (8 * (8 - BYTES)));
+                        value = (LSB_POSITION < 64) ? (SWAPPED >> (LSB_POSITION % 64)) : 0;
+                    }
+                    else {
+                        // Bit b of byte k is located at bit 8*(BYTES-1-k)+b of the payload.
+                        const int32_t SHIFT = 8 * (static_cast<int32_t>(BYTES) - 1 - LSB_POSITION / 8) + LSB_POSITION % 8;
+                        value = (SHIFT >= 0) ? ((SHIFT < 64) ? (PAYLOAD >> SHIFT) : 0)
+                                             : ((-SHIFT < 64) ? (PAYLOAD << -SHIFT) : 0);
+                    }
+                    value &= MASK;
+
+                    // If the signal is signed and its MSB equals 1, preserve the two's complement representation.
+                    if ( (Signedness::SIGNED == SIGNEDNESS) && (LENGTH > 0) && (0 != ((value >> ((LENGTH - 1) % 64)) & 0x1)) ) {
+                        value |= ~MASK;
+                    }
+                    return static_cast<int64_t>(value);
+                }
+
+                /**
+                 * This method decodes the signal.
+                 *
+                 * @param data Payload as stored in GenericCANMessage.
+                 * @param length Number of payload bytes.
+                 * @param factor Factor to be multiplied.
+                 * @param offset Offset to be added.
+                 * @param rangeB Lower range limit.
+                 * @param rangeE Upper range limit.
+                 * @return Decoded value.
+                 */
+                static inline double decode(const uint64_t &data, const uint8_t &length, const double &factor, const double &offset, const double &rangeB, const double &rangeE) {
+                    double signalValue = static_cast<double>(extractRawSignal(data, length));
+                    signalValue = (signalValue * factor) + offset;
+
+                    // If the range is [0,0], skip the range check.
+                    const double TOLERANCE = 1e-5;
+                    if (!(rangeB - rangeE < TOLERANCE && rangeB < TOLERANCE)) {
+                        if (signalValue < rangeB) {
+                            signalValue = rangeB;
+                        }
+                        else if (signalValue > rangeE) {
+                            signalValue = rangeE;
+                        }
+                    }
+                    return signalValue;
+                }
+
+            private:
+                static inline uint64_t swapBytes(const uint64_t &v) {
+                    return ((v & 0x00000000000000FFULL) << 56) | ((v & 0x000000000000FF00ULL) << 40) |
+                           ((v & 0x0000000000FF0000ULL) << 24) | ((v & 0x00000000FF000000ULL) << 8) |
+                           ((v & 0x000000FF00000000ULL) >> 8) | ((v & 0x0000FF0000000000ULL) >> 24) |
+                           ((v & 0x00FF000000000000ULL) >> 40) | ((v & 0xFF00000000000000ULL) >> 56);
+                }
+        };
+
+        template<uint8_t START_BIT, uint8_t LENGTH, Signedness SIGNEDNESS, Endianness ENDIANNESS>
+        constexpr uint64_t CANSignalDecoder<START_BIT, LENGTH, SIGNEDNESS, ENDIANNESS>::MASK;
+
+        template<uint8_t START_BIT, uint8_t LENGTH, Signedness SIGNEDNESS, Endianness ENDIANNESS>
+        constexpr int32_t CANSignalDecoder<START_BIT, LENGTH, SIGNEDNESS, ENDIANNESS>::LSB_POSITION;
+
+    }
+}
+
+#endif /* CANSIGNALDECODER_H_ */
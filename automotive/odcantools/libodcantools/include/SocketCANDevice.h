@@ -26,8 +26,10 @@
     #include <linux/can.h>
 #endif
 
+#include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <opendavinci/odcore/base/Mutex.h>
 
@@ -48,6 +50,12 @@ class GenericCANMessageListener;
          * socket represented by this class.
          */
         class SocketCANDevice : public CANDevice {
+           public:
+                enum {
+                    // Number of frames to be received or sent with one system call.
+                    MAX_FRAMES_PER_BATCH = 64,
+                };
+
            private:
                 /**
                  * "Forbidden" copy constructor. Goal: The compiler should warn
@@ -83,10 +91,50 @@ class GenericCANMessageListener;
 
                 virtual int write(const GenericCANMessage &gcm);
 
+                /**
+                 * This method writes several GenericCANMessages with as
+                 * few system calls as possible.
+                 *
+                 * @param gcms GenericCANMessages to write.
+                 * @return Error code (0 = no error).
+                 */
+                int write(const vector<GenericCANMessage> &gcms);
+
+                /**
+                 * This method configures the kernel to only pass CAN frames
+                 * with the given identifiers to this socket; frames with
+                 * other identifiers are discarded without waking up run().
+                 *
+                 * @param identifiers CAN identifiers to receive; all frames are received if empty.
+                 * @return true if the filter could be set.
+                 */
+                bool setFilter(const vector<uint64_t> &identifiers);
+
+                /**
+                 * @return true if CAN-FD frames are received from this socket.
+                 */
+                bool isCANFDEnabled() const;
+
+                /**
+                 * @return Number of received CAN-FD frames with more than 8 data
+                 *         bytes that cannot be represented as GenericCANMessage.
+                 */
+                uint64_t getNumberOfDroppedFrames() const;
+
                 virtual void beforeStop();
 
                 virtual void run();
 
+            private:
+                /**
+                 * This method sends the given GenericCANMessages in batches.
+                 *
+                 * @param gcms GenericCANMessages to send.
+                 * @param numberOfMessages Number of GenericCANMessages.
+                 * @return Error code (0 = no error).
+                 */
+                int send(const GenericCANMessage *gcms, const uint32_t &numberOfMessages);
+
             private:
                 string m_deviceNode;
 #ifdef __linux__
@@ -94,6 +142,8 @@ class GenericCANMessageListener;
 #endif
                 odcore::base::Mutex m_socketCANMutex;
                 int m_socketCAN;
+                bool m_canFD;
+                std::atomic<uint64_t> m_numberOfDroppedFrames;
                 GenericCANMessageListener &m_listener;
         };
 
@@ -22,10 +22,14 @@
 
 #ifdef __linux__
     #include <linux/if.h>
+    #include <linux/can/raw.h>
 #endif
 
 #include <cerrno>
 #include <cstring>
+#include <ctime>
+
+#include <algorithm>
 
 #include <iostream>
 #include <sstream>
@@ -55,6 +59,8 @@ namespace automotive {
             m_address(),
             m_socketCANMutex(),
             m_socketCAN(-1),
+            m_canFD(false),
+            m_numberOfDroppedFrames(0),
             m_listener(listener) {
             cerr << "[SocketCANDevice] Opening " << m_deviceNode << "... ";
 #ifdef __linux__
@@ -92,6 +98,15 @@ namespace automotive {
                 s << "[SocketCANDevice] Error while binding socket: " << strerror(errno);
                 throw s.str();
             }
+
+            // Let the kernel time stamp received frames with nanosecond resolution.
+            const int ENABLE = 1;
+            if (0 != setsockopt(m_socketCAN, SOL_SOCKET, SO_TIMESTAMPNS, &ENABLE, sizeof(ENABLE))) {
+                cerr << "(no kernel time stamps: " << strerror(errno) << ") ";
+            }
+
+            // Receive CAN-FD frames as well if supported by kernel and device.
+            m_canFD = (0 == setsockopt(m_socketCAN, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &ENABLE, sizeof(ENABLE)));
             cerr << "done." << endl;
 #else
             cerr << "failed (SocketCAN not available on this platform). ";
@@ -114,48 +129,125 @@ namespace automotive {
         }
 
         int SocketCANDevice::write(const GenericCANMessage &gcm) {
+            return send(&gcm, 1);
+        }
+
+        int SocketCANDevice::write(const vector<GenericCANMessage> &gcms) {
+            return (gcms.empty() ? 0 : send(&gcms[0], gcms.size()));
+        }
+
+        int SocketCANDevice::send(const GenericCANMessage *gcms, const uint32_t &numberOfMessages) {
             int errorCode = 0;
             Lock l(m_socketCANMutex);
 
 #ifndef __linux__
             // Avoid compilation error.
-            (void)gcm;
+            (void)gcms;
+            (void)numberOfMessages;
 #endif
 
             if (m_socketCAN > -1) {
 #ifdef __linux__
-                struct can_frame frame;
-
-                const uint8_t LENGTH = gcm.getLength();
-                frame.can_id = gcm.getIdentifier();
-                frame.can_dlc = LENGTH;
-                uint64_t data = gcm.getData();
-                for (uint8_t i = 0; i < LENGTH; i++) {
-                    frame.data[LENGTH-1-i] = (data & 0xFF);
-                    data = data >> 8;
+                struct can_frame frames[MAX_FRAMES_PER_BATCH];
+                struct iovec iovecs[MAX_FRAMES_PER_BATCH];
+                struct mmsghdr messages[MAX_FRAMES_PER_BATCH];
+
+                uint32_t sent = 0;
+                while ( (sent < numberOfMessages) && (0 == errorCode) ) {
+                    const uint32_t BATCH = std::min<uint32_t>(numberOfMessages - sent, MAX_FRAMES_PER_BATCH);
+                    memset(messages, 0, sizeof(struct mmsghdr) * BATCH);
+                    for (uint32_t i = 0; i < BATCH; i++) {
+                        const GenericCANMessage &gcm = gcms[sent + i];
+
+                        const uint8_t LENGTH = std::min<uint8_t>(gcm.getLength(), CAN_MAX_DLEN);
+                        memset(&frames[i], 0, sizeof(struct can_frame));
+                        frames[i].can_id = gcm.getIdentifier();
+                        frames[i].can_dlc = LENGTH;
+                        uint64_t data = gcm.getData();
+                        for (uint8_t j = 0; j < LENGTH; j++) {
+                            frames[i].data[LENGTH-1-j] = (data & 0xFF);
+                            data = data >> 8;
+                        }
+
+                        iovecs[i].iov_base = &frames[i];
+                        iovecs[i].iov_len = sizeof(struct can_frame);
+                        messages[i].msg_hdr.msg_iov = &iovecs[i];
+                        messages[i].msg_hdr.msg_iovlen = 1;
+                    }
+
+                    // Send all frames of this batch with one system call.
+                    const int32_t SENT = sendmmsg(m_socketCAN, messages, BATCH, 0);
+                    if (0 < SENT) {
+                        sent += SENT;
+                    }
+                    else if (EINTR != errno) {
+                        errorCode = errno;
+                        CLOG1 << "[SocketCANDevice] Writing " << BATCH << " frames failed, errorCode = " << errorCode << ", strerror(" << errno << "): '" << strerror(errno) << "'" << endl;
+                    }
                 }
-                int32_t nbytes = ::write(m_socketCAN, &frame, sizeof(struct can_frame));
-                if (0 < nbytes) {
-                    CLOG1 << "[SocketCANDevice] Writing ID = " << frame.can_id << ", LEN = " << +frame.can_dlc << ", nbytes = " << nbytes << endl;
+#endif
+            }
+            return errorCode;
+        }
+
+        bool SocketCANDevice::setFilter(const vector<uint64_t> &identifiers) {
+            bool retVal = false;
+
+#ifndef __linux__
+            // Avoid compilation error.
+            (void)identifiers;
+#endif
+
+            Lock l(m_socketCANMutex);
+            if (m_socketCAN > -1) {
+#ifdef __linux__
+                vector<struct can_filter> filters;
+                for (auto identifier : identifiers) {
+                    // Identifiers not fitting into 11 bits denote extended frames.
+                    const bool EXTENDED = ( (0 != (identifier & CAN_EFF_FLAG)) || (identifier > CAN_SFF_MASK) );
+
+                    struct can_filter filter;
+                    filter.can_id = EXTENDED ? ((identifier & CAN_EFF_MASK) | CAN_EFF_FLAG) : (identifier & CAN_SFF_MASK);
+                    filter.can_mask = CAN_EFF_FLAG | CAN_RTR_FLAG | (EXTENDED ? CAN_EFF_MASK : CAN_SFF_MASK);
+                    filters.push_back(filter);
                 }
-                else {
-                    CLOG1 << "[SocketCANDevice] Writing ID = " << frame.can_id << ", LEN = " << +frame.can_dlc << ", errorCode = " << errorCode << ", strerror(" << errno << "): '" << strerror(errno) << "'" << endl;
-                    errorCode = errno;
+
+                // An empty list of identifiers lets all frames pass.
+                if (filters.empty()) {
+                    struct can_filter filter;
+                    filter.can_id = 0;
+                    filter.can_mask = 0;
+                    filters.push_back(filter);
+                }
+
+                retVal = (0 == setsockopt(m_socketCAN, SOL_CAN_RAW, CAN_RAW_FILTER, &filters[0], sizeof(struct can_filter) * filters.size()));
+                if (!retVal) {
+                    cerr << "[SocketCANDevice] Error while setting filter for " << m_deviceNode << ": " << strerror(errno) << endl;
                 }
 #endif
             }
-            return errorCode;
+            return retVal;
+        }
+
+        bool SocketCANDevice::isCANFDEnabled() const {
+            return m_canFD;
+        }
+
+        uint64_t SocketCANDevice::getNumberOfDroppedFrames() const {
+            return m_numberOfDroppedFrames.load();
         }
 
         void SocketCANDevice::beforeStop() {}
 
         void SocketCANDevice::run() {
 #ifdef __linux__
-            struct can_frame frame;
+            // Buffers for a batch of frames including the control messages carrying the kernel time stamps.
+            struct canfd_frame frames[MAX_FRAMES_PER_BATCH];
+            struct iovec iovecs[MAX_FRAMES_PER_BATCH];
+            struct mmsghdr messages[MAX_FRAMES_PER_BATCH];
+            char controls[MAX_FRAMES_PER_BATCH][CMSG_SPACE(sizeof(struct timespec))];
             fd_set rfds;
             struct timeval timeout;
-            struct timeval socketTimeStamp;
-            int32_t nbytes = 0;
 #endif
 
             // serviceReady must be called in any case to avoid blocking of caller.
@@ -173,28 +265,53 @@ namespace automotive {
                     select(m_socketCAN + 1, &rfds, NULL, NULL, &timeout);
 
                     if (FD_ISSET(m_socketCAN, &rfds)) {
-                        nbytes = read(m_socketCAN, &frame, sizeof(struct can_frame));
-                        if ( (nbytes > 0) && (nbytes == sizeof(struct can_frame)) ) {
-                            // Get receiving time stamp.
-                            if (0 != ioctl(m_socketCAN, SIOCGSTAMP, &socketTimeStamp)) {
-                                // In case the ioctl failed, use traditional vsariant.
-                                const odcore::data::TimeStamp now;
-                                socketTimeStamp.tv_sec = now.getSeconds();
-                                socketTimeStamp.tv_usec = now.getMicroseconds();
+                        memset(messages, 0, sizeof(messages));
+                        for (uint32_t i = 0; i < MAX_FRAMES_PER_BATCH; i++) {
+                            iovecs[i].iov_base = &frames[i];
+                            iovecs[i].iov_len = sizeof(struct canfd_frame);
+                            messages[i].msg_hdr.msg_iov = &iovecs[i];
+                            messages[i].msg_hdr.msg_iovlen = 1;
+                            messages[i].msg_hdr.msg_control = controls[i];
+                            messages[i].msg_hdr.msg_controllen = sizeof(controls[i]);
+                        }
+
+                        // Receive all pending frames with one system call.
+                        const int32_t RECEIVED = recvmmsg(m_socketCAN, messages, MAX_FRAMES_PER_BATCH, MSG_DONTWAIT, NULL);
+
+                        // Time stamp to be used for frames without kernel time stamp.
+                        const odcore::data::TimeStamp now;
+
+                        for (int32_t i = 0; i < RECEIVED; i++) {
+                            const uint32_t SIZE = messages[i].msg_len;
+                            if ( (CAN_MTU != SIZE) && (CANFD_MTU != SIZE) ) {
+                                continue;
+                            }
+
+                            // GenericCANMessage can only carry up to 8 data bytes.
+                            if (frames[i].len > CAN_MAX_DLEN) {
+                                m_numberOfDroppedFrames++;
+                                continue;
+                            }
+
+                            // Get receiving time stamp from the kernel.
+                            odcore::data::TimeStamp received(now);
+                            for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&messages[i].msg_hdr); NULL != cmsg; cmsg = CMSG_NXTHDR(&messages[i].msg_hdr, cmsg)) {
+                                if ( (SOL_SOCKET == cmsg->cmsg_level) && (SCM_TIMESTAMPNS == cmsg->cmsg_type) ) {
+                                    struct timespec socketTimeStamp;
+                                    memcpy(&socketTimeStamp, CMSG_DATA(cmsg), sizeof(struct timespec));
+                                    received = odcore::data::TimeStamp(socketTimeStamp.tv_sec, socketTimeStamp.tv_nsec / 1000);
+                                }
                             }
-                            odcore::data::TimeStamp received(socketTimeStamp.tv_sec, socketTimeStamp.tv_usec);
 
                             // Create generic CAN message representation.
                             GenericCANMessage gcm;
                             gcm.setDriverTimeStamp(received);
-                            gcm.setIdentifier(frame.can_id);
-                            gcm.setLength(frame.can_dlc);
+                            gcm.setIdentifier(frames[i].can_id);
+                            gcm.setLength(frames[i].len);
                             uint64_t data = 0;
-                            for (uint8_t i = 0; i < frame.can_dlc; i++) {
-                                CLOG1 << static_cast<uint32_t>(frame.data[i]) << " ";
-                                data |= (static_cast<uint64_t>(frame.data[i]) << ((frame.can_dlc-1-i)*8));
+                            for (uint8_t j = 0; j < frames[i].len; j++) {
+                                data |= (static_cast<uint64_t>(frames[i].data[j]) << ((frames[i].len-1-j)*8));
                             }
-                            CLOG1 << endl;
                             gcm.setData(data);
 
                             // Propagate GenericCANMessage.
@@ -0,0 +1,177 @@
+/**
+ * libodcantools - Library to wrap a CAN interface.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CANSIGNALDECODERTESTSUITE_H_
+#define CANSIGNALDECODERTESTSUITE_H_
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "cxxtest/TestSuite.h"
+
+#include <opendavinci/odcore/data/TimeStamp.h>
+#include "automotivedata/generated/automotive/GenericCANMessage.h"
+
+// Include local header files.
+#include "../include/CANMessage.h"
+#include "../include/CANSignalDecoder.h"
+
+using namespace std;
+using namespace automotive;
+using namespace automotive::odcantools;
+
+/**
+ * Excerpt from odcanascreplay/example/example.asc carrying the wheel speeds
+ * as four unsigned 16 bit little endian signals.
+ */
+const char *ASC_TRACE =
+    "5.365 1 123 Rx d 8 00 74 00 83 00 7D 00 00\n"
+    "5.37513 1 123 Rx d 8 00 83 00 83 00 7D 00 00\n"
+    "5.38484 1 123 Rx d 8 00 86 00 83 00 7D 00 00\n"
+    "5.39505 1 123 Rx d 8 00 89 00 83 00 7D 00 00\n"
+    "5.40501 1 123 Rx d 8 00 8C 00 8F 00 88 00 8C\n"
+    "5.41494 1 123 Rx d 8 00 8F 00 93 00 8B 00 8C\n"
+    "5.42504 1 123 Rx d 8 00 95 00 97 00 8E 00 8C\n";
+
+class CANSignalDecoderTest : public CxxTest::TestSuite {
+    public:
+        template<uint8_t START_BIT, uint8_t LENGTH, Signedness SIGNEDNESS, Endianness ENDIANNESS>
+        void compareWithCANMessage(const vector<uint64_t> &payloads) {
+            for (auto payload : payloads) {
+                for (uint8_t length = 1; length <= 8; length++) {
+                    CANMessage cm(0x123, length, payload);
+                    CANSignal signal(START_BIT, LENGTH, SIGNEDNESS, ENDIANNESS, 0.5, -3, 0, 0);
+                    cm.addSignal(1, signal);
+
+                    const double EXPECTED = cm.decodeSignal(1);
+                    const double ACTUAL = CANSignalDecoder<START_BIT, LENGTH, SIGNEDNESS, ENDIANNESS>::decode(cm.getData(), length, 0.5, -3, 0, 0);
+                    TS_ASSERT_EQUALS(ACTUAL, EXPECTED);
+                }
+            }
+        }
+
+        void testDecoderMatchesCANMessage() {
+            vector<uint64_t> payloads;
+            payloads.push_back(0);
+            payloads.push_back(~static_cast<uint64_t>(0));
+            payloads.push_back(0x3C2217220D220722ULL);
+            payloads.push_back(0x8000000000000001ULL);
+            srand(4711);
+            for (uint32_t i = 0; i < 100; i++) {
+                payloads.push_back((static_cast<uint64_t>(rand()) << 40) ^ (static_cast<uint64_t>(rand()) << 20) ^ static_cast<uint64_t>(rand()));
+            }
+
+            compareWithCANMessage<0, 1, UNSIGNED, LITTLE>(payloads);
+            compareWithCANMessage<0, 8, UNSIGNED, LITTLE>(payloads);
+            compareWithCANMessage<3, 7, SIGNED, LITTLE>(payloads);
+            compareWithCANMessage<12, 12, SIGNED, LITTLE>(payloads);
+            compareWithCANMessage<16, 16, UNSIGNED, LITTLE>(payloads);
+            compareWithCANMessage<32, 32, SIGNED, LITTLE>(payloads);
+            compareWithCANMessage<48, 16, UNSIGNED, LITTLE>(payloads);
+            compareWithCANMessage<0, 64, UNSIGNED, LITTLE>(payloads);
+            compareWithCANMessage<60, 4, SIGNED, LITTLE>(payloads);
+
+            compareWithCANMessage<7, 1, UNSIGNED, BIG>(payloads);
+            compareWithCANMessage<7, 8, SIGNED, BIG>(payloads);
+            compareWithCANMessage<7, 16, UNSIGNED, BIG>(payloads);
+            compareWithCANMessage<3, 12, SIGNED, BIG>(payloads);
+            compareWithCANMessage<23, 16, SIGNED, BIG>(payloads);
+            compareWithCANMessage<39, 32, UNSIGNED, BIG>(payloads);
+            compareWithCANMessage<5, 20, UNSIGNED, BIG>(payloads);
+            compareWithCANMessage<63, 8, SIGNED, BIG>(payloads);
+        }
+
+        void testRangeIsApplied() {
+            // Raw value 0xFFFF * 0.01 = 655.35 exceeds the range [0, 200].
+            TS_ASSERT_DELTA((CANSignalDecoder<0, 16, UNSIGNED, LITTLE>::decode(0xFFFF000000000000ULL, 8, 0.01, 0, 0, 200)), 200, 1e-9);
+            TS_ASSERT_DELTA((CANSignalDecoder<0, 16, UNSIGNED, LITTLE>::decode(0x3C22000000000000ULL, 8, 0.01, 0, 0, 200)), 87.64, 1e-9);
+        }
+
+        void testBenchmarkReplayingASCTrace() {
+            // Parse the ASC trace into GenericCANMessages.
+            vector<GenericCANMessage> trace;
+            {
+                stringstream sstr(ASC_TRACE);
+                string line;
+                while (getline(sstr, line)) {
+                    stringstream l(line);
+                    string time, channel, id, direction, d;
+                    uint32_t length = 0;
+                    l >> time >> channel >> id >> direction >> d >> length;
+
+                    uint64_t data = 0;
+                    for (uint32_t i = 0; i < length; i++) {
+                        string byte;
+                        l >> byte;
+                        data = (data << 8) | strtoul(byte.c_str(), NULL, 16);
+                    }
+
+                    GenericCANMessage gcm;
+                    gcm.setIdentifier(strtoul(id.c_str(), NULL, 16));
+                    gcm.setLength(length);
+                    gcm.setData(data);
+                    trace.push_back(gcm);
+                }
+            }
+            TS_ASSERT_EQUALS(trace.size(), 7u);
+
+            const uint32_t ITERATIONS = 20000;
+            double sumOld = 0;
+            double sumNew = 0;
+
+            // Old path: CANMessage with byte vectors and bit-wise extraction.
+            const odcore::data::TimeStamp BEFORE_OLD;
+            for (uint32_t i = 0; i < ITERATIONS; i++) {
+                for (auto &gcm : trace) {
+                    CANMessage cm(gcm.getIdentifier(), gcm.getLength(), gcm.getData());
+                    cm.addSignal(1, CANSignal(0, 16, UNSIGNED, LITTLE, 0.01, 0, 0, 200));
+                    cm.addSignal(2, CANSignal(16, 16, UNSIGNED, LITTLE, 0.01, 0, 0, 200));
+                    cm.addSignal(3, CANSignal(32, 16, UNSIGNED, LITTLE, 0.01, 0, 0, 200));
+                    cm.addSignal(4, CANSignal(48, 16, UNSIGNED, LITTLE, 0.01, 0, 0, 200));
+                    sumOld += cm.decodeSignal(1) + cm.decodeSignal(2) + cm.decodeSignal(3) + cm.decodeSignal(4);
+                }
+            }
+            const odcore::data::TimeStamp AFTER_OLD;
+
+            // New path: shift/mask extraction specialized per signal.
+            const odcore::data::TimeStamp BEFORE_NEW;
+            for (uint32_t i = 0; i < ITERATIONS; i++) {
+                for (auto &gcm : trace) {
+                    const uint64_t DATA = gcm.getData();
+                    const uint8_t LENGTH = gcm.getLength();
+                    sumNew += CANSignalDecoder<0, 16, UNSIGNED, LITTLE>::decode(DATA, LENGTH, 0.01, 0, 0, 200)
+                            + CANSignalDecoder<16, 16, UNSIGNED, LITTLE>::decode(DATA, LENGTH, 0.01, 0, 0, 200)
+                            + CANSignalDecoder<32, 16, UNSIGNED, LITTLE>::decode(DATA, LENGTH, 0.01, 0, 0, 200)
+                            + CANSignalDecoder<48, 16, UNSIGNED, LITTLE>::decode(DATA, LENGTH, 0.01, 0, 0, 200);
+                }
+            }
+            const odcore::data::TimeStamp AFTER_NEW;
+
+            TS_ASSERT_DELTA(sumNew, sumOld, 1e-6 * sumOld);
+
+            const uint64_t FRAMES = ITERATIONS * trace.size();
+            clog << "[CANSignalDecoderTestSuite] Decoded " << FRAMES << " frames with CANMessage in " << (AFTER_OLD - BEFORE_OLD).toMicroseconds() << "us"
+                 << " and with CANSignalDecoder in " << (AFTER_NEW - BEFORE_NEW).toMicroseconds() << "us." << endl;
+        }
+};
+
+#endif /*CANSIGNALDECODERTESTSUITE_H_*/
@@ -20,11 +20,15 @@
 #ifndef CANTOOLSTESTSUITE_H_
 #define CANTOOLSTESTSUITE_H_
 
+#include <iostream>
 #include <string>
+#include <vector>
 
 #include "cxxtest/TestSuite.h"
 
 #include <opendavinci/odcore/data/TimeStamp.h>
+#include <opendavinci/odcore/base/Lock.h>
+#include <opendavinci/odcore/base/Mutex.h>
 #include <opendavinci/odcore/base/Thread.h>
 #include "automotivedata/generated/automotive/GenericCANMessage.h"
 
@@ -40,6 +44,7 @@
 #include "../include/CANDevice.h"
 #include "../include/CANMessage.h"
 #include "../include/GenericCANMessageListener.h"
+#include "../include/SocketCANDevice.h"
 
 using namespace std;
 using namespace odcore::serialization;
@@ -457,6 +462,27 @@ class WheelSpeed : public odcore::data::SerializableData, public odcore::base::V
         WheelSpeedHL m_automotive_vehicle_WheelSpeed;
 }; // end of class "WheelSpeed"
 
+class GenericCANMessageCollector : public GenericCANMessageListener {
+    public:
+        GenericCANMessageCollector() :
+            m_mutex(),
+            m_messages() {}
+
+        virtual void nextGenericCANMessage(const GenericCANMessage &gcm) {
+            odcore::base::Lock l(m_mutex);
+            m_messages.push_back(gcm);
+        }
+
+        vector<GenericCANMessage> getMessages() {
+            odcore::base::Lock l(m_mutex);
+            return m_messages;
+        }
+
+    private:
+        odcore::base::Mutex m_mutex;
+        vector<GenericCANMessage> m_messages;
+};
+
 /**
  * The actual testsuite starts here.
  */
@@ -509,6 +535,65 @@ class CANToolsTest : public CxxTest::TestSuite, public GenericCANMessageListener
 #endif
     }
 
+    void testSocketCANDeviceWithVirtualCANInterface()
+    {
+        // This test requires a virtual CAN interface:
+        // modprobe vcan && ip link add dev vcan0 type vcan && ip link set up vcan0
+        GenericCANMessageCollector collector;
+        GenericCANMessageCollector unused;
+        try {
+            SocketCANDevice receiver("vcan0", collector);
+            SocketCANDevice sender("vcan0", unused);
+
+            // Only receive frames with the identifiers 0x123 and 0x18FEF100 (extended).
+            vector<uint64_t> identifiers;
+            identifiers.push_back(0x123);
+            identifiers.push_back(0x18FEF100);
+            TS_ASSERT(receiver.setFilter(identifiers));
+
+            receiver.start();
+
+            // Send a batch of frames; only every second frame passes the filter.
+            const odcore::data::TimeStamp BEFORE;
+            vector<GenericCANMessage> gcms;
+            for (uint32_t i = 0; i < 2 * SocketCANDevice::MAX_FRAMES_PER_BATCH + 10; i++) {
+                GenericCANMessage gcm;
+                gcm.setIdentifier((i % 2 == 0) ? 0x123 : 0x124);
+                gcm.setLength(8);
+                gcm.setData(i);
+                gcms.push_back(gcm);
+            }
+            TS_ASSERT_EQUALS(sender.write(gcms), 0);
+
+            GenericCANMessage extended;
+            extended.setIdentifier(0x18FEF100 | CAN_EFF_FLAG);
+            extended.setLength(2);
+            extended.setData(0xBEEF);
+            TS_ASSERT_EQUALS(sender.write(extended), 0);
+
+            Thread::usleepFor(500 * 1000);
+            receiver.stop();
+
+            const vector<GenericCANMessage> RECEIVED = collector.getMessages();
+            TS_ASSERT_EQUALS(RECEIVED.size(), gcms.size() / 2 + 1);
+            for (uint32_t i = 0; (i < RECEIVED.size()) && (i < gcms.size() / 2); i++) {
+                TS_ASSERT_EQUALS(RECEIVED[i].getIdentifier(), 0x123u);
+                TS_ASSERT_EQUALS(RECEIVED[i].getData(), 2u * i);
+                // Kernel time stamps are taken after sending.
+                TS_ASSERT(RECEIVED[i].getDriverTimeStamp() >= BEFORE);
+            }
+            if (RECEIVED.size() == gcms.size() / 2 + 1) {
+                TS_ASSERT_EQUALS(RECEIVED.back().getIdentifier(), static_cast<uint64_t>(0x18FEF100 | CAN_EFF_FLAG));
+                TS_ASSERT_EQUALS(RECEIVED.back().getLength(), 2);
+                TS_ASSERT_EQUALS(RECEIVED.back().getData(), 0xBEEFu);
+            }
+            TS_ASSERT_EQUALS(receiver.getNumberOfDroppedFrames(), 0u);
+        }
+        catch(string &s) {
+            cout << "Skipping test as vcan0 is not available: " << s << endl;
+        }
+    }
+
     void testEncode()
     {
         // Mapping name automotive.vehicle.WheelSpeed
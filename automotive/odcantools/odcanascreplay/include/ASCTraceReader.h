@@ -0,0 +1,143 @@
+/**
+ * odcanascreplay - Tool to replay from an ASC file.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef ASCTRACEREADER_H_
+#define ASCTRACEREADER_H_
+
+#include <stdint.h>
+
+#include <istream>
+#include <string>
+
+namespace automotive {
+    namespace odcantools {
+
+        using namespace std;
+
+        /**
+         * This class describes one CAN frame from an ASC trace.
+         */
+        class ASCFrame {
+            public:
+                ASCFrame();
+
+            public:
+                int64_t m_timeStamp; // Time stamp from the trace in microseconds.
+                uint32_t m_channel;
+                uint64_t m_identifier;
+                bool m_extended;
+                uint8_t m_length;
+                uint64_t m_data; // Byte i of the payload is stored in bits 8*i..8*i+7.
+        };
+
+        /**
+         * This class reads received CAN data frames from an ASC trace
+         * ('Timestamp Channel ID Rx d Length 00 11 22 33 44 55 66 77').
+         * A trace file is mapped into memory and parsed in place; stdin
+         * is read line by line. All other lines (header, comments, Tx,
+         * remote, error, and CAN FD frames) are skipped.
+         */
+        class ASCTraceReader {
+            private:
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 *
+                 * @param obj Reference to an object of this class.
+                 */
+                ASCTraceReader(const ASCTraceReader &/*obj*/);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 *
+                 * @param obj Reference to an object of this class.
+                 * @return Reference to this instance.
+                 */
+                ASCTraceReader& operator=(const ASCTraceReader &/*obj*/);
+
+            public:
+                /**
+                 * Constructor to read from a trace file.
+                 *
+                 * @param filename ASC file to map into memory.
+                 */
+                ASCTraceReader(const string &filename);
+
+                /**
+                 * Constructor to read from a stream like stdin.
+                 *
+                 * @param in Stream to read from.
+                 */
+                ASCTraceReader(istream &in);
+
+                virtual ~ASCTraceReader();
+
+                /**
+                 * @return true if the trace could be opened.
+                 */
+                bool isOpen() const;
+
+                /**
+                 * This method returns the next frame from the trace.
+                 *
+                 * @param frame Frame to fill.
+                 * @return true if a frame was read, false at the end of the trace.
+                 */
+                bool next(ASCFrame &frame);
+
+                /**
+                 * This method starts reading the trace file from the beginning
+                 * again (not supported for streams).
+                 *
+                 * @return true if the trace was rewound.
+                 */
+                bool rewind();
+
+                /**
+                 * @return Number of lines read so far.
+                 */
+                uint64_t getNumberOfLines() const;
+
+                /**
+                 * This method parses one line of an ASC trace.
+                 *
+                 * @param begin First character of the line.
+                 * @param end Character after the last one of the line.
+                 * @param frame Frame to fill.
+                 * @return true if the line describes a received CAN data frame.
+                 */
+                static bool parseLine(const char *begin, const char *end, ASCFrame &frame);
+
+            private:
+                istream *m_in;
+                string m_line;
+                int m_fd;
+                const char *m_begin;
+                const char *m_end;
+                const char *m_current;
+                uint64_t m_numberOfLines;
+        };
+
+    } // odcantools
+} // automotive
+
+#endif /*ASCTRACEREADER_H_*/
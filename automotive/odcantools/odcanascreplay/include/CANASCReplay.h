@@ -22,16 +22,25 @@
 
 #include <stdint.h>
 
+#include <memory>
+#include <set>
+#include <string>
+
 #include "opendavinci/odcore/base/module/TimeTriggeredConferenceClientModule.h"
 #include "opendavinci/generated/odcore/data/dmcp/ModuleExitCodeMessage.h"
 
+#include "ASCTraceReader.h"
+
 namespace automotive {
     namespace odcantools {
 
         using namespace std;
 
         /**
-         * This class plays back data from an ASC file.
+         * This class plays back data from an ASC file. The trace is either
+         * replayed one frame per time slice (default), with the timing from
+         * the trace ('realtime', optionally scaled by a speed factor), or as
+         * fast as possible ('throughput') while reporting frames/s.
          */
         class CANASCReplay : public odcore::base::module::TimeTriggeredConferenceClientModule {
             private:
@@ -71,7 +80,37 @@ namespace automotive {
 
                 virtual void tearDown();
 
+                /**
+                 * This method distributes a frame as GenericCANMessage if its
+                 * channel is selected.
+                 *
+                 * @param frame Frame to distribute.
+                 * @return true if the frame was distributed.
+                 */
+                bool send(const ASCFrame &frame);
+
+                /**
+                 * This method replays one frame per time slice.
+                 */
+                void replayPerTimeslice();
+
+                /**
+                 * This method replays the frames with the timing from the
+                 * trace by sleeping until each frame's absolute deadline.
+                 */
+                void replayInRealtime();
+
+                /**
+                 * This method replays the frames as fast as possible.
+                 */
+                void replayForThroughput();
+
             private:
+                unique_ptr<ASCTraceReader> m_reader;
+                string m_mode;
+                double m_speed;
+                set<uint32_t> m_channels;
+                uint64_t m_numberOfSentFrames;
         };
 
     } // odcantools
@@ -0,0 +1,289 @@
+/**
+ * odcanascreplay - Tool to replay from an ASC file.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include "ASCTraceReader.h"
+
+namespace automotive {
+    namespace odcantools {
+
+        using namespace std;
+
+        ASCFrame::ASCFrame() :
+            m_timeStamp(0),
+            m_channel(0),
+            m_identifier(0),
+            m_extended(false),
+            m_length(0),
+            m_data(0) {}
+
+        ////////////////////////////////////////////////////////////////////////
+
+        ASCTraceReader::ASCTraceReader(const string &filename) :
+            m_in(NULL),
+            m_line(),
+            m_fd(-1),
+            m_begin(NULL),
+            m_end(NULL),
+            m_current(NULL),
+            m_numberOfLines(0) {
+            m_fd = ::open(filename.c_str(), O_RDONLY);
+            if (m_fd < 0) {
+                cerr << "[ASCTraceReader] Could not open '" << filename << "': " << strerror(errno) << endl;
+                return;
+            }
+
+            struct stat fileStatus;
+            if ( (::fstat(m_fd, &fileStatus) < 0) || (fileStatus.st_size == 0) ) {
+                cerr << "[ASCTraceReader] Could not determine size of '" << filename << "'." << endl;
+                ::close(m_fd);
+                m_fd = -1;
+                return;
+            }
+
+            void *data = ::mmap(NULL, fileStatus.st_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+            if (MAP_FAILED == data) {
+                cerr << "[ASCTraceReader] Could not map '" << filename << "': " << strerror(errno) << endl;
+                ::close(m_fd);
+                m_fd = -1;
+                return;
+            }
+
+            // The trace is read front to back only once.
+            ::madvise(data, fileStatus.st_size, MADV_SEQUENTIAL);
+
+            m_begin = static_cast<const char*>(data);
+            m_end = m_begin + fileStatus.st_size;
+            m_current = m_begin;
+        }
+
+        ASCTraceReader::ASCTraceReader(istream &in) :
+            m_in(&in),
+            m_line(),
+            m_fd(-1),
+            m_begin(NULL),
+            m_end(NULL),
+            m_current(NULL),
+            m_numberOfLines(0) {}
+
+        ASCTraceReader::~ASCTraceReader() {
+            if (NULL != m_begin) {
+                ::munmap(const_cast<char*>(m_begin), m_end - m_begin);
+            }
+            if (m_fd > -1) {
+                ::close(m_fd);
+            }
+        }
+
+        bool ASCTraceReader::isOpen() const {
+            return (NULL != m_in) || (NULL != m_begin);
+        }
+
+        bool ASCTraceReader::rewind() {
+            if (NULL != m_begin) {
+                m_current = m_begin;
+                m_numberOfLines = 0;
+                return true;
+            }
+            return false;
+        }
+
+        uint64_t ASCTraceReader::getNumberOfLines() const {
+            return m_numberOfLines;
+        }
+
+        bool ASCTraceReader::next(ASCFrame &frame) {
+            if (NULL != m_in) {
+                while (getline(*m_in, m_line)) {
+                    m_numberOfLines++;
+                    if (parseLine(m_line.data(), m_line.data() + m_line.size(), frame)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            while (m_current < m_end) {
+                const char *lineEnd = static_cast<const char*>(::memchr(m_current, '\n', m_end - m_current));
+                if (NULL == lineEnd) {
+                    lineEnd = m_end;
+                }
+
+                const char *lineBegin = m_current;
+                m_current = (lineEnd < m_end) ? lineEnd + 1 : m_end;
+                m_numberOfLines++;
+
+                if (parseLine(lineBegin, lineEnd, frame)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+
+        static inline bool isBlank(const char c) {
+            return (' ' == c) || ('\t' == c) || ('\r' == c);
+        }
+
+        static inline const char* skipBlanks(const char *p, const char *end) {
+            while ( (p < end) && isBlank(*p) ) {
+                p++;
+            }
+            return p;
+        }
+
+        static inline int32_t hexValue(const char c) {
+            if ( (c >= '0') && (c <= '9') ) {
+                return c - '0';
+            }
+            if ( (c >= 'a') && (c <= 'f') ) {
+                return c - 'a' + 10;
+            }
+            if ( (c >= 'A') && (c <= 'F') ) {
+                return c - 'A' + 10;
+            }
+            return -1;
+        }
+
+        static inline bool parseHex(const char *&p, const char *end, uint64_t &value) {
+            const char *start = p;
+            value = 0;
+            int32_t v = 0;
+            while ( (p < end) && ((v = hexValue(*p)) > -1) ) {
+                value = (value << 4) | static_cast<uint64_t>(v);
+                p++;
+            }
+            return (p > start) && (p - start <= 16);
+        }
+
+        static inline bool parseDecimal(const char *&p, const char *end, uint64_t &value) {
+            const char *start = p;
+            value = 0;
+            while ( (p < end) && (*p >= '0') && (*p <= '9') ) {
+                value = value * 10 + static_cast<uint64_t>(*p - '0');
+                p++;
+            }
+            return (p > start);
+        }
+
+        bool ASCTraceReader::parseLine(const char *begin, const char *end, ASCFrame &frame) {
+            const char *p = skipBlanks(begin, end);
+
+            // Time stamp in seconds with up to microseconds resolution.
+            uint64_t seconds = 0;
+            if (!parseDecimal(p, end, seconds)) {
+                return false;
+            }
+            int64_t microseconds = 0;
+            if ( (p < end) && ('.' == *p) ) {
+                p++;
+                int32_t digits = 0;
+                while ( (p < end) && (*p >= '0') && (*p <= '9') ) {
+                    if (digits < 6) {
+                        microseconds = microseconds * 10 + (*p - '0');
+                        digits++;
+                    }
+                    p++;
+                }
+                for (; digits < 6; digits++) {
+                    microseconds *= 10;
+                }
+            }
+            if ( (p == end) || !isBlank(*p) ) {
+                return false;
+            }
+
+            // Channel (decimal); lines like 'CANFD' or 'ErrorFrame' are skipped here.
+            p = skipBlanks(p, end);
+            uint64_t channel = 0;
+            if (!parseDecimal(p, end, channel) || (p == end) || !isBlank(*p)) {
+                return false;
+            }
+
+            // CAN identifier (hexadecimal); extended identifiers end with 'x'.
+            p = skipBlanks(p, end);
+            uint64_t identifier = 0;
+            if (!parseHex(p, end, identifier)) {
+                return false;
+            }
+            bool extended = false;
+            if ( (p < end) && (('x' == *p) || ('X' == *p)) ) {
+                extended = true;
+                p++;
+            }
+            if ( (p == end) || !isBlank(*p) ) {
+                return false;
+            }
+
+            // Direction: Only received frames are replayed.
+            p = skipBlanks(p, end);
+            if ( (end - p < 3) || (('R' != p[0]) && ('r' != p[0])) || (('X' != p[1]) && ('x' != p[1])) || !isBlank(p[2]) ) {
+                return false;
+            }
+            p += 3;
+
+            // Frame type: Only data frames are replayed.
+            p = skipBlanks(p, end);
+            if ( (end - p < 2) || (('d' != p[0]) && ('D' != p[0])) || !isBlank(p[1]) ) {
+                return false;
+            }
+            p += 2;
+
+            // Payload length (0-8).
+            p = skipBlanks(p, end);
+            uint64_t length = 0;
+            if (!parseDecimal(p, end, length) || (length > 8)) {
+                return false;
+            }
+
+            // Payload.
+            uint64_t data = 0;
+            for (uint64_t i = 0; i < length; i++) {
+                if ( (p == end) || !isBlank(*p) ) {
+                    return false;
+                }
+                p = skipBlanks(p, end);
+
+                uint64_t value = 0;
+                if (!parseHex(p, end, value) || (value > 0xFF)) {
+                    return false;
+                }
+                data |= (value << (i*8));
+            }
+
+            frame.m_timeStamp = static_cast<int64_t>(seconds) * 1000000L + microseconds;
+            frame.m_channel = static_cast<uint32_t>(channel);
+            frame.m_identifier = identifier;
+            frame.m_extended = extended;
+            frame.m_length = static_cast<uint8_t>(length);
+            frame.m_data = data;
+            return true;
+        }
+
+    } // odcantools
+} // automotive
@@ -17,6 +17,10 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
+#include <time.h>
+
+#include <cerrno>
+#include <cstdlib>
 #include <iostream>
 
 #include "opendavinci/odcore/opendavinci.h"
@@ -34,65 +38,191 @@ namespace automotive {
         using namespace odcore::data;
         using namespace odcore::strings;
 
+        static int64_t now() {
+            struct timespec ts;
+            ::clock_gettime(CLOCK_MONOTONIC, &ts);
+            return static_cast<int64_t>(ts.tv_sec) * 1000000L + ts.tv_nsec / 1000L;
+        }
+
+        static void sleepUntil(const int64_t &deadline) {
+            struct timespec ts;
+            ts.tv_sec = deadline / 1000000L;
+            ts.tv_nsec = (deadline % 1000000L) * 1000L;
+            // Absolute deadlines do not accumulate the time spent for parsing and sending.
+            while (EINTR == ::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL)) {}
+        }
+
         CANASCReplay::CANASCReplay(const int32_t &argc, char **argv) :
-            TimeTriggeredConferenceClientModule(argc, argv, "odcanascreplay") {}
+            TimeTriggeredConferenceClientModule(argc, argv, "odcanascreplay"),
+            m_reader(),
+            m_mode("timeslice"),
+            m_speed(1.0),
+            m_channels(),
+            m_numberOfSentFrames(0) {}
 
         CANASCReplay::~CANASCReplay() {}
 
-        void CANASCReplay::setUp() {}
+        void CANASCReplay::setUp() {
+            // Read from the given trace file or from stdin.
+            bool found = false;
+            const string INPUT = getKeyValueConfiguration().getOptionalValue<string>("odcanascreplay.input", found);
+            if (found && !INPUT.empty()) {
+                m_reader = unique_ptr<ASCTraceReader>(new ASCTraceReader(INPUT));
+            }
+            else {
+                m_reader = unique_ptr<ASCTraceReader>(new ASCTraceReader(cin));
+            }
+
+            found = false;
+            string mode = getKeyValueConfiguration().getOptionalValue<string>("odcanascreplay.mode", found);
+            StringToolbox::trim(mode);
+            if (found && !mode.empty()) {
+                m_mode = mode;
+            }
+
+            found = false;
+            const double SPEED = getKeyValueConfiguration().getOptionalValue<double>("odcanascreplay.speed", found);
+            if (found && (SPEED > 0)) {
+                m_speed = SPEED;
+            }
+
+            // Replay only the selected channels.
+            found = false;
+            const string CHANNELS = getKeyValueConfiguration().getOptionalValue<string>("odcanascreplay.channels", found);
+            if (found) {
+                const vector<string> TOKENS = StringToolbox::split(CHANNELS, ',');
+                for (auto token : TOKENS) {
+                    StringToolbox::trim(token);
+                    if (!token.empty()) {
+                        m_channels.insert(static_cast<uint32_t>(strtoul(token.c_str(), NULL, 10)));
+                    }
+                }
+            }
+        }
 
         void CANASCReplay::tearDown() {}
 
-        odcore::data::dmcp::ModuleExitCodeMessage::ModuleExitCode CANASCReplay::body() {
-            // Structure of an ASC entry: 'Timestamp Channel  ID             Rx   d Length 00 11 22 33 44 55 66 77'
-            char buffer[100];
+        bool CANASCReplay::send(const ASCFrame &frame) {
+            if (!m_channels.empty() && (m_channels.count(frame.m_channel) == 0)) {
+                return false;
+            }
+
+            // Create GenericCANMessage from parsed data.
+            GenericCANMessage gcm;
+            gcm.setDriverTimeStamp(TimeStamp(static_cast<int32_t>(frame.m_timeStamp / 1000000L), static_cast<int32_t>(frame.m_timeStamp % 1000000L)));
+            gcm.setIdentifier(frame.m_identifier);
+            gcm.setLength(frame.m_length);
+            gcm.setData(frame.m_data);
+
+            CLOG1 << gcm.toString() << endl;
+
+            // Distribute data; the channel is used as sender stamp to distinguish the CAN buses.
+            Container c(gcm);
+            c.setSenderStamp(frame.m_channel);
+            getConference().send(c);
+
+            m_numberOfSentFrames++;
+            return true;
+        }
+
+        void CANASCReplay::replayPerTimeslice() {
+            ASCFrame frame;
             while (getModuleStateAndWaitForRemainingTimeInTimeslice() == odcore::data::dmcp::ModuleStateMessage::RUNNING) {
-                // Read next line from STDIN.
-                cin.getline(buffer, 100);
-
-                // Tokenize the read line.
-                vector<string> tokens = StringToolbox::split(string(buffer), ' ');
-
-                // Do we have a valid line?
-                if ( (tokens.size() >= 7) &&
-                     (StringToolbox::equalsIgnoreCase(tokens[3], "rx")) ) {
-                    // Read CAN identifier.
-                    stringstream _identifier;
-                    uint64_t identifier = 0;
-                    _identifier << tokens[2]; _identifier >> hex >> identifier;
-
-                    // Read payload length (1-8).
-                    stringstream _length;
-                    uint16_t length = 0;
-                    _length << tokens[5]; _length >> dec >> length;
-
-                    // Read payload.
-                    uint64_t data = 0;
-                    for (uint16_t i = 0; i < length; i++) {
-                        // Put next data byte into stringstream.
-                        stringstream _data;
-                        _data << tokens[6 + i];
-
-                        // Read next data byte.
-                        uint16_t value = 0;
-                        _data >> hex >> value;
-                        data |= (static_cast<uint64_t>(value) << (i*8));
-                    }
+                // Skip frames from other channels within the same time slice.
+                bool sent = false;
+                while (!sent && m_reader->next(frame)) {
+                    sent = send(frame);
+                }
+                if (!sent) {
+                    break;
+                }
+            }
+        }
+
+        void CANASCReplay::replayInRealtime() {
+            // Sleep at most this long at once to react on a stopping module.
+            const int64_t MAX_SLEEP = 100000L;
+            // Frames sent later than this are counted as late.
+            const int64_t MAX_LATENESS = 1000L;
+
+            int64_t start = 0;
+            int64_t firstTimeStamp = 0;
+            uint64_t numberOfLateFrames = 0;
+            int64_t maxLateness = 0;
+
+            ASCFrame frame;
+            while ( (getModuleState() == odcore::data::dmcp::ModuleStateMessage::RUNNING) && m_reader->next(frame) ) {
+                if (0 == start) {
+                    start = now();
+                    firstTimeStamp = frame.m_timeStamp;
+                }
+
+                const int64_t DEADLINE = start + static_cast<int64_t>((frame.m_timeStamp - firstTimeStamp) / m_speed);
+                int64_t current = now();
+                while ( (DEADLINE - current > MAX_SLEEP) && (getModuleState() == odcore::data::dmcp::ModuleStateMessage::RUNNING) ) {
+                    sleepUntil(current + MAX_SLEEP);
+                    current = now();
+                }
+                if (DEADLINE > current) {
+                    sleepUntil(DEADLINE);
+                }
+                else if (current - DEADLINE > MAX_LATENESS) {
+                    numberOfLateFrames++;
+                    maxLateness = (current - DEADLINE > maxLateness) ? current - DEADLINE : maxLateness;
+                }
+
+                send(frame);
+            }
+
+            cout << "[odcanascreplay] Replayed " << m_numberOfSentFrames << " frames, " << numberOfLateFrames << " frames were late (at most " << maxLateness << " us)." << endl;
+        }
 
-                    // Create GenericCANMessage from parsed data.
-                    GenericCANMessage gcm;
-                    gcm.setIdentifier(identifier);
-                    gcm.setLength(length);
-                    gcm.setData(data);
+        void CANASCReplay::replayForThroughput() {
+            // Check the module's state and report the throughput only after this many frames.
+            const uint64_t CHECK_INTERVAL = 4096;
 
-                    CLOG1 << gcm.toString() << endl;
+            const int64_t START = now();
+            int64_t lastReport = START;
+            uint64_t lastNumberOfSentFrames = 0;
+            uint64_t numberOfReadFrames = 0;
 
-                    // Distribute data.
-                    Container c(gcm);
-                    getConference().send(c);
+            ASCFrame frame;
+            while (m_reader->next(frame)) {
+                send(frame);
+
+                if (0 == (++numberOfReadFrames % CHECK_INTERVAL)) {
+                    if (getModuleState() != odcore::data::dmcp::ModuleStateMessage::RUNNING) {
+                        break;
+                    }
+
+                    const int64_t CURRENT = now();
+                    if (CURRENT - lastReport >= 1000000L) {
+                        CLOG1 << "[odcanascreplay] " << (m_numberOfSentFrames - lastNumberOfSentFrames) * 1000000.0 / (CURRENT - lastReport) << " frames/s." << endl;
+                        lastReport = CURRENT;
+                        lastNumberOfSentFrames = m_numberOfSentFrames;
+                    }
                 }
             }
 
+            const double DURATION = (now() - START) / 1000000.0;
+            cout << "[odcanascreplay] Replayed " << m_numberOfSentFrames << " frames from " << m_reader->getNumberOfLines() << " lines in " << DURATION << " s (" << ((DURATION > 0) ? m_numberOfSentFrames / DURATION : 0) << " frames/s)." << endl;
+        }
+
+        odcore::data::dmcp::ModuleExitCodeMessage::ModuleExitCode CANASCReplay::body() {
+            if (!m_reader->isOpen()) {
+                return odcore::data::dmcp::ModuleExitCodeMessage::SERIOUS_ERROR;
+            }
+
+            if (StringToolbox::equalsIgnoreCase(m_mode, "realtime")) {
+                replayInRealtime();
+            }
+            else if (StringToolbox::equalsIgnoreCase(m_mode, "throughput")) {
+                replayForThroughput();
+            }
+            else {
+                replayPerTimeslice();
+            }
+
             return odcore::data::dmcp::ModuleExitCodeMessage::OKAY;
         }
 
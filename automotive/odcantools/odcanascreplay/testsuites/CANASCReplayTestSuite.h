@@ -20,9 +20,18 @@
 #ifndef CANASCREPLAYTESTSUITE_H_
 #define CANASCREPLAYTESTSUITE_H_
 
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
 #include "cxxtest/TestSuite.h"
 
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/data/TimeStamp.h"
+
 // Include local header files.
+#include "../include/ASCTraceReader.h"
 #include "../include/CANASCReplay.h"
 
 using namespace std;
@@ -84,6 +93,121 @@ class CANASCReplayTest : public CxxTest::TestSuite {
             TS_ASSERT(dt != NULL);
         }
 
+        void testASCTraceReaderParseLine() {
+            const string LINE1 = "5.29517 1 123 Rx d 8 00 74 00 83 00 7D 00 0A";
+            ASCFrame frame;
+            TS_ASSERT(ASCTraceReader::parseLine(LINE1.data(), LINE1.data() + LINE1.size(), frame));
+            TS_ASSERT(frame.m_timeStamp == 5295170);
+            TS_ASSERT(frame.m_channel == 1);
+            TS_ASSERT(frame.m_identifier == 0x123);
+            TS_ASSERT(!frame.m_extended);
+            TS_ASSERT(frame.m_length == 8);
+            TS_ASSERT(frame.m_data == 0x0A007D0083007400ull);
+
+            const string LINE2 = "   12.000001 2  18FEF100x       Rx   d 3 01 02 ff  Length = 0 BitCount = 0\r";
+            TS_ASSERT(ASCTraceReader::parseLine(LINE2.data(), LINE2.data() + LINE2.size(), frame));
+            TS_ASSERT(frame.m_timeStamp == 12000001);
+            TS_ASSERT(frame.m_channel == 2);
+            TS_ASSERT(frame.m_identifier == 0x18FEF100);
+            TS_ASSERT(frame.m_extended);
+            TS_ASSERT(frame.m_length == 3);
+            TS_ASSERT(frame.m_data == 0xFF0201ull);
+
+            const string INVALID[] = { "Time (s) Channel ID RX/TX d Length Byte 1 Byte 2",
+                                       "date Mon Oct 2 10:00:00 2017",
+                                       "0.5 1 123 Tx d 1 00",
+                                       "0.5 1 123 Rx r 0",
+                                       "0.5 1 ErrorFrame",
+                                       "0.5 CANFD 1 Rx 123 1 0 8 8 00 00 00 00 00 00 00 00",
+                                       "0.5 1 123 Rx d 9 00 00 00 00 00 00 00 00 00",
+                                       "0.5 1 123 Rx d 2 00",
+                                       "0.5 1 123 Rx d 2 00 100",
+                                       "" };
+            for (auto &line : INVALID) {
+                TS_ASSERT(!ASCTraceReader::parseLine(line.data(), line.data() + line.size(), frame));
+            }
+        }
+
+        void testASCTraceReaderMappedFileAndStreamAreEqual() {
+            stringstream trace;
+            trace << "Time (s) Channel ID RX/TX d Length Byte 1 Byte 2 Byte 3 Byte 4 Byte 5 Byte 6 Byte 7 Byte 8" << endl;
+            for (uint32_t i = 0; i < 1000; i++) {
+                trace << i / 100 << "." << (i % 100) << " " << (1 + i % 2) << " " << hex << (0x100 + i % 7) << dec << " Rx d " << (i % 9);
+                for (uint32_t j = 0; j < i % 9; j++) {
+                    trace << " " << hex << ((i + j) & 0xFF) << dec;
+                }
+                trace << endl;
+            }
+            // The last line does not end with a newline.
+            trace << "10.5 3 7FF Rx d 1 AA";
+
+            const string FILENAME = "CANASCReplayTestSuite.asc";
+            {
+                fstream fout(FILENAME.c_str(), ios::out | ios::binary | ios::trunc);
+                fout << trace.str();
+            }
+
+            stringstream in(trace.str());
+            ASCTraceReader fromStream(in);
+            ASCTraceReader fromFile(FILENAME);
+            TS_ASSERT(fromStream.isOpen());
+            TS_ASSERT(fromFile.isOpen());
+
+            uint32_t numberOfFrames = 0;
+            ASCFrame a, b;
+            while (fromStream.next(a)) {
+                TS_ASSERT(fromFile.next(b));
+                TS_ASSERT(a.m_timeStamp == b.m_timeStamp);
+                TS_ASSERT(a.m_channel == b.m_channel);
+                TS_ASSERT(a.m_identifier == b.m_identifier);
+                TS_ASSERT(a.m_length == b.m_length);
+                TS_ASSERT(a.m_data == b.m_data);
+                numberOfFrames++;
+            }
+            TS_ASSERT(!fromFile.next(b));
+            TS_ASSERT(numberOfFrames == 1001);
+            TS_ASSERT(a.m_channel == 3);
+            TS_ASSERT(a.m_identifier == 0x7FF);
+            TS_ASSERT(a.m_data == 0xAA);
+            TS_ASSERT(fromFile.getNumberOfLines() == 1002);
+
+            // Read the file again.
+            TS_ASSERT(fromFile.rewind());
+            TS_ASSERT(fromFile.next(b));
+            TS_ASSERT(b.m_timeStamp == 0);
+            TS_ASSERT(!fromStream.rewind());
+
+            UNLINK(FILENAME.c_str());
+        }
+
+        void testASCTraceReaderThroughput() {
+            const uint32_t LINES = 200000;
+            stringstream trace;
+            for (uint32_t i = 0; i < LINES; i++) {
+                trace << i / 1000 << "." << (i % 1000) << " 1 123 Rx d 8 00 74 00 83 00 7D 00 00" << endl;
+            }
+            const string FILENAME = "CANASCReplayTestSuiteThroughput.asc";
+            {
+                fstream fout(FILENAME.c_str(), ios::out | ios::binary | ios::trunc);
+                fout << trace.str();
+            }
+
+            ASCTraceReader reader(FILENAME);
+            ASCFrame frame;
+            uint32_t numberOfFrames = 0;
+            odcore::data::TimeStamp before;
+            while (reader.next(frame)) {
+                numberOfFrames++;
+            }
+            odcore::data::TimeStamp after;
+            TS_ASSERT(numberOfFrames == LINES);
+
+            const double DURATION = (after - before).toMicroseconds() / 1000000.0;
+            clog << "[CANASCReplayTestSuite] Parsed " << numberOfFrames << " frames in " << DURATION << " s (" << ((DURATION > 0) ? numberOfFrames / DURATION : 0) << " frames/s)." << endl;
+
+            UNLINK(FILENAME.c_str());
+        }
+
         ////////////////////////////////////////////////////////////////////////////////////
         // Below this line the necessary constructor for initializing the pointer variables,
         // and the forbidden copy constructor and assignment operator are declared.
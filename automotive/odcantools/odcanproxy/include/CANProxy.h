@@ -23,6 +23,7 @@
 #include <stdint.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "GenericCANMessageListener.h"
 #include "opendavinci/odcore/base/FIFOQueue.h"
@@ -93,6 +94,16 @@ class CANDevice;
 
                 virtual void tearDown();
 
+                /**
+                 * This method returns the CAN identifiers needed by a
+                 * generated CanMapping in a shared library.
+                 *
+                 * @param library Shared library containing the CanMapping.
+                 * @param identifiers CAN identifiers needed by the CanMapping.
+                 * @return true if the identifiers could be determined.
+                 */
+                bool getIdentifiersFromCANMapping(const string &library, vector<uint64_t> &identifiers);
+
             private:
                 odcore::base::FIFOQueue m_fifo;
                 unique_ptr<odtools::recorder::Recorder> m_recorder;
@@ -17,10 +17,15 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
+#include <dlfcn.h>
+
+#include <cstdlib>
 #include <iostream>
+#include <vector>
 
 #include "opendavinci/odcore/data/Container.h"
 #include "opendavinci/odcore/data/TimeStamp.h"
+#include "opendavinci/odcore/strings/StringToolbox.h"
 #include "opendavinci/odtools/recorder/Recorder.h"
 #include "automotivedata/generated/automotive/GenericCANMessage.h"
 
@@ -50,7 +55,38 @@ namespace automotive {
             m_deviceNode = getKeyValueConfiguration().getValue<string>("odcanproxy.devicenode");
 
             // Try to open CAN device and register this instance as receiver for GenericCANMessages.
-            m_device = shared_ptr<CANDevice>(new SocketCANDevice(m_deviceNode, *this));
+            shared_ptr<SocketCANDevice> socketCANDevice = shared_ptr<SocketCANDevice>(new SocketCANDevice(m_deviceNode, *this));
+
+            // Let the kernel discard all CAN frames that are not needed by
+            // the CanMapping; an explicitly configured filter overrides it.
+            vector<uint64_t> identifiers;
+            bool hasFilter = false;
+            bool mappingFound = false;
+            const string MAPPING = getKeyValueConfiguration().getOptionalValue<string>("odcanproxy.mapping", mappingFound);
+            if (mappingFound) {
+                hasFilter = getIdentifiersFromCANMapping(MAPPING, identifiers);
+            }
+
+            bool filterFound = false;
+            const string FILTER = getKeyValueConfiguration().getOptionalValue<string>("odcanproxy.filter", filterFound);
+            if (filterFound) {
+                identifiers.clear();
+                const vector<string> TOKENS = odcore::strings::StringToolbox::split(FILTER, ',');
+                for (auto token : TOKENS) {
+                    odcore::strings::StringToolbox::trim(token);
+                    if (!token.empty()) {
+                        identifiers.push_back(strtoull(token.c_str(), NULL, 0));
+                    }
+                }
+                hasFilter = true;
+            }
+
+            if (hasFilter && socketCANDevice->isOpen()) {
+                if (socketCANDevice->setFilter(identifiers)) {
+                    cout << "[odcanproxy] Receiving " << identifiers.size() << " CAN identifiers from " << m_deviceNode << "." << endl;
+                }
+            }
+            m_device = socketCANDevice;
 
             // If the device could be successfully opened, create a recording file with a dump of the data.
             if (m_device->isOpen()) {
@@ -76,8 +112,36 @@ namespace automotive {
 
         void CANProxy::tearDown() {}
 
+        bool CANProxy::getIdentifiersFromCANMapping(const string &library, vector<uint64_t> &identifiers) {
+            bool retVal = false;
+            void *handle = dlopen(library.c_str(), RTLD_LAZY);
+            if (NULL == handle) {
+                cerr << "[odcanproxy] Cannot open CAN mapping '" << library << "': " << dlerror() << endl;
+                return retVal;
+            }
+
+            typedef void getCanMappingIdentifiers_t(vector<uint64_t> &);
+
+            // Reset errors.
+            dlerror();
+            getCanMappingIdentifiers_t *getCanMappingIdentifiers = reinterpret_cast<getCanMappingIdentifiers_t*>(dlsym(handle, "getCanMappingIdentifiers"));
+            const char *dlsym_error = dlerror();
+            if (NULL != dlsym_error) {
+                cerr << "[odcanproxy] Cannot load symbol 'getCanMappingIdentifiers' from '" << library << "': " << dlsym_error << endl;
+            }
+            else {
+                getCanMappingIdentifiers(identifiers);
+                retVal = true;
+            }
+            dlclose(handle);
+
+            return retVal;
+        }
+
         void CANProxy::nextGenericCANMessage(const GenericCANMessage &gcm) {
             Container c(gcm);
+            // Use the kernel's receiving time stamp as sample time.
+            c.setSampleTimeStamp(gcm.getDriverTimeStamp());
             m_fifo.add(c);
         }
 
@@ -0,0 +1,286 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_BASE_PROFILER_H_
+#define OPENDAVINCI_CORE_BASE_PROFILER_H_
+
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+
+namespace odcore {
+    namespace base {
+
+        using namespace std;
+
+        class ProfilerRing;
+        class ProfilerRingOwner;
+
+        /**
+         * This structure describes one entry of a profiling trace. The
+         * trace file starts with ProfilerHeader followed by a sequence of
+         * ProfilerEvents in the host's byte order. An event of type NAME
+         * is followed by m_value bytes for the name with identifier m_name.
+         */
+        struct ProfilerEvent {
+            enum TYPE {
+                CYCLE_BEGIN = 1,   // m_value: Time waited for this cycle in nanoseconds.
+                CYCLE_END = 2,
+                CONTAINER_IN = 3,  // m_value: Data type.
+                CONTAINER_OUT = 4, // m_value: Data type.
+                SPAN_BEGIN = 5,
+                SPAN_END = 6,
+                NAME = 7,          // m_value: Length of the following name.
+                DROPPED = 8,       // m_value: Number of events lost as the thread's ring was full.
+            };
+
+            uint64_t m_ticks;
+            int64_t m_value;
+            uint32_t m_thread;
+            uint16_t m_type;
+            uint16_t m_name;
+        };
+
+        struct ProfilerHeader {
+            char m_magic[8];
+            double m_ticksPerMicrosecond;
+        };
+
+        /**
+         * This class collects profiling events with low overhead. Every
+         * thread writes into its own lock-free ring buffer; a background
+         * thread drains all rings into a binary trace file, which can be
+         * converted to CSV or Chrome's trace format using odprofileconverter.
+         * If a ring is full, events are dropped and counted instead of
+         * blocking the producer. The ring of a finished thread is released
+         * after its pending events were written; up to MAX_SPARE_RINGS rings
+         * are kept for reuse by new threads.
+         *
+         * While profiling is disabled, recording an event costs a single
+         * relaxed atomic load. Named spans are added like:
+         *
+         * @code
+         * void MyModule::process() {
+         *     OPENDAVINCI_PROFILE_SPAN("MyModule::process");
+         *     ...
+         * }
+         * @endcode
+         */
+        class OPENDAVINCI_API Profiler {
+            private:
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 */
+                Profiler(const Profiler &);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 */
+                Profiler& operator=(const Profiler &);
+
+            private:
+                Profiler();
+
+            public:
+                virtual ~Profiler();
+
+                enum {
+                    WRITER_INTERVAL = 10, // Milliseconds between draining the rings.
+                    MAX_SPARE_RINGS = 4,  // Rings of finished threads kept for reuse.
+                };
+
+                static const char MAGIC[8];
+
+                /**
+                 * @return Instance of the process-wide profiler.
+                 */
+                static Profiler& getInstance();
+
+                /**
+                 * This method starts writing a trace file.
+                 *
+                 * @param fileName Name of the trace file.
+                 * @return true if the file could be opened or profiling was already started.
+                 */
+                bool start(const string &fileName);
+
+                /**
+                 * This method stops profiling and writes all pending events.
+                 */
+                void stop();
+
+                /**
+                 * @return true if events are currently recorded.
+                 */
+                static inline bool isEnabled() {
+                    return m_enabled.load(std::memory_order_relaxed);
+                }
+
+                /**
+                 * This method records an event for the calling thread if
+                 * profiling is enabled.
+                 *
+                 * @param type ProfilerEvent::TYPE.
+                 * @param name Identifier returned by registerName or 0.
+                 * @param value Value depending on the type.
+                 */
+                static inline void record(const uint16_t &type, const uint16_t &name, const int64_t &value) {
+                    if (isEnabled()) {
+                        recordEvent(type, name, value);
+                    }
+                }
+
+                /**
+                 * This method registers a name for spans; registering
+                 * the same name twice returns the same identifier.
+                 *
+                 * @param name Name.
+                 * @return Identifier for the name or 0 if too many names were registered.
+                 */
+                static uint16_t registerName(const string &name);
+
+                /**
+                 * @return Number of events dropped since start().
+                 */
+                uint64_t getNumberOfDroppedEvents() const;
+
+                /**
+                 * @return Number of rings currently allocated, including spare ones.
+                 */
+                uint32_t getNumberOfRings();
+
+            private:
+                friend class ProfilerRingOwner;
+
+                static void recordEvent(const uint16_t &type, const uint16_t &name, const int64_t &value);
+
+                ProfilerRing* createRing();
+
+                /**
+                 * This method is called when the owning thread of the
+                 * given ring has finished.
+                 *
+                 * @param ring Ring to be released.
+                 */
+                void releaseRing(ProfilerRing *ring);
+
+                /**
+                 * This method moves the drained rings of finished threads
+                 * to the spare rings (to be called with m_ringsMutex locked
+                 * and only by the consumer of the rings).
+                 */
+                void recycleReleasedRings();
+
+                void run();
+
+                /**
+                 * This method writes pending names and events to the file.
+                 */
+                void drain();
+
+            private:
+                static std::atomic<bool> m_enabled;
+
+                std::mutex m_mutex;
+                std::atomic<bool> m_running;
+                std::thread m_writer;
+                ofstream m_file;
+                uint64_t m_numberOfDroppedEvents;
+
+                std::mutex m_ringsMutex;
+                vector<shared_ptr<ProfilerRing> > m_rings;
+                vector<shared_ptr<ProfilerRing> > m_spareRings;
+                uint32_t m_numberOfThreads;
+
+                std::mutex m_namesMutex;
+                vector<string> m_names;
+                map<string, uint16_t> m_nameIdentifiers;
+                uint32_t m_numberOfWrittenNames;
+        };
+
+        /**
+         * This class records a named span from its construction until
+         * its destruction.
+         */
+        class OPENDAVINCI_API ProfilerSpan {
+            private:
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 */
+                ProfilerSpan(const ProfilerSpan &);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 */
+                ProfilerSpan& operator=(const ProfilerSpan &);
+
+            public:
+                /**
+                 * Constructor.
+                 *
+                 * @param name Identifier returned by Profiler::registerName.
+                 */
+                inline ProfilerSpan(const uint16_t &name) :
+                    m_name(name),
+                    m_active(Profiler::isEnabled()) {
+                    if (m_active) {
+                        Profiler::record(ProfilerEvent::SPAN_BEGIN, m_name, 0);
+                    }
+                }
+
+                inline ~ProfilerSpan() {
+                    if (m_active) {
+                        Profiler::record(ProfilerEvent::SPAN_END, m_name, 0);
+                    }
+                }
+
+            private:
+                uint16_t m_name;
+                bool m_active;
+        };
+
+    }
+} // odcore::base
+
+#define OPENDAVINCI_PROFILE_CONCAT_(a, b) a##b
+#define OPENDAVINCI_PROFILE_CONCAT(a, b) OPENDAVINCI_PROFILE_CONCAT_(a, b)
+
+/**
+ * This macro records a named span until the end of the enclosing scope.
+ */
+#define OPENDAVINCI_PROFILE_SPAN(NAME) \
+    static const uint16_t OPENDAVINCI_PROFILE_CONCAT(odProfilerName, __LINE__) = odcore::base::Profiler::registerName(NAME); \
+    odcore::base::ProfilerSpan OPENDAVINCI_PROFILE_CONCAT(odProfilerSpan, __LINE__)(OPENDAVINCI_PROFILE_CONCAT(odProfilerName, __LINE__))
+
+#endif /*OPENDAVINCI_CORE_BASE_PROFILER_H_*/
@@ -0,0 +1,126 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_BASE_WORKERPOOL_H_
+#define OPENDAVINCI_CORE_BASE_WORKERPOOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+
+namespace odcore {
+    namespace base {
+
+        using namespace std;
+
+        /**
+         * This class executes tasks on a fixed number of threads.
+         * Tasks are queued without limit and started in the order
+         * of their submission; the result of a task is provided by
+         * the returned future. Tasks must not wait for other tasks
+         * of the same pool as all workers might be blocked otherwise.
+         *
+         * @code
+         * WorkerPool pool(0);
+         * std::future<int> f = pool.submit(std::bind(&compute, 42));
+         * int result = f.get();
+         * @endcode
+         */
+        class OPENDAVINCI_API WorkerPool {
+            private:
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 */
+                WorkerPool(const WorkerPool &);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 */
+                WorkerPool& operator=(const WorkerPool &);
+
+            public:
+                /**
+                 * Constructor.
+                 *
+                 * @param numberOfWorkers Number of threads; 0 uses one thread per hardware thread.
+                 */
+                WorkerPool(const uint32_t &numberOfWorkers);
+
+                /**
+                 * Destructor. All queued tasks are finished before
+                 * the workers are joined.
+                 */
+                virtual ~WorkerPool();
+
+                /**
+                 * @return Number of threads.
+                 */
+                uint32_t getNumberOfWorkers() const;
+
+                /**
+                 * This method queues a task.
+                 *
+                 * @param task Callable without parameters.
+                 * @return Future for the task's result.
+                 */
+                template<typename F>
+                std::future<typename std::result_of<F()>::type> submit(F task) {
+                    typedef typename std::result_of<F()>::type RESULT;
+                    std::shared_ptr<std::packaged_task<RESULT()> > packagedTask(new std::packaged_task<RESULT()>(task));
+                    std::future<RESULT> result = packagedTask->get_future();
+                    enqueue([packagedTask]() { (*packagedTask)(); });
+                    return result;
+                }
+
+            private:
+                /**
+                 * This method queues a task and wakes up one worker.
+                 *
+                 * @param task Task to be executed.
+                 */
+                void enqueue(const std::function<void()> &task);
+
+                /**
+                 * This method executes queued tasks until the pool is destroyed.
+                 */
+                void run();
+
+            private:
+                std::mutex m_tasksMutex;
+                std::condition_variable m_tasksCondition;
+                deque<std::function<void()> > m_tasks;
+                bool m_isRunning;
+                vector<std::thread> m_workers;
+        };
+
+    }
+} // odcore::base
+
+#endif /*OPENDAVINCI_CORE_BASE_WORKERPOOL_H_*/
@@ -23,6 +23,7 @@
 #include <string>
 
 #include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/module/DeadlineScheduler.h"
 #include "opendavinci/odcore/base/module/InterruptibleModule.h"
 #include "opendavinci/odcore/base/module/Periodic.h"
 #include "opendavinci/odcore/exceptions/Exceptions.h"
@@ -114,6 +115,24 @@ namespace odcore {
                         return m_profiling;
                     }
 
+                    /**
+                     * This method returns true, if --telemetry=1 is given.
+                     *
+                     * @return true if telemetry of the container conference is enabled.
+                     */
+                    inline bool isTelemetry() const {
+                        return m_telemetry;
+                    }
+
+                    /**
+                     * This method returns true, if --shm is enabled.
+                     *
+                     * @return true if containers shall be exchanged with local modules using shared memory.
+                     */
+                    inline bool isSharedMemoryTransport() const {
+                        return m_sharedMemoryTransport;
+                    }
+
                     /**
                      * This method returns true, if --realtime is enabled.
                      *
@@ -130,6 +149,22 @@ namespace odcore {
                      */
                     uint32_t getRealtimePriority() const;
 
+                    /**
+                     * This method returns the policy for missed deadlines
+                     * as specified by --overrun=skip|burst|stretch.
+                     *
+                     * @return Overrun policy (default: stretch).
+                     */
+                    DeadlineScheduler::OVERRUNPOLICY getOverrunPolicy() const;
+
+                    /**
+                     * This method returns the time to busy-wait before the
+                     * next time slice as specified by --busywait.
+                     *
+                     * @return Busy-wait tail in microseconds (default: 0).
+                     */
+                    uint32_t getBusyWait() const;
+
                     virtual void waitForNextFullSecond(const uint32_t &secondsIncrement);
 
                 private:
@@ -140,8 +175,12 @@ namespace odcore {
                     string m_multicastGroup;
                     uint32_t m_CID;
                     bool m_profiling;
+                    bool m_telemetry;
+                    bool m_sharedMemoryTransport;
                     bool m_realtime;
                     uint32_t m_realtimePriority;
+                    DeadlineScheduler::OVERRUNPOLICY m_overrunPolicy;
+                    uint32_t m_busyWait;
 
                     /**
                      * This method tries to parse the identifier.
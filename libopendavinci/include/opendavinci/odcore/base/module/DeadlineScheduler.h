@@ -0,0 +1,200 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_BASE_MODULE_DEADLINESCHEDULER_H_
+#define OPENDAVINCI_CORE_BASE_MODULE_DEADLINESCHEDULER_H_
+
+#include <string>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+
+namespace odcore {
+    namespace base {
+        namespace module {
+
+            using namespace std;
+
+            /**
+             * This class schedules periodic time slices at absolute deadlines
+             * on the monotonic clock. In contrast to sleeping relatively for
+             * the remainder of a time slice, the deadlines do not drift as
+             * the time for computing the sleep is not accumulated.
+             *
+             * Optionally, the last microseconds before a deadline are spent
+             * busy-waiting to compensate the wake-up latency of the operating
+             * system. The scheduler detects overruns (i.e. the deadline has
+             * already passed when waiting) and handles them according to an
+             * OVERRUNPOLICY. The wake-up jitter is collected in a histogram.
+             */
+            class OPENDAVINCI_API DeadlineScheduler {
+                public:
+                    enum OVERRUNPOLICY {
+                        SKIP = 0,    // Drop the missed time slices and continue with the next one on the original grid.
+                        BURST = 1,   // Run the missed time slices back to back until the schedule is caught up.
+                        STRETCH = 2, // Start the next time slice immediately and restart the grid from now (default).
+                    };
+
+                    enum {
+                        NUMBER_OF_HISTOGRAM_BINS = 12,
+                        MAX_BURST_CYCLES = 10, // BURST restarts the grid from now when being further behind.
+                    };
+
+                private:
+                    /**
+                     * "Forbidden" copy constructor. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the copy constructor.
+                     */
+                    DeadlineScheduler(const DeadlineScheduler &);
+
+                    /**
+                     * "Forbidden" assignment operator. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the assignment operator.
+                     */
+                    DeadlineScheduler& operator=(const DeadlineScheduler &);
+
+                public:
+                    DeadlineScheduler();
+
+                    virtual ~DeadlineScheduler();
+
+                    /**
+                     * This method sets the duration of one time slice.
+                     *
+                     * @param microseconds Period in microseconds.
+                     */
+                    void setPeriod(const int64_t &microseconds);
+
+                    int64_t getPeriod() const;
+
+                    /**
+                     * This method sets the time before a deadline that is
+                     * spent busy-waiting instead of sleeping.
+                     *
+                     * @param microseconds Busy-wait tail in microseconds (0 disables busy-waiting).
+                     */
+                    void setBusyWait(const int64_t &microseconds);
+
+                    int64_t getBusyWait() const;
+
+                    void setOverrunPolicy(const OVERRUNPOLICY &policy);
+
+                    OVERRUNPOLICY getOverrunPolicy() const;
+
+                    /**
+                     * This method starts the schedule; the first deadline is
+                     * one period from now.
+                     */
+                    void start();
+
+                    /**
+                     * @return true if start() was called.
+                     */
+                    bool isStarted() const;
+
+                    /**
+                     * This method suspends the calling thread until the next
+                     * deadline.
+                     *
+                     * @return true if the deadline was already missed.
+                     */
+                    bool waitForNextDeadline();
+
+                    /**
+                     * @return Time in microseconds actually spent in the last call of waitForNextDeadline().
+                     */
+                    int64_t getLastWaitTime() const;
+
+                    /**
+                     * @return Number of missed deadlines since the last reset.
+                     */
+                    uint32_t getNumberOfOverruns() const;
+
+                    /**
+                     * @return Number of time slices dropped by the policy SKIP since the last reset.
+                     */
+                    uint32_t getNumberOfSkippedCycles() const;
+
+                    /**
+                     * @return Mean wake-up jitter in microseconds since the last reset.
+                     */
+                    double getMeanJitter() const;
+
+                    /**
+                     * @return Maximum wake-up jitter in microseconds since the last reset.
+                     */
+                    double getMaxJitter() const;
+
+                    /**
+                     * This method returns the histogram of the wake-up jitter.
+                     * The upper bounds of the bins are 1, 2, 5, 10, 20, 50, 100,
+                     * 200, 500, 1000, and 2000 microseconds; the last bin
+                     * collects everything above.
+                     *
+                     * @return Histogram with NUMBER_OF_HISTOGRAM_BINS entries.
+                     */
+                    vector<uint32_t> getJitterHistogram() const;
+
+                    /**
+                     * This method resets the overrun and jitter statistics.
+                     */
+                    void resetStatistics();
+
+                    /**
+                     * This method parses the name of an overrun policy.
+                     *
+                     * @param name skip, burst, or stretch.
+                     * @param policy Parsed policy.
+                     * @return true if the name is valid.
+                     */
+                    static bool parseOverrunPolicy(const string &name, OVERRUNPOLICY &policy);
+
+                private:
+                    /**
+                     * This method sleeps and busy-waits until the given
+                     * deadline and records the jitter.
+                     *
+                     * @param deadline Monotonic time in nanoseconds.
+                     */
+                    void waitUntil(const int64_t &deadline);
+
+                    void addJitter(const int64_t &jitter);
+
+                private:
+                    int64_t m_period;
+                    int64_t m_busyWait;
+                    OVERRUNPOLICY m_overrunPolicy;
+                    int64_t m_nextDeadline;
+                    int64_t m_lastWaitTime;
+
+                    uint32_t m_numberOfOverruns;
+                    uint32_t m_numberOfSkippedCycles;
+                    uint32_t m_numberOfJitterSamples;
+                    int64_t m_sumOfJitter;
+                    int64_t m_maxJitter;
+                    vector<uint32_t> m_jitterHistogram;
+            };
+
+        }
+    }
+} // odcore::base::module
+
+#endif /*OPENDAVINCI_CORE_BASE_MODULE_DEADLINESCHEDULER_H_*/
@@ -27,6 +27,7 @@
 #include <memory>
 #include "opendavinci/odcore/base/module/Breakpoint.h"
 #include "opendavinci/odcore/base/module/ClientModule.h"
+#include "opendavinci/odcore/base/module/DeadlineScheduler.h"
 #include "opendavinci/odcore/data/TimeStamp.h"
 #include "opendavinci/odcore/exceptions/Exceptions.h"
 #include "opendavinci/odcore/io/conference/ContainerConference.h"
@@ -123,6 +124,7 @@ namespace odcore {
                     odcore::data::dmcp::ModuleExitCodeMessage::ModuleExitCode runModuleImplementation_ManagedLevel_None();
                     void wait_ManagedLevel_None();
                     void wait_ManagedLevel_None_realtime();
+                    void startScheduler();
 
                     odcore::data::dmcp::ModuleExitCodeMessage::ModuleExitCode runModuleImplementation_ManagedLevel_Pulse();
                     void wait_ManagedLevel_Pulse();
@@ -147,25 +149,12 @@ namespace odcore {
                     /**
                      * This method calculates the waiting time in microseconds
                      * to complete this execution cycle. Furthermore, it updates
-                     * RuntimeStatistics and local profiling data.
+                     * RuntimeStatistics.
                      *
                      * @return waiting time in microseconds.
                      */
                     uint32_t getWaitingTimeAndUpdateRuntimeStatistics();
 
-                    /**
-                     * This method is used to log the time consumption (load)
-                     * for this module into a profiling file.
-                     */
-                    void logProfilingData(const odcore::data::TimeStamp &current,
-                                          const odcore::data::TimeStamp &lastCycle,
-                                          const float &freq,
-                                          const long &lastWaitTime,
-                                          const long &timeConsumptionCurrent,
-                                          const long &nominalDuration,
-                                          const long &waitingTimeCurrent,
-                                          const int32_t &cycleCounter);
-
                 protected:
                     /**
                      * This method sets the ContainerConference to be used. In the case
@@ -197,9 +186,11 @@ namespace odcore {
                     odcore::data::TimeStamp m_startOfCurrentCycle;
                     odcore::data::TimeStamp m_startOfLastCycle;
                     odcore::data::TimeStamp m_lastCycle;
+                    int64_t m_lastCycleMonotonic;
                     long m_lastWaitTime;
                     int32_t m_cycleCounter;
-                    ofstream *m_profilingFile;
+                    bool m_isProfiling;
+                    DeadlineScheduler m_scheduler;
 
                     bool m_firstCallToBreakpoint_ManagedLevel_Pulse;
 
@@ -24,6 +24,7 @@
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/data/ContainerBatch.h"
 #include "opendavinci/odcore/io/conference/ContainerConference.h"
 
 namespace odcore {
@@ -75,8 +76,16 @@ namespace odcore {
                      */
                     vector<odcore::data::Container> getListOfContainers() const;
 
+                    /**
+                     * This message returns the containers to be transferred from a connected
+                     * module to supercomponent in their serialized form.
+                     *
+                     * @return Batch of containers to be transferred to supercomponent.
+                     */
+                    const odcore::data::ContainerBatch& getContainerBatch() const;
+
                 private:
-                    vector<odcore::data::Container> m_listOfContainersToBeDelivered;
+                    odcore::data::ContainerBatch m_containersToBeDelivered;
             };
 
         }
@@ -0,0 +1,181 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_DATA_COMPACTPOINTCLOUDDECODER_H_
+#define OPENDAVINCI_CORE_DATA_COMPACTPOINTCLOUDDECODER_H_
+
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/generated/odcore/data/CompactPointCloud.h"
+
+namespace odcore {
+    namespace data {
+
+        using namespace std;
+
+        /**
+         * This class decodes CompactPointCloud containers from a
+         * Velodyne VLP-16 (16 entries per azimuth) or HDL-32E (one of
+         * the three parts with 12, 11, or 9 entries per azimuth) into
+         * distances, angles, Cartesian coordinates, and intensities.
+         *
+         * The sine and cosine values of the vertical angles are
+         * precomputed per layer; the sine and cosine values of the
+         * azimuths are computed once per azimuth and the conversion
+         * to Cartesian coordinates is vectorized. Points with a
+         * distance of 1m or less are discarded.
+         *
+         * The decoded points are appended to a PointBuffer that is
+         * owned by the caller and can be reused between scans:
+         *
+         * @code
+         * CompactPointCloudDecoder decoder;
+         * CompactPointCloudDecoder::PointBuffer points;
+         * ...
+         * points.clear();
+         * decoder.decode(cpc, points);
+         * for (uint32_t i = 0; i < points.size(); i++) {
+         *     ... points.m_x[i], points.m_y[i], points.m_z[i] ...
+         * }
+         * @endcode
+         */
+        class OPENDAVINCI_API CompactPointCloudDecoder {
+            public:
+                /**
+                 * Decoded points as structure of arrays. Angles are
+                 * in DEG, distances and coordinates in m, and
+                 * intensities are normalized to [0, 1].
+                 */
+                class OPENDAVINCI_API PointBuffer {
+                    public:
+                        PointBuffer();
+
+                        /**
+                         * This method removes all points but keeps the
+                         * allocated memory.
+                         */
+                        void clear();
+
+                        /**
+                         * @return Number of points.
+                         */
+                        uint32_t size() const;
+
+                        /**
+                         * This method changes the number of points.
+                         *
+                         * @param numberOfPoints New number of points.
+                         */
+                        void resize(const uint32_t &numberOfPoints);
+
+                    public:
+                        vector<float> m_distance;
+                        vector<float> m_azimuth;
+                        vector<float> m_verticalAngle;
+                        vector<float> m_x;
+                        vector<float> m_y;
+                        vector<float> m_z;
+                        vector<float> m_intensity;
+                };
+
+            private:
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 */
+                CompactPointCloudDecoder(const CompactPointCloudDecoder &);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 */
+                CompactPointCloudDecoder& operator=(const CompactPointCloudDecoder &);
+
+            public:
+                CompactPointCloudDecoder();
+
+                virtual ~CompactPointCloudDecoder();
+
+                /**
+                 * This method decodes the given CompactPointCloud and
+                 * appends the points to the given buffer.
+                 *
+                 * @param cpc CompactPointCloud to decode.
+                 * @param points Buffer to append the decoded points to.
+                 * @param isNetworkByteOrder true if the distances are stored in network byte order (recordings since 2017), false for host byte order.
+                 * @return Number of appended points; 0 if the number of entries per azimuth is not supported.
+                 */
+                uint32_t decode(const CompactPointCloud &cpc, PointBuffer &points, const bool &isNetworkByteOrder = true);
+
+                /**
+                 * This method returns the vertical angles for the
+                 * given number of entries per azimuth.
+                 *
+                 * @param entriesPerAzimuth Number of entries per azimuth.
+                 * @return Vertical angles in DEG in the order of the entries; empty if not supported.
+                 */
+                const vector<float>& getVerticalAngles(const uint8_t &entriesPerAzimuth) const;
+
+            private:
+                struct Layers {
+                    Layers() :
+                        m_verticalAngles(),
+                        m_sinVerticalAngles(),
+                        m_cosVerticalAngles() {}
+
+                    vector<float> m_verticalAngles;
+                    vector<float> m_sinVerticalAngles;
+                    vector<float> m_cosVerticalAngles;
+                };
+
+                /**
+                 * This method sets the vertical angles of the given layers
+                 * and precomputes their sine and cosine values.
+                 *
+                 * @param layers Layers to set.
+                 * @param verticalAngles Vertical angles in DEG.
+                 */
+                static void setVerticalAngles(Layers &layers, const vector<float> &verticalAngles);
+
+                /**
+                 * @return Layers for the given number of entries per azimuth or NULL.
+                 */
+                const Layers* getLayers(const uint8_t &entriesPerAzimuth) const;
+
+            private:
+                Layers m_vlp16;
+                Layers m_hdl32Part1;
+                Layers m_hdl32Part2;
+                Layers m_hdl32Part3;
+                Layers m_unsupported;
+
+                // Temporary buffers for the vectorized conversion.
+                vector<float> m_sinAzimuths;
+                vector<float> m_cosAzimuths;
+                vector<float> m_sinVerticalAngles;
+                vector<float> m_cosVerticalAngles;
+        };
+
+    }
+} // odcore::data
+
+#endif /*OPENDAVINCI_CORE_DATA_COMPACTPOINTCLOUDDECODER_H_*/
@@ -111,6 +111,15 @@ class SerializableData;
                     return containerData;
                 }
 
+                /**
+                 * This method returns the serialized data without
+                 * deserializing it, e.g. to extract single fields
+                 * with a FieldAccessor.
+                 *
+                 * @return Serialized data contained in this container.
+                 */
+                const string getRawData() const;
+
                 /**
                  * This method returns the time stamp when this
                  * container was sent.
@@ -0,0 +1,122 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_DATA_CONTAINERBATCH_H_
+#define OPENDAVINCI_CORE_DATA_CONTAINERBATCH_H_
+
+#include <string>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/data/Container.h"
+
+namespace odcore {
+    namespace data {
+
+        using namespace std;
+
+        /**
+         * This class stores a list of containers as the concatenation of
+         * their serialized representations (0x0D 0xA4 A B C <payload>).
+         * Thus, batches can be forwarded and merged without deserializing
+         * and serializing the contained containers again.
+         */
+        class OPENDAVINCI_API ContainerBatch {
+            public:
+                ContainerBatch();
+
+                /**
+                 * Constructor.
+                 *
+                 * @param rawData Serialized containers; incomplete trailing data is discarded.
+                 */
+                ContainerBatch(const string &rawData);
+
+                /**
+                 * Constructor.
+                 *
+                 * @param listOfContainers Containers to be serialized.
+                 */
+                ContainerBatch(const vector<Container> &listOfContainers);
+
+                virtual ~ContainerBatch();
+
+                /**
+                 * This method serializes and appends a container.
+                 *
+                 * @param c Container to be appended.
+                 */
+                void add(const Container &c);
+
+                /**
+                 * This method appends all containers from the given batch
+                 * without deserializing them.
+                 *
+                 * @param batch Batch to be appended.
+                 */
+                void append(const ContainerBatch &batch);
+
+                /**
+                 * This method reserves memory for the serialized containers.
+                 *
+                 * @param bytes Number of bytes.
+                 */
+                void reserve(const uint32_t &bytes);
+
+                void clear();
+
+                bool isEmpty() const;
+
+                /**
+                 * @return Number of containers in this batch.
+                 */
+                uint32_t getNumberOfContainers() const;
+
+                /**
+                 * @return Serialized containers.
+                 */
+                const string& getRawData() const;
+
+                /**
+                 * This method deserializes all containers.
+                 *
+                 * @return List of containers.
+                 */
+                vector<Container> getListOfContainers() const;
+
+            private:
+                /**
+                 * This method returns the size of the serialized container
+                 * starting at the given position.
+                 *
+                 * @param rawData Serialized containers.
+                 * @param position Start of the container.
+                 * @return Size including the header or 0 if the data is invalid or incomplete.
+                 */
+                static uint32_t getSizeOfContainer(const string &rawData, const uint32_t &position);
+
+            private:
+                string m_rawData;
+                uint32_t m_numberOfContainers;
+        };
+
+    }
+} // odcore::data
+
+#endif /*OPENDAVINCI_CORE_DATA_CONTAINERBATCH_H_*/
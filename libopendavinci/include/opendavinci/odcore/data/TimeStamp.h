@@ -20,6 +20,7 @@
 #ifndef OPENDAVINCI_CORE_DATA_TIMESTAMP_H_
 #define OPENDAVINCI_CORE_DATA_TIMESTAMP_H_
 
+#include <ctime>
 #include <string>
 
 #include "opendavinci/generated/odcore/data/TimePoint.h"
@@ -36,9 +37,6 @@ namespace odcore {
          * This class can be used for time computations.
          */
         class OPENDAVINCI_API TimeStamp : public odcore::data::TimePoint {
-            private:
-                friend class Container;
-
             private:
                 enum CUMULATIVE_DAYS {
                     January = 31,   // 31
@@ -227,17 +225,12 @@ namespace odcore {
                 bool isLeapYear(const uint32_t &year) const;
 
                 /**
-                 * This methods computes the human readable representation.
+                 * This methods computes the human readable representation
+                 * on demand as it is rarely needed but expensive.
+                 *
+                 * @param readable Local time to fill.
                  */
-                void computeHumanReadableRepresentation();
-
-            private:
-                uint32_t m_readableYear;
-                uint32_t m_readableMonth;
-                uint32_t m_readableDayOfMonth;
-                uint32_t m_readableHours;
-                uint32_t m_readableMinutes;
-                uint32_t m_readableSeconds;
+                void computeHumanReadableRepresentation(struct tm &readable) const;
         };
 
     }
@@ -26,6 +26,7 @@
 #include "opendavinci/odcore/base/Condition.h"
 #include "opendavinci/odcore/base/KeyValueConfiguration.h"
 #include "opendavinci/odcore/base/Mutex.h"
+#include "opendavinci/odcore/data/ContainerBatch.h"
 #include "opendavinci/odcore/io/Connection.h"
 #include "opendavinci/odcore/io/ConnectionErrorListener.h"
 #include "opendavinci/odcore/io/conference/ContainerListener.h"
@@ -93,6 +94,14 @@ namespace odcore {
                      */
                     void sendPulseAckContainers(const vector<odcore::data::Container> &listOfContainers);
 
+                    /**
+                     * This method sends the PulseAckMessage to supercomponent
+                     * including all containers to be sent from this component.
+                     *
+                     * @param batch Serialized containers to be sent.
+                     */
+                    void sendPulseAckContainers(const odcore::data::ContainerBatch &batch);
+
                     void setSupercomponentStateListener(SupercomponentStateListener* listener);
 
                     bool isConnected();
@@ -27,6 +27,7 @@
 #include "opendavinci/odcore/base/Condition.h"
 #include "opendavinci/odcore/base/Mutex.h"
 #include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/data/ContainerBatch.h"
 #include "opendavinci/odcore/io/Connection.h"
 #include "opendavinci/odcore/io/ConnectionErrorListener.h"
 #include "opendavinci/odcore/io/conference/ContainerListener.h"
@@ -98,7 +99,18 @@ namespace odcore {
                      * @param timeout Timeout in milliseconds to wait for the ACK message.
                      * @return Containers to be transferred to supercomponent.
                      */
-                    vector<odcore::data::Container> pulse_ack_containers(const odcore::data::dmcp::PulseMessage &pm, const uint32_t &timeout);
+                    odcore::data::ContainerBatch pulse_ack_containers(const odcore::data::dmcp::PulseMessage &pm, const uint32_t &timeout);
+
+                    /**
+                     * This method is the same as the one above but sends an
+                     * already serialized pulse to allow sending the same
+                     * pulse to several modules without serializing it again.
+                     *
+                     * @param pulse Container with the pulse to be sent.
+                     * @param timeout Timeout in milliseconds to wait for the ACK message.
+                     * @return Containers to be transferred to supercomponent.
+                     */
+                    odcore::data::ContainerBatch pulse_ack_containers(odcore::data::Container &pulse, const uint32_t &timeout);
 
                     const odcore::data::dmcp::ModuleDescriptor getModuleDescriptor() const;
 
@@ -125,7 +137,7 @@ namespace odcore {
                     ModuleStateListener* m_stateListener;
                     odcore::base::Mutex m_stateListenerMutex;
 
-                    vector<odcore::data::Container> m_containersToBeTransferredToSupercomponent;
+                    odcore::data::ContainerBatch m_containersToBeTransferredToSupercomponent;
             };
         }
     }
@@ -20,8 +20,11 @@
 #ifndef OPENDAVINCI_CORE_IO_CONFERENCE_CONTAINERCONFERENCE_H_
 #define OPENDAVINCI_CORE_IO_CONFERENCE_CONTAINERCONFERENCE_H_
 
+#include <atomic>
+
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/base/Mutex.h"
+#include "opendavinci/odcore/io/conference/ContainerConferenceTelemetry.h"
 #include "opendavinci/odcore/io/conference/ContainerObserver.h"
 
 namespace odcore { namespace data { class Container; } }
@@ -97,6 +100,26 @@ class ContainerListener;
                      */
                     uint32_t getSenderStamp() const;
 
+                    /**
+                     * This method enables or disables counting the sent and
+                     * received containers for telemetry.
+                     *
+                     * @param enabled true to enable telemetry.
+                     */
+                    void setTelemetryEnabled(const bool &enabled);
+
+                    /**
+                     * @return true if telemetry is enabled.
+                     */
+                    bool isTelemetryEnabled() const;
+
+                    /**
+                     * This method returns the telemetry of this conference.
+                     *
+                     * @return Telemetry.
+                     */
+                    ContainerConferenceTelemetry& getTelemetry() const;
+
                 protected:
                     /**
                      * This method can be called from any subclass to distribute
@@ -119,6 +142,9 @@ class ContainerListener;
 
                     mutable base::Mutex m_senderStampMutex;
                     uint32_t m_senderStamp;
+
+                    std::atomic<bool> m_telemetryEnabled;
+                    mutable ContainerConferenceTelemetry m_telemetry;
             };
 
         }
@@ -43,6 +43,11 @@ class ContainerConference;
                         MULTICAST_PORT = 12175 // Mariposa Rd, Victorville.
                     };
 
+                    enum TRANSPORT {
+                        UDP_MULTICAST,
+                        SHARED_MEMORY // Shared memory for local participants and UDP multicast for all others.
+                    };
+
                 private:
                     /**
                      * "Forbidden" copy constructor. Goal: The compiler should warn
@@ -84,6 +89,17 @@ class ContainerConference;
                      */
                     virtual std::shared_ptr<ContainerConference> getContainerConference(const string &address, const uint32_t &port = ContainerConferenceFactory::MULTICAST_PORT);
 
+                    /**
+                     * This method sets the transport to be used for new
+                     * ContainerConferences. If shared memory is not available,
+                     * UDP multicast is used.
+                     *
+                     * @param transport Transport to be used (default: UDP_MULTICAST).
+                     */
+                    void setTransport(const TRANSPORT &transport);
+
+                    TRANSPORT getTransport() const;
+
                 protected:
                     /**
                      * This method sets the singleton pointer.
@@ -95,6 +111,8 @@ class ContainerConference;
                 private:
                     static base::Mutex m_singletonMutex;
                     static ContainerConferenceFactory* m_singleton;
+
+                    TRANSPORT m_transport;
             };
 
         }
@@ -0,0 +1,175 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_IO_CONFERENCE_CONTAINERCONFERENCETELEMETRY_H_
+#define OPENDAVINCI_CORE_IO_CONFERENCE_CONTAINERCONFERENCETELEMETRY_H_
+
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/generated/odcore/data/dmcp/ContainerStatistics.h"
+
+namespace odcore { namespace data { class Container; } }
+
+namespace odcore {
+    namespace io {
+        namespace conference {
+
+            using namespace std;
+
+            /**
+             * This class is a histogram with logarithmically growing buckets
+             * similar to an HDR histogram: Values below 32 are counted
+             * exactly; above, every power of two is split into 16 buckets
+             * resulting in a relative error below 7%.
+             */
+            class OPENDAVINCI_API LatencyHistogram {
+                public:
+                    enum {
+                        SUB_BUCKETS = 16,
+                        NUMBER_OF_BUCKETS = 2 * SUB_BUCKETS + 27 * SUB_BUCKETS, // Values up to 2^32; larger ones are counted in the last bucket.
+                    };
+
+                public:
+                    LatencyHistogram();
+
+                    /**
+                     * This method adds a value; negative values are counted as 0.
+                     *
+                     * @param value Value to add.
+                     */
+                    void add(const int64_t &value);
+
+                    /**
+                     * @param percentile Percentile in [0, 100].
+                     * @return Upper bound of the bucket containing the percentile.
+                     */
+                    int64_t getPercentile(const double &percentile) const;
+
+                    int64_t getMaximum() const;
+
+                    uint32_t getNumberOfSamples() const;
+
+                    void reset();
+
+                    static uint32_t getBucket(const int64_t &value);
+
+                    static int64_t getUpperBound(const uint32_t &bucket);
+
+                private:
+                    vector<uint32_t> m_buckets;
+                    uint32_t m_numberOfSamples;
+                    int64_t m_maximum;
+            };
+
+            /**
+             * This class counts sent, received, and dropped containers per
+             * data type and sender stamp and measures the time for
+             * (de-)serialization and the latency between sending and
+             * receiving. The latency is computed from the containers' sent
+             * and received time stamps; thus, it is only meaningful for
+             * synchronized clocks across hosts.
+             */
+            class OPENDAVINCI_API ContainerConferenceTelemetry {
+                private:
+                    /**
+                     * "Forbidden" copy constructor. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the copy constructor.
+                     */
+                    ContainerConferenceTelemetry(const ContainerConferenceTelemetry &);
+
+                    /**
+                     * "Forbidden" assignment operator. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the assignment operator.
+                     */
+                    ContainerConferenceTelemetry& operator=(const ContainerConferenceTelemetry &);
+
+                public:
+                    ContainerConferenceTelemetry();
+
+                    virtual ~ContainerConferenceTelemetry();
+
+                    /**
+                     * This method counts a sent container.
+                     *
+                     * @param c Sent container.
+                     * @param bytes Size of the serialized container.
+                     * @param serializationTime Time for serializing in nanoseconds.
+                     */
+                    void countSent(const odcore::data::Container &c, const uint32_t &bytes, const int64_t &serializationTime);
+
+                    /**
+                     * This method counts a received container.
+                     *
+                     * @param c Received container with sent and received time stamps.
+                     * @param bytes Size of the serialized container.
+                     * @param deserializationTime Time for deserializing in nanoseconds.
+                     */
+                    void countReceived(const odcore::data::Container &c, const uint32_t &bytes, const int64_t &deserializationTime);
+
+                    /**
+                     * This method counts a received container that could
+                     * not be delivered.
+                     *
+                     * @param c Dropped container.
+                     */
+                    void countDropped(const odcore::data::Container &c);
+
+                    /**
+                     * This method returns the statistics since the last call
+                     * and resets all counters.
+                     *
+                     * @return Statistics per data type and sender stamp.
+                     */
+                    odcore::data::dmcp::ContainerStatistics getStatisticsAndReset();
+
+                private:
+                    class Entry {
+                        public:
+                            Entry();
+
+                        public:
+                            uint32_t m_numberOfSentContainers;
+                            uint64_t m_numberOfSentBytes;
+                            int64_t m_serializationTime;
+                            uint32_t m_numberOfReceivedContainers;
+                            uint64_t m_numberOfReceivedBytes;
+                            int64_t m_deserializationTime;
+                            uint32_t m_numberOfDroppedContainers;
+                            LatencyHistogram m_latency;
+                    };
+
+                    Entry& getEntry(const odcore::data::Container &c);
+
+                private:
+                    std::mutex m_entriesMutex;
+                    map<pair<int32_t, uint32_t>, Entry> m_entries;
+                    int64_t m_startOfPeriod;
+            };
+
+        }
+    }
+} // odcore::io::conference
+
+#endif /*OPENDAVINCI_CORE_IO_CONFERENCE_CONTAINERCONFERENCETELEMETRY_H_*/
@@ -0,0 +1,156 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_IO_CONFERENCE_SHAREDMEMORYCONTAINERCONFERENCE_H_
+#define OPENDAVINCI_CORE_IO_CONFERENCE_SHAREDMEMORYCONTAINERCONFERENCE_H_
+
+#include <atomic>
+#include <string>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Service.h"
+#include "opendavinci/odcore/exceptions/Exceptions.h"
+#include "opendavinci/odcore/io/conference/UDPMultiCastContainerConference.h"
+
+namespace odcore {
+    namespace io {
+        namespace conference {
+
+            using namespace std;
+
+            /**
+             * This class extends the UDP multicast conference by a
+             * shared memory ring buffer for all participants that are
+             * running on the same machine. Every container is written
+             * once into the ring and all local participants are woken
+             * up (using a futex on Linux); thus, local receivers do not
+             * need any system call for receiving and deserializing a
+             * container.
+             *
+             * Containers are still sent using UDP multicast to reach
+             * participants on other machines and local participants
+             * that do not use shared memory. The local UDP sender ports
+             * of all shared memory participants are registered in the
+             * shared memory segment so that their UDP packets are ignored
+             * by the local participants to avoid duplicates.
+             */
+            class OPENDAVINCI_API SharedMemoryContainerConference : public UDPMultiCastContainerConference, public odcore::base::Service {
+                private:
+                    friend class ContainerConferenceFactory;
+
+                    /**
+                     * Layout of the shared memory segment.
+                     */
+                    struct Segment;
+
+                private:
+                    /**
+                     * "Forbidden" copy constructor. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the copy constructor.
+                     */
+                    SharedMemoryContainerConference(const SharedMemoryContainerConference &);
+
+                    /**
+                     * "Forbidden" assignment operator. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the assignment operator.
+                     */
+                    SharedMemoryContainerConference& operator=(const SharedMemoryContainerConference &);
+
+                protected:
+                    /**
+                     * Constructor.
+                     *
+                     * @param address Use address for joining.
+                     * @param port Use port for joining.
+                     * @throws ConferenceException if the conference could not be created.
+                     */
+                    SharedMemoryContainerConference(const string &address, const uint32_t &port) throw (exceptions::ConferenceException);
+
+                public:
+                    virtual ~SharedMemoryContainerConference();
+
+                    /**
+                     * @return Name of the shared memory segment used for the given conference.
+                     */
+                    static string getName(const string &address, const uint32_t &port);
+
+                    /**
+                     * @return Number of containers that were overwritten before they could be read.
+                     */
+                    uint64_t getNumberOfOverrunContainers() const;
+
+                protected:
+                    virtual void sendSerializedContainer(const string &data) const;
+
+                    virtual void beforeStop();
+
+                    virtual void run();
+
+                private:
+                    /**
+                     * This method registers this participant in the shared memory segment.
+                     */
+                    void join();
+
+                    /**
+                     * This method unregisters this participant from the shared memory segment.
+                     */
+                    void leave();
+
+                    /**
+                     * This method unmaps and closes the shared memory segment.
+                     */
+                    void detach();
+
+                    /**
+                     * This method updates the UDP ports to be ignored if
+                     * the participants in the shared memory segment changed.
+                     */
+                    void updateSenderPortsToIgnore();
+
+                    /**
+                     * This method wakes up all waiting participants.
+                     */
+                    void wakeUp() const;
+
+                    /**
+                     * This method waits until a new container is written
+                     * or the timeout expired.
+                     *
+                     * @param wakeUpCounter Value of the wake up counter before checking for new containers.
+                     */
+                    void waitForNextContainer(const uint32_t &wakeUpCounter);
+
+                private:
+                    string m_name;
+                    int32_t m_fd;
+                    Segment *m_segment;
+                    int32_t m_participant;
+                    uint32_t m_participantsVersion;
+                    uint64_t m_readIndex;
+                    std::atomic<uint64_t> m_numberOfOverrunContainers;
+            };
+
+        }
+    }
+} // odcore::io::conference
+
+#endif /*OPENDAVINCI_CORE_IO_CONFERENCE_SHAREDMEMORYCONTAINERCONFERENCE_H_*/
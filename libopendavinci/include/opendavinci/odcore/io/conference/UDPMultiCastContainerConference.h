@@ -22,6 +22,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/exceptions/Exceptions.h"
@@ -31,6 +32,7 @@
 #include "opendavinci/odcore/io/udp/UDPSender.h"
 
 namespace odcore { namespace data { class Container; } }
+namespace odcore { namespace data { class TimeStamp; } }
 
 namespace odcore {
     namespace io {
@@ -81,6 +83,37 @@ namespace odcore {
 
                     virtual void send(odcore::data::Container &container) const;
 
+                protected:
+                    /**
+                     * This method decodes a serialized container and
+                     * distributes it to the registered ContainerListener.
+                     *
+                     * @param data Serialized container.
+                     * @param received Time stamp when the data was received.
+                     */
+                    void receiveSerializedContainer(const string &data, const odcore::data::TimeStamp &received);
+
+                    /**
+                     * This method transmits a serialized container. Subclasses
+                     * can override this method to use further transports.
+                     *
+                     * @param data Serialized container.
+                     */
+                    virtual void sendSerializedContainer(const string &data) const;
+
+                    /**
+                     * @return Local port used for sending UDP packets.
+                     */
+                    uint16_t getSenderPort() const;
+
+                    /**
+                     * This method sets the local ports of the UDP packets to be
+                     * ignored; the own sender port should always be contained.
+                     *
+                     * @param portsToIgnore Ports to ignore.
+                     */
+                    void setSenderPortsToIgnore(const vector<uint16_t> &portsToIgnore);
+
                 private:
                     std::shared_ptr<odcore::io::udp::UDPSender> m_sender;
                     std::shared_ptr<odcore::io::udp::UDPReceiver> m_receiver;
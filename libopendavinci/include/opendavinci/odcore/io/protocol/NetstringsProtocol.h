@@ -104,6 +104,11 @@ namespace odcore {
                     virtual void nextString(const string &s);
 
                 private:
+                    /**
+                     * This method decodes all complete Netstrings in place
+                     * from the buffered data; the decoded bytes are only
+                     * skipped and removed later at once when appending new data.
+                     */
                     void decodeNetstring();
 
                     /**
@@ -116,7 +121,9 @@ namespace odcore {
                     StringListener *m_stringListener;
 
                     odcore::base::Mutex m_partialDataMutex;
-                    stringstream m_partialData;
+                    string m_partialData;
+                    uint64_t m_partialDataBegin;
+                    string m_payload;
             };
 
         }
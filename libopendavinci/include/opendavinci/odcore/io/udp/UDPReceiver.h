@@ -20,6 +20,8 @@
 #ifndef OPENDAVINCI_CORE_IO_UDP_UDPRECEIVER_H_
 #define OPENDAVINCI_CORE_IO_UDP_UDPRECEIVER_H_
 
+#include <vector>
+
 #include "opendavinci/odcore/base/Mutex.h"
 #include "opendavinci/odcore/io/PacketObserver.h"
 #include "opendavinci/odcore/io/PacketPipeline.h"
@@ -137,6 +139,15 @@ namespace odcore {
                      */
                     virtual void setSenderPortToIgnore(const uint16_t &portToIgnore) = 0;
 
+                    /**
+                     * This method sets the ports to be ignored to receive from
+                     * if several processes on the same machine exchange their
+                     * data differently (e.g. using shared memory).
+                     *
+                     * @param portsToIgnore Ports to ignore.
+                     */
+                    virtual void setSenderPortsToIgnore(const vector<uint16_t> &portsToIgnore) = 0;
+
                 protected:
                     /**
                      * This method is called from deriving classes to
@@ -0,0 +1,230 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_REFLECTION_FIELDACCESSOR_H_
+#define OPENDAVINCI_CORE_REFLECTION_FIELDACCESSOR_H_
+
+#include <string>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/reflection/Message.h"
+#include "opendavinci/generated/odcore/data/reflection/AbstractField.h"
+
+namespace odcore { namespace data { class Container; } }
+
+namespace odcore {
+    namespace reflection {
+
+        using namespace std;
+
+        /**
+         * This class extracts a single field from the serialized
+         * payload of a Container without deserializing the entire
+         * data structure into a Message.
+         *
+         * A field path like "field", "field.subfield", or
+         * "LongName/field.subfield" is compiled once from a Message
+         * that was resolved for the data type to access; the
+         * compiled accessor consists of the sequence of field
+         * identifiers to follow through nested data structures and
+         * the type of the final field. Afterwards, the value is
+         * read by skipping over the Proto-encoded payload:
+         *
+         * @code
+         * FieldAccessor fa;
+         * ...
+         * if (!fa.isCompiled()) {
+         *     Message msg = messageResolver.resolve(c, successfullyMapped);
+         *     fa.compile(msg, "position.x");
+         * }
+         * bool extracted = false;
+         * double x = fa.getValue(c, extracted);
+         * @endcode
+         */
+        class OPENDAVINCI_API FieldAccessor {
+            public:
+                FieldAccessor();
+
+                /**
+                 * Copy constructor.
+                 *
+                 * @param obj Reference to an object of this class.
+                 */
+                FieldAccessor(const FieldAccessor &obj);
+
+                virtual ~FieldAccessor();
+
+                /**
+                 * Assignment operator.
+                 *
+                 * @param obj Reference to an object of this class.
+                 * @return Reference to this instance.
+                 */
+                FieldAccessor& operator=(const FieldAccessor &obj);
+
+                /**
+                 * This method compiles the given field path for the data
+                 * type described by the given message.
+                 *
+                 * @param msg Message resolved from a container of the data type to access.
+                 * @param fieldPath Short field names separated by '.', optionally prefixed by the message's long name and '/'.
+                 * @return true if the field path denotes a scalar or string field that is not a fixed array.
+                 */
+                bool compile(const Message &msg, const string &fieldPath);
+
+                /**
+                 * This method compiles accessors for all scalar and string
+                 * fields of the given message including the fields of
+                 * nested data structures in the order of their appearance.
+                 *
+                 * @param msg Message resolved from a container of the data type to access.
+                 * @return List of compiled accessors.
+                 */
+                static vector<FieldAccessor> compileAll(const Message &msg);
+
+                /**
+                 * This method compiles accessors for all scalar and string
+                 * fields of the given message including the fields of
+                 * nested data structures in the order of their appearance.
+                 *
+                 * @param msg Message resolved from a container of the data type to access.
+                 * @param isComplete Flag modified by this method indicating if every field of the message is covered by an accessor; fixed arrays, raw data, lists, and maps are not.
+                 * @return List of compiled accessors.
+                 */
+                static vector<FieldAccessor> compileAll(const Message &msg, bool &isComplete);
+
+                /**
+                 * @return true if this accessor was successfully compiled.
+                 */
+                bool isCompiled() const;
+
+                /**
+                 * @return Container data type identifier this accessor is bound to.
+                 */
+                int32_t getDataType() const;
+
+                /**
+                 * @return Short field names separated by '.'.
+                 */
+                const string getFieldPath() const;
+
+                /**
+                 * @return Data type of the accessed field.
+                 */
+                odcore::data::reflection::AbstractField::FIELDDATATYPE getFieldDataType() const;
+
+                /**
+                 * This method extracts the value of a scalar field from
+                 * the given container.
+                 *
+                 * @param c Container to extract the value from.
+                 * @param extracted Flag modified by this method indicating if the value was successfully extracted.
+                 * @return Extracted value.
+                 */
+                double getValue(const odcore::data::Container &c, bool &extracted) const;
+
+                /**
+                 * This method extracts the value of a scalar field from
+                 * the given serialized payload.
+                 *
+                 * @param payload Serialized data of a container.
+                 * @param extracted Flag modified by this method indicating if the value was successfully extracted.
+                 * @return Extracted value.
+                 */
+                double getValue(const string &payload, bool &extracted) const;
+
+                /**
+                 * This method extracts the value of a scalar or string
+                 * field from the given serialized payload and formats it
+                 * for displaying.
+                 *
+                 * @param payload Serialized data of a container.
+                 * @param extracted Flag modified by this method indicating if the value was successfully extracted.
+                 * @return Extracted value as string.
+                 */
+                const string getValueAsString(const string &payload, bool &extracted) const;
+
+            private:
+                /**
+                 * This method compiles accessors for all fields of the
+                 * given message recursively.
+                 */
+                static void compileAll(const Message &msg, const int32_t &dataType, const string &prefix, const vector<uint32_t> &identifiers, vector<FieldAccessor> &accessors, bool &isComplete);
+
+                /**
+                 * @return true if the given field is a scalar or string field that is not a fixed array.
+                 */
+                static bool isAccessible(const odcore::data::reflection::AbstractField &field);
+
+                /**
+                 * This method locates the encoded value of the accessed
+                 * field in the given payload.
+                 *
+                 * @param payload Serialized data of a container.
+                 * @param begin Start of the encoded value.
+                 * @param end End of the payload or of the encoded nested data structure.
+                 * @return true if the field was found.
+                 */
+                bool locate(const string &payload, const char* &begin, const char* &end) const;
+
+                /**
+                 * This method decodes a varint.
+                 *
+                 * @param begin Start of the varint; moved behind the varint.
+                 * @param end End of the buffer.
+                 * @param value Decoded value.
+                 * @return true if a complete varint was decoded.
+                 */
+                static bool decodeVarInt(const char* &begin, const char *end, uint64_t &value);
+
+                /**
+                 * This method decodes the value of an integral field
+                 * (including bool and char) and converts it into the
+                 * field's data type.
+                 *
+                 * @param begin Start of the encoded value.
+                 * @param end End of the buffer.
+                 * @param value Decoded value; values of UINT64_T fields are stored bitwise.
+                 * @return true if the value was decoded.
+                 */
+                bool decodeInteger(const char *begin, const char *end, int64_t &value) const;
+
+                /**
+                 * This method decodes a little endian float or double.
+                 *
+                 * @param begin Start of the encoded value.
+                 * @param end End of the buffer.
+                 * @param value Decoded value.
+                 * @return true if the value was decoded.
+                 */
+                bool decodeFloatingPoint(const char *begin, const char *end, double &value) const;
+
+            private:
+                int32_t m_dataType;
+                string m_fieldPath;
+                vector<uint32_t> m_identifiers;
+                odcore::data::reflection::AbstractField::FIELDDATATYPE m_fieldDataType;
+                bool m_compiled;
+        };
+
+    }
+} // odcore::reflection
+
+#endif /*OPENDAVINCI_CORE_REFLECTION_FIELDACCESSOR_H_*/
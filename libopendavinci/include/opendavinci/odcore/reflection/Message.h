@@ -124,6 +124,13 @@ namespace odcore {
                  */
                 uint32_t getNumberOfFields() const;
 
+                /**
+                 * This method returns the fields in the order they were added.
+                 *
+                 * @return List of fields.
+                 */
+                const vector<std::shared_ptr<odcore::data::reflection::AbstractField> >& getFields() const;
+
                 /**
                  * This method tries to find a field with the given identifier.
                  *
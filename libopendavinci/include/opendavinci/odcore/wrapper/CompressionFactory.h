@@ -22,6 +22,7 @@
 
 #include "opendavinci/odcore/opendavinci.h"
 #include <memory>
+#include <string>
 
 namespace odcore {
     namespace wrapper {
@@ -45,10 +46,19 @@ class DecompressedData;
          * }
          * @endcode
          *
+         * Files should be passed by their name instead as they are read
+         * in place without copying them:
+         *
+         * @code
+         * std::shared_ptr<DecompressedData> dd = CompressionFactory::getContents("zip-file");
+         * @endcode
+         *
          * @See CompressionFactoryWorker
          */
         struct OPENDAVINCI_API CompressionFactory {
             static std::shared_ptr<DecompressedData> getContents(istream &in);
+
+            static std::shared_ptr<DecompressedData> getContents(const string &fileName);
         };
 
     }
@@ -49,6 +49,15 @@ namespace odcore {
              * @return Compressed file based on the type of instance this factory is.
              */
             static DecompressedData* getContents(istream &in);
+
+            /**
+             * This method creates a DecompressedData object based on a given
+             * file that is read in place.
+             *
+             * @param fileName The file from which the compressed data should be read.
+             * @return Compressed file based on the type of instance this factory is.
+             */
+            static DecompressedData* getContents(const string &fileName);
         };
 
     }
@@ -25,6 +25,7 @@
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/io/tcp/TCPAcceptor.h"
 #include "opendavinci/odcore/wrapper/Runnable.h"
+#include "opendavinci/odcore/wrapper/POSIX/POSIXTCPReactor.h"
 
 namespace odcore { namespace io { namespace tcp { class TCPAcceptorListener; } } }
 namespace odcore { namespace io { namespace tcp { class TCPConnection; } } }
@@ -37,7 +38,12 @@ namespace odcore {
 
             using namespace std;
 
-            class POSIXTCPAcceptor : public odcore::io::tcp::TCPAcceptor, public Runnable {
+            /**
+             * This class accepts TCP connections. If the POSIXTCPReactor is
+             * available, the listening socket is registered there; otherwise,
+             * an own thread is used.
+             */
+            class POSIXTCPAcceptor : public odcore::io::tcp::TCPAcceptor, public Runnable, public POSIXTCPReactorHandler {
                 private:
                     static const int32_t BACKLOG = 100;
 
@@ -68,6 +74,8 @@ namespace odcore {
                     virtual bool isRunning();
                     virtual void run();
 
+                    virtual void handleEvents(const uint32_t &events);
+
                 protected:
                     void invokeAcceptorListener(std::shared_ptr<odcore::io::tcp::TCPConnection> connection);
 
@@ -78,6 +86,9 @@ namespace odcore {
 
                     int32_t m_fileDescriptor;
                     int32_t m_port;
+
+                    POSIXTCPReactor *m_reactor;
+                    uint64_t m_reactorId;
             };
 
         }
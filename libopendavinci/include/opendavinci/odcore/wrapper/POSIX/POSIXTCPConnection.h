@@ -20,12 +20,14 @@
 #ifndef OPENDAVINCI_CORE_WRAPPER_POSIXTCPCONNECTION_H_
 #define OPENDAVINCI_CORE_WRAPPER_POSIXTCPCONNECTION_H_
 
+#include <deque>
 #include <memory>
 #include <string>
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/io/tcp/TCPConnection.h"
 #include "opendavinci/odcore/wrapper/Runnable.h"
+#include "opendavinci/odcore/wrapper/POSIX/POSIXTCPReactor.h"
 
 namespace odcore { namespace wrapper { class Mutex; } }
 namespace odcore { namespace wrapper { class Thread; } }
@@ -36,7 +38,17 @@ namespace odcore {
 
             using namespace std;
 
-            class POSIXTCPConnection : public odcore::io::tcp::TCPConnection, public Runnable {
+            /**
+             * This class realizes a TCP connection. If the POSIXTCPReactor is
+             * available, the connection is served by the reactor's threads
+             * and sends that cannot be completed at once are queued and
+             * written when the socket becomes writable; otherwise, the
+             * connection uses its own thread for receiving. If the peer
+             * does not keep up and more than MAX_QUEUED_BYTES are queued,
+             * sending blocks until the queue has drained below this limit
+             * like on a blocking socket.
+             */
+            class POSIXTCPConnection : public odcore::io::tcp::TCPConnection, public Runnable, public POSIXTCPReactorHandler {
                 private:
                     /**
                      * "Forbidden" copy constructor. Goal: The compiler should warn
@@ -67,15 +79,59 @@ namespace odcore {
                     virtual bool isRunning();
                     virtual void run();
 
+                    virtual void handleEvents(const uint32_t &events);
+
                 protected:
                     void initialize();
 
+                    /**
+                     * This method sends data blocking until all bytes are written.
+                     *
+                     * @param data Data to send.
+                     * @return true if all data was sent.
+                     */
+                    bool sendBlocking(const std::string &data);
+
+                    /**
+                     * This method writes as much queued data as possible
+                     * without blocking (to be called with m_socketMutex locked).
+                     *
+                     * @return false in case of an error.
+                     */
+                    bool writeQueuedData();
+
+                    /**
+                     * This method waits until the queue can take the given
+                     * number of bytes (to be called with m_socketMutex locked;
+                     * the mutex is released while waiting).
+                     *
+                     * @param size Number of bytes to be queued.
+                     * @return false in case of an error.
+                     */
+                    bool waitForQueueCapacity(const uint64_t &size);
+
+                    /**
+                     * This method unregisters the connection from the reactor
+                     * and writes all remaining queued data.
+                     */
+                    void unregisterFromReactor();
+
                     unique_ptr<Thread> m_thread;
 
                     unique_ptr<Mutex> m_socketMutex;
                     int32_t m_fileDescriptor;
 
+                    POSIXTCPReactor *m_reactor;
+                    uint64_t m_reactorId;
+                    std::deque<std::string> m_queuedData;
+                    uint64_t m_queuedDataOffset;
+                    uint64_t m_numberOfQueuedBytes;
+
                     enum {BUFFER_SIZE = 65535};
+                    enum {MAX_READS_PER_EVENT = 16};
+                    enum {MAX_IOVECS = 64};
+                    enum {MAX_QUEUED_BYTES = 16 * 1024 * 1024};
+                    enum {BACKPRESSURE_TIMEOUT = 1000}; // ms
                     char m_buffer[BUFFER_SIZE];
                     std::string m_ip;
                     uint32_t m_port;
@@ -0,0 +1,212 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_WRAPPER_POSIXTCPREACTOR_H_
+#define OPENDAVINCI_CORE_WRAPPER_POSIXTCPREACTOR_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+
+namespace odcore {
+    namespace wrapper {
+        namespace POSIX {
+
+            using namespace std;
+
+            /**
+             * This interface is implemented by TCP connections and acceptors
+             * to get informed by the POSIXTCPReactor about pending events.
+             */
+            class POSIXTCPReactorHandler {
+                public:
+                    enum EVENTS {
+                        READABLE = 1,
+                        WRITABLE = 2,
+                        FAILED = 4,
+                    };
+
+                    virtual ~POSIXTCPReactorHandler();
+
+                    /**
+                     * This method is called from one of the reactor's threads;
+                     * it is never called concurrently for the same handler.
+                     *
+                     * @param events Bitmask of EVENTS.
+                     */
+                    virtual void handleEvents(const uint32_t &events) = 0;
+            };
+
+            /**
+             * This class multiplexes all TCP connections and acceptors of a
+             * process using epoll and a small pool of threads instead of one
+             * thread per connection. The number of threads is read from the
+             * environment variable OPENDAVINCI_TCP_REACTOR_THREADS (default:
+             * number of cores, between 2 and 4); 0 disables the reactor. The
+             * reactor is only available on Linux.
+             *
+             * StringListeners and ConnectionListeners are called from the
+             * reactor's threads. While a listener is busy, its thread does
+             * not serve other connections; thus, listeners should return
+             * quickly, and a single thread lets one slow listener stall all
+             * connections of the process.
+             */
+            class POSIXTCPReactor {
+                private:
+                    /**
+                     * "Forbidden" copy constructor. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the copy constructor.
+                     */
+                    POSIXTCPReactor(const POSIXTCPReactor &);
+
+                    /**
+                     * "Forbidden" assignment operator. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the assignment operator.
+                     */
+                    POSIXTCPReactor& operator=(const POSIXTCPReactor &);
+
+                private:
+                    POSIXTCPReactor(const uint32_t &numberOfThreads);
+
+                public:
+                    virtual ~POSIXTCPReactor();
+
+                    enum {
+                        MAX_THREADS = 64,
+                        MIN_DEFAULT_THREADS = 2,
+                        MAX_DEFAULT_THREADS = 4,
+                        MAX_EVENTS = 64,
+                    };
+
+                    /**
+                     * @return Reactor or NULL if the reactor is not available or disabled.
+                     */
+                    static POSIXTCPReactor* getInstance();
+
+                    /**
+                     * This method registers a file descriptor for reading.
+                     *
+                     * @param fileDescriptor Non-blocking file descriptor.
+                     * @param handler Handler to be called for events.
+                     * @param isAcceptor true if the file descriptor is a listening socket.
+                     * @return Identifier for the registration or 0 in case of an error.
+                     */
+                    uint64_t add(const int32_t &fileDescriptor, POSIXTCPReactorHandler *handler, const bool &isAcceptor);
+
+                    /**
+                     * This method enables or disables the WRITABLE event for a
+                     * registration.
+                     *
+                     * @param id Identifier of the registration.
+                     * @param writable true to get informed about writability.
+                     */
+                    void setWritable(const uint64_t &id, const bool &writable);
+
+                    /**
+                     * This method removes a registration. If the handler is
+                     * currently called from another thread, this method waits
+                     * until the handler returns.
+                     *
+                     * @param id Identifier of the registration.
+                     */
+                    void remove(const uint64_t &id);
+
+                    uint32_t getNumberOfThreads() const;
+                    uint32_t getNumberOfConnections() const;
+                    uint32_t getNumberOfAcceptors() const;
+
+                    void addReceivedBytes(const uint64_t &bytes);
+                    uint64_t getReceivedBytes() const;
+
+                    void addSentBytes(const uint64_t &bytes);
+                    uint64_t getSentBytes() const;
+
+                    /**
+                     * This method counts sends that could not be written
+                     * completely at once and were queued.
+                     */
+                    void incrementQueuedSends();
+                    uint64_t getQueuedSends() const;
+
+                    /**
+                     * @return Human readable counters.
+                     */
+                    const string toString() const;
+
+                private:
+                    /**
+                     * This method waits for events and calls the handlers.
+                     */
+                    void run();
+
+                    /**
+                     * This method re-enables a registration after its handler
+                     * was called.
+                     */
+                    void rearm(const uint64_t &id, const int32_t &fileDescriptor, const bool &writable);
+
+                    class Registration {
+                        public:
+                            Registration();
+
+                        public:
+                            int32_t m_fileDescriptor;
+                            POSIXTCPReactorHandler *m_handler;
+                            bool m_isAcceptor;
+                            bool m_writable;
+                            bool m_busy;
+                            bool m_removed;
+                            uint32_t m_pendingEvents;
+                            std::thread::id m_thread;
+                    };
+
+                    static std::mutex m_singletonMutex;
+                    static POSIXTCPReactor *m_singleton;
+                    static bool m_singletonInitialized;
+
+                    int32_t m_epollFileDescriptor;
+                    int32_t m_wakeupFileDescriptor;
+                    std::atomic<bool> m_running;
+                    vector<std::thread> m_threads;
+
+                    mutable std::mutex m_registrationsMutex;
+                    std::condition_variable m_registrationsCondition;
+                    map<uint64_t, Registration> m_registrations;
+                    uint64_t m_nextId;
+                    uint32_t m_numberOfConnections;
+                    uint32_t m_numberOfAcceptors;
+
+                    std::atomic<uint64_t> m_receivedBytes;
+                    std::atomic<uint64_t> m_sentBytes;
+                    std::atomic<uint64_t> m_queuedSends;
+            };
+
+        }
+    }
+}
+
+#endif /* OPENDAVINCI_CORE_WRAPPER_POSIXTCPREACTOR_H_ */
@@ -25,7 +25,9 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <vector>
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/io/udp/UDPReceiver.h"
@@ -88,9 +90,12 @@ namespace odcore {
 
                     virtual void setSenderPortToIgnore(const uint16_t &portToIgnore);
 
+                    virtual void setSenderPortsToIgnore(const vector<uint16_t> &portsToIgnore);
+
                 private:
                     map<unsigned long, bool> m_mapOfIPAddresses;
-                    uint16_t m_portToIgnore;
+                    odcore::base::Mutex m_portsToIgnoreMutex;
+                    set<uint16_t> m_portsToIgnore;
                     bool m_isMulticast;
                     struct sockaddr_in m_address;
                     struct ip_mreq m_mreq;
@@ -103,6 +108,8 @@ namespace odcore {
                     virtual bool isRunning();
 
                     void getIPAddresses();
+
+                    bool isSenderPortToIgnore(const uint16_t &port);
             };
 
         }
@@ -0,0 +1,110 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_WRAPPER_SYSTEMCLOCK_H_
+#define OPENDAVINCI_CORE_WRAPPER_SYSTEMCLOCK_H_
+
+#include <chrono>
+
+#include "opendavinci/odcore/opendavinci.h"
+
+namespace odcore {
+    namespace wrapper {
+
+        /**
+         * This class provides allocation-free access to the system's
+         * clocks. On Linux, std::chrono's clocks are served by
+         * clock_gettime from the vDSO without a system call.
+         *
+         * In contrast to TimeFactory, these clocks cannot be replaced
+         * by a controlled time during simulations.
+         */
+        class OPENDAVINCI_API SystemClock {
+            private:
+                /**
+                 * "Forbidden" constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the constructor.
+                 */
+                SystemClock();
+
+            public:
+                /**
+                 * This method returns the wall clock time.
+                 *
+                 * @param seconds Seconds since Jan. 1, 1970.
+                 * @param microseconds Partial microseconds from the next full second.
+                 */
+                static inline void getRealtime(int32_t &seconds, int32_t &microseconds) {
+                    const int64_t US = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+                    seconds = static_cast<int32_t>(US / 1000000L);
+                    microseconds = static_cast<int32_t>(US % 1000000L);
+                }
+
+                /**
+                 * This method returns the time of a monotonic clock that
+                 * is not affected by NTP steps or changes of the wall
+                 * clock. Its origin is unspecified; thus, it must only be
+                 * used to measure durations.
+                 *
+                 * @return Monotonic time in microseconds.
+                 */
+                static inline int64_t getMonotonicMicroseconds() {
+                    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+                }
+
+                /**
+                 * This method returns the monotonic time in nanoseconds.
+                 *
+                 * @return Monotonic time in nanoseconds.
+                 */
+                static inline int64_t getMonotonicNanoseconds() {
+                    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+                }
+
+                /**
+                 * This method returns the CPU's time stamp counter for
+                 * sub-microsecond profiling. If the CPU does not provide
+                 * an invariant time stamp counter, the monotonic time in
+                 * nanoseconds is returned instead. Ticks must be converted
+                 * using getTicksPerMicrosecond().
+                 *
+                 * @return Ticks.
+                 */
+                static uint64_t getTicks();
+
+                /**
+                 * This method returns the number of ticks per microsecond.
+                 * The time stamp counter is calibrated once against the
+                 * monotonic clock.
+                 *
+                 * @return Ticks per microsecond.
+                 */
+                static double getTicksPerMicrosecond();
+
+                /**
+                 * @return true if getTicks() reads the CPU's time stamp counter.
+                 */
+                static bool hasInvariantTSC();
+        };
+
+    }
+} // odcore::wrapper
+
+#endif /*OPENDAVINCI_CORE_WRAPPER_SYSTEMCLOCK_H_*/
@@ -20,10 +20,10 @@
 #ifndef OPENDAVINCI_CORE_WRAPPER_TIMEFACTORY_H_
 #define OPENDAVINCI_CORE_WRAPPER_TIMEFACTORY_H_
 
+#include <atomic>
 #include <memory>
 
 #include "opendavinci/odcore/opendavinci.h"
-#include <memory>
 #include "opendavinci/odcore/wrapper/ConfigurationTraits.h"
 #include "opendavinci/odcore/wrapper/Libraries.h"
 #include "opendavinci/odcore/wrapper/SystemLibraryProducts.h"
@@ -62,6 +62,21 @@ namespace odcore {
                 virtual std::shared_ptr<odcore::wrapper::Time> now();
                 static TimeFactory& getInstance();
 
+                /**
+                 * This method returns the current time. Unless a controlled
+                 * time factory is set, the system's clock is read directly
+                 * without locking and without allocating a Time object.
+                 *
+                 * @param seconds Seconds since Jan. 1, 1970.
+                 * @param microseconds Partial microseconds from the next full second.
+                 */
+                static void getCurrentTime(int32_t &seconds, int32_t &microseconds);
+
+                /**
+                 * @return true if a controlled time factory replaces the system's clock.
+                 */
+                static bool isControlled();
+
             protected:
                 TimeFactory();
                 static void setSingleton(TimeFactory *tf);
@@ -70,6 +85,7 @@ namespace odcore {
 
             private:
                 static unique_ptr<Mutex> m_singletonMutex;
+                static std::atomic<bool> m_isControlled;
         };
 
         class OPENDAVINCI_API SystemTimeFactory {
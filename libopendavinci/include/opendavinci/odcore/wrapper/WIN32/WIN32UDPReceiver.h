@@ -83,6 +83,8 @@ namespace odcore {
 
                     virtual void setSenderPortToIgnore(const uint16_t &portToIgnore);
 
+                    virtual void setSenderPortsToIgnore(const vector<uint16_t> &portsToIgnore);
+
                 private:
                     const char* inet_ntop(int af, const void* src, char* dst, int cnt);
 
@@ -0,0 +1,157 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_WRAPPER_ZIP_ZIPARCHIVE_H_
+#define OPENDAVINCI_CORE_WRAPPER_ZIP_ZIPARCHIVE_H_
+
+#include <mutex>
+#include <string>
+
+#include "opendavinci/odcore/opendavinci.h"
+
+struct zip;
+struct zip_file;
+
+namespace odcore {
+    namespace wrapper {
+        namespace Zip {
+
+            using namespace std;
+
+            /**
+             * This class encapsulates an opened ZIP archive that is
+             * shared among all streams reading from its entries. All
+             * accesses to libzip are serialized as libzip's handle is
+             * not thread-safe. On POSIX platforms, the archive is also
+             * mapped into memory so that stored (i.e. uncompressed)
+             * entries can be read without any copy.
+             */
+            class ZipArchive {
+                private:
+                    /**
+                     * "Forbidden" copy constructor. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the copy constructor.
+                     */
+                    ZipArchive(const ZipArchive &);
+
+                    /**
+                     * "Forbidden" assignment operator. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the assignment operator.
+                     */
+                    ZipArchive& operator=(const ZipArchive &);
+
+                public:
+                    /**
+                     * Constructor. A temporary file is owned by this
+                     * instance and removed as soon as possible; any other
+                     * file is read in place and must not be modified while
+                     * this instance exists.
+                     *
+                     * @param fileName File containing the archive.
+                     * @param isTemporary true if the file shall be removed.
+                     */
+                    ZipArchive(const string &fileName, const bool &isTemporary);
+
+                    virtual ~ZipArchive();
+
+                    /**
+                     * @return true if the archive could be opened.
+                     */
+                    bool isOpen() const;
+
+                    /**
+                     * @return Number of entries in the archive.
+                     */
+                    int32_t getNumberOfEntries();
+
+                    /**
+                     * This method returns the name of an entry as stored
+                     * in the archive.
+                     *
+                     * @param index Index of the entry.
+                     * @return Name or empty string.
+                     */
+                    string getName(const int32_t &index);
+
+                    /**
+                     * This method returns the uncompressed size of an entry.
+                     *
+                     * @param index Index of the entry.
+                     * @param size Uncompressed size.
+                     * @return true if the entry exists.
+                     */
+                    bool getSize(const int32_t &index, uint64_t &size);
+
+                    /**
+                     * This method returns the contents of an entry directly
+                     * from the memory mapped archive if the entry is stored
+                     * neither compressed nor encrypted.
+                     *
+                     * @param index Index of the entry.
+                     * @param size Size of the entry.
+                     * @return Pointer to the entry's contents or NULL.
+                     */
+                    const char* getStoredEntry(const int32_t &index, uint64_t &size);
+
+                    /**
+                     * This method opens an entry for decompression.
+                     *
+                     * @param index Index of the entry.
+                     * @return Handle or NULL.
+                     */
+                    struct zip_file* openEntry(const int32_t &index);
+
+                    /**
+                     * This method decompresses the next bytes of an entry.
+                     *
+                     * @param entry Handle of the entry.
+                     * @param buffer Buffer to be filled.
+                     * @param size Size of the buffer.
+                     * @return Number of bytes read or -1 on errors.
+                     */
+                    int64_t readEntry(struct zip_file *entry, char *buffer, const uint32_t &size);
+
+                    /**
+                     * This method closes an entry.
+                     *
+                     * @param entry Handle of the entry.
+                     */
+                    void closeEntry(struct zip_file *entry);
+
+                private:
+                    string m_fileName;
+                    bool m_isTemporary;
+                    struct zip *m_archive;
+                    std::mutex m_archiveMutex;
+                    const char *m_data;
+                    uint64_t m_size;
+
+                    /**
+                     * This method removes the file if it is temporary.
+                     */
+                    void removeFile();
+            };
+
+        }
+    }
+} // odcore::wrapper::Zip
+
+#endif /*OPENDAVINCI_CORE_WRAPPER_ZIP_ZIPARCHIVE_H_*/
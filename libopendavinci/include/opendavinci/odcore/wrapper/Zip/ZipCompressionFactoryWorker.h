@@ -35,6 +35,10 @@ namespace odcore {
             static DecompressedData* getContents(istream &in) {
                 return new Zip::ZipDecompressedData(in);
             };
+
+            static DecompressedData* getContents(const string &fileName) {
+                return new Zip::ZipDecompressedData(fileName);
+            };
         };
 
     }
@@ -31,6 +31,7 @@
 #include "opendavinci/odcore/wrapper/DecompressedData.h"
 
 namespace odcore { namespace wrapper { template <odcore::wrapper::CompressionLibraryProducts product> struct CompressionFactoryWorker; } }
+namespace odcore { namespace wrapper { namespace Zip { class ZipArchive; } } }
 
 namespace odcore {
     namespace wrapper {
@@ -42,12 +43,20 @@ namespace odcore {
              * This class implements an abstract object containing
              * the decompressed contents of a compressed archive.
              *
+             * Entries are decompressed lazily while they are read
+             * from the returned streams; stored entries are read
+             * directly from the memory mapped archive. Archives given
+             * by their file name are read in place; archives given as
+             * stream are copied to a temporary file first. Every call to
+             * getInputStreamFor returns a new, independent stream that
+             * remains valid after this object has been destroyed.
+             *
              * @See DecompressedData.
              */
             class ZipDecompressedData : public DecompressedData {
                 private:
                     enum {
-                        BUFFER_SIZE = 1024
+                        BUFFER_SIZE = 65536
                     };
 
                 private:
@@ -60,6 +69,13 @@ namespace odcore {
                      */
                     ZipDecompressedData(istream &in);
 
+                    /**
+                     * Constructor.
+                     *
+                     * @param fileName File to be read in place.
+                     */
+                    ZipDecompressedData(const string &fileName);
+
                 private:
                     /**
                      * "Forbidden" copy constructor. Goal: The compiler should warn
@@ -83,15 +99,25 @@ namespace odcore {
                     virtual std::shared_ptr<istream> getInputStreamFor(const string &entry);
 
                 private:
-                    map<string, std::shared_ptr<istream>, odcore::strings::StringComparator> m_mapOfDecompressedEntries;
+                    std::shared_ptr<ZipArchive> m_archive;
+                    map<string, int32_t, odcore::strings::StringComparator> m_mapOfEntries;
 
                     /**
-                     * This method tries to decompress the given archive and
-                     * read the complete content into memory.
+                     * This method copies the given archive to a temporary
+                     * file and opens it.
                      *
                      * @param in Stream to be used for reading the contents.
                      */
-                    void decompressData(istream &in);
+                    void openArchive(istream &in);
+
+                    /**
+                     * This method tries to open the given archive and
+                     * reads the list of its entries.
+                     *
+                     * @param fileName File containing the archive.
+                     * @param isTemporary true if the file shall be removed.
+                     */
+                    void openArchive(const string &fileName, const bool &isTemporary);
             };
 
         }
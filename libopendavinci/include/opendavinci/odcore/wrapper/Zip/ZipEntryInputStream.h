@@ -0,0 +1,73 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_WRAPPER_ZIP_ZIPENTRYINPUTSTREAM_H_
+#define OPENDAVINCI_CORE_WRAPPER_ZIP_ZIPENTRYINPUTSTREAM_H_
+
+#include <istream>
+#include <memory>
+#include <streambuf>
+
+#include "opendavinci/odcore/opendavinci.h"
+
+namespace odcore {
+    namespace wrapper {
+        namespace Zip {
+
+            using namespace std;
+
+            /**
+             * This class is an input stream that owns the stream
+             * buffer reading one entry of a ZIP archive.
+             */
+            class ZipEntryInputStream : public istream {
+                private:
+                    /**
+                     * "Forbidden" copy constructor. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the copy constructor.
+                     */
+                    ZipEntryInputStream(const ZipEntryInputStream &);
+
+                    /**
+                     * "Forbidden" assignment operator. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the assignment operator.
+                     */
+                    ZipEntryInputStream& operator=(const ZipEntryInputStream &);
+
+                public:
+                    /**
+                     * Constructor.
+                     *
+                     * @param buffer Stream buffer to read from.
+                     */
+                    ZipEntryInputStream(std::shared_ptr<streambuf> buffer);
+
+                    virtual ~ZipEntryInputStream();
+
+                private:
+                    std::shared_ptr<streambuf> m_buffer;
+            };
+
+        }
+    }
+} // odcore::wrapper::Zip
+
+#endif /*OPENDAVINCI_CORE_WRAPPER_ZIP_ZIPENTRYINPUTSTREAM_H_*/
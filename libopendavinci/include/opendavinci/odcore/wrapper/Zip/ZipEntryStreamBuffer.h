@@ -0,0 +1,108 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_WRAPPER_ZIP_ZIPENTRYSTREAMBUFFER_H_
+#define OPENDAVINCI_CORE_WRAPPER_ZIP_ZIPENTRYSTREAMBUFFER_H_
+
+#include <memory>
+#include <streambuf>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/wrapper/Zip/ZipArchive.h"
+
+namespace odcore {
+    namespace wrapper {
+        namespace Zip {
+
+            using namespace std;
+
+            /**
+             * This class decompresses one entry of a ZIP archive
+             * while it is read. Only a small window of the entry is
+             * kept in memory; seeking backwards restarts the
+             * decompression from the entry's beginning.
+             */
+            class ZipEntryStreamBuffer : public streambuf {
+                private:
+                    enum {
+                        BUFFER_SIZE = 16384
+                    };
+
+                private:
+                    /**
+                     * "Forbidden" copy constructor. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the copy constructor.
+                     */
+                    ZipEntryStreamBuffer(const ZipEntryStreamBuffer &);
+
+                    /**
+                     * "Forbidden" assignment operator. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the assignment operator.
+                     */
+                    ZipEntryStreamBuffer& operator=(const ZipEntryStreamBuffer &);
+
+                public:
+                    /**
+                     * Constructor.
+                     *
+                     * @param archive Archive containing the entry.
+                     * @param index Index of the entry.
+                     * @param size Uncompressed size of the entry.
+                     */
+                    ZipEntryStreamBuffer(std::shared_ptr<ZipArchive> archive, const int32_t &index, const uint64_t &size);
+
+                    virtual ~ZipEntryStreamBuffer();
+
+                protected:
+                    virtual int_type underflow();
+
+                    virtual pos_type seekoff(off_type off, ios_base::seekdir dir, ios_base::openmode which = ios_base::in);
+
+                    virtual pos_type seekpos(pos_type pos, ios_base::openmode which = ios_base::in);
+
+                private:
+                    std::shared_ptr<ZipArchive> m_archive;
+                    int32_t m_index;
+                    uint64_t m_size;
+                    struct zip_file *m_entry;
+                    uint64_t m_positionOfBuffer;
+                    vector<char> m_buffer;
+
+                    /**
+                     * This method decompresses the next part of the entry
+                     * into the buffer.
+                     *
+                     * @return false if the end of the entry was reached.
+                     */
+                    bool fill();
+
+                    /**
+                     * This method restarts the decompression.
+                     */
+                    void rewind();
+            };
+
+        }
+    }
+} // odcore::wrapper::Zip
+
+#endif /*OPENDAVINCI_CORE_WRAPPER_ZIP_ZIPENTRYSTREAMBUFFER_H_*/
@@ -0,0 +1,81 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_CORE_WRAPPER_ZIP_ZIPSTOREDENTRYSTREAMBUFFER_H_
+#define OPENDAVINCI_CORE_WRAPPER_ZIP_ZIPSTOREDENTRYSTREAMBUFFER_H_
+
+#include <memory>
+#include <streambuf>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/wrapper/Zip/ZipArchive.h"
+
+namespace odcore {
+    namespace wrapper {
+        namespace Zip {
+
+            using namespace std;
+
+            /**
+             * This class reads one stored (i.e. uncompressed) entry
+             * directly from the memory mapped ZIP archive without
+             * copying its contents.
+             */
+            class ZipStoredEntryStreamBuffer : public streambuf {
+                private:
+                    /**
+                     * "Forbidden" copy constructor. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the copy constructor.
+                     */
+                    ZipStoredEntryStreamBuffer(const ZipStoredEntryStreamBuffer &);
+
+                    /**
+                     * "Forbidden" assignment operator. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the assignment operator.
+                     */
+                    ZipStoredEntryStreamBuffer& operator=(const ZipStoredEntryStreamBuffer &);
+
+                public:
+                    /**
+                     * Constructor.
+                     *
+                     * @param archive Archive containing the entry; it keeps the memory mapped.
+                     * @param data Contents of the entry.
+                     * @param size Size of the entry.
+                     */
+                    ZipStoredEntryStreamBuffer(std::shared_ptr<ZipArchive> archive, const char *data, const uint64_t &size);
+
+                    virtual ~ZipStoredEntryStreamBuffer();
+
+                protected:
+                    virtual pos_type seekoff(off_type off, ios_base::seekdir dir, ios_base::openmode which = ios_base::in);
+
+                    virtual pos_type seekpos(pos_type pos, ios_base::openmode which = ios_base::in);
+
+                private:
+                    std::shared_ptr<ZipArchive> m_archive;
+            };
+
+        }
+    }
+} // odcore::wrapper::Zip
+
+#endif /*OPENDAVINCI_CORE_WRAPPER_ZIP_ZIPSTOREDENTRYSTREAMBUFFER_H_*/
@@ -30,7 +30,7 @@ namespace odcore {
 
             /**
              * This class implements an abstract object to compress
-             * a string up to 16,384 bytes.
+             * and decompress arbitrary binary data held in a string.
              */
             class Zlib {
                 private:
@@ -58,7 +58,20 @@ namespace odcore {
                 public:
                     virtual ~Zlib();
 
+                    /**
+                     * This method compresses the given data.
+                     *
+                     * @param s Data to compress.
+                     * @return Compressed data or empty string in case of an error.
+                     */
                     static string compress(const string &s);
+
+                    /**
+                     * This method decompresses the given data.
+                     *
+                     * @param s Data to decompress.
+                     * @return Decompressed data or empty string in case of an error.
+                     */
                     static string decompress(const string &s);
             };
 
@@ -0,0 +1,198 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_TOOLS_COLUMNAR_COLUMNARFORMAT_H_
+#define OPENDAVINCI_TOOLS_COLUMNAR_COLUMNARFORMAT_H_
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+
+namespace odtools {
+    namespace columnar {
+
+        using namespace std;
+
+        /**
+         * This class describes one compressed block of a column. All
+         * columns of a table are split at the same rows.
+         */
+        class OPENDAVINCI_API ColumnBlock {
+            public:
+                ColumnBlock();
+
+            public:
+                uint64_t m_offset;
+                uint32_t m_compressedSize;
+                uint64_t m_firstRow;
+                uint32_t m_numberOfRows;
+                uint64_t m_minimum; // Raw 8 bytes; interpretation depends on the column's type.
+                uint64_t m_maximum; // Raw 8 bytes; interpretation depends on the column's type.
+        };
+
+        /**
+         * This class describes one column, i.e. one field path of a
+         * message type like "SampleTimeStamp" or "position.x".
+         */
+        class OPENDAVINCI_API Column {
+            public:
+                Column();
+
+            public:
+                string m_name;
+                uint8_t m_type;
+                vector<ColumnBlock> m_blocks;
+        };
+
+        /**
+         * This class describes all columns for one pair of message type
+         * and sender stamp.
+         */
+        class OPENDAVINCI_API Table {
+            public:
+                Table();
+
+                /**
+                 * @param name Name of the column.
+                 * @return Index of the column or -1 if not found.
+                 */
+                int32_t findColumn(const string &name) const;
+
+            public:
+                string m_name;
+                int32_t m_dataType;
+                uint32_t m_senderStamp;
+                uint64_t m_numberOfRows;
+                vector<Column> m_columns;
+        };
+
+        /**
+         * This class describes the on-disk layout of a columnar recording
+         * (.rec.col): An 8 byte magic number is followed by the compressed
+         * column blocks, the directory describing all tables, columns, and
+         * blocks, and a trailer containing the directory's offset and the
+         * magic number again. All values are stored with 8 bytes in little
+         * endian; integer columns are delta-encoded before compression.
+         */
+        class OPENDAVINCI_API ColumnarFormat {
+            private:
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 *
+                 * @param obj Reference to an object of this class.
+                 */
+                ColumnarFormat(const ColumnarFormat &/*obj*/);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 *
+                 * @param obj Reference to an object of this class.
+                 * @return Reference to this instance.
+                 */
+                ColumnarFormat& operator=(const ColumnarFormat &/*obj*/);
+
+                ColumnarFormat();
+
+            public:
+                virtual ~ColumnarFormat();
+
+            public:
+                enum COLUMN_TYPE {
+                    INTEGER = 0,
+                    FLOATING_POINT = 1,
+                };
+
+                enum {
+                    ROWS_PER_BLOCK = 4096,
+                    MAGIC_SIZE = 8,
+                };
+
+                static const char MAGIC[MAGIC_SIZE + 1];
+
+                static const string SENT_TIMESTAMP;
+                static const string RECEIVED_TIMESTAMP;
+                static const string SAMPLE_TIMESTAMP;
+
+                /**
+                 * This method converts a raw value into a double.
+                 *
+                 * @param type Type of the value.
+                 * @param value Raw value.
+                 * @return Value as double.
+                 */
+                static double toDouble(const uint8_t &type, const uint64_t &value);
+
+                /**
+                 * This method compares two raw values.
+                 *
+                 * @param type Type of the values.
+                 * @param a Raw value.
+                 * @param b Raw value.
+                 * @return true if a < b.
+                 */
+                static bool isLess(const uint8_t &type, const uint64_t &a, const uint64_t &b);
+
+                /**
+                 * This method encodes and compresses the values of a block.
+                 *
+                 * @param type Type of the values.
+                 * @param values Raw values.
+                 * @return Compressed block.
+                 */
+                static string encodeBlock(const uint8_t &type, const vector<uint64_t> &values);
+
+                /**
+                 * This method decompresses and decodes the values of a block.
+                 *
+                 * @param type Type of the values.
+                 * @param data Compressed block.
+                 * @param numberOfRows Expected number of values.
+                 * @param values Raw values.
+                 * @return true if the block could be decoded.
+                 */
+                static bool decodeBlock(const uint8_t &type, const string &data, const uint32_t &numberOfRows, vector<uint64_t> &values);
+
+                /**
+                 * This method writes the directory.
+                 *
+                 * @param out Stream to write to.
+                 * @param tables Tables to write.
+                 */
+                static void writeDirectory(ostream &out, const vector<Table> &tables);
+
+                /**
+                 * This method reads the directory.
+                 *
+                 * @param in Stream to read from.
+                 * @param tables Tables to read.
+                 * @return true if the directory could be read.
+                 */
+                static bool readDirectory(istream &in, vector<Table> &tables);
+        };
+
+    } // columnar
+} // odtools
+
+#endif /*OPENDAVINCI_TOOLS_COLUMNAR_COLUMNARFORMAT_H_*/
@@ -0,0 +1,121 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_TOOLS_COLUMNAR_COLUMNARFROMVISITABLEVISITOR_H_
+#define OPENDAVINCI_TOOLS_COLUMNAR_COLUMNARFROMVISITABLEVISITOR_H_
+
+#include <string>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Visitor.h"
+
+namespace odcore { namespace serialization { class Serializable; } }
+
+namespace odtools {
+    namespace columnar {
+
+        using namespace std;
+
+        /**
+         * This class describes one scalar value of a flattened Visitable.
+         */
+        class OPENDAVINCI_API ColumnValue {
+            public:
+                ColumnValue();
+                ColumnValue(const string &name, const uint8_t &type, const uint64_t &value);
+
+            public:
+                string m_name;
+                uint8_t m_type;
+                uint64_t m_value;
+        };
+
+        /**
+         * This class flattens a Visitable into its scalar fields; nested
+         * Visitables are prefixed with their short name like "position.x".
+         * Strings and binary data are not representable with fixed width
+         * and hence, skipped.
+         */
+        class OPENDAVINCI_API ColumnarFromVisitableVisitor : public odcore::base::Visitor {
+            private:
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 */
+                ColumnarFromVisitableVisitor(const ColumnarFromVisitableVisitor &);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 */
+                ColumnarFromVisitableVisitor& operator=(const ColumnarFromVisitableVisitor &);
+
+            public:
+                /**
+                 * Constructor.
+                 *
+                 * @param prefix Prefix for the names of all visited fields.
+                 */
+                ColumnarFromVisitableVisitor(const string &prefix = "");
+
+                virtual ~ColumnarFromVisitableVisitor();
+
+            public:
+                virtual void beginVisit(const int32_t &id, const string &shortName, const string &longName);
+                virtual void endVisit();
+
+                virtual void visit(const uint32_t &id, const string &longName, const string &shortName, odcore::serialization::Serializable &v);
+                virtual void visit(const uint32_t &id, const string &longName, const string &shortName, bool &v);
+                virtual void visit(const uint32_t &id, const string &longName, const string &shortName, char &v);
+                virtual void visit(const uint32_t &id, const string &longName, const string &shortName, unsigned char &v);
+                virtual void visit(const uint32_t &id, const string &longName, const string &shortName, int8_t &v);
+                virtual void visit(const uint32_t &id, const string &longName, const string &shortName, int16_t &v);
+                virtual void visit(const uint32_t &id, const string &longName, const string &shortName, uint16_t &v);
+                virtual void visit(const uint32_t &id, const string &longName, const string &shortName, int32_t &v);
+                virtual void visit(const uint32_t &id, const string &longName, const string &shortName, uint32_t &v);
+                virtual void visit(const uint32_t &id, const string &longName, const string &shortName, int64_t &v);
+                virtual void visit(const uint32_t &id, const string &longName, const string &shortName, uint64_t &v);
+                virtual void visit(const uint32_t &id, const string &longName, const string &shortName, float &v);
+                virtual void visit(const uint32_t &id, const string &longName, const string &shortName, double &v);
+                virtual void visit(const uint32_t &id, const string &longName, const string &shortName, string &v);
+                virtual void visit(const uint32_t &id, const string &longName, const string &shortName, void *data, const uint32_t &size);
+                virtual void visit(const uint32_t &id, const string &longName, const string &shortName, void *data, const uint32_t &count, const odcore::TYPE_ &t);
+
+            public:
+                /**
+                 * @return Scalar values in the order of visiting.
+                 */
+                const vector<ColumnValue>& getValues() const;
+
+            private:
+                void addInteger(const string &shortName, const int64_t &v);
+                void addFloatingPoint(const string &shortName, const double &v);
+
+            private:
+                string m_prefix;
+                vector<ColumnValue> m_values;
+        };
+
+    } // columnar
+} // odtools
+
+#endif /*OPENDAVINCI_TOOLS_COLUMNAR_COLUMNARFROMVISITABLEVISITOR_H_*/
@@ -0,0 +1,145 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_TOOLS_COLUMNAR_COLUMNARREADER_H_
+#define OPENDAVINCI_TOOLS_COLUMNAR_COLUMNARREADER_H_
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odtools/columnar/ColumnarFormat.h"
+
+namespace odtools {
+    namespace columnar {
+
+        using namespace std;
+
+        /**
+         * This class queries a columnar recording (.rec.col). Only the
+         * directory is read when opening the file; a query decompresses
+         * only the blocks of the requested columns whose statistics
+         * overlap with the requested ranges.
+         */
+        class OPENDAVINCI_API ColumnarReader {
+            private:
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 *
+                 * @param obj Reference to an object of this class.
+                 */
+                ColumnarReader(const ColumnarReader &/*obj*/);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 *
+                 * @param obj Reference to an object of this class.
+                 * @return Reference to this instance.
+                 */
+                ColumnarReader& operator=(const ColumnarReader &/*obj*/);
+
+            public:
+                /**
+                 * Constructor.
+                 *
+                 * @param filename Name of the .rec.col file to open.
+                 */
+                ColumnarReader(const string &filename);
+
+                virtual ~ColumnarReader();
+
+                /**
+                 * @return true if the file's directory could be read.
+                 */
+                bool isValid() const;
+
+                /**
+                 * @return All tables of this file.
+                 */
+                const vector<Table>& getTables() const;
+
+                /**
+                 * This method returns the values of a column for all rows whose
+                 * time stamp is between from and to (both including).
+                 *
+                 * @param messageName Long name of the message type like "odcore.data.TimePoint".
+                 * @param senderStamp Sender stamp.
+                 * @param columnName Name of the column like "position.x".
+                 * @param from First time stamp in microseconds.
+                 * @param to Last time stamp in microseconds.
+                 * @param timeStamps Time stamps of the matching rows.
+                 * @param values Values of the matching rows.
+                 * @param timeStampColumn Column to be used as time stamp.
+                 * @return true if the table and columns exist and all blocks could be read.
+                 */
+                bool query(const string &messageName, const uint32_t &senderStamp, const string &columnName,
+                           const int64_t &from, const int64_t &to,
+                           vector<int64_t> &timeStamps, vector<double> &values,
+                           const string &timeStampColumn = ColumnarFormat::SAMPLE_TIMESTAMP);
+
+                /**
+                 * This method returns the values of a column between minimum
+                 * and maximum (both including) together with the time stamps.
+                 *
+                 * @param messageName Long name of the message type.
+                 * @param senderStamp Sender stamp.
+                 * @param columnName Name of the column.
+                 * @param minimum Smallest value.
+                 * @param maximum Largest value.
+                 * @param timeStamps Time stamps of the matching rows.
+                 * @param values Values of the matching rows.
+                 * @param timeStampColumn Column to be used as time stamp.
+                 * @return true if the table and columns exist and all blocks could be read.
+                 */
+                bool queryValues(const string &messageName, const uint32_t &senderStamp, const string &columnName,
+                                 const double &minimum, const double &maximum,
+                                 vector<int64_t> &timeStamps, vector<double> &values,
+                                 const string &timeStampColumn = ColumnarFormat::SAMPLE_TIMESTAMP);
+
+                /**
+                 * @return Number of blocks decompressed since opening the file.
+                 */
+                uint64_t getNumberOfDecodedBlocks() const;
+
+            private:
+                const Table* findTable(const string &messageName, const uint32_t &senderStamp) const;
+
+                bool readBlock(const Column &column, const uint32_t &block, vector<uint64_t> &values);
+
+                bool scan(const string &messageName, const uint32_t &senderStamp, const string &columnName,
+                          const string &timeStampColumn, const bool &filterByTime,
+                          const int64_t &from, const int64_t &to, const double &minimum, const double &maximum,
+                          vector<int64_t> &timeStamps, vector<double> &values);
+
+            private:
+                fstream m_in;
+                bool m_valid;
+                vector<Table> m_tables;
+                uint64_t m_numberOfDecodedBlocks;
+        };
+
+    } // columnar
+} // odtools
+
+#endif /*OPENDAVINCI_TOOLS_COLUMNAR_COLUMNARREADER_H_*/
@@ -0,0 +1,124 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_TOOLS_COLUMNAR_COLUMNARWRITER_H_
+#define OPENDAVINCI_TOOLS_COLUMNAR_COLUMNARWRITER_H_
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odtools/columnar/ColumnarFormat.h"
+
+namespace odcore { namespace data { class Container; } }
+namespace odcore { namespace reflection { class Message; } }
+
+namespace odtools {
+    namespace columnar {
+
+        using namespace std;
+
+        /**
+         * This class writes a columnar recording (.rec.col) from Containers
+         * and their corresponding Messages. Rows are buffered per table up to
+         * ColumnarFormat::ROWS_PER_BLOCK before they are compressed and written.
+         */
+        class OPENDAVINCI_API ColumnarWriter {
+            private:
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 *
+                 * @param obj Reference to an object of this class.
+                 */
+                ColumnarWriter(const ColumnarWriter &/*obj*/);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 *
+                 * @param obj Reference to an object of this class.
+                 * @return Reference to this instance.
+                 */
+                ColumnarWriter& operator=(const ColumnarWriter &/*obj*/);
+
+            public:
+                /**
+                 * Constructor.
+                 *
+                 * @param filename Name of the .rec.col file to create.
+                 */
+                ColumnarWriter(const string &filename);
+
+                /**
+                 * Destructor; calls close().
+                 */
+                virtual ~ColumnarWriter();
+
+                /**
+                 * @return true if the file could be created and all writes succeeded so far.
+                 */
+                bool isGood() const;
+
+                /**
+                 * This method appends one row to the table for the given
+                 * Container's data type and sender stamp. The columns of a
+                 * table are defined by the first appended Message.
+                 *
+                 * @param c Container providing data type, sender stamp, and time stamps.
+                 * @param msg Message that was mapped from c.
+                 */
+                void append(odcore::data::Container &c, odcore::reflection::Message &msg);
+
+                /**
+                 * This method writes the pending blocks and the directory.
+                 *
+                 * @return true if the file was written completely.
+                 */
+                bool close();
+
+            private:
+                /**
+                 * This class holds the pending rows of a table.
+                 */
+                class TableBuffer {
+                    public:
+                        TableBuffer();
+
+                    public:
+                        Table m_table;
+                        vector<vector<uint64_t> > m_values;
+                };
+
+                void flush(TableBuffer &tb);
+
+            private:
+                fstream m_out;
+                bool m_closed;
+                map<string, TableBuffer> m_tables;
+        };
+
+    } // columnar
+} // odtools
+
+#endif /*OPENDAVINCI_TOOLS_COLUMNAR_COLUMNARWRITER_H_*/
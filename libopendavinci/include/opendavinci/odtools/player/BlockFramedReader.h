@@ -0,0 +1,169 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_TOOLS_PLAYER_BLOCKFRAMEDREADER_H_
+#define OPENDAVINCI_TOOLS_PLAYER_BLOCKFRAMEDREADER_H_
+
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Mutex.h"
+#include "opendavinci/odtools/recorder/BlockFrameHeader.h"
+
+namespace odcore { namespace data { class Container; } }
+
+namespace odtools {
+    namespace player {
+
+        using namespace std;
+
+        /**
+         * This class reads Containers from a block-framed recording (cf.
+         * odtools::recorder::BlockFrameHeader). A Container is addressed by
+         * a position combining the block's number (upper 32 bits) and the
+         * Container's offset in the uncompressed block (lower 32 bits).
+         * Opening a recording only reads the block headers. Blocks are
+         * decompressed when they are needed; when a block is accessed, the
+         * following blocks are decompressed in parallel background threads.
+         * The most recently used blocks are kept in an LRU cache.
+         */
+        class OPENDAVINCI_API BlockFramedReader {
+            private:
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 *
+                 * @param obj Reference to an object of this class.
+                 */
+                BlockFramedReader(const BlockFramedReader &/*obj*/);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 *
+                 * @param obj Reference to an object of this class.
+                 * @return Reference to this instance.
+                 */
+                BlockFramedReader& operator=(const BlockFramedReader &/*obj*/);
+
+            public:
+                /**
+                 * Constructor.
+                 *
+                 * @param filename Block-framed recording to read.
+                 * @param numberOfBlocksToReadAhead Number of blocks to decompress ahead of the current one.
+                 */
+                BlockFramedReader(const string &filename, const uint32_t &numberOfBlocksToReadAhead);
+
+                virtual ~BlockFramedReader();
+
+                /**
+                 * @return true if all block headers could be read.
+                 */
+                bool isValid() const;
+
+                /**
+                 * @return Headers of all blocks.
+                 */
+                const vector<odtools::recorder::BlockFrameHeader>& getHeaders() const;
+
+                /**
+                 * @return Total number of Containers according to the block headers.
+                 */
+                uint32_t getNumberOfContainers() const;
+
+                /**
+                 * This method decompresses one block and calls f for every
+                 * Container in this block in the order of the file.
+                 *
+                 * @param block Block to index.
+                 * @param f Function to call with a Container and its position.
+                 * @return true if the block could be decompressed.
+                 */
+                bool index(const uint32_t &block, std::function<void(const odcore::data::Container &, const uint64_t &)> f);
+
+                /**
+                 * This method reads the Container at the given position.
+                 *
+                 * @param position Position as passed to index(...).
+                 * @param c Container to read.
+                 * @return true if the Container could be read.
+                 */
+                bool read(const uint64_t &position, odcore::data::Container &c);
+
+                /**
+                 * This method discards all decompressed blocks.
+                 */
+                void reset();
+
+                /**
+                 * @return Number of blocks decompressed so far.
+                 */
+                uint32_t getNumberOfDecompressedBlocks() const;
+
+                /**
+                 * @return Number of blocks currently kept in memory.
+                 */
+                uint32_t getNumberOfCachedBlocks() const;
+
+            private:
+                /**
+                 * This method decompresses one block using its own stream
+                 * to the file to be run concurrently.
+                 *
+                 * @param block Block to decompress.
+                 * @return Uncompressed block or NULL on failure.
+                 */
+                std::shared_ptr<stringstream> decompress(const uint32_t &block);
+
+                /**
+                 * This method returns the given block from the LRU cache
+                 * and starts decompressing the following blocks.
+                 *
+                 * @param block Block to return.
+                 * @return Uncompressed block or NULL on failure.
+                 */
+                std::shared_ptr<stringstream> getBlock(const uint32_t &block);
+
+            private:
+                const string m_filename;
+                const uint32_t m_numberOfBlocksToReadAhead;
+                bool m_valid;
+                vector<odtools::recorder::BlockFrameHeader> m_headers;
+                vector<uint64_t> m_blockOffsets;
+
+                mutable odcore::base::Mutex m_blocksMutex;
+                map<uint32_t, std::shared_future<std::shared_ptr<stringstream> > > m_blocks;
+                list<uint32_t> m_leastRecentlyUsedBlocks;
+                uint32_t m_numberOfDecompressedBlocks;
+        };
+
+    } // player
+} // tools
+
+#endif /*OPENDAVINCI_TOOLS_PLAYER_BLOCKFRAMEDREADER_H_*/
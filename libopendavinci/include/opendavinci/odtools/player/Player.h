@@ -25,6 +25,7 @@
 #include <map>
 #include <memory>
 #include <thread>
+#include <vector>
 
 #include <opendavinci/odcore/opendavinci.h>
 #include <opendavinci/odcore/base/Mutex.h>
@@ -38,6 +39,7 @@
 namespace odtools {
     namespace player {
 
+        class BlockFramedReader;
         class PlayerDelegate;
         class RecMemIndex;
 
@@ -160,6 +162,33 @@ namespace odtools {
                  */
                 void initializeIndex();
 
+                /**
+                 * This method prepares the index for a block-framed .rec
+                 * file: Only the block headers are read and the blocks
+                 * are ordered by their first sample time stamp; a block's
+                 * Containers are added to the index when the replay
+                 * reaches the block's time range.
+                 */
+                void initializeIndexFromBlockFramedFile();
+
+                /**
+                 * This method adds all Containers of a block to the index.
+                 *
+                 * @param block Block to index.
+                 */
+                void indexBlock(const uint32_t &block);
+
+                /**
+                 * This method indexes all blocks that might contain
+                 * Containers to be replayed up to the entry following
+                 * the given one. Thus, advancing an iterator past the
+                 * given entry never skips Containers from blocks that
+                 * are indexed later.
+                 *
+                 * @param entry Entry that was read last or m_index.end() to index the first entry.
+                 */
+                void indexBlocksFollowing(const multimap<int64_t, IndexEntry>::iterator &entry);
+
                 /**
                  * This method computes the initially required amount of
                  * containers in the cache and fill the cache accordingly.
@@ -210,6 +239,14 @@ namespace odtools {
                 fstream m_recFile;
                 bool m_recFileValid;
 
+                // Reader for block-framed .rec files; NULL for regular .rec files.
+                unique_ptr<BlockFramedReader> m_blockFramedReader;
+
+                // Blocks ordered by their first sample time stamp; the first
+                // m_numberOfIndexedBlocks of them are already in the index.
+                vector<uint32_t> m_blocksToIndex;
+                uint32_t m_numberOfIndexedBlocks;
+
             private: // Player states.
                 bool m_autoRewind;
 
@@ -0,0 +1,99 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_TOOLS_RECORDER_BLOCKFRAMEHEADER_H_
+#define OPENDAVINCI_TOOLS_RECORDER_BLOCKFRAMEHEADER_H_
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+
+namespace odtools {
+    namespace recorder {
+
+        using namespace std;
+
+        /**
+         * This class describes the header of one block in a block-framed
+         * recording: Instead of plain Containers, such a file consists of
+         * blocks of serialized Containers that are compressed independently
+         * with zlib. Every block is preceded by this header describing the
+         * block's size, the time range of its Containers' sample time
+         * stamps, and the set of contained data types:
+         *
+         * "ODZB" compressedSize uncompressedSize numberOfContainers
+         * firstSampleTimeStamp lastSampleTimeStamp numberOfDataTypes dataType*
+         *
+         * As a regular .rec file starts with 0x0D, both formats can be
+         * distinguished by their first bytes.
+         */
+        class OPENDAVINCI_API BlockFrameHeader {
+            public:
+                enum {
+                    MAGIC_SIZE = 4,
+                    DEFAULT_BLOCK_SIZE = 4 * 1024 * 1024,
+                };
+
+                static const char MAGIC[MAGIC_SIZE + 1];
+
+            public:
+                BlockFrameHeader();
+
+                /**
+                 * This method checks whether the given file is block-framed.
+                 *
+                 * @param filename File to check.
+                 * @return true if the file starts with a BlockFrameHeader.
+                 */
+                static bool isBlockFramed(const string &filename);
+
+                /**
+                 * This method adds a Container's meta data to this header.
+                 *
+                 * @param sampleTimeStamp Sample time stamp in microseconds.
+                 * @param dataType Data type.
+                 */
+                void add(const int64_t &sampleTimeStamp, const int32_t &dataType);
+
+                /**
+                 * @param out Stream to write this header to.
+                 */
+                void write(ostream &out) const;
+
+                /**
+                 * @param in Stream to read this header from.
+                 * @return true if a valid header was read.
+                 */
+                bool read(istream &in);
+
+            public:
+                uint32_t m_compressedSize;
+                uint32_t m_uncompressedSize;
+                uint32_t m_numberOfContainers;
+                int64_t m_firstSampleTimeStamp;
+                int64_t m_lastSampleTimeStamp;
+                vector<int32_t> m_dataTypes;
+        };
+
+    } // recorder
+} // tools
+
+#endif /*OPENDAVINCI_TOOLS_RECORDER_BLOCKFRAMEHEADER_H_*/
@@ -0,0 +1,120 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef OPENDAVINCI_TOOLS_RECORDER_BLOCKFRAMEDWRITER_H_
+#define OPENDAVINCI_TOOLS_RECORDER_BLOCKFRAMEDWRITER_H_
+
+#include <deque>
+#include <future>
+#include <memory>
+#include <ostream>
+#include <string>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odtools/recorder/BlockFrameHeader.h"
+
+namespace odcore { namespace data { class Container; } }
+
+namespace odtools {
+    namespace recorder {
+
+        using namespace std;
+
+        /**
+         * This class writes Containers as block-framed recording (cf.
+         * BlockFrameHeader). Full blocks are compressed by background
+         * threads and written in their original order.
+         */
+        class OPENDAVINCI_API BlockFramedWriter {
+            private:
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 *
+                 * @param obj Reference to an object of this class.
+                 */
+                BlockFramedWriter(const BlockFramedWriter &/*obj*/);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 *
+                 * @param obj Reference to an object of this class.
+                 * @return Reference to this instance.
+                 */
+                BlockFramedWriter& operator=(const BlockFramedWriter &/*obj*/);
+
+            public:
+                /**
+                 * Constructor.
+                 *
+                 * @param out Stream to write the blocks to.
+                 * @param blockSize Number of uncompressed bytes after which a block is completed.
+                 * @param numberOfCompressionThreads Maximum number of blocks to be compressed concurrently.
+                 */
+                BlockFramedWriter(std::shared_ptr<ostream> out, const uint32_t &blockSize, const uint32_t &numberOfCompressionThreads);
+
+                /**
+                 * Destructor; calls flush().
+                 */
+                virtual ~BlockFramedWriter();
+
+                /**
+                 * This method adds a Container to the current block.
+                 *
+                 * @param c Container to write.
+                 */
+                void write(const odcore::data::Container &c);
+
+                /**
+                 * This method completes the current block and waits until
+                 * all blocks are written.
+                 */
+                void flush();
+
+            private:
+                /**
+                 * This method hands the current block to a background thread.
+                 */
+                void compressCurrentBlock();
+
+                /**
+                 * This method writes the compressed blocks in order.
+                 *
+                 * @param maximumNumberOfPendingBlocks Wait until at most this number of blocks is pending.
+                 */
+                void writeCompressedBlocks(const uint32_t &maximumNumberOfPendingBlocks);
+
+                static string compressBlock(BlockFrameHeader header, const string &block);
+
+            private:
+                std::shared_ptr<ostream> m_out;
+                const uint32_t m_blockSize;
+                const uint32_t m_numberOfCompressionThreads;
+                string m_block;
+                BlockFrameHeader m_header;
+                deque<std::future<string> > m_pendingBlocks;
+        };
+
+    } // recorder
+} // tools
+
+#endif /*OPENDAVINCI_TOOLS_RECORDER_BLOCKFRAMEDWRITER_H_*/
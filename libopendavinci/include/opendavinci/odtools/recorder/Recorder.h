@@ -33,6 +33,7 @@ namespace odcore { namespace data { class Container; } }
 namespace odtools {
     namespace recorder {
 
+        class BlockFramedWriter;
         class RecorderDelegate;
         class SharedDataListener;
 
@@ -78,6 +79,19 @@ namespace odtools {
                  */
                 Recorder(const string &url, const uint32_t &memorySegmentSize, const uint32_t &numberOfSegments, const bool &threading, const bool &dumpSharedData);
 
+                /**
+                 * Constructor.
+                 *
+                 * @param url URL of the resource to be used for writing containers to.
+                 * @param memorySegmentSize Size of a memory segment for storing shared memory data (like shared images).
+                 * @param numberOfSegments Number of segments to be used.
+                 * @param threading If true recorder is using a background thread to dump shared memory data.
+                 * @param dumpSharedData If true, shared images and shared data will be stored as well.
+                 * @param compressionBlockSize If larger than 0, containers are stored in zlib-compressed blocks
+                 *                             of this uncompressed size (cf. BlockFrameHeader) instead of plainly.
+                 */
+                Recorder(const string &url, const uint32_t &memorySegmentSize, const uint32_t &numberOfSegments, const bool &threading, const bool &dumpSharedData, const uint32_t &compressionBlockSize);
+
                 virtual ~Recorder();
 
                 /**
@@ -121,10 +135,20 @@ namespace odtools {
                  */
                 void store(odcore::data::Container c);
 
+            private:
+                /**
+                 * This method writes a container to the output either
+                 * directly or into the current compressed block.
+                 *
+                 * @param c Container to write.
+                 */
+                void write(const odcore::data::Container &c);
+
             private:
                 odcore::base::FIFOQueue m_fifo;
                 unique_ptr<SharedDataListener> m_sharedDataListener;
                 std::shared_ptr<ostream> m_out;
+                unique_ptr<BlockFramedWriter> m_blockFramedWriter;
                 std::shared_ptr<ostream> m_outSharedMemoryFile;
                 bool m_dumpSharedData;
                 odcore::base::Mutex m_mapOfRecorderDelegatesMutex;
@@ -0,0 +1,367 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+
+#include "opendavinci/odcore/base/Profiler.h"
+#include "opendavinci/odcore/wrapper/SystemClock.h"
+
+namespace odcore {
+    namespace base {
+
+        using namespace std;
+
+        /**
+         * This class is a single-producer/single-consumer ring buffer
+         * for the events of one thread.
+         */
+        class ProfilerRing {
+            private:
+                ProfilerRing(const ProfilerRing &);
+                ProfilerRing& operator=(const ProfilerRing &);
+
+            public:
+                enum {
+                    CAPACITY = 16384, // Must be a power of two.
+                };
+
+                ProfilerRing(const uint32_t &thread) :
+                    m_thread(thread),
+                    m_events(CAPACITY),
+                    m_head(0),
+                    m_tail(0),
+                    m_dropped(0),
+                    m_released(false) {}
+
+                uint32_t getThread() const {
+                    return m_thread;
+                }
+
+                /**
+                 * This method hands a drained ring over to a new thread.
+                 */
+                void reuse(const uint32_t &thread) {
+                    m_thread = thread;
+                    m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_release);
+                    m_dropped.store(0, std::memory_order_relaxed);
+                    m_released.store(false, std::memory_order_release);
+                }
+
+                void release() {
+                    m_released.store(true, std::memory_order_release);
+                }
+
+                /**
+                 * @return true if the owning thread has finished and all of its events were drained.
+                 */
+                bool isDrainedAndReleased() const {
+                    return m_released.load(std::memory_order_acquire) &&
+                           (m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_relaxed));
+                }
+
+                void push(const ProfilerEvent &e) {
+                    const uint64_t HEAD = m_head.load(std::memory_order_relaxed);
+                    if (HEAD - m_tail.load(std::memory_order_acquire) >= CAPACITY) {
+                        m_dropped.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+                    m_events[HEAD & (CAPACITY - 1)] = e;
+                    m_head.store(HEAD + 1, std::memory_order_release);
+                }
+
+                /**
+                 * This method writes all pending events and must only be
+                 * called by the writer.
+                 *
+                 * @return Number of dropped events since the last call.
+                 */
+                uint64_t drain(ostream &out) {
+                    uint64_t tail = m_tail.load(std::memory_order_relaxed);
+                    const uint64_t HEAD = m_head.load(std::memory_order_acquire);
+                    while (tail < HEAD) {
+                        // Write the contiguous part until the end of the buffer at once.
+                        const uint64_t INDEX = tail & (CAPACITY - 1);
+                        const uint64_t LENGTH = std::min<uint64_t>(HEAD - tail, CAPACITY - INDEX);
+                        out.write(reinterpret_cast<const char*>(&m_events[INDEX]), static_cast<streamsize>(LENGTH * sizeof(ProfilerEvent)));
+                        tail += LENGTH;
+                    }
+                    m_tail.store(tail, std::memory_order_release);
+                    return m_dropped.exchange(0, std::memory_order_relaxed);
+                }
+
+            private:
+                uint32_t m_thread;
+                vector<ProfilerEvent> m_events;
+                std::atomic<uint64_t> m_head;
+                std::atomic<uint64_t> m_tail;
+                std::atomic<uint64_t> m_dropped;
+                std::atomic<bool> m_released;
+        };
+
+        /**
+         * This class hands the ring of a thread back to the profiler
+         * when the thread finishes.
+         */
+        class ProfilerRingOwner {
+            private:
+                ProfilerRingOwner(const ProfilerRingOwner &);
+                ProfilerRingOwner& operator=(const ProfilerRingOwner &);
+
+            public:
+                ProfilerRingOwner() :
+                    m_ring(NULL) {}
+
+                ~ProfilerRingOwner() {
+                    if (NULL != m_ring) {
+                        Profiler::getInstance().releaseRing(m_ring);
+                    }
+                }
+
+                ProfilerRing *m_ring;
+        };
+
+        // The rings are owned by the profiler; a thread uses its ring until it finishes.
+        static thread_local ProfilerRingOwner threadRing;
+
+        const char Profiler::MAGIC[8] = { 'O', 'D', 'P', 'R', 'O', 'F', '0', '1' };
+
+        std::atomic<bool> Profiler::m_enabled(false);
+
+        Profiler::Profiler() :
+            m_mutex(),
+            m_running(false),
+            m_writer(),
+            m_file(),
+            m_numberOfDroppedEvents(0),
+            m_ringsMutex(),
+            m_rings(),
+            m_spareRings(),
+            m_numberOfThreads(0),
+            m_namesMutex(),
+            m_names(),
+            m_nameIdentifiers(),
+            m_numberOfWrittenNames(0) {
+            // Identifier 0 denotes unnamed events.
+            m_names.push_back("");
+        }
+
+        Profiler::~Profiler() {
+            stop();
+        }
+
+        Profiler& Profiler::getInstance() {
+            // The profiler is never destroyed as threads might still record events during shutdown.
+            static Profiler *instance = new Profiler();
+            return *instance;
+        }
+
+        bool Profiler::start(const string &fileName) {
+            std::lock_guard<std::mutex> l(m_mutex);
+            if (m_running) {
+                return true;
+            }
+
+            m_file.open(fileName.c_str(), ios::out | ios::binary | ios::trunc);
+            if (!m_file.good()) {
+                return false;
+            }
+
+            ProfilerHeader header;
+            ::memcpy(header.m_magic, MAGIC, sizeof(header.m_magic));
+            header.m_ticksPerMicrosecond = odcore::wrapper::SystemClock::getTicksPerMicrosecond();
+            m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+            {
+                std::lock_guard<std::mutex> ln(m_namesMutex);
+                m_numberOfWrittenNames = 1;
+            }
+            m_numberOfDroppedEvents = 0;
+
+            // Discard events from a previous run.
+            {
+                std::lock_guard<std::mutex> lr(m_ringsMutex);
+                stringstream discard;
+                for (auto ring : m_rings) {
+                    ring->drain(discard);
+                }
+                recycleReleasedRings();
+            }
+
+            m_running = true;
+            m_enabled = true;
+            m_writer = std::thread(&Profiler::run, this);
+            return true;
+        }
+
+        void Profiler::stop() {
+            std::lock_guard<std::mutex> l(m_mutex);
+            if (!m_running) {
+                return;
+            }
+
+            m_enabled = false;
+            m_running = false;
+            if (m_writer.joinable()) {
+                m_writer.join();
+            }
+
+            drain();
+            m_file.flush();
+            m_file.close();
+        }
+
+        uint16_t Profiler::registerName(const string &name) {
+            Profiler &profiler = getInstance();
+            std::lock_guard<std::mutex> l(profiler.m_namesMutex);
+            auto it = profiler.m_nameIdentifiers.find(name);
+            if (it != profiler.m_nameIdentifiers.end()) {
+                return it->second;
+            }
+            if (profiler.m_names.size() > 0xFFFF) {
+                return 0;
+            }
+            const uint16_t ID = static_cast<uint16_t>(profiler.m_names.size());
+            profiler.m_names.push_back(name);
+            profiler.m_nameIdentifiers[name] = ID;
+            return ID;
+        }
+
+        uint64_t Profiler::getNumberOfDroppedEvents() const {
+            return m_numberOfDroppedEvents;
+        }
+
+        uint32_t Profiler::getNumberOfRings() {
+            std::lock_guard<std::mutex> l(m_ringsMutex);
+            return static_cast<uint32_t>(m_rings.size() + m_spareRings.size());
+        }
+
+        void Profiler::recordEvent(const uint16_t &type, const uint16_t &name, const int64_t &value) {
+            ProfilerRing *ring = threadRing.m_ring;
+            if (NULL == ring) {
+                ring = threadRing.m_ring = getInstance().createRing();
+            }
+
+            ProfilerEvent e;
+            e.m_ticks = odcore::wrapper::SystemClock::getTicks();
+            e.m_value = value;
+            e.m_thread = ring->getThread();
+            e.m_type = type;
+            e.m_name = name;
+            ring->push(e);
+        }
+
+        ProfilerRing* Profiler::createRing() {
+            std::lock_guard<std::mutex> l(m_ringsMutex);
+            // Every thread gets its own identifier, also when reusing a ring.
+            const uint32_t THREAD = m_numberOfThreads++;
+            shared_ptr<ProfilerRing> ring;
+            if (!m_spareRings.empty()) {
+                ring = m_spareRings.back();
+                m_spareRings.pop_back();
+                ring->reuse(THREAD);
+            }
+            else {
+                ring = shared_ptr<ProfilerRing>(new ProfilerRing(THREAD));
+            }
+            m_rings.push_back(ring);
+            return ring.get();
+        }
+
+        void Profiler::releaseRing(ProfilerRing *ring) {
+            ring->release();
+
+            // Without the writer, nobody else consumes the rings.
+            std::lock_guard<std::mutex> l(m_mutex);
+            if (!m_running) {
+                std::lock_guard<std::mutex> lr(m_ringsMutex);
+                stringstream discard;
+                ring->drain(discard);
+                recycleReleasedRings();
+            }
+        }
+
+        void Profiler::recycleReleasedRings() {
+            for (auto it = m_rings.begin(); it != m_rings.end();) {
+                if ((*it)->isDrainedAndReleased()) {
+                    if (m_spareRings.size() < MAX_SPARE_RINGS) {
+                        m_spareRings.push_back(*it);
+                    }
+                    it = m_rings.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+        }
+
+        void Profiler::run() {
+            while (m_running) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(WRITER_INTERVAL));
+                drain();
+            }
+        }
+
+        void Profiler::drain() {
+            // Names are written before the events that might use them.
+            {
+                std::lock_guard<std::mutex> l(m_namesMutex);
+                while (m_numberOfWrittenNames < m_names.size()) {
+                    const string &NAME = m_names[m_numberOfWrittenNames];
+                    ProfilerEvent e;
+                    e.m_ticks = 0;
+                    e.m_value = static_cast<int64_t>(NAME.size());
+                    e.m_thread = 0;
+                    e.m_type = ProfilerEvent::NAME;
+                    e.m_name = static_cast<uint16_t>(m_numberOfWrittenNames);
+                    m_file.write(reinterpret_cast<const char*>(&e), sizeof(e));
+                    m_file.write(NAME.c_str(), static_cast<streamsize>(NAME.size()));
+                    m_numberOfWrittenNames++;
+                }
+            }
+
+            vector<shared_ptr<ProfilerRing> > rings;
+            {
+                std::lock_guard<std::mutex> l(m_ringsMutex);
+                rings = m_rings;
+            }
+            for (auto ring : rings) {
+                const uint64_t DROPPED = ring->drain(m_file);
+                if (DROPPED > 0) {
+                    ProfilerEvent e;
+                    e.m_ticks = odcore::wrapper::SystemClock::getTicks();
+                    e.m_value = static_cast<int64_t>(DROPPED);
+                    e.m_thread = ring->getThread();
+                    e.m_type = ProfilerEvent::DROPPED;
+                    e.m_name = 0;
+                    m_file.write(reinterpret_cast<const char*>(&e), sizeof(e));
+                    m_numberOfDroppedEvents += DROPPED;
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> l(m_ringsMutex);
+                recycleReleasedRings();
+            }
+        }
+
+    }
+} // odcore::base
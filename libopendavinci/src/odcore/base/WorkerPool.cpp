@@ -0,0 +1,88 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <algorithm>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/WorkerPool.h"
+
+namespace odcore {
+    namespace base {
+
+        using namespace std;
+
+        WorkerPool::WorkerPool(const uint32_t &numberOfWorkers) :
+            m_tasksMutex(),
+            m_tasksCondition(),
+            m_tasks(),
+            m_isRunning(true),
+            m_workers() {
+            const uint32_t NUMBER_OF_WORKERS = (numberOfWorkers > 0) ? numberOfWorkers : std::max<uint32_t>(1, std::thread::hardware_concurrency());
+            for (uint32_t i = 0; i < NUMBER_OF_WORKERS; i++) {
+                m_workers.push_back(std::thread(&WorkerPool::run, this));
+            }
+        }
+
+        WorkerPool::~WorkerPool() {
+            {
+                std::lock_guard<std::mutex> l(m_tasksMutex);
+                m_isRunning = false;
+            }
+            m_tasksCondition.notify_all();
+
+            vector<std::thread>::iterator it = m_workers.begin();
+            while (it != m_workers.end()) {
+                (*it++).join();
+            }
+        }
+
+        uint32_t WorkerPool::getNumberOfWorkers() const {
+            return static_cast<uint32_t>(m_workers.size());
+        }
+
+        void WorkerPool::enqueue(const std::function<void()> &task) {
+            {
+                std::lock_guard<std::mutex> l(m_tasksMutex);
+                m_tasks.push_back(task);
+            }
+            m_tasksCondition.notify_one();
+        }
+
+        void WorkerPool::run() {
+            while (true) {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> l(m_tasksMutex);
+                    while (m_isRunning && m_tasks.empty()) {
+                        m_tasksCondition.wait(l);
+                    }
+
+                    // Remaining tasks are finished before stopping.
+                    if (m_tasks.empty()) {
+                        break;
+                    }
+                    task = m_tasks.front();
+                    m_tasks.pop_front();
+                }
+                task();
+            }
+        }
+
+    }
+} // odcore::base
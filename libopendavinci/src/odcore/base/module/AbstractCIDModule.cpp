@@ -44,8 +44,12 @@ namespace odcore {
                     m_multicastGroup(),
                     m_CID(0),
                     m_profiling(false),
+                    m_telemetry(false),
+                    m_sharedMemoryTransport(false),
                     m_realtime(false),
-                    m_realtimePriority(0) {
+                    m_realtimePriority(0),
+                    m_overrunPolicy(DeadlineScheduler::STRETCH),
+                    m_busyWait(0) {
                 m_verbose = false;
                 parseCommandLine(argc, argv);
             }
@@ -65,7 +69,11 @@ namespace odcore {
                 cmdParser.addCommandLineArgument("freq");
                 cmdParser.addCommandLineArgument("verbose");
                 cmdParser.addCommandLineArgument("profiling");
+                cmdParser.addCommandLineArgument("telemetry");
+                cmdParser.addCommandLineArgument("shm");
                 cmdParser.addCommandLineArgument("realtime");
+                cmdParser.addCommandLineArgument("overrun");
+                cmdParser.addCommandLineArgument("busywait");
 
                 cmdParser.parse(argc, argv);
 
@@ -74,7 +82,11 @@ namespace odcore {
                 CommandLineArgument cmdArgumentFREQ = cmdParser.getCommandLineArgument("freq");
                 CommandLineArgument cmdArgumentVERBOSE = cmdParser.getCommandLineArgument("verbose");
                 CommandLineArgument cmdArgumentPROFILING = cmdParser.getCommandLineArgument("profiling");
+                CommandLineArgument cmdArgumentTELEMETRY = cmdParser.getCommandLineArgument("telemetry");
+                CommandLineArgument cmdArgumentSHM = cmdParser.getCommandLineArgument("shm");
                 CommandLineArgument cmdArgumentREALTIME = cmdParser.getCommandLineArgument("realtime");
+                CommandLineArgument cmdArgumentOVERRUN = cmdParser.getCommandLineArgument("overrun");
+                CommandLineArgument cmdArgumentBUSYWAIT = cmdParser.getCommandLineArgument("busywait");
 
                 if (cmdArgumentVERBOSE.isSet()) {
                     AbstractCIDModule::m_verbose = cmdArgumentVERBOSE.getValue<int32_t>();;
@@ -117,6 +129,15 @@ namespace odcore {
                     m_profiling = true;
                 }
 
+                if (cmdArgumentTELEMETRY.isSet()) {
+                    // --telemetry=0 disables the telemetry explicitly.
+                    m_telemetry = (cmdArgumentTELEMETRY.getValue<int>() != 0);
+                }
+
+                if (cmdArgumentSHM.isSet()) {
+                    m_sharedMemoryTransport = true;
+                }
+
                 if (cmdArgumentREALTIME.isSet()) {
                     errno = 0;
 #ifdef HAVE_LINUX_RT
@@ -134,6 +155,26 @@ namespace odcore {
                                                   "Realtime is only available on Linux with rt-preempt.");
 #endif
                 }
+
+                if (cmdArgumentOVERRUN.isSet()) {
+                    if (!DeadlineScheduler::parseOverrunPolicy(cmdArgumentOVERRUN.getValue<string>(), m_overrunPolicy)) {
+                        errno = 0;
+                        OPENDAVINCI_CORE_THROW_EXCEPTION(InvalidArgumentException,
+                                                      "The overrun policy has to be one of skip, burst, or stretch.");
+                    }
+                }
+
+                if (cmdArgumentBUSYWAIT.isSet()) {
+                    const int32_t BUSYWAIT = cmdArgumentBUSYWAIT.getValue<int32_t>();
+
+                    if (BUSYWAIT < 0) {
+                        errno = 0;
+                        OPENDAVINCI_CORE_THROW_EXCEPTION(InvalidArgumentException,
+                                                      "The busy-wait time must not be negative.");
+                    }
+
+                    m_busyWait = static_cast<uint32_t>(BUSYWAIT);
+                }
             }
 
             bool AbstractCIDModule::isVerbose() {
@@ -164,6 +205,14 @@ namespace odcore {
                 return m_realtimePriority;
             }
 
+            DeadlineScheduler::OVERRUNPOLICY AbstractCIDModule::getOverrunPolicy() const {
+                return m_overrunPolicy;
+            }
+
+            uint32_t AbstractCIDModule::getBusyWait() const {
+                return m_busyWait;
+            }
+
             void AbstractCIDModule::waitForNextFullSecond(const uint32_t &secondsIncrement) {
                 if (!isRealtime()) {
                     // Suspend this thread to the beginning of the secondsIncrement-th full second only
@@ -50,12 +50,16 @@ namespace odcore {
                     m_loggerInitializedMutex(),
                     m_loggerInitialized(false) {
                 // Create a container conference.
+                if (isSharedMemoryTransport()) {
+                    ContainerConferenceFactory::getInstance().setTransport(ContainerConferenceFactory::SHARED_MEMORY);
+                }
                 std::shared_ptr<ContainerConference> containerConference = ContainerConferenceFactory::getInstance().getContainerConference(getMultiCastGroup());
                 if (!containerConference.get()) {
                     OPENDAVINCI_CORE_THROW_EXCEPTION(InvalidArgumentException, "ContainerConference invalid!");
                 }
                 // Set senderStamp to module identifier by default.
                 containerConference->setSenderStamp(getIdentifier());
+                containerConference->setTelemetryEnabled(isTelemetry());
                 // Store container conference.
                 setContainerConference(containerConference);
 
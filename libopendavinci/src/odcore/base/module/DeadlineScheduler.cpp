@@ -0,0 +1,212 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifdef __linux__
+    #include <time.h>
+#endif
+
+#include <cerrno>
+#include <chrono>
+#include <thread>
+
+#include "opendavinci/odcore/base/module/DeadlineScheduler.h"
+#include "opendavinci/odcore/strings/StringToolbox.h"
+#include "opendavinci/odcore/wrapper/SystemClock.h"
+
+namespace odcore {
+    namespace base {
+        namespace module {
+
+            using namespace std;
+            using namespace odcore::wrapper;
+
+            // Upper bounds of the histogram's bins in nanoseconds.
+            static const int64_t JITTER_BINS[DeadlineScheduler::NUMBER_OF_HISTOGRAM_BINS - 1] = {
+                1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000, 500000, 1000000, 2000000
+            };
+
+            DeadlineScheduler::DeadlineScheduler() :
+                m_period(1000000000L),
+                m_busyWait(0),
+                m_overrunPolicy(STRETCH),
+                m_nextDeadline(0),
+                m_lastWaitTime(0),
+                m_numberOfOverruns(0),
+                m_numberOfSkippedCycles(0),
+                m_numberOfJitterSamples(0),
+                m_sumOfJitter(0),
+                m_maxJitter(0),
+                m_jitterHistogram(NUMBER_OF_HISTOGRAM_BINS, 0) {}
+
+            DeadlineScheduler::~DeadlineScheduler() {}
+
+            void DeadlineScheduler::setPeriod(const int64_t &microseconds) {
+                m_period = (microseconds > 0 ? microseconds : 1) * 1000L;
+            }
+
+            int64_t DeadlineScheduler::getPeriod() const {
+                return m_period / 1000L;
+            }
+
+            void DeadlineScheduler::setBusyWait(const int64_t &microseconds) {
+                m_busyWait = (microseconds > 0 ? microseconds : 0) * 1000L;
+            }
+
+            int64_t DeadlineScheduler::getBusyWait() const {
+                return m_busyWait / 1000L;
+            }
+
+            void DeadlineScheduler::setOverrunPolicy(const OVERRUNPOLICY &policy) {
+                m_overrunPolicy = policy;
+            }
+
+            DeadlineScheduler::OVERRUNPOLICY DeadlineScheduler::getOverrunPolicy() const {
+                return m_overrunPolicy;
+            }
+
+            void DeadlineScheduler::start() {
+                m_nextDeadline = SystemClock::getMonotonicNanoseconds() + m_period;
+            }
+
+            bool DeadlineScheduler::isStarted() const {
+                return (m_nextDeadline > 0);
+            }
+
+            bool DeadlineScheduler::waitForNextDeadline() {
+                if (!isStarted()) {
+                    start();
+                }
+
+                const int64_t NOW = SystemClock::getMonotonicNanoseconds();
+                if (NOW <= m_nextDeadline) {
+                    waitUntil(m_nextDeadline);
+                    m_nextDeadline += m_period;
+                    m_lastWaitTime = SystemClock::getMonotonicNanoseconds() - NOW;
+                    return false;
+                }
+
+                m_numberOfOverruns++;
+                const int64_t BEHIND = NOW - m_nextDeadline;
+                if (SKIP == m_overrunPolicy) {
+                    // Drop all time slices whose deadlines have passed and stay on the grid.
+                    const int64_t MISSED = BEHIND / m_period + 1;
+                    m_numberOfSkippedCycles += static_cast<uint32_t>(MISSED);
+                    m_nextDeadline += MISSED * m_period;
+                    waitUntil(m_nextDeadline);
+                    m_nextDeadline += m_period;
+                }
+                else if ( (BURST == m_overrunPolicy) && (BEHIND < MAX_BURST_CYCLES * m_period) ) {
+                    m_nextDeadline += m_period;
+                }
+                else {
+                    m_nextDeadline = NOW + m_period;
+                }
+                m_lastWaitTime = SystemClock::getMonotonicNanoseconds() - NOW;
+                return true;
+            }
+
+            int64_t DeadlineScheduler::getLastWaitTime() const {
+                return m_lastWaitTime / 1000L;
+            }
+
+            void DeadlineScheduler::waitUntil(const int64_t &deadline) {
+                const int64_t WAKEUP = deadline - m_busyWait;
+                if (WAKEUP > SystemClock::getMonotonicNanoseconds()) {
+#ifdef __linux__
+                    // SystemClock's steady_clock is based on CLOCK_MONOTONIC.
+                    struct timespec ts;
+                    ts.tv_sec = static_cast<time_t>(WAKEUP / 1000000000L);
+                    ts.tv_nsec = static_cast<long>(WAKEUP % 1000000000L);
+                    while (EINTR == ::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL)) {}
+#else
+                    std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(WAKEUP))));
+#endif
+                }
+
+                // Spin for the remaining time.
+                int64_t now = SystemClock::getMonotonicNanoseconds();
+                while (now < deadline) {
+                    now = SystemClock::getMonotonicNanoseconds();
+                }
+                addJitter(now - deadline);
+            }
+
+            void DeadlineScheduler::addJitter(const int64_t &jitter) {
+                uint32_t bin = 0;
+                while ( (bin < NUMBER_OF_HISTOGRAM_BINS - 1) && (jitter > JITTER_BINS[bin]) ) {
+                    bin++;
+                }
+                m_jitterHistogram[bin]++;
+
+                m_numberOfJitterSamples++;
+                m_sumOfJitter += jitter;
+                m_maxJitter = (jitter > m_maxJitter) ? jitter : m_maxJitter;
+            }
+
+            uint32_t DeadlineScheduler::getNumberOfOverruns() const {
+                return m_numberOfOverruns;
+            }
+
+            uint32_t DeadlineScheduler::getNumberOfSkippedCycles() const {
+                return m_numberOfSkippedCycles;
+            }
+
+            double DeadlineScheduler::getMeanJitter() const {
+                if (0 == m_numberOfJitterSamples) {
+                    return 0;
+                }
+                return static_cast<double>(m_sumOfJitter) / m_numberOfJitterSamples / 1000.0;
+            }
+
+            double DeadlineScheduler::getMaxJitter() const {
+                return static_cast<double>(m_maxJitter) / 1000.0;
+            }
+
+            vector<uint32_t> DeadlineScheduler::getJitterHistogram() const {
+                return m_jitterHistogram;
+            }
+
+            void DeadlineScheduler::resetStatistics() {
+                m_numberOfOverruns = 0;
+                m_numberOfSkippedCycles = 0;
+                m_numberOfJitterSamples = 0;
+                m_sumOfJitter = 0;
+                m_maxJitter = 0;
+                m_jitterHistogram.assign(NUMBER_OF_HISTOGRAM_BINS, 0);
+            }
+
+            bool DeadlineScheduler::parseOverrunPolicy(const string &name, OVERRUNPOLICY &policy) {
+                if (odcore::strings::StringToolbox::equalsIgnoreCase(name, "skip")) {
+                    policy = SKIP;
+                    return true;
+                }
+                if (odcore::strings::StringToolbox::equalsIgnoreCase(name, "burst")) {
+                    policy = BURST;
+                    return true;
+                }
+                if (odcore::strings::StringToolbox::equalsIgnoreCase(name, "stretch")) {
+                    policy = STRETCH;
+                    return true;
+                }
+                return false;
+            }
+
+        }
+    }
+} // odcore::base::module
@@ -24,7 +24,6 @@
 
 #include <cmath>
 #include <exception>
-#include <fstream>
 #include <iostream>
 #include <sstream>
 #include <vector>
@@ -32,14 +31,19 @@
 #include "opendavinci/odcontext/base/ControlledTime.h"
 #include "opendavinci/odcontext/base/ControlledTimeFactory.h"
 #include "opendavinci/odcontext/base/RuntimeControl.h"
+#include "opendavinci/odcore/base/Profiler.h"
 #include "opendavinci/odcore/base/Thread.h"
 #include "opendavinci/odcore/base/module/ManagedClientModule.h"
 #include "opendavinci/odcore/base/module/ManagedClientModuleContainerConference.h"
 #include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/data/ContainerBatch.h"
 #include "opendavinci/odcore/data/TimeStamp.h"
 #include "opendavinci/odcore/dmcp/connection/Client.h"
 #include "opendavinci/odcore/exceptions/Exceptions.h"
 #include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/wrapper/SystemClock.h"
+#include "opendavinci/odcore/wrapper/TimeFactory.h"
+#include "opendavinci/generated/odcore/data/dmcp/ContainerStatistics.h"
 #include "opendavinci/generated/odcore/data/dmcp/ModuleStateMessage.h"
 #include "opendavinci/generated/odcore/data/dmcp/RuntimeStatistic.h"
 #include "opendavinci/generated/odcore/data/dmcp/ServerInformation.h"
@@ -63,9 +67,11 @@ namespace odcore {
                 m_startOfCurrentCycle(),
                 m_startOfLastCycle(),
                 m_lastCycle(),
+                m_lastCycleMonotonic(odcore::wrapper::SystemClock::getMonotonicMicroseconds()),
                 m_lastWaitTime(0),
                 m_cycleCounter(0),
-                m_profilingFile(NULL),
+                m_isProfiling(false),
+                m_scheduler(),
                 m_firstCallToBreakpoint_ManagedLevel_Pulse(true),
                 m_time(),
                 m_controlledTimeFactory(NULL),
@@ -78,17 +84,14 @@ namespace odcore {
             }
 
             ManagedClientModule::~ManagedClientModule() {
-                if (m_profilingFile != NULL) {
-                    m_profilingFile->flush();
-                    m_profilingFile->close();
+                if (m_isProfiling) {
+                    Profiler::getInstance().stop();
                 }
 
                 if (m_hasExternalContainerConference) {
                     m_containerConference.reset();
                     m_hasExternalContainerConference = false;
                 }
-
-                OPENDAVINCI_CORE_DELETE_POINTER(m_profilingFile);
             }
 
             void ManagedClientModule::DMCPconnectionLost() {}
@@ -123,6 +126,11 @@ namespace odcore {
                     OPENDAVINCI_CORE_THROW_EXCEPTION(InvalidArgumentException,
                                                   "Realtime scheduling specified but current module shall run in dependent manage level (i.e. supercomponent is running with a different level than --managed=none!)");
                 }
+
+                // Record the end of this cycle to measure the time waited for the next one.
+                const int64_t END_OF_CYCLE = Profiler::isEnabled() ? odcore::wrapper::SystemClock::getMonotonicNanoseconds() : 0;
+                Profiler::record(ProfilerEvent::CYCLE_END, 0, m_cycleCounter);
+
                 if (isRealtime() && getServerInformation().getManagedLevel() == odcore::data::dmcp::ServerInformation::ML_NONE) {
                     wait_ManagedLevel_None_realtime();
                 }
@@ -152,6 +160,10 @@ namespace odcore {
                         wait_ManagedLevel_Pulse_Time_Ack_Containers();
                     }            
                 }
+
+                if (Profiler::isEnabled() && (END_OF_CYCLE > 0)) {
+                    Profiler::record(ProfilerEvent::CYCLE_BEGIN, 0, odcore::wrapper::SystemClock::getMonotonicNanoseconds() - END_OF_CYCLE);
+                }
             }
 
             odcore::data::dmcp::ModuleExitCodeMessage::ModuleExitCode ManagedClientModule::runModuleImplementation() {
@@ -160,6 +172,16 @@ namespace odcore {
                     OPENDAVINCI_CORE_THROW_EXCEPTION(InvalidArgumentException,
                                                   "Realtime scheduling specified but current module shall run in dependent manage level (i.e. supercomponent is running with a different level than --managed=none!)");
                 }
+
+                // Trace the cycles into a binary file to be converted by odprofileconverter.
+                if (isProfiling() && !m_isProfiling) {
+                    stringstream sstr;
+                    sstr << getName() << "_" << TimeStamp().getYYYYMMDD_HHMMSS_noBlankNoColons() << ".profiling.bin";
+                    m_isProfiling = Profiler::getInstance().start(sstr.str());
+                    if (!m_isProfiling) {
+                        clog << "Could not create profiling file " << sstr.str() << endl;
+                    }
+                }
                 if (isRealtime() && getServerInformation().getManagedLevel() == odcore::data::dmcp::ServerInformation::ML_NONE) {
 #ifdef HAVE_LINUX_RT
                     // Setup realtime task using FIFO scheduling.
@@ -243,42 +265,6 @@ namespace odcore {
                 }
             }
 
-            void ManagedClientModule::logProfilingData(const TimeStamp &current, const TimeStamp &lastCycle, const float &freq, const long &lastWaitTime, const long &timeConsumptionCurrent, const long &nominalDuration, const long &waitingTimeCurrent, const int32_t &cycleCounter) {
-                if (m_profilingFile == NULL) {
-                    stringstream sstr;
-                    sstr << getName() << "_" << TimeStamp().getYYYYMMDD_HHMMSS_noBlankNoColons() << ".profiling.csv";
-                    m_profilingFile = new ofstream();
-                    m_profilingFile->open(sstr.str().c_str(), ios::out | ios::app);
-
-                    (*m_profilingFile) <<
-                        "timestamp_current_cycle" << ";" <<
-                        "timestamp_last_cycle" << ";" <<
-                        "freq" << ";" <<
-                        "last_wait_time" << ";" <<
-                        "time_consumption_current" << ";" <<
-                        "nominal_duration" << ";" <<
-                        "waiting_time_current" << ";" <<
-                        "percentage_load_current_slice" << ";" <<
-                        "percentage_waiting_current_slice" << ";" <<
-                        "cycle_counter" << endl;
-                }
-
-                if (m_profilingFile != NULL) {
-                    (*m_profilingFile) <<
-                        current.toMicroseconds() << ";" <<
-                        lastCycle.toMicroseconds() << ";" <<
-                        freq << ";" <<
-                        lastWaitTime << ";" <<
-                        timeConsumptionCurrent << ";" <<
-                        nominalDuration << ";" <<
-                        waitingTimeCurrent << ";" <<
-                        (100.0-(waitingTimeCurrent*100.0/(static_cast<float>(nominalDuration)))) << ";" <<
-                        (waitingTimeCurrent*100.0/(static_cast<float>(nominalDuration))) << ";" <<
-                        cycleCounter << endl;
-                    m_profilingFile->flush();
-                }
-            }
-
             ///////////////////////////////////////////////////////////////////////
             // Implementation for managed level none.
             ///////////////////////////////////////////////////////////////////////
@@ -298,6 +284,9 @@ namespace odcore {
                         getDMCPClient()->sendModuleState(odcore::data::dmcp::ModuleStateMessage::RUNNING);
                     }
 
+                    // The first time slice starts now.
+                    startScheduler();
+
                     // Execute the module's body.
                     retVal = body();
 
@@ -334,8 +323,12 @@ namespace odcore {
                 m_startOfCurrentCycle = current;
                 m_startOfLastCycle = m_lastCycle;
 
+                // Measure the cycle with a monotonic clock so that NTP steps do not disturb the scheduling; a controlled time is used as is.
+                const int64_t CURRENT_MONOTONIC = odcore::wrapper::TimeFactory::isControlled() ? current.toMicroseconds() : odcore::wrapper::SystemClock::getMonotonicMicroseconds();
+                const int64_t LAST_CYCLE_MONOTONIC = odcore::wrapper::TimeFactory::isControlled() ? m_lastCycle.toMicroseconds() : m_lastCycleMonotonic;
+
                 const float FREQ = getFrequency();
-                const long TIME_CONSUMPTION_OF_CURRENT_SLICE = (current.toMicroseconds() - m_lastCycle.toMicroseconds()) - m_lastWaitTime;
+                const long TIME_CONSUMPTION_OF_CURRENT_SLICE = (CURRENT_MONOTONIC - LAST_CYCLE_MONOTONIC) - m_lastWaitTime;
 
                 const long ONE_SECOND_IN_MICROSECONDS = 1000 * 1000 * 1;
                 const long NOMINAL_DURATION_OF_ONE_SLICE = static_cast<long>((1.0f/FREQ) * ONE_SECOND_IN_MICROSECONDS);
@@ -361,16 +354,28 @@ namespace odcore {
                 if (sendStatistics && getDMCPClient().get()) {
                     odcore::data::dmcp::RuntimeStatistic rts;
                     rts.setSliceConsumption(static_cast<float>(TIME_CONSUMPTION_OF_CURRENT_SLICE)/static_cast<float>(NOMINAL_DURATION_OF_ONE_SLICE));
+                    rts.setNumberOfOverruns(m_scheduler.getNumberOfOverruns());
+                    rts.setNumberOfSkippedCycles(m_scheduler.getNumberOfSkippedCycles());
+                    rts.setMeanJitter(m_scheduler.getMeanJitter());
+                    rts.setMaxJitter(m_scheduler.getMaxJitter());
+                    rts.setListOfJitterHistogram(m_scheduler.getJitterHistogram());
+                    m_scheduler.resetStatistics();
                     getDMCPClient()->sendStatistics(rts);
                 }
 
-                // Check whether we need to save profiling data.
-                if (isProfiling()) {
-                    logProfilingData(current, m_lastCycle, FREQ, m_lastWaitTime, TIME_CONSUMPTION_OF_CURRENT_SLICE, NOMINAL_DURATION_OF_ONE_SLICE, WAITING_TIME_OF_CURRENT_SLICE, m_cycleCounter);
+                // Publish the container telemetry if enabled by --telemetry.
+                if (sendStatistics && m_containerConference.get() && m_containerConference->isTelemetryEnabled()) {
+                    odcore::data::dmcp::ContainerStatistics cs = m_containerConference->getTelemetry().getStatisticsAndReset();
+                    cs.setModuleName(getName());
+                    cs.setIdentifier(getIdentifier());
+
+                    Container c(cs);
+                    m_containerConference->send(c);
                 }
 
                 // Store "now" to m_lastCycle for usage in next cycle.
                 m_lastCycle = current;
+                m_lastCycleMonotonic = CURRENT_MONOTONIC;
 
                 // Save the time to be waited.
                 if (WAITING_TIME_OF_CURRENT_SLICE > 0) {
@@ -383,13 +388,30 @@ namespace odcore {
                 return WAITING_TIME_OF_CURRENT_SLICE;
             }
 
+            void ManagedClientModule::startScheduler() {
+                const double ONE_SECOND_IN_MICROSECONDS = 1000 * 1000 * 1;
+                m_scheduler.setPeriod(static_cast<int64_t>(ONE_SECOND_IN_MICROSECONDS / getFrequency()));
+                m_scheduler.setBusyWait(getBusyWait());
+                m_scheduler.setOverrunPolicy(getOverrunPolicy());
+                m_scheduler.start();
+            }
+
             void ManagedClientModule::wait_ManagedLevel_None() {
-                const long WAITING_TIME_OF_CURRENT_SLICE = getWaitingTimeAndUpdateRuntimeStatistics();
+                // Update statistics and ignore return value as the time slices are scheduled at absolute deadlines.
+                getWaitingTimeAndUpdateRuntimeStatistics();
 
-                // Enforce waiting to consume the rest of the time slice but ensure that there is no overflow.
-                const long ONE_SECOND_IN_MICROSECONDS = 1000 * 1000 * 1;
-                if ( (WAITING_TIME_OF_CURRENT_SLICE > 0) && (WAITING_TIME_OF_CURRENT_SLICE < ONE_SECOND_IN_MICROSECONDS) ) {
-                    Thread::usleepFor(WAITING_TIME_OF_CURRENT_SLICE);
+                if (!m_scheduler.isStarted()) {
+                    startScheduler();
+                }
+
+                // Wait for the next deadline; missed deadlines are handled according to --overrun.
+                if (m_scheduler.waitForNextDeadline()) {
+                    CLOG2 << "Deadline missed." << endl;
+                }
+
+                // Account the time actually slept rather than the computed one so that oversleeping is not attributed to the slice.
+                if (!odcore::wrapper::TimeFactory::isControlled()) {
+                    m_lastWaitTime = static_cast<long>(m_scheduler.getLastWaitTime());
                 }
 
                 CLOG2 << "Starting next cycle at " << TimeStamp().toString() << endl;
@@ -657,7 +679,7 @@ namespace odcore {
                 // Confirm the successful processing of the received pulse and
                 // deliver all containers from this module to supercomponent.
                 if (getDMCPClient().get()) {
-                    getDMCPClient()->sendPulseAckContainers(reinterpret_cast<ManagedClientModuleContainerConference*>(m_localContainerConference.operator->())->getListOfContainers());
+                    getDMCPClient()->sendPulseAckContainers(reinterpret_cast<ManagedClientModuleContainerConference*>(m_localContainerConference.operator->())->getContainerBatch());
 
                     // After all containers have been delivered to supercomponent,
                     // reset the list of containers from the last iteration in our own
@@ -669,8 +691,10 @@ namespace odcore {
                 // next pulse message.
                 reached_ManagedLevel_Pulse_Time();
 
-                // Deliver containers from last cycle before starting current cycle.
-                vector<Container> listOfContainersToBeDistributed = m_pulseMessage.getListOfContainers();
+                // Deliver containers from last cycle before starting current cycle; an older
+                // supercomponent sends them as list instead of a batch.
+                const string CONTAINER_BATCH = m_pulseMessage.getContainerBatch();
+                vector<Container> listOfContainersToBeDistributed = (CONTAINER_BATCH.empty() ? m_pulseMessage.getListOfContainers() : ContainerBatch(CONTAINER_BATCH).getListOfContainers());
                 vector<Container>::iterator it = listOfContainersToBeDistributed.begin();
                 while (it != listOfContainersToBeDistributed.end()) {
                     Container c = *it;
@@ -17,6 +17,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include "opendavinci/odcore/base/Profiler.h"
 #include "opendavinci/odcore/base/module/ManagedClientModuleContainerConference.h"
 #include "opendavinci/odcore/data/TimeStamp.h"
 
@@ -27,11 +28,13 @@ namespace odcore {
             using namespace odcore::data;
 
             ManagedClientModuleContainerConference::ManagedClientModuleContainerConference() :
-                m_listOfContainersToBeDelivered() {}
+                m_containersToBeDelivered() {}
 
             ManagedClientModuleContainerConference::~ManagedClientModuleContainerConference() {}
 
             void ManagedClientModuleContainerConference::send(odcore::data::Container &container) const {
+                Profiler::record(ProfilerEvent::CONTAINER_OUT, 0, container.getDataType());
+
                 // Put container to be sent into our list of data to be distributed.
                 container.setSentTimeStamp(TimeStamp());
 
@@ -40,16 +43,21 @@ namespace odcore {
                     container.setSampleTimeStamp(container.getSentTimeStamp());
                 }
 
+                // Serialize the container only once; supercomponent forwards the serialized data as is.
                 // The const cast is required as the method signature is designed to be const...
-                const_cast<ManagedClientModuleContainerConference*>(this)->m_listOfContainersToBeDelivered.push_back(container);
+                const_cast<ManagedClientModuleContainerConference*>(this)->m_containersToBeDelivered.add(container);
             }
 
             vector<odcore::data::Container> ManagedClientModuleContainerConference::getListOfContainers() const {
-                return m_listOfContainersToBeDelivered;
+                return m_containersToBeDelivered.getListOfContainers();
+            }
+
+            const odcore::data::ContainerBatch& ManagedClientModuleContainerConference::getContainerBatch() const {
+                return m_containersToBeDelivered;
             }
 
             void ManagedClientModuleContainerConference::clearListOfContainers() {
-                m_listOfContainersToBeDelivered.clear();
+                m_containersToBeDelivered.clear();
             }
 
             void ManagedClientModuleContainerConference::receiveFromLocal(odcore::data::Container &c) {
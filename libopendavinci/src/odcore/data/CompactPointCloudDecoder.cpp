@@ -0,0 +1,247 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "opendavinci/odcore/data/CompactPointCloudDecoder.h"
+#include "opendavinci/odcore/wrapper/Eigen.h"
+
+namespace odcore {
+    namespace data {
+
+        using namespace std;
+
+        CompactPointCloudDecoder::PointBuffer::PointBuffer() :
+            m_distance(),
+            m_azimuth(),
+            m_verticalAngle(),
+            m_x(),
+            m_y(),
+            m_z(),
+            m_intensity() {}
+
+        void CompactPointCloudDecoder::PointBuffer::clear() {
+            resize(0);
+        }
+
+        uint32_t CompactPointCloudDecoder::PointBuffer::size() const {
+            return m_distance.size();
+        }
+
+        void CompactPointCloudDecoder::PointBuffer::resize(const uint32_t &numberOfPoints) {
+            m_distance.resize(numberOfPoints);
+            m_azimuth.resize(numberOfPoints);
+            m_verticalAngle.resize(numberOfPoints);
+            m_x.resize(numberOfPoints);
+            m_y.resize(numberOfPoints);
+            m_z.resize(numberOfPoints);
+            m_intensity.resize(numberOfPoints);
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+
+        CompactPointCloudDecoder::CompactPointCloudDecoder() :
+            m_vlp16(),
+            m_hdl32Part1(),
+            m_hdl32Part2(),
+            m_hdl32Part3(),
+            m_unsupported(),
+            m_sinAzimuths(),
+            m_cosAzimuths(),
+            m_sinVerticalAngles(),
+            m_cosVerticalAngles() {
+            // VLP-16: The entries per azimuth are sorted by increasing vertical angles from -15 to 15 DEG with increment 2 DEG.
+            vector<float> vlp16;
+            for (uint32_t layer = 0; layer < 16; layer++) {
+                vlp16.push_back(-15.0f + 2.0f * layer);
+            }
+            setVerticalAngles(m_vlp16, vlp16);
+
+            // HDL-32E: Vertical angles range from -30.67 to 10.67 DEG with increment 4/3 DEG (alternating 1.33 and 1.34 DEG).
+            vector<float> hdl32;
+            for (uint32_t layer = 0; layer < 32; layer++) {
+                hdl32.push_back(-30.67f + (4.0f / 3.0f) * layer);
+            }
+
+            // A complete scan of a HDL-32E is split into three CompactPointClouds:
+            // Part 1 with 12 layers: 0, 1, 4, 7, 10, 13, 16, 19, 22, 25, 28, 31
+            // Part 2 with 11 layers: 2, 3, 6, 9, 12, 15, 18, 21, 24, 27, 30
+            // Part 3 with 9 layers: 5, 8, 11, 14, 17, 20, 23, 26, 29
+            vector<float> part1;
+            part1.push_back(hdl32[0]);
+            part1.push_back(hdl32[1]);
+            for (uint32_t layer = 4; layer < 32; layer += 3) {
+                part1.push_back(hdl32[layer]);
+            }
+            setVerticalAngles(m_hdl32Part1, part1);
+
+            vector<float> part2;
+            part2.push_back(hdl32[2]);
+            part2.push_back(hdl32[3]);
+            for (uint32_t layer = 6; layer < 32; layer += 3) {
+                part2.push_back(hdl32[layer]);
+            }
+            setVerticalAngles(m_hdl32Part2, part2);
+
+            vector<float> part3;
+            for (uint32_t layer = 5; layer < 32; layer += 3) {
+                part3.push_back(hdl32[layer]);
+            }
+            setVerticalAngles(m_hdl32Part3, part3);
+        }
+
+        CompactPointCloudDecoder::~CompactPointCloudDecoder() {}
+
+        void CompactPointCloudDecoder::setVerticalAngles(Layers &layers, const vector<float> &verticalAngles) {
+            const double DEG2RAD = M_PI / 180.0;
+            layers.m_verticalAngles = verticalAngles;
+            layers.m_sinVerticalAngles.clear();
+            layers.m_cosVerticalAngles.clear();
+            for (uint32_t i = 0; i < verticalAngles.size(); i++) {
+                layers.m_sinVerticalAngles.push_back(static_cast<float>(sin(verticalAngles[i] * DEG2RAD)));
+                layers.m_cosVerticalAngles.push_back(static_cast<float>(cos(verticalAngles[i] * DEG2RAD)));
+            }
+        }
+
+        const CompactPointCloudDecoder::Layers* CompactPointCloudDecoder::getLayers(const uint8_t &entriesPerAzimuth) const {
+            switch (entriesPerAzimuth) {
+                case 16: return &m_vlp16;
+                case 12: return &m_hdl32Part1;
+                case 11: return &m_hdl32Part2;
+                case 9: return &m_hdl32Part3;
+            }
+            return NULL;
+        }
+
+        const vector<float>& CompactPointCloudDecoder::getVerticalAngles(const uint8_t &entriesPerAzimuth) const {
+            const Layers *layers = getLayers(entriesPerAzimuth);
+            return (NULL != layers) ? layers->m_verticalAngles : m_unsupported.m_verticalAngles;
+        }
+
+        uint32_t CompactPointCloudDecoder::decode(const CompactPointCloud &cpc, PointBuffer &points, const bool &isNetworkByteOrder) {
+            const Layers *layers = getLayers(cpc.getEntriesPerAzimuth());
+            const uint8_t NUMBER_OF_BITS_FOR_INTENSITY = cpc.getNumberOfBitsForIntensity();
+            if ( (NULL == layers) || (NUMBER_OF_BITS_FOR_INTENSITY > 15) ) {
+                return 0;
+            }
+
+            const string distances = cpc.getDistances();
+            const uint32_t ENTRIES_PER_AZIMUTH = layers->m_verticalAngles.size();
+            const uint32_t NUMBER_OF_AZIMUTHS = (distances.size() / 2) / ENTRIES_PER_AZIMUTH;
+            if (0 == NUMBER_OF_AZIMUTHS) {
+                return 0;
+            }
+
+            // Distances are stored in cm or in 2mm; like in the previous viewers, points not farther than 1m are discarded.
+            const bool IS_CM = (CompactPointCloud::CM == cpc.getDistanceEncoding());
+            const float SCALE = (IS_CM ? 1.0f/100.0f : 1.0f/500.0f);
+            const uint16_t THRESHOLD = (IS_CM ? 100 : 500);
+
+            // The intensity is stored either in the higher or in the lower bits of a distance value.
+            const bool INTENSITY_IN_HIGHER_BITS = (CompactPointCloud::HIGHER_BITS == cpc.getIntensityPlacement());
+            uint16_t distanceMask = 0xFFFF;
+            if (NUMBER_OF_BITS_FOR_INTENSITY > 0) {
+                distanceMask = (INTENSITY_IN_HIGHER_BITS ? (0xFFFF >> NUMBER_OF_BITS_FOR_INTENSITY) : static_cast<uint16_t>(0xFFFF << NUMBER_OF_BITS_FOR_INTENSITY));
+            }
+            const float INTENSITY_SCALE = (NUMBER_OF_BITS_FOR_INTENSITY > 0) ? 1.0f / static_cast<float>((1 << NUMBER_OF_BITS_FOR_INTENSITY) - 1) : 0.0f;
+
+            const float START_AZIMUTH = cpc.getStartAzimuth();
+            const float AZIMUTH_INCREMENT = (cpc.getEndAzimuth() - START_AZIMUTH) / NUMBER_OF_AZIMUTHS;
+
+            // Sine and cosine values of all azimuths.
+            m_sinAzimuths.resize(NUMBER_OF_AZIMUTHS);
+            m_cosAzimuths.resize(NUMBER_OF_AZIMUTHS);
+            {
+                const float DEG2RAD = static_cast<float>(M_PI / 180.0);
+                Map<ArrayXf> sinAzimuths(&m_sinAzimuths[0], NUMBER_OF_AZIMUTHS);
+                Map<ArrayXf> cosAzimuths(&m_cosAzimuths[0], NUMBER_OF_AZIMUTHS);
+                sinAzimuths = ArrayXf::LinSpaced(NUMBER_OF_AZIMUTHS, START_AZIMUTH * DEG2RAD, (START_AZIMUTH + AZIMUTH_INCREMENT * (NUMBER_OF_AZIMUTHS - 1)) * DEG2RAD);
+                cosAzimuths = sinAzimuths.cos();
+                sinAzimuths = sinAzimuths.sin();
+            }
+
+            // Unpack all distances and gather the sine and cosine values per point.
+            const uint32_t START = points.size();
+            const uint32_t MAX_NUMBER_OF_POINTS = NUMBER_OF_AZIMUTHS * ENTRIES_PER_AZIMUTH;
+            points.resize(START + MAX_NUMBER_OF_POINTS);
+            m_sinVerticalAngles.resize(MAX_NUMBER_OF_POINTS);
+            m_cosVerticalAngles.resize(MAX_NUMBER_OF_POINTS);
+
+            const uint8_t *data = reinterpret_cast<const uint8_t*>(distances.data());
+            float *distance = &points.m_distance[START];
+            float *azimuth = &points.m_azimuth[START];
+            float *verticalAngle = &points.m_verticalAngle[START];
+            float *intensity = &points.m_intensity[START];
+            float *x = &points.m_x[START];
+            float *y = &points.m_y[START];
+            uint32_t numberOfPoints = 0;
+            for (uint32_t azimuthIndex = 0; azimuthIndex < NUMBER_OF_AZIMUTHS; azimuthIndex++) {
+                const float AZIMUTH = START_AZIMUTH + AZIMUTH_INCREMENT * azimuthIndex;
+                for (uint32_t layer = 0; layer < ENTRIES_PER_AZIMUTH; layer++, data += 2) {
+                    uint16_t value = 0;
+                    if (isNetworkByteOrder) {
+                        value = static_cast<uint16_t>((data[0] << 8) | data[1]);
+                    }
+                    else {
+                        memcpy(&value, data, sizeof(uint16_t));
+                    }
+
+                    const uint16_t DISTANCE = value & distanceMask;
+                    if (DISTANCE <= THRESHOLD) {
+                        continue;
+                    }
+
+                    distance[numberOfPoints] = DISTANCE * SCALE;
+                    azimuth[numberOfPoints] = AZIMUTH;
+                    verticalAngle[numberOfPoints] = layers->m_verticalAngles[layer];
+                    intensity[numberOfPoints] = (INTENSITY_IN_HIGHER_BITS ? (value >> (16 - NUMBER_OF_BITS_FOR_INTENSITY)) : (value & ~distanceMask & 0xFFFF)) * INTENSITY_SCALE;
+                    // Use the x and y arrays for the sine and cosine values of the azimuth.
+                    x[numberOfPoints] = m_sinAzimuths[azimuthIndex];
+                    y[numberOfPoints] = m_cosAzimuths[azimuthIndex];
+                    m_sinVerticalAngles[numberOfPoints] = layers->m_sinVerticalAngles[layer];
+                    m_cosVerticalAngles[numberOfPoints] = layers->m_cosVerticalAngles[layer];
+                    numberOfPoints++;
+                }
+            }
+            points.resize(START + numberOfPoints);
+
+            // Vectorized conversion to Cartesian coordinates.
+            if (numberOfPoints > 0) {
+                Map<ArrayXf> d(&points.m_distance[START], numberOfPoints);
+                Map<ArrayXf> xs(&points.m_x[START], numberOfPoints);
+                Map<ArrayXf> ys(&points.m_y[START], numberOfPoints);
+                Map<ArrayXf> zs(&points.m_z[START], numberOfPoints);
+                Map<ArrayXf> sinVerticalAngles(&m_sinVerticalAngles[0], numberOfPoints);
+                Map<ArrayXf> cosVerticalAngles(&m_cosVerticalAngles[0], numberOfPoints);
+
+                // Distance in the xy-plane.
+                cosVerticalAngles *= d;
+                xs *= cosVerticalAngles;
+                ys *= cosVerticalAngles;
+                zs = d * sinVerticalAngles;
+            }
+
+            return numberOfPoints;
+        }
+
+    }
+} // odcore::data
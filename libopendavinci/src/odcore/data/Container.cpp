@@ -94,6 +94,10 @@ namespace odcore {
             return m_dataType;
         }
 
+        const string Container::getRawData() const {
+            return m_serializedData.str();
+        }
+
         const TimeStamp Container::getSentTimeStamp() const {
             return m_sent;
         }
@@ -270,13 +274,13 @@ namespace odcore {
             m_serializedData.str(rawData);
 
             // Read sent time stamp data.
-            d->read(3, m_sent); m_sent.computeHumanReadableRepresentation();
+            d->read(3, m_sent);
 
             // Read received time stamp data.
-            d->read(4, m_received); m_received.computeHumanReadableRepresentation();
+            d->read(4, m_received);
 
             // Read sample time stamp.
-            d->read(5, m_sampleTimeStamp); m_sampleTimeStamp.computeHumanReadableRepresentation();
+            d->read(5, m_sampleTimeStamp);
 
             // Read sender stamp.
             d->read(6, m_senderStamp);
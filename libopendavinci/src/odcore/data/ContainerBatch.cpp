@@ -0,0 +1,128 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include "opendavinci/odcore/data/ContainerBatch.h"
+
+namespace odcore {
+    namespace data {
+
+        using namespace std;
+
+        // Size of the header 0x0D 0xA4 A B C.
+        static const uint32_t OPENDAVINCI_CONTAINER_HEADER_SIZE = 5;
+
+        ContainerBatch::ContainerBatch() :
+            m_rawData(),
+            m_numberOfContainers(0) {}
+
+        ContainerBatch::ContainerBatch(const string &rawData) :
+            m_rawData(rawData),
+            m_numberOfContainers(0) {
+            uint32_t position = 0;
+            while (position < m_rawData.size()) {
+                const uint32_t SIZE = getSizeOfContainer(m_rawData, position);
+                if (0 == SIZE) {
+                    cerr << "[core::data::ContainerBatch] Discarding " << (m_rawData.size() - position) << " bytes of invalid data." << endl;
+                    m_rawData.resize(position);
+                    break;
+                }
+                position += SIZE;
+                m_numberOfContainers++;
+            }
+        }
+
+        ContainerBatch::ContainerBatch(const vector<Container> &listOfContainers) :
+            m_rawData(),
+            m_numberOfContainers(0) {
+            for (auto it = listOfContainers.begin(); it != listOfContainers.end(); ++it) {
+                add(*it);
+            }
+        }
+
+        ContainerBatch::~ContainerBatch() {}
+
+        uint32_t ContainerBatch::getSizeOfContainer(const string &rawData, const uint32_t &position) {
+            if (rawData.size() - position < OPENDAVINCI_CONTAINER_HEADER_SIZE) {
+                return 0;
+            }
+
+            uint32_t length = 0;
+            ::memcpy(&length, rawData.data() + position + 1, sizeof(uint32_t));
+            length = le32toh(length);
+
+            if ( (0x0D != static_cast<uint8_t>(rawData[position])) || (0xA4 != (length & 0xFF)) ) {
+                return 0;
+            }
+
+            const uint32_t SIZE = OPENDAVINCI_CONTAINER_HEADER_SIZE + (length >> 8);
+            return (rawData.size() - position < SIZE) ? 0 : SIZE;
+        }
+
+        void ContainerBatch::add(const Container &c) {
+            stringstream sstr;
+            sstr << c;
+            m_rawData.append(sstr.str());
+            m_numberOfContainers++;
+        }
+
+        void ContainerBatch::append(const ContainerBatch &batch) {
+            m_rawData.append(batch.m_rawData);
+            m_numberOfContainers += batch.m_numberOfContainers;
+        }
+
+        void ContainerBatch::reserve(const uint32_t &bytes) {
+            m_rawData.reserve(bytes);
+        }
+
+        void ContainerBatch::clear() {
+            m_rawData.clear();
+            m_numberOfContainers = 0;
+        }
+
+        bool ContainerBatch::isEmpty() const {
+            return (0 == m_numberOfContainers);
+        }
+
+        uint32_t ContainerBatch::getNumberOfContainers() const {
+            return m_numberOfContainers;
+        }
+
+        const string& ContainerBatch::getRawData() const {
+            return m_rawData;
+        }
+
+        vector<Container> ContainerBatch::getListOfContainers() const {
+            vector<Container> listOfContainers;
+            listOfContainers.reserve(m_numberOfContainers);
+
+            stringstream sstr(m_rawData);
+            for (uint32_t i = 0; i < m_numberOfContainers; i++) {
+                Container c;
+                sstr >> c;
+                listOfContainers.push_back(c);
+            }
+            return listOfContainers;
+        }
+
+    }
+} // odcore::data
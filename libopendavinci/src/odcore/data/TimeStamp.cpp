@@ -25,7 +25,6 @@
 #include <memory>
 
 #include "opendavinci/odcore/data/TimeStamp.h"
-#include "opendavinci/odcore/wrapper/Time.h"
 #include "opendavinci/odcore/wrapper/TimeFactory.h"
 
 namespace odcore {
@@ -36,40 +35,19 @@ namespace odcore {
         using namespace odcore::serialization;
 
         TimeStamp::TimeStamp() :
-            TimePoint(),
-            m_readableYear(0),
-            m_readableMonth(0),
-            m_readableDayOfMonth(0),
-            m_readableHours(0),
-            m_readableMinutes(0),
-            m_readableSeconds(0) {
-            std::shared_ptr<odcore::wrapper::Time> time(odcore::wrapper::TimeFactory::getInstance().now());
-            if (time.get()) {
-                setSeconds(time->getSeconds());
-                setMicroseconds(time->getPartialMicroseconds());
-                computeHumanReadableRepresentation();
-            }
+            TimePoint() {
+            int32_t seconds = 0;
+            int32_t microseconds = 0;
+            odcore::wrapper::TimeFactory::getCurrentTime(seconds, microseconds);
+            setSeconds(seconds);
+            setMicroseconds(microseconds);
         }
 
         TimeStamp::TimeStamp(const int32_t &seconds, const int32_t &microSeconds) :
-            TimePoint(seconds, microSeconds),
-            m_readableYear(0),
-            m_readableMonth(0),
-            m_readableDayOfMonth(0),
-            m_readableHours(0),
-            m_readableMinutes(0),
-            m_readableSeconds(0) {
-            computeHumanReadableRepresentation();
-        }
+            TimePoint(seconds, microSeconds) {}
 
         TimeStamp::TimeStamp(const string &ddmmyyyyhhmmss) :
-            TimePoint(),
-            m_readableYear(0),
-            m_readableMonth(0),
-            m_readableDayOfMonth(0),
-            m_readableHours(0),
-            m_readableMinutes(0),
-            m_readableSeconds(0) {
+            TimePoint() {
             if (ddmmyyyyhhmmss.size() == 14) {
                 stringstream dataDD;
                 dataDD.str(ddmmyyyyhhmmss.substr(0, 2));
@@ -152,41 +130,19 @@ namespace odcore {
                 }
 
                 setSeconds((yearsSince01011970 * 365 + additionalLeapDays + cumulativeDays + dd - 1) * 24 * 60 * 60 + hour*60*60 + min*60 + sec);
-                computeHumanReadableRepresentation();
             }
         }
 
         TimeStamp::TimeStamp(const TimeStamp &obj) :
-            TimePoint(obj),
-            m_readableYear(obj.m_readableYear),
-            m_readableMonth(obj.m_readableMonth),
-            m_readableDayOfMonth(obj.m_readableDayOfMonth),
-            m_readableHours(obj.m_readableHours),
-            m_readableMinutes(obj.m_readableMinutes),
-            m_readableSeconds(obj.m_readableSeconds) {}
+            TimePoint(obj) {}
 
         TimeStamp::TimeStamp(const TimePoint &obj) :
-            TimePoint(obj),
-            m_readableYear(0),
-            m_readableMonth(0),
-            m_readableDayOfMonth(0),
-            m_readableHours(0),
-            m_readableMinutes(0),
-            m_readableSeconds(0) {
-            computeHumanReadableRepresentation();
-        }
+            TimePoint(obj) {}
 
         TimeStamp::~TimeStamp() {}
 
         TimeStamp& TimeStamp::operator=(const TimeStamp &obj) {
             TimePoint::operator=(obj);
-            m_readableYear = obj.m_readableYear;
-            m_readableMonth = obj.m_readableMonth;
-            m_readableDayOfMonth = obj.m_readableDayOfMonth;
-            m_readableHours = obj.m_readableHours;
-            m_readableMinutes = obj.m_readableMinutes;
-            m_readableSeconds = obj.m_readableSeconds;
-            computeHumanReadableRepresentation();
             return (*this);
         }
 
@@ -250,41 +206,49 @@ namespace odcore {
             return getMicroseconds();
         }
 
-        void TimeStamp::computeHumanReadableRepresentation() {
-            const long int seconds = getSeconds();
-            struct tm *tm = localtime(&seconds);
-
-            m_readableYear = (1900 + tm->tm_year);
-            m_readableMonth = (1 + tm->tm_mon);
-            m_readableDayOfMonth = tm->tm_mday;
-            m_readableHours = tm->tm_hour;
-            m_readableMinutes = tm->tm_min;
-            m_readableSeconds = tm->tm_sec;
+        void TimeStamp::computeHumanReadableRepresentation(struct tm &readable) const {
+            const time_t seconds = getSeconds();
+#ifdef WIN32
+            localtime_s(&readable, &seconds);
+#else
+            localtime_r(&seconds, &readable);
+#endif
         }
 
         uint32_t TimeStamp::getHour() const {
-            return m_readableHours;
+            struct tm readable;
+            computeHumanReadableRepresentation(readable);
+            return readable.tm_hour;
         }
 
         uint32_t TimeStamp::getMinute() const {
-            return m_readableMinutes;
+            struct tm readable;
+            computeHumanReadableRepresentation(readable);
+            return readable.tm_min;
         }
 
         uint32_t TimeStamp::getSecond() const {
-            return m_readableSeconds;
+            struct tm readable;
+            computeHumanReadableRepresentation(readable);
+            return readable.tm_sec;
         }
 
         uint32_t TimeStamp::getDay() const {
-            return m_readableDayOfMonth;
+            struct tm readable;
+            computeHumanReadableRepresentation(readable);
+            return readable.tm_mday;
         }
 
         uint32_t TimeStamp::getMonth() const {
-            return m_readableMonth;
-
+            struct tm readable;
+            computeHumanReadableRepresentation(readable);
+            return (1 + readable.tm_mon);
         }
 
         uint32_t TimeStamp::getYear() const {
-            return m_readableYear;
+            struct tm readable;
+            computeHumanReadableRepresentation(readable);
+            return (1900 + readable.tm_year);
         }
 
         bool TimeStamp::isLeapYear(const uint32_t &year) const {
@@ -116,8 +116,12 @@ namespace odcore {
             }
 
             void Client::sendPulseAckContainers(const vector<odcore::data::Container> &listOfContainers) {
+                sendPulseAckContainers(ContainerBatch(listOfContainers));
+            }
+
+            void Client::sendPulseAckContainers(const ContainerBatch &batch) {
                 PulseAckContainersMessage pac;
-                pac.setListOfContainers(listOfContainers);
+                pac.setContainerBatch(batch.getRawData());
                 Container container(pac);
                 m_connection.send(container);
             }
@@ -118,13 +118,21 @@ namespace odcore {
                 }
             }
 
-            vector<odcore::data::Container> ModuleConnection::pulse_ack_containers(const odcore::data::dmcp::PulseMessage &pm, const uint32_t &timeout) {
+            ContainerBatch ModuleConnection::pulse_ack_containers(const odcore::data::dmcp::PulseMessage &pm, const uint32_t &timeout) {
+                Container c(pm);
+                return pulse_ack_containers(c, timeout);
+            }
+
+            ContainerBatch ModuleConnection::pulse_ack_containers(Container &pulse, const uint32_t &timeout) {
                 // Unfortunately, we cannot prevent code duplication here (cf. pulse_ack)
                 // as in this case, the dependent client module will send all its containers
                 // via this TCP link and NOT via the regular UDP multicast conference.
 
                 // Assume that we don't receive any further containers.
-                m_containersToBeTransferredToSupercomponent.clear();
+                {
+                    Lock l(m_pulseAckContainersCondition);
+                    m_containersToBeTransferredToSupercomponent.clear();
+                }
 
                 bool connectionLost = true;
                 {
@@ -139,8 +147,7 @@ namespace odcore {
                         m_hasReceivedPulseAckContainers = false;
                     }
 
-                    Container c(pm);
-                    m_connection->send(c);
+                    m_connection->send(pulse);
 
                     // Wait for the ACK message from client.
                     {
@@ -151,6 +158,7 @@ namespace odcore {
                     }
                 }
 
+                Lock l(m_pulseAckContainersCondition);
                 return m_containersToBeTransferredToSupercomponent;
             }
 
@@ -207,9 +215,11 @@ namespace odcore {
                     Lock l(m_pulseAckContainersCondition);
                     m_hasReceivedPulseAckContainers = true;
 
-                    // Get containers to be transferred to supercomponent.
+                    // Get containers to be transferred to supercomponent; they are kept serialized as
+                    // they are only forwarded. An older module sends them as list instead of a batch.
                     PulseAckContainersMessage pac = container.getData<PulseAckContainersMessage>();
-                    m_containersToBeTransferredToSupercomponent = pac.getListOfContainers();
+                    const string CONTAINER_BATCH = pac.getContainerBatch();
+                    m_containersToBeTransferredToSupercomponent = (CONTAINER_BATCH.empty() ? ContainerBatch(pac.getListOfContainers()) : ContainerBatch(CONTAINER_BATCH));
 
                     m_pulseAckContainersCondition.wakeAll();
                     return;
@@ -18,11 +18,11 @@
  */
 
 #include "opendavinci/odcore/base/Lock.h"
+#include "opendavinci/odcore/base/Profiler.h"
+#include "opendavinci/odcore/data/Container.h"
 #include "opendavinci/odcore/io/conference/ContainerConference.h"
 #include "opendavinci/odcore/io/conference/ContainerListener.h"
 
-namespace odcore { namespace data { class Container; } }
-
 namespace odcore {
     namespace io {
         namespace conference {
@@ -35,7 +35,9 @@ namespace odcore {
                 m_containerListenerMutex(),
                 m_containerListener(NULL),
                 m_senderStampMutex(),
-                m_senderStamp(0) {}
+                m_senderStamp(0),
+                m_telemetryEnabled(false),
+                m_telemetry() {}
 
             ContainerConference::~ContainerConference() {}
 
@@ -59,6 +61,18 @@ namespace odcore {
                 return m_senderStamp;
             }
 
+            void ContainerConference::setTelemetryEnabled(const bool &enabled) {
+                m_telemetryEnabled = enabled;
+            }
+
+            bool ContainerConference::isTelemetryEnabled() const {
+                return m_telemetryEnabled.load(std::memory_order_relaxed);
+            }
+
+            ContainerConferenceTelemetry& ContainerConference::getTelemetry() const {
+                return m_telemetry;
+            }
+
             bool ContainerConference::hasContainerListener() const {
                 bool hasListener = false;
                 {
@@ -69,6 +83,8 @@ namespace odcore {
             }
 
             void ContainerConference::receive(Container &c) {
+                Profiler::record(ProfilerEvent::CONTAINER_IN, 0, c.getDataType());
+
                 Lock l(m_containerListenerMutex);
                 if (m_containerListener != NULL) {
                     m_containerListener->nextContainer(c);
@@ -17,9 +17,12 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <iostream>
+
 #include "opendavinci/odcore/base/Lock.h"
 #include "opendavinci/odcore/io/conference/ContainerConference.h"
 #include "opendavinci/odcore/io/conference/ContainerConferenceFactory.h"
+#include "opendavinci/odcore/io/conference/SharedMemoryContainerConference.h"
 #include "opendavinci/odcore/io/conference/UDPMultiCastContainerConference.h"
 
 namespace odcore {
@@ -28,12 +31,14 @@ namespace odcore {
 
             using namespace std;
             using namespace base;
+            using namespace exceptions;
 
             // Initialize singleton instance.
             Mutex ContainerConferenceFactory::m_singletonMutex;
             ContainerConferenceFactory* ContainerConferenceFactory::m_singleton = NULL;
 
-            ContainerConferenceFactory::ContainerConferenceFactory() {}
+            ContainerConferenceFactory::ContainerConferenceFactory() :
+                m_transport(UDP_MULTICAST) {}
 
             ContainerConferenceFactory::~ContainerConferenceFactory() {
                 setSingleton(NULL);
@@ -55,9 +60,27 @@ namespace odcore {
             }
 
             std::shared_ptr<ContainerConference> ContainerConferenceFactory::getContainerConference(const string &address, const uint32_t &port) {
+#ifndef WIN32
+                if (SHARED_MEMORY == m_transport) {
+                    try {
+                        return std::shared_ptr<ContainerConference>(new SharedMemoryContainerConference(address, port));
+                    }
+                    catch (ConferenceException &e) {
+                        clog << "[core::io::conference::ContainerConferenceFactory] " << e.getMessage() << " Using UDP multicast only." << endl;
+                    }
+                }
+#endif
                 return std::shared_ptr<ContainerConference>(new UDPMultiCastContainerConference(address, port));
             }
 
+            void ContainerConferenceFactory::setTransport(const TRANSPORT &transport) {
+                m_transport = transport;
+            }
+
+            ContainerConferenceFactory::TRANSPORT ContainerConferenceFactory::getTransport() const {
+                return m_transport;
+            }
+
         }
     }
 } // odcore::io::conference
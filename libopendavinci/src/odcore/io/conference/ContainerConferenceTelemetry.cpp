@@ -0,0 +1,213 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <cmath>
+
+#include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/data/TimeStamp.h"
+#include "opendavinci/odcore/io/conference/ContainerConferenceTelemetry.h"
+#include "opendavinci/odcore/wrapper/SystemClock.h"
+#include "opendavinci/generated/odcore/data/dmcp/ContainerStatistic.h"
+
+namespace odcore {
+    namespace io {
+        namespace conference {
+
+            using namespace std;
+            using namespace odcore::data;
+
+            LatencyHistogram::LatencyHistogram() :
+                m_buckets(NUMBER_OF_BUCKETS, 0),
+                m_numberOfSamples(0),
+                m_maximum(0) {}
+
+            uint32_t LatencyHistogram::getBucket(const int64_t &value) {
+                if (value < 2 * SUB_BUCKETS) {
+                    return (value < 0) ? 0 : static_cast<uint32_t>(value);
+                }
+
+                uint32_t msb = 0;
+                uint64_t v = static_cast<uint64_t>(value);
+                while (v > 1) {
+                    v >>= 1;
+                    msb++;
+                }
+
+                // Keep the four bits below the most significant one.
+                const uint32_t SHIFT = msb - 4;
+                const uint32_t BUCKET = 2 * SUB_BUCKETS + (SHIFT - 1) * SUB_BUCKETS + static_cast<uint32_t>((static_cast<uint64_t>(value) >> SHIFT) - SUB_BUCKETS);
+                return (BUCKET < NUMBER_OF_BUCKETS) ? BUCKET : (NUMBER_OF_BUCKETS - 1);
+            }
+
+            int64_t LatencyHistogram::getUpperBound(const uint32_t &bucket) {
+                if (bucket < 2 * SUB_BUCKETS) {
+                    return bucket;
+                }
+                const uint32_t SHIFT = (bucket - 2 * SUB_BUCKETS) / SUB_BUCKETS + 1;
+                const int64_t SUB_BUCKET = (bucket - 2 * SUB_BUCKETS) % SUB_BUCKETS + SUB_BUCKETS;
+                return ((SUB_BUCKET + 1) << SHIFT) - 1;
+            }
+
+            void LatencyHistogram::add(const int64_t &value) {
+                const int64_t VALUE = (value < 0) ? 0 : value;
+                m_buckets[getBucket(VALUE)]++;
+                m_numberOfSamples++;
+                if (VALUE > m_maximum) {
+                    m_maximum = VALUE;
+                }
+            }
+
+            int64_t LatencyHistogram::getPercentile(const double &percentile) const {
+                if (0 == m_numberOfSamples) {
+                    return 0;
+                }
+
+                const double P = (percentile < 0) ? 0 : ((percentile > 100) ? 100 : percentile);
+                const uint64_t RANK = static_cast<uint64_t>(std::ceil(P / 100.0 * m_numberOfSamples));
+                uint64_t count = 0;
+                for (uint32_t i = 0; i < NUMBER_OF_BUCKETS; i++) {
+                    count += m_buckets[i];
+                    if ( (count >= RANK) && (count > 0) ) {
+                        // The bucket's upper bound must not exceed the actual maximum.
+                        const int64_t UPPER = getUpperBound(i);
+                        return (UPPER < m_maximum) ? UPPER : m_maximum;
+                    }
+                }
+                return m_maximum;
+            }
+
+            int64_t LatencyHistogram::getMaximum() const {
+                return m_maximum;
+            }
+
+            uint32_t LatencyHistogram::getNumberOfSamples() const {
+                return m_numberOfSamples;
+            }
+
+            void LatencyHistogram::reset() {
+                m_buckets.assign(NUMBER_OF_BUCKETS, 0);
+                m_numberOfSamples = 0;
+                m_maximum = 0;
+            }
+
+            ////////////////////////////////////////////////////////////////////
+
+            ContainerConferenceTelemetry::Entry::Entry() :
+                m_numberOfSentContainers(0),
+                m_numberOfSentBytes(0),
+                m_serializationTime(0),
+                m_numberOfReceivedContainers(0),
+                m_numberOfReceivedBytes(0),
+                m_deserializationTime(0),
+                m_numberOfDroppedContainers(0),
+                m_latency() {}
+
+            ContainerConferenceTelemetry::ContainerConferenceTelemetry() :
+                m_entriesMutex(),
+                m_entries(),
+                m_startOfPeriod(odcore::wrapper::SystemClock::getMonotonicMicroseconds()) {}
+
+            ContainerConferenceTelemetry::~ContainerConferenceTelemetry() {}
+
+            ContainerConferenceTelemetry::Entry& ContainerConferenceTelemetry::getEntry(const Container &c) {
+                return m_entries[make_pair(c.getDataType(), c.getSenderStamp())];
+            }
+
+            void ContainerConferenceTelemetry::countSent(const Container &c, const uint32_t &bytes, const int64_t &serializationTime) {
+                std::lock_guard<std::mutex> l(m_entriesMutex);
+                Entry &e = getEntry(c);
+                e.m_numberOfSentContainers++;
+                e.m_numberOfSentBytes += bytes;
+                e.m_serializationTime += serializationTime;
+            }
+
+            void ContainerConferenceTelemetry::countReceived(const Container &c, const uint32_t &bytes, const int64_t &deserializationTime) {
+                const int64_t SENT = c.getSentTimeStamp().toMicroseconds();
+                const int64_t RECEIVED = c.getReceivedTimeStamp().toMicroseconds();
+
+                std::lock_guard<std::mutex> l(m_entriesMutex);
+                Entry &e = getEntry(c);
+                e.m_numberOfReceivedContainers++;
+                e.m_numberOfReceivedBytes += bytes;
+                e.m_deserializationTime += deserializationTime;
+                if ( (SENT > 0) && (RECEIVED > 0) ) {
+                    e.m_latency.add(RECEIVED - SENT);
+                }
+            }
+
+            void ContainerConferenceTelemetry::countDropped(const Container &c) {
+                std::lock_guard<std::mutex> l(m_entriesMutex);
+                getEntry(c).m_numberOfDroppedContainers++;
+            }
+
+            odcore::data::dmcp::ContainerStatistics ContainerConferenceTelemetry::getStatisticsAndReset() {
+                odcore::data::dmcp::ContainerStatistics statistics;
+
+                const int64_t NOW = odcore::wrapper::SystemClock::getMonotonicMicroseconds();
+
+                std::lock_guard<std::mutex> l(m_entriesMutex);
+                const double PERIOD = (NOW - m_startOfPeriod) / 1000000.0;
+                m_startOfPeriod = NOW;
+                statistics.setPeriod(PERIOD);
+
+                for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+                    const Entry &E = it->second;
+
+                    odcore::data::dmcp::ContainerStatistic cs;
+                    cs.setDataType(it->first.first);
+                    cs.setSenderStamp(it->first.second);
+                    if (PERIOD > 0) {
+                        cs.setSentRate(E.m_numberOfSentContainers / PERIOD);
+                        cs.setSentBytesRate(E.m_numberOfSentBytes / PERIOD);
+                        cs.setReceivedRate(E.m_numberOfReceivedContainers / PERIOD);
+                        cs.setReceivedBytesRate(E.m_numberOfReceivedBytes / PERIOD);
+                    }
+                    cs.setNumberOfDroppedContainers(E.m_numberOfDroppedContainers);
+                    if (E.m_numberOfSentContainers > 0) {
+                        cs.setMeanSerializationTime(E.m_serializationTime / 1000.0 / E.m_numberOfSentContainers);
+                    }
+                    if (E.m_numberOfReceivedContainers > 0) {
+                        cs.setMeanDeserializationTime(E.m_deserializationTime / 1000.0 / E.m_numberOfReceivedContainers);
+                    }
+                    cs.setNumberOfLatencySamples(E.m_latency.getNumberOfSamples());
+                    cs.setLatencyP50(static_cast<double>(E.m_latency.getPercentile(50)));
+                    cs.setLatencyP90(static_cast<double>(E.m_latency.getPercentile(90)));
+                    cs.setLatencyP99(static_cast<double>(E.m_latency.getPercentile(99)));
+                    cs.setLatencyMax(static_cast<double>(E.m_latency.getMaximum()));
+
+                    statistics.addTo_ListOfContainerStatistics(cs);
+                }
+
+                // Keep the entries to report silent data types with zero rates only once.
+                for (auto it = m_entries.begin(); it != m_entries.end(); ) {
+                    if ( (0 == it->second.m_numberOfSentContainers) && (0 == it->second.m_numberOfReceivedContainers) && (0 == it->second.m_numberOfDroppedContainers) ) {
+                        it = m_entries.erase(it);
+                    }
+                    else {
+                        it->second = Entry();
+                        ++it;
+                    }
+                }
+
+                return statistics;
+            }
+
+        }
+    }
+} // odcore::io::conference
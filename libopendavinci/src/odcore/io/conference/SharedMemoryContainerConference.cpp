@@ -0,0 +1,434 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef WIN32
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <time.h>
+#endif
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "opendavinci/odcore/base/Thread.h"
+#include "opendavinci/odcore/data/TimeStamp.h"
+#include "opendavinci/odcore/io/conference/SharedMemoryContainerConference.h"
+#include "opendavinci/odcore/wrapper/SystemClock.h"
+
+namespace odcore {
+    namespace io {
+        namespace conference {
+
+            using namespace std;
+            using namespace odcore::data;
+            using namespace odcore::exceptions;
+
+            /**
+             * The segment consists of a table of participants and a ring of
+             * slots. Writers get an index by incrementing m_writeIndex; each
+             * slot is protected by a sequence number that is 2 * index + 1
+             * while the container with the given index is written and
+             * 2 * (index + 1) when it is readable (seqlock). A writer takes
+             * over its slot from the previous round with a compare-and-swap
+             * on the sequence number so that two writers never write the
+             * same slot at the same time. Readers keep their own read index
+             * and detect being overtaken by comparing sequence numbers.
+             */
+            struct SharedMemoryContainerConference::Segment {
+                enum {
+                    // Increment the last byte whenever the layout changes.
+                    MAGIC = 0x4F444302,
+                    NUMBER_OF_PARTICIPANTS = 64,
+                    NUMBER_OF_SLOTS = 64,
+                    // Large enough for the largest UDP packet.
+                    SLOT_SIZE = 65536
+                };
+
+                struct Participant {
+                    std::atomic<int32_t> m_pid;
+                    std::atomic<uint32_t> m_port;
+                };
+
+                struct Slot {
+                    std::atomic<uint64_t> m_sequence;
+                    std::atomic<uint32_t> m_length;
+                    std::atomic<int32_t> m_participant;
+                    char m_data[SLOT_SIZE];
+                };
+
+                std::atomic<uint32_t> m_magic;
+                uint32_t m_size;
+                std::atomic<uint32_t> m_participantsVersion;
+                std::atomic<uint32_t> m_wakeUpCounter;
+                std::atomic<uint32_t> m_numberOfWaiters;
+                alignas(64) std::atomic<uint64_t> m_writeIndex;
+                alignas(64) Participant m_participants[NUMBER_OF_PARTICIPANTS];
+                Slot m_slots[NUMBER_OF_SLOTS];
+            };
+
+            // Maximum time to wait for the next container before checking whether to stop.
+            static const long WAIT_TIMEOUT = 100 * 1000;
+
+            // Maximum time to wait for another process initializing the segment.
+            static const uint32_t INITIALIZATION_TIMEOUT = 1000 * 1000;
+
+            // Number of attempts to wait for the writer of the previous round to finish with a slot.
+            static const uint32_t MAX_WRITER_SPINS = 1000;
+
+            // Number of attempts to wait for a container that is currently written before sleeping.
+            static const uint32_t MAX_READER_SPINS = 100;
+
+            // Maximum time in microseconds to wait for a writer before skipping its container, e.g. if it crashed.
+            static const int64_t STALLED_WRITER_TIMEOUT = 100 * 1000;
+
+            static bool isAlive(const int32_t &pid) {
+                return (0 == ::kill(pid, 0)) || (EPERM == errno);
+            }
+
+            SharedMemoryContainerConference::SharedMemoryContainerConference(const string &address, const uint32_t &port) throw (ConferenceException) :
+                UDPMultiCastContainerConference(address, port),
+                Service(),
+                m_name(getName(address, port)),
+                m_fd(-1),
+                m_segment(NULL),
+                m_participant(-1),
+                m_participantsVersion(0),
+                m_readIndex(0),
+                m_numberOfOverrunContainers(0) {
+                bool created = true;
+                m_fd = ::shm_open(m_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0666);
+                if ( (m_fd < 0) && (EEXIST == errno) ) {
+                    created = false;
+                    m_fd = ::shm_open(m_name.c_str(), O_RDWR, 0666);
+                }
+                if (m_fd < 0) {
+                    stringstream s;
+                    s << "[core::io::conference::SharedMemoryContainerConference] Error while opening shared memory '" << m_name << "': " << strerror(errno);
+                    OPENDAVINCI_CORE_THROW_EXCEPTION(ConferenceException, s.str());
+                }
+
+                if (created) {
+                    // Allow all users to join regardless of the umask.
+                    ::fchmod(m_fd, 0666);
+                    if (0 != ::ftruncate(m_fd, sizeof(Segment))) {
+                        stringstream s;
+                        s << "[core::io::conference::SharedMemoryContainerConference] Error while resizing shared memory '" << m_name << "': " << strerror(errno);
+                        ::shm_unlink(m_name.c_str());
+                        detach();
+                        OPENDAVINCI_CORE_THROW_EXCEPTION(ConferenceException, s.str());
+                    }
+                }
+                else {
+                    // Wait for the creating process to resize the segment.
+                    struct stat st;
+                    st.st_size = 0;
+                    for (uint32_t waited = 0; (0 == ::fstat(m_fd, &st)) && (st.st_size < static_cast<off_t>(sizeof(Segment))) && (waited < INITIALIZATION_TIMEOUT); waited += 1000) {
+                        odcore::base::Thread::usleepFor(1000);
+                    }
+
+                    // Accessing a smaller segment would cause SIGBUS.
+                    if (st.st_size < static_cast<off_t>(sizeof(Segment))) {
+                        stringstream s;
+                        s << "[core::io::conference::SharedMemoryContainerConference] Shared memory '" << m_name << "' is incompatible; remove /dev/shm" << m_name << " when no module is running.";
+                        detach();
+                        OPENDAVINCI_CORE_THROW_EXCEPTION(ConferenceException, s.str());
+                    }
+                }
+
+                void *ptr = ::mmap(NULL, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+                if (MAP_FAILED == ptr) {
+                    stringstream s;
+                    s << "[core::io::conference::SharedMemoryContainerConference] Error while mapping shared memory '" << m_name << "': " << strerror(errno);
+                    detach();
+                    OPENDAVINCI_CORE_THROW_EXCEPTION(ConferenceException, s.str());
+                }
+                m_segment = static_cast<Segment*>(ptr);
+
+                if (created) {
+                    // The resized segment is filled with zeros.
+                    m_segment->m_size = sizeof(Segment);
+                    m_segment->m_magic.store(Segment::MAGIC, std::memory_order_release);
+                }
+                else {
+                    for (uint32_t waited = 0; (0 == m_segment->m_magic.load(std::memory_order_acquire)) && (waited < INITIALIZATION_TIMEOUT); waited += 1000) {
+                        odcore::base::Thread::usleepFor(1000);
+                    }
+                    if ( (Segment::MAGIC != m_segment->m_magic.load(std::memory_order_acquire)) || (sizeof(Segment) != m_segment->m_size) ) {
+                        stringstream s;
+                        s << "[core::io::conference::SharedMemoryContainerConference] Shared memory '" << m_name << "' is incompatible; remove /dev/shm" << m_name << " when no module is running.";
+                        detach();
+                        OPENDAVINCI_CORE_THROW_EXCEPTION(ConferenceException, s.str());
+                    }
+                }
+
+                join();
+
+                // Only containers sent after joining are received.
+                m_readIndex = m_segment->m_writeIndex.load();
+
+                // Start receiving.
+                start();
+            }
+
+            SharedMemoryContainerConference::~SharedMemoryContainerConference() {
+                // Stop receiving.
+                stop();
+
+                leave();
+                detach();
+            }
+
+            string SharedMemoryContainerConference::getName(const string &address, const uint32_t &port) {
+                stringstream s;
+                s << "/odcc." << address << "." << port;
+                return s.str();
+            }
+
+            uint64_t SharedMemoryContainerConference::getNumberOfOverrunContainers() const {
+                return m_numberOfOverrunContainers.load();
+            }
+
+            void SharedMemoryContainerConference::join() {
+                const int32_t PID = ::getpid();
+                for (int32_t i = 0; (i < Segment::NUMBER_OF_PARTICIPANTS) && (m_participant < 0); i++) {
+                    Segment::Participant &participant = m_segment->m_participants[i];
+
+                    // Reuse entries from crashed processes.
+                    int32_t pid = participant.m_pid.load();
+                    if ( (0 != pid) && !isAlive(pid) ) {
+                        participant.m_pid.compare_exchange_strong(pid, 0);
+                    }
+
+                    int32_t unused = 0;
+                    if (participant.m_pid.compare_exchange_strong(unused, PID)) {
+                        participant.m_port.store(getSenderPort());
+                        m_participant = i;
+                    }
+                }
+
+                if (m_participant < 0) {
+                    stringstream s;
+                    s << "[core::io::conference::SharedMemoryContainerConference] Shared memory '" << m_name << "' has no free entry for another participant.";
+                    detach();
+                    OPENDAVINCI_CORE_THROW_EXCEPTION(ConferenceException, s.str());
+                }
+
+                // Inform the other participants to ignore our UDP packets.
+                m_segment->m_participantsVersion.fetch_add(1);
+                wakeUp();
+            }
+
+            void SharedMemoryContainerConference::leave() {
+                if ( (NULL != m_segment) && (m_participant >= 0) ) {
+                    Segment::Participant &participant = m_segment->m_participants[m_participant];
+                    participant.m_port.store(0);
+                    participant.m_pid.store(0);
+                    m_participant = -1;
+
+                    m_segment->m_participantsVersion.fetch_add(1);
+                    wakeUp();
+                }
+            }
+
+            void SharedMemoryContainerConference::detach() {
+                if (NULL != m_segment) {
+                    ::munmap(m_segment, sizeof(Segment));
+                    m_segment = NULL;
+                }
+                if (m_fd >= 0) {
+                    ::close(m_fd);
+                    m_fd = -1;
+                }
+            }
+
+            void SharedMemoryContainerConference::updateSenderPortsToIgnore() {
+                const uint32_t VERSION = m_segment->m_participantsVersion.load();
+                if (VERSION != m_participantsVersion) {
+                    vector<uint16_t> portsToIgnore;
+                    portsToIgnore.push_back(getSenderPort());
+                    for (int32_t i = 0; i < Segment::NUMBER_OF_PARTICIPANTS; i++) {
+                        const int32_t PID = m_segment->m_participants[i].m_pid.load();
+                        const uint32_t PORT = m_segment->m_participants[i].m_port.load();
+                        if ( (0 != PID) && (0 != PORT) && isAlive(PID) ) {
+                            portsToIgnore.push_back(static_cast<uint16_t>(PORT));
+                        }
+                    }
+                    setSenderPortsToIgnore(portsToIgnore);
+                    m_participantsVersion = VERSION;
+                }
+            }
+
+            void SharedMemoryContainerConference::wakeUp() const {
+                m_segment->m_wakeUpCounter.fetch_add(1);
+#ifdef __linux__
+                if (m_segment->m_numberOfWaiters.load() > 0) {
+                    ::syscall(SYS_futex, reinterpret_cast<int*>(&m_segment->m_wakeUpCounter), FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+                }
+#endif
+            }
+
+            void SharedMemoryContainerConference::waitForNextContainer(const uint32_t &wakeUpCounter) {
+#ifdef __linux__
+                // Returns immediately if a container was written after reading wakeUpCounter.
+                struct timespec timeout;
+                timeout.tv_sec = 0;
+                timeout.tv_nsec = WAIT_TIMEOUT * 1000;
+                m_segment->m_numberOfWaiters.fetch_add(1);
+                ::syscall(SYS_futex, reinterpret_cast<int*>(&m_segment->m_wakeUpCounter), FUTEX_WAIT, wakeUpCounter, &timeout, NULL, 0);
+                m_segment->m_numberOfWaiters.fetch_sub(1);
+#else
+                if (wakeUpCounter == m_segment->m_wakeUpCounter.load()) {
+                    odcore::base::Thread::usleepFor(1000);
+                }
+#endif
+            }
+
+            void SharedMemoryContainerConference::sendSerializedContainer(const string &data) const {
+                if (data.size() <= Segment::SLOT_SIZE) {
+                    const uint64_t INDEX = m_segment->m_writeIndex.fetch_add(1);
+                    Segment::Slot &slot = m_segment->m_slots[INDEX % Segment::NUMBER_OF_SLOTS];
+                    const uint64_t WRITING = 2 * INDEX + 1;
+
+                    // Claim the slot once the writer of a previous round has finished; a writer
+                    // that does not finish in time is taken over. If a writer of a later round
+                    // owns the slot already, this container is skipped by the readers.
+                    bool claimed = false;
+                    uint64_t sequence = slot.m_sequence.load(std::memory_order_acquire);
+                    for (uint32_t spins = 0; !claimed && (sequence < WRITING); spins++) {
+                        if ( (1 == sequence % 2) && (spins < MAX_WRITER_SPINS) ) {
+                            std::this_thread::yield();
+                            sequence = slot.m_sequence.load(std::memory_order_acquire);
+                            continue;
+                        }
+                        claimed = slot.m_sequence.compare_exchange_weak(sequence, WRITING, std::memory_order_acq_rel, std::memory_order_acquire);
+                    }
+
+                    if (claimed) {
+                        slot.m_length.store(static_cast<uint32_t>(data.size()), std::memory_order_relaxed);
+                        slot.m_participant.store(m_participant, std::memory_order_relaxed);
+                        ::memcpy(slot.m_data, data.data(), data.size());
+
+                        // Publish the container unless the slot was taken over in the meantime.
+                        uint64_t expected = WRITING;
+                        slot.m_sequence.compare_exchange_strong(expected, WRITING + 1, std::memory_order_release, std::memory_order_relaxed);
+                    }
+
+                    wakeUp();
+                }
+
+                // Send to participants on other machines or not using shared memory.
+                UDPMultiCastContainerConference::sendSerializedContainer(data);
+            }
+
+            void SharedMemoryContainerConference::beforeStop() {
+                // Interrupt waiting.
+                wakeUp();
+            }
+
+            void SharedMemoryContainerConference::run() {
+                updateSenderPortsToIgnore();
+
+                serviceReady();
+
+                string data;
+                data.reserve(Segment::SLOT_SIZE);
+
+                // State for waiting on the writer of the next container.
+                uint64_t waitingForIndex = m_readIndex;
+                uint32_t spins = 0;
+                int64_t waitingSince = 0;
+
+                while (isRunning()) {
+                    // Read the counter before checking for new containers to not miss any wake up.
+                    const uint32_t WAKE_UP_COUNTER = m_segment->m_wakeUpCounter.load();
+
+                    updateSenderPortsToIgnore();
+
+                    const uint64_t WRITE_INDEX = m_segment->m_writeIndex.load();
+                    if (m_readIndex < WRITE_INDEX) {
+                        Segment::Slot &slot = m_segment->m_slots[m_readIndex % Segment::NUMBER_OF_SLOTS];
+                        const uint64_t EXPECTED = 2 * m_readIndex + 2;
+                        const uint64_t SEQUENCE = slot.m_sequence.load(std::memory_order_acquire);
+
+                        if (EXPECTED == SEQUENCE) {
+                            const uint32_t LENGTH = slot.m_length.load(std::memory_order_relaxed);
+                            const int32_t PARTICIPANT = slot.m_participant.load(std::memory_order_relaxed);
+                            data.assign(slot.m_data, (LENGTH < Segment::SLOT_SIZE) ? LENGTH : static_cast<uint32_t>(Segment::SLOT_SIZE));
+
+                            // Discard the copy if the slot was overwritten in the meantime.
+                            std::atomic_thread_fence(std::memory_order_acquire);
+                            if (EXPECTED == slot.m_sequence.load(std::memory_order_relaxed)) {
+                                m_readIndex++;
+                                if (PARTICIPANT != m_participant) {
+                                    receiveSerializedContainer(data, TimeStamp());
+                                }
+                                continue;
+                            }
+                        }
+
+                        if ( (SEQUENCE > EXPECTED) || (WRITE_INDEX - m_readIndex > Segment::NUMBER_OF_SLOTS) ) {
+                            // The writers have overtaken this reader; continue with the oldest available container.
+                            const uint64_t OLDEST = WRITE_INDEX - Segment::NUMBER_OF_SLOTS + 1;
+                            const uint64_t NEXT = ( (WRITE_INDEX > Segment::NUMBER_OF_SLOTS) && (OLDEST > m_readIndex + 1) ) ? OLDEST : (m_readIndex + 1);
+                            m_numberOfOverrunContainers += (NEXT - m_readIndex);
+                            m_readIndex = NEXT;
+                            continue;
+                        }
+
+                        // The next container is being written; the writer is most likely copying it right now.
+                        if (waitingForIndex != m_readIndex) {
+                            waitingForIndex = m_readIndex;
+                            spins = 0;
+                            waitingSince = odcore::wrapper::SystemClock::getMonotonicMicroseconds();
+                        }
+                        if (spins < MAX_READER_SPINS) {
+                            spins++;
+                            std::this_thread::yield();
+                            continue;
+                        }
+                        if (odcore::wrapper::SystemClock::getMonotonicMicroseconds() - waitingSince > STALLED_WRITER_TIMEOUT) {
+                            // Do not wait for a writer that does not finish, e.g. as it crashed.
+                            m_numberOfOverrunContainers++;
+                            m_readIndex++;
+                            continue;
+                        }
+                    }
+
+                    // Nothing to read or the next container is still being written.
+                    waitForNextContainer(WAKE_UP_COUNTER);
+                }
+            }
+
+        }
+    }
+} // odcore::io::conference
+
+#endif
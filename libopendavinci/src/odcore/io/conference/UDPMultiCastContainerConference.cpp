@@ -20,12 +20,14 @@
 #include <iosfwd>
 #include <sstream>
 
+#include "opendavinci/odcore/base/Profiler.h"
 #include "opendavinci/odcore/serialization/Serializable.h"
 #include "opendavinci/odcore/data/Container.h"
 #include "opendavinci/odcore/data/TimeStamp.h"
 #include "opendavinci/odcore/io/conference/UDPMultiCastContainerConference.h"
 #include "opendavinci/odcore/io/udp/UDPFactory.h"
 #include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/wrapper/SystemClock.h"
 
 namespace odcore {
     namespace io {
@@ -71,14 +73,31 @@ namespace odcore {
             }
 
             void UDPMultiCastContainerConference::nextPacket(const Packet &p) {
-                if (hasContainerListener()) {
+                // Set received time stamp based on information from packet.
+                receiveSerializedContainer(p.getData(), TimeStamp(p.getReceived()));
+            }
+
+            void UDPMultiCastContainerConference::receiveSerializedContainer(const string &data, const TimeStamp &received) {
+                const bool TELEMETRY = isTelemetryEnabled();
+                if (hasContainerListener() || TELEMETRY) {
                     Container container;
 
-                    stringstream stringstreamData(p.getData());
+                    const int64_t START = TELEMETRY ? odcore::wrapper::SystemClock::getMonotonicNanoseconds() : 0;
+                    stringstream stringstreamData(data);
                     stringstreamData >> container;
+                    const int64_t DURATION = TELEMETRY ? (odcore::wrapper::SystemClock::getMonotonicNanoseconds() - START) : 0;
 
-                    // Set received time stamp based on information from packet.
-                    container.setReceivedTimeStamp(TimeStamp(p.getReceived()));
+                    container.setReceivedTimeStamp(received);
+
+                    if (TELEMETRY) {
+                        // Containers that could not be decoded or that nobody listens to are dropped.
+                        if ( (Container::UNDEFINEDDATA == container.getDataType()) || !hasContainerListener() ) {
+                            getTelemetry().countDropped(container);
+                        }
+                        else {
+                            getTelemetry().countReceived(container, static_cast<uint32_t>(data.size()), DURATION);
+                        }
+                    }
 
                     // Use superclass to distribute any received containers.
                     receive(container);
@@ -86,6 +105,8 @@ namespace odcore {
             }
 
             void UDPMultiCastContainerConference::send(Container &container) const {
+                odcore::base::Profiler::record(odcore::base::ProfilerEvent::CONTAINER_OUT, 0, container.getDataType());
+
                 // Set sending time stamp.
                 container.setSentTimeStamp(TimeStamp());
 
@@ -100,13 +121,32 @@ namespace odcore {
                     container.setSenderStamp(getSenderStamp());
                 }
 
+                const bool TELEMETRY = isTelemetryEnabled();
+                const int64_t START = TELEMETRY ? odcore::wrapper::SystemClock::getMonotonicNanoseconds() : 0;
+
                 stringstream stringstreamValue;
                 stringstreamValue << container;
 
                 string stringValue = stringstreamValue.str();
 
+                if (TELEMETRY) {
+                    getTelemetry().countSent(container, static_cast<uint32_t>(stringValue.size()), odcore::wrapper::SystemClock::getMonotonicNanoseconds() - START);
+                }
+
                 // Send data.
-                m_sender->send(stringValue);
+                sendSerializedContainer(stringValue);
+            }
+
+            void UDPMultiCastContainerConference::sendSerializedContainer(const string &data) const {
+                m_sender->send(data);
+            }
+
+            uint16_t UDPMultiCastContainerConference::getSenderPort() const {
+                return m_sender->getPort();
+            }
+
+            void UDPMultiCastContainerConference::setSenderPortsToIgnore(const vector<uint16_t> &portsToIgnore) {
+                m_receiver->setSenderPortsToIgnore(portsToIgnore);
             }
 
         }
@@ -17,7 +17,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
-#include <cstdlib>
+#include <sstream>
 
 #include "opendavinci/odcore/base/Lock.h"
 #include "opendavinci/odcore/io/StringListener.h"
@@ -34,7 +34,9 @@ namespace odcore {
                 m_stringListenerMutex(),
                 m_stringListener(NULL),
                 m_partialDataMutex(),
-                m_partialData() {}
+                m_partialData(),
+                m_partialDataBegin(0),
+                m_payload() {}
 
             NetstringsProtocol::~NetstringsProtocol() {
                 setStringListener(NULL);
@@ -57,74 +59,76 @@ namespace odcore {
 
             void NetstringsProtocol::nextString(const string &s) {
                 Lock l(m_partialDataMutex);
-                m_partialData.write(s.c_str(), s.length());
+
+                // Remove the already decoded Netstrings only if they occupy
+                // at least half of the buffer to keep the effort linear.
+                if ( (m_partialDataBegin > 0) && (m_partialDataBegin >= m_partialData.size() / 2) ) {
+                    m_partialData.erase(0, m_partialDataBegin);
+                    m_partialDataBegin = 0;
+                }
+
+                m_partialData.append(s);
                 decodeNetstring();
 
-                // After using str() to set the remaining string, the write pointer
-                // points to the beginning of the stream and further receivedString() calls
-                // would override existing data. So the write pointer has to point to the
-                // end of the stream.
-                m_partialData.seekp(0, ios_base::end);
+                // Reuse the allocated memory if everything was decoded.
+                if (m_partialDataBegin == m_partialData.size()) {
+                    m_partialData.clear();
+                    m_partialDataBegin = 0;
+                }
             }
 
             void NetstringsProtocol::decodeNetstring(void) {
                 // Netstrings have the following format:
                 // ASCII Number representing the length of the payload + ':' + payload + ','
 
-                bool checkForMoreNetstrings = true;
-                while (checkForMoreNetstrings) {
-                    m_partialData.seekg(0, ios_base::end);
-                    uint32_t lengthOfBuffer = m_partialData.tellg();
-                    m_partialData.seekg(0, ios_base::beg);
-
-                    if (lengthOfBuffer >= 3) {
-                        // On WIN32, the .str() returns a temporary object that is destroyed after the expression.
-                        // The reference keeps its existence instead.
-                        const string &m_partialDataString = m_partialData.str();
-                        const char *receiveBuffer = m_partialDataString.c_str();
-                        char *colonSign = NULL;
-                        uint32_t lengthOfPayload = strtol(receiveBuffer, &colonSign, 10);
-                        if (lengthOfPayload == 0) {
-                            // Remove empty Netstring: "0:," (size is 3).
-                            m_partialData.str(m_partialData.str().substr(3));
-                            checkForMoreNetstrings = true;
-                            continue; // Try to decode next Netstring if any.
-                        }
+                // A payload larger than 4 GB is not supported.
+                const uint32_t MAX_DIGITS = 10;
 
-                        if (lengthOfPayload > lengthOfBuffer) {
-                            // Incomplete Netstring received. Wait for more data.
-                            checkForMoreNetstrings = false;
-                            continue;
-                        }
+                while (m_partialDataBegin < m_partialData.size()) {
+                    const char *receiveBuffer = m_partialData.data() + m_partialDataBegin;
+                    const uint64_t lengthOfBuffer = m_partialData.size() - m_partialDataBegin;
 
-                        // Check for colon.
-                        if (*colonSign == ':') {
-                            // Found colon sign. Now, check if (receiveBuffer + 1 + lengthOfPayload) == ','.
-                            if ((colonSign[1 + lengthOfPayload]) == ',') {
-                                // Successfully found a complete Netstring.
-                                string receivedPayload = m_partialData.str().substr((colonSign + 1) - receiveBuffer, lengthOfPayload);
+                    // Read the length of the payload.
+                    uint64_t lengthOfPayload = 0;
+                    uint32_t digits = 0;
+                    while ( (digits < lengthOfBuffer) && (digits <= MAX_DIGITS) && (receiveBuffer[digits] >= '0') && (receiveBuffer[digits] <= '9') ) {
+                        lengthOfPayload = lengthOfPayload * 10 + static_cast<uint64_t>(receiveBuffer[digits] - '0');
+                        digits++;
+                    }
 
-                                invokeStringListener(receivedPayload);
+                    if (digits == lengthOfBuffer) {
+                        // Incomplete length received. Wait for more data.
+                        break;
+                    }
 
-                                // Calculate size of decoded Netstring: "<lengthOfPayload> : <payload> ,"
-                                const uint32_t lengthOfNetstring = (colonSign + 1 + lengthOfPayload + 1) - receiveBuffer;
+                    // Check for colon.
+                    if ( (digits > 0) && (digits <= MAX_DIGITS) && (lengthOfPayload <= 0xFFFFFFFFu) && (receiveBuffer[digits] == ':') ) {
+                        // Calculate size of Netstring: "<lengthOfPayload> : <payload> ,"
+                        const uint64_t lengthOfNetstring = digits + 1 + lengthOfPayload + 1;
 
-                                // Remove the decoded Netstring from the buffer.
-                                m_partialData.str(m_partialData.str().substr(lengthOfNetstring));
+                        if (lengthOfNetstring > lengthOfBuffer) {
+                            // Incomplete Netstring received. Wait for more data.
+                            break;
+                        }
 
-                                checkForMoreNetstrings = true;
-                                continue;
+                        // Found colon sign. Now, check if (receiveBuffer + 1 + lengthOfPayload) == ','.
+                        if (receiveBuffer[lengthOfNetstring - 1] == ',') {
+                            // Successfully found a complete Netstring; empty Netstrings "0:," are skipped.
+                            if (lengthOfPayload > 0) {
+                                // The payload is copied into a reused buffer to avoid memory allocations.
+                                m_payload.assign(receiveBuffer + digits + 1, lengthOfPayload);
+                                invokeStringListener(m_payload);
                             }
-                        }
 
-                        // We should never get here as the received data might be corrupted; reset buffer.
-                        m_partialData.str("");
-                        checkForMoreNetstrings = false;
-                    }
-                    else {
-                        // We need to wait for more data.
-                        checkForMoreNetstrings = false;
+                            // Skip the decoded Netstring.
+                            m_partialDataBegin += lengthOfNetstring;
+                            continue;
+                        }
                     }
+
+                    // We should never get here as the received data might be corrupted; reset buffer.
+                    m_partialData.clear();
+                    m_partialDataBegin = 0;
                 }
             }
 
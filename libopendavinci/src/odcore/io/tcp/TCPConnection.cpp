@@ -97,7 +97,8 @@ namespace odcore {
                 else {
                     m_partialData.write(s.c_str(), s.length());
 
-                    if (hasCompleteData()) {
+                    // One chunk might contain several messages.
+                    while (hasCompleteData()) {
                         m_partialData.seekg(0, ios_base::beg);
 
                         uint32_t dataSize = 0;
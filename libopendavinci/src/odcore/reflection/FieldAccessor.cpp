@@ -0,0 +1,422 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+
+#include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/reflection/Field.h"
+#include "opendavinci/odcore/reflection/FieldAccessor.h"
+#include "opendavinci/odcore/serialization/ProtoSerializer.h"
+#include "opendavinci/odcore/strings/StringToolbox.h"
+
+namespace odcore {
+    namespace reflection {
+
+        using namespace std;
+        using namespace odcore::data;
+        using namespace odcore::data::reflection;
+        using namespace odcore::serialization;
+
+        FieldAccessor::FieldAccessor() :
+            m_dataType(0),
+            m_fieldPath(""),
+            m_identifiers(),
+            m_fieldDataType(AbstractField::BOOL_T),
+            m_compiled(false) {}
+
+        FieldAccessor::FieldAccessor(const FieldAccessor &obj) :
+            m_dataType(obj.m_dataType),
+            m_fieldPath(obj.m_fieldPath),
+            m_identifiers(obj.m_identifiers),
+            m_fieldDataType(obj.m_fieldDataType),
+            m_compiled(obj.m_compiled) {}
+
+        FieldAccessor::~FieldAccessor() {}
+
+        FieldAccessor& FieldAccessor::operator=(const FieldAccessor &obj) {
+            m_dataType = obj.m_dataType;
+            m_fieldPath = obj.m_fieldPath;
+            m_identifiers = obj.m_identifiers;
+            m_fieldDataType = obj.m_fieldDataType;
+            m_compiled = obj.m_compiled;
+
+            return (*this);
+        }
+
+        bool FieldAccessor::compile(const Message &msg, const string &fieldPath) {
+            m_dataType = msg.getID();
+            m_fieldPath = "";
+            m_identifiers.clear();
+            m_fieldDataType = AbstractField::BOOL_T;
+            m_compiled = false;
+
+            // Check the optional name of the data type.
+            string path = fieldPath;
+            const string::size_type SLASH = path.find('/');
+            if (SLASH != string::npos) {
+                const string NAME = path.substr(0, SLASH);
+                if ( (NAME != msg.getLongName()) && (NAME != msg.getShortName()) ) {
+                    return false;
+                }
+                path = path.substr(SLASH + 1);
+            }
+
+            // Follow the field names through the nested data structures.
+            const vector<string> NAMES = odcore::strings::StringToolbox::split(path, '.');
+            Message current = msg;
+            for (uint32_t i = 0; i < NAMES.size(); i++) {
+                std::shared_ptr<AbstractField> field;
+                const vector<std::shared_ptr<AbstractField> > &fields = current.getFields();
+                for (auto it = fields.begin(); it != fields.end(); ++it) {
+                    if ((*it)->getShortFieldName() == NAMES.at(i)) {
+                        field = *it;
+                        break;
+                    }
+                }
+                if (!field.get()) {
+                    return false;
+                }
+
+                m_identifiers.push_back(field->getFieldIdentifier());
+
+                const AbstractField::FIELDDATATYPE TYPE = field->getFieldDataType();
+                if ((i + 1) < NAMES.size()) {
+                    Field<Message> *nested = dynamic_cast<Field<Message>*>(field.get());
+                    if ( (TYPE != AbstractField::SERIALIZABLE_T) || (field->getIsFixedArray()) || (NULL == nested) ) {
+                        return false;
+                    }
+                    current = nested->getValue();
+                }
+                else {
+                    // Fixed arrays report the type of their elements but are encoded as raw data.
+                    if (!isAccessible(*field)) {
+                        return false;
+                    }
+                    m_fieldDataType = TYPE;
+                }
+
+                m_fieldPath += (i > 0 ? "." : "") + NAMES.at(i);
+            }
+
+            m_compiled = !m_identifiers.empty();
+            return m_compiled;
+        }
+
+        vector<FieldAccessor> FieldAccessor::compileAll(const Message &msg) {
+            bool isComplete = true;
+            return compileAll(msg, isComplete);
+        }
+
+        vector<FieldAccessor> FieldAccessor::compileAll(const Message &msg, bool &isComplete) {
+            vector<FieldAccessor> accessors;
+            isComplete = true;
+            compileAll(msg, msg.getID(), "", vector<uint32_t>(), accessors, isComplete);
+            return accessors;
+        }
+
+        void FieldAccessor::compileAll(const Message &msg, const int32_t &dataType, const string &prefix, const vector<uint32_t> &identifiers, vector<FieldAccessor> &accessors, bool &isComplete) {
+            const vector<std::shared_ptr<AbstractField> > &fields = msg.getFields();
+            for (auto it = fields.begin(); it != fields.end(); ++it) {
+                vector<uint32_t> path = identifiers;
+                path.push_back((*it)->getFieldIdentifier());
+
+                const AbstractField::FIELDDATATYPE TYPE = (*it)->getFieldDataType();
+                Field<Message> *nested = dynamic_cast<Field<Message>*>((*it).get());
+                if ( (TYPE == AbstractField::SERIALIZABLE_T) && (!(*it)->getIsFixedArray()) && (NULL != nested) ) {
+                    compileAll(nested->getValue(), dataType, prefix + (*it)->getShortFieldName() + ".", path, accessors, isComplete);
+                }
+                else if (!isAccessible(*(*it))) {
+                    isComplete = false;
+                }
+                else {
+                    FieldAccessor fa;
+                    fa.m_dataType = dataType;
+                    fa.m_fieldPath = prefix + (*it)->getShortFieldName();
+                    fa.m_identifiers = path;
+                    fa.m_fieldDataType = TYPE;
+                    fa.m_compiled = true;
+                    accessors.push_back(fa);
+                }
+            }
+        }
+
+        bool FieldAccessor::isAccessible(const AbstractField &field) {
+            const AbstractField::FIELDDATATYPE TYPE = field.getFieldDataType();
+            return (!field.getIsFixedArray()) && ( (TYPE <= AbstractField::DOUBLE_T) || (TYPE == AbstractField::STRING_T) );
+        }
+
+        bool FieldAccessor::isCompiled() const {
+            return m_compiled;
+        }
+
+        int32_t FieldAccessor::getDataType() const {
+            return m_dataType;
+        }
+
+        const string FieldAccessor::getFieldPath() const {
+            return m_fieldPath;
+        }
+
+        AbstractField::FIELDDATATYPE FieldAccessor::getFieldDataType() const {
+            return m_fieldDataType;
+        }
+
+        double FieldAccessor::getValue(const Container &c, bool &extracted) const {
+            extracted = false;
+            if (c.getDataType() != m_dataType) {
+                return 0;
+            }
+            return getValue(c.getRawData(), extracted);
+        }
+
+        double FieldAccessor::getValue(const string &payload, bool &extracted) const {
+            double value = 0;
+            extracted = false;
+
+            const char *begin = NULL;
+            const char *end = NULL;
+            if (locate(payload, begin, end)) {
+                if ( (m_fieldDataType == AbstractField::FLOAT_T) || (m_fieldDataType == AbstractField::DOUBLE_T) ) {
+                    extracted = decodeFloatingPoint(begin, end, value);
+                }
+                else if (m_fieldDataType != AbstractField::STRING_T) {
+                    int64_t integer = 0;
+                    extracted = decodeInteger(begin, end, integer);
+                    value = (m_fieldDataType == AbstractField::UINT64_T) ? static_cast<double>(static_cast<uint64_t>(integer)) : static_cast<double>(integer);
+                }
+            }
+
+            return value;
+        }
+
+        const string FieldAccessor::getValueAsString(const string &payload, bool &extracted) const {
+            stringstream sstr;
+            extracted = false;
+
+            const char *begin = NULL;
+            const char *end = NULL;
+            if (locate(payload, begin, end)) {
+                if (m_fieldDataType == AbstractField::STRING_T) {
+                    uint64_t length = 0;
+                    if (decodeVarInt(begin, end, length) && (length <= static_cast<uint64_t>(end - begin))) {
+                        extracted = true;
+                        return string(begin, length);
+                    }
+                }
+                else if ( (m_fieldDataType == AbstractField::FLOAT_T) || (m_fieldDataType == AbstractField::DOUBLE_T) ) {
+                    double value = 0;
+                    extracted = decodeFloatingPoint(begin, end, value);
+                    sstr << setprecision(10) << value;
+                }
+                else {
+                    int64_t integer = 0;
+                    extracted = decodeInteger(begin, end, integer);
+                    if (m_fieldDataType == AbstractField::UINT64_T) {
+                        sstr << static_cast<uint64_t>(integer);
+                    }
+                    else {
+                        sstr << integer;
+                    }
+                }
+            }
+
+            return (extracted ? sstr.str() : "");
+        }
+
+        bool FieldAccessor::locate(const string &payload, const char* &begin, const char* &end) const {
+            if (!m_compiled) {
+                return false;
+            }
+
+            begin = payload.data();
+            end = begin + payload.size();
+
+            for (uint32_t level = 0; level < m_identifiers.size(); level++) {
+                const uint32_t ID = m_identifiers.at(level);
+                const bool IS_NESTED = ((level + 1) < m_identifiers.size());
+
+                bool found = false;
+                while (!found && (begin < end)) {
+                    uint64_t key = 0;
+                    if (!decodeVarInt(begin, end, key)) {
+                        return false;
+                    }
+
+                    const uint32_t FIELD_ID = static_cast<uint32_t>(key >> 3);
+                    const uint8_t PROTO_TYPE = static_cast<uint8_t>(key & 0x7);
+
+                    if (FIELD_ID == ID) {
+                        found = true;
+                        if (IS_NESTED) {
+                            // Restrict the search to the nested data structure.
+                            uint64_t length = 0;
+                            if ( (PROTO_TYPE != ProtoSerializer::LENGTH_DELIMITED)
+                              || !decodeVarInt(begin, end, length)
+                              || (length > static_cast<uint64_t>(end - begin)) ) {
+                                return false;
+                            }
+                            end = begin + length;
+                        }
+                        else {
+                            // Refuse values that were encoded for a different type.
+                            const bool IS_FLOAT = (m_fieldDataType == AbstractField::FLOAT_T);
+                            const bool IS_DOUBLE = (m_fieldDataType == AbstractField::DOUBLE_T);
+                            const bool IS_STRING = (m_fieldDataType == AbstractField::STRING_T);
+                            if ( (IS_FLOAT && (PROTO_TYPE != ProtoSerializer::FOUR_BYTES))
+                              || (IS_DOUBLE && (PROTO_TYPE != ProtoSerializer::EIGHT_BYTES))
+                              || (IS_STRING && (PROTO_TYPE != ProtoSerializer::LENGTH_DELIMITED))
+                              || (!IS_FLOAT && !IS_DOUBLE && !IS_STRING && (PROTO_TYPE != ProtoSerializer::VARINT)) ) {
+                                return false;
+                            }
+                        }
+                    }
+                    else {
+                        // Skip the value of any other field.
+                        uint64_t length = 0;
+                        switch (PROTO_TYPE) {
+                            case ProtoSerializer::VARINT:
+                                if (!decodeVarInt(begin, end, length)) {
+                                    return false;
+                                }
+                                length = 0;
+                            break;
+                            case ProtoSerializer::EIGHT_BYTES:
+                                length = sizeof(uint64_t);
+                            break;
+                            case ProtoSerializer::FOUR_BYTES:
+                                length = sizeof(uint32_t);
+                            break;
+                            case ProtoSerializer::LENGTH_DELIMITED:
+                                if (!decodeVarInt(begin, end, length)) {
+                                    return false;
+                                }
+                            break;
+                            default:
+                                return false;
+                        }
+                        if (length > static_cast<uint64_t>(end - begin)) {
+                            return false;
+                        }
+                        begin += length;
+                    }
+                }
+
+                if (!found) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        bool FieldAccessor::decodeVarInt(const char* &begin, const char *end, uint64_t &value) {
+            value = 0;
+            uint8_t shift = 0;
+            while ( (begin < end) && (shift < 64) ) {
+                const uint8_t BYTE = static_cast<uint8_t>(*begin++);
+                value |= static_cast<uint64_t>(BYTE & 0x7f) << shift;
+                if (!(BYTE & 0x80)) {
+                    return true;
+                }
+                shift += 7;
+            }
+            return false;
+        }
+
+        bool FieldAccessor::decodeInteger(const char *begin, const char *end, int64_t &value) const {
+            uint64_t v = 0;
+            if (!decodeVarInt(begin, end, v)) {
+                return false;
+            }
+
+            // Signed integers are ZigZag encoded.
+            const int64_t ZIGZAG = static_cast<int64_t>((v >> 1) ^ -(v & 1));
+
+            switch (m_fieldDataType) {
+                case AbstractField::BOOL_T:
+                    value = (v != 0) ? 1 : 0;
+                break;
+                case AbstractField::CHAR_T:
+                    value = static_cast<char>(v);
+                break;
+                case AbstractField::UCHAR_T:
+                case AbstractField::UINT8_T:
+                    value = static_cast<uint8_t>(v);
+                break;
+                case AbstractField::INT8_T:
+                    value = static_cast<int8_t>(ZIGZAG);
+                break;
+                case AbstractField::UINT16_T:
+                    value = static_cast<uint16_t>(v);
+                break;
+                case AbstractField::INT16_T:
+                    value = static_cast<int16_t>(ZIGZAG);
+                break;
+                case AbstractField::UINT32_T:
+                    value = static_cast<uint32_t>(v);
+                break;
+                case AbstractField::INT32_T:
+                    value = static_cast<int32_t>(ZIGZAG);
+                break;
+                case AbstractField::UINT64_T:
+                    value = static_cast<int64_t>(v);
+                break;
+                case AbstractField::INT64_T:
+                    value = ZIGZAG;
+                break;
+                default:
+                    return false;
+            }
+
+            return true;
+        }
+
+        bool FieldAccessor::decodeFloatingPoint(const char *begin, const char *end, double &value) const {
+            if (m_fieldDataType == AbstractField::FLOAT_T) {
+                uint32_t raw = 0;
+                if (static_cast<uint32_t>(end - begin) < sizeof(uint32_t)) {
+                    return false;
+                }
+                memcpy(&raw, begin, sizeof(uint32_t));
+                raw = le32toh(raw);
+
+                float f = 0;
+                memcpy(&f, &raw, sizeof(float));
+                value = f;
+                return true;
+            }
+            if (m_fieldDataType == AbstractField::DOUBLE_T) {
+                uint64_t raw = 0;
+                if (static_cast<uint32_t>(end - begin) < sizeof(uint64_t)) {
+                    return false;
+                }
+                memcpy(&raw, begin, sizeof(uint64_t));
+                raw = le64toh(raw);
+
+                memcpy(&value, &raw, sizeof(double));
+                return true;
+            }
+            return false;
+        }
+
+    }
+} // odcore::reflection
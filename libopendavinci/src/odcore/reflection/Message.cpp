@@ -72,6 +72,10 @@ namespace odcore {
             return m_fields.size();
         }
 
+        const vector<std::shared_ptr<AbstractField> >& Message::getFields() const {
+            return m_fields;
+        }
+
         void Message::setID(const int32_t &id) {
             m_ID = id;
         }
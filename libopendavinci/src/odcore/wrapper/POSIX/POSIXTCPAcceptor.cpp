@@ -17,6 +17,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <fcntl.h>
 #include <netinet/in.h>
 #include <sys/select.h>
 #include <sys/socket.h>
@@ -46,12 +47,17 @@ namespace odcore {
                 m_listenerMutex(),
                 m_listener(NULL),
                 m_fileDescriptor(0),
-                m_port(port) {
-                m_thread = unique_ptr<Thread>(ConcurrencyFactory::createThread(*this));
-                if (m_thread.get() == NULL) {
-                    stringstream s;
-                    s << "[core::wrapper::POSIXTCPAcceptor] Error creating thread: " << strerror(errno);
-                    throw s.str();
+                m_port(port),
+                m_reactor(POSIXTCPReactor::getInstance()),
+                m_reactorId(0) {
+                // Use the shared reactor if available; otherwise, use our own thread.
+                if (NULL == m_reactor) {
+                    m_thread = unique_ptr<Thread>(ConcurrencyFactory::createThread(*this));
+                    if (m_thread.get() == NULL) {
+                        stringstream s;
+                        s << "[core::wrapper::POSIXTCPAcceptor] Error creating thread: " << strerror(errno);
+                        throw s.str();
+                    }
                 }
 
                 m_listenerMutex = unique_ptr<Mutex>(MutexFactory::createMutex());
@@ -104,6 +110,9 @@ namespace odcore {
             }
 
             POSIXTCPAcceptor::~POSIXTCPAcceptor() {
+                if (NULL != m_reactor) {
+                    stop();
+                }
                 setAcceptorListener(NULL);
                 close(m_fileDescriptor);
             }
@@ -126,15 +135,58 @@ namespace odcore {
             }
 
             void POSIXTCPAcceptor::start() {
-                m_thread->start();
+                if (NULL == m_reactor) {
+                    m_thread->start();
+                    return;
+                }
+
+                if (0 == m_reactorId) {
+                    const int32_t FLAGS = fcntl(m_fileDescriptor, F_GETFL, 0);
+                    fcntl(m_fileDescriptor, F_SETFL, FLAGS | O_NONBLOCK);
+                    m_reactorId = m_reactor->add(m_fileDescriptor, this, true);
+                }
             }
 
             void POSIXTCPAcceptor::stop() {
-                m_thread->stop();
+                if (NULL == m_reactor) {
+                    m_thread->stop();
+                    return;
+                }
+
+                if (0 != m_reactorId) {
+                    // Waits until a concurrently running handleEvents() has returned.
+                    m_reactor->remove(m_reactorId);
+                    m_reactorId = 0;
+
+                    // Refuse further connections like the thread-based variant.
+                    close(m_fileDescriptor);
+                    m_fileDescriptor = -1;
+                }
             }
 
             bool POSIXTCPAcceptor::isRunning() {
-                return m_thread->isRunning();
+                if (NULL == m_reactor) {
+                    return m_thread->isRunning();
+                }
+                return (0 != m_reactorId);
+            }
+
+            void POSIXTCPAcceptor::handleEvents(const uint32_t &events) {
+                if (events & POSIXTCPReactorHandler::READABLE) {
+                    // Accept all pending connections.
+                    while (true) {
+                        sockaddr clientsock;
+                        socklen_t csize = sizeof(clientsock);
+
+                        int32_t client = accept(m_fileDescriptor, &clientsock, &csize);
+                        if (client >= 0) {
+                            invokeAcceptorListener(std::shared_ptr<odcore::io::tcp::TCPConnection>(new POSIXTCPConnection(client)));
+                        }
+                        else if (EINTR != errno) {
+                            break;
+                        }
+                    }
+                }
             }
 
             void POSIXTCPAcceptor::run() {
@@ -17,9 +17,13 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <fcntl.h>
 #include <netdb.h>
+#include <poll.h>
 #include <sys/select.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
 #include <cerrno>
 #include <cstring>
 #include <sstream>
@@ -30,16 +34,34 @@
 #include "opendavinci/odcore/wrapper/POSIX/POSIXTCPConnection.h"
 #include "opendavinci/odcore/wrapper/Thread.h"
 
+// Do not raise SIGPIPE when the peer closed the connection.
+#ifndef MSG_NOSIGNAL
+    #define MSG_NOSIGNAL 0
+#endif
+
 namespace odcore {
     namespace wrapper {
         namespace POSIX {
 
             using namespace std;
 
+            static inline bool wouldBlock(const int error) {
+#if EAGAIN == EWOULDBLOCK
+                return (EAGAIN == error);
+#else
+                return (EAGAIN == error) || (EWOULDBLOCK == error);
+#endif
+            }
+
             POSIXTCPConnection::POSIXTCPConnection(const int32_t &fileDescriptor) :
                 m_thread(),
                 m_socketMutex(),
                 m_fileDescriptor(fileDescriptor),
+                m_reactor(NULL),
+                m_reactorId(0),
+                m_queuedData(),
+                m_queuedDataOffset(0),
+                m_numberOfQueuedBytes(0),
                 m_buffer(),
                 m_ip(""),
                 m_port(0) {
@@ -50,6 +72,11 @@ namespace odcore {
                 m_thread(),
                 m_socketMutex(),
                 m_fileDescriptor(-1),
+                m_reactor(NULL),
+                m_reactorId(0),
+                m_queuedData(),
+                m_queuedDataOffset(0),
+                m_numberOfQueuedBytes(0),
                 m_buffer(),
                 m_ip(ip),
                 m_port(port) {
@@ -99,15 +126,69 @@ namespace odcore {
             }
 
             void POSIXTCPConnection::start() {
-                m_thread->start();
+                if (NULL == m_reactor) {
+                    m_thread->start();
+                    return;
+                }
+
+                m_socketMutex->lock();
+                if (0 == m_reactorId) {
+                    // The reactor's threads must never block on this socket.
+                    const int32_t FLAGS = fcntl(m_fileDescriptor, F_GETFL, 0);
+                    fcntl(m_fileDescriptor, F_SETFL, FLAGS | O_NONBLOCK);
+                    m_reactorId = m_reactor->add(m_fileDescriptor, this, false);
+                }
+                m_socketMutex->unlock();
             }
 
             void POSIXTCPConnection::stop() {
-                m_thread->stop();
+                if (NULL == m_reactor) {
+                    m_thread->stop();
+                    return;
+                }
+
+                unregisterFromReactor();
             }
 
             bool POSIXTCPConnection::isRunning() {
-                return m_thread->isRunning();
+                if (NULL == m_reactor) {
+                    return m_thread->isRunning();
+                }
+
+                m_socketMutex->lock();
+                const bool RUNNING = (0 != m_reactorId);
+                m_socketMutex->unlock();
+                return RUNNING;
+            }
+
+            void POSIXTCPConnection::unregisterFromReactor() {
+                m_socketMutex->lock();
+                const uint64_t ID = m_reactorId;
+                m_reactorId = 0;
+                m_socketMutex->unlock();
+
+                if (0 != ID) {
+                    // Waits until a concurrently running handleEvents() has returned.
+                    m_reactor->remove(ID);
+
+                    m_socketMutex->lock();
+                    {
+                        // Continue with blocking sends.
+                        const int32_t FLAGS = fcntl(m_fileDescriptor, F_GETFL, 0);
+                        fcntl(m_fileDescriptor, F_SETFL, FLAGS & ~O_NONBLOCK);
+
+                        while (!m_queuedData.empty()) {
+                            const std::string DATA = m_queuedData.front().substr(m_queuedDataOffset);
+                            m_queuedData.pop_front();
+                            m_queuedDataOffset = 0;
+                            if (!sendBlocking(DATA)) {
+                                m_queuedData.clear();
+                            }
+                        }
+                        m_numberOfQueuedBytes = 0;
+                    }
+                    m_socketMutex->unlock();
+                }
             }
 
             void POSIXTCPConnection::run() {
@@ -143,24 +224,210 @@ namespace odcore {
                 }
             }
 
+            void POSIXTCPConnection::handleEvents(const uint32_t &events) {
+                bool failed = false;
+
+                if (events & POSIXTCPReactorHandler::WRITABLE) {
+                    m_socketMutex->lock();
+                    failed = !writeQueuedData();
+                    m_socketMutex->unlock();
+                }
+
+                if (!failed && (events & POSIXTCPReactorHandler::READABLE)) {
+                    // Read a limited amount of data to be fair to the other connections.
+                    for (uint32_t i = 0; i < MAX_READS_PER_EVENT; i++) {
+                        const ssize_t numBytes = recv(m_fileDescriptor, m_buffer, BUFFER_SIZE, 0);
+
+                        if (numBytes > 0) {
+                            m_reactor->addReceivedBytes(numBytes);
+
+                            // Process data in higher layers.
+                            receivedString(string(m_buffer, numBytes));
+
+                            if (numBytes < BUFFER_SIZE) {
+                                break;
+                            }
+                        }
+                        else if ( (numBytes < 0) && (EINTR == errno) ) {
+                            continue;
+                        }
+                        else if ( (numBytes < 0) && wouldBlock(errno) ) {
+                            break;
+                        }
+                        else {
+                            // Handle error: numBytes == 0 if peer shut down, numBytes < 0 in any case of error.
+                            failed = true;
+                            break;
+                        }
+                    }
+                }
+
+                if (failed) {
+                    m_socketMutex->lock();
+                    const uint64_t ID = m_reactorId;
+                    m_reactorId = 0;
+                    m_queuedData.clear();
+                    m_numberOfQueuedBytes = 0;
+                    m_socketMutex->unlock();
+
+                    m_reactor->remove(ID);
+
+                    // The listener might destroy this connection; thus, this must be the last statement.
+                    invokeConnectionListener();
+                }
+            }
+
+            bool POSIXTCPConnection::sendBlocking(const std::string &data) {
+                uint64_t sent = 0;
+                while (sent < data.length()) {
+                    const ssize_t numBytes = ::send(m_fileDescriptor, data.c_str() + sent, data.length() - sent, MSG_NOSIGNAL);
+                    if (numBytes < 0) {
+                        if (EINTR == errno) {
+                            continue;
+                        }
+                        return false;
+                    }
+                    sent += numBytes;
+                }
+                if (NULL != m_reactor) {
+                    m_reactor->addSentBytes(sent);
+                }
+                return true;
+            }
+
+            bool POSIXTCPConnection::writeQueuedData() {
+                while (!m_queuedData.empty()) {
+                    // Write as many queued sends as possible at once.
+                    struct iovec iov[MAX_IOVECS];
+                    uint32_t numberOfIOVecs = 0;
+                    for (auto it = m_queuedData.begin(); (it != m_queuedData.end()) && (numberOfIOVecs < MAX_IOVECS); ++it, ++numberOfIOVecs) {
+                        const uint64_t OFFSET = (0 == numberOfIOVecs) ? m_queuedDataOffset : 0;
+                        iov[numberOfIOVecs].iov_base = const_cast<char*>(it->data()) + OFFSET;
+                        iov[numberOfIOVecs].iov_len = it->length() - OFFSET;
+                    }
+
+                    struct msghdr msg;
+                    memset(&msg, 0, sizeof(msg));
+                    msg.msg_iov = iov;
+                    msg.msg_iovlen = numberOfIOVecs;
+
+                    const ssize_t numBytes = ::sendmsg(m_fileDescriptor, &msg, MSG_NOSIGNAL);
+                    if (numBytes < 0) {
+                        if (EINTR == errno) {
+                            continue;
+                        }
+                        if (wouldBlock(errno)) {
+                            return true;
+                        }
+                        return false;
+                    }
+                    m_reactor->addSentBytes(numBytes);
+                    m_numberOfQueuedBytes -= numBytes;
+
+                    // Remove the written data.
+                    uint64_t written = numBytes;
+                    while ( (written > 0) && !m_queuedData.empty() ) {
+                        const uint64_t AVAILABLE = m_queuedData.front().length() - m_queuedDataOffset;
+                        if (written >= AVAILABLE) {
+                            written -= AVAILABLE;
+                            m_queuedData.pop_front();
+                            m_queuedDataOffset = 0;
+                        }
+                        else {
+                            m_queuedDataOffset += written;
+                            written = 0;
+                        }
+                    }
+                }
+
+                // Nothing left to write.
+                if (0 != m_reactorId) {
+                    m_reactor->setWritable(m_reactorId, false);
+                }
+                return true;
+            }
+
+            bool POSIXTCPConnection::waitForQueueCapacity(const uint64_t &size) {
+                while ( (0 != m_reactorId) && !m_queuedData.empty() && (m_numberOfQueuedBytes + size > MAX_QUEUED_BYTES) ) {
+                    // Let the reactor continue writing while we are waiting.
+                    m_socketMutex->unlock();
+                    struct pollfd pfd;
+                    pfd.fd = m_fileDescriptor;
+                    pfd.events = POLLOUT;
+                    pfd.revents = 0;
+                    const int RESULT = ::poll(&pfd, 1, BACKPRESSURE_TIMEOUT);
+                    const int ERROR = errno;
+                    m_socketMutex->lock();
+
+                    if ( (RESULT < 0) && (EINTR != ERROR) ) {
+                        return false;
+                    }
+                    if ( (0 != m_reactorId) && !writeQueuedData() ) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
             void POSIXTCPConnection::sendImplementation(const std::string& data) {
+                if (data.empty()) {
+                    return;
+                }
+
+                bool failed = false;
                 m_socketMutex->lock();
-                int32_t numBytes = ::send(m_fileDescriptor, data.c_str(), data.length(), 0);
+                // Apply backpressure to the sender if the peer does not keep up.
+                if (!waitForQueueCapacity(data.length())) {
+                    failed = true;
+                }
+                else if (0 == m_reactorId) {
+                    // Any queued data was flushed when the connection was unregistered.
+                    failed = !sendBlocking(data);
+                }
+                else if (!m_queuedData.empty()) {
+                    // Keep the order of the data.
+                    m_queuedData.push_back(data);
+                    m_numberOfQueuedBytes += data.length();
+                }
+                else {
+                    const ssize_t numBytes = ::send(m_fileDescriptor, data.c_str(), data.length(), MSG_NOSIGNAL);
+                    if (numBytes > 0) {
+                        m_reactor->addSentBytes(numBytes);
+                    }
 
-                if (numBytes == -1) {
+                    if (numBytes == static_cast<ssize_t>(data.length())) {
+                        // All data was sent.
+                    }
+                    else if ( (numBytes >= 0) || wouldBlock(errno) || (EINTR == errno) ) {
+                        // Queue the remaining data until the socket becomes writable.
+                        m_queuedData.push_back(data);
+                        m_queuedDataOffset = (numBytes > 0) ? numBytes : 0;
+                        m_numberOfQueuedBytes = data.length() - m_queuedDataOffset;
+                        m_reactor->incrementQueuedSends();
+                        m_reactor->setWritable(m_reactorId, true);
+                    }
+                    else {
+                        failed = true;
+                    }
+                }
+                m_socketMutex->unlock();
+
+                if (failed) {
                     // Handle error.
                     invokeConnectionListener();
                 }
-                m_socketMutex->unlock();
             }
 
-
             void POSIXTCPConnection::initialize() {
-                m_thread = unique_ptr<Thread>(ConcurrencyFactory::createThread(*this));
-                if (m_thread.get() == NULL) {
-                    stringstream s;
-                    s << "[core::wrapper::POSIXTCPConnection] Error creating thread: " << strerror(errno);
-                    throw s.str();
+                // Use the shared reactor if available; otherwise, use our own thread.
+                m_reactor = POSIXTCPReactor::getInstance();
+                if (NULL == m_reactor) {
+                    m_thread = unique_ptr<Thread>(ConcurrencyFactory::createThread(*this));
+                    if (m_thread.get() == NULL) {
+                        stringstream s;
+                        s << "[core::wrapper::POSIXTCPConnection] Error creating thread: " << strerror(errno);
+                        throw s.str();
+                    }
                 }
 
                 m_socketMutex = unique_ptr<Mutex>(MutexFactory::createMutex());
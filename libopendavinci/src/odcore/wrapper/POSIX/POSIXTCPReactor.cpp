@@ -0,0 +1,378 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifdef __linux__
+    #include <sys/epoll.h>
+    #include <sys/eventfd.h>
+#endif
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include "opendavinci/odcore/wrapper/POSIX/POSIXTCPReactor.h"
+
+namespace odcore {
+    namespace wrapper {
+        namespace POSIX {
+
+            using namespace std;
+
+            POSIXTCPReactorHandler::~POSIXTCPReactorHandler() {}
+
+            ////////////////////////////////////////////////////////////////////
+
+            POSIXTCPReactor::Registration::Registration() :
+                m_fileDescriptor(-1),
+                m_handler(NULL),
+                m_isAcceptor(false),
+                m_writable(false),
+                m_busy(false),
+                m_removed(false),
+                m_pendingEvents(0),
+                m_thread() {}
+
+            ////////////////////////////////////////////////////////////////////
+
+            // Initialization of the singleton instance.
+            std::mutex POSIXTCPReactor::m_singletonMutex;
+            POSIXTCPReactor* POSIXTCPReactor::m_singleton = NULL;
+            bool POSIXTCPReactor::m_singletonInitialized = false;
+
+            POSIXTCPReactor* POSIXTCPReactor::getInstance() {
+                std::lock_guard<std::mutex> l(m_singletonMutex);
+                if (!m_singletonInitialized) {
+                    m_singletonInitialized = true;
+#ifdef __linux__
+                    // A listener that takes long to process a received string
+                    // blocks the reactor thread it is called from; thus, use
+                    // several threads to keep the other connections served.
+                    const uint32_t CORES = std::thread::hardware_concurrency();
+                    uint32_t numberOfThreads = (CORES < MIN_DEFAULT_THREADS) ? static_cast<uint32_t>(MIN_DEFAULT_THREADS) :
+                                               ((CORES > MAX_DEFAULT_THREADS) ? static_cast<uint32_t>(MAX_DEFAULT_THREADS) : CORES);
+                    const char *THREADS = ::getenv("OPENDAVINCI_TCP_REACTOR_THREADS");
+                    if (NULL != THREADS) {
+                        numberOfThreads = static_cast<uint32_t>(::strtoul(THREADS, NULL, 10));
+                    }
+                    if (numberOfThreads > 0) {
+                        try {
+                            // The reactor lives until the end of the process.
+                            m_singleton = new POSIXTCPReactor((numberOfThreads > MAX_THREADS) ? static_cast<uint32_t>(MAX_THREADS) : numberOfThreads);
+                        }
+                        catch (string &s) {
+                            cerr << s << endl;
+                            m_singleton = NULL;
+                        }
+                    }
+#endif
+                }
+                return m_singleton;
+            }
+
+            POSIXTCPReactor::POSIXTCPReactor(const uint32_t &numberOfThreads) :
+                m_epollFileDescriptor(-1),
+                m_wakeupFileDescriptor(-1),
+                m_running(true),
+                m_threads(),
+                m_registrationsMutex(),
+                m_registrationsCondition(),
+                m_registrations(),
+                m_nextId(1),
+                m_numberOfConnections(0),
+                m_numberOfAcceptors(0),
+                m_receivedBytes(0),
+                m_sentBytes(0),
+                m_queuedSends(0) {
+#ifdef __linux__
+                m_epollFileDescriptor = ::epoll_create1(EPOLL_CLOEXEC);
+                if (m_epollFileDescriptor < 0) {
+                    stringstream s;
+                    s << "[core::wrapper::POSIXTCPReactor] Error while creating epoll: " << strerror(errno);
+                    throw s.str();
+                }
+
+                // The wakeup file descriptor stays readable to let all threads return.
+                m_wakeupFileDescriptor = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+                if (m_wakeupFileDescriptor < 0) {
+                    ::close(m_epollFileDescriptor);
+
+                    stringstream s;
+                    s << "[core::wrapper::POSIXTCPReactor] Error while creating eventfd: " << strerror(errno);
+                    throw s.str();
+                }
+
+                struct epoll_event ev;
+                memset(&ev, 0, sizeof(ev));
+                ev.events = EPOLLIN;
+                ev.data.u64 = 0;
+                ::epoll_ctl(m_epollFileDescriptor, EPOLL_CTL_ADD, m_wakeupFileDescriptor, &ev);
+
+                for (uint32_t i = 0; i < numberOfThreads; i++) {
+                    m_threads.push_back(std::thread(&POSIXTCPReactor::run, this));
+                }
+#else
+                (void)numberOfThreads;
+#endif
+            }
+
+            POSIXTCPReactor::~POSIXTCPReactor() {
+                m_running = false;
+#ifdef __linux__
+                const uint64_t ONE = 1;
+                if (::write(m_wakeupFileDescriptor, &ONE, sizeof(ONE)) < 0) {
+                    cerr << "[core::wrapper::POSIXTCPReactor] Error while waking up threads: " << strerror(errno) << endl;
+                }
+#endif
+                for (auto &t : m_threads) {
+                    if (t.joinable()) {
+                        t.join();
+                    }
+                }
+
+                if (m_wakeupFileDescriptor > -1) {
+                    ::close(m_wakeupFileDescriptor);
+                }
+                if (m_epollFileDescriptor > -1) {
+                    ::close(m_epollFileDescriptor);
+                }
+            }
+
+            uint64_t POSIXTCPReactor::add(const int32_t &fileDescriptor, POSIXTCPReactorHandler *handler, const bool &isAcceptor) {
+                std::lock_guard<std::mutex> l(m_registrationsMutex);
+                const uint64_t ID = m_nextId++;
+
+                Registration r;
+                r.m_fileDescriptor = fileDescriptor;
+                r.m_handler = handler;
+                r.m_isAcceptor = isAcceptor;
+                m_registrations[ID] = r;
+
+#ifdef __linux__
+                // One-shot registrations ensure that a handler is never called concurrently.
+                struct epoll_event ev;
+                memset(&ev, 0, sizeof(ev));
+                ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+                ev.data.u64 = ID;
+                if (::epoll_ctl(m_epollFileDescriptor, EPOLL_CTL_ADD, fileDescriptor, &ev) < 0) {
+                    cerr << "[core::wrapper::POSIXTCPReactor] Error while adding file descriptor: " << strerror(errno) << endl;
+                    m_registrations.erase(ID);
+                    return 0;
+                }
+#endif
+
+                if (isAcceptor) {
+                    m_numberOfAcceptors++;
+                }
+                else {
+                    m_numberOfConnections++;
+                }
+                return ID;
+            }
+
+            void POSIXTCPReactor::rearm(const uint64_t &id, const int32_t &fileDescriptor, const bool &writable) {
+#ifdef __linux__
+                struct epoll_event ev;
+                memset(&ev, 0, sizeof(ev));
+                ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+                if (writable) {
+                    ev.events |= EPOLLOUT;
+                }
+                ev.data.u64 = id;
+                ::epoll_ctl(m_epollFileDescriptor, EPOLL_CTL_MOD, fileDescriptor, &ev);
+#else
+                (void)id;
+                (void)fileDescriptor;
+                (void)writable;
+#endif
+            }
+
+            void POSIXTCPReactor::setWritable(const uint64_t &id, const bool &writable) {
+                std::lock_guard<std::mutex> l(m_registrationsMutex);
+                auto it = m_registrations.find(id);
+                if ( (it != m_registrations.end()) && (it->second.m_writable != writable) ) {
+                    it->second.m_writable = writable;
+                    // A busy registration is re-armed by its thread.
+                    if (!it->second.m_busy) {
+                        rearm(id, it->second.m_fileDescriptor, writable);
+                    }
+                }
+            }
+
+            void POSIXTCPReactor::remove(const uint64_t &id) {
+                std::unique_lock<std::mutex> l(m_registrationsMutex);
+                auto it = m_registrations.find(id);
+                if (it == m_registrations.end()) {
+                    return;
+                }
+
+                if (!it->second.m_removed) {
+                    it->second.m_removed = true;
+#ifdef __linux__
+                    struct epoll_event ev;
+                    memset(&ev, 0, sizeof(ev));
+                    ::epoll_ctl(m_epollFileDescriptor, EPOLL_CTL_DEL, it->second.m_fileDescriptor, &ev);
+#endif
+                    if (it->second.m_isAcceptor) {
+                        m_numberOfAcceptors--;
+                    }
+                    else {
+                        m_numberOfConnections--;
+                    }
+                }
+
+                // Wait for the handler unless it is removing itself.
+                if (it->second.m_busy && (it->second.m_thread != std::this_thread::get_id())) {
+                    m_registrationsCondition.wait(l, [&]{
+                        auto entry = m_registrations.find(id);
+                        return (entry == m_registrations.end()) || !entry->second.m_busy;
+                    });
+                }
+                m_registrations.erase(id);
+            }
+
+            void POSIXTCPReactor::run() {
+#ifdef __linux__
+                struct epoll_event events[MAX_EVENTS];
+                while (m_running) {
+                    const int32_t N = ::epoll_wait(m_epollFileDescriptor, events, MAX_EVENTS, -1);
+                    if (N < 0) {
+                        if (EINTR == errno) {
+                            continue;
+                        }
+                        cerr << "[core::wrapper::POSIXTCPReactor] Error while waiting for events: " << strerror(errno) << endl;
+                        break;
+                    }
+
+                    for (int32_t i = 0; (i < N) && m_running; i++) {
+                        const uint64_t ID = events[i].data.u64;
+                        if (0 == ID) {
+                            continue;
+                        }
+
+                        uint32_t pendingEvents = 0;
+                        if (events[i].events & EPOLLIN) {
+                            pendingEvents |= POSIXTCPReactorHandler::READABLE;
+                        }
+                        if (events[i].events & EPOLLOUT) {
+                            pendingEvents |= POSIXTCPReactorHandler::WRITABLE;
+                        }
+                        if (events[i].events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP)) {
+                            pendingEvents |= POSIXTCPReactorHandler::FAILED | POSIXTCPReactorHandler::READABLE;
+                        }
+
+                        POSIXTCPReactorHandler *handler = NULL;
+                        {
+                            std::lock_guard<std::mutex> l(m_registrationsMutex);
+                            auto it = m_registrations.find(ID);
+                            if ( (it == m_registrations.end()) || it->second.m_removed ) {
+                                continue;
+                            }
+                            if (it->second.m_busy) {
+                                // Another thread handles this registration already.
+                                it->second.m_pendingEvents |= pendingEvents;
+                                continue;
+                            }
+                            it->second.m_busy = true;
+                            it->second.m_thread = std::this_thread::get_id();
+                            handler = it->second.m_handler;
+                        }
+
+                        while (NULL != handler) {
+                            handler->handleEvents(pendingEvents);
+
+                            std::lock_guard<std::mutex> l(m_registrationsMutex);
+                            auto it = m_registrations.find(ID);
+                            if (it == m_registrations.end()) {
+                                // The handler removed itself.
+                                break;
+                            }
+                            if (it->second.m_removed) {
+                                it->second.m_busy = false;
+                                m_registrationsCondition.notify_all();
+                                break;
+                            }
+                            if (0 != it->second.m_pendingEvents) {
+                                pendingEvents = it->second.m_pendingEvents;
+                                it->second.m_pendingEvents = 0;
+                                continue;
+                            }
+                            it->second.m_busy = false;
+                            rearm(ID, it->second.m_fileDescriptor, it->second.m_writable);
+                            break;
+                        }
+                    }
+                }
+#endif
+            }
+
+            uint32_t POSIXTCPReactor::getNumberOfThreads() const {
+                return m_threads.size();
+            }
+
+            uint32_t POSIXTCPReactor::getNumberOfConnections() const {
+                std::lock_guard<std::mutex> l(m_registrationsMutex);
+                return m_numberOfConnections;
+            }
+
+            uint32_t POSIXTCPReactor::getNumberOfAcceptors() const {
+                std::lock_guard<std::mutex> l(m_registrationsMutex);
+                return m_numberOfAcceptors;
+            }
+
+            void POSIXTCPReactor::addReceivedBytes(const uint64_t &bytes) {
+                m_receivedBytes += bytes;
+            }
+
+            uint64_t POSIXTCPReactor::getReceivedBytes() const {
+                return m_receivedBytes;
+            }
+
+            void POSIXTCPReactor::addSentBytes(const uint64_t &bytes) {
+                m_sentBytes += bytes;
+            }
+
+            uint64_t POSIXTCPReactor::getSentBytes() const {
+                return m_sentBytes;
+            }
+
+            void POSIXTCPReactor::incrementQueuedSends() {
+                m_queuedSends++;
+            }
+
+            uint64_t POSIXTCPReactor::getQueuedSends() const {
+                return m_queuedSends;
+            }
+
+            const string POSIXTCPReactor::toString() const {
+                stringstream s;
+                s << "[core::wrapper::POSIXTCPReactor] threads: " << getNumberOfThreads()
+                  << ", connections: " << getNumberOfConnections()
+                  << ", acceptors: " << getNumberOfAcceptors()
+                  << ", received bytes: " << getReceivedBytes()
+                  << ", sent bytes: " << getSentBytes()
+                  << ", queued sends: " << getQueuedSends();
+                return s.str();
+            }
+
+        }
+    }
+}
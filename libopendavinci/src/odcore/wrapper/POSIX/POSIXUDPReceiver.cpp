@@ -37,6 +37,7 @@
 #include <cstring>
 #include <sstream>
 
+#include "opendavinci/odcore/base/Lock.h"
 #include "opendavinci/odcore/data/TimeStamp.h"
 #include "opendavinci/odcore/wrapper/ConcurrencyFactory.h"
 #include "opendavinci/odcore/wrapper/POSIX/POSIXUDPReceiver.h"
@@ -51,7 +52,8 @@ namespace odcore {
 
             POSIXUDPReceiver::POSIXUDPReceiver(const string &address, const uint32_t &port, const bool &isMulticast) :
                 m_mapOfIPAddresses(),
-                m_portToIgnore(0),
+                m_portsToIgnoreMutex(),
+                m_portsToIgnore(),
                 m_isMulticast(isMulticast),
                 m_address(),
                 m_mreq(),
@@ -155,7 +157,19 @@ namespace odcore {
             }
 
             void POSIXUDPReceiver::setSenderPortToIgnore(const uint16_t &portToIgnore) {
-                m_portToIgnore = portToIgnore;
+                odcore::base::Lock l(m_portsToIgnoreMutex);
+                m_portsToIgnore.clear();
+                m_portsToIgnore.insert(portToIgnore);
+            }
+
+            void POSIXUDPReceiver::setSenderPortsToIgnore(const vector<uint16_t> &portsToIgnore) {
+                odcore::base::Lock l(m_portsToIgnoreMutex);
+                m_portsToIgnore = set<uint16_t>(portsToIgnore.begin(), portsToIgnore.end());
+            }
+
+            bool POSIXUDPReceiver::isSenderPortToIgnore(const uint16_t &port) {
+                odcore::base::Lock l(m_portsToIgnoreMutex);
+                return (m_portsToIgnore.count(port) > 0);
             }
 
             void POSIXUDPReceiver::run() {
@@ -191,7 +205,7 @@ namespace odcore {
                             // or, if sent from the same machine as the one used for receiving, if the data was not sent from a
                             // port that shall be ignored.
                             const bool ACCEPT_PACKET = (0 == m_mapOfIPAddresses.count(RECVFROM_IP_ADDRESS))
-                                                    || ((m_mapOfIPAddresses.count(RECVFROM_IP_ADDRESS) > 0) && (m_portToIgnore != RECVFROM_PORT));
+                                                    || ((m_mapOfIPAddresses.count(RECVFROM_IP_ADDRESS) > 0) && !isSenderPortToIgnore(RECVFROM_PORT));
                             if (ACCEPT_PACKET) {
                                 // Get sender address.
                                 const uint32_t MAX_ADDR_SIZE = 1024;
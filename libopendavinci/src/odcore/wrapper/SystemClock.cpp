@@ -0,0 +1,84 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define HAVE_X86_TSC
+    #include <cpuid.h>
+    #include <x86intrin.h>
+#endif
+
+#include <thread>
+
+#include "opendavinci/odcore/wrapper/SystemClock.h"
+
+namespace odcore {
+    namespace wrapper {
+
+        static bool detectInvariantTSC() {
+#ifdef HAVE_X86_TSC
+            uint32_t eax = 0, ebx = 0, ecx = 0, edx = 0;
+            if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) && (eax >= 0x80000007)) {
+                // CPUID.80000007H:EDX[8] denotes a constant rate across P-, C-, and T-states.
+                if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+                    return (edx & (1 << 8)) != 0;
+                }
+            }
+#endif
+            return false;
+        }
+
+        static double calibrate() {
+            if (!SystemClock::hasInvariantTSC()) {
+                return 1000.0;
+            }
+
+            // Measure the counter against the monotonic clock for some milliseconds.
+            const int64_t START_NS = SystemClock::getMonotonicNanoseconds();
+            const uint64_t START_TICKS = SystemClock::getTicks();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            const int64_t END_NS = SystemClock::getMonotonicNanoseconds();
+            const uint64_t END_TICKS = SystemClock::getTicks();
+
+            if ( (END_NS <= START_NS) || (END_TICKS <= START_TICKS) ) {
+                return 1000.0;
+            }
+            return static_cast<double>(END_TICKS - START_TICKS) * 1000.0 / static_cast<double>(END_NS - START_NS);
+        }
+
+        bool SystemClock::hasInvariantTSC() {
+            static const bool INVARIANT_TSC = detectInvariantTSC();
+            return INVARIANT_TSC;
+        }
+
+        uint64_t SystemClock::getTicks() {
+#ifdef HAVE_X86_TSC
+            if (hasInvariantTSC()) {
+                return __rdtsc();
+            }
+#endif
+            return static_cast<uint64_t>(getMonotonicNanoseconds());
+        }
+
+        double SystemClock::getTicksPerMicrosecond() {
+            static const double TICKS_PER_MICROSECOND = calibrate();
+            return TICKS_PER_MICROSECOND;
+        }
+
+    }
+} // odcore::wrapper
@@ -19,6 +19,7 @@
 
 #include "opendavinci/odcore/wrapper/Mutex.h"
 #include "opendavinci/odcore/wrapper/MutexFactory.h"
+#include "opendavinci/odcore/wrapper/SystemClock.h"
 #include "opendavinci/odcore/wrapper/Time.h"
 #include "opendavinci/odcore/wrapper/TimeFactory.h"
 
@@ -29,6 +30,7 @@ namespace odcore {
         TimeFactory* TimeFactory::instance = NULL;
         TimeFactory* TimeFactory::controlledInstance = NULL;
         unique_ptr<Mutex> TimeFactory::m_singletonMutex = unique_ptr<Mutex>(MutexFactory::createMutex());
+        std::atomic<bool> TimeFactory::m_isControlled(false);
 
         SystemTimeFactory::worker_type SystemTimeFactory::instance = SystemTimeFactory::worker_type();
         
@@ -70,9 +72,27 @@ namespace odcore {
             return t;
         }
 
+        void TimeFactory::getCurrentTime(int32_t &seconds, int32_t &microseconds) {
+            if (!TimeFactory::m_isControlled.load(std::memory_order_acquire)) {
+                SystemClock::getRealtime(seconds, microseconds);
+                return;
+            }
+
+            std::shared_ptr<odcore::wrapper::Time> t(TimeFactory::getInstance().now());
+            if (t.get()) {
+                seconds = t->getSeconds();
+                microseconds = t->getPartialMicroseconds();
+            }
+        }
+
+        bool TimeFactory::isControlled() {
+            return TimeFactory::m_isControlled.load(std::memory_order_acquire);
+        }
+
         void TimeFactory::setSingleton(TimeFactory *tf) {
         	TimeFactory::m_singletonMutex->lock();
             	TimeFactory::controlledInstance = tf;
+            	TimeFactory::m_isControlled.store(tf != NULL, std::memory_order_release);
             TimeFactory::m_singletonMutex->unlock();
         }  
 
@@ -151,6 +151,10 @@ namespace odcore {
                 std::cout << "[core::wrapper::WIN32UDPReceiver] setSenderPortToIgnore() not implemented." << std::endl;
             }
 
+            void WIN32UDPReceiver::setSenderPortsToIgnore(const vector<uint16_t> &/*portsToIgnore*/) {
+                std::cout << "[core::wrapper::WIN32UDPReceiver] setSenderPortsToIgnore() not implemented." << std::endl;
+            }
+
             const char* WIN32UDPReceiver::inet_ntop(int af, const void* src, char* dst, int cnt) {
                 struct sockaddr_in srcaddr;
 
@@ -0,0 +1,168 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifdef WIN32
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <sys/types.h>
+    #include <unistd.h>
+#endif
+
+#include <cstdio>
+
+#include "zip.h"
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/wrapper/Zip/ZipArchive.h"
+
+// Offset of an entry's data as determined by the shipped libzip (cf. zipint.h).
+extern "C" unsigned int _zip_file_get_offset(struct zip *, int);
+
+namespace odcore {
+    namespace wrapper {
+        namespace Zip {
+
+            using namespace std;
+
+            ZipArchive::ZipArchive(const string &fileName, const bool &isTemporary) :
+                m_fileName(fileName),
+                m_isTemporary(isTemporary),
+                m_archive(NULL),
+                m_archiveMutex(),
+                m_data(NULL),
+                m_size(0) {
+                m_archive = zip_open(m_fileName.c_str(), 0, NULL);
+
+#ifndef WIN32
+                if (m_archive != NULL) {
+                    const int FD = ::open(m_fileName.c_str(), O_RDONLY);
+                    if (FD >= 0) {
+                        struct stat fileStatus;
+                        if ( (::fstat(FD, &fileStatus) == 0) && (fileStatus.st_size > 0) ) {
+                            void *data = ::mmap(NULL, static_cast<size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, FD, 0);
+                            if (data != MAP_FAILED) {
+                                m_data = static_cast<const char*>(data);
+                                m_size = static_cast<uint64_t>(fileStatus.st_size);
+                            }
+                        }
+                        // The mapping remains valid after closing the file.
+                        ::close(FD);
+                    }
+                }
+
+                // libzip keeps the file open; thus, a temporary file can be removed already.
+                removeFile();
+#endif
+            }
+
+            ZipArchive::~ZipArchive() {
+                if (m_archive != NULL) {
+                    zip_close(m_archive);
+                    m_archive = NULL;
+                }
+
+#ifndef WIN32
+                if (m_data != NULL) {
+                    ::munmap(const_cast<char*>(m_data), static_cast<size_t>(m_size));
+                }
+#endif
+
+                removeFile();
+            }
+
+            void ZipArchive::removeFile() {
+                if (m_isTemporary && !m_fileName.empty()) {
+#ifdef WIN32
+                    _unlink(m_fileName.c_str());
+#else
+                    unlink(m_fileName.c_str());
+#endif
+                    m_fileName = "";
+                }
+            }
+
+            bool ZipArchive::isOpen() const {
+                return (m_archive != NULL);
+            }
+
+            int32_t ZipArchive::getNumberOfEntries() {
+                std::lock_guard<std::mutex> l(m_archiveMutex);
+                return (m_archive != NULL) ? zip_get_num_files(m_archive) : 0;
+            }
+
+            string ZipArchive::getName(const int32_t &index) {
+                std::lock_guard<std::mutex> l(m_archiveMutex);
+                const char *name = (m_archive != NULL) ? zip_get_name(m_archive, index, 0) : NULL;
+                return (name != NULL) ? string(name) : string("");
+            }
+
+            bool ZipArchive::getSize(const int32_t &index, uint64_t &size) {
+                std::lock_guard<std::mutex> l(m_archiveMutex);
+                struct zip_stat status;
+                if ( (m_archive != NULL) && (zip_stat_index(m_archive, index, 0, &status) == 0) ) {
+                    size = static_cast<uint64_t>(status.size);
+                    return true;
+                }
+                return false;
+            }
+
+            const char* ZipArchive::getStoredEntry(const int32_t &index, uint64_t &size) {
+                std::lock_guard<std::mutex> l(m_archiveMutex);
+                if ( (m_archive == NULL) || (m_data == NULL) ) {
+                    return NULL;
+                }
+
+                struct zip_stat status;
+                if ( (zip_stat_index(m_archive, index, 0, &status) != 0) ||
+                     (status.comp_method != ZIP_CM_STORE) ||
+                     (status.encryption_method != ZIP_EM_NONE) ) {
+                    return NULL;
+                }
+
+                // The offset is determined from the entry's local header.
+                const uint64_t OFFSET = _zip_file_get_offset(m_archive, index);
+                const uint64_t SIZE = static_cast<uint64_t>(status.size);
+                if ( (OFFSET == 0) || (OFFSET + SIZE > m_size) ) {
+                    return NULL;
+                }
+
+                size = SIZE;
+                return m_data + OFFSET;
+            }
+
+            struct zip_file* ZipArchive::openEntry(const int32_t &index) {
+                std::lock_guard<std::mutex> l(m_archiveMutex);
+                return (m_archive != NULL) ? zip_fopen_index(m_archive, index, 0) : NULL;
+            }
+
+            int64_t ZipArchive::readEntry(struct zip_file *entry, char *buffer, const uint32_t &size) {
+                std::lock_guard<std::mutex> l(m_archiveMutex);
+                return zip_fread(entry, buffer, size);
+            }
+
+            void ZipArchive::closeEntry(struct zip_file *entry) {
+                std::lock_guard<std::mutex> l(m_archiveMutex);
+                zip_fclose(entry);
+            }
+
+        }
+    }
+} // odcore::wrapper::Zip
@@ -24,13 +24,19 @@
 #include <functional>
 #include <fstream>
 #include <iostream>
-#include <sstream>
 
-#include "zip.h"
+#ifndef WIN32
+    #include <unistd.h>
+#endif
+
 #include "opendavinci/odcore/opendavinci.h"
 #include <memory>
 #include "opendavinci/odcore/base/module/AbstractCIDModule.h"
+#include "opendavinci/odcore/wrapper/Zip/ZipArchive.h"
 #include "opendavinci/odcore/wrapper/Zip/ZipDecompressedData.h"
+#include "opendavinci/odcore/wrapper/Zip/ZipEntryInputStream.h"
+#include "opendavinci/odcore/wrapper/Zip/ZipEntryStreamBuffer.h"
+#include "opendavinci/odcore/wrapper/Zip/ZipStoredEntryStreamBuffer.h"
 
 namespace odcore {
     namespace wrapper {
@@ -41,115 +47,97 @@ namespace odcore {
             using namespace odcore::strings;
 
             ZipDecompressedData::ZipDecompressedData(istream &in) :
-                m_mapOfDecompressedEntries() {
-                decompressData(in);
+                m_archive(),
+                m_mapOfEntries() {
+                openArchive(in);
+            }
+
+            ZipDecompressedData::ZipDecompressedData(const string &fileName) :
+                m_archive(),
+                m_mapOfEntries() {
+                openArchive(fileName, false);
             }
 
             ZipDecompressedData::~ZipDecompressedData() {
-                // Cleaning up the decompressed data entries.
-                m_mapOfDecompressedEntries.clear();
+                // Streams still in use keep the archive open.
+                m_mapOfEntries.clear();
             }
 
-            void ZipDecompressedData::decompressData(istream &in) {
-                // TODO: libzip needs a file to read from. Therefore, we need to buffer the istream...
+            void ZipDecompressedData::openArchive(istream &in) {
+                // libzip needs a file to read from. Therefore, we need to buffer the istream...
                 char *tempFileName;
 #ifdef WIN32
-                tempFileName = _tempnam("test", NULL);
+                tempFileName = _tempnam(NULL, "odzip");
 #else
-                tempFileName = strdup("tmpfileXXXXXX");
-                if (mkstemp(tempFileName) == -1) {
+                const char *TEMP = ::getenv("TMPDIR");
+                tempFileName = strdup((string((TEMP != NULL) ? TEMP : "/tmp") + "/odzipXXXXXX").c_str());
+                const int FD = mkstemp(tempFileName);
+                if (FD == -1) {
                     CLOG3 << "ZipDecompressedData: temporary file cannot be created" << endl;
                 }
+                else {
+                    close(FD);
+                }
 #endif
                 fstream fout(tempFileName, ios::binary | ios::out);
 
                 if (fout.good()) {
-                    char c = 0;
-                    while (in.get(c)) {
-                        fout << c;
+                    vector<char> buffer(ZipDecompressedData::BUFFER_SIZE);
+                    while (in.good()) {
+                        in.read(&buffer[0], buffer.size());
+                        fout.write(&buffer[0], in.gcount());
                     }
                     fout.flush();
                     fout.close();
 
-                    // Do decompression.
-                    struct zip *zipArchive = NULL;
-
-                    // Open the ZIP archive.
-                    zipArchive = zip_open(tempFileName, 0, NULL);
-                    if (zipArchive != NULL) {
-
-                        // Get the number of compressed entries.
-                        int32_t numberOfEntries = zip_get_num_files(zipArchive);
-                        if (numberOfEntries > 0) {
-
-                            // Allocate memory for decompression.
-                            char *buffer = new char[ZipDecompressedData::BUFFER_SIZE];
-                            if (buffer != NULL) {
-
-                                // Start decompression.
-                                for (int32_t i = 0; i < numberOfEntries; i++) {
-
-                                    // Get i-th entry.
-                                    const char *nameOfEntry = zip_get_name(zipArchive, i, 0);
-                                    if (nameOfEntry != NULL) {
-                                        string name(nameOfEntry);
-
-                                        // Remove leading ./
-                                        if ( (name.length() > 2) && (name.at(0) == '.') && (name.at(1) == '/') ) {
-                                            name = string(nameOfEntry+2);
-                                        }
+                    // The archive removes the temporary file once it is not needed anymore.
+                    openArchive(tempFileName, true);
+                }
+                else {
+#ifdef WIN32
+                    _unlink(tempFileName);
+#else
+                    unlink(tempFileName);
+#endif
+                }
 
-                                        // Transform to lower case for case insensitive searches.
-                                        transform(name.begin(), name.end(), name.begin(), ptr_fun(::tolower));
+                free(tempFileName);
+            }
 
-                                        // Get entry from zip file.
-                                        struct zip_file *entry = zip_fopen_index(zipArchive, i, ZIP_FL_NOCASE);
-                                        if (entry != NULL) {
+            void ZipDecompressedData::openArchive(const string &fileName, const bool &isTemporary) {
+                m_archive = std::shared_ptr<ZipArchive>(new ZipArchive(fileName, isTemporary));
+                if (m_archive->isOpen()) {
 
-                                            // Create stream for storing content.
-                                            stringstream *stream = new stringstream();
-                                            if (stream != NULL) {
+                    // Get the number of compressed entries.
+                    const int32_t NUMBER_OF_ENTRIES = m_archive->getNumberOfEntries();
+                    for (int32_t i = 0; i < NUMBER_OF_ENTRIES; i++) {
 
-                                                // Decompress data.
-                                                int32_t nbytes = 0;
-                                                while ( (nbytes = zip_fread(entry, buffer, ZipDecompressedData::BUFFER_SIZE)) > 0) {
-                                                    string s(buffer, nbytes);
-                                                    (*stream) << s;
-                                                }
+                        // Get i-th entry; it is decompressed when it is read.
+                        string name = m_archive->getName(i);
+                        if (!name.empty()) {
 
-                                                // Store read content into map.
-                                                m_mapOfDecompressedEntries[name] = std::shared_ptr<istream>(stream);
-                                            }
+                            // Remove leading ./
+                            if ( (name.length() > 2) && (name.at(0) == '.') && (name.at(1) == '/') ) {
+                                name = name.substr(2);
+                            }
 
-                                            // Close entry.
-                                            zip_fclose(entry);
-                                        }
-                                    }
-                                }
+                            // Transform to lower case for case insensitive searches.
+                            transform(name.begin(), name.end(), name.begin(), ptr_fun(::tolower));
 
-                                // De-allocate memory.
-                                delete [] buffer;
-                            }
+                            m_mapOfEntries[name] = i;
                         }
-
-                        // Close given archive.
-                        zip_close(zipArchive);
                     }
                 }
-
-#ifdef WIN32
-                _unlink(tempFileName);
-#else
-                unlink(tempFileName);
-#endif
-                free(tempFileName);
+                else {
+                    m_archive.reset();
+                }
             }
 
             vector<string> ZipDecompressedData::getListOfEntries() {
                 vector<string> listOfEntries;
 
-                map<string, std::shared_ptr<istream>, StringComparator>::const_iterator it = m_mapOfDecompressedEntries.begin();
-                while (it != m_mapOfDecompressedEntries.end()) {
+                map<string, int32_t, StringComparator>::const_iterator it = m_mapOfEntries.begin();
+                while (it != m_mapOfEntries.end()) {
                     listOfEntries.push_back(it->first);
                     ++it;
                 }
@@ -165,9 +153,23 @@ namespace odcore {
                 transform(key.begin(), key.end(), key.begin(), ptr_fun(::tolower));
 
                 // Try to find the key/value.
-                map<string, std::shared_ptr<istream>, StringComparator>::const_iterator it = m_mapOfDecompressedEntries.find(key);
-                if (it != m_mapOfDecompressedEntries.end()) {
-                    stream = it->second;
+                map<string, int32_t, StringComparator>::const_iterator it = m_mapOfEntries.find(key);
+                if ( (it != m_mapOfEntries.end()) && (m_archive.get() != NULL) ) {
+                    std::shared_ptr<streambuf> buffer;
+
+                    // Stored entries are read without copying them.
+                    uint64_t size = 0;
+                    const char *data = m_archive->getStoredEntry(it->second, size);
+                    if (data != NULL) {
+                        buffer = std::shared_ptr<streambuf>(new ZipStoredEntryStreamBuffer(m_archive, data, size));
+                    }
+                    else if (m_archive->getSize(it->second, size)) {
+                        buffer = std::shared_ptr<streambuf>(new ZipEntryStreamBuffer(m_archive, it->second, size));
+                    }
+
+                    if (buffer.get() != NULL) {
+                        stream = std::shared_ptr<istream>(new ZipEntryInputStream(buffer));
+                    }
                 }
 
                 return stream;
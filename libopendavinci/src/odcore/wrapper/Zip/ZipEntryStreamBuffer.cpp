@@ -0,0 +1,118 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/wrapper/Zip/ZipEntryStreamBuffer.h"
+
+namespace odcore {
+    namespace wrapper {
+        namespace Zip {
+
+            using namespace std;
+
+            ZipEntryStreamBuffer::ZipEntryStreamBuffer(std::shared_ptr<ZipArchive> archive, const int32_t &index, const uint64_t &size) :
+                m_archive(archive),
+                m_index(index),
+                m_size(size),
+                m_entry(NULL),
+                m_positionOfBuffer(0),
+                m_buffer(ZipEntryStreamBuffer::BUFFER_SIZE) {
+                rewind();
+            }
+
+            ZipEntryStreamBuffer::~ZipEntryStreamBuffer() {
+                if (m_entry != NULL) {
+                    m_archive->closeEntry(m_entry);
+                    m_entry = NULL;
+                }
+            }
+
+            void ZipEntryStreamBuffer::rewind() {
+                if (m_entry != NULL) {
+                    m_archive->closeEntry(m_entry);
+                }
+                m_entry = m_archive->openEntry(m_index);
+
+                m_positionOfBuffer = 0;
+                setg(&m_buffer[0], &m_buffer[0], &m_buffer[0]);
+            }
+
+            bool ZipEntryStreamBuffer::fill() {
+                m_positionOfBuffer += static_cast<uint64_t>(egptr() - eback());
+                setg(&m_buffer[0], &m_buffer[0], &m_buffer[0]);
+
+                if (m_entry == NULL) {
+                    return false;
+                }
+
+                const int64_t LENGTH = m_archive->readEntry(m_entry, &m_buffer[0], m_buffer.size());
+                if (LENGTH <= 0) {
+                    return false;
+                }
+
+                setg(&m_buffer[0], &m_buffer[0], &m_buffer[0] + LENGTH);
+                return true;
+            }
+
+            ZipEntryStreamBuffer::int_type ZipEntryStreamBuffer::underflow() {
+                if ( (gptr() < egptr()) || fill() ) {
+                    return traits_type::to_int_type(*gptr());
+                }
+                return traits_type::eof();
+            }
+
+            ZipEntryStreamBuffer::pos_type ZipEntryStreamBuffer::seekoff(off_type off, ios_base::seekdir dir, ios_base::openmode which) {
+                const off_type CURRENT = static_cast<off_type>(m_positionOfBuffer) + (gptr() - eback());
+
+                off_type target = off;
+                if (dir == ios_base::cur) {
+                    target += CURRENT;
+                }
+                else if (dir == ios_base::end) {
+                    target += static_cast<off_type>(m_size);
+                }
+
+                return seekpos(pos_type(target), which);
+            }
+
+            ZipEntryStreamBuffer::pos_type ZipEntryStreamBuffer::seekpos(pos_type pos, ios_base::openmode which) {
+                const off_type TARGET = static_cast<off_type>(pos);
+                if ( ((which & ios_base::in) == 0) || (TARGET < 0) || (TARGET > static_cast<off_type>(m_size)) ) {
+                    return pos_type(off_type(-1));
+                }
+
+                // libzip cannot seek within compressed data; thus, restart from the beginning.
+                if (TARGET < static_cast<off_type>(m_positionOfBuffer)) {
+                    rewind();
+                }
+
+                // Skip forward until the target is in the buffer.
+                while (TARGET > static_cast<off_type>(m_positionOfBuffer) + (egptr() - eback())) {
+                    if (!fill()) {
+                        return pos_type(off_type(-1));
+                    }
+                }
+
+                setg(eback(), eback() + (TARGET - static_cast<off_type>(m_positionOfBuffer)), egptr());
+                return pos;
+            }
+
+        }
+    }
+} // odcore::wrapper::Zip
@@ -0,0 +1,62 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/wrapper/Zip/ZipStoredEntryStreamBuffer.h"
+
+namespace odcore {
+    namespace wrapper {
+        namespace Zip {
+
+            using namespace std;
+
+            ZipStoredEntryStreamBuffer::ZipStoredEntryStreamBuffer(std::shared_ptr<ZipArchive> archive, const char *data, const uint64_t &size) :
+                m_archive(archive) {
+                // The get area is never written to.
+                char *begin = const_cast<char*>(data);
+                setg(begin, begin, begin + size);
+            }
+
+            ZipStoredEntryStreamBuffer::~ZipStoredEntryStreamBuffer() {}
+
+            ZipStoredEntryStreamBuffer::pos_type ZipStoredEntryStreamBuffer::seekoff(off_type off, ios_base::seekdir dir, ios_base::openmode which) {
+                off_type target = off;
+                if (dir == ios_base::cur) {
+                    target += gptr() - eback();
+                }
+                else if (dir == ios_base::end) {
+                    target += egptr() - eback();
+                }
+
+                return seekpos(pos_type(target), which);
+            }
+
+            ZipStoredEntryStreamBuffer::pos_type ZipStoredEntryStreamBuffer::seekpos(pos_type pos, ios_base::openmode which) {
+                const off_type TARGET = static_cast<off_type>(pos);
+                if ( ((which & ios_base::in) == 0) || (TARGET < 0) || (TARGET > (egptr() - eback())) ) {
+                    return pos_type(off_type(-1));
+                }
+
+                setg(eback(), eback() + TARGET, egptr());
+                return pos;
+            }
+
+        }
+    }
+} // odcore::wrapper::Zip
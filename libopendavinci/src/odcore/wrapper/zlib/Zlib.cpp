@@ -34,29 +34,29 @@ namespace odcore {
             string Zlib::compress(const string &s) {
                 string result;
                 const uint32_t CHUNK = Zlib::BUFFER_SIZE;
-                if (s.size() < CHUNK) {
-                    int level = Z_DEFAULT_COMPRESSION;
-                    int ret = 0, flush = 0;
-                    unsigned int have = 0;
-                    z_stream strm;
-                    unsigned char out[CHUNK];
+                int ret = 0;
+                z_stream strm;
+                unsigned char out[CHUNK];
 
-                    strm.zalloc = Z_NULL;
-                    strm.zfree = Z_NULL;
-                    strm.opaque = Z_NULL;
-                    ret = deflateInit(&strm, level);
-                    if (ret == Z_OK) {
-                        strm.avail_in = s.size();
-                        flush = Z_FINISH;
-                        strm.next_in = (unsigned char*)(s.c_str());
+                strm.zalloc = Z_NULL;
+                strm.zfree = Z_NULL;
+                strm.opaque = Z_NULL;
+                ret = deflateInit(&strm, Z_DEFAULT_COMPRESSION);
+                if (ret == Z_OK) {
+                    strm.avail_in = s.size();
+                    strm.next_in = (unsigned char*)(s.c_str());
 
+                    // Binary data might contain '\0'; thus, the output is appended with explicit length.
+                    do {
                         strm.avail_out = CHUNK;
                         strm.next_out = out;
-                        (void)deflate(&strm, flush);
-                        have = CHUNK - strm.avail_out;
-                        out[have] = 0;
-                        result = string((const char*)out);
-                        (void)deflateEnd(&strm);
+                        ret = deflate(&strm, Z_FINISH);
+                        result.append(reinterpret_cast<const char*>(out), CHUNK - strm.avail_out);
+                    } while (ret == Z_OK);
+
+                    (void)deflateEnd(&strm);
+                    if (ret != Z_STREAM_END) {
+                        result = "";
                     }
                 }
                 return result;
@@ -65,31 +65,32 @@ namespace odcore {
             string Zlib::decompress(const string &s) {
                 string result;
                 const uint32_t CHUNK = Zlib::BUFFER_SIZE;
-                if (s.size() < CHUNK) {
-                    int ret = 0;
-                    unsigned int have = 0;
-                    z_stream strm;
-                    unsigned char out[CHUNK];
+                int ret = 0;
+                z_stream strm;
+                unsigned char out[CHUNK];
+
+                strm.zalloc = Z_NULL;
+                strm.zfree = Z_NULL;
+                strm.opaque = Z_NULL;
+                strm.avail_in = 0;
+                strm.next_in = Z_NULL;
+                ret = inflateInit(&strm);
+                if (ret == Z_OK) {
+                    strm.avail_in = s.size();
+                    strm.next_in = (unsigned char*)(s.c_str());
 
-                    strm.zalloc = Z_NULL;
-                    strm.zfree = Z_NULL;
-                    strm.opaque = Z_NULL;
-                    strm.avail_in = 0;
-                    strm.next_in = Z_NULL;
-                    ret = inflateInit(&strm);
-                    if (ret == Z_OK) {
-                        strm.avail_in = s.size();
-                        strm.next_in = (unsigned char*)(s.c_str());
+                    do {
                         strm.avail_out = CHUNK;
                         strm.next_out = out;
-                        
                         ret = inflate(&strm, Z_NO_FLUSH);
-                        if (ret != Z_STREAM_ERROR) {
-                            have = CHUNK - strm.avail_out;
-                            out[have] = 0;
-                            result = string((const char*)out);
-                            (void)inflateEnd(&strm);
+                        if ( (ret == Z_OK) || (ret == Z_STREAM_END) ) {
+                            result.append(reinterpret_cast<const char*>(out), CHUNK - strm.avail_out);
                         }
+                    } while (ret == Z_OK);
+
+                    (void)inflateEnd(&strm);
+                    if (ret != Z_STREAM_END) {
+                        result = "";
                     }
                 }
                 return result;
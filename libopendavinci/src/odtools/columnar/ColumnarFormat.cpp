@@ -0,0 +1,236 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/wrapper/zlib/Zlib.h"
+#include "opendavinci/odtools/columnar/ColumnarFormat.h"
+
+namespace odtools {
+    namespace columnar {
+
+        using namespace std;
+
+        ColumnBlock::ColumnBlock() :
+            m_offset(0),
+            m_compressedSize(0),
+            m_firstRow(0),
+            m_numberOfRows(0),
+            m_minimum(0),
+            m_maximum(0) {}
+
+        ////////////////////////////////////////////////////////////////////////
+
+        Column::Column() :
+            m_name(),
+            m_type(ColumnarFormat::INTEGER),
+            m_blocks() {}
+
+        ////////////////////////////////////////////////////////////////////////
+
+        Table::Table() :
+            m_name(),
+            m_dataType(0),
+            m_senderStamp(0),
+            m_numberOfRows(0),
+            m_columns() {}
+
+        int32_t Table::findColumn(const string &name) const {
+            for (uint32_t i = 0; i < m_columns.size(); i++) {
+                if (m_columns[i].m_name == name) {
+                    return i;
+                }
+            }
+            return -1;
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+
+        const char ColumnarFormat::MAGIC[ColumnarFormat::MAGIC_SIZE + 1] = "ODCOL001";
+
+        const string ColumnarFormat::SENT_TIMESTAMP = "SentTimeStamp";
+        const string ColumnarFormat::RECEIVED_TIMESTAMP = "ReceivedTimeStamp";
+        const string ColumnarFormat::SAMPLE_TIMESTAMP = "SampleTimeStamp";
+
+        ColumnarFormat::ColumnarFormat() {}
+
+        ColumnarFormat::~ColumnarFormat() {}
+
+        double ColumnarFormat::toDouble(const uint8_t &type, const uint64_t &value) {
+            if (FLOATING_POINT == type) {
+                double d = 0;
+                memcpy(&d, &value, sizeof(double));
+                return d;
+            }
+            return static_cast<double>(static_cast<int64_t>(value));
+        }
+
+        bool ColumnarFormat::isLess(const uint8_t &type, const uint64_t &a, const uint64_t &b) {
+            if (FLOATING_POINT == type) {
+                return toDouble(type, a) < toDouble(type, b);
+            }
+            return static_cast<int64_t>(a) < static_cast<int64_t>(b);
+        }
+
+        string ColumnarFormat::encodeBlock(const uint8_t &type, const vector<uint64_t> &values) {
+            string raw(values.size() * sizeof(uint64_t), '\0');
+            uint64_t previous = 0;
+            for (uint32_t i = 0; i < values.size(); i++) {
+                // Consecutive integers like time stamps or counters compress much better as differences.
+                const uint64_t V = (INTEGER == type) ? (values[i] - previous) : values[i];
+                previous = values[i];
+
+                const uint64_t LE = htole64(V);
+                memcpy(&raw[i * sizeof(uint64_t)], &LE, sizeof(uint64_t));
+            }
+            return odcore::wrapper::zlib::Zlib::compress(raw);
+        }
+
+        bool ColumnarFormat::decodeBlock(const uint8_t &type, const string &data, const uint32_t &numberOfRows, vector<uint64_t> &values) {
+            const string RAW = odcore::wrapper::zlib::Zlib::decompress(data);
+            if (RAW.size() != numberOfRows * sizeof(uint64_t)) {
+                return false;
+            }
+
+            values.resize(numberOfRows);
+            uint64_t previous = 0;
+            for (uint32_t i = 0; i < numberOfRows; i++) {
+                uint64_t v = 0;
+                memcpy(&v, &RAW[i * sizeof(uint64_t)], sizeof(uint64_t));
+                v = le64toh(v);
+                values[i] = (INTEGER == type) ? (previous + v) : v;
+                previous = values[i];
+            }
+            return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+
+        static void write(ostream &out, const uint8_t &v) {
+            out.write(reinterpret_cast<const char*>(&v), sizeof(uint8_t));
+        }
+
+        static void write(ostream &out, const uint32_t &v) {
+            const uint32_t LE = htole32(v);
+            out.write(reinterpret_cast<const char*>(&LE), sizeof(uint32_t));
+        }
+
+        static void write(ostream &out, const uint64_t &v) {
+            const uint64_t LE = htole64(v);
+            out.write(reinterpret_cast<const char*>(&LE), sizeof(uint64_t));
+        }
+
+        static void write(ostream &out, const string &v) {
+            write(out, static_cast<uint32_t>(v.size()));
+            out.write(v.c_str(), v.size());
+        }
+
+        static void read(istream &in, uint8_t &v) {
+            in.read(reinterpret_cast<char*>(&v), sizeof(uint8_t));
+        }
+
+        static void read(istream &in, uint32_t &v) {
+            in.read(reinterpret_cast<char*>(&v), sizeof(uint32_t));
+            v = le32toh(v);
+        }
+
+        static void read(istream &in, uint64_t &v) {
+            in.read(reinterpret_cast<char*>(&v), sizeof(uint64_t));
+            v = le64toh(v);
+        }
+
+        static void read(istream &in, string &v) {
+            uint32_t size = 0;
+            read(in, size);
+            if (in.good()) {
+                v.resize(size);
+                if (size > 0) {
+                    in.read(&v[0], size);
+                }
+            }
+        }
+
+        void ColumnarFormat::writeDirectory(ostream &out, const vector<Table> &tables) {
+            write(out, static_cast<uint32_t>(tables.size()));
+            for (auto &t : tables) {
+                write(out, t.m_name);
+                write(out, static_cast<uint32_t>(t.m_dataType));
+                write(out, t.m_senderStamp);
+                write(out, t.m_numberOfRows);
+                write(out, static_cast<uint32_t>(t.m_columns.size()));
+                for (auto &c : t.m_columns) {
+                    write(out, c.m_name);
+                    write(out, c.m_type);
+                    write(out, static_cast<uint32_t>(c.m_blocks.size()));
+                    for (auto &b : c.m_blocks) {
+                        write(out, b.m_offset);
+                        write(out, b.m_compressedSize);
+                        write(out, b.m_firstRow);
+                        write(out, b.m_numberOfRows);
+                        write(out, b.m_minimum);
+                        write(out, b.m_maximum);
+                    }
+                }
+            }
+        }
+
+        bool ColumnarFormat::readDirectory(istream &in, vector<Table> &tables) {
+            tables.clear();
+
+            uint32_t numberOfTables = 0;
+            read(in, numberOfTables);
+            for (uint32_t i = 0; (i < numberOfTables) && in.good(); i++) {
+                Table t;
+                uint32_t dataType = 0;
+                uint32_t numberOfColumns = 0;
+                read(in, t.m_name);
+                read(in, dataType);
+                t.m_dataType = static_cast<int32_t>(dataType);
+                read(in, t.m_senderStamp);
+                read(in, t.m_numberOfRows);
+                read(in, numberOfColumns);
+                for (uint32_t j = 0; (j < numberOfColumns) && in.good(); j++) {
+                    Column c;
+                    uint32_t numberOfBlocks = 0;
+                    read(in, c.m_name);
+                    read(in, c.m_type);
+                    read(in, numberOfBlocks);
+                    for (uint32_t k = 0; (k < numberOfBlocks) && in.good(); k++) {
+                        ColumnBlock b;
+                        read(in, b.m_offset);
+                        read(in, b.m_compressedSize);
+                        read(in, b.m_firstRow);
+                        read(in, b.m_numberOfRows);
+                        read(in, b.m_minimum);
+                        read(in, b.m_maximum);
+                        c.m_blocks.push_back(b);
+                    }
+                    t.m_columns.push_back(c);
+                }
+                tables.push_back(t);
+            }
+
+            return in.good();
+        }
+
+    } // columnar
+} // odtools
@@ -0,0 +1,134 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <cstring>
+
+#include "opendavinci/odcore/base/Visitable.h"
+#include "opendavinci/odcore/serialization/Serializable.h"
+#include "opendavinci/odtools/columnar/ColumnarFormat.h"
+#include "opendavinci/odtools/columnar/ColumnarFromVisitableVisitor.h"
+
+namespace odtools {
+    namespace columnar {
+
+        using namespace std;
+        using namespace odcore::base;
+        using namespace odcore::serialization;
+
+        ColumnValue::ColumnValue() :
+            ColumnValue("", ColumnarFormat::INTEGER, 0) {}
+
+        ColumnValue::ColumnValue(const string &name, const uint8_t &type, const uint64_t &value) :
+            m_name(name),
+            m_type(type),
+            m_value(value) {}
+
+        ////////////////////////////////////////////////////////////////////////
+
+        ColumnarFromVisitableVisitor::ColumnarFromVisitableVisitor(const string &prefix) :
+            m_prefix(prefix),
+            m_values() {}
+
+        ColumnarFromVisitableVisitor::~ColumnarFromVisitableVisitor() {}
+
+        void ColumnarFromVisitableVisitor::beginVisit(const int32_t &/*id*/, const string &/*shortName*/, const string &/*longName*/) {}
+
+        void ColumnarFromVisitableVisitor::endVisit() {}
+
+        const vector<ColumnValue>& ColumnarFromVisitableVisitor::getValues() const {
+            return m_values;
+        }
+
+        void ColumnarFromVisitableVisitor::addInteger(const string &shortName, const int64_t &v) {
+            m_values.push_back(ColumnValue(m_prefix + shortName, ColumnarFormat::INTEGER, static_cast<uint64_t>(v)));
+        }
+
+        void ColumnarFromVisitableVisitor::addFloatingPoint(const string &shortName, const double &v) {
+            uint64_t raw = 0;
+            memcpy(&raw, &v, sizeof(double));
+            m_values.push_back(ColumnValue(m_prefix + shortName, ColumnarFormat::FLOATING_POINT, raw));
+        }
+
+        void ColumnarFromVisitableVisitor::visit(const uint32_t &/*id*/, const string &/*longName*/, const string &shortName, Serializable &v) {
+            try {
+                Visitable &visitable = dynamic_cast<Visitable&>(v);
+
+                ColumnarFromVisitableVisitor nested(m_prefix + shortName + ".");
+                visitable.accept(nested);
+                m_values.insert(m_values.end(), nested.getValues().begin(), nested.getValues().end());
+            }
+            catch(...) {}
+        }
+
+        void ColumnarFromVisitableVisitor::visit(const uint32_t &/*id*/, const string &/*longName*/, const string &shortName, bool &v) {
+            addInteger(shortName, static_cast<int64_t>(v));
+        }
+
+        void ColumnarFromVisitableVisitor::visit(const uint32_t &/*id*/, const string &/*longName*/, const string &shortName, char &v) {
+            addInteger(shortName, static_cast<int64_t>(v));
+        }
+
+        void ColumnarFromVisitableVisitor::visit(const uint32_t &/*id*/, const string &/*longName*/, const string &shortName, unsigned char &v) {
+            addInteger(shortName, static_cast<int64_t>(v));
+        }
+
+        void ColumnarFromVisitableVisitor::visit(const uint32_t &/*id*/, const string &/*longName*/, const string &shortName, int8_t &v) {
+            addInteger(shortName, static_cast<int64_t>(v));
+        }
+
+        void ColumnarFromVisitableVisitor::visit(const uint32_t &/*id*/, const string &/*longName*/, const string &shortName, int16_t &v) {
+            addInteger(shortName, static_cast<int64_t>(v));
+        }
+
+        void ColumnarFromVisitableVisitor::visit(const uint32_t &/*id*/, const string &/*longName*/, const string &shortName, uint16_t &v) {
+            addInteger(shortName, static_cast<int64_t>(v));
+        }
+
+        void ColumnarFromVisitableVisitor::visit(const uint32_t &/*id*/, const string &/*longName*/, const string &shortName, int32_t &v) {
+            addInteger(shortName, static_cast<int64_t>(v));
+        }
+
+        void ColumnarFromVisitableVisitor::visit(const uint32_t &/*id*/, const string &/*longName*/, const string &shortName, uint32_t &v) {
+            addInteger(shortName, static_cast<int64_t>(v));
+        }
+
+        void ColumnarFromVisitableVisitor::visit(const uint32_t &/*id*/, const string &/*longName*/, const string &shortName, int64_t &v) {
+            addInteger(shortName, static_cast<int64_t>(v));
+        }
+
+        void ColumnarFromVisitableVisitor::visit(const uint32_t &/*id*/, const string &/*longName*/, const string &shortName, uint64_t &v) {
+            addInteger(shortName, static_cast<int64_t>(v));
+        }
+
+        void ColumnarFromVisitableVisitor::visit(const uint32_t &/*id*/, const string &/*longName*/, const string &shortName, float &v) {
+            addFloatingPoint(shortName, static_cast<double>(v));
+        }
+
+        void ColumnarFromVisitableVisitor::visit(const uint32_t &/*id*/, const string &/*longName*/, const string &shortName, double &v) {
+            addFloatingPoint(shortName, static_cast<double>(v));
+        }
+
+        void ColumnarFromVisitableVisitor::visit(const uint32_t &/*id*/, const string &/*longName*/, const string &/*shortName*/, string &/*v*/) {}
+
+        void ColumnarFromVisitableVisitor::visit(const uint32_t &/*id*/, const string &/*longName*/, const string &/*shortName*/, void */*data*/, const uint32_t &/*size*/) {}
+
+        void ColumnarFromVisitableVisitor::visit(const uint32_t &/*id*/, const string &/*longName*/, const string &/*shortName*/, void */*data*/, const uint32_t &/*count*/, const odcore::TYPE_ &/*t*/) {}
+
+    } // columnar
+} // odtools
@@ -0,0 +1,175 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <cstring>
+#include <iostream>
+
+#include "opendavinci/odtools/columnar/ColumnarReader.h"
+
+namespace odtools {
+    namespace columnar {
+
+        using namespace std;
+
+        ColumnarReader::ColumnarReader(const string &filename) :
+            m_in(),
+            m_valid(false),
+            m_tables(),
+            m_numberOfDecodedBlocks(0) {
+            m_in.open(filename.c_str(), ios_base::in|ios_base::binary);
+            if (!m_in.good()) {
+                cerr << "[odtools::columnar::ColumnarReader] Could not open " << filename << "." << endl;
+                return;
+            }
+
+            const uint32_t TRAILER_SIZE = sizeof(uint64_t) + ColumnarFormat::MAGIC_SIZE;
+            char magic[ColumnarFormat::MAGIC_SIZE];
+            m_in.read(magic, ColumnarFormat::MAGIC_SIZE);
+            m_in.seekg(0, m_in.end);
+            const uint64_t LENGTH = m_in.tellg();
+            if ( !m_in.good() || (0 != memcmp(magic, ColumnarFormat::MAGIC, ColumnarFormat::MAGIC_SIZE)) || (LENGTH < (ColumnarFormat::MAGIC_SIZE + TRAILER_SIZE)) ) {
+                cerr << "[odtools::columnar::ColumnarReader] " << filename << " is not a columnar recording." << endl;
+                return;
+            }
+
+            uint64_t directoryOffset = 0;
+            m_in.seekg(LENGTH - TRAILER_SIZE, m_in.beg);
+            m_in.read(reinterpret_cast<char*>(&directoryOffset), sizeof(uint64_t));
+            m_in.read(magic, ColumnarFormat::MAGIC_SIZE);
+            directoryOffset = le64toh(directoryOffset);
+            if ( !m_in.good() || (0 != memcmp(magic, ColumnarFormat::MAGIC, ColumnarFormat::MAGIC_SIZE)) || (directoryOffset > (LENGTH - TRAILER_SIZE)) ) {
+                cerr << "[odtools::columnar::ColumnarReader] " << filename << " is incomplete." << endl;
+                return;
+            }
+
+            m_in.seekg(directoryOffset, m_in.beg);
+            m_valid = ColumnarFormat::readDirectory(m_in, m_tables);
+        }
+
+        ColumnarReader::~ColumnarReader() {}
+
+        bool ColumnarReader::isValid() const {
+            return m_valid;
+        }
+
+        const vector<Table>& ColumnarReader::getTables() const {
+            return m_tables;
+        }
+
+        uint64_t ColumnarReader::getNumberOfDecodedBlocks() const {
+            return m_numberOfDecodedBlocks;
+        }
+
+        const Table* ColumnarReader::findTable(const string &messageName, const uint32_t &senderStamp) const {
+            for (auto &t : m_tables) {
+                if ( (t.m_name == messageName) && (t.m_senderStamp == senderStamp) ) {
+                    return &t;
+                }
+            }
+            return NULL;
+        }
+
+        bool ColumnarReader::readBlock(const Column &column, const uint32_t &block, vector<uint64_t> &values) {
+            const ColumnBlock &B = column.m_blocks.at(block);
+            string data(B.m_compressedSize, '\0');
+            m_in.clear();
+            m_in.seekg(B.m_offset, m_in.beg);
+            if (B.m_compressedSize > 0) {
+                m_in.read(&data[0], B.m_compressedSize);
+            }
+            m_numberOfDecodedBlocks++;
+            return m_in.good() && ColumnarFormat::decodeBlock(column.m_type, data, B.m_numberOfRows, values);
+        }
+
+        bool ColumnarReader::query(const string &messageName, const uint32_t &senderStamp, const string &columnName,
+                                   const int64_t &from, const int64_t &to,
+                                   vector<int64_t> &timeStamps, vector<double> &values,
+                                   const string &timeStampColumn) {
+            return scan(messageName, senderStamp, columnName, timeStampColumn, true, from, to, 0, 0, timeStamps, values);
+        }
+
+        bool ColumnarReader::queryValues(const string &messageName, const uint32_t &senderStamp, const string &columnName,
+                                         const double &minimum, const double &maximum,
+                                         vector<int64_t> &timeStamps, vector<double> &values,
+                                         const string &timeStampColumn) {
+            return scan(messageName, senderStamp, columnName, timeStampColumn, false, 0, 0, minimum, maximum, timeStamps, values);
+        }
+
+        bool ColumnarReader::scan(const string &messageName, const uint32_t &senderStamp, const string &columnName,
+                                  const string &timeStampColumn, const bool &filterByTime,
+                                  const int64_t &from, const int64_t &to, const double &minimum, const double &maximum,
+                                  vector<int64_t> &timeStamps, vector<double> &values) {
+            timeStamps.clear();
+            values.clear();
+
+            const Table *table = findTable(messageName, senderStamp);
+            if (!m_valid || (NULL == table)) {
+                return false;
+            }
+            const int32_t TIMESTAMP_INDEX = table->findColumn(timeStampColumn);
+            const int32_t VALUE_INDEX = table->findColumn(columnName);
+            if ( (TIMESTAMP_INDEX < 0) || (VALUE_INDEX < 0) ) {
+                return false;
+            }
+
+            const Column &T = table->m_columns[TIMESTAMP_INDEX];
+            const Column &V = table->m_columns[VALUE_INDEX];
+
+            bool retVal = true;
+            vector<uint64_t> rawTimeStamps;
+            vector<uint64_t> rawValues;
+            for (uint32_t block = 0; (block < V.m_blocks.size()) && (block < T.m_blocks.size()); block++) {
+                // Skip blocks whose statistics cannot match.
+                if (filterByTime) {
+                    const int64_t MIN = static_cast<int64_t>(T.m_blocks[block].m_minimum);
+                    const int64_t MAX = static_cast<int64_t>(T.m_blocks[block].m_maximum);
+                    if ( (MAX < from) || (MIN > to) ) {
+                        continue;
+                    }
+                }
+                else {
+                    const double MIN = ColumnarFormat::toDouble(V.m_type, V.m_blocks[block].m_minimum);
+                    const double MAX = ColumnarFormat::toDouble(V.m_type, V.m_blocks[block].m_maximum);
+                    if ( (MAX < minimum) || (MIN > maximum) ) {
+                        continue;
+                    }
+                }
+
+                if (!readBlock(T, block, rawTimeStamps) || !readBlock(V, block, rawValues)) {
+                    retVal = false;
+                    break;
+                }
+
+                for (uint32_t row = 0; row < rawValues.size(); row++) {
+                    const int64_t TIMESTAMP = static_cast<int64_t>(rawTimeStamps[row]);
+                    const double VALUE = ColumnarFormat::toDouble(V.m_type, rawValues[row]);
+                    const bool MATCHES = filterByTime ? ( (from <= TIMESTAMP) && (TIMESTAMP <= to) )
+                                                      : ( (minimum <= VALUE) && (VALUE <= maximum) );
+                    if (MATCHES) {
+                        timeStamps.push_back(TIMESTAMP);
+                        values.push_back(VALUE);
+                    }
+                }
+            }
+
+            return retVal;
+        }
+
+    } // columnar
+} // odtools
@@ -0,0 +1,187 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <iostream>
+#include <sstream>
+
+#include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/data/TimeStamp.h"
+#include "opendavinci/odcore/reflection/Message.h"
+#include "opendavinci/odtools/columnar/ColumnarFromVisitableVisitor.h"
+#include "opendavinci/odtools/columnar/ColumnarWriter.h"
+
+namespace odtools {
+    namespace columnar {
+
+        using namespace std;
+        using namespace odcore::data;
+        using namespace odcore::reflection;
+
+        ColumnarWriter::TableBuffer::TableBuffer() :
+            m_table(),
+            m_values() {}
+
+        ////////////////////////////////////////////////////////////////////////
+
+        ColumnarWriter::ColumnarWriter(const string &filename) :
+            m_out(),
+            m_closed(false),
+            m_tables() {
+            m_out.open(filename.c_str(), ios_base::out|ios_base::binary|ios_base::trunc);
+            if (m_out.good()) {
+                m_out.write(ColumnarFormat::MAGIC, ColumnarFormat::MAGIC_SIZE);
+            }
+            else {
+                cerr << "[odtools::columnar::ColumnarWriter] Could not create " << filename << "." << endl;
+            }
+        }
+
+        ColumnarWriter::~ColumnarWriter() {
+            close();
+        }
+
+        bool ColumnarWriter::isGood() const {
+            return m_out.good();
+        }
+
+        void ColumnarWriter::append(Container &c, Message &msg) {
+            if (m_closed) {
+                return;
+            }
+
+            ColumnarFromVisitableVisitor visitor;
+            msg.accept(visitor);
+            const vector<ColumnValue> &VALUES = visitor.getValues();
+
+            stringstream sstrKey;
+            sstrKey << c.getDataType() << "/" << c.getSenderStamp();
+            const string KEY = sstrKey.str();
+
+            TableBuffer &tb = m_tables[KEY];
+            if (tb.m_table.m_columns.empty()) {
+                tb.m_table.m_name = msg.getLongName();
+                tb.m_table.m_dataType = c.getDataType();
+                tb.m_table.m_senderStamp = c.getSenderStamp();
+
+                // The Container's time stamps in microseconds are the first columns of every table.
+                const string TIMESTAMPS[] = { ColumnarFormat::SENT_TIMESTAMP, ColumnarFormat::RECEIVED_TIMESTAMP, ColumnarFormat::SAMPLE_TIMESTAMP };
+                for (auto name : TIMESTAMPS) {
+                    Column column;
+                    column.m_name = name;
+                    column.m_type = ColumnarFormat::INTEGER;
+                    tb.m_table.m_columns.push_back(column);
+                }
+                // Fields named like a time stamp column are dropped in favour of the Container's time stamps.
+                for (auto &v : VALUES) {
+                    if (tb.m_table.findColumn(v.m_name) < 0) {
+                        Column column;
+                        column.m_name = v.m_name;
+                        column.m_type = v.m_type;
+                        tb.m_table.m_columns.push_back(column);
+                    }
+                }
+                tb.m_values.resize(tb.m_table.m_columns.size());
+            }
+
+            // Fields missing in this Message are stored as 0; fields unknown to the table are dropped.
+            const uint32_t ROW = tb.m_values[0].size();
+            for (auto &column : tb.m_values) {
+                column.push_back(0);
+            }
+            tb.m_values[0][ROW] = static_cast<uint64_t>(c.getSentTimeStamp().toMicroseconds());
+            tb.m_values[1][ROW] = static_cast<uint64_t>(c.getReceivedTimeStamp().toMicroseconds());
+            tb.m_values[2][ROW] = static_cast<uint64_t>(c.getSampleTimeStamp().toMicroseconds());
+            uint32_t nextColumn = 3;
+            for (auto &v : VALUES) {
+                // Usually, the fields are visited in the same order as the columns were created.
+                const int32_t INDEX = ( (nextColumn < tb.m_table.m_columns.size()) && (tb.m_table.m_columns[nextColumn].m_name == v.m_name) ) ? static_cast<int32_t>(nextColumn) : tb.m_table.findColumn(v.m_name);
+                if (INDEX >= 0) {
+                    nextColumn = INDEX + 1;
+                    if (tb.m_table.m_columns[INDEX].m_type == v.m_type) {
+                        tb.m_values[INDEX][ROW] = v.m_value;
+                    }
+                }
+            }
+
+            if (tb.m_values[0].size() >= ColumnarFormat::ROWS_PER_BLOCK) {
+                flush(tb);
+            }
+        }
+
+        void ColumnarWriter::flush(TableBuffer &tb) {
+            const uint32_t NUMBER_OF_ROWS = (tb.m_values.empty() ? 0 : tb.m_values[0].size());
+            if (0 == NUMBER_OF_ROWS) {
+                return;
+            }
+
+            for (uint32_t i = 0; i < tb.m_table.m_columns.size(); i++) {
+                Column &column = tb.m_table.m_columns[i];
+                vector<uint64_t> &values = tb.m_values[i];
+
+                ColumnBlock block;
+                block.m_firstRow = tb.m_table.m_numberOfRows;
+                block.m_numberOfRows = NUMBER_OF_ROWS;
+                block.m_minimum = block.m_maximum = values[0];
+                for (auto v : values) {
+                    if (ColumnarFormat::isLess(column.m_type, v, block.m_minimum)) {
+                        block.m_minimum = v;
+                    }
+                    if (ColumnarFormat::isLess(column.m_type, block.m_maximum, v)) {
+                        block.m_maximum = v;
+                    }
+                }
+
+                const string DATA = ColumnarFormat::encodeBlock(column.m_type, values);
+                block.m_offset = m_out.tellp();
+                block.m_compressedSize = DATA.size();
+                m_out.write(DATA.c_str(), DATA.size());
+                column.m_blocks.push_back(block);
+
+                values.clear();
+            }
+            tb.m_table.m_numberOfRows += NUMBER_OF_ROWS;
+        }
+
+        bool ColumnarWriter::close() {
+            if (m_closed) {
+                return m_out.good();
+            }
+            m_closed = true;
+
+            vector<Table> tables;
+            for (auto &entry : m_tables) {
+                flush(entry.second);
+                tables.push_back(entry.second.m_table);
+            }
+            m_tables.clear();
+
+            // Trailer: offset of the directory followed by the magic number.
+            const uint64_t DIRECTORY_OFFSET = htole64(static_cast<uint64_t>(m_out.tellp()));
+            ColumnarFormat::writeDirectory(m_out, tables);
+            m_out.write(reinterpret_cast<const char*>(&DIRECTORY_OFFSET), sizeof(uint64_t));
+            m_out.write(ColumnarFormat::MAGIC, ColumnarFormat::MAGIC_SIZE);
+            m_out.flush();
+
+            const bool RETVAL = m_out.good();
+            m_out.close();
+            return RETVAL;
+        }
+
+    } // columnar
+} // odtools
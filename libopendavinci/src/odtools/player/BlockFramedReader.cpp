@@ -0,0 +1,213 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Lock.h"
+#include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/wrapper/zlib/Zlib.h"
+#include "opendavinci/odtools/player/BlockFramedReader.h"
+
+namespace odtools {
+    namespace player {
+
+        using namespace std;
+        using namespace odcore::base;
+        using namespace odcore::data;
+        using namespace odtools::recorder;
+
+        BlockFramedReader::BlockFramedReader(const string &filename, const uint32_t &numberOfBlocksToReadAhead) :
+            m_filename(filename),
+            m_numberOfBlocksToReadAhead(numberOfBlocksToReadAhead),
+            m_valid(false),
+            m_headers(),
+            m_blockOffsets(),
+            m_blocksMutex(),
+            m_blocks(),
+            m_leastRecentlyUsedBlocks(),
+            m_numberOfDecompressedBlocks(0) {
+            // Only read the headers and skip the compressed payload.
+            ifstream in(m_filename.c_str(), ios_base::in|ios_base::binary);
+            m_valid = in.good();
+            while (in.good() && (EOF != in.peek())) {
+                BlockFrameHeader header;
+                if (!header.read(in)) {
+                    cerr << "[odtools::player::BlockFramedReader]: Invalid block header in " << m_filename << " after " << m_headers.size() << " blocks." << endl;
+                    m_valid = false;
+                    break;
+                }
+                m_blockOffsets.push_back(in.tellg());
+                m_headers.push_back(header);
+                in.seekg(header.m_compressedSize, ios_base::cur);
+            }
+        }
+
+        BlockFramedReader::~BlockFramedReader() {
+            reset();
+        }
+
+        bool BlockFramedReader::isValid() const {
+            return m_valid;
+        }
+
+        const vector<BlockFrameHeader>& BlockFramedReader::getHeaders() const {
+            return m_headers;
+        }
+
+        uint32_t BlockFramedReader::getNumberOfContainers() const {
+            uint32_t numberOfContainers = 0;
+            for (auto &h : m_headers) {
+                numberOfContainers += h.m_numberOfContainers;
+            }
+            return numberOfContainers;
+        }
+
+        uint32_t BlockFramedReader::getNumberOfDecompressedBlocks() const {
+            Lock l(m_blocksMutex);
+            return m_numberOfDecompressedBlocks;
+        }
+
+        uint32_t BlockFramedReader::getNumberOfCachedBlocks() const {
+            Lock l(m_blocksMutex);
+            return m_blocks.size();
+        }
+
+        std::shared_ptr<stringstream> BlockFramedReader::decompress(const uint32_t &block) {
+            std::shared_ptr<stringstream> retVal;
+            if (block < m_headers.size()) {
+                ifstream in(m_filename.c_str(), ios_base::in|ios_base::binary);
+                in.seekg(m_blockOffsets[block]);
+
+                string compressed(m_headers[block].m_compressedSize, '\0');
+                if (!compressed.empty()) {
+                    in.read(&compressed[0], compressed.size());
+                }
+
+                string uncompressed = odcore::wrapper::zlib::Zlib::decompress(compressed);
+                if (in.good() && (uncompressed.size() == m_headers[block].m_uncompressedSize)) {
+                    retVal = std::make_shared<stringstream>(uncompressed);
+
+                    Lock l(m_blocksMutex);
+                    m_numberOfDecompressedBlocks++;
+                }
+                else {
+                    cerr << "[odtools::player::BlockFramedReader]: Failed to decompress block " << block << " from " << m_filename << "." << endl;
+                }
+            }
+            return retVal;
+        }
+
+        std::shared_ptr<stringstream> BlockFramedReader::getBlock(const uint32_t &block) {
+            // Discarded blocks are destroyed outside the lock as their
+            // destructor waits for any pending decompression.
+            vector<std::shared_future<std::shared_ptr<stringstream> > > discardedBlocks;
+            std::shared_future<std::shared_ptr<stringstream> > retVal;
+            {
+                Lock l(m_blocksMutex);
+
+                // Decompress the requested block and the following ones in the
+                // background; the requested block is the most recently used one.
+                const uint32_t LAST = std::min<uint32_t>(m_headers.size() - 1, block + m_numberOfBlocksToReadAhead);
+                for (uint32_t i = LAST + 1; i-- > block;) {
+                    if (m_blocks.find(i) == m_blocks.end()) {
+                        m_blocks[i] = std::async(std::launch::async, &BlockFramedReader::decompress, this, i).share();
+                    }
+                    else {
+                        m_leastRecentlyUsedBlocks.remove(i);
+                    }
+                    m_leastRecentlyUsedBlocks.push_front(i);
+                }
+
+                // Keep the read-ahead window plus the current and the previous
+                // block as sample time stamps might slightly overlap.
+                while (m_blocks.size() > (m_numberOfBlocksToReadAhead + 2)) {
+                    const uint32_t LEAST_RECENTLY_USED = m_leastRecentlyUsedBlocks.back();
+                    m_leastRecentlyUsedBlocks.pop_back();
+                    discardedBlocks.push_back(m_blocks[LEAST_RECENTLY_USED]);
+                    m_blocks.erase(LEAST_RECENTLY_USED);
+                }
+
+                retVal = m_blocks[block];
+            }
+
+            return retVal.get();
+        }
+
+        bool BlockFramedReader::index(const uint32_t &block, std::function<void(const Container &, const uint64_t &)> f) {
+            if (block >= m_headers.size()) {
+                return false;
+            }
+
+            std::shared_ptr<stringstream> in = getBlock(block);
+            if (!in.get()) {
+                return false;
+            }
+
+            // Only the Player's thread is reading Containers from a block.
+            in->clear();
+            in->seekg(0);
+            while (in->good() && (EOF != in->peek())) {
+                const uint64_t POSITION = (static_cast<uint64_t>(block) << 32) | static_cast<uint64_t>(in->tellg());
+                Container c;
+                *in >> c;
+                if (!in->fail()) {
+                    f(c, POSITION);
+                }
+            }
+            return true;
+        }
+
+        bool BlockFramedReader::read(const uint64_t &position, Container &c) {
+            const uint32_t BLOCK = static_cast<uint32_t>(position >> 32);
+            const uint32_t OFFSET = static_cast<uint32_t>(position & 0xFFFFFFFF);
+            if (BLOCK >= m_headers.size()) {
+                return false;
+            }
+
+            std::shared_ptr<stringstream> in = getBlock(BLOCK);
+            if (!in.get()) {
+                return false;
+            }
+
+            // Only the Player's thread is reading Containers from a block.
+            in->clear();
+            in->seekg(OFFSET);
+            *in >> c;
+            return !in->fail();
+        }
+
+        void BlockFramedReader::reset() {
+            map<uint32_t, std::shared_future<std::shared_ptr<stringstream> > > blocks;
+            {
+                Lock l(m_blocksMutex);
+                blocks.swap(m_blocks);
+                m_leastRecentlyUsedBlocks.clear();
+            }
+
+            // Wait for pending decompressions outside the lock.
+            for (auto &b : blocks) {
+                b.second.wait();
+            }
+        }
+
+    } // player
+} // tools
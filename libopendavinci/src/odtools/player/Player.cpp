@@ -31,7 +31,9 @@
 #include <opendavinci/odcore/base/Lock.h>
 #include <opendavinci/odcore/base/Thread.h>
 #include <opendavinci/odcore/io/URL.h>
+#include <opendavinci/odtools/recorder/BlockFrameHeader.h>
 
+#include <opendavinci/odtools/player/BlockFramedReader.h>
 #include <opendavinci/odtools/player/Player.h>
 #include <opendavinci/odtools/player/PlayerDelegate.h>
 #include <opendavinci/odtools/player/RecMemIndex.h>
@@ -65,6 +67,9 @@ namespace odtools {
             m_url(url),
             m_recFile(),
             m_recFileValid(false),
+            m_blockFramedReader(),
+            m_blocksToIndex(),
+            m_numberOfIndexedBlocks(0),
             m_autoRewind(autoRewind),
             m_indexMutex(),
             m_index(),
@@ -125,6 +130,7 @@ namespace odtools {
             // Free the map of cached container entries.
             m_recMemIndex.reset();
 
+            m_blockFramedReader.reset();
             m_recFile.close();
         }
 
@@ -152,6 +158,11 @@ namespace odtools {
         ////////////////////////////////////////////////////////////////////////
 
         void Player::initializeIndex() {
+            if (odtools::recorder::BlockFrameHeader::isBlockFramed(m_url.getResource())) {
+                initializeIndexFromBlockFramedFile();
+                return;
+            }
+
             m_recFile.open(m_url.getResource().c_str(), ios_base::in|ios_base::binary);
             m_recFileValid = m_recFile.good();
 
@@ -198,6 +209,71 @@ namespace odtools {
             }
         }
 
+        void Player::initializeIndexFromBlockFramedFile() {
+            m_blockFramedReader = unique_ptr<BlockFramedReader>(new BlockFramedReader(m_url.getResource(), std::max<uint32_t>(1, std::thread::hardware_concurrency())));
+            m_recFileValid = m_blockFramedReader->isValid();
+
+            // The blocks are indexed in the order of their first sample time stamps.
+            const vector<odtools::recorder::BlockFrameHeader> &HEADERS = m_blockFramedReader->getHeaders();
+            m_blocksToIndex.clear();
+            for (uint32_t i = 0; i < HEADERS.size(); i++) {
+                m_blocksToIndex.push_back(i);
+            }
+            std::stable_sort(m_blocksToIndex.begin(), m_blocksToIndex.end(), [&HEADERS](const uint32_t &a, const uint32_t &b) {
+                return HEADERS[a].m_firstSampleTimeStamp < HEADERS[b].m_firstSampleTimeStamp;
+            });
+            m_numberOfIndexedBlocks = 0;
+
+            // Only the blocks needed for the first entry are decompressed now.
+            const TimeStamp BEFORE;
+            indexBlocksFollowing(m_index.end());
+            const TimeStamp AFTER;
+
+            if (m_recFileValid) {
+                clog << "[odtools::player::Player]: " << m_url.getResource()
+                                      << " contains " << m_blockFramedReader->getNumberOfContainers() << " entries in " << HEADERS.size() << " compressed blocks; "
+                                      << "indexed " << m_numberOfIndexedBlocks << " block(s) "
+                                      << "in " << (AFTER-BEFORE).toMicroseconds()/(1000.0*1000.0) << "s." << endl;
+            }
+        }
+
+        void Player::indexBlock(const uint32_t &block) {
+            // Decompress and read the block outside of the lock.
+            vector<pair<int64_t, uint64_t> > entries;
+            m_blockFramedReader->index(block, [&entries](const Container &c, const uint64_t &position) {
+                entries.push_back(std::make_pair(c.getSampleTimeStamp().toMicroseconds(), position));
+            });
+
+            Lock l(m_indexMutex);
+            for (auto &e : entries) {
+                m_index.emplace(std::make_pair(e.first, IndexEntry(e.first, e.second)));
+            }
+        }
+
+        void Player::indexBlocksFollowing(const multimap<int64_t, IndexEntry>::iterator &entry) {
+            // Only this thread is modifying the index; thus, reading it does not need the lock.
+            const vector<odtools::recorder::BlockFrameHeader> &HEADERS = m_blockFramedReader->getHeaders();
+            while (m_numberOfIndexedBlocks < m_blocksToIndex.size()) {
+                multimap<int64_t, IndexEntry>::iterator next = entry;
+                if (next == m_index.end()) {
+                    next = m_index.begin();
+                }
+                else {
+                    next++;
+                }
+
+                // All Containers of a block are sampled at or after its first sample time stamp.
+                const int64_t NEXT_SAMPLE_TIMESTAMP = (next == m_index.end()) ? numeric_limits<int64_t>::max() : next->first;
+                const uint32_t BLOCK = m_blocksToIndex[m_numberOfIndexedBlocks];
+                if (HEADERS[BLOCK].m_firstSampleTimeStamp > NEXT_SAMPLE_TIMESTAMP) {
+                    break;
+                }
+
+                m_numberOfIndexedBlocks++;
+                indexBlock(BLOCK);
+            }
+        }
+
         void Player::resetCaches() {
             Lock l(m_indexMutex);
             m_delay = m_correctedDelay = 0;
@@ -216,15 +292,27 @@ namespace odtools {
         }
 
         void Player::computeInitialCacheLevelAndFillCache() {
-            if (m_recFileValid && (m_index.size() > 0) ) {
+            const uint32_t NUMBER_OF_ENTRIES = getTotalNumberOfContainersInRecFile();
+            if (m_recFileValid && (NUMBER_OF_ENTRIES > 0) ) {
                 int64_t smallestSampleTimePoint = numeric_limits<int64_t>::max();
                 int64_t largestSampleTimePoint = numeric_limits<int64_t>::min();
-                for (auto it = m_index.begin(); it != m_index.end(); it++) {
-                    smallestSampleTimePoint = std::min(smallestSampleTimePoint, it->first);
-                    largestSampleTimePoint = std::max(largestSampleTimePoint, it->first);
+                if (NULL != m_blockFramedReader.get()) {
+                    // The block headers provide the time range without indexing all blocks.
+                    for (auto &h : m_blockFramedReader->getHeaders()) {
+                        if (h.m_numberOfContainers > 0) {
+                            smallestSampleTimePoint = std::min(smallestSampleTimePoint, h.m_firstSampleTimeStamp);
+                            largestSampleTimePoint = std::max(largestSampleTimePoint, h.m_lastSampleTimeStamp);
+                        }
+                    }
+                }
+                else {
+                    for (auto it = m_index.begin(); it != m_index.end(); it++) {
+                        smallestSampleTimePoint = std::min(smallestSampleTimePoint, it->first);
+                        largestSampleTimePoint = std::max(largestSampleTimePoint, it->first);
+                    }
                 }
 
-                const uint32_t ENTRIES_TO_READ_PER_SECOND_FOR_REALTIME_REPLAY = std::ceil(m_index.size()*(static_cast<float>(Player::ONE_SECOND_IN_MICROSECONDS))/(largestSampleTimePoint - smallestSampleTimePoint));
+                const uint32_t ENTRIES_TO_READ_PER_SECOND_FOR_REALTIME_REPLAY = std::ceil(NUMBER_OF_ENTRIES*(static_cast<float>(Player::ONE_SECOND_IN_MICROSECONDS))/(largestSampleTimePoint - smallestSampleTimePoint));
                 m_desiredInitialLevel = std::max<uint32_t>(ENTRIES_TO_READ_PER_SECOND_FOR_REALTIME_REPLAY * Player::LOOK_AHEAD_IN_S,
                                                            MIN_ENTRIES_FOR_LOOK_AHEAD);
 
@@ -244,12 +332,18 @@ namespace odtools {
 
                 while ( (m_nextEntryToReadFromRecFile != m_index.end())
                      && (entriesReadFromFile < maxNumberOfEntriesToReadFromFile) ) {
-                    // Move to corresponding position in the .rec file.
-                    m_recFile.seekg(m_nextEntryToReadFromRecFile->second.m_filePosition);
-
-                    // Read the corresponding container.
                     Container c;
-                    m_recFile >> c;
+                    if (NULL != m_blockFramedReader.get()) {
+                        // Read the container from its (decompressed) block.
+                        m_blockFramedReader->read(m_nextEntryToReadFromRecFile->second.m_filePosition, c);
+                    }
+                    else {
+                        // Move to corresponding position in the .rec file.
+                        m_recFile.seekg(m_nextEntryToReadFromRecFile->second.m_filePosition);
+
+                        // Read the corresponding container.
+                        m_recFile >> c;
+                    }
 
                     // Store the container in the container cache.
                     {
@@ -257,6 +351,11 @@ namespace odtools {
                         m_nextEntryToReadFromRecFile->second.m_available = m_containerCache.emplace(std::make_pair(m_nextEntryToReadFromRecFile->second.m_filePosition, c)).second;
                     }
 
+                    if (NULL != m_blockFramedReader.get()) {
+                        // Make sure that the entry following this one is in the index.
+                        indexBlocksFollowing(m_nextEntryToReadFromRecFile);
+                    }
+
                     m_nextEntryToReadFromRecFile++;
                     entriesReadFromFile++;
                 }
@@ -382,6 +481,11 @@ namespace odtools {
         ////////////////////////////////////////////////////////////////////////
 
         uint32_t Player::getTotalNumberOfContainersInRecFile() const {
+            if (NULL != m_blockFramedReader.get()) {
+                // The index of a block-framed .rec file is only complete when all blocks were replayed.
+                return m_blockFramedReader->getNumberOfContainers();
+            }
+
             Lock l(m_indexMutex);
             return m_index.size();
         }
@@ -405,6 +509,11 @@ namespace odtools {
                 m_containerCacheFillingThread.join();
             }
 
+            // Discard decompressed blocks from the end of the file.
+            if (NULL != m_blockFramedReader.get()) {
+                m_blockFramedReader->reset();
+            }
+
             computeInitialCacheLevelAndFillCache();
 
             if (m_threading) {
@@ -452,11 +561,7 @@ namespace odtools {
             uint8_t statisticsCounter = 0;
             float refillMultiplicator = 1.1;
             uint32_t numberOfEntries = 0;
-            uint32_t numberOfEntriesInIndex = 0;
-            {
-                Lock l(m_indexMutex);
-                numberOfEntriesInIndex = m_index.size();
-            }
+            const uint32_t numberOfEntriesInIndex = getTotalNumberOfContainersInRecFile();
 
             while (isContainerCacheFillingRunning()) {
                 {
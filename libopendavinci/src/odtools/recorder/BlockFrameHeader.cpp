@@ -0,0 +1,116 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <ostream>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odtools/recorder/BlockFrameHeader.h"
+
+namespace odtools {
+    namespace recorder {
+
+        using namespace std;
+
+        const char BlockFrameHeader::MAGIC[BlockFrameHeader::MAGIC_SIZE + 1] = "ODZB";
+
+        BlockFrameHeader::BlockFrameHeader() :
+            m_compressedSize(0),
+            m_uncompressedSize(0),
+            m_numberOfContainers(0),
+            m_firstSampleTimeStamp(numeric_limits<int64_t>::max()),
+            m_lastSampleTimeStamp(numeric_limits<int64_t>::min()),
+            m_dataTypes() {}
+
+        bool BlockFrameHeader::isBlockFramed(const string &filename) {
+            char magic[MAGIC_SIZE];
+            ifstream in(filename.c_str(), ios_base::in|ios_base::binary);
+            in.read(magic, MAGIC_SIZE);
+            return (in.gcount() == MAGIC_SIZE) && (0 == memcmp(magic, MAGIC, MAGIC_SIZE));
+        }
+
+        void BlockFrameHeader::add(const int64_t &sampleTimeStamp, const int32_t &dataType) {
+            m_numberOfContainers++;
+            m_firstSampleTimeStamp = std::min(m_firstSampleTimeStamp, sampleTimeStamp);
+            m_lastSampleTimeStamp = std::max(m_lastSampleTimeStamp, sampleTimeStamp);
+
+            auto it = std::lower_bound(m_dataTypes.begin(), m_dataTypes.end(), dataType);
+            if ( (it == m_dataTypes.end()) || (*it != dataType) ) {
+                m_dataTypes.insert(it, dataType);
+            }
+        }
+
+        void BlockFrameHeader::write(ostream &out) const {
+            const uint32_t COMPRESSED_SIZE = htole32(m_compressedSize);
+            const uint32_t UNCOMPRESSED_SIZE = htole32(m_uncompressedSize);
+            const uint32_t NUMBER_OF_CONTAINERS = htole32(m_numberOfContainers);
+            const int64_t FIRST = htole64(m_firstSampleTimeStamp);
+            const int64_t LAST = htole64(m_lastSampleTimeStamp);
+            const uint32_t NUMBER_OF_DATATYPES = htole32(static_cast<uint32_t>(m_dataTypes.size()));
+
+            out.write(MAGIC, MAGIC_SIZE);
+            out.write(reinterpret_cast<const char*>(&COMPRESSED_SIZE), sizeof(uint32_t));
+            out.write(reinterpret_cast<const char*>(&UNCOMPRESSED_SIZE), sizeof(uint32_t));
+            out.write(reinterpret_cast<const char*>(&NUMBER_OF_CONTAINERS), sizeof(uint32_t));
+            out.write(reinterpret_cast<const char*>(&FIRST), sizeof(int64_t));
+            out.write(reinterpret_cast<const char*>(&LAST), sizeof(int64_t));
+            out.write(reinterpret_cast<const char*>(&NUMBER_OF_DATATYPES), sizeof(uint32_t));
+            for (auto dataType : m_dataTypes) {
+                const int32_t DATATYPE = htole32(dataType);
+                out.write(reinterpret_cast<const char*>(&DATATYPE), sizeof(int32_t));
+            }
+        }
+
+        bool BlockFrameHeader::read(istream &in) {
+            char magic[MAGIC_SIZE];
+            in.read(magic, MAGIC_SIZE);
+            if ( (in.gcount() != MAGIC_SIZE) || (0 != memcmp(magic, MAGIC, MAGIC_SIZE)) ) {
+                return false;
+            }
+
+            uint32_t numberOfDataTypes = 0;
+            in.read(reinterpret_cast<char*>(&m_compressedSize), sizeof(uint32_t));
+            in.read(reinterpret_cast<char*>(&m_uncompressedSize), sizeof(uint32_t));
+            in.read(reinterpret_cast<char*>(&m_numberOfContainers), sizeof(uint32_t));
+            in.read(reinterpret_cast<char*>(&m_firstSampleTimeStamp), sizeof(int64_t));
+            in.read(reinterpret_cast<char*>(&m_lastSampleTimeStamp), sizeof(int64_t));
+            in.read(reinterpret_cast<char*>(&numberOfDataTypes), sizeof(uint32_t));
+            m_compressedSize = le32toh(m_compressedSize);
+            m_uncompressedSize = le32toh(m_uncompressedSize);
+            m_numberOfContainers = le32toh(m_numberOfContainers);
+            m_firstSampleTimeStamp = le64toh(m_firstSampleTimeStamp);
+            m_lastSampleTimeStamp = le64toh(m_lastSampleTimeStamp);
+            numberOfDataTypes = le32toh(numberOfDataTypes);
+
+            m_dataTypes.clear();
+            for (uint32_t i = 0; (i < numberOfDataTypes) && in.good(); i++) {
+                int32_t dataType = 0;
+                in.read(reinterpret_cast<char*>(&dataType), sizeof(int32_t));
+                m_dataTypes.push_back(le32toh(dataType));
+            }
+
+            return in.good();
+        }
+
+    } // recorder
+} // tools
@@ -0,0 +1,112 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/wrapper/zlib/Zlib.h"
+#include "opendavinci/odtools/recorder/BlockFramedWriter.h"
+
+namespace odtools {
+    namespace recorder {
+
+        using namespace std;
+        using namespace odcore::data;
+
+        BlockFramedWriter::BlockFramedWriter(std::shared_ptr<ostream> out, const uint32_t &blockSize, const uint32_t &numberOfCompressionThreads) :
+            m_out(out),
+            m_blockSize((blockSize > 0) ? blockSize : static_cast<uint32_t>(BlockFrameHeader::DEFAULT_BLOCK_SIZE)),
+            m_numberOfCompressionThreads((numberOfCompressionThreads > 0) ? numberOfCompressionThreads : 1),
+            m_block(),
+            m_header(),
+            m_pendingBlocks() {}
+
+        BlockFramedWriter::~BlockFramedWriter() {
+            flush();
+        }
+
+        void BlockFramedWriter::write(const Container &c) {
+            stringstream sstr;
+            sstr << c;
+            m_block += sstr.str();
+            m_header.add(c.getSampleTimeStamp().toMicroseconds(), c.getDataType());
+
+            if (m_block.size() >= m_blockSize) {
+                compressCurrentBlock();
+            }
+
+            // Write finished blocks without waiting unless too many blocks are pending.
+            writeCompressedBlocks(m_numberOfCompressionThreads);
+        }
+
+        void BlockFramedWriter::flush() {
+            compressCurrentBlock();
+            writeCompressedBlocks(0);
+            if (m_out.get()) {
+                m_out->flush();
+            }
+        }
+
+        void BlockFramedWriter::compressCurrentBlock() {
+            if (m_block.empty()) {
+                return;
+            }
+
+            string block;
+            block.swap(m_block);
+            m_pendingBlocks.push_back(std::async(std::launch::async, &BlockFramedWriter::compressBlock, m_header, std::move(block)));
+            m_header = BlockFrameHeader();
+        }
+
+        void BlockFramedWriter::writeCompressedBlocks(const uint32_t &maximumNumberOfPendingBlocks) {
+            while (!m_pendingBlocks.empty()) {
+                const bool READY = (m_pendingBlocks.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+                if (!READY && (m_pendingBlocks.size() <= maximumNumberOfPendingBlocks)) {
+                    break;
+                }
+
+                const string BLOCK = m_pendingBlocks.front().get();
+                m_pendingBlocks.pop_front();
+                if (m_out.get()) {
+                    m_out->write(BLOCK.c_str(), BLOCK.size());
+                }
+            }
+        }
+
+        string BlockFramedWriter::compressBlock(BlockFrameHeader header, const string &block) {
+            const string COMPRESSED = odcore::wrapper::zlib::Zlib::compress(block);
+            if (COMPRESSED.empty()) {
+                cerr << "[odtools::recorder::BlockFramedWriter] Failed to compress block with " << header.m_numberOfContainers << " containers." << endl;
+                return "";
+            }
+
+            header.m_compressedSize = COMPRESSED.size();
+            header.m_uncompressedSize = block.size();
+
+            stringstream sstr;
+            header.write(sstr);
+            sstr.write(COMPRESSED.c_str(), COMPRESSED.size());
+            return sstr.str();
+        }
+
+    } // recorder
+} // tools
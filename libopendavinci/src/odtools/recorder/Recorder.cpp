@@ -18,6 +18,7 @@
  */
 
 #include <iostream>
+#include <thread>
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/base/Lock.h"
@@ -26,6 +27,7 @@
 #include "opendavinci/odcore/io/StreamFactory.h"
 #include "opendavinci/odcore/io/URL.h"
 #include "opendavinci/odcore/serialization/Serializable.h"
+#include "opendavinci/odtools/recorder/BlockFramedWriter.h"
 #include "opendavinci/odtools/recorder/Recorder.h"
 #include "opendavinci/odtools/recorder/RecorderDelegate.h"
 #include "opendavinci/odtools/recorder/SharedDataListener.h"
@@ -41,9 +43,13 @@ namespace odtools {
         using namespace odcore::io;
 
         Recorder::Recorder(const string &url, const uint32_t &memorySegmentSize, const uint32_t &numberOfSegments, const bool &threading, const bool &dumpSharedData) :
+            Recorder(url, memorySegmentSize, numberOfSegments, threading, dumpSharedData, 0) {}
+
+        Recorder::Recorder(const string &url, const uint32_t &memorySegmentSize, const uint32_t &numberOfSegments, const bool &threading, const bool &dumpSharedData, const uint32_t &compressionBlockSize) :
             m_fifo(),
             m_sharedDataListener(),
             m_out(NULL),
+            m_blockFramedWriter(),
             m_outSharedMemoryFile(NULL),
             m_dumpSharedData(dumpSharedData),
             m_mapOfRecorderDelegatesMutex(),
@@ -53,6 +59,11 @@ namespace odtools {
             URL _url(url);
             m_out = StreamFactory::getInstance().getOutputStream(_url);
 
+            // Compress containers in blocks using one background thread per core.
+            if ( (compressionBlockSize > 0) && (m_out.get()) ) {
+                m_blockFramedWriter = unique_ptr<BlockFramedWriter>(new BlockFramedWriter(m_out, compressionBlockSize, std::thread::hardware_concurrency()));
+            }
+
             // Add a specific listener for SharedData type.
             URL urlSharedMemoryFile("file://" + _url.getResource() + ".mem");
             m_outSharedMemoryFile = StreamFactory::getInstance().getOutputStream(urlSharedMemoryFile);
@@ -73,6 +84,12 @@ namespace odtools {
                     m_mapOfRecorderDelegates.clear();
                 }
 
+                // Compress and write the last incomplete block.
+                if (m_blockFramedWriter.get()) {
+                    m_blockFramedWriter->flush();
+                    m_blockFramedWriter.reset();
+                }
+
                 // Flush the file's content.
                 if (m_out.get()) {
                     m_out->flush();
@@ -150,9 +167,7 @@ namespace odtools {
                         auto delegate = m_mapOfRecorderDelegates.find(c.getDataType());
                         if (delegate != m_mapOfRecorderDelegates.end()) {
                             Container replacementContainer = delegate->second->process(c);
-                            if (m_out.get()) {
-                                (*m_out) << replacementContainer;
-                            }
+                            write(replacementContainer);
 
                             // Continue processing as a delegated RecorderDelegate has
                             // handled this Container.
@@ -166,17 +181,25 @@ namespace odtools {
                          (c.getDataType() != odcore::data::SharedData::ID())  &&
                          (c.getDataType() != odcore::data::SharedPointCloud::ID())  &&
                          (c.getDataType() != odcore::data::image::SharedImage::ID()) ) {
-                        if (m_out.get()) {
-                            (*m_out) << c;
-                        }
+                        write(c);
                     }
                 }
 
-                if (m_out.get()) {
+                // Compressed blocks are written once they are complete.
+                if ( (m_out.get()) && (!m_blockFramedWriter.get()) ) {
                     m_out->flush();
                 }
             }
         }
 
+        void Recorder::write(const Container &c) {
+            if (m_blockFramedWriter.get()) {
+                m_blockFramedWriter->write(c);
+            }
+            else if (m_out.get()) {
+                (*m_out) << c;
+            }
+        }
+
     } // recorder
 } // tools
@@ -196,6 +196,91 @@ class AbstractCIDModuleTest : public CxxTest::TestSuite {
             delete[] argv;
         }
 
+        void testAbstractCIDModuleOverrunPolicy() {
+            string argv0("ConferenceClientModuleTestModule");
+            string argv1("--cid=10");
+            string argv2("--overrun=burst");
+            string argv3("--busywait=50");
+            int32_t argc = 4;
+            char **argv;
+            argv = new char*[4];
+            argv[0] = const_cast<char*>(argv0.c_str());
+            argv[1] = const_cast<char*>(argv1.c_str());
+            argv[2] = const_cast<char*>(argv2.c_str());
+            argv[3] = const_cast<char*>(argv3.c_str());
+
+            AbstractCIDModuleTestConcreteModule amtcm(argc, argv);
+            TS_ASSERT(amtcm.getOverrunPolicy() == DeadlineScheduler::BURST);
+            TS_ASSERT(amtcm.getBusyWait() == 50);
+
+            AbstractCIDModuleTestConcreteModule amtcm2(2, argv);
+            TS_ASSERT(amtcm2.getOverrunPolicy() == DeadlineScheduler::STRETCH);
+            TS_ASSERT(amtcm2.getBusyWait() == 0);
+
+            // Clean up created modules.
+            AbstractCIDModule::getListOfModules().clear();
+            delete[] argv;
+        }
+
+        void testAbstractCIDModuleTelemetry() {
+            string argv0("ConferenceClientModuleTestModule");
+            string argv1("--cid=10");
+            string argv2("--telemetry=1");
+            int32_t argc = 3;
+            char **argv;
+            argv = new char*[3];
+            argv[0] = const_cast<char*>(argv0.c_str());
+            argv[1] = const_cast<char*>(argv1.c_str());
+            argv[2] = const_cast<char*>(argv2.c_str());
+
+            AbstractCIDModuleTestConcreteModule amtcm(argc, argv);
+            TS_ASSERT(amtcm.isTelemetry());
+
+            AbstractCIDModuleTestConcreteModule amtcm2(2, argv);
+            TS_ASSERT(!amtcm2.isTelemetry());
+            TS_ASSERT(!amtcm2.isSharedMemoryTransport());
+
+            string argv4("--telemetry=0");
+            argv[2] = const_cast<char*>(argv4.c_str());
+            AbstractCIDModuleTestConcreteModule amtcm4(argc, argv);
+            TS_ASSERT(!amtcm4.isTelemetry());
+
+            string argv3("--shm=1");
+            argv[2] = const_cast<char*>(argv3.c_str());
+            AbstractCIDModuleTestConcreteModule amtcm3(argc, argv);
+            TS_ASSERT(amtcm3.isSharedMemoryTransport());
+            TS_ASSERT(!amtcm3.isTelemetry());
+
+            // Clean up created modules.
+            AbstractCIDModule::getListOfModules().clear();
+            delete[] argv;
+        }
+
+        void testAbstractCIDModuleWrongOverrunPolicy() {
+            string argv0("ConferenceClientModuleTestModule");
+            string argv1("--cid=10");
+            string argv2("--overrun=wait");
+            int32_t argc = 3;
+            char **argv;
+            argv = new char*[3];
+            argv[0] = const_cast<char*>(argv0.c_str());
+            argv[1] = const_cast<char*>(argv1.c_str());
+            argv[2] = const_cast<char*>(argv2.c_str());
+
+            bool failed = true;
+            try {
+                AbstractCIDModuleTestConcreteModule amtcm(argc, argv);
+            } catch (InvalidArgumentException &iae) {
+                TS_ASSERT(iae.getMessage() == "The overrun policy has to be one of skip, burst, or stretch.");
+                failed = false;
+            }
+            TS_ASSERT(!failed);
+
+            // Clean up created modules.
+            AbstractCIDModule::getListOfModules().clear();
+            delete[] argv;
+        }
+
         void testKillAbstractCIDModule() {
             string argv0("ConferenceClientModuleTestModule");
             string argv1("--id=ABD");
@@ -0,0 +1,139 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2008 - 2015 Christian Berger, Bernhard Rumpe
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CORE_BLOCKFRAMEDTESTSUITE_H_
+#define CORE_BLOCKFRAMEDTESTSUITE_H_
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cxxtest/TestSuite.h"          // for TS_ASSERT, TestSuite
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/data/TimeStamp.h"
+#include "opendavinci/odcore/io/URL.h"
+#include "opendavinci/odtools/player/BlockFramedReader.h"
+#include "opendavinci/odtools/player/Player.h"
+#include "opendavinci/odtools/recorder/BlockFrameHeader.h"
+#include "opendavinci/odtools/recorder/BlockFramedWriter.h"
+
+using namespace std;
+using namespace odcore::data;
+using namespace odtools::player;
+using namespace odtools::recorder;
+
+class BlockFramedTest : public CxxTest::TestSuite {
+    public:
+        enum {
+            NUMBER_OF_CONTAINERS = 5000,
+            BLOCK_SIZE = 16 * 1024,
+        };
+
+        void writeRecording(const string &filename) {
+            std::shared_ptr<ostream> out = std::make_shared<ofstream>(filename.c_str(), ios::out | ios::binary | ios::trunc);
+            BlockFramedWriter writer(out, BLOCK_SIZE, 4);
+            for (int32_t i = 0; i < NUMBER_OF_CONTAINERS; i++) {
+                TimeStamp ts(i, 0);
+                Container c(ts);
+                c.setSampleTimeStamp(ts);
+                writer.write(c);
+            }
+        }
+
+        void testBlockFramedWriterAndReader() {
+            const string FILENAME = "BlockFramedTestSuite.rec";
+            writeRecording(FILENAME);
+
+            TS_ASSERT(BlockFrameHeader::isBlockFramed(FILENAME));
+
+            BlockFramedReader reader(FILENAME, 2);
+            TS_ASSERT(reader.isValid());
+            TS_ASSERT(reader.getHeaders().size() > 2);
+
+            // Block headers cover consecutive time ranges of one data type.
+            uint32_t numberOfContainers = 0;
+            int64_t lastSampleTimeStamp = -1;
+            for (auto &h : reader.getHeaders()) {
+                TS_ASSERT(h.m_compressedSize < h.m_uncompressedSize);
+                TS_ASSERT(h.m_firstSampleTimeStamp > lastSampleTimeStamp);
+                TS_ASSERT_EQUALS(h.m_dataTypes.size(), 1u);
+                TS_ASSERT_EQUALS(h.m_dataTypes[0], TimeStamp::ID());
+                numberOfContainers += h.m_numberOfContainers;
+                lastSampleTimeStamp = h.m_lastSampleTimeStamp;
+            }
+            TS_ASSERT_EQUALS(numberOfContainers, static_cast<uint32_t>(NUMBER_OF_CONTAINERS));
+
+            // Opening the recording does not decompress any block.
+            TS_ASSERT_EQUALS(reader.getNumberOfDecompressedBlocks(), 0u);
+            TS_ASSERT_EQUALS(reader.getNumberOfContainers(), static_cast<uint32_t>(NUMBER_OF_CONTAINERS));
+
+            // Blocks are indexed one by one; only the read-ahead window, the current, and the previous block are kept.
+            vector<uint64_t> positions;
+            for (uint32_t block = 0; block < reader.getHeaders().size(); block++) {
+                TS_ASSERT(reader.index(block, [&positions](const Container &c, const uint64_t &position) {
+                    TS_ASSERT_EQUALS(c.getSampleTimeStamp().getSeconds(), static_cast<int32_t>(positions.size()));
+                    positions.push_back(position);
+                }));
+                TS_ASSERT(reader.getNumberOfCachedBlocks() <= 4u);
+            }
+            TS_ASSERT(!reader.index(reader.getHeaders().size(), [](const Container &, const uint64_t &) {}));
+            TS_ASSERT_EQUALS(positions.size(), static_cast<uint32_t>(NUMBER_OF_CONTAINERS));
+            reader.reset();
+            TS_ASSERT_EQUALS(reader.getNumberOfCachedBlocks(), 0u);
+
+            // Random access only decompresses the requested block and the read-ahead window.
+            const uint32_t DECOMPRESSED_BEFORE = reader.getNumberOfDecompressedBlocks();
+            Container c;
+            TS_ASSERT(reader.read(positions[NUMBER_OF_CONTAINERS - 1], c));
+            TS_ASSERT_EQUALS(c.getData<TimeStamp>().getSeconds(), NUMBER_OF_CONTAINERS - 1);
+            TS_ASSERT(reader.read(positions[0], c));
+            TS_ASSERT_EQUALS(c.getData<TimeStamp>().getSeconds(), 0);
+            reader.reset();
+            TS_ASSERT(reader.getNumberOfDecompressedBlocks() - DECOMPRESSED_BEFORE <= 4u);
+
+            UNLINK(FILENAME.c_str());
+        }
+
+        void testPlayerReplaysBlockFramedRecording() {
+            const string FILENAME = "BlockFramedTestSuite2.rec";
+            writeRecording(FILENAME);
+
+            {
+                odcore::io::URL url("file://" + FILENAME);
+                Player player(url, false, 0, 0, false);
+                TS_ASSERT_EQUALS(player.getTotalNumberOfContainersInRecFile(), static_cast<uint32_t>(NUMBER_OF_CONTAINERS));
+
+                int32_t i = 0;
+                while (player.hasMoreData()) {
+                    Container c = player.getNextContainerToBeSent();
+                    TS_ASSERT_EQUALS(c.getData<TimeStamp>().getSeconds(), i);
+                    i++;
+                }
+                TS_ASSERT_EQUALS(i, NUMBER_OF_CONTAINERS);
+            }
+
+            UNLINK(FILENAME.c_str());
+        }
+};
+
+#endif /*CORE_BLOCKFRAMEDTESTSUITE_H_*/
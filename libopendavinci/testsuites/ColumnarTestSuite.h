@@ -0,0 +1,144 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2008 - 2015 Christian Berger, Bernhard Rumpe
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CORE_COLUMNARTESTSUITE_H_
+#define CORE_COLUMNARTESTSUITE_H_
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cxxtest/TestSuite.h"          // for TS_ASSERT, TestSuite
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/data/TimeStamp.h"
+#include "opendavinci/odcore/reflection/Field.h"
+#include "opendavinci/odcore/reflection/Message.h"
+#include "opendavinci/odtools/columnar/ColumnarFormat.h"
+#include "opendavinci/odtools/columnar/ColumnarReader.h"
+#include "opendavinci/odtools/columnar/ColumnarWriter.h"
+#include "opendavinci/generated/odcore/data/reflection/AbstractField.h"
+
+using namespace std;
+using namespace odcore::data;
+using namespace odcore::reflection;
+using namespace odtools::columnar;
+
+class ColumnarTest : public CxxTest::TestSuite {
+    public:
+        Message createMessage(const int32_t &counter, const double &speed) {
+            Message msg;
+            msg.setLongName("Columnar.Test");
+            msg.setShortName("Test");
+
+            shared_ptr<Field<int32_t> > f1 = shared_ptr<Field<int32_t> >(new Field<int32_t>(counter));
+            f1->setFieldIdentifier(1);
+            f1->setLongFieldName("counter");
+            f1->setShortFieldName("counter");
+            f1->setFieldDataType(odcore::data::reflection::AbstractField::INT32_T);
+            f1->setSize(sizeof(int32_t));
+            msg.addField(f1);
+
+            shared_ptr<Field<double> > f2 = shared_ptr<Field<double> >(new Field<double>(speed));
+            f2->setFieldIdentifier(2);
+            f2->setLongFieldName("speed");
+            f2->setShortFieldName("speed");
+            f2->setFieldDataType(odcore::data::reflection::AbstractField::DOUBLE_T);
+            f2->setSize(sizeof(double));
+            msg.addField(f2);
+
+            return msg;
+        }
+
+        void testWriteAndQueryColumnarRecording() {
+            const string FILENAME = "ColumnarTestSuite.rec.col";
+            const int32_t ROWS = 3 * ColumnarFormat::ROWS_PER_BLOCK + 100;
+            {
+                ColumnarWriter writer(FILENAME);
+                TS_ASSERT(writer.isGood());
+                for (int32_t i = 0; i < ROWS; i++) {
+                    Container c;
+                    c.setSenderStamp(2);
+                    c.setSampleTimeStamp(TimeStamp(i, 0));
+                    Message msg = createMessage(i, i * 0.5);
+                    writer.append(c, msg);
+                }
+                TS_ASSERT(writer.close());
+            }
+
+            ColumnarReader reader(FILENAME);
+            TS_ASSERT(reader.isValid());
+            TS_ASSERT_EQUALS(reader.getTables().size(), 1u);
+
+            const Table &T = reader.getTables()[0];
+            TS_ASSERT_EQUALS(T.m_name, "Columnar.Test");
+            TS_ASSERT_EQUALS(T.m_senderStamp, 2u);
+            TS_ASSERT_EQUALS(T.m_numberOfRows, static_cast<uint64_t>(ROWS));
+            TS_ASSERT(T.findColumn(ColumnarFormat::SAMPLE_TIMESTAMP) >= 0);
+            TS_ASSERT(T.findColumn("counter") >= 0);
+            TS_ASSERT(T.findColumn("speed") >= 0);
+            TS_ASSERT_EQUALS(T.m_columns[T.findColumn("speed")].m_blocks.size(), 4u);
+
+            // Time range within the second block: only time stamp and value block of one block are decoded.
+            vector<int64_t> timeStamps;
+            vector<double> values;
+            const int64_t FROM = (ColumnarFormat::ROWS_PER_BLOCK + 10) * 1000000LL;
+            const int64_t TO = (ColumnarFormat::ROWS_PER_BLOCK + 19) * 1000000LL;
+            TS_ASSERT(reader.query("Columnar.Test", 2, "speed", FROM, TO, timeStamps, values));
+            TS_ASSERT_EQUALS(reader.getNumberOfDecodedBlocks(), 2u);
+            TS_ASSERT_EQUALS(values.size(), 10u);
+            for (uint32_t i = 0; i < values.size(); i++) {
+                TS_ASSERT_EQUALS(timeStamps[i], FROM + i * 1000000LL);
+                TS_ASSERT_DELTA(values[i], (ColumnarFormat::ROWS_PER_BLOCK + 10 + i) * 0.5, 1e-9);
+            }
+
+            // Value range within the last block.
+            TS_ASSERT(reader.queryValues("Columnar.Test", 2, "counter", ROWS - 5, ROWS, timeStamps, values));
+            TS_ASSERT_EQUALS(reader.getNumberOfDecodedBlocks(), 4u);
+            TS_ASSERT_EQUALS(values.size(), 5u);
+            TS_ASSERT_DELTA(values[0], ROWS - 5, 1e-9);
+            TS_ASSERT_EQUALS(timeStamps[0], (ROWS - 5) * 1000000LL);
+
+            // Unknown tables and columns.
+            TS_ASSERT(!reader.query("Columnar.Test", 1, "speed", FROM, TO, timeStamps, values));
+            TS_ASSERT(!reader.query("Columnar.Test", 2, "unknown", FROM, TO, timeStamps, values));
+
+            UNLINK(FILENAME.c_str());
+        }
+
+        void testInvalidColumnarRecording() {
+            const string FILENAME = "ColumnarTestSuite.invalid.rec.col";
+            {
+                fstream fout(FILENAME.c_str(), ios::out | ios::binary | ios::trunc);
+                fout << "This is not a columnar recording.";
+            }
+
+            ColumnarReader reader(FILENAME);
+            TS_ASSERT(!reader.isValid());
+            TS_ASSERT_EQUALS(reader.getTables().size(), 0u);
+
+            UNLINK(FILENAME.c_str());
+        }
+};
+
+#endif /*CORE_COLUMNARTESTSUITE_H_*/
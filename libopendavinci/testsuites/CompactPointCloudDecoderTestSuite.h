@@ -0,0 +1,227 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CORE_COMPACTPOINTCLOUDDECODERTESTSUITE_H_
+#define CORE_COMPACTPOINTCLOUDDECODERTESTSUITE_H_
+
+#include <algorithm>                    // for max
+#include <cmath>                        // for fabs, sin, cos
+#include <iostream>                     // for clog
+#include <sstream>                      // for stringstream
+#include <string>                       // for string
+#include <vector>                       // for vector
+
+#include "cxxtest/TestSuite.h"          // for TS_ASSERT, TestSuite
+
+#include "opendavinci/odcore/data/CompactPointCloudDecoder.h"
+#include "opendavinci/odcore/data/TimeStamp.h"
+#include "opendavinci/generated/odcore/data/CompactPointCloud.h"
+
+using namespace std;
+using namespace odcore::data;
+
+class CompactPointCloudDecoderTest : public CxxTest::TestSuite {
+    public:
+        static string encode(const vector<uint16_t> &values, const bool &networkByteOrder) {
+            stringstream sstr;
+            for (uint32_t i = 0; i < values.size(); i++) {
+                if (networkByteOrder) {
+                    sstr.put(static_cast<char>(values[i] >> 8));
+                    sstr.put(static_cast<char>(values[i] & 0xFF));
+                }
+                else {
+                    sstr.write(reinterpret_cast<const char*>(&values[i]), 2);
+                }
+            }
+            return sstr.str();
+        }
+
+        static bool isClose(const float &a, const float &b) {
+            return fabs(a - b) < 1e-3;
+        }
+
+        void testVLP16() {
+            // Two azimuths with 16 layers each; the first layer is closer than or exactly 1m.
+            vector<uint16_t> values;
+            for (uint32_t i = 0; i < 32; i++) {
+                values.push_back((i % 16 == 0) ? 99 + i / 16 : 100 + i * 10);
+            }
+            CompactPointCloud cpc(10.0f, 30.0f, 16, encode(values, true), 0, CompactPointCloud::HIGHER_BITS, CompactPointCloud::CM);
+
+            CompactPointCloudDecoder decoder;
+            CompactPointCloudDecoder::PointBuffer points;
+            TS_ASSERT(decoder.decode(cpc, points) == 30);
+            TS_ASSERT(points.size() == 30);
+
+            const float DEG2RAD = static_cast<float>(M_PI / 180.0);
+            uint32_t p = 0;
+            for (uint32_t i = 0; i < 32; i++) {
+                if (i % 16 == 0) {
+                    continue;
+                }
+                const float DISTANCE = (100 + i * 10) / 100.0f;
+                const float AZIMUTH = (i < 16) ? 10.0f : 20.0f;
+                const float VERTICAL_ANGLE = -15.0f + 2.0f * (i % 16);
+                TS_ASSERT(isClose(points.m_distance[p], DISTANCE));
+                TS_ASSERT(isClose(points.m_azimuth[p], AZIMUTH));
+                TS_ASSERT(isClose(points.m_verticalAngle[p], VERTICAL_ANGLE));
+                TS_ASSERT(isClose(points.m_x[p], DISTANCE * cos(VERTICAL_ANGLE * DEG2RAD) * sin(AZIMUTH * DEG2RAD)));
+                TS_ASSERT(isClose(points.m_y[p], DISTANCE * cos(VERTICAL_ANGLE * DEG2RAD) * cos(AZIMUTH * DEG2RAD)));
+                TS_ASSERT(isClose(points.m_z[p], DISTANCE * sin(VERTICAL_ANGLE * DEG2RAD)));
+                TS_ASSERT(isClose(points.m_intensity[p], 0.0f));
+                p++;
+            }
+
+            // Decoding appends to the buffer.
+            TS_ASSERT(decoder.decode(cpc, points) == 30);
+            TS_ASSERT(points.size() == 60);
+            TS_ASSERT(isClose(points.m_z[30], points.m_z[0]));
+            points.clear();
+            TS_ASSERT(points.size() == 0);
+
+            // Recordings before 2017 stored the distances in host byte order.
+            CompactPointCloud cpcHostByteOrder(10.0f, 30.0f, 16, encode(values, false), 0, CompactPointCloud::HIGHER_BITS, CompactPointCloud::CM);
+            TS_ASSERT(decoder.decode(cpcHostByteOrder, points, false) == 30);
+            TS_ASSERT(isClose(points.m_distance[0], 1.1f));
+        }
+
+        void testResolutionAndIntensity() {
+            CompactPointCloudDecoder decoder;
+            CompactPointCloudDecoder::PointBuffer points;
+
+            // 2mm resolution with 4 bits for intensity in the higher bits.
+            vector<uint16_t> values(16, static_cast<uint16_t>((15 << 12) | 1000));
+            values[1] = static_cast<uint16_t>((5 << 12) | 1000);
+            values[2] = static_cast<uint16_t>((15 << 12) | 499);
+            CompactPointCloud higher(0.0f, 1.0f, 16, encode(values, true), 4, CompactPointCloud::HIGHER_BITS, CompactPointCloud::MM);
+            TS_ASSERT(decoder.decode(higher, points) == 15);
+            TS_ASSERT(isClose(points.m_distance[0], 2.0f));
+            TS_ASSERT(isClose(points.m_intensity[0], 1.0f));
+            TS_ASSERT(isClose(points.m_intensity[1], 5.0f / 15.0f));
+
+            // 1cm resolution with 2 bits for intensity in the lower bits.
+            points.clear();
+            vector<uint16_t> lower(16, static_cast<uint16_t>(400 | 2));
+            CompactPointCloud cpcLower(0.0f, 1.0f, 16, encode(lower, true), 2, CompactPointCloud::LOWER_BITS, CompactPointCloud::CM);
+            TS_ASSERT(decoder.decode(cpcLower, points) == 16);
+            TS_ASSERT(isClose(points.m_distance[0], 4.0f));
+            TS_ASSERT(isClose(points.m_intensity[0], 2.0f / 3.0f));
+        }
+
+        void testHDL32() {
+            CompactPointCloudDecoder decoder;
+            TS_ASSERT(decoder.getVerticalAngles(12).size() == 12);
+            TS_ASSERT(decoder.getVerticalAngles(11).size() == 11);
+            TS_ASSERT(decoder.getVerticalAngles(9).size() == 9);
+            TS_ASSERT(decoder.getVerticalAngles(16).size() == 16);
+            TS_ASSERT(decoder.getVerticalAngles(7).empty());
+
+            // All three parts together contain all 32 layers from -30.67 to 10.67 DEG.
+            vector<float> all;
+            all.insert(all.end(), decoder.getVerticalAngles(12).begin(), decoder.getVerticalAngles(12).end());
+            all.insert(all.end(), decoder.getVerticalAngles(11).begin(), decoder.getVerticalAngles(11).end());
+            all.insert(all.end(), decoder.getVerticalAngles(9).begin(), decoder.getVerticalAngles(9).end());
+            TS_ASSERT(all.size() == 32);
+            float minimum = all[0], maximum = all[0];
+            for (uint32_t i = 0; i < all.size(); i++) {
+                minimum = (all[i] < minimum) ? all[i] : minimum;
+                maximum = (all[i] > maximum) ? all[i] : maximum;
+            }
+            TS_ASSERT(isClose(minimum, -30.67f));
+            TS_ASSERT(fabs(maximum - 10.67f) < 0.01f);
+            TS_ASSERT(isClose(decoder.getVerticalAngles(12)[1], -29.3367f));
+            TS_ASSERT(isClose(decoder.getVerticalAngles(9)[0], -24.0033f));
+
+            vector<uint16_t> values(11 * 3, 1234);
+            CompactPointCloud cpc(0.0f, 3.0f, 11, encode(values, true), 0, CompactPointCloud::HIGHER_BITS, CompactPointCloud::CM);
+            CompactPointCloudDecoder::PointBuffer points;
+            TS_ASSERT(decoder.decode(cpc, points) == 33);
+            TS_ASSERT(isClose(points.m_azimuth[32], 2.0f));
+            TS_ASSERT(isClose(points.m_verticalAngle[0], decoder.getVerticalAngles(11)[0]));
+
+            // Unsupported number of entries per azimuth.
+            CompactPointCloud unsupported(0.0f, 3.0f, 7, encode(values, true), 0, CompactPointCloud::HIGHER_BITS, CompactPointCloud::CM);
+            TS_ASSERT(decoder.decode(unsupported, points) == 0);
+            TS_ASSERT(points.size() == 33);
+        }
+
+        void testDecoderThroughput() {
+            // One VLP-16 scan with 1800 azimuths.
+            const uint32_t NUMBER_OF_AZIMUTHS = 1800;
+            const uint32_t NUMBER_OF_SCANS = 100;
+            vector<uint16_t> values;
+            for (uint32_t i = 0; i < NUMBER_OF_AZIMUTHS * 16; i++) {
+                values.push_back(static_cast<uint16_t>(150 + (i * 7) % 5000));
+            }
+            CompactPointCloud cpc(0.0f, 360.0f, 16, encode(values, true), 0, CompactPointCloud::HIGHER_BITS, CompactPointCloud::CM);
+
+            CompactPointCloudDecoder decoder;
+            CompactPointCloudDecoder::PointBuffer points;
+            TimeStamp before;
+            for (uint32_t scan = 0; scan < NUMBER_OF_SCANS; scan++) {
+                points.clear();
+                decoder.decode(cpc, points);
+            }
+            TimeStamp after;
+            TS_ASSERT(points.size() == NUMBER_OF_AZIMUTHS * 16);
+
+            // Previous implementation: stringstream and trigonometric functions per point.
+            vector<float> x, y, z;
+            const float DEG2RAD = static_cast<float>(M_PI / 180.0);
+            for (uint32_t scan = 0; scan < NUMBER_OF_SCANS; scan++) {
+                x.clear(); y.clear(); z.clear();
+                stringstream sstr(cpc.getDistances());
+                const float AZIMUTH_INCREMENT = (cpc.getEndAzimuth() - cpc.getStartAzimuth()) / NUMBER_OF_AZIMUTHS;
+                float azimuth = cpc.getStartAzimuth();
+                for (uint32_t azimuthIndex = 0; azimuthIndex < NUMBER_OF_AZIMUTHS; azimuthIndex++) {
+                    float verticalAngle = -15.0f;
+                    for (uint32_t layer = 0; layer < 16; layer++) {
+                        uint16_t value = 0;
+                        sstr.read(reinterpret_cast<char*>(&value), 2);
+                        value = static_cast<uint16_t>((value >> 8) | (value << 8));
+                        const float DISTANCE = value / 100.0f;
+                        if (DISTANCE > 1.0f) {
+                            const float XY_DISTANCE = DISTANCE * cos(verticalAngle * DEG2RAD);
+                            x.push_back(XY_DISTANCE * sin(azimuth * DEG2RAD));
+                            y.push_back(XY_DISTANCE * cos(azimuth * DEG2RAD));
+                            z.push_back(DISTANCE * sin(verticalAngle * DEG2RAD));
+                        }
+                        verticalAngle += 2.0f;
+                    }
+                    azimuth += AZIMUTH_INCREMENT;
+                }
+            }
+            TimeStamp afterReference;
+            TS_ASSERT(x.size() == points.size());
+
+            float maximumError = 0.0f;
+            for (uint32_t i = 0; i < x.size(); i++) {
+                maximumError = std::max(maximumError, static_cast<float>(fabs(x[i] - points.m_x[i])));
+                maximumError = std::max(maximumError, static_cast<float>(fabs(y[i] - points.m_y[i])));
+                maximumError = std::max(maximumError, static_cast<float>(fabs(z[i] - points.m_z[i])));
+            }
+            TS_ASSERT(maximumError < 1e-2);
+
+            clog << "[CompactPointCloudDecoderTestSuite] Decoded " << NUMBER_OF_SCANS << " scans with " << points.size() << " points in "
+                 << (after - before).toMicroseconds() << " us instead of " << (afterReference - after).toMicroseconds()
+                 << " us when converting every point separately; maximum difference " << maximumError << " m." << endl;
+        }
+};
+
+#endif /*CORE_COMPACTPOINTCLOUDDECODERTESTSUITE_H_*/
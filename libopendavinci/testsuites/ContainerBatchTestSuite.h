@@ -0,0 +1,116 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CORE_CONTAINERBATCHTESTSUITE_H_
+#define CORE_CONTAINERBATCHTESTSUITE_H_
+
+#include <string>                       // for string
+#include <vector>                       // for vector
+
+#include "cxxtest/TestSuite.h"          // for TS_ASSERT, TestSuite
+
+#include "opendavinci/odcore/data/Container.h"        // for Container, etc
+#include "opendavinci/odcore/data/ContainerBatch.h"   // for ContainerBatch
+#include "opendavinci/odcore/data/TimeStamp.h"        // for TimeStamp
+
+using namespace std;
+using namespace odcore::data;
+
+class ContainerBatchTest : public CxxTest::TestSuite {
+    public:
+        void testEmptyBatch() {
+            ContainerBatch b;
+            TS_ASSERT(b.isEmpty());
+            TS_ASSERT(b.getNumberOfContainers() == 0);
+            TS_ASSERT(b.getRawData().empty());
+            TS_ASSERT(b.getListOfContainers().empty());
+
+            ContainerBatch b2("");
+            TS_ASSERT(b2.isEmpty());
+        }
+
+        void testAddAndDecode() {
+            ContainerBatch b;
+            for (int32_t i = 0; i < 10; i++) {
+                TimeStamp ts(i, i * 1000);
+                Container c(ts);
+                c.setSenderStamp(i);
+                b.add(c);
+            }
+            TS_ASSERT(b.getNumberOfContainers() == 10);
+
+            // Decoding the raw data must restore all containers.
+            ContainerBatch b2(b.getRawData());
+            TS_ASSERT(b2.getNumberOfContainers() == 10);
+            TS_ASSERT(b2.getRawData() == b.getRawData());
+
+            vector<Container> list = b2.getListOfContainers();
+            TS_ASSERT(list.size() == 10);
+            for (int32_t i = 0; i < 10; i++) {
+                TS_ASSERT(list[i].getDataType() == TimeStamp::ID());
+                TS_ASSERT(list[i].getSenderStamp() == static_cast<uint32_t>(i));
+                TimeStamp ts = list[i].getData<TimeStamp>();
+                TS_ASSERT(ts.getSeconds() == i);
+                TS_ASSERT(ts.getFractionalMicroseconds() == i * 1000);
+            }
+        }
+
+        void testAppend() {
+            vector<Container> list1;
+            list1.push_back(Container(TimeStamp(1, 0)));
+            list1.push_back(Container(TimeStamp(2, 0)));
+            vector<Container> list2;
+            list2.push_back(Container(TimeStamp(3, 0)));
+
+            ContainerBatch b(list1);
+            ContainerBatch b2(list2);
+            b.append(b2);
+            b.append(ContainerBatch());
+            TS_ASSERT(b.getNumberOfContainers() == 3);
+
+            vector<Container> list = ContainerBatch(b.getRawData()).getListOfContainers();
+            TS_ASSERT(list.size() == 3);
+            TS_ASSERT(list[0].getData<TimeStamp>().getSeconds() == 1);
+            TS_ASSERT(list[1].getData<TimeStamp>().getSeconds() == 2);
+            TS_ASSERT(list[2].getData<TimeStamp>().getSeconds() == 3);
+
+            b.clear();
+            TS_ASSERT(b.isEmpty());
+            TS_ASSERT(b.getRawData().empty());
+        }
+
+        void testInvalidData() {
+            ContainerBatch b;
+            b.add(Container(TimeStamp(1, 0)));
+            b.add(Container(TimeStamp(2, 0)));
+
+            // A truncated container is discarded.
+            const string RAW = b.getRawData();
+            ContainerBatch b2(RAW.substr(0, RAW.size() - 1));
+            TS_ASSERT(b2.getNumberOfContainers() == 1);
+            TS_ASSERT(b2.getListOfContainers().size() == 1);
+
+            // Data without a valid header is discarded.
+            ContainerBatch b3(RAW + "garbage");
+            TS_ASSERT(b3.getNumberOfContainers() == 2);
+            TS_ASSERT(b3.getRawData() == RAW);
+        }
+};
+
+#endif /*CORE_CONTAINERBATCHTESTSUITE_H_*/
@@ -0,0 +1,139 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CORE_CONTAINERCONFERENCETELEMETRYTESTSUITE_H_
+#define CORE_CONTAINERCONFERENCETELEMETRYTESTSUITE_H_
+
+#include <vector>                       // for vector
+
+#include "cxxtest/TestSuite.h"          // for TS_ASSERT, TestSuite
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/data/TimeStamp.h"
+#include "opendavinci/odcore/io/conference/ContainerConferenceTelemetry.h"
+#include "opendavinci/generated/odcore/data/dmcp/ContainerStatistic.h"
+#include "opendavinci/generated/odcore/data/dmcp/ContainerStatistics.h"
+
+using namespace std;
+using namespace odcore::data;
+using namespace odcore::data::dmcp;
+using namespace odcore::io::conference;
+
+class ContainerConferenceTelemetryTest : public CxxTest::TestSuite {
+    private:
+        Container createContainer(const uint32_t &senderStamp, const int64_t &sent, const int64_t &received) {
+            TimeStamp ts;
+            Container c(ts);
+            c.setSenderStamp(senderStamp);
+            c.setSentTimeStamp(TimeStamp(0, sent));
+            c.setReceivedTimeStamp(TimeStamp(0, received));
+            return c;
+        }
+
+    public:
+        void testHistogramBuckets() {
+            // Small values are exact.
+            for (int64_t i = 0; i < 32; i++) {
+                TS_ASSERT(LatencyHistogram::getBucket(i) == i);
+                TS_ASSERT(LatencyHistogram::getUpperBound(LatencyHistogram::getBucket(i)) == i);
+            }
+
+            // Every value is within the bounds of its bucket with a relative error below 7%.
+            for (int64_t i = 32; i < (1L << 30); i = i * 5 / 4 + 1) {
+                const uint32_t BUCKET = LatencyHistogram::getBucket(i);
+                TS_ASSERT(BUCKET < LatencyHistogram::NUMBER_OF_BUCKETS);
+                TS_ASSERT(LatencyHistogram::getUpperBound(BUCKET) >= i);
+                TS_ASSERT(LatencyHistogram::getUpperBound(BUCKET - 1) < i);
+                TS_ASSERT(LatencyHistogram::getUpperBound(BUCKET) - i < i * 0.07);
+            }
+
+            TS_ASSERT(LatencyHistogram::getBucket(-1) == 0);
+            TS_ASSERT(LatencyHistogram::getBucket(1L << 40) == LatencyHistogram::NUMBER_OF_BUCKETS - 1);
+        }
+
+        void testHistogramPercentiles() {
+            LatencyHistogram h;
+            TS_ASSERT(h.getPercentile(50) == 0);
+
+            for (int64_t i = 1; i <= 1000; i++) {
+                h.add(i);
+            }
+            TS_ASSERT(h.getNumberOfSamples() == 1000);
+            TS_ASSERT(h.getMaximum() == 1000);
+
+            const int64_t P50 = h.getPercentile(50);
+            const int64_t P99 = h.getPercentile(99);
+            TS_ASSERT(P50 >= 500 && P50 < 535);
+            TS_ASSERT(P99 >= 990 && P99 <= 1000);
+            TS_ASSERT(h.getPercentile(100) == 1000);
+
+            h.reset();
+            TS_ASSERT(h.getNumberOfSamples() == 0);
+            TS_ASSERT(h.getMaximum() == 0);
+        }
+
+        void testCountAndReset() {
+            ContainerConferenceTelemetry t;
+
+            for (uint32_t i = 0; i < 10; i++) {
+                t.countSent(createContainer(1, 0, 0), 100, 2000);
+                t.countReceived(createContainer(2, 1000, 1000 + 10 * (i + 1)), 50, 4000);
+            }
+            t.countDropped(createContainer(3, 0, 0));
+
+            ContainerStatistics cs = t.getStatisticsAndReset();
+            TS_ASSERT(cs.getPeriod() >= 0);
+            vector<ContainerStatistic> list = cs.getListOfContainerStatistics();
+            TS_ASSERT(list.size() == 3);
+
+            // Entries are ordered by data type and sender stamp.
+            TS_ASSERT(list[0].getDataType() == TimeStamp::ID());
+            TS_ASSERT(list[0].getSenderStamp() == 1);
+            TS_ASSERT(list[0].getNumberOfLatencySamples() == 0);
+            TS_ASSERT_DELTA(list[0].getMeanSerializationTime(), 2.0, 1e-9);
+
+            TS_ASSERT(list[1].getSenderStamp() == 2);
+            TS_ASSERT(list[1].getNumberOfLatencySamples() == 10);
+            TS_ASSERT_DELTA(list[1].getMeanDeserializationTime(), 4.0, 1e-9);
+            TS_ASSERT_DELTA(list[1].getLatencyMax(), 100, 1e-9);
+            TS_ASSERT(list[1].getLatencyP50() >= 50 && list[1].getLatencyP50() <= 55);
+
+            TS_ASSERT(list[2].getSenderStamp() == 3);
+            TS_ASSERT(list[2].getNumberOfDroppedContainers() == 1);
+
+            if (cs.getPeriod() > 0) {
+                TS_ASSERT_DELTA(list[0].getSentRate() * cs.getPeriod(), 10, 1e-6);
+                TS_ASSERT_DELTA(list[0].getSentBytesRate() * cs.getPeriod(), 1000, 1e-6);
+                TS_ASSERT_DELTA(list[1].getReceivedBytesRate() * cs.getPeriod(), 500, 1e-6);
+            }
+
+            // Silent entries are reported once with zero rates and removed afterwards.
+            cs = t.getStatisticsAndReset();
+            list = cs.getListOfContainerStatistics();
+            TS_ASSERT(list.size() == 3);
+            TS_ASSERT(list[1].getNumberOfLatencySamples() == 0);
+            TS_ASSERT(list[2].getNumberOfDroppedContainers() == 0);
+
+            cs = t.getStatisticsAndReset();
+            TS_ASSERT(cs.getListOfContainerStatistics().size() == 0);
+        }
+};
+
+#endif /*CORE_CONTAINERCONFERENCETELEMETRYTESTSUITE_H_*/
@@ -0,0 +1,189 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CORE_DEADLINESCHEDULERTESTSUITE_H_
+#define CORE_DEADLINESCHEDULERTESTSUITE_H_
+
+#include <vector>                       // for vector
+
+#include "cxxtest/TestSuite.h"          // for TS_ASSERT, TestSuite
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Thread.h"           // for Thread
+#include "opendavinci/odcore/base/module/DeadlineScheduler.h"
+#include "opendavinci/odcore/wrapper/SystemClock.h"
+
+using namespace std;
+using namespace odcore::base;
+using namespace odcore::base::module;
+using namespace odcore::wrapper;
+
+class DeadlineSchedulerTest : public CxxTest::TestSuite {
+    public:
+        void testNoDrift() {
+            DeadlineScheduler ds;
+            ds.setPeriod(10000);
+            TS_ASSERT(ds.getPeriod() == 10000);
+            TS_ASSERT(!ds.isStarted());
+
+            ds.start();
+            TS_ASSERT(ds.isStarted());
+            const int64_t START = SystemClock::getMonotonicMicroseconds();
+            for (uint32_t i = 0; i < 20; i++) {
+                // Consume some time of the slice.
+                Thread::usleepFor(2000);
+                TS_ASSERT(!ds.waitForNextDeadline());
+            }
+            const int64_t DURATION = SystemClock::getMonotonicMicroseconds() - START;
+
+            // The time for the work within the slices must not accumulate.
+            TS_ASSERT(DURATION >= 200000);
+            TS_ASSERT(DURATION < 210000);
+
+            TS_ASSERT(ds.getNumberOfOverruns() == 0);
+            TS_ASSERT(ds.getMaxJitter() >= ds.getMeanJitter());
+
+            uint32_t samples = 0;
+            const vector<uint32_t> HISTOGRAM = ds.getJitterHistogram();
+            TS_ASSERT(HISTOGRAM.size() == DeadlineScheduler::NUMBER_OF_HISTOGRAM_BINS);
+            for (auto bin : HISTOGRAM) {
+                samples += bin;
+            }
+            TS_ASSERT(samples == 20);
+
+            ds.resetStatistics();
+            samples = 0;
+            for (auto bin : ds.getJitterHistogram()) {
+                samples += bin;
+            }
+            TS_ASSERT(samples == 0);
+            TS_ASSERT(ds.getMeanJitter() == 0);
+        }
+
+        void testBusyWait() {
+            DeadlineScheduler ds;
+            ds.setPeriod(5000);
+            ds.setBusyWait(1000);
+            TS_ASSERT(ds.getBusyWait() == 1000);
+
+            ds.start();
+            for (uint32_t i = 0; i < 10; i++) {
+                TS_ASSERT(!ds.waitForNextDeadline());
+            }
+
+            // Spinning for the last microseconds hits the deadlines closely.
+            TS_ASSERT(ds.getMeanJitter() < 100);
+        }
+
+        void testLastWaitTime() {
+            DeadlineScheduler ds;
+            ds.setPeriod(10000);
+            ds.start();
+            TS_ASSERT(ds.getLastWaitTime() == 0);
+
+            // The time actually waited is reported, not the nominal period.
+            Thread::usleepFor(4000);
+            const int64_t START = SystemClock::getMonotonicMicroseconds();
+            TS_ASSERT(!ds.waitForNextDeadline());
+            const int64_t DURATION = SystemClock::getMonotonicMicroseconds() - START;
+            TS_ASSERT(ds.getLastWaitTime() <= DURATION);
+            TS_ASSERT(ds.getLastWaitTime() + 1000 > DURATION);
+            TS_ASSERT(ds.getLastWaitTime() < 6500);
+
+            // No waiting after a missed deadline with the policy STRETCH.
+            ds.setOverrunPolicy(DeadlineScheduler::STRETCH);
+            Thread::usleepFor(15000);
+            TS_ASSERT(ds.waitForNextDeadline());
+            TS_ASSERT(ds.getLastWaitTime() < 1000);
+        }
+
+        void testOverrunSkip() {
+            DeadlineScheduler ds;
+            ds.setPeriod(10000);
+            ds.setOverrunPolicy(DeadlineScheduler::SKIP);
+            ds.start();
+
+            // Miss two and a half deadlines.
+            const int64_t START = SystemClock::getMonotonicMicroseconds();
+            Thread::usleepFor(25000);
+            TS_ASSERT(ds.waitForNextDeadline());
+            const int64_t DURATION = SystemClock::getMonotonicMicroseconds() - START;
+
+            // The next slice starts on the original grid.
+            TS_ASSERT(DURATION >= 30000);
+            TS_ASSERT(DURATION < 35000);
+            TS_ASSERT(ds.getNumberOfOverruns() == 1);
+            TS_ASSERT(ds.getNumberOfSkippedCycles() == 2);
+
+            TS_ASSERT(!ds.waitForNextDeadline());
+        }
+
+        void testOverrunBurst() {
+            DeadlineScheduler ds;
+            ds.setPeriod(10000);
+            ds.setOverrunPolicy(DeadlineScheduler::BURST);
+            ds.start();
+
+            Thread::usleepFor(25000);
+            const int64_t START = SystemClock::getMonotonicMicroseconds();
+
+            // The missed slices are run back to back.
+            TS_ASSERT(ds.waitForNextDeadline());
+            TS_ASSERT(ds.waitForNextDeadline());
+            TS_ASSERT(SystemClock::getMonotonicMicroseconds() - START < 5000);
+
+            // The third slice is in time again.
+            TS_ASSERT(!ds.waitForNextDeadline());
+            TS_ASSERT(ds.getNumberOfOverruns() == 2);
+            TS_ASSERT(ds.getNumberOfSkippedCycles() == 0);
+        }
+
+        void testOverrunStretch() {
+            // Like sleeping for the remainder of a slice, STRETCH is the default.
+            DeadlineScheduler ds;
+            TS_ASSERT(ds.getOverrunPolicy() == DeadlineScheduler::STRETCH);
+            ds.setPeriod(10000);
+            ds.start();
+
+            Thread::usleepFor(15000);
+            const int64_t START = SystemClock::getMonotonicMicroseconds();
+
+            // The next slice starts immediately and the grid starts again from now.
+            TS_ASSERT(ds.waitForNextDeadline());
+            TS_ASSERT(!ds.waitForNextDeadline());
+            const int64_t DURATION = SystemClock::getMonotonicMicroseconds() - START;
+            TS_ASSERT(DURATION >= 10000);
+            TS_ASSERT(DURATION < 15000);
+            TS_ASSERT(ds.getNumberOfOverruns() == 1);
+        }
+
+        void testParseOverrunPolicy() {
+            DeadlineScheduler::OVERRUNPOLICY policy = DeadlineScheduler::SKIP;
+            TS_ASSERT(DeadlineScheduler::parseOverrunPolicy("stretch", policy));
+            TS_ASSERT(policy == DeadlineScheduler::STRETCH);
+            TS_ASSERT(DeadlineScheduler::parseOverrunPolicy("BURST", policy));
+            TS_ASSERT(policy == DeadlineScheduler::BURST);
+            TS_ASSERT(DeadlineScheduler::parseOverrunPolicy("skip", policy));
+            TS_ASSERT(policy == DeadlineScheduler::SKIP);
+            TS_ASSERT(!DeadlineScheduler::parseOverrunPolicy("none", policy));
+            TS_ASSERT(policy == DeadlineScheduler::SKIP);
+        }
+};
+
+#endif /*CORE_DEADLINESCHEDULERTESTSUITE_H_*/
@@ -0,0 +1,372 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CORE_FIELDACCESSORTESTSUITE_H_
+#define CORE_FIELDACCESSORTESTSUITE_H_
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cxxtest/TestSuite.h"
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Visitable.h"
+#include "opendavinci/odcore/base/Visitor.h"
+#include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/data/SerializableData.h"
+#include "opendavinci/odcore/reflection/FieldAccessor.h"
+#include "opendavinci/odcore/reflection/Message.h"
+#include "opendavinci/odcore/reflection/MessageFromVisitableVisitor.h"
+#include "opendavinci/odcore/serialization/Deserializer.h"
+#include "opendavinci/odcore/serialization/Serializable.h"
+#include "opendavinci/odcore/serialization/SerializationFactory.h"
+#include "opendavinci/odcore/serialization/Serializer.h"
+#include "opendavinci/generated/odcore/data/reflection/AbstractField.h"
+
+using namespace std;
+using namespace odcore;
+using namespace odcore::base;
+using namespace odcore::data;
+using namespace odcore::reflection;
+using namespace odcore::serialization;
+
+class FieldAccessorTestPosition : public Serializable, public Visitable {
+    public:
+        FieldAccessorTestPosition() :
+            Serializable(),
+            Visitable(),
+            m_x(0),
+            m_y(0) {}
+
+        double m_x;
+        float m_y;
+
+        virtual void accept(odcore::base::Visitor &v) {
+            v.beginVisit(1, "Position", "test.Position");
+            v.visit(1, "Position.x", "x", m_x);
+            v.visit(2, "Position.y", "y", m_y);
+            v.endVisit();
+        }
+
+        virtual ostream& operator<<(ostream &out) const {
+            SerializationFactory& sf=SerializationFactory::getInstance();
+            std::shared_ptr<Serializer> s = sf.getSerializer(out);
+            s->write(1, m_x);
+            s->write(2, m_y);
+            return out;
+        }
+
+        virtual istream& operator>>(istream &in) {
+            SerializationFactory& sf=SerializationFactory::getInstance();
+            std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
+            d->read(1, m_x);
+            d->read(2, m_y);
+            return in;
+        }
+};
+
+class FieldAccessorTestData : public SerializableData, public Visitable {
+    public:
+        FieldAccessorTestData() :
+            SerializableData(),
+            Visitable(),
+            m_name(""),
+            m_flag(false),
+            m_char(0),
+            m_int8(0),
+            m_int16(0),
+            m_uint32(0),
+            m_int64(0),
+            m_uint64(0),
+            m_position() {}
+
+        string m_name;
+        bool m_flag;
+        char m_char;
+        int8_t m_int8;
+        int16_t m_int16;
+        uint32_t m_uint32;
+        int64_t m_int64;
+        uint64_t m_uint64;
+        FieldAccessorTestPosition m_position;
+
+        virtual int32_t getID() const { return 4711; }
+        virtual const string getShortName() const { return "Data"; }
+        virtual const string getLongName() const { return "test.Data"; }
+        virtual const string toString() const { return ""; }
+
+        virtual void accept(odcore::base::Visitor &v) {
+            v.beginVisit(getID(), getShortName(), getLongName());
+            v.visit(1, "Data.name", "name", m_name);
+            v.visit(2, "Data.flag", "flag", m_flag);
+            v.visit(3, "Data.character", "character", m_char);
+            v.visit(4, "Data.int8", "int8", m_int8);
+            v.visit(5, "Data.int16", "int16", m_int16);
+            v.visit(6, "Data.uint32", "uint32", m_uint32);
+            v.visit(7, "Data.int64", "int64", m_int64);
+            v.visit(8, "Data.uint64", "uint64", m_uint64);
+            v.visit(9, "Data.position", "position", m_position);
+            v.endVisit();
+        }
+
+        virtual ostream& operator<<(ostream &out) const {
+            SerializationFactory& sf=SerializationFactory::getInstance();
+            std::shared_ptr<Serializer> s = sf.getSerializer(out);
+            s->write(1, m_name);
+            s->write(2, m_flag);
+            s->write(3, m_char);
+            s->write(4, m_int8);
+            s->write(5, m_int16);
+            s->write(6, m_uint32);
+            s->write(7, m_int64);
+            s->write(8, m_uint64);
+            s->write(9, m_position);
+            return out;
+        }
+
+        virtual istream& operator>>(istream &in) {
+            SerializationFactory& sf=SerializationFactory::getInstance();
+            std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
+            d->read(1, m_name);
+            d->read(2, m_flag);
+            d->read(3, m_char);
+            d->read(4, m_int8);
+            d->read(5, m_int16);
+            d->read(6, m_uint32);
+            d->read(7, m_int64);
+            d->read(8, m_uint64);
+            d->read(9, m_position);
+            return in;
+        }
+};
+
+class FieldAccessorTestArray : public SerializableData, public Visitable {
+    public:
+        FieldAccessorTestArray() :
+            SerializableData(),
+            Visitable(),
+            m_acceleration(),
+            m_counter(0) {
+            m_acceleration[0] = 0;
+            m_acceleration[1] = 0;
+            m_acceleration[2] = 0;
+        }
+
+        float m_acceleration[3];
+        int32_t m_counter;
+
+        virtual int32_t getID() const { return 4713; }
+        virtual const string getShortName() const { return "Array"; }
+        virtual const string getLongName() const { return "test.Array"; }
+        virtual const string toString() const { return ""; }
+
+        virtual void accept(odcore::base::Visitor &v) {
+            v.beginVisit(getID(), getShortName(), getLongName());
+            v.visit(1, "Array.acceleration", "acceleration", m_acceleration, 3, odcore::FLOAT_T);
+            v.visit(2, "Array.counter", "counter", m_counter);
+            v.endVisit();
+        }
+
+        virtual ostream& operator<<(ostream &out) const {
+            SerializationFactory& sf=SerializationFactory::getInstance();
+            std::shared_ptr<Serializer> s = sf.getSerializer(out);
+            s->write(1, m_acceleration, 3 * sizeof(float));
+            s->write(2, m_counter);
+            return out;
+        }
+
+        virtual istream& operator>>(istream &in) {
+            SerializationFactory& sf=SerializationFactory::getInstance();
+            std::shared_ptr<Deserializer> d = sf.getDeserializer(in);
+            d->read(1, m_acceleration, 3 * sizeof(float));
+            d->read(2, m_counter);
+            return in;
+        }
+};
+
+class FieldAccessorTest : public CxxTest::TestSuite {
+    public:
+        FieldAccessorTestData getTestData() {
+            FieldAccessorTestData data;
+            data.m_name = "Hello World";
+            data.m_flag = true;
+            data.m_char = -5;
+            data.m_int8 = -128;
+            data.m_int16 = -1234;
+            data.m_uint32 = 4000000000u;
+            data.m_int64 = -123456789012LL;
+            data.m_uint64 = 18000000000000000000ull;
+            data.m_position.m_x = 1.5;
+            data.m_position.m_y = -2.25f;
+            return data;
+        }
+
+        Message getMessage(FieldAccessorTestData &data) {
+            MessageFromVisitableVisitor mfvv;
+            data.accept(mfvv);
+            return mfvv.getMessage();
+        }
+
+        bool isClose(const double &a, const double &b) {
+            return fabs(a - b) <= 1e-9 * (fabs(b) > 1 ? fabs(b) : 1);
+        }
+
+        void testCompileFieldPaths() {
+            FieldAccessorTestData data = getTestData();
+            Message msg = getMessage(data);
+
+            FieldAccessor fa;
+            TS_ASSERT(!fa.isCompiled());
+
+            TS_ASSERT(fa.compile(msg, "int16"));
+            TS_ASSERT(fa.isCompiled());
+            TS_ASSERT(fa.getDataType() == 4711);
+            TS_ASSERT(fa.getFieldPath() == "int16");
+            TS_ASSERT(fa.getFieldDataType() == odcore::data::reflection::AbstractField::INT16_T);
+
+            TS_ASSERT(fa.compile(msg, "test.Data/position.y"));
+            TS_ASSERT(fa.getFieldPath() == "position.y");
+            TS_ASSERT(fa.getFieldDataType() == odcore::data::reflection::AbstractField::FLOAT_T);
+
+            TS_ASSERT(fa.compile(msg, "Data/name"));
+            TS_ASSERT(fa.getFieldDataType() == odcore::data::reflection::AbstractField::STRING_T);
+
+            TS_ASSERT(!fa.compile(msg, "other.Data/int16"));
+            TS_ASSERT(!fa.compile(msg, "unknown"));
+            TS_ASSERT(!fa.compile(msg, "position"));
+            TS_ASSERT(!fa.compile(msg, "int16.x"));
+            TS_ASSERT(!fa.compile(msg, "position.z"));
+            TS_ASSERT(!fa.isCompiled());
+        }
+
+        void testExtractScalars() {
+            FieldAccessorTestData data = getTestData();
+            Message msg = getMessage(data);
+            Container c(data);
+
+            const string FIELDS[] = { "flag", "character", "int8", "int16", "uint32", "int64", "uint64", "position.x", "position.y" };
+            const double VALUES[] = { 1, -5, -128, -1234, 4000000000.0, -123456789012.0, 18000000000000000000.0, 1.5, -2.25 };
+
+            for (uint32_t i = 0; i < 9; i++) {
+                FieldAccessor fa;
+                TS_ASSERT(fa.compile(msg, FIELDS[i]));
+
+                bool extracted = false;
+                const double VALUE = fa.getValue(c, extracted);
+                TS_ASSERT(extracted);
+                TS_ASSERT(isClose(VALUE, VALUES[i]));
+            }
+
+            // Strings are not scalars.
+            FieldAccessor fa;
+            TS_ASSERT(fa.compile(msg, "name"));
+            bool extracted = true;
+            fa.getValue(c, extracted);
+            TS_ASSERT(!extracted);
+
+            // Containers of other data types are ignored.
+            TS_ASSERT(fa.compile(msg, "int16"));
+            Container other(data, 4712);
+            extracted = true;
+            fa.getValue(other, extracted);
+            TS_ASSERT(!extracted);
+        }
+
+        void testCompileAllAndFormat() {
+            FieldAccessorTestData data = getTestData();
+            Message msg = getMessage(data);
+            Container c(data);
+            const string PAYLOAD = c.getRawData();
+
+            vector<FieldAccessor> accessors = FieldAccessor::compileAll(msg);
+            TS_ASSERT(accessors.size() == 10);
+
+            const string PATHS[] = { "name", "flag", "character", "int8", "int16", "uint32", "int64", "uint64", "position.x", "position.y" };
+            const string VALUES[] = { "Hello World", "1", "-5", "-128", "-1234", "4000000000", "-123456789012", "18000000000000000000", "1.5", "-2.25" };
+
+            for (uint32_t i = 0; (i < accessors.size()) && (i < 10); i++) {
+                TS_ASSERT(accessors.at(i).getDataType() == 4711);
+                TS_ASSERT(accessors.at(i).getFieldPath() == PATHS[i]);
+
+                bool extracted = false;
+                TS_ASSERT(accessors.at(i).getValueAsString(PAYLOAD, extracted) == VALUES[i]);
+                TS_ASSERT(extracted);
+            }
+        }
+
+        void testFixedArrays() {
+            FieldAccessorTestArray data;
+            data.m_acceleration[0] = 1.5f;
+            data.m_acceleration[1] = -2.5f;
+            data.m_acceleration[2] = 3.5f;
+            data.m_counter = 42;
+
+            MessageFromVisitableVisitor mfvv;
+            data.accept(mfvv);
+            Message msg = mfvv.getMessage();
+            Container c(data);
+
+            // Fixed arrays report the type of their elements but cannot be accessed.
+            FieldAccessor fa;
+            TS_ASSERT(!fa.compile(msg, "acceleration"));
+            TS_ASSERT(!fa.isCompiled());
+
+            TS_ASSERT(fa.compile(msg, "counter"));
+            bool extracted = false;
+            TS_ASSERT(isClose(fa.getValue(c, extracted), 42));
+            TS_ASSERT(extracted);
+
+            bool isComplete = true;
+            vector<FieldAccessor> accessors = FieldAccessor::compileAll(msg, isComplete);
+            TS_ASSERT(!isComplete);
+            TS_ASSERT(accessors.size() == 1);
+            if (accessors.size() == 1) {
+                TS_ASSERT(accessors.at(0).getFieldPath() == "counter");
+            }
+
+            FieldAccessorTestData other = getTestData();
+            isComplete = false;
+            FieldAccessor::compileAll(getMessage(other), isComplete);
+            TS_ASSERT(isComplete);
+        }
+
+        void testTruncatedPayload() {
+            FieldAccessorTestData data = getTestData();
+            Message msg = getMessage(data);
+            Container c(data);
+            const string PAYLOAD = c.getRawData();
+
+            FieldAccessor fa;
+            TS_ASSERT(fa.compile(msg, "position.y"));
+
+            bool extracted = false;
+            fa.getValue(PAYLOAD, extracted);
+            TS_ASSERT(extracted);
+
+            for (uint32_t length = 0; length < PAYLOAD.size(); length++) {
+                extracted = true;
+                fa.getValue(PAYLOAD.substr(0, length), extracted);
+                TS_ASSERT(!extracted);
+            }
+        }
+};
+
+#endif /*CORE_FIELDACCESSORTESTSUITE_H_*/
@@ -20,17 +20,40 @@
 #ifndef CORE_NETSTRINGSPROTOCOLTESTSUITE_H_
 #define CORE_NETSTRINGSPROTOCOLTESTSUITE_H_
 
+#include <cstdlib>                      // for rand, srand
 #include <iostream>                     // for operator<<, basic_ostream, etc
 #include <string>                       // for string, char_traits, etc
+#include <vector>                       // for vector
 
 #include "cxxtest/TestSuite.h"          // for TS_ASSERT, TestSuite
 
 #include "opendavinci/odcore/io/StringListener.h"     // for StringListener
 #include "opendavinci/odcore/io/StringSender.h"       // for StringSender
+#include "opendavinci/odcore/data/TimeStamp.h"  // for TimeStamp
 #include "opendavinci/odcore/io/protocol/NetstringsProtocol.h"
 
 using namespace std;
 
+class NetstringsCollector : public odcore::io::StringListener {
+    public:
+        NetstringsCollector() :
+            m_payloads(),
+            m_numberOfPayloads(0),
+            m_keepPayloads(true) {}
+
+        void nextString(const string &s) {
+            m_numberOfPayloads++;
+            if (m_keepPayloads) {
+                m_payloads.push_back(s);
+            }
+        }
+
+    public:
+        vector<string> m_payloads;
+        uint32_t m_numberOfPayloads;
+        bool m_keepPayloads;
+};
+
 class NetstringsProtocolTest : public CxxTest::TestSuite, public odcore::io::StringListener, public odcore::io::StringSender {
     private:
         string m_receivedData;
@@ -123,6 +146,119 @@ class NetstringsProtocolTest : public CxxTest::TestSuite, public odcore::io::Str
             TS_ASSERT(m_receivedData.compare(testDataToBeSent) == 0); 
         }
 
+        void testNetstringsProtocolManyNetstringsInOneString() {
+            odcore::io::protocol::NetstringsProtocol nsp;
+            NetstringsCollector collector;
+            nsp.setStringListener(&collector);
+
+            nsp.nextString("5:Hello,0:,1:a,5:World,3:a:,,2:");
+            TS_ASSERT(collector.m_payloads.size() == 4);
+            TS_ASSERT(collector.m_payloads.at(0) == "Hello");
+            TS_ASSERT(collector.m_payloads.at(1) == "a");
+            TS_ASSERT(collector.m_payloads.at(2) == "World");
+            TS_ASSERT(collector.m_payloads.at(3) == "a:,");
+
+            // Complete the partial Netstring.
+            nsp.nextString("xy,");
+            TS_ASSERT(collector.m_payloads.size() == 5);
+            TS_ASSERT(collector.m_payloads.at(4) == "xy");
+
+            // Corrupted data is discarded.
+            nsp.nextString("3:abc;4:Test,");
+            TS_ASSERT(collector.m_payloads.size() == 5);
+            nsp.nextString("4:Test,");
+            TS_ASSERT(collector.m_payloads.size() == 6);
+            TS_ASSERT(collector.m_payloads.at(5) == "Test");
+        }
+
+        void testNetstringsProtocolFuzzing() {
+            srand(42);
+            for (uint32_t run = 0; run < 50; run++) {
+                // Create random payloads including binary data.
+                vector<string> payloads;
+                stringstream encoded;
+                const uint32_t NUMBER_OF_PAYLOADS = 1 + rand() % 200;
+                for (uint32_t i = 0; i < NUMBER_OF_PAYLOADS; i++) {
+                    string payload(1 + rand() % ((0 == i % 10) ? 5000 : 20), '\0');
+                    for (uint32_t j = 0; j < payload.size(); j++) {
+                        payload[j] = static_cast<char>(rand() % 256);
+                    }
+                    payloads.push_back(payload);
+                    encoded << payload.size() << ":" << payload << ",";
+                }
+                const string ENCODED = encoded.str();
+
+                // Deliver the encoded data in randomly sized chunks.
+                odcore::io::protocol::NetstringsProtocol nsp;
+                NetstringsCollector collector;
+                nsp.setStringListener(&collector);
+
+                uint32_t position = 0;
+                while (position < ENCODED.size()) {
+                    const uint32_t CHUNK = 1 + rand() % ((0 == run % 2) ? 7 : 3000);
+                    nsp.nextString(ENCODED.substr(position, CHUNK));
+                    position += CHUNK;
+                }
+
+                TS_ASSERT(collector.m_payloads.size() == payloads.size());
+                for (uint32_t i = 0; (i < payloads.size()) && (i < collector.m_payloads.size()); i++) {
+                    TS_ASSERT(collector.m_payloads.at(i) == payloads.at(i));
+                }
+
+                // Random garbage must not harm; afterwards, valid Netstrings are decoded again.
+                // The garbage starts without a length so that the decoder discards it entirely.
+                string garbage(1 + rand() % 100, '\0');
+                for (uint32_t j = 0; j < garbage.size(); j++) {
+                    garbage[j] = static_cast<char>(rand() % 256);
+                }
+                garbage[0] = 'X';
+                nsp.nextString(garbage);
+                TS_ASSERT(collector.m_payloads.size() == payloads.size());
+
+                nsp.nextString("6:Resync,");
+                TS_ASSERT(collector.m_payloads.size() == payloads.size() + 1);
+                nsp.nextString("3:");
+                nsp.nextString("ABC,6:Resync,");
+                TS_ASSERT(collector.m_payloads.size() == payloads.size() + 3);
+                TS_ASSERT(collector.m_payloads.at(payloads.size()) == "Resync");
+                TS_ASSERT(collector.m_payloads.at(payloads.size() + 1) == "ABC");
+                TS_ASSERT(collector.m_payloads.back() == "Resync");
+            }
+        }
+
+        void testNetstringsProtocolThroughput() {
+            // Many small Netstrings arriving with one read like DMCP messages in pulse-ack modes.
+            const uint32_t NUMBER_OF_PAYLOADS = 5000;
+            const string PAYLOAD(64, 'x');
+            stringstream encoded;
+            for (uint32_t i = 0; i < NUMBER_OF_PAYLOADS; i++) {
+                encoded << PAYLOAD.size() << ":" << PAYLOAD << ",";
+            }
+            const string ENCODED = encoded.str();
+
+            odcore::io::protocol::NetstringsProtocol nsp;
+            NetstringsCollector collector;
+            collector.m_keepPayloads = false;
+            nsp.setStringListener(&collector);
+
+            odcore::data::TimeStamp before;
+            nsp.nextString(ENCODED);
+            odcore::data::TimeStamp after;
+            TS_ASSERT(collector.m_numberOfPayloads == NUMBER_OF_PAYLOADS);
+
+            // Same data in chunks of a typical TCP read.
+            const uint32_t CHUNK = 1500;
+            for (uint32_t position = 0; position < ENCODED.size(); position += CHUNK) {
+                nsp.nextString(ENCODED.substr(position, CHUNK));
+            }
+            odcore::data::TimeStamp afterChunks;
+            TS_ASSERT(collector.m_numberOfPayloads == 2 * NUMBER_OF_PAYLOADS);
+
+            clog << "[NetstringsProtocolTestSuite] Decoded " << NUMBER_OF_PAYLOADS << " Netstrings (" << ENCODED.size() << " bytes) in "
+                 << (after - before).toMicroseconds() << " us from one string and in "
+                 << (afterChunks - after).toMicroseconds() << " us from chunks of " << CHUNK << " bytes." << endl;
+        }
+
 };
 
 #endif /*CORE_NETSTRINGSPROTOCOLTESTSUITE_H_*/
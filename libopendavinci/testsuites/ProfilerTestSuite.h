@@ -0,0 +1,164 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CORE_PROFILERTESTSUITE_H_
+#define CORE_PROFILERTESTSUITE_H_
+
+#include <chrono>                       // for milliseconds
+#include <cstdio>                       // for remove
+#include <cstring>                      // for memcmp
+#include <fstream>                      // for fstream
+#include <map>                          // for map
+#include <string>                       // for string
+#include <thread>                       // for thread
+
+#include "cxxtest/TestSuite.h"          // for TS_ASSERT, TestSuite
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Profiler.h"
+
+using namespace std;
+using namespace odcore::base;
+
+class ProfilerTest : public CxxTest::TestSuite {
+    private:
+        void recordCycles(const uint32_t &cycles) {
+            for (uint32_t i = 0; i < cycles; i++) {
+                Profiler::record(ProfilerEvent::CYCLE_BEGIN, 0, 0);
+                {
+                    OPENDAVINCI_PROFILE_SPAN("ProfilerTest::recordCycles");
+                    Profiler::record(ProfilerEvent::CONTAINER_OUT, 0, 42);
+                }
+                Profiler::record(ProfilerEvent::CYCLE_END, 0, i);
+            }
+        }
+
+    public:
+        void testDisabled() {
+            TS_ASSERT(!Profiler::isEnabled());
+            // Recording without a started profiler must not have any effect.
+            recordCycles(10);
+            TS_ASSERT(!Profiler::isEnabled());
+        }
+
+        void testRegisterName() {
+            const uint16_t A = Profiler::registerName("ProfilerTest::a");
+            const uint16_t B = Profiler::registerName("ProfilerTest::b");
+            TS_ASSERT(A > 0);
+            TS_ASSERT(B > 0);
+            TS_ASSERT(A != B);
+            TS_ASSERT(A == Profiler::registerName("ProfilerTest::a"));
+        }
+
+        void testTrace() {
+            const string FILENAME("ProfilerTestSuite.profiling.bin");
+            TS_ASSERT(Profiler::getInstance().start(FILENAME));
+            TS_ASSERT(Profiler::isEnabled());
+
+            std::thread t1(&ProfilerTest::recordCycles, this, 100);
+            std::thread t2(&ProfilerTest::recordCycles, this, 100);
+            t1.join();
+            t2.join();
+
+            Profiler::getInstance().stop();
+            TS_ASSERT(!Profiler::isEnabled());
+            TS_ASSERT(Profiler::getInstance().getNumberOfDroppedEvents() == 0);
+
+            fstream fin(FILENAME.c_str(), ios::in | ios::binary);
+            ProfilerHeader header;
+            fin.read(reinterpret_cast<char*>(&header), sizeof(header));
+            TS_ASSERT(0 == memcmp(header.m_magic, Profiler::MAGIC, sizeof(header.m_magic)));
+            TS_ASSERT(header.m_ticksPerMicrosecond > 0);
+
+            map<uint16_t, uint32_t> numberOfEvents;
+            map<uint32_t, uint64_t> lastTicks;
+            bool ordered = true;
+            string spanName;
+            ProfilerEvent e;
+            while (fin.read(reinterpret_cast<char*>(&e), sizeof(e))) {
+                if (ProfilerEvent::NAME == e.m_type) {
+                    string name(static_cast<size_t>(e.m_value), '\0');
+                    fin.read(&name[0], e.m_value);
+                    if (name == "ProfilerTest::recordCycles") {
+                        spanName = name;
+                    }
+                    continue;
+                }
+                numberOfEvents[e.m_type]++;
+
+                // Events of one thread are written in order.
+                ordered &= (e.m_ticks >= lastTicks[e.m_thread]);
+                lastTicks[e.m_thread] = e.m_ticks;
+            }
+            fin.close();
+
+            TS_ASSERT(spanName == "ProfilerTest::recordCycles");
+            TS_ASSERT(ordered);
+            TS_ASSERT(lastTicks.size() == 2);
+            TS_ASSERT(numberOfEvents[ProfilerEvent::CYCLE_BEGIN] == 200);
+            TS_ASSERT(numberOfEvents[ProfilerEvent::CYCLE_END] == 200);
+            TS_ASSERT(numberOfEvents[ProfilerEvent::SPAN_BEGIN] == 200);
+            TS_ASSERT(numberOfEvents[ProfilerEvent::SPAN_END] == 200);
+            TS_ASSERT(numberOfEvents[ProfilerEvent::CONTAINER_OUT] == 200);
+
+            ::remove(FILENAME.c_str());
+        }
+
+        void testRingsOfFinishedThreadsAreReused() {
+            const string FILENAME("ProfilerTestSuite.rings.profiling.bin");
+            TS_ASSERT(Profiler::getInstance().start(FILENAME));
+
+            // Many short-living threads must not accumulate rings.
+            for (uint32_t i = 0; i < 50; i++) {
+                std::thread t(&ProfilerTest::recordCycles, this, 10);
+                t.join();
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5 * Profiler::WRITER_INTERVAL));
+            TS_ASSERT(Profiler::getInstance().getNumberOfRings() <= Profiler::MAX_SPARE_RINGS + 1u);
+
+            Profiler::getInstance().stop();
+            TS_ASSERT(Profiler::getInstance().getNumberOfDroppedEvents() == 0);
+
+            // All events of the finished threads were written, each thread with its own identifier.
+            fstream fin(FILENAME.c_str(), ios::in | ios::binary);
+            ProfilerHeader header;
+            fin.read(reinterpret_cast<char*>(&header), sizeof(header));
+            map<uint32_t, uint32_t> numberOfCyclesPerThread;
+            ProfilerEvent e;
+            while (fin.read(reinterpret_cast<char*>(&e), sizeof(e))) {
+                if (ProfilerEvent::NAME == e.m_type) {
+                    fin.seekg(e.m_value, ios::cur);
+                    continue;
+                }
+                if (ProfilerEvent::CYCLE_END == e.m_type) {
+                    numberOfCyclesPerThread[e.m_thread]++;
+                }
+            }
+            fin.close();
+
+            TS_ASSERT(numberOfCyclesPerThread.size() == 50);
+            for (auto it : numberOfCyclesPerThread) {
+                TS_ASSERT(it.second == 10);
+            }
+
+            ::remove(FILENAME.c_str());
+        }
+};
+
+#endif /*CORE_PROFILERTESTSUITE_H_*/
@@ -0,0 +1,116 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CORE_SHAREDMEMORYCONTAINERCONFERENCETESTSUITE_H_
+#define CORE_SHAREDMEMORYCONTAINERCONFERENCETESTSUITE_H_
+
+#include <sys/mman.h>
+
+#include <memory>
+#include <string>                       // for string
+
+#include "cxxtest/TestSuite.h"          // for TS_ASSERT, TestSuite
+
+#include "opendavinci/odcore/base/FIFOQueue.h"
+#include "opendavinci/odcore/base/Thread.h"
+#include "opendavinci/odcore/data/Container.h"        // for Container, etc
+#include "opendavinci/odcore/data/TimeStamp.h"        // for TimeStamp
+#include "opendavinci/odcore/io/conference/ContainerConference.h"
+#include "opendavinci/odcore/io/conference/ContainerConferenceFactory.h"
+#include "opendavinci/odcore/io/conference/ContainerListener.h"
+#include "opendavinci/odcore/io/conference/SharedMemoryContainerConference.h"
+
+using namespace std;
+using namespace odcore::base;
+using namespace odcore::data;
+using namespace odcore::io;
+using namespace odcore::io::conference;
+
+class SharedMemoryContainerConferenceTestContainerListener : public ContainerListener {
+    public:
+        SharedMemoryContainerConferenceTestContainerListener() :
+            m_fifo() {}
+
+        virtual ~SharedMemoryContainerConferenceTestContainerListener() {}
+
+        virtual void nextContainer(Container &c) {
+            m_fifo.add(c);
+        }
+
+        FIFOQueue& getFIFO() {
+            return m_fifo;
+        }
+
+    private:
+        FIFOQueue m_fifo;
+};
+
+class SharedMemoryContainerConferenceTest : public CxxTest::TestSuite {
+    public:
+        void testSendAndReceive() {
+            const string GROUP = "225.0.0.201";
+            shm_unlink(SharedMemoryContainerConference::getName(GROUP, ContainerConferenceFactory::MULTICAST_PORT).c_str());
+
+            ContainerConferenceFactory::getInstance().setTransport(ContainerConferenceFactory::SHARED_MEMORY);
+            std::shared_ptr<ContainerConference> sender = ContainerConferenceFactory::getInstance().getContainerConference(GROUP);
+            std::shared_ptr<ContainerConference> receiver = ContainerConferenceFactory::getInstance().getContainerConference(GROUP);
+            ContainerConferenceFactory::getInstance().setTransport(ContainerConferenceFactory::UDP_MULTICAST);
+
+            TS_ASSERT(dynamic_cast<SharedMemoryContainerConference*>(sender.get()) != NULL);
+            TS_ASSERT(dynamic_cast<SharedMemoryContainerConference*>(receiver.get()) != NULL);
+
+            SharedMemoryContainerConferenceTestContainerListener senderListener;
+            SharedMemoryContainerConferenceTestContainerListener receiverListener;
+            sender->setContainerListener(&senderListener);
+            receiver->setContainerListener(&receiverListener);
+            FIFOQueue &senderFIFO = senderListener.getFIFO();
+            FIFOQueue &receiverFIFO = receiverListener.getFIFO();
+
+            for (int32_t i = 1; i <= 10; i++) {
+                Container c(TimeStamp(i, 0));
+                sender->send(c);
+            }
+
+            for (uint32_t i = 0; (i < 100) && (receiverFIFO.getSize() < 10); i++) {
+                Thread::usleepFor(10 * 1000);
+            }
+            // Wait for duplicates sent by UDP multicast.
+            Thread::usleepFor(100 * 1000);
+
+            // Every container is received exactly once and in order; the sender does not receive its own containers.
+            TS_ASSERT(receiverFIFO.getSize() == 10);
+            TS_ASSERT(senderFIFO.getSize() == 0);
+            for (int32_t i = 1; (i <= 10) && !receiverFIFO.isEmpty(); i++) {
+                Container c = receiverFIFO.leave();
+                TS_ASSERT(c.getDataType() == TimeStamp::ID());
+                TS_ASSERT(c.getData<TimeStamp>().getSeconds() == i);
+                TS_ASSERT(c.getReceivedTimeStamp().toMicroseconds() >= c.getSentTimeStamp().toMicroseconds());
+            }
+            TS_ASSERT(dynamic_cast<SharedMemoryContainerConference*>(receiver.get())->getNumberOfOverrunContainers() == 0);
+
+            sender->setContainerListener(NULL);
+            receiver->setContainerListener(NULL);
+            sender.reset();
+            receiver.reset();
+
+            shm_unlink(SharedMemoryContainerConference::getName(GROUP, ContainerConferenceFactory::MULTICAST_PORT).c_str());
+        }
+};
+
+#endif /*CORE_SHAREDMEMORYCONTAINERCONFERENCETESTSUITE_H_*/
@@ -20,12 +20,17 @@
 #ifndef CORE_WRAPPER_TCPCONNECTIONTESTSUITE_H_
 #define CORE_WRAPPER_TCPCONNECTIONTESTSUITE_H_
 
+#include <chrono>
+#include <condition_variable>
 #include <memory>                       // for unique_ptr, etc
+#include <mutex>
+#include <sstream>
 #include <string>                       // for string
 
 #include "cxxtest/TestSuite.h"          // for TS_ASSERT, TestSuite
 
 #include "opendavinci/odcore/io/Connection.h"
+#include "opendavinci/odcore/io/StringListener.h"
 #include "opendavinci/odcore/io/tcp/TCPAcceptor.h"
 #include "opendavinci/odcore/wrapper/NetworkLibraryProducts.h"
 #include "mocks/ConnectionListenerMock.h"
@@ -34,6 +39,7 @@
 
 #ifndef WIN32
     #include "opendavinci/odcore/wrapper/POSIX/POSIXTCPFactoryWorker.h"
+    #include "opendavinci/odcore/wrapper/POSIX/POSIXTCPReactor.h"
 #endif
 #ifdef WIN32
     #include "opendavinci/odcore/wrapper/WIN32/WIN32TCPFactoryWorker.h"
@@ -47,6 +53,39 @@ using namespace std;
 using namespace odcore;
 using namespace odcore::base;
 
+class TCPConnectionTestStringCollector : public odcore::io::StringListener {
+    private:
+        TCPConnectionTestStringCollector(const TCPConnectionTestStringCollector &);
+        TCPConnectionTestStringCollector& operator=(const TCPConnectionTestStringCollector &);
+
+    public:
+        TCPConnectionTestStringCollector() :
+            m_mutex(),
+            m_condition(),
+            m_data() {}
+
+        virtual void nextString(const string &s) {
+            std::lock_guard<std::mutex> l(m_mutex);
+            m_data += s;
+            m_condition.notify_all();
+        }
+
+        bool waitFor(const uint64_t &length) {
+            std::unique_lock<std::mutex> l(m_mutex);
+            return m_condition.wait_for(l, std::chrono::seconds(10), [&]{ return m_data.length() >= length; });
+        }
+
+        string getData() {
+            std::lock_guard<std::mutex> l(m_mutex);
+            return m_data;
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        string m_data;
+};
+
 template <typename worker> struct TCPConnectionTests
 {
     static void transferTest()
@@ -100,6 +139,51 @@ template <typename worker> struct TCPConnectionTests
         stmAcceptedConnection.CALLWAITER_nextString.reset();
     }
 
+    static void bulkTransferTest()
+    {
+        mocks::TCPAcceptorListenerMock am;
+
+        unique_ptr<odcore::io::tcp::TCPAcceptor> acceptor(worker::createTCPAcceptor(20006));
+        acceptor->setAcceptorListener(&am);
+        acceptor->start();
+
+        unique_ptr<odcore::io::tcp::TCPConnection> connection(worker::createTCPConnectionTo("127.0.0.1", 20006));
+        connection->start();
+
+        TS_ASSERT(am.CALLWAITER_onNewConnection.wait());
+        TCPConnectionTestStringCollector collector;
+        am.getConnection()->setStringListener(&collector);
+        am.getConnection()->start();
+
+        // Many small sends followed by one send exceeding the socket's buffers.
+        string expected;
+        for (uint32_t i = 0; i < 10000; i++) {
+            stringstream sstr;
+            sstr << "Message " << i << ";";
+            expected += sstr.str();
+            connection->send(sstr.str());
+        }
+        string large(8 * 1024 * 1024, ' ');
+        for (uint32_t i = 0; i < large.length(); i++) {
+            large[i] = static_cast<char>('a' + (i % 26));
+        }
+        expected += large;
+        connection->send(large);
+
+        TS_ASSERT(collector.waitFor(expected.length()));
+        TS_ASSERT(collector.getData() == expected);
+
+        // The other direction.
+        TCPConnectionTestStringCollector collector2;
+        connection->setStringListener(&collector2);
+        am.getConnection()->send(large);
+        TS_ASSERT(collector2.waitFor(large.length()));
+        TS_ASSERT(collector2.getData() == large);
+
+        connection->setStringListener(NULL);
+        am.getConnection()->setStringListener(NULL);
+    }
+
     static void errorTest() {
         bool failed = true;
         try {
@@ -180,6 +264,25 @@ class TCPConnectionTestSuite  : public CxxTest::TestSuite
             #endif
         }
 
+        void testBulkTransfer()
+        {
+            #ifndef WIN32
+                clog << endl << "TCPConnectionTestSuite::testBulkTransfer using NetworkLibraryPosix" << endl;
+                TCPConnectionTests
+                <
+                     odcore::wrapper::TCPFactoryWorker<odcore::wrapper::NetworkLibraryPosix>
+                >::bulkTransferTest();
+
+                odcore::wrapper::POSIX::POSIXTCPReactor *reactor = odcore::wrapper::POSIX::POSIXTCPReactor::getInstance();
+                if (NULL != reactor) {
+                    clog << reactor->toString() << endl;
+                    TS_ASSERT(reactor->getNumberOfThreads() > 0);
+                    TS_ASSERT(reactor->getReceivedBytes() > 2 * 8 * 1024 * 1024);
+                    TS_ASSERT(reactor->getSentBytes() > 2 * 8 * 1024 * 1024);
+                }
+            #endif
+        }
+
         void testError()
         {
             #ifdef WIN32
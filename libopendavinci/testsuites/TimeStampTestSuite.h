@@ -23,6 +23,7 @@
 #include "cxxtest/TestSuite.h"          // for TS_ASSERT, TestSuite
 
 #include "opendavinci/odcore/data/TimeStamp.h"        // for TimeStamp
+#include "opendavinci/odcore/wrapper/SystemClock.h"
 
 using namespace std;
 using namespace odcore::data;
@@ -85,6 +86,56 @@ class TimeStampTest : public CxxTest::TestSuite {
             TS_ASSERT(ts2.getMinute() == 42);
             TS_ASSERT(ts2.getSecond() == 54);
         }
+
+        void testHumanReadableRepresentationFollowsSeconds() {
+            TimeStamp ts(1240926174, 1234);
+            TS_ASSERT(ts.getSecond() == 54);
+
+            ts.setSeconds(1240926175);
+            TS_ASSERT(ts.getSecond() == 55);
+
+            TimeStamp ts2;
+            ts2 = ts;
+            TS_ASSERT(ts2.getDay() == 28);
+            TS_ASSERT(ts2.getSecond() == 55);
+        }
+
+        void testNowUsesSystemClock() {
+            int32_t seconds = 0;
+            int32_t microseconds = 0;
+            odcore::wrapper::SystemClock::getRealtime(seconds, microseconds);
+            TimeStamp now;
+
+            TS_ASSERT(seconds > 1000);
+            TS_ASSERT( (microseconds >= 0) && (microseconds < 1000000) );
+            TS_ASSERT( (now.getFractionalMicroseconds() >= 0) && (now.getFractionalMicroseconds() < 1000000) );
+            TS_ASSERT(now.toMicroseconds() - (seconds * 1000000L + microseconds) >= 0);
+            TS_ASSERT(now.toMicroseconds() - (seconds * 1000000L + microseconds) < 1000000L);
+        }
+
+        void testMonotonicClock() {
+            int64_t last = odcore::wrapper::SystemClock::getMonotonicMicroseconds();
+            for (uint32_t i = 0; i < 100000; i++) {
+                const int64_t CURRENT = odcore::wrapper::SystemClock::getMonotonicMicroseconds();
+                TS_ASSERT(CURRENT >= last);
+                last = CURRENT;
+            }
+        }
+
+        void testTicks() {
+            const double TICKS_PER_MICROSECOND = odcore::wrapper::SystemClock::getTicksPerMicrosecond();
+            TS_ASSERT(TICKS_PER_MICROSECOND > 0);
+
+            const uint64_t START = odcore::wrapper::SystemClock::getTicks();
+            const int64_t START_US = odcore::wrapper::SystemClock::getMonotonicMicroseconds();
+            while (odcore::wrapper::SystemClock::getMonotonicMicroseconds() - START_US < 10000) {}
+            const uint64_t END = odcore::wrapper::SystemClock::getTicks();
+
+            // 10ms busy waiting must roughly match the calibrated ticks.
+            const double DURATION = static_cast<double>(END - START) / TICKS_PER_MICROSECOND;
+            TS_ASSERT(DURATION > 5000);
+            TS_ASSERT(DURATION < 100000);
+        }
 };
 
 #endif /*CORE_TIMESTAMPTESTSUITE_H_*/
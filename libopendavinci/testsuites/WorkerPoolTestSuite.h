@@ -0,0 +1,83 @@
+/**
+ * OpenDaVINCI - Portable middleware for distributed components.
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CORE_WORKERPOOLTESTSUITE_H_
+#define CORE_WORKERPOOLTESTSUITE_H_
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "cxxtest/TestSuite.h"
+
+#include "opendavinci/odcore/base/WorkerPool.h"
+
+using namespace std;
+using namespace odcore::base;
+
+class WorkerPoolTest : public CxxTest::TestSuite {
+    public:
+        static uint32_t square(const uint32_t value) {
+            return value * value;
+        }
+
+        static void countConcurrentTasks(std::atomic<uint32_t> *running, std::atomic<uint32_t> *maximum) {
+            const uint32_t RUNNING = ++(*running);
+            uint32_t previous = maximum->load();
+            while ( (RUNNING > previous) && !maximum->compare_exchange_weak(previous, RUNNING) ) {}
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            (*running)--;
+        }
+
+        void testResults() {
+            WorkerPool pool(0);
+            TS_ASSERT(pool.getNumberOfWorkers() >= 1);
+
+            vector<std::future<uint32_t> > results;
+            for (uint32_t i = 0; i < 100; i++) {
+                results.push_back(pool.submit(std::bind(&WorkerPoolTest::square, i)));
+            }
+            for (uint32_t i = 0; i < results.size(); i++) {
+                TS_ASSERT_EQUALS(results.at(i).get(), i * i);
+            }
+        }
+
+        void testNumberOfWorkersIsBounded() {
+            std::atomic<uint32_t> running(0);
+            std::atomic<uint32_t> maximum(0);
+            {
+                WorkerPool pool(2);
+                TS_ASSERT_EQUALS(pool.getNumberOfWorkers(), 2u);
+                for (uint32_t i = 0; i < 20; i++) {
+                    pool.submit(std::bind(&WorkerPoolTest::countConcurrentTasks, &running, &maximum));
+                }
+            }
+
+            // All tasks are finished when the pool is destroyed.
+            TS_ASSERT_EQUALS(running.load(), 0u);
+            TS_ASSERT(maximum.load() >= 1);
+            TS_ASSERT(maximum.load() <= 2);
+        }
+};
+
+#endif /*CORE_WORKERPOOLTESTSUITE_H_*/
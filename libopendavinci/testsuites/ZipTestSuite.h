@@ -96,6 +96,120 @@ class ZipTest : public CxxTest::TestSuite {
             UNLINK("ZipTest.zip");
         }
 
+        void testLazyDecompressionOfStoredAndDeflatedEntries() {
+            // Create zip file containing one stored and one deflated entry.
+            stringstream archiveData;
+            archiveData.str("80 75 3 4 20 0 0 0 0 0 0 0 33 74 3 -1 -119 86 47 0 0 0 47 0 0 0 10 0 0 0 83 116 111 114 101 100 46 116 120 116 68 105 101 115 32 105 115 116 32 101 105 110 32 84 101 115 116 46 10 68 105 101 115 32 105 115 116 32 101 105 110 101 32 122 119 101 105 116 101 32 90 101 105 108 101 46 10 80 75 3 4 20 0 0 0 8 0 0 0 33 74 -97 -108 -57 22 57 0 0 0 76 0 0 0 12 0 0 0 100 101 102 108 97 116 101 100 46 116 120 116 115 -55 76 45 86 -56 44 46 81 72 -51 -52 83 -88 42 79 -51 44 73 45 82 8 73 45 46 -47 -29 114 65 -110 74 -123 -54 41 68 -91 102 -26 -92 42 0 -43 -90 0 -43 65 -60 -14 20 92 18 75 82 51 -11 -72 0 80 75 1 2 20 3 20 0 0 0 0 0 0 0 33 74 3 -1 -119 86 47 0 0 0 47 0 0 0 10 0 0 0 0 0 0 0 0 0 0 0 -128 1 0 0 0 0 83 116 111 114 101 100 46 116 120 116 80 75 1 2 20 3 20 0 0 0 8 0 0 0 33 74 -97 -108 -57 22 57 0 0 0 76 0 0 0 12 0 0 0 0 0 0 0 0 0 0 0 -128 1 87 0 0 0 100 101 102 108 97 116 101 100 46 116 120 116 80 75 5 6 0 0 0 0 2 0 2 0 114 0 0 0 -70 0 0 0 0 0");
+            int32_t data = 0;
+            fstream fout("ZipTest2.zip", ios::binary | ios::out);
+            while (archiveData.good()) {
+                archiveData >> data;
+                fout << (char)data;
+            }
+            fout.close();
+
+            fstream fin("ZipTest2.zip", ios::binary | ios::in);
+            std::shared_ptr<odcore::wrapper::DecompressedData> dd = odcore::wrapper::CompressionFactory::getContents(fin);
+            TS_ASSERT(dd.get());
+            fin.close();
+
+            vector<string> entries = dd->getListOfEntries();
+            TS_ASSERT(entries.size() == 2);
+            TS_ASSERT(entries.at(0) == "deflated.txt");
+            TS_ASSERT(entries.at(1) == "stored.txt");
+
+            stringstream storedData;
+            storedData << "Dies ist ein Test." << endl
+                       << "Dies ist eine zweite Zeile." << endl;
+            stringstream deflatedData;
+            deflatedData << "Dies ist ein zweiter Test." << endl
+                         << "Dies ist eine zweite Zeile in der zweiten Datei." << endl;
+
+            std::shared_ptr<istream> stored = dd->getInputStreamFor("STORED.TXT");
+            std::shared_ptr<istream> deflated = dd->getInputStreamFor("deflated.txt");
+            TS_ASSERT(stored.get());
+            TS_ASSERT(deflated.get());
+
+            // Streams remain valid after the decompressed data is released.
+            dd.reset();
+
+            if (stored.get()) {
+                string s;
+                (*stored) >> s;
+                TS_ASSERT(s == "Dies");
+
+                stored->seekg(5);
+                (*stored) >> s;
+                TS_ASSERT(s == "ist");
+
+                stored->seekg(0);
+                char c;
+                stringstream decompressedData;
+                while (stored->get(c)) {
+                    decompressedData << c;
+                }
+                TS_ASSERT(decompressedData.str() == storedData.str());
+            }
+
+            if (deflated.get()) {
+                string line;
+                getline(*deflated, line);
+                TS_ASSERT(line == "Dies ist ein zweiter Test.");
+
+                deflated->seekg(-7, ios::end);
+                getline(*deflated, line);
+                TS_ASSERT(line == "Datei.");
+
+                deflated->seekg(0);
+                char c;
+                stringstream decompressedData;
+                while (deflated->get(c)) {
+                    decompressedData << c;
+                }
+                TS_ASSERT(decompressedData.str() == deflatedData.str());
+            }
+
+            UNLINK("ZipTest2.zip");
+        }
+
+        void testDecompressionInPlace() {
+            // Create zip file containing one stored entry.
+            stringstream archiveData;
+            archiveData.str("80 75 3 4 20 0 0 0 0 0 0 0 33 74 3 -1 -119 86 47 0 0 0 47 0 0 0 10 0 0 0 83 116 111 114 101 100 46 116 120 116 68 105 101 115 32 105 115 116 32 101 105 110 32 84 101 115 116 46 10 68 105 101 115 32 105 115 116 32 101 105 110 101 32 122 119 101 105 116 101 32 90 101 105 108 101 46 10 80 75 1 2 20 3 20 0 0 0 0 0 0 0 33 74 3 -1 -119 86 47 0 0 0 47 0 0 0 10 0 0 0 0 0 0 0 0 0 0 0 -128 1 0 0 0 0 83 116 111 114 101 100 46 116 120 116 80 75 5 6 0 0 0 0 1 0 1 0 56 0 0 0 87 0 0 0 0 0");
+            int32_t data = 0;
+            fstream fout("ZipTest3.zip", ios::binary | ios::out);
+            while (archiveData.good()) {
+                archiveData >> data;
+                fout << (char)data;
+            }
+            fout.close();
+
+            std::shared_ptr<odcore::wrapper::DecompressedData> dd = odcore::wrapper::CompressionFactory::getContents("ZipTest3.zip");
+            TS_ASSERT(dd.get());
+
+            vector<string> entries = dd->getListOfEntries();
+            TS_ASSERT(entries.size() == 1);
+            TS_ASSERT(entries.at(0) == "stored.txt");
+
+            std::shared_ptr<istream> stored = dd->getInputStreamFor("stored.txt");
+            TS_ASSERT(stored.get());
+            dd.reset();
+
+            if (stored.get()) {
+                string line;
+                getline(*stored, line);
+                TS_ASSERT(line == "Dies ist ein Test.");
+            }
+            stored.reset();
+
+            // The original file is neither copied nor removed.
+            fstream fin("ZipTest3.zip", ios::binary | ios::in);
+            TS_ASSERT(fin.good());
+            fin.close();
+
+            UNLINK("ZipTest3.zip");
+        }
+
 };
 
 #endif /*CORE_ZIPTESTSUITE_H_*/
@@ -44,6 +44,23 @@ class ZlibTest : public CxxTest::TestSuite {
             TS_ASSERT(odcore::strings::StringToolbox::equalsIgnoreCase(input, decompressedOutput));
         }
 
+        void testCompressionDecompressionOfLargeBinaryData() {
+            string input;
+            for (uint32_t i = 0; i < 100000; i++) {
+                input.push_back(static_cast<char>((i * i) % 7));
+            }
+
+            string compressedOutput = Zlib::compress(input);
+            TS_ASSERT(compressedOutput.size() > 0);
+            TS_ASSERT(compressedOutput.size() < input.size());
+
+            string decompressedOutput = Zlib::decompress(compressedOutput);
+            TS_ASSERT(decompressedOutput == input);
+
+            // Corrupt data must not be decompressed.
+            TS_ASSERT(Zlib::decompress(compressedOutput.substr(0, compressedOutput.size() / 2)).size() == 0);
+        }
+
 };
 
 #endif /*CORE_ZLIBTESTSUITE_H_*/
@@ -0,0 +1,186 @@
+/**
+ * OpenDLV - Simulation environment
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+// This benchmark measures the frame rate of rendering and reading back
+// camera images with PixelReadback, synchronously and asynchronously. It
+// runs without a display on an EGL surfaceless context (e.g. Mesa) and
+// renders into a framebuffer object. The contents of every returned image
+// are checked against the frame that it is expected to show.
+//
+// Usage: opendlv-pixelreadback-benchmark [number of views] [number of frames]
+
+#define GL_GLEXT_PROTOTYPES
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendlv/threeD/PixelReadback.h"
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+using namespace std;
+using namespace opendlv::threeD;
+
+const uint32_t WIDTH = 640;
+const uint32_t HEIGHT = 480;
+
+bool createContext() {
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    EGLDisplay display = (getPlatformDisplay != NULL) ? getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL) : eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    EGLint major = 0;
+    EGLint minor = 0;
+    if ( (display == EGL_NO_DISPLAY) || (!eglInitialize(display, &major, &minor)) ) {
+        cerr << "PixelReadbackBenchmark: EGL cannot be initialized." << endl;
+        return false;
+    }
+    eglBindAPI(EGL_OPENGL_API);
+
+    const EGLint ATTRIBUTES[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+    EGLConfig config = NULL;
+    EGLint numberOfConfigs = 0;
+    eglChooseConfig(display, ATTRIBUTES, &config, 1, &numberOfConfigs);
+
+    EGLContext context = eglCreateContext(display, (numberOfConfigs > 0) ? config : NULL, EGL_NO_CONTEXT, NULL);
+    if ( (context == EGL_NO_CONTEXT) || (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) ) {
+        cerr << "PixelReadbackBenchmark: OpenGL context cannot be created (" << eglGetError() << ")." << endl;
+        return false;
+    }
+    return true;
+}
+
+void createFramebuffer(const uint32_t &numberOfViews) {
+    GLuint framebuffer = 0;
+    GLuint renderbuffers[2];
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glGenRenderbuffers(2, renderbuffers);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[0]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, WIDTH * numberOfViews, HEIGHT);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffers[0]);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[1]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, WIDTH * numberOfViews, HEIGHT);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, renderbuffers[1]);
+}
+
+void render(const uint32_t &frame, const PixelReadback &readback) {
+    for (uint32_t view = 0; view < readback.getNumberOfViews(); view++) {
+        readback.setViewport(view);
+
+        // The red channel encodes the frame and the green channel the view.
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(view * WIDTH, 0, WIDTH, HEIGHT);
+        glClearColor((frame % 256) / 255.0f, (view % 256) / 255.0f, 0.5f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glDisable(GL_SCISSOR_TEST);
+
+        // Some geometry to keep the renderer busy; it leaves the corners untouched.
+        glBegin(GL_TRIANGLES);
+        glColor3f(0.2f, 0.8f, 0.3f);
+        for (uint32_t i = 0; i < 2000; i++) {
+            const float ANGLE = i * 0.01f + frame * 0.1f;
+            glVertex3f(cos(ANGLE) * 0.8f, sin(ANGLE) * 0.8f, 0);
+            glVertex3f(cos(ANGLE + 0.3f) * 0.5f, sin(ANGLE + 0.3f) * 0.5f, 0);
+            glVertex3f(0, 0, 0);
+        }
+        glEnd();
+    }
+}
+
+bool showsFrame(const char *image, const uint32_t &frame, const uint32_t &view) {
+    // The first pixel of a BGR image.
+    const unsigned char *PIXEL = reinterpret_cast<const unsigned char*>(image);
+    return (abs(static_cast<int32_t>(PIXEL[2]) - static_cast<int32_t>(frame % 256)) <= 1) &&
+           (abs(static_cast<int32_t>(PIXEL[1]) - static_cast<int32_t>(view % 256)) <= 1);
+}
+
+uint32_t run(const uint32_t &numberOfViews, const uint32_t &numberOfFrames, const bool &allowAsynchronous) {
+    PixelReadback readback(WIDTH, HEIGHT, numberOfViews, allowAsynchronous);
+    const bool IS_ASYNCHRONOUS = readback.isAsynchronous();
+
+    vector<vector<char> > images(numberOfViews, vector<char>(WIDTH * HEIGHT * PixelReadback::BYTES_PER_PIXEL));
+    vector<char*> listOfImages;
+    for (uint32_t view = 0; view < numberOfViews; view++) {
+        listOfImages.push_back(&(images.at(view)[0]));
+    }
+
+    uint32_t errors = 0;
+    const chrono::steady_clock::time_point START = chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < numberOfFrames; frame++) {
+        render(frame, readback);
+        const bool HAS_IMAGES = readback.read(listOfImages);
+
+        // Asynchronously, the first frame is returned at once, the second
+        // call returns nothing, and all further calls the previous frame.
+        if (IS_ASYNCHRONOUS && (frame == 1)) {
+            errors += (HAS_IMAGES ? 1 : 0);
+            continue;
+        }
+        if (!HAS_IMAGES) {
+            errors++;
+            continue;
+        }
+
+        const uint32_t EXPECTED = (IS_ASYNCHRONOUS && (frame > 0)) ? frame - 1 : frame;
+        for (uint32_t view = 0; view < numberOfViews; view++) {
+            errors += (showsFrame(listOfImages.at(view), EXPECTED, view) ? 0 : 1);
+        }
+    }
+    glFinish();
+    const double SECONDS = chrono::duration<double>(chrono::steady_clock::now() - START).count();
+
+    cout << (IS_ASYNCHRONOUS ? "asynchronous" : "synchronous") << ": "
+         << numberOfViews << " view(s), "
+         << numberOfFrames / SECONDS << " frames/s, "
+         << (numberOfFrames * numberOfViews) / SECONDS << " images/s, "
+         << errors << " error(s)" << endl;
+
+    return errors;
+}
+
+int32_t main(int32_t argc, char **argv) {
+    const uint32_t NUMBER_OF_VIEWS = (argc > 1) ? static_cast<uint32_t>(atoi(argv[1])) : 1;
+    const uint32_t NUMBER_OF_FRAMES = (argc > 2) ? static_cast<uint32_t>(atoi(argv[2])) : 200;
+    if ( (NUMBER_OF_VIEWS == 0) || (NUMBER_OF_FRAMES < 2) ) {
+        cerr << "Usage: " << argv[0] << " [number of views] [number of frames >= 2]" << endl;
+        return 1;
+    }
+
+    if (!createContext()) {
+        return 1;
+    }
+    createFramebuffer(NUMBER_OF_VIEWS);
+    cout << "PixelReadbackBenchmark: " << glGetString(GL_RENDERER) << ", " << WIDTH << "x" << HEIGHT << endl;
+
+    uint32_t errors = run(NUMBER_OF_VIEWS, NUMBER_OF_FRAMES, false);
+    errors += run(NUMBER_OF_VIEWS, NUMBER_OF_FRAMES, true);
+
+    return (errors == 0) ? 0 : 1;
+}
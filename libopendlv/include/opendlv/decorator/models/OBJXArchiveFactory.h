@@ -21,6 +21,8 @@
 #define HESPERIA_CORE_DECORATOR_MODELS_OBJXARCHIVEFACTORY_H_
 
 #include <iostream>
+#include <memory>
+#include <string>
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/base/Mutex.h"
@@ -28,6 +30,8 @@
 
 #include "opendlv/decorator/models/OBJXArchive.h"
 
+namespace odcore { namespace wrapper { class DecompressedData; } }
+
 namespace opendlv {
     namespace decorator {
         namespace models {
@@ -85,6 +89,26 @@ namespace opendlv {
                      */
                     OBJXArchive* getOBJXArchive(istream &in) throw (odcore::exceptions::InvalidArgumentException);
 
+                    /**
+                     * This method returns the OBJXArchive data structure
+                     * for a file that is read in place without copying it.
+                     *
+                     * @param fileName OBJX archive file.
+                     * @return OBJXArchive.
+                     * @throws InvalidArgumentException if the file could not be used to create the data structure.
+                     */
+                    OBJXArchive* getOBJXArchive(const string &fileName) throw (odcore::exceptions::InvalidArgumentException);
+
+                private:
+                    /**
+                     * This method creates the OBJXArchive data structure
+                     * from an archive's contents.
+                     *
+                     * @param data Contents of the archive.
+                     * @return OBJXArchive or NULL if data is not available.
+                     */
+                    OBJXArchive* getOBJXArchive(std::shared_ptr<odcore::wrapper::DecompressedData> data);
+
                 private:
                     static odcore::base::Mutex m_singletonMutex;
                     static OBJXArchiveFactory* m_singleton;
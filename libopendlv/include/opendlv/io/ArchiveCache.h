@@ -0,0 +1,240 @@
+/**
+ * OpenDLV - Simulation environment
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef HESPERIA_IO_ARCHIVECACHE_H_
+#define HESPERIA_IO_ARCHIVECACHE_H_
+
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Mutex.h"
+
+namespace opendlv {
+    namespace io {
+
+        using namespace std;
+
+        /**
+         * This class provides an on-disk cache for preprocessed contents
+         * of SCNX and OBJX archives that is shared among all processes
+         * on one machine. Entries are identified by keys that are derived
+         * either from a hash of the original data or from the metadata of
+         * the original file; they are written atomically and are mapped
+         * read-only into memory when read. Every entry starts with a header
+         * containing a magic number, the format's version, and a checksum;
+         * entries not matching their header are ignored.
+         *
+         * The cache is located in the directory denoted by the environment
+         * variable OPENDLV_ARCHIVE_CACHE; if this variable is set to an
+         * empty value, the cache is disabled. Otherwise, the directory
+         * opendlv-archive-cache-<uid> in the temporary directory is used.
+         * The directory is created with mode 0700; an existing directory
+         * is only used if it is owned by the current user and neither
+         * writable by its group nor by others.
+         */
+        class OPENDAVINCI_API ArchiveCache {
+            private:
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 */
+                ArchiveCache(const ArchiveCache &);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 */
+                ArchiveCache& operator=(const ArchiveCache &);
+
+            public:
+                enum {
+                    // Version of the entries' header.
+                    FORMAT_VERSION = 1,
+                    // Size of the entries' header in bytes.
+                    HEADER_SIZE = 32
+                };
+
+                static const char MAGIC[8];
+
+                /**
+                 * This class represents the read-only contents of one
+                 * cache entry.
+                 */
+                class OPENDAVINCI_API Entry {
+                    private:
+                        Entry(const Entry &);
+                        Entry& operator=(const Entry &);
+
+                    public:
+                        /**
+                         * Constructor.
+                         *
+                         * @param fileName File to be mapped.
+                         */
+                        Entry(const string &fileName);
+
+                        virtual ~Entry();
+
+                        /**
+                         * @return true if the file could be mapped and matches its header.
+                         */
+                        bool isValid() const;
+
+                        /**
+                         * @return Pointer to the contents without the header.
+                         */
+                        const char* getData() const;
+
+                        /**
+                         * @return Size of the contents in bytes.
+                         */
+                        uint64_t getSize() const;
+
+                    private:
+                        const char *m_mapping;
+                        uint64_t m_sizeOfMapping;
+                        const char *m_data;
+                        uint64_t m_size;
+                        // Contents on platforms without memory mapped files.
+                        vector<char> m_buffer;
+                };
+
+                /**
+                 * This class reads the contents of an entry directly
+                 * from the mapped file without copying them.
+                 */
+                class OPENDAVINCI_API EntryStreamBuffer : public streambuf {
+                    private:
+                        EntryStreamBuffer(const EntryStreamBuffer &);
+                        EntryStreamBuffer& operator=(const EntryStreamBuffer &);
+
+                    public:
+                        /**
+                         * Constructor.
+                         *
+                         * @param entry Entry to be read; it is kept mapped while reading.
+                         */
+                        EntryStreamBuffer(std::shared_ptr<Entry> entry);
+
+                        virtual ~EntryStreamBuffer();
+
+                    protected:
+                        virtual pos_type seekoff(off_type off, ios_base::seekdir dir, ios_base::openmode which = ios_base::in);
+
+                        virtual pos_type seekpos(pos_type pos, ios_base::openmode which = ios_base::in);
+
+                    private:
+                        std::shared_ptr<Entry> m_entry;
+                };
+
+            private:
+                ArchiveCache();
+
+            public:
+                virtual ~ArchiveCache();
+
+                /**
+                 * This method returns a static instance for this cache.
+                 *
+                 * @return Instance of this cache.
+                 */
+                static ArchiveCache& getInstance();
+
+                /**
+                 * This method computes a 64 bit FNV-1a hash.
+                 *
+                 * @param data Data to be hashed.
+                 * @param length Length of the data.
+                 * @return Hash of the data.
+                 */
+                static uint64_t getHash(const char *data, const uint64_t &length);
+
+                /**
+                 * This method computes a key for the cache.
+                 *
+                 * @param prefix Prefix describing the kind of the entry including its format's version.
+                 * @param data Original data the entry is derived from.
+                 * @return Key.
+                 */
+                static string getKey(const string &prefix, const string &data);
+
+                /**
+                 * This method computes a key for the cache from the name,
+                 * size, and modification time of a file without reading it.
+                 *
+                 * @param prefix Prefix describing the kind of the entry including its format's version.
+                 * @param fileName File the entry is derived from.
+                 * @return Key or an empty string if the file does not exist.
+                 */
+                static string getKeyForFile(const string &prefix, const string &fileName);
+
+                /**
+                 * @return true if the cache is enabled.
+                 */
+                bool isEnabled() const;
+
+                /**
+                 * This method returns the entry for the given key.
+                 *
+                 * @param key Key of the entry.
+                 * @return Entry or NULL if there is no such entry.
+                 */
+                std::shared_ptr<Entry> get(const string &key) const;
+
+                /**
+                 * This method stores an entry for the given key. Failures
+                 * are ignored as the cache is only an optimization.
+                 *
+                 * @param key Key of the entry.
+                 * @param data Contents of the entry.
+                 */
+                void put(const string &key, const string &data);
+
+            private:
+                /**
+                 * @return Name of the file for the given key.
+                 */
+                string getFileName(const string &key) const;
+
+                /**
+                 * This method creates the cache's directory if necessary
+                 * and checks that no other user can modify its entries.
+                 *
+                 * @return true if the directory can be used.
+                 */
+                bool prepareDirectory() const;
+
+            private:
+                static odcore::base::Mutex m_singletonMutex;
+                static ArchiveCache* m_singleton;
+
+                string m_directory;
+                odcore::base::Mutex m_temporaryFilesMutex;
+                uint32_t m_numberOfTemporaryFiles;
+        };
+
+    }
+} // opendlv::io
+
+#endif /*HESPERIA_IO_ARCHIVECACHE_H_*/
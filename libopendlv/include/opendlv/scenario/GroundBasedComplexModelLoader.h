@@ -20,10 +20,13 @@
 #ifndef HESPERIA_SCENARIO_GROUNDBASEDCOMPLEXMODELLOADER_H_
 #define HESPERIA_SCENARIO_GROUNDBASEDCOMPLEXMODELLOADER_H_
 
+#include <string>
+
 #include "opendavinci/odcore/opendavinci.h"
 
 #include "opendlv/scenario/SCNXArchive.h"
 #include "opendlv/threeD/TransformGroup.h"
+#include "opendlv/threeD/loaders/OBJXArchive.h"
 
 namespace opendlv {
     namespace scenario {
@@ -33,6 +36,8 @@ namespace opendlv {
         /**
          * This class traverses the list of ground based complex
          * models and returns a renderable tranformation group.
+         * Distinct model files are decompressed and parsed in
+         * parallel before the scene graph is created.
          */
         class OPENDAVINCI_API GroundBasedComplexModelLoader {
             private:
@@ -56,6 +61,16 @@ namespace opendlv {
                 virtual ~GroundBasedComplexModelLoader();
 
                 threeD::TransformGroup* getGroundBasedComplexModels(const scenario::SCNXArchive &scnxArchive) const;
+
+            private:
+                /**
+                 * This method loads and parses one model file.
+                 *
+                 * @param scnxArchive SCNXArchive containing the model file.
+                 * @param modelFile Name of the model file.
+                 * @return OBJXArchive or NULL if the model file could not be loaded.
+                 */
+                static threeD::loaders::OBJXArchive* loadModel(const scenario::SCNXArchive &scnxArchive, const string &modelFile);
         };
 
     }
@@ -124,6 +124,15 @@ namespace opendlv {
                  */
                 std::shared_ptr<istream> getModelData(const string &modelFile) const;
 
+            private:
+                /**
+                 * This method decodes an image from the archive.
+                 *
+                 * @param stream Stream to read the image from.
+                 * @return Image or NULL if the image could not be decoded.
+                 */
+                static core::wrapper::Image* decodeImage(std::shared_ptr<istream> stream);
+
             private:
                 data::scenario::Scenario m_scenario;
                 std::shared_ptr<odcore::wrapper::DecompressedData> m_decompressedData;
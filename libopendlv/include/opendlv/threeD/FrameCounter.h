@@ -36,12 +36,24 @@ namespace opendlv {
 
                 void update();
 
+                // Measures the time spent for drawing a frame; endFrame() calls update().
+                void beginFrame();
+
+                void endFrame();
+
                 double getFPS();
 
+                // Average time in ms between beginFrame() and endFrame() during the last second.
+                double getFrameTime();
+
             protected:
                 uint32_t m_frameCounter;
                 odcore::data::TimeStamp m_lastFrame;
                 double m_fps;
+                odcore::data::TimeStamp m_beginOfFrame;
+                uint32_t m_timedFrames;
+                int64_t m_accumulatedFrameTime;
+                double m_frameTime;
         };
     }
 }
@@ -0,0 +1,94 @@
+/**
+ * OpenDLV - Simulation environment
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef HESPERIA_THREED_FRUSTUM_H_
+#define HESPERIA_THREED_FRUSTUM_H_
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendlv/data/environment/Point3.h"
+
+namespace opendlv {
+    namespace threeD {
+
+        /**
+         * This class represents the six clipping planes of the view
+         * frustum in the coordinate system of the current model. It
+         * is used to skip nodes whose axis-aligned bounding boxes are
+         * completely outside of the visible volume. A default frustum
+         * does not reject anything.
+         */
+        class OPENDAVINCI_API Frustum {
+            public:
+                Frustum();
+
+                /**
+                 * Copy constructor.
+                 *
+                 * @param obj Reference to an object of this class.
+                 */
+                Frustum(const Frustum &obj);
+
+                virtual ~Frustum();
+
+                /**
+                 * Assignment operator.
+                 *
+                 * @param obj Reference to an object of this class.
+                 * @return Reference to this instance.
+                 */
+                Frustum& operator=(const Frustum &obj);
+
+                /**
+                 * This method computes the clipping planes from the given
+                 * matrices in OpenGL's column-major order.
+                 *
+                 * @param projection Projection matrix.
+                 * @param modelView Model view matrix.
+                 */
+                void update(const double *projection, const double *modelView);
+
+                /**
+                 * This method computes the clipping planes from OpenGL's
+                 * current projection and model view matrices.
+                 */
+                void updateFromOpenGL();
+
+                /**
+                 * This method checks whether an axis-aligned bounding box
+                 * is at least partially inside of the frustum.
+                 *
+                 * @param minimum Minimum corner of the bounding box.
+                 * @param maximum Maximum corner of the bounding box.
+                 * @return false if the bounding box is completely outside.
+                 */
+                bool isVisible(const opendlv::data::environment::Point3 &minimum, const opendlv::data::environment::Point3 &maximum) const;
+
+            private:
+                enum {
+                    NUMBER_OF_PLANES = 6
+                };
+
+                // Planes (a, b, c, d) with a*x + b*y + c*z + d >= 0 inside.
+                double m_planes[NUMBER_OF_PLANES][4];
+        };
+
+    }
+} // opendlv::threeD
+
+#endif /*HESPERIA_THREED_FRUSTUM_H_*/
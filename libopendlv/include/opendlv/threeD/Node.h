@@ -22,6 +22,7 @@
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/wrapper/Disposable.h"
+#include "opendlv/data/environment/Point3.h"
 #include "opendlv/threeD/NodeDescriptor.h"
 
 namespace opendlv {
@@ -70,6 +71,27 @@ class RenderingConfiguration;
                  */
                 virtual void render(RenderingConfiguration &renderingConfiguration) = 0;
 
+                /**
+                 * This method returns the axis-aligned bounding box of this
+                 * node's content in its own coordinate system. Nodes without
+                 * a known extent are never culled.
+                 *
+                 * @param minimum Minimum corner of the bounding box.
+                 * @param maximum Maximum corner of the bounding box.
+                 * @return true if this node provides a bounding box.
+                 */
+                virtual bool getBoundingBox(opendlv::data::environment::Point3 &minimum, opendlv::data::environment::Point3 &maximum);
+
+                /**
+                 * This method returns true if this node draws the same
+                 * content regardless of the view and does not create
+                 * display lists while rendering; thus, its rendering can
+                 * be recorded into a display list.
+                 *
+                 * @return true if this node's rendering can be recorded.
+                 */
+                virtual bool isCompilable() const;
+
                 /**
                  * This method returns this node's description.
                  *
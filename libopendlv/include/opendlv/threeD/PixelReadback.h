@@ -0,0 +1,159 @@
+/**
+ * OpenDLV - Simulation environment
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef HESPERIA_CORE_THREED_PIXELREADBACK_H_
+#define HESPERIA_CORE_THREED_PIXELREADBACK_H_
+
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+
+namespace opendlv {
+    namespace threeD {
+
+        using namespace std;
+
+        /**
+         * This class reads rendered frames back from OpenGL as BGR
+         * images. Several views of the same size can be rendered side
+         * by side into one framebuffer (e.g. one per camera) and are
+         * read back with a single transfer.
+         *
+         * If asynchronous reading is allowed and pixel buffer objects
+         * are available, the transfer is double-buffered: read() starts
+         * reading the current frame and returns the previous one, so the
+         * GPU is not stalled while the next frame is rendered. Only the
+         * very first frame is read synchronously. Otherwise, glReadPixels
+         * is used directly and every image shows the frame just rendered.
+         * Callers that stamp images with the time of the rendered scene
+         * must therefore read synchronously. An OpenGL context must be
+         * current whenever methods of this class are called.
+         */
+        class OPENDAVINCI_API PixelReadback {
+            private:
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 */
+                PixelReadback(const PixelReadback &);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 */
+                PixelReadback& operator=(const PixelReadback &);
+
+            public:
+                enum {
+                    BYTES_PER_PIXEL = 3
+                };
+
+                /**
+                 * Constructor.
+                 *
+                 * @param width Width of one view.
+                 * @param height Height of one view.
+                 * @param numberOfViews Number of views placed side by side.
+                 * @param allowAsynchronous true if images may show the previously rendered frame.
+                 */
+                PixelReadback(const uint32_t &width, const uint32_t &height, const uint32_t &numberOfViews, const bool &allowAsynchronous);
+
+                virtual ~PixelReadback();
+
+                /**
+                 * @return Number of views.
+                 */
+                uint32_t getNumberOfViews() const;
+
+                /**
+                 * @return true if frames are read asynchronously.
+                 */
+                bool isAsynchronous();
+
+                /**
+                 * This method restricts the rendering to the given view.
+                 *
+                 * @param view View to be rendered next.
+                 */
+                void setViewport(const uint32_t &view) const;
+
+                /**
+                 * This method starts reading the current framebuffer and
+                 * copies the last completely read frame into the given
+                 * images. When reading asynchronously, the second call
+                 * has no completed frame as the first one was already
+                 * returned synchronously; the images are left unchanged
+                 * in this case and must not be published again. Every
+                 * rendered frame is returned exactly once.
+                 *
+                 * @param images One BGR image of width*height*3 bytes per view.
+                 * @return true if the images were updated.
+                 */
+                bool read(const vector<char*> &images);
+
+                /**
+                 * This method copies one view from a frame read from
+                 * OpenGL, i.e. with all views side by side.
+                 *
+                 * @param frame Frame containing all views.
+                 * @param width Width of one view.
+                 * @param height Height of one view.
+                 * @param numberOfViews Number of views in the frame.
+                 * @param view View to be copied.
+                 * @param image Image of width*height*3 bytes.
+                 */
+                static void copyView(const char *frame, const uint32_t &width, const uint32_t &height, const uint32_t &numberOfViews, const uint32_t &view, char *image);
+
+            private:
+                enum {
+                    NUMBER_OF_BUFFERS = 2
+                };
+
+                uint32_t m_width;
+                uint32_t m_height;
+                uint32_t m_numberOfViews;
+                bool m_allowAsynchronous;
+                bool m_isInitialized;
+                bool m_isAsynchronous;
+                uint32_t m_buffers[NUMBER_OF_BUFFERS];
+                uint32_t m_currentBuffer;
+                uint64_t m_numberOfFrames;
+                vector<char> m_frame;
+
+                /**
+                 * This method creates the pixel buffer objects if
+                 * they are supported by the current context.
+                 */
+                void initialize();
+
+                /**
+                 * This method copies all views into the given images.
+                 *
+                 * @param frame Frame containing all views.
+                 * @param images Images to be filled.
+                 */
+                void copyViews(const char *frame, const vector<char*> &images) const;
+        };
+
+    }
+} // opendlv::threeD
+
+#endif /*HESPERIA_CORE_THREED_PIXELREADBACK_H_*/
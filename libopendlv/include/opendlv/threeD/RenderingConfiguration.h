@@ -71,6 +71,21 @@ namespace opendlv {
                  */
                 void setDrawTextures(const bool &drawTextures);
 
+                /**
+                 * This method returns true if nodes outside of the view
+                 * frustum should be skipped.
+                 *
+                 * @return true if frustum culling is enabled.
+                 */
+                bool hasFrustumCulling() const;
+
+                /**
+                 * This method enables or disables frustum culling.
+                 *
+                 * @param frustumCulling true if nodes outside of the view frustum should be skipped.
+                 */
+                void setFrustumCulling(const bool &frustumCulling);
+
                 /**
                  * This method returns a NodeRenderingConfiguration
                  * for the given NodeDescriptor.
@@ -91,6 +106,7 @@ namespace opendlv {
 
             private:
                 bool m_drawTextures;
+                bool m_frustumCulling;
                 map<NodeDescriptor, NodeRenderingConfiguration, NodeDescriptorComparator> m_nodesRenderingConfiguration;
         };
 
@@ -20,11 +20,15 @@
 #ifndef HESPERIA_CORE_THREED_TEXTUREMANAGER_H_
 #define HESPERIA_CORE_THREED_TEXTUREMANAGER_H_
 
+#include <future>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/base/Mutex.h"
+#include "opendavinci/odcore/base/WorkerPool.h"
 #include "opendlv/core/wrapper/Image.h"
 #include "opendavinci/odcore/strings/StringComparator.h"
 
@@ -35,6 +39,20 @@ namespace opendlv {
 
         /**
          * This class manages all textures for an OpenGL scene.
+         *
+         * Images are added without blocking: A texture handle is available
+         * immediately while the mipmaps are computed by a pool of worker
+         * threads. The mipmaps are uploaded by update() from the coarsest
+         * to the finest level in tiles of rows limited per frame; thus,
+         * textures appear quickly and are refined progressively. Levels
+         * finer than the preview are kept either on the GPU or in host
+         * memory but not in both. If the uploaded textures exceed the
+         * memory budget, the finest levels of the least recently used
+         * textures are read back and released until they are used again.
+         *
+         * Textures bound by display lists are not bound through this class
+         * when the lists are replayed; their use is recorded while compiling
+         * the lists and must be reported by markAsUsed() instead.
          */
         class OPENDAVINCI_API TextureManager {
             private:
@@ -65,9 +83,20 @@ namespace opendlv {
                  */
                 static TextureManager& getInstance();
 
+                enum {
+                    // Default memory budget for uploaded textures in bytes.
+                    DEFAULT_MEMORY_BUDGET = 512 * 1024 * 1024,
+                    // Default number of bytes to be uploaded per frame.
+                    DEFAULT_UPLOAD_BUDGET = 4 * 1024 * 1024,
+                    // Maximum edge length of the levels that are never released.
+                    PREVIEW_SIZE = 64
+                };
+
                 /**
                  * This method adds a new image to be used as a texture.
-                 * Furthermore, mipmaps are generated automatically.
+                 * Furthermore, mipmaps are generated automatically in
+                 * the background. The image's data is copied; the image
+                 * can be released afterwards.
                  *
                  * @param name Unique name for this image to be added.
                  * @param image Image to be added.
@@ -100,10 +129,161 @@ namespace opendlv {
                  */
                 void removeTexture(const string &name);
 
+                /**
+                 * This method binds the given texture and marks it as
+                 * recently used.
+                 *
+                 * @param textureHandle Texture handle to be bound.
+                 */
+                void bindTexture(const uint32_t &textureHandle);
+
+                /**
+                 * This method starts recording the textures that are
+                 * bound, e.g. while compiling a display list.
+                 */
+                void startRecordingBoundTextures();
+
+                /**
+                 * This method stops recording the bound textures.
+                 *
+                 * @param textureHandles Textures bound since startRecordingBoundTextures().
+                 */
+                void stopRecordingBoundTextures(vector<uint32_t> &textureHandles);
+
+                /**
+                 * This method marks the given textures as recently used
+                 * without binding them, e.g. when replaying a display list.
+                 *
+                 * @param textureHandles Textures to be marked.
+                 */
+                void markAsUsed(const vector<uint32_t> &textureHandles);
+
+                /**
+                 * This method uploads pending mipmaps and releases the
+                 * least recently used levels if the memory budget is
+                 * exceeded. It must be called once per frame from the
+                 * thread owning the OpenGL context.
+                 */
+                void update();
+
+                /**
+                 * This method checks whether all levels of the texture
+                 * "name" are uploaded.
+                 *
+                 * @param name Name of the texture.
+                 * @return true, if the texture is available in full resolution.
+                 */
+                bool isComplete(const string &name) const;
+
+                /**
+                 * This method sets the memory budget for uploaded textures.
+                 *
+                 * @param bytes Memory budget in bytes.
+                 */
+                void setMemoryBudget(const uint64_t &bytes);
+
+                /**
+                 * @return Memory budget for uploaded textures in bytes.
+                 */
+                uint64_t getMemoryBudget() const;
+
+                /**
+                 * This method sets the number of bytes to be uploaded per frame.
+                 *
+                 * @param bytes Number of bytes.
+                 */
+                void setUploadBudget(const uint32_t &bytes);
+
+                /**
+                 * @return Number of bytes currently uploaded for all textures.
+                 */
+                uint64_t getResidentMemory() const;
+
+            private:
+                /**
+                 * One level of a texture's mipmaps with tightly packed
+                 * pixels of three bytes.
+                 */
+                class MipmapLevel {
+                    public:
+                        MipmapLevel();
+
+                    public:
+                        uint32_t m_width;
+                        uint32_t m_height;
+                        // Empty while the level is only kept on the GPU.
+                        vector<unsigned char> m_data;
+                };
+
+                /**
+                 * State of one texture.
+                 */
+                class Texture {
+                    private:
+                        Texture(const Texture &/*obj*/);
+                        Texture& operator=(const Texture &/*obj*/);
+
+                    public:
+                        Texture();
+
+                    public:
+                        uint32_t m_handle;
+                        uint32_t m_format;
+                        std::future<std::shared_ptr<vector<MipmapLevel> > > m_pendingMipmaps;
+                        std::shared_ptr<vector<MipmapLevel> > m_mipmaps;
+                        uint32_t m_previewLevel;
+                        // Finest completely uploaded level (number of levels if none).
+                        uint32_t m_baseLevel;
+                        // Rows of the next finer level that are already uploaded.
+                        uint32_t m_uploadedRows;
+                        uint64_t m_residentBytes;
+                        uint64_t m_lastUse;
+                        bool m_isReleased;
+                };
+
+                /**
+                 * This method computes the mipmaps for the given pixels.
+                 * The finest level is resized to the nearest power of two.
+                 *
+                 * @param pixels Tightly packed pixels of three bytes.
+                 * @param width Width of the image.
+                 * @param height Height of the image.
+                 * @param maximumSize Maximum edge length of the finest level.
+                 * @return Mipmaps starting with the finest level.
+                 */
+                static std::shared_ptr<vector<MipmapLevel> > buildMipmaps(std::shared_ptr<vector<unsigned char> > pixels, const uint32_t width, const uint32_t height, const uint32_t maximumSize);
+
+                /**
+                 * This method uploads finer levels of a texture.
+                 *
+                 * @param texture Texture to upload.
+                 * @param budget Number of bytes that might be uploaded.
+                 * @return Number of bytes uploaded.
+                 */
+                uint64_t upload(Texture &texture, const uint64_t &budget);
+
+                /**
+                 * This method reads the levels of a texture that are finer
+                 * than its preview level back into host memory and
+                 * releases them on the GPU.
+                 *
+                 * @param texture Texture to release.
+                 */
+                void release(Texture &texture);
+
             private:
                 static odcore::base::Mutex m_singletonMutex;
                 static TextureManager* m_singleton;
+                mutable odcore::base::Mutex m_texturesMutex;
                 map<string, uint32_t, odcore::strings::StringComparator> m_mapOfTextureHandles;
+                map<uint32_t, std::shared_ptr<Texture> > m_mapOfTextures;
+                uint64_t m_frame;
+                uint64_t m_memoryBudget;
+                uint32_t m_uploadBudget;
+                uint64_t m_residentMemory;
+                bool m_isRecording;
+                vector<uint32_t> m_recordedTextures;
+                odcore::base::WorkerPool m_mipmapWorkers;
         };
 
     }
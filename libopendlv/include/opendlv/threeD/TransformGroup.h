@@ -26,6 +26,7 @@
 
 #include "opendavinci/odcore/base/Mutex.h"
 #include "opendlv/data/environment/Point3.h"
+#include "opendlv/threeD/Frustum.h"
 #include "opendlv/threeD/Node.h"
 #include "opendlv/threeD/NodeDescriptor.h"
 #include "opendlv/threeD/TransformGroupVisitor.h"
@@ -35,6 +36,11 @@ namespace opendlv {
 
         /**
          * This class creates a scene graph.
+         *
+         * Children whose bounding boxes are outside of the view frustum
+         * are skipped. Groups marked as static additionally cache the
+         * bounding boxes of their children and draw leaf nodes from
+         * display lists.
          */
         class OPENDAVINCI_API TransformGroup : public Node {
             private:
@@ -69,6 +75,32 @@ namespace opendlv {
 
                 virtual void render(RenderingConfiguration &renderingConfiguration);
 
+                /**
+                 * This method returns the bounding box of all children
+                 * transformed by this group; it is only available if all
+                 * children provide a bounding box.
+                 *
+                 * @param minimum Minimum corner of the bounding box.
+                 * @param maximum Maximum corner of the bounding box.
+                 * @return true if this group provides a bounding box.
+                 */
+                virtual bool getBoundingBox(opendlv::data::environment::Point3 &minimum, opendlv::data::environment::Point3 &maximum);
+
+                /**
+                 * This method marks this group and all its descendant
+                 * groups as static, i.e. neither their transformations
+                 * nor their children nor the children's geometry will
+                 * change anymore.
+                 *
+                 * @param isStatic true if this group is static.
+                 */
+                void setStatic(const bool &isStatic);
+
+                /**
+                 * @return true if this group is static.
+                 */
+                bool isStatic() const;
+
                 /**
                  * This method sets the translation.
                  *
@@ -137,6 +169,62 @@ namespace opendlv {
                  */
                 void accept(TransformGroupVisitor &visitor);
 
+            private:
+                /**
+                 * Cached state of a child of a static group.
+                 */
+                class CachedChild {
+                    public:
+                        CachedChild();
+
+                        CachedChild(const CachedChild &obj);
+
+                        CachedChild& operator=(const CachedChild &obj);
+
+                    public:
+                        Node *m_node;
+                        // Groups and view-dependent nodes are not recorded into display lists.
+                        bool m_isRenderedDirectly;
+                        bool m_hasBoundingBox;
+                        opendlv::data::environment::Point3 m_minimum;
+                        opendlv::data::environment::Point3 m_maximum;
+                        bool m_isPrepared;
+                        uint32_t m_callList;
+                        bool m_drawTextures;
+                        // Textures bound by the display list.
+                        vector<uint32_t> m_textures;
+                };
+
+                /**
+                 * This method renders the children of a static group.
+                 *
+                 * @param renderingConfiguration Configuration for the rendering process.
+                 * @param frustum View frustum in this group's coordinate system.
+                 */
+                void renderStaticChildren(RenderingConfiguration &renderingConfiguration, const Frustum &frustum);
+
+                /**
+                 * This method computes the bounding box of all children
+                 * transformed by this group.
+                 */
+                bool computeBoundingBox(opendlv::data::environment::Point3 &minimum, opendlv::data::environment::Point3 &maximum);
+
+                /**
+                 * This method discards all cached data.
+                 */
+                void invalidateCache();
+
+                /**
+                 * This method deletes the display lists of discarded
+                 * cached children; an OpenGL context must be current.
+                 */
+                void releaseCallLists();
+
+                /**
+                 * @return true if an OpenGL context is current on the calling thread.
+                 */
+                static bool hasCurrentContext();
+
             private:
                 opendlv::data::environment::Point3 m_translation;
                 opendlv::data::environment::Point3 m_rotation;
@@ -144,6 +232,15 @@ namespace opendlv {
 
                 mutable odcore::base::Mutex m_listOfChildrenMutex;
                 vector<Node*> m_listOfChildren;
+
+                bool m_isStatic;
+                bool m_isBoundingBoxCached;
+                bool m_hasBoundingBox;
+                opendlv::data::environment::Point3 m_minimum;
+                opendlv::data::environment::Point3 m_maximum;
+                vector<CachedChild> m_listOfCachedChildren;
+                vector<uint8_t> m_visibleChildren;
+                vector<uint32_t> m_listOfReleasedCallLists;
         };
 
     }
@@ -23,6 +23,7 @@
 #include <map>
 #include <string>
 #include <sstream>
+#include <vector>
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendlv/core/wrapper/Image.h"
@@ -30,6 +31,7 @@
 
 #include "opendlv/threeD/Material.h"
 #include "opendlv/threeD/TransformGroup.h"
+#include "opendlv/threeD/models/Triangle.h"
 
 namespace opendlv {
     namespace threeD {
@@ -117,6 +119,14 @@ namespace opendlv {
                      */
                     const stringstream& getContentsOfMtlFile() const;
 
+                    /**
+                     * This method parses the obj-file into sets of triangles.
+                     * As it does not use OpenGL, it can be called from any
+                     * thread to prepare createTransformGroup. The result is
+                     * taken from or stored into the ArchiveCache.
+                     */
+                    void parse();
+
                     /**
                      * This method creates a displayable node for the scene graph
                      * based on the data of an instance of this class.
@@ -125,11 +135,51 @@ namespace opendlv {
                      */
                     TransformGroup* createTransformGroup(const NodeDescriptor &nd);
 
+                private:
+                    /**
+                     * This class contains the triangles of one group of
+                     * the obj-file.
+                     */
+                    class TriangleGroup {
+                        public:
+                            TriangleGroup();
+
+                            // Name of the most recently used material, if any.
+                            bool m_hasMaterial;
+                            string m_material;
+                            vector<models::Triangle> m_triangles;
+                    };
+
+                    /**
+                     * This method parses the obj-file.
+                     */
+                    void parseObjFile();
+
+                    /**
+                     * This method serializes the parsed triangle groups
+                     * into their binary representation for the cache.
+                     *
+                     * @return Binary representation.
+                     */
+                    string serializeTriangleGroups() const;
+
+                    /**
+                     * This method reads the triangle groups from their
+                     * binary representation.
+                     *
+                     * @param data Binary representation.
+                     * @param size Size of the binary representation.
+                     * @return true if the data could be read completely.
+                     */
+                    bool deserializeTriangleGroups(const char *data, const uint64_t &size);
+
                 private:
                     map<string, core::wrapper::Image*, odcore::strings::StringComparator> m_mapOfImages;
                     map<string, Material, odcore::strings::StringComparator> m_mapOfMaterials;
                     stringstream m_objFile;
                     stringstream m_mtlFile;
+                    bool m_isParsed;
+                    vector<TriangleGroup> m_listOfTriangleGroups;
 
                     /**
                      * This method creates the material's map.
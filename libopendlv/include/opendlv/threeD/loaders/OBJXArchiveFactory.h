@@ -21,13 +21,18 @@
 #define HESPERIA_CORE_THREED_LOADERS_OBJXARCHIVEFACTORY_H_
 
 #include <iostream>
+#include <memory>
+#include <string>
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/base/Mutex.h"
+#include "opendavinci/odcore/base/WorkerPool.h"
 #include "opendavinci/odcore/exceptions/Exceptions.h"
 
 #include "opendlv/threeD/loaders/OBJXArchive.h"
 
+namespace odcore { namespace wrapper { class DecompressedData; } }
+
 namespace opendlv {
     namespace threeD {
         namespace loaders {
@@ -85,9 +90,41 @@ namespace opendlv {
                      */
                     OBJXArchive* getOBJXArchive(istream &in) throw (odcore::exceptions::InvalidArgumentException);
 
+                    /**
+                     * This method returns the OBJXArchive data structure
+                     * for a file that is read in place without copying it.
+                     *
+                     * @param fileName OBJX archive file.
+                     * @return OBJXArchive.
+                     * @throws InvalidArgumentException if the file could not be used to create the data structure.
+                     */
+                    OBJXArchive* getOBJXArchive(const string &fileName) throw (odcore::exceptions::InvalidArgumentException);
+
+                private:
+                    /**
+                     * This method creates the OBJXArchive data structure
+                     * from an archive's contents.
+                     *
+                     * @param data Contents of the archive.
+                     * @return OBJXArchive or NULL if data is not available.
+                     */
+                    OBJXArchive* getOBJXArchive(std::shared_ptr<odcore::wrapper::DecompressedData> data);
+
+                    /**
+                     * This method decodes a texture image from an archive.
+                     *
+                     * @param stream Stream to read the image from.
+                     * @return Image or NULL if the entry is not an image.
+                     */
+                    static core::wrapper::Image* decodeImage(std::shared_ptr<istream> stream);
+
                 private:
                     static odcore::base::Mutex m_singletonMutex;
                     static OBJXArchiveFactory* m_singleton;
+
+                    // Shared by all callers as archives are loaded from several threads; it
+                    // must not be used by tasks that wait for its own tasks.
+                    odcore::base::WorkerPool m_imageDecoders;
             };
 
         }
@@ -109,6 +109,8 @@ namespace opendlv {
 
                     virtual void render(RenderingConfiguration &renderingConfiguration);
 
+                    virtual bool getBoundingBox(opendlv::data::environment::Point3 &minimum, opendlv::data::environment::Point3 &maximum);
+
                 private:
                     const core::wrapper::Image *m_image;
                     opendlv::data::environment::Point3 m_originPixelXY;
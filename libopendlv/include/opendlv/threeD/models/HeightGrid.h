@@ -20,6 +20,8 @@
 #ifndef HESPERIA_CORE_THREED_MODELS_HEIGHTGRID_H_
 #define HESPERIA_CORE_THREED_MODELS_HEIGHTGRID_H_
 
+#include <vector>
+
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendlv/core/wrapper/Image.h"
 
@@ -36,18 +38,36 @@ namespace opendlv {
             using namespace std;
 
             /**
-             * This class represents the actual renderer.
+             * This class represents the actual renderer. The grid is split
+             * into tiles that are drawn with a level of detail chosen by
+             * their distance to the camera. The display lists for the tiles
+             * are compiled on demand starting with the coarsest level; a
+             * tile is drawn with the nearest available level until its
+             * desired level is compiled.
              */
             class OPENDAVINCI_API HeightGridRenderer : public Node {
                 public:
+                    enum {
+                        // Number of cells per tile in each direction.
+                        TILE_SIZE = 64,
+                        // Number of levels; level l uses every 2^l-th height value.
+                        LEVELS_OF_DETAIL = 4,
+                        // Number of vertices to be compiled per frame for refining tiles.
+                        VERTICES_PER_FRAME = 256 * 1024
+                    };
+
                     /**
                      * Constructor.
                      *
                     * @param nodeDesciptor Description for this node.
-                     * @param callList Handle for the height grid's call list.
+                     * @param heightImage Image to be used as height image.
+                     * @param ground Value for the ground.
+                     * @param scaleZ Scaling for the heights.
                      */
                     HeightGridRenderer(const NodeDescriptor &nodeDescriptor,
-                                       const uint32_t &callList);
+                                       const core::wrapper::Image *heightImage,
+                                       const float &ground,
+                                       const float &scaleZ);
 
                     /**
                      * Copy constructor.
@@ -68,8 +88,36 @@ namespace opendlv {
 
                     virtual void render(RenderingConfiguration &renderingConfiguration);
 
+                    virtual bool isCompilable() const;
+
+                private:
+                    /**
+                     * This method compiles the display list for a tile.
+                     *
+                     * @param tileX Column of the tile.
+                     * @param tileY Row of the tile.
+                     * @param level Level of detail.
+                     * @return Number of compiled vertices.
+                     */
+                    uint32_t compileTile(const uint32_t &tileX, const uint32_t &tileY, const uint32_t &level);
+
+                    /**
+                     * This method emits a vertex for the given position in the grid.
+                     *
+                     * @param x Column in the grid.
+                     * @param y Row in the grid.
+                     * @param offsetZ Additional offset for the height.
+                     */
+                    void vertex(const uint32_t &x, const uint32_t &y, const float &offsetZ);
+
                 private:
-                    uint32_t m_callList;
+                    const core::wrapper::Image *m_heightImage;
+                    float m_ground;
+                    float m_scaleZ;
+                    uint32_t m_numberOfTilesX;
+                    uint32_t m_numberOfTilesY;
+                    // Display lists per tile and level; 0 denotes not yet compiled ones.
+                    vector<uint32_t> m_callLists;
             };
 
             /**
@@ -117,6 +165,10 @@ namespace opendlv {
 
                     virtual void render(RenderingConfiguration &renderingConfiguration);
 
+                    virtual bool getBoundingBox(opendlv::data::environment::Point3 &minimum, opendlv::data::environment::Point3 &maximum);
+
+                    virtual bool isCompilable() const;
+
                 private:
                     const core::wrapper::Image *m_heightImage;
                     opendlv::data::environment::Point3 m_originPixelXY;
@@ -126,7 +178,6 @@ namespace opendlv {
                     float m_min;
                     float m_max;
 
-                    uint32_t m_callList;
                     TransformGroup *m_heightImageNode;
                     HeightGridRenderer *m_heightImageRenderer;
 
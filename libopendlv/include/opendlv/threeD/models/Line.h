@@ -67,6 +67,8 @@ namespace opendlv {
 
                     virtual void render(RenderingConfiguration &renderingConfiguration);
 
+                    virtual bool getBoundingBox(opendlv::data::environment::Point3 &minimum, opendlv::data::environment::Point3 &maximum);
+
                 private:
                     opendlv::data::environment::Point3 m_positionA;
                     opendlv::data::environment::Point3 m_positionB;
@@ -65,6 +65,8 @@ namespace opendlv {
 
                     virtual void render(RenderingConfiguration &renderingConfiguration);
 
+                    virtual bool getBoundingBox(opendlv::data::environment::Point3 &minimum, opendlv::data::environment::Point3 &maximum);
+
                 private:
                     opendlv::data::environment::Point3 m_position;
                     opendlv::data::environment::Point3 m_color;
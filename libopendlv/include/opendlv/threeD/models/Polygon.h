@@ -68,6 +68,8 @@ namespace opendlv {
 
                     virtual void render(RenderingConfiguration &renderingConfiguration);
 
+                    virtual bool getBoundingBox(opendlv::data::environment::Point3 &minimum, opendlv::data::environment::Point3 &maximum);
+
                 private:
                     vector<opendlv::data::environment::Point3> m_listOfGroundVertices;
                     opendlv::data::environment::Point3 m_color;
@@ -69,6 +69,8 @@ namespace opendlv {
 
                     virtual void render(RenderingConfiguration &renderingConfiguration);
 
+                    virtual bool getBoundingBox(opendlv::data::environment::Point3 &minimum, opendlv::data::environment::Point3 &maximum);
+
                     /**
                      * This method adds a new triangle.
                      *
@@ -90,6 +92,9 @@ namespace opendlv {
                     vector<opendlv::data::environment::Point3> m_vertices;
                     vector<opendlv::data::environment::Point3> m_normals;
                     vector<opendlv::data::environment::Point3> m_textureCoordinates;
+                    bool m_hasBoundingBox;
+                    opendlv::data::environment::Point3 m_minimum;
+                    opendlv::data::environment::Point3 m_maximum;
 
                     /**
                      * This method compiles this triangle set using OpenGL
@@ -30,6 +30,7 @@
 
 #include "opendlv/data/environment/EgoState.h"
 #include "opendlv/io/camera/ImageGrabber.h"
+#include "opendlv/threeD/PixelReadback.h"
 #include "opendlv/threeD/TransformGroup.h"
 
 namespace opendlv { namespace vehiclecontext {
@@ -85,6 +86,7 @@ namespace opendlv { namespace vehiclecontext {
                 odcore::base::KeyValueConfiguration m_kvc;
                 std::shared_ptr<core::wrapper::Image> m_image;
                 std::shared_ptr<odcore::wrapper::SharedMemory> m_sharedMemory;
+                std::shared_ptr<opendlv::threeD::PixelReadback> m_readback;
                 std::shared_ptr<opendlv::threeD::TransformGroup> m_root;
         };
 
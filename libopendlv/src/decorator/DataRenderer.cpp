@@ -17,7 +17,6 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
-#include <fstream>
 #include <iostream>
 #include <map>
 #include <string>
@@ -245,10 +244,8 @@ namespace opendlv {
         void DataRenderer::setEgoStateModel(const string &fn)  {
             Lock l(m_dataRendererMutex);
 
-            cout << "Trying to load file stream to car model " << fn << endl;
-            fstream fin(fn.c_str(), ios::in | ios::binary);
-
-            OBJXArchive *objxArchive = OBJXArchiveFactory::getInstance().getOBJXArchive(fin);
+            cout << "Trying to load car model " << fn << endl;
+            OBJXArchive *objxArchive = OBJXArchiveFactory::getInstance().getOBJXArchive(fn);
             if (objxArchive != NULL) {
                 m_egoStateModel = objxArchive->getListOfTriangleSets();
 
@@ -17,6 +17,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -100,10 +101,23 @@ namespace opendlv {
                     }
                 }
 
-                OBJXArchive *objxArchive = NULL;
-
                 // Use CompressionFactory to read the contents of the OBJXArchive.
-                std::shared_ptr<odcore::wrapper::DecompressedData> data = odcore::wrapper::CompressionFactory::getContents(in);
+                return getOBJXArchive(odcore::wrapper::CompressionFactory::getContents(in));
+            }
+
+            OBJXArchive* OBJXArchiveFactory::getOBJXArchive(const string &fileName) throw (InvalidArgumentException) {
+                ifstream fin(fileName.c_str(), ios::binary | ios::in);
+                if (!(fin.good())) {
+                    OPENDAVINCI_CORE_THROW_EXCEPTION(InvalidArgumentException, "Given file is invalid.");
+                }
+                fin.close();
+
+                // The archive is read in place.
+                return getOBJXArchive(odcore::wrapper::CompressionFactory::getContents(fileName));
+            }
+
+            OBJXArchive* OBJXArchiveFactory::getOBJXArchive(std::shared_ptr<odcore::wrapper::DecompressedData> data) {
+                OBJXArchive *objxArchive = NULL;
 
                 if (data.get()) {
                     // Create OBJXArchive.
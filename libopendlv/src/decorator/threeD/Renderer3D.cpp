@@ -213,7 +213,7 @@ namespace opendlv {
                                     // Get texture handle.
                                     textureHandle = textureManager.getTexture(sstrImage.str());
                                     glEnable(GL_TEXTURE_2D);
-                                    glBindTexture(GL_TEXTURE_2D, static_cast<uint32_t>(textureHandle));
+                                    textureManager.bindTexture(static_cast<uint32_t>(textureHandle));
                                     glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_DECAL);
                                 }
 
@@ -334,7 +334,7 @@ namespace opendlv {
                                     {
                                         // Actually draw the image.
                                         glEnable(GL_TEXTURE_2D);
-                                        glBindTexture(GL_TEXTURE_2D, textureHandle);
+                                        textureManager.bindTexture(textureHandle);
                                         glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_DECAL);
 
                                         glBegin(GL_QUADS);
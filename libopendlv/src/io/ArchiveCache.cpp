@@ -0,0 +1,332 @@
+/**
+ * OpenDLV - Simulation environment
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifdef WIN32
+    #include <direct.h>
+    #include <process.h>
+    #include <sys/stat.h>
+    #include <sys/types.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <sys/types.h>
+    #include <unistd.h>
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Lock.h"
+#include "opendavinci/odcore/base/Mutex.h"
+#include "opendlv/io/ArchiveCache.h"
+
+namespace opendlv {
+    namespace io {
+
+        using namespace std;
+        using namespace odcore::base;
+
+        const char ArchiveCache::MAGIC[8] = { 'O', 'D', 'L', 'V', 'A', 'C', 'H', 'E' };
+
+        /**
+         * Header preceding the contents of every entry in the host's byte order.
+         */
+        struct ArchiveCacheHeader {
+            char m_magic[8];
+            uint32_t m_version;
+            uint32_t m_reserved;
+            uint64_t m_size;
+            uint64_t m_checksum;
+        };
+
+        ArchiveCache::Entry::Entry(const string &fileName) :
+            m_mapping(NULL),
+            m_sizeOfMapping(0),
+            m_data(NULL),
+            m_size(0),
+            m_buffer() {
+#ifdef WIN32
+            fstream fin(fileName.c_str(), ios::binary | ios::in);
+            if (fin.good()) {
+                m_buffer.assign(istreambuf_iterator<char>(fin), istreambuf_iterator<char>());
+                if (!m_buffer.empty()) {
+                    m_mapping = &m_buffer[0];
+                    m_sizeOfMapping = m_buffer.size();
+                }
+            }
+#else
+            const int FD = ::open(fileName.c_str(), O_RDONLY);
+            if (FD >= 0) {
+                struct stat fileStatus;
+                if ( (::fstat(FD, &fileStatus) == 0) && (fileStatus.st_size > 0) ) {
+                    void *data = ::mmap(NULL, static_cast<size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, FD, 0);
+                    if (data != MAP_FAILED) {
+                        m_mapping = static_cast<const char*>(data);
+                        m_sizeOfMapping = static_cast<uint64_t>(fileStatus.st_size);
+                    }
+                }
+                // The mapping remains valid after closing the file.
+                ::close(FD);
+            }
+#endif
+
+            // Only accept complete entries of the current format.
+            ArchiveCacheHeader header;
+            if ( (m_mapping != NULL) && (m_sizeOfMapping >= ArchiveCache::HEADER_SIZE) ) {
+                memcpy(&header, m_mapping, sizeof(header));
+                const char *DATA = m_mapping + ArchiveCache::HEADER_SIZE;
+                const uint64_t SIZE = m_sizeOfMapping - ArchiveCache::HEADER_SIZE;
+                if ( (memcmp(header.m_magic, ArchiveCache::MAGIC, sizeof(header.m_magic)) == 0) &&
+                     (header.m_version == ArchiveCache::FORMAT_VERSION) &&
+                     (header.m_size == SIZE) &&
+                     (header.m_checksum == ArchiveCache::getHash(DATA, SIZE)) ) {
+                    m_data = DATA;
+                    m_size = SIZE;
+                }
+            }
+        }
+
+        ArchiveCache::Entry::~Entry() {
+#ifndef WIN32
+            if (m_mapping != NULL) {
+                ::munmap(const_cast<char*>(m_mapping), static_cast<size_t>(m_sizeOfMapping));
+            }
+#endif
+        }
+
+        bool ArchiveCache::Entry::isValid() const {
+            return (m_data != NULL);
+        }
+
+        const char* ArchiveCache::Entry::getData() const {
+            return m_data;
+        }
+
+        uint64_t ArchiveCache::Entry::getSize() const {
+            return m_size;
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+
+        ArchiveCache::EntryStreamBuffer::EntryStreamBuffer(std::shared_ptr<Entry> entry) :
+            m_entry(entry) {
+            // The get area is never written to.
+            char *begin = const_cast<char*>(m_entry->getData());
+            setg(begin, begin, begin + m_entry->getSize());
+        }
+
+        ArchiveCache::EntryStreamBuffer::~EntryStreamBuffer() {}
+
+        ArchiveCache::EntryStreamBuffer::pos_type ArchiveCache::EntryStreamBuffer::seekoff(off_type off, ios_base::seekdir dir, ios_base::openmode which) {
+            off_type target = off;
+            if (dir == ios_base::cur) {
+                target += gptr() - eback();
+            }
+            else if (dir == ios_base::end) {
+                target += egptr() - eback();
+            }
+
+            return seekpos(pos_type(target), which);
+        }
+
+        ArchiveCache::EntryStreamBuffer::pos_type ArchiveCache::EntryStreamBuffer::seekpos(pos_type pos, ios_base::openmode which) {
+            const off_type TARGET = static_cast<off_type>(pos);
+            if ( ((which & ios_base::in) == 0) || (TARGET < 0) || (TARGET > (egptr() - eback())) ) {
+                return pos_type(off_type(-1));
+            }
+
+            setg(eback(), eback() + TARGET, egptr());
+            return pos;
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+
+        // Initialize singleton instance.
+        Mutex ArchiveCache::m_singletonMutex;
+        ArchiveCache* ArchiveCache::m_singleton = NULL;
+
+        ArchiveCache::ArchiveCache() :
+            m_directory(),
+            m_temporaryFilesMutex(),
+            m_numberOfTemporaryFiles(0) {
+            const char *DIRECTORY = ::getenv("OPENDLV_ARCHIVE_CACHE");
+            if (DIRECTORY != NULL) {
+                m_directory = DIRECTORY;
+            }
+            else {
+#ifdef WIN32
+                const char *TEMP = ::getenv("TEMP");
+                m_directory = string((TEMP != NULL) ? TEMP : ".") + "\\opendlv-archive-cache";
+#else
+                // Every user has an own cache as entries of other users cannot be trusted.
+                const char *TEMP = ::getenv("TMPDIR");
+                stringstream directory;
+                directory << ((TEMP != NULL) ? TEMP : "/tmp") << "/opendlv-archive-cache-" << ::getuid();
+                m_directory = directory.str();
+#endif
+            }
+        }
+
+        ArchiveCache::~ArchiveCache() {}
+
+        ArchiveCache& ArchiveCache::getInstance() {
+            {
+                Lock l(ArchiveCache::m_singletonMutex);
+                if (ArchiveCache::m_singleton == NULL) {
+                    ArchiveCache::m_singleton = new ArchiveCache();
+                }
+            }
+
+            return (*ArchiveCache::m_singleton);
+        }
+
+        uint64_t ArchiveCache::getHash(const char *data, const uint64_t &length) {
+            uint64_t hash = 14695981039346656037ull;
+            for (uint64_t i = 0; i < length; i++) {
+                hash ^= static_cast<unsigned char>(data[i]);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        string ArchiveCache::getKey(const string &prefix, const string &data) {
+            char hash[17];
+            ::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(getHash(data.c_str(), data.size())));
+
+            stringstream key;
+            key << prefix << "-" << hash << "-" << data.size();
+            return key.str();
+        }
+
+        string ArchiveCache::getKeyForFile(const string &prefix, const string &fileName) {
+            stringstream metadata;
+#ifdef WIN32
+            struct _stat64 fileStatus;
+            if (::_stat64(fileName.c_str(), &fileStatus) != 0) {
+                return "";
+            }
+            metadata << fileName << "|" << fileStatus.st_size << "|" << fileStatus.st_mtime;
+#else
+            struct stat fileStatus;
+            if (::stat(fileName.c_str(), &fileStatus) != 0) {
+                return "";
+            }
+            metadata << fileName << "|" << fileStatus.st_dev << "|" << fileStatus.st_ino << "|" << fileStatus.st_size << "|" << fileStatus.st_mtime;
+#if defined(__linux__)
+            metadata << "." << fileStatus.st_mtim.tv_nsec;
+#endif
+#endif
+            return getKey(prefix, metadata.str());
+        }
+
+        bool ArchiveCache::prepareDirectory() const {
+#ifdef WIN32
+            // Other processes might have created the directory already.
+            ::_mkdir(m_directory.c_str());
+            return true;
+#else
+            // Other processes might have created the directory already.
+            ::mkdir(m_directory.c_str(), 0700);
+
+            struct stat directoryStatus;
+            if ( (::lstat(m_directory.c_str(), &directoryStatus) != 0) ||
+                 !S_ISDIR(directoryStatus.st_mode) ||
+                 (directoryStatus.st_uid != ::geteuid()) ||
+                 ((directoryStatus.st_mode & (S_IWGRP | S_IWOTH)) != 0) ) {
+                clog << "ArchiveCache: Ignoring " << m_directory << " as it is not a directory that is private to the current user." << endl;
+                return false;
+            }
+            return true;
+#endif
+        }
+
+        bool ArchiveCache::isEnabled() const {
+            return !m_directory.empty();
+        }
+
+        string ArchiveCache::getFileName(const string &key) const {
+#ifdef WIN32
+            return m_directory + "\\" + key + ".bin";
+#else
+            return m_directory + "/" + key + ".bin";
+#endif
+        }
+
+        std::shared_ptr<ArchiveCache::Entry> ArchiveCache::get(const string &key) const {
+            std::shared_ptr<Entry> entry;
+            if (isEnabled() && prepareDirectory()) {
+                entry = std::shared_ptr<Entry>(new Entry(getFileName(key)));
+                if (!entry->isValid()) {
+                    entry.reset();
+                }
+            }
+            return entry;
+        }
+
+        void ArchiveCache::put(const string &key, const string &data) {
+            if (!isEnabled() || !prepareDirectory()) {
+                return;
+            }
+
+#ifdef WIN32
+            const int32_t PID = ::_getpid();
+#else
+            const int32_t PID = ::getpid();
+#endif
+
+            uint32_t number = 0;
+            {
+                Lock l(m_temporaryFilesMutex);
+                number = m_numberOfTemporaryFiles++;
+            }
+
+            // Write to a temporary file first so that readers never see partially written entries.
+            stringstream temporaryFileName;
+            temporaryFileName << getFileName(key) << "." << PID << "." << number << ".tmp";
+
+            fstream fout(temporaryFileName.str().c_str(), ios::binary | ios::out | ios::trunc);
+            if (fout.good()) {
+                ArchiveCacheHeader header;
+                memset(&header, 0, sizeof(header));
+                memcpy(header.m_magic, ArchiveCache::MAGIC, sizeof(header.m_magic));
+                header.m_version = ArchiveCache::FORMAT_VERSION;
+                header.m_size = data.size();
+                header.m_checksum = getHash(data.c_str(), data.size());
+
+                fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                fout.write(data.c_str(), data.size());
+                fout.close();
+
+                if (fout.good() && (::rename(temporaryFileName.str().c_str(), getFileName(key).c_str()) == 0)) {
+                    clog << "ArchiveCache: Stored " << key << "." << endl;
+                    return;
+                }
+            }
+            ::remove(temporaryFileName.str().c_str());
+        }
+
+    }
+} // opendlv::io
@@ -40,7 +40,9 @@
 #include "opendlv/threeD/models/CheckerBoard.h"
 #include "opendlv/threeD/models/Grid.h"
 #include "opendlv/threeD/models/XYZAxes.h"
+#include "opendlv/threeD/PixelReadback.h"
 #include "opendlv/threeD/RenderingConfiguration.h"
+#include "opendlv/threeD/TextureManager.h"
 
 namespace core { namespace wrapper { class Image; } }
 namespace opendlv { namespace data { namespace camera { class ImageGrabberCalibration; } } }
@@ -64,6 +66,7 @@ namespace opendlv { namespace vehiclecontext {
             m_kvc(kvc),
             m_image(),
             m_sharedMemory(),
+            m_readback(),
             m_root() {
 
             const URL urlOfSCNXFile(m_kvc.getValue<string>("global.scenario"));
@@ -84,6 +87,9 @@ namespace opendlv { namespace vehiclecontext {
 
                 m_image = std::shared_ptr<core::wrapper::Image>(core::wrapper::ImageFactory::getInstance().getImage(640, 480, core::wrapper::Image::BGR_24BIT, static_cast<char*>(m_sharedMemory->getSharedMemory())));
 
+                // CameraModel sends each image within the simulation step that rendered it; thus, it must not show the previous frame.
+                m_readback = std::shared_ptr<PixelReadback>(new PixelReadback(640, 480, 1, false));
+
                 if (m_image.get()) {
                     cerr << "OpenGLGrabber initialized." << endl;
                 }
@@ -99,16 +105,20 @@ namespace opendlv { namespace vehiclecontext {
         std::shared_ptr<core::wrapper::Image> OpenGLGrabber::getNextImage() {
             if ( (m_sharedMemory.get()) && (m_sharedMemory->isValid()) ) {
                 m_sharedMemory->lock();
+                    // Continue uploading textures that were loaded in the background.
+                    TextureManager::getInstance().update();
+
                     RenderingConfiguration r = RenderingConfiguration();
                     m_root->render(r);
 
                     // TODO Read pixels using BGRA!!!
                     glReadBuffer(GL_BACK);
-                    glPixelStorei(GL_PACK_ALIGNMENT, 1);
-                    glReadPixels(0, 0, m_image->getWidth(), m_image->getHeight(), GL_BGR, GL_UNSIGNED_BYTE, m_sharedMemory->getSharedMemory());
 
-                    // Flip the image horizontally.
-                    m_image->flipHorizontally();
+                    vector<char*> images(1, static_cast<char*>(m_sharedMemory->getSharedMemory()));
+                    if (m_readback->read(images)) {
+                        // Flip the image horizontally.
+                        m_image->flipHorizontally();
+                    }
 
                 m_sharedMemory->unlock();
             }
@@ -17,13 +17,19 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
+#include <algorithm>
+#include <cctype>
 #include <cstdio>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <map>
 #include <string>
 #include <vector>
 
 #include <memory>
 #include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/WorkerPool.h"
 #include "opendlv/data/environment/Point3.h"
 #include "opendlv/data/scenario/ComplexModel.h"
 #include "opendlv/data/scenario/Vertex3.h"
@@ -51,59 +57,96 @@ namespace opendlv {
 
         GroundBasedComplexModelLoader::~GroundBasedComplexModelLoader() {}
 
+        OBJXArchive* GroundBasedComplexModelLoader::loadModel(const SCNXArchive &scnxArchive, const string &modelFile) {
+            OBJXArchive *objxArchive = NULL;
+
+            std::shared_ptr<istream> in = scnxArchive.getModelData(modelFile);
+            if (in.get()) {
+                // Check model.
+                if (modelFile.find(".objx") != string::npos) {
+                    objxArchive = OBJXArchiveFactory::getInstance().getOBJXArchive(*in);
+                } else if (modelFile.find(".obj") != string::npos) {
+                    objxArchive = OBJXArchiveFactory::getInstance().getOBJXArchiveFromPlainOBJFile(*in);
+                }
+
+                if (objxArchive != NULL) {
+                    objxArchive->parse();
+                }
+            }
+
+            return objxArchive;
+        }
+
         TransformGroup* GroundBasedComplexModelLoader::getGroundBasedComplexModels(const SCNXArchive &scnxArchive) const {
             TransformGroup *complexModels = new TransformGroup();
 
             // Get list of all ground based complex models.
             vector<ComplexModel*> listOfComplexModels = scnxArchive.getListOfGroundBasedComplexModels();
 
-            // Iterate over all ground based complex models and try to build a transform group.
+            // Load every model file only once as entries of the archive are looked up case insensitively
+            // and their streams must not be read concurrently; one thread per hardware thread is used.
+            odcore::base::WorkerPool workers(0);
+            map<string, std::future<OBJXArchive*> > loadingModels;
+            vector<ComplexModel*>::iterator it = listOfComplexModels.begin();
+            while (it != listOfComplexModels.end()) {
+                const string MODEL_FILE = (*it++)->getModelFile();
+                string key = MODEL_FILE;
+                transform(key.begin(), key.end(), key.begin(), ::tolower);
+
+                if (loadingModels.find(key) == loadingModels.end()) {
+                    loadingModels[key] = workers.submit(std::bind(&GroundBasedComplexModelLoader::loadModel, std::cref(scnxArchive), MODEL_FILE));
+                }
+            }
+
+            map<string, OBJXArchive*> loadedModels;
+            map<string, std::future<OBJXArchive*> >::iterator kt = loadingModels.begin();
+            while (kt != loadingModels.end()) {
+                loadedModels[kt->first] = kt->second.get();
+                kt++;
+            }
+
+            // Iterate over all ground based complex models and try to build a transform group; this uses OpenGL and must happen in the calling thread.
             vector<ComplexModel*>::iterator jt = listOfComplexModels.begin();
             while (jt != listOfComplexModels.end()) {
                 ComplexModel *cm = (*jt++);
-                std::shared_ptr<istream> in = scnxArchive.getModelData(cm->getModelFile());
-                if (in.get()) {
-                    Node *model = NULL;
-
-                    // Check model.
-                    OBJXArchive *objxArchive = NULL;
-                    if (cm->getModelFile().find(".objx") != string::npos) {
-                        objxArchive = OBJXArchiveFactory::getInstance().getOBJXArchive(*in);
-                    } else if (cm->getModelFile().find(".obj") != string::npos) {
-                        objxArchive = OBJXArchiveFactory::getInstance().getOBJXArchiveFromPlainOBJFile(*in);
-                    }
-
-                    if (objxArchive != NULL) {
-                        model = objxArchive->createTransformGroup(NodeDescriptor(cm->getName()));
+                string key = cm->getModelFile();
+                transform(key.begin(), key.end(), key.begin(), ::tolower);
 
-                        if (model != NULL) {
-                            clog << "OBJ model successfully opened." << endl;
-                            clog << "  Translation: " << cm->getPosition().toString() << endl;
-                            clog << "  Rotation: " << cm->getRotation().toString() << endl;
+                OBJXArchive *objxArchive = loadedModels[key];
+                if (objxArchive != NULL) {
+                    Node *model = objxArchive->createTransformGroup(NodeDescriptor(cm->getName()));
 
-                            TransformGroup *complexModel = new TransformGroup();
+                    if (model != NULL) {
+                        clog << "OBJ model successfully opened." << endl;
+                        clog << "  Translation: " << cm->getPosition().toString() << endl;
+                        clog << "  Rotation: " << cm->getRotation().toString() << endl;
 
-                            // Translation.
-                            Point3 translation(cm->getPosition());
-                            complexModel->setTranslation(translation);
+                        TransformGroup *complexModel = new TransformGroup();
 
-                            // TODO: Achsenprüfung!!
-                            Point3 rotation(cm->getRotation().getX(), cm->getRotation().getZ(), cm->getRotation().getY());
-                            complexModel->setRotation(rotation);
+                        // Translation.
+                        Point3 translation(cm->getPosition());
+                        complexModel->setTranslation(translation);
 
-                            complexModel->addChild(model);
+                        // TODO: Achsenprüfung!!
+                        Point3 rotation(cm->getRotation().getX(), cm->getRotation().getZ(), cm->getRotation().getY());
+                        complexModel->setRotation(rotation);
 
-                            complexModels->addChild(complexModel);
+                        complexModel->addChild(model);
 
-                        } else {
-                            clog << "OBJ model could not be opened." << endl;
-                        }
+                        complexModels->addChild(complexModel);
 
-                        OPENDAVINCI_CORE_DELETE_POINTER(objxArchive);
+                    } else {
+                        clog << "OBJ model could not be opened." << endl;
                     }
                 }
             }
 
+            map<string, OBJXArchive*>::iterator mt = loadedModels.begin();
+            while (mt != loadedModels.end()) {
+                OPENDAVINCI_CORE_DELETE_POINTER(mt->second);
+                mt++;
+            }
+
             return complexModels;
         }
 
@@ -17,6 +17,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
+#include <future>
 #include <istream>
 #include <string>
 #include <vector>
@@ -50,20 +51,27 @@ namespace opendlv {
             m_aerialImage(NULL),
             m_heightImage(NULL) {
 
-            // Try to read the images from the archive.
-            stringstream sstr;
-            sstr << scenario.getGround().getAerialImage().getFileName();
-            std::shared_ptr<istream> stream = m_decompressedData->getInputStreamFor(sstr.str());
-            if (stream.get()) {
-                m_aerialImage = core::wrapper::ImageFactory::getInstance().getImage(*stream);
-            }
+            // Try to read the images from the archive; both are decoded in parallel.
+            std::shared_ptr<istream> aerialImageStream = m_decompressedData->getInputStreamFor(scenario.getGround().getAerialImage().getFileName());
+            std::shared_ptr<istream> heightImageStream = m_decompressedData->getInputStreamFor(scenario.getGround().getHeightImage().getFileName());
 
-            sstr.str("");
-            sstr << scenario.getGround().getHeightImage().getFileName();
-            stream = m_decompressedData->getInputStreamFor(sstr.str());
-            if (stream.get()) {
-                m_heightImage = core::wrapper::ImageFactory::getInstance().getImage(*stream);
+            if ( (aerialImageStream.get()) && (heightImageStream.get()) && (aerialImageStream != heightImageStream) ) {
+                std::future<core::wrapper::Image*> aerialImage = std::async(std::launch::async, &SCNXArchive::decodeImage, aerialImageStream);
+                m_heightImage = decodeImage(heightImageStream);
+                m_aerialImage = aerialImage.get();
             }
+            else {
+                if (aerialImageStream.get()) {
+                    m_aerialImage = decodeImage(aerialImageStream);
+                }
+                if (heightImageStream.get()) {
+                    m_heightImage = decodeImage(heightImageStream);
+                }
+            }
+        }
+
+        core::wrapper::Image* SCNXArchive::decodeImage(std::shared_ptr<istream> stream) {
+            return core::wrapper::ImageFactory::getInstance().getImage(*stream);
         }
 
         SCNXArchive::~SCNXArchive() {
@@ -17,9 +17,10 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
-#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <map>
+#include <sstream>
 #include <string>
 
 #include "opendavinci/odcore/opendavinci.h"
@@ -32,6 +33,7 @@
 #include "opendavinci/odcore/wrapper/CompressionFactory.h"
 #include "opendavinci/odcore/wrapper/DecompressedData.h"
 #include "opendlv/data/scenario/Scenario.h"
+#include "opendlv/io/ArchiveCache.h"
 #include "opendlv/scenario/SCNXArchive.h"
 #include "opendlv/scenario/SCNXArchiveFactory.h"
 #include "opendlv/scenario/ScenarioFactory.h"
@@ -93,26 +95,48 @@ namespace opendlv {
             if (scnxArchive == NULL) {
                 clog << "Creating new SCNXArchive from " << url.toString() << endl;
 
+                // The archive is read in place.
                 string fileName = url.getResource();
-                fstream fin(fileName.c_str(), ios::binary | ios::in);
-                std::shared_ptr<odcore::wrapper::DecompressedData> data = odcore::wrapper::CompressionFactory::getContents(fin);
-                fin.close();
+                std::shared_ptr<odcore::wrapper::DecompressedData> data = odcore::wrapper::CompressionFactory::getContents(fileName);
 
                 if (data.get()) {
                     Scenario scenario;
-                    std::shared_ptr<istream> stream = data->getInputStreamFor("scenario.scn");
-                    if (stream.get()) {
-                        stringstream s;
-                        char c;
-                        while (stream->good()) {
-                            stream->get(c);
-                            s << c;
-                        }
 
-                        // Trying to parse the input.
-                        scenario = ScenarioFactory::getInstance().getScenario(s.str());
-                    } else {
-                        OPENDAVINCI_CORE_THROW_EXCEPTION(InvalidArgumentException, "Archive from the given URL does not contain a valid SCN file.");
+                    // Try to use the already parsed scenario of an unmodified archive; the
+                    // archive's contents are still needed for its images and models.
+                    const string KEY = opendlv::io::ArchiveCache::getKeyForFile("scn-v2", fileName);
+                    std::shared_ptr<opendlv::io::ArchiveCache::Entry> entry;
+                    if (!KEY.empty()) {
+                        entry = opendlv::io::ArchiveCache::getInstance().get(KEY);
+                    }
+                    if (entry.get()) {
+                        clog << "Using cached scenario " << KEY << endl;
+                        opendlv::io::ArchiveCache::EntryStreamBuffer buffer(entry);
+                        istream cached(&buffer);
+                        cached >> scenario;
+                    }
+                    else {
+                        std::shared_ptr<istream> stream = data->getInputStreamFor("scenario.scn");
+                        if (stream.get()) {
+                            stringstream s;
+                            char c;
+                            while (stream->good()) {
+                                stream->get(c);
+                                s << c;
+                            }
+
+                            // Trying to parse the input.
+                            scenario = ScenarioFactory::getInstance().getScenario(s.str());
+
+                            // Store the parsed scenario for all further processes.
+                            if (!KEY.empty()) {
+                                stringstream serializedScenario;
+                                serializedScenario << scenario;
+                                opendlv::io::ArchiveCache::getInstance().put(KEY, serializedScenario.str());
+                            }
+                        } else {
+                            OPENDAVINCI_CORE_THROW_EXCEPTION(InvalidArgumentException, "Archive from the given URL does not contain a valid SCN file.");
+                        }
                     }
 
                     // Create SCNXArchive.
@@ -27,7 +27,11 @@ namespace opendlv {
         FrameCounter::FrameCounter() :
             m_frameCounter(0),
             m_lastFrame(),
-            m_fps(0)
+            m_fps(0),
+            m_beginOfFrame(),
+            m_timedFrames(0),
+            m_accumulatedFrameTime(0),
+            m_frameTime(0)
         {}
 
         FrameCounter::~FrameCounter()
@@ -37,6 +41,10 @@ namespace opendlv {
             m_frameCounter = 0;
             m_lastFrame = TimeStamp();
             m_fps = 0.0;
+            m_beginOfFrame = TimeStamp();
+            m_timedFrames = 0;
+            m_accumulatedFrameTime = 0;
+            m_frameTime = 0.0;
         }
 
         void FrameCounter::update() {
@@ -45,15 +53,37 @@ namespace opendlv {
             m_frameCounter++;
 
             if ( duration.toMicroseconds() > 1000*1000) {
-                m_fps = m_frameCounter / duration.getSecond();
+                m_fps = m_frameCounter / (duration.toMicroseconds() / (1000.0*1000.0));
                 m_frameCounter = 0;
                 m_lastFrame = TimeStamp();
+
+                if (m_timedFrames > 0) {
+                    m_frameTime = m_accumulatedFrameTime / (1000.0 * m_timedFrames);
+                }
+                m_timedFrames = 0;
+                m_accumulatedFrameTime = 0;
             }
         }
 
+        void FrameCounter::beginFrame() {
+            m_beginOfFrame = TimeStamp();
+        }
+
+        void FrameCounter::endFrame() {
+            TimeStamp current;
+            m_accumulatedFrameTime += (current - m_beginOfFrame).toMicroseconds();
+            m_timedFrames++;
+
+            update();
+        }
+
 
         double FrameCounter::getFPS() {
             return m_fps;
         }
+
+        double FrameCounter::getFrameTime() {
+            return m_frameTime;
+        }
     }
 }
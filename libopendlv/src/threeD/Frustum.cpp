@@ -0,0 +1,105 @@
+/**
+ * OpenDLV - Simulation environment
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+// The following include is necessary on Win32 platforms to set up necessary macro definitions.
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#ifdef __APPLE__
+    #include <OpenGL/gl.h>
+#else
+    #include <GL/gl.h>
+#endif
+
+#include <cstring>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendlv/data/environment/Point3.h"
+#include "opendlv/threeD/Frustum.h"
+
+namespace opendlv {
+    namespace threeD {
+
+        using namespace opendlv::data::environment;
+
+        Frustum::Frustum() :
+            m_planes() {}
+
+        Frustum::Frustum(const Frustum &obj) :
+            m_planes() {
+            memcpy(m_planes, obj.m_planes, sizeof(m_planes));
+        }
+
+        Frustum::~Frustum() {}
+
+        Frustum& Frustum::operator=(const Frustum &obj) {
+            memcpy(m_planes, obj.m_planes, sizeof(m_planes));
+            return (*this);
+        }
+
+        void Frustum::update(const double *projection, const double *modelView) {
+            // Combined matrix (column-major): clip = projection * modelView.
+            double clip[16];
+            for (uint32_t column = 0; column < 4; column++) {
+                for (uint32_t row = 0; row < 4; row++) {
+                    double sum = 0;
+                    for (uint32_t k = 0; k < 4; k++) {
+                        sum += projection[k * 4 + row] * modelView[column * 4 + k];
+                    }
+                    clip[column * 4 + row] = sum;
+                }
+            }
+
+            // Each plane is the sum or difference of the fourth row and one of the other rows
+            // (left, right, bottom, top, near, far).
+            for (uint32_t plane = 0; plane < NUMBER_OF_PLANES; plane++) {
+                const uint32_t ROW = plane / 2;
+                const double SIGN = ((plane % 2) == 0) ? 1.0 : -1.0;
+                for (uint32_t column = 0; column < 4; column++) {
+                    m_planes[plane][column] = clip[column * 4 + 3] + SIGN * clip[column * 4 + ROW];
+                }
+            }
+        }
+
+        void Frustum::updateFromOpenGL() {
+            double projection[16];
+            double modelView[16];
+            glGetDoublev(GL_PROJECTION_MATRIX, projection);
+            glGetDoublev(GL_MODELVIEW_MATRIX, modelView);
+            update(projection, modelView);
+        }
+
+        bool Frustum::isVisible(const Point3 &minimum, const Point3 &maximum) const {
+            for (uint32_t plane = 0; plane < NUMBER_OF_PLANES; plane++) {
+                const double *p = m_planes[plane];
+
+                // Test the corner farthest along the plane's normal.
+                const double X = (p[0] >= 0) ? maximum.getX() : minimum.getX();
+                const double Y = (p[1] >= 0) ? maximum.getY() : minimum.getY();
+                const double Z = (p[2] >= 0) ? maximum.getZ() : minimum.getZ();
+                if ((p[0] * X + p[1] * Y + p[2] * Z + p[3]) < 0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    }
+} // opendlv::threeD
@@ -30,6 +30,14 @@ namespace opendlv {
 
         Node::~Node() {}
 
+        bool Node::getBoundingBox(opendlv::data::environment::Point3 &/*minimum*/, opendlv::data::environment::Point3 &/*maximum*/) {
+            return false;
+        }
+
+        bool Node::isCompilable() const {
+            return true;
+        }
+
         const NodeDescriptor Node::getNodeDescriptor() const {
             return m_nodeDescriptor;
         }
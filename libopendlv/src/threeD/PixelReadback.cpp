@@ -0,0 +1,201 @@
+/**
+ * OpenDLV - Simulation environment
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+// The following include is necessary on Win32 platforms to set up necessary macro definitions.
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#ifdef __APPLE__
+    #include <OpenGL/gl.h>
+    #define HAVE_PIXEL_BUFFER_OBJECTS
+#elif !defined(WIN32)
+    // Pixel buffer objects are part of OpenGL 2.1 and exported by libGL.
+    #define GL_GLEXT_PROTOTYPES
+    #include <GL/gl.h>
+    #include <GL/glext.h>
+    #define HAVE_PIXEL_BUFFER_OBJECTS
+#else
+    #include <GL/gl.h>
+#endif
+
+// Under Win32, GL_BGR is missing.
+#ifdef WIN32
+#ifndef GL_BGR
+#define GL_BGR 0x80E0
+#endif
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendlv/threeD/PixelReadback.h"
+
+namespace opendlv {
+    namespace threeD {
+
+        using namespace std;
+
+        PixelReadback::PixelReadback(const uint32_t &width, const uint32_t &height, const uint32_t &numberOfViews, const bool &allowAsynchronous) :
+            m_width(width),
+            m_height(height),
+            m_numberOfViews((numberOfViews > 0) ? numberOfViews : 1),
+            m_allowAsynchronous(allowAsynchronous),
+            m_isInitialized(false),
+            m_isAsynchronous(false),
+            m_buffers(),
+            m_currentBuffer(0),
+            m_numberOfFrames(0),
+            m_frame() {}
+
+        PixelReadback::~PixelReadback() {
+#ifdef HAVE_PIXEL_BUFFER_OBJECTS
+            if (m_isAsynchronous) {
+                glDeleteBuffers(PixelReadback::NUMBER_OF_BUFFERS, m_buffers);
+            }
+#endif
+        }
+
+        uint32_t PixelReadback::getNumberOfViews() const {
+            return m_numberOfViews;
+        }
+
+        bool PixelReadback::isAsynchronous() {
+            initialize();
+            return m_isAsynchronous;
+        }
+
+        void PixelReadback::initialize() {
+            if (m_isInitialized) {
+                return;
+            }
+            m_isInitialized = true;
+
+#ifdef HAVE_PIXEL_BUFFER_OBJECTS
+            // Pixel buffer objects require OpenGL 2.1 or GL_ARB_pixel_buffer_object.
+            const char *VERSION = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+            const char *EXTENSIONS = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+            int major = 0;
+            int minor = 0;
+            bool isSupported = false;
+            if ( (VERSION != NULL) && (::sscanf(VERSION, "%d.%d", &major, &minor) == 2) ) {
+                isSupported = (major > 2) || ( (major == 2) && (minor >= 1) );
+            }
+            if ( (EXTENSIONS != NULL) && (::strstr(EXTENSIONS, "GL_ARB_pixel_buffer_object") != NULL) ) {
+                isSupported = true;
+            }
+
+            // Synchronous reading can be enforced, e.g. for comparing both variants.
+            if ( (!m_allowAsynchronous) || (::getenv("OPENDLV_SYNCHRONOUS_READBACK") != NULL) ) {
+                isSupported = false;
+            }
+
+            if (isSupported) {
+                const uint32_t SIZE = m_width * m_numberOfViews * m_height * PixelReadback::BYTES_PER_PIXEL;
+                glGenBuffers(PixelReadback::NUMBER_OF_BUFFERS, m_buffers);
+                for (uint32_t i = 0; i < PixelReadback::NUMBER_OF_BUFFERS; i++) {
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffers[i]);
+                    glBufferData(GL_PIXEL_PACK_BUFFER, SIZE, NULL, GL_STREAM_READ);
+                }
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                m_isAsynchronous = true;
+            }
+#endif
+
+            clog << "PixelReadback: Reading " << m_numberOfViews << " view(s) " << (m_isAsynchronous ? "asynchronously." : "synchronously.") << endl;
+        }
+
+        void PixelReadback::setViewport(const uint32_t &view) const {
+            glViewport(view * m_width, 0, m_width, m_height);
+        }
+
+        bool PixelReadback::read(const vector<char*> &images) {
+            initialize();
+
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+            if (!m_isAsynchronous) {
+                // A single view is read directly into the image.
+                if ( (m_numberOfViews == 1) && (!images.empty()) && (images.at(0) != NULL) ) {
+                    glReadPixels(0, 0, m_width, m_height, GL_BGR, GL_UNSIGNED_BYTE, images.at(0));
+                    return true;
+                }
+
+                m_frame.resize(m_width * m_numberOfViews * m_height * PixelReadback::BYTES_PER_PIXEL);
+                glReadPixels(0, 0, m_width * m_numberOfViews, m_height, GL_BGR, GL_UNSIGNED_BYTE, &m_frame[0]);
+                copyViews(&m_frame[0], images);
+                return true;
+            }
+
+            bool hasFrame = false;
+#ifdef HAVE_PIXEL_BUFFER_OBJECTS
+            // Start the transfer of the current frame; glReadPixels returns immediately.
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffers[m_currentBuffer]);
+            glReadPixels(0, 0, m_width * m_numberOfViews, m_height, GL_BGR, GL_UNSIGNED_BYTE, NULL);
+
+            // Wait for the very first frame or fetch the previous one. After
+            // the second call, the first frame was already returned while
+            // the second one is still transferred; thus, nothing is returned
+            // so that the caller does not publish the first frame twice.
+            const uint32_t PREVIOUS = (m_currentBuffer + 1) % PixelReadback::NUMBER_OF_BUFFERS;
+            const bool HAS_COMPLETED_FRAME = (m_numberOfFrames != 1);
+            if (HAS_COMPLETED_FRAME) {
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffers[(m_numberOfFrames == 0) ? m_currentBuffer : PREVIOUS]);
+                const char *frame = static_cast<const char*>(glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY));
+                if (frame != NULL) {
+                    copyViews(frame, images);
+                    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+                    hasFrame = true;
+                }
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+            m_currentBuffer = PREVIOUS;
+            m_numberOfFrames++;
+#endif
+            return hasFrame;
+        }
+
+        void PixelReadback::copyViews(const char *frame, const vector<char*> &images) const {
+            for (uint32_t view = 0; (view < m_numberOfViews) && (view < images.size()); view++) {
+                if (images.at(view) != NULL) {
+                    copyView(frame, m_width, m_height, m_numberOfViews, view, images.at(view));
+                }
+            }
+        }
+
+        void PixelReadback::copyView(const char *frame, const uint32_t &width, const uint32_t &height, const uint32_t &numberOfViews, const uint32_t &view, char *image) {
+            const uint32_t ROW = width * PixelReadback::BYTES_PER_PIXEL;
+            if (numberOfViews == 1) {
+                memcpy(image, frame, ROW * height);
+                return;
+            }
+
+            for (uint32_t y = 0; y < height; y++) {
+                memcpy(image + y * ROW, frame + (y * numberOfViews + view) * ROW, ROW);
+            }
+        }
+
+    }
+} // opendlv::threeD
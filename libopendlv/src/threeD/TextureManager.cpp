@@ -30,16 +30,29 @@
     #include <GL/glu.h>
 #endif
 
-// Under Win32, GL_BGR is missing.
+// Under Win32, GL_BGR and the texture level parameters are missing.
 #ifdef WIN32
 #ifndef GL_BGR
 #define GL_BGR 0x80E0
 #endif
+#ifndef GL_TEXTURE_BASE_LEVEL
+#define GL_TEXTURE_BASE_LEVEL 0x813C
+#endif
+#ifndef GL_TEXTURE_MAX_LEVEL
+#define GL_TEXTURE_MAX_LEVEL 0x813D
+#endif
 #endif
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/base/Lock.h"
@@ -55,12 +68,41 @@ namespace opendlv {
         using namespace std;
         using namespace odcore::base;
 
+        // Number of bytes per pixel of all textures.
+        static const uint32_t BYTES_PER_PIXEL = 3;
+
         // Initialize singleton instance.
         Mutex TextureManager::m_singletonMutex;
         TextureManager* TextureManager::m_singleton = NULL;
 
+        TextureManager::MipmapLevel::MipmapLevel() :
+                m_width(0),
+                m_height(0),
+                m_data() {}
+
+        TextureManager::Texture::Texture() :
+                m_handle(0),
+                m_format(0),
+                m_pendingMipmaps(),
+                m_mipmaps(),
+                m_previewLevel(0),
+                m_baseLevel(0),
+                m_uploadedRows(0),
+                m_residentBytes(0),
+                m_lastUse(0),
+                m_isReleased(false) {}
+
         TextureManager::TextureManager() :
-                m_mapOfTextureHandles() {}
+                m_texturesMutex(),
+                m_mapOfTextureHandles(),
+                m_mapOfTextures(),
+                m_frame(0),
+                m_memoryBudget(DEFAULT_MEMORY_BUDGET),
+                m_uploadBudget(DEFAULT_UPLOAD_BUDGET),
+                m_residentMemory(0),
+                m_isRecording(false),
+                m_recordedTextures(),
+                m_mipmapWorkers(0) {}
 
         TextureManager::~TextureManager() {}
 
@@ -76,15 +118,24 @@ namespace opendlv {
         }
 
         void TextureManager::removeTexture(const string &name) {
+            Lock l(m_texturesMutex);
+
             map<string, uint32_t, odcore::strings::StringComparator>::iterator it = m_mapOfTextureHandles.find(name);
             if (it != m_mapOfTextureHandles.end()) {
                 // TODO: glDeleteTextures(1, it->second); fails...
+                map<uint32_t, std::shared_ptr<Texture> >::iterator jt = m_mapOfTextures.find(it->second);
+                if (jt != m_mapOfTextures.end()) {
+                    m_residentMemory -= jt->second->m_residentBytes;
+                    m_mapOfTextures.erase(jt);
+                }
                 m_mapOfTextureHandles.erase(it);
                 clog << "Removed texture " << name << "." << endl;
             }
         }
 
         int32_t TextureManager::getTexture(const string &name) const {
+            Lock l(m_texturesMutex);
+
             int32_t textureHandle = -1;
 
             map<string, uint32_t, odcore::strings::StringComparator>::const_iterator it = m_mapOfTextureHandles.find(name);
@@ -96,6 +147,8 @@ namespace opendlv {
         }
 
         bool TextureManager::hasTexture(const string &name) const {
+            Lock l(m_texturesMutex);
+
             bool retVal = false;
 
             map<string, uint32_t, odcore::strings::StringComparator>::const_iterator it = m_mapOfTextureHandles.find(name);
@@ -104,45 +157,66 @@ namespace opendlv {
             return retVal;
         }
 
+        bool TextureManager::isComplete(const string &name) const {
+            Lock l(m_texturesMutex);
+
+            map<string, uint32_t, odcore::strings::StringComparator>::const_iterator it = m_mapOfTextureHandles.find(name);
+            if (it != m_mapOfTextureHandles.end()) {
+                map<uint32_t, std::shared_ptr<Texture> >::const_iterator jt = m_mapOfTextures.find(it->second);
+                return ( (jt != m_mapOfTextures.end()) && jt->second->m_mipmaps.get() && (0 == jt->second->m_baseLevel) );
+            }
+            return false;
+        }
+
         bool TextureManager::addImage(const string &name, const core::wrapper::Image *image) {
             bool retVal = false;
 
             if ( (name.length() != 0) && ( (image != NULL) && (image->getHeight() > 0) && (image->getWidth() > 0) && (image->getWidthStep() > 0) ) ) {
+                Lock l(m_texturesMutex);
+
                 // Check if a texture was previously registered for this name.
                 if (m_mapOfTextureHandles.find(name) == m_mapOfTextureHandles.end()) {
-                    // No texture registered, thus register the give image.
-                    uint32_t identifier = 0;
-
-                    glGenTextures(1, &identifier);
-                    glBindTexture(GL_TEXTURE_2D, identifier);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-
                     // Set up byte order.
                     GLenum format = GL_RGB;
-                    uint32_t numberOfColorComponents = 0;
                     switch (image->getFormat()) {
                     case core::wrapper::Image::BGR_24BIT:
                         format = GL_BGR;
-                        numberOfColorComponents = 3;
                         break;
                     case core::wrapper::Image::RGB_24BIT:
                         format = GL_RGB;
-                        numberOfColorComponents = 3;
                         break;
                     case core::wrapper::Image::INVALID:
                         format = 0;
                     }
 
                     if (format != 0) {
+                        // No texture registered, thus register the give image.
+                        uint32_t identifier = 0;
+
+                        glGenTextures(1, &identifier);
+                        glBindTexture(GL_TEXTURE_2D, identifier);
+                        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+
+                        GLint maximumSize = 0;
+                        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maximumSize);
+
+                        // Copy the image's rows without padding as the image might be released while computing the mipmaps.
+                        const uint32_t ROW_LENGTH = image->getWidth() * BYTES_PER_PIXEL;
+                        std::shared_ptr<vector<unsigned char> > pixels(new vector<unsigned char>(ROW_LENGTH * image->getHeight()));
+                        for (uint32_t row = 0; row < image->getHeight(); row++) {
+                            memcpy(&(*pixels)[row * ROW_LENGTH], image->getRawData() + row * image->getWidthStep(), std::min(ROW_LENGTH, image->getWidthStep()));
+                        }
 
-                        // 2d texture, level of detail 0 (normal), 3 components (red, green, blue), x size from image, y size from image,
-                        // border 0 (normal), rgb color data, unsigned byte data, and finally the data itself.
-                        glTexImage2D(GL_TEXTURE_2D, 0, numberOfColorComponents, image->getWidth(), image->getHeight(), 0, format, GL_UNSIGNED_BYTE, image->getRawData());
-                        gluBuild2DMipmaps(GL_TEXTURE_2D, numberOfColorComponents, image->getWidth(), image->getHeight(), format, GL_UNSIGNED_BYTE, image->getRawData());
+                        std::shared_ptr<Texture> texture(new Texture());
+                        texture->m_handle = identifier;
+                        texture->m_format = format;
+                        texture->m_lastUse = m_frame;
+                        texture->m_pendingMipmaps = m_mipmapWorkers.submit(std::bind(&TextureManager::buildMipmaps, pixels, image->getWidth(), image->getHeight(), static_cast<uint32_t>(std::max<GLint>(1, maximumSize))));
 
                         // Register texture using the given name.
                         m_mapOfTextureHandles[name] = identifier;
+                        m_mapOfTextures[identifier] = texture;
 
                         retVal = true;
                     } else {
@@ -154,5 +228,282 @@ namespace opendlv {
             return retVal;
         }
 
+        void TextureManager::bindTexture(const uint32_t &textureHandle) {
+            {
+                Lock l(m_texturesMutex);
+
+                map<uint32_t, std::shared_ptr<Texture> >::iterator it = m_mapOfTextures.find(textureHandle);
+                if (it != m_mapOfTextures.end()) {
+                    it->second->m_lastUse = m_frame;
+                }
+                if (m_isRecording) {
+                    m_recordedTextures.push_back(textureHandle);
+                }
+            }
+
+            glBindTexture(GL_TEXTURE_2D, textureHandle);
+        }
+
+        void TextureManager::startRecordingBoundTextures() {
+            Lock l(m_texturesMutex);
+            m_isRecording = true;
+            m_recordedTextures.clear();
+        }
+
+        void TextureManager::stopRecordingBoundTextures(vector<uint32_t> &textureHandles) {
+            Lock l(m_texturesMutex);
+            m_isRecording = false;
+
+            std::sort(m_recordedTextures.begin(), m_recordedTextures.end());
+            m_recordedTextures.erase(std::unique(m_recordedTextures.begin(), m_recordedTextures.end()), m_recordedTextures.end());
+            textureHandles = m_recordedTextures;
+            m_recordedTextures.clear();
+        }
+
+        void TextureManager::markAsUsed(const vector<uint32_t> &textureHandles) {
+            Lock l(m_texturesMutex);
+
+            vector<uint32_t>::const_iterator it = textureHandles.begin();
+            while (it != textureHandles.end()) {
+                map<uint32_t, std::shared_ptr<Texture> >::iterator jt = m_mapOfTextures.find(*it++);
+                if (jt != m_mapOfTextures.end()) {
+                    jt->second->m_lastUse = m_frame;
+                }
+            }
+        }
+
+        void TextureManager::setMemoryBudget(const uint64_t &bytes) {
+            Lock l(m_texturesMutex);
+            m_memoryBudget = bytes;
+        }
+
+        uint64_t TextureManager::getMemoryBudget() const {
+            Lock l(m_texturesMutex);
+            return m_memoryBudget;
+        }
+
+        void TextureManager::setUploadBudget(const uint32_t &bytes) {
+            Lock l(m_texturesMutex);
+            m_uploadBudget = bytes;
+        }
+
+        uint64_t TextureManager::getResidentMemory() const {
+            Lock l(m_texturesMutex);
+            return m_residentMemory;
+        }
+
+        void TextureManager::update() {
+            Lock l(m_texturesMutex);
+
+            m_frame++;
+
+            GLint previousTexture = 0;
+            glGetIntegerv(GL_TEXTURE_BINDING_2D, &previousTexture);
+            glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+            uint64_t uploaded = 0;
+            map<uint32_t, std::shared_ptr<Texture> >::iterator it = m_mapOfTextures.begin();
+            while (it != m_mapOfTextures.end()) {
+                Texture &texture = *(it++)->second;
+
+                // Take over finished mipmaps.
+                if (texture.m_pendingMipmaps.valid() && (texture.m_pendingMipmaps.wait_for(std::chrono::seconds(0)) == std::future_status::ready)) {
+                    texture.m_mipmaps = texture.m_pendingMipmaps.get();
+
+                    const uint32_t NUMBER_OF_LEVELS = static_cast<uint32_t>(texture.m_mipmaps->size());
+                    texture.m_baseLevel = NUMBER_OF_LEVELS;
+                    texture.m_previewLevel = NUMBER_OF_LEVELS - 1;
+                    while ( (texture.m_previewLevel > 0) &&
+                            (std::max(texture.m_mipmaps->at(texture.m_previewLevel - 1).m_width, texture.m_mipmaps->at(texture.m_previewLevel - 1).m_height) <= PREVIEW_SIZE) ) {
+                        texture.m_previewLevel--;
+                    }
+
+                    glBindTexture(GL_TEXTURE_2D, texture.m_handle);
+                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, NUMBER_OF_LEVELS - 1);
+                }
+
+                // Released textures are refined only while they are in use.
+                if ( texture.m_mipmaps.get() && (uploaded < m_uploadBudget) &&
+                     (!texture.m_isReleased || ((texture.m_lastUse + 1) >= m_frame)) ) {
+                    uploaded += upload(texture, m_uploadBudget - uploaded);
+                }
+            }
+
+            // Release the least recently used textures that were not bound during the last frame.
+            m_residentMemory = 0;
+            for (it = m_mapOfTextures.begin(); it != m_mapOfTextures.end(); it++) {
+                m_residentMemory += it->second->m_residentBytes;
+            }
+            while (m_residentMemory > m_memoryBudget) {
+                Texture *leastRecentlyUsed = NULL;
+                for (it = m_mapOfTextures.begin(); it != m_mapOfTextures.end(); it++) {
+                    Texture &texture = *it->second;
+                    const bool RELEASABLE = texture.m_mipmaps.get() && (texture.m_baseLevel <= texture.m_previewLevel) &&
+                                            ((texture.m_baseLevel < texture.m_previewLevel) || (texture.m_uploadedRows > 0));
+                    if ( RELEASABLE && ((texture.m_lastUse + 1) < m_frame) &&
+                         ((leastRecentlyUsed == NULL) || (texture.m_lastUse < leastRecentlyUsed->m_lastUse)) ) {
+                        leastRecentlyUsed = &texture;
+                    }
+                }
+                if (leastRecentlyUsed == NULL) {
+                    break;
+                }
+
+                m_residentMemory -= leastRecentlyUsed->m_residentBytes;
+                release(*leastRecentlyUsed);
+                m_residentMemory += leastRecentlyUsed->m_residentBytes;
+            }
+
+            glPopClientAttrib();
+            glBindTexture(GL_TEXTURE_2D, static_cast<uint32_t>(previousTexture));
+        }
+
+        uint64_t TextureManager::upload(Texture &texture, const uint64_t &budget) {
+            uint64_t uploaded = 0;
+
+            glBindTexture(GL_TEXTURE_2D, texture.m_handle);
+            while ( (texture.m_baseLevel > 0) && (uploaded < budget) ) {
+                const uint32_t LEVEL = texture.m_baseLevel - 1;
+                MipmapLevel &mipmapLevel = texture.m_mipmaps->at(LEVEL);
+                const uint32_t ROW_LENGTH = mipmapLevel.m_width * BYTES_PER_PIXEL;
+
+                if (0 == texture.m_uploadedRows) {
+                    glTexImage2D(GL_TEXTURE_2D, LEVEL, GL_RGB, mipmapLevel.m_width, mipmapLevel.m_height, 0, texture.m_format, GL_UNSIGNED_BYTE, NULL);
+                }
+
+                // Upload a tile of complete rows; at least one row is uploaded per call.
+                const uint32_t ROWS = static_cast<uint32_t>(std::min<uint64_t>(mipmapLevel.m_height - texture.m_uploadedRows, std::max<uint64_t>(1, (budget - uploaded) / ROW_LENGTH)));
+                glTexSubImage2D(GL_TEXTURE_2D, LEVEL, 0, texture.m_uploadedRows, mipmapLevel.m_width, ROWS, texture.m_format, GL_UNSIGNED_BYTE, &mipmapLevel.m_data[texture.m_uploadedRows * ROW_LENGTH]);
+
+                uploaded += static_cast<uint64_t>(ROWS) * ROW_LENGTH;
+                texture.m_residentBytes += static_cast<uint64_t>(ROWS) * ROW_LENGTH;
+                texture.m_uploadedRows += ROWS;
+
+                if (texture.m_uploadedRows == mipmapLevel.m_height) {
+                    // The level is complete; thus, use it for rendering.
+                    texture.m_uploadedRows = 0;
+                    texture.m_baseLevel = LEVEL;
+                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, LEVEL);
+
+                    // Levels that might be released are kept on the GPU only; release() reads them back.
+                    if (LEVEL < texture.m_previewLevel) {
+                        vector<unsigned char>().swap(mipmapLevel.m_data);
+                    }
+                }
+            }
+
+            if (0 == texture.m_baseLevel) {
+                texture.m_isReleased = false;
+            }
+
+            return uploaded;
+        }
+
+        void TextureManager::release(Texture &texture) {
+            glBindTexture(GL_TEXTURE_2D, texture.m_handle);
+
+            // Specifying empty images frees the memory of the finer levels
+            // after the completely uploaded ones were read back.
+            texture.m_residentBytes = 0;
+            for (uint32_t level = 0; level < texture.m_mipmaps->size(); level++) {
+                MipmapLevel &mipmapLevel = texture.m_mipmaps->at(level);
+                if (level < texture.m_previewLevel) {
+                    if ( (level >= texture.m_baseLevel) && mipmapLevel.m_data.empty() ) {
+                        mipmapLevel.m_data.resize(static_cast<uint64_t>(mipmapLevel.m_width) * mipmapLevel.m_height * BYTES_PER_PIXEL);
+                        glGetTexImage(GL_TEXTURE_2D, level, texture.m_format, GL_UNSIGNED_BYTE, &mipmapLevel.m_data[0]);
+                    }
+                    glTexImage2D(GL_TEXTURE_2D, level, GL_RGB, 0, 0, 0, texture.m_format, GL_UNSIGNED_BYTE, NULL);
+                }
+                else {
+                    texture.m_residentBytes += static_cast<uint64_t>(mipmapLevel.m_width) * mipmapLevel.m_height * BYTES_PER_PIXEL;
+                }
+            }
+
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, texture.m_previewLevel);
+            texture.m_baseLevel = texture.m_previewLevel;
+            texture.m_uploadedRows = 0;
+            texture.m_isReleased = true;
+        }
+
+        std::shared_ptr<vector<TextureManager::MipmapLevel> > TextureManager::buildMipmaps(std::shared_ptr<vector<unsigned char> > pixels, const uint32_t width, const uint32_t height, const uint32_t maximumSize) {
+            std::shared_ptr<vector<MipmapLevel> > mipmaps(new vector<MipmapLevel>());
+
+            // Find the nearest power of two for both dimensions.
+            uint32_t size[2] = { width, height };
+            for (uint32_t i = 0; i < 2; i++) {
+                uint32_t powerOfTwo = 1;
+                while ((powerOfTwo * 2) <= size[i]) {
+                    powerOfTwo *= 2;
+                }
+                if ((size[i] - powerOfTwo) > (2 * powerOfTwo - size[i])) {
+                    powerOfTwo *= 2;
+                }
+                size[i] = std::min(powerOfTwo, maximumSize);
+            }
+
+            // Resize the image bilinearly to the finest level.
+            MipmapLevel finest;
+            finest.m_width = size[0];
+            finest.m_height = size[1];
+            if ( (finest.m_width == width) && (finest.m_height == height) ) {
+                finest.m_data.swap(*pixels);
+            }
+            else {
+                finest.m_data.resize(finest.m_width * finest.m_height * BYTES_PER_PIXEL);
+                const float SCALE_X = static_cast<float>(width) / finest.m_width;
+                const float SCALE_Y = static_cast<float>(height) / finest.m_height;
+                for (uint32_t y = 0; y < finest.m_height; y++) {
+                    const float SOURCE_Y = std::max(0.0f, (y + 0.5f) * SCALE_Y - 0.5f);
+                    const uint32_t Y0 = std::min(static_cast<uint32_t>(SOURCE_Y), height - 1);
+                    const uint32_t Y1 = std::min(Y0 + 1, height - 1);
+                    const float WEIGHT_Y = SOURCE_Y - Y0;
+                    for (uint32_t x = 0; x < finest.m_width; x++) {
+                        const float SOURCE_X = std::max(0.0f, (x + 0.5f) * SCALE_X - 0.5f);
+                        const uint32_t X0 = std::min(static_cast<uint32_t>(SOURCE_X), width - 1);
+                        const uint32_t X1 = std::min(X0 + 1, width - 1);
+                        const float WEIGHT_X = SOURCE_X - X0;
+                        for (uint32_t c = 0; c < BYTES_PER_PIXEL; c++) {
+                            const float TOP = (1 - WEIGHT_X) * (*pixels)[(Y0 * width + X0) * BYTES_PER_PIXEL + c] + WEIGHT_X * (*pixels)[(Y0 * width + X1) * BYTES_PER_PIXEL + c];
+                            const float BOTTOM = (1 - WEIGHT_X) * (*pixels)[(Y1 * width + X0) * BYTES_PER_PIXEL + c] + WEIGHT_X * (*pixels)[(Y1 * width + X1) * BYTES_PER_PIXEL + c];
+                            finest.m_data[(y * finest.m_width + x) * BYTES_PER_PIXEL + c] = static_cast<unsigned char>((1 - WEIGHT_Y) * TOP + WEIGHT_Y * BOTTOM + 0.5f);
+                        }
+                    }
+                }
+            }
+            mipmaps->push_back(std::move(finest));
+
+            // Each coarser level averages 2x2 pixels of the finer one.
+            while ( (mipmaps->back().m_width > 1) || (mipmaps->back().m_height > 1) ) {
+                const MipmapLevel &finer = mipmaps->back();
+                MipmapLevel coarser;
+                coarser.m_width = std::max<uint32_t>(1, finer.m_width / 2);
+                coarser.m_height = std::max<uint32_t>(1, finer.m_height / 2);
+                coarser.m_data.resize(coarser.m_width * coarser.m_height * BYTES_PER_PIXEL);
+
+                const uint32_t STEP_X = (finer.m_width > 1) ? 1 : 0;
+                const uint32_t STEP_Y = (finer.m_height > 1) ? 1 : 0;
+                for (uint32_t y = 0; y < coarser.m_height; y++) {
+                    const uint32_t ROW0 = (STEP_Y > 0) ? (2 * y) : y;
+                    const uint32_t ROW1 = ROW0 + STEP_Y;
+                    for (uint32_t x = 0; x < coarser.m_width; x++) {
+                        const uint32_t COLUMN0 = (STEP_X > 0) ? (2 * x) : x;
+                        const uint32_t COLUMN1 = COLUMN0 + STEP_X;
+                        for (uint32_t c = 0; c < BYTES_PER_PIXEL; c++) {
+                            const uint32_t SUM = finer.m_data[(ROW0 * finer.m_width + COLUMN0) * BYTES_PER_PIXEL + c] +
+                                                 finer.m_data[(ROW0 * finer.m_width + COLUMN1) * BYTES_PER_PIXEL + c] +
+                                                 finer.m_data[(ROW1 * finer.m_width + COLUMN0) * BYTES_PER_PIXEL + c] +
+                                                 finer.m_data[(ROW1 * finer.m_width + COLUMN1) * BYTES_PER_PIXEL + c];
+                            coarser.m_data[(y * coarser.m_width + x) * BYTES_PER_PIXEL + c] = static_cast<unsigned char>((SUM + 2) / 4);
+                        }
+                    }
+                }
+                mipmaps->push_back(std::move(coarser));
+            }
+
+            return mipmaps;
+        }
+
     }
 } // opendlv::threeD
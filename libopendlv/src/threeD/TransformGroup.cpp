@@ -23,21 +23,31 @@
 #endif
 
 #ifdef __APPLE__
+    #include <OpenGL/OpenGL.h>
     #include <OpenGL/gl.h>
 #else
     #include <GL/gl.h>
 #endif
 
+#if !defined(WIN32) && !defined(__APPLE__)
+// Exported by libGL; declared here to not depend on the X11 headers from GL/glx.h.
+extern "C" void* glXGetCurrentContext(void);
+#endif
+
 #include <algorithm>
+#include <cmath>
 #include <vector>
 
 #include "opendavinci/odcore/base/Lock.h"
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendlv/data/environment/Point3.h"
+#include "opendlv/threeD/Frustum.h"
 #include "opendlv/threeD/Node.h"
 #include "opendlv/threeD/NodeDescriptor.h"
+#include "opendlv/threeD/NodeRenderingConfiguration.h"
 #include "opendlv/threeD/TransformGroup.h"
 #include "opendlv/threeD/RenderingConfiguration.h"
+#include "opendlv/threeD/TextureManager.h"
 
 namespace opendlv { namespace threeD { class TransformGroupVisitor; } }
 
@@ -47,13 +57,56 @@ namespace opendlv {
         using namespace odcore::base;
         using namespace opendlv::data::environment;
 
+        TransformGroup::CachedChild::CachedChild() :
+                m_node(NULL),
+                m_isRenderedDirectly(false),
+                m_hasBoundingBox(false),
+                m_minimum(),
+                m_maximum(),
+                m_isPrepared(false),
+                m_callList(0),
+                m_drawTextures(false),
+                m_textures() {}
+
+        TransformGroup::CachedChild::CachedChild(const CachedChild &obj) :
+                m_node(obj.m_node),
+                m_isRenderedDirectly(obj.m_isRenderedDirectly),
+                m_hasBoundingBox(obj.m_hasBoundingBox),
+                m_minimum(obj.m_minimum),
+                m_maximum(obj.m_maximum),
+                m_isPrepared(obj.m_isPrepared),
+                m_callList(obj.m_callList),
+                m_drawTextures(obj.m_drawTextures),
+                m_textures(obj.m_textures) {}
+
+        TransformGroup::CachedChild& TransformGroup::CachedChild::operator=(const CachedChild &obj) {
+            m_node = obj.m_node;
+            m_isRenderedDirectly = obj.m_isRenderedDirectly;
+            m_hasBoundingBox = obj.m_hasBoundingBox;
+            m_minimum = obj.m_minimum;
+            m_maximum = obj.m_maximum;
+            m_isPrepared = obj.m_isPrepared;
+            m_callList = obj.m_callList;
+            m_drawTextures = obj.m_drawTextures;
+            m_textures = obj.m_textures;
+            return (*this);
+        }
+
         TransformGroup::TransformGroup() :
                 Node(NodeDescriptor()),
                 m_translation(),
                 m_rotation(),
                 m_scaling(Point3(1, 1, 1)),
                 m_listOfChildrenMutex(),
-                m_listOfChildren() {}
+                m_listOfChildren(),
+                m_isStatic(false),
+                m_isBoundingBoxCached(false),
+                m_hasBoundingBox(false),
+                m_minimum(),
+                m_maximum(),
+                m_listOfCachedChildren(),
+                m_visibleChildren(),
+                m_listOfReleasedCallLists() {}
 
         TransformGroup::TransformGroup(const NodeDescriptor &nodeDescriptor) :
                 Node(nodeDescriptor),
@@ -61,10 +114,42 @@ namespace opendlv {
                 m_rotation(),
                 m_scaling(Point3(1, 1, 1)),
                 m_listOfChildrenMutex(),
-                m_listOfChildren() {}
+                m_listOfChildren(),
+                m_isStatic(false),
+                m_isBoundingBoxCached(false),
+                m_hasBoundingBox(false),
+                m_minimum(),
+                m_maximum(),
+                m_listOfCachedChildren(),
+                m_visibleChildren(),
+                m_listOfReleasedCallLists() {}
 
         TransformGroup::~TransformGroup() {
             deleteAllChildren();
+
+            // The display lists can only be deleted in the context they were
+            // created in; otherwise, they are released with their context.
+            if (hasCurrentContext()) {
+                releaseCallLists();
+            }
+        }
+
+        bool TransformGroup::hasCurrentContext() {
+#ifdef WIN32
+            return (wglGetCurrentContext() != NULL);
+#elif defined(__APPLE__)
+            return (CGLGetCurrentContext() != NULL);
+#else
+            return (glXGetCurrentContext() != NULL);
+#endif
+        }
+
+        void TransformGroup::releaseCallLists() {
+            vector<uint32_t>::const_iterator it = m_listOfReleasedCallLists.begin();
+            while (it != m_listOfReleasedCallLists.end()) {
+                glDeleteLists(*it++, 1);
+            }
+            m_listOfReleasedCallLists.clear();
         }
 
         void TransformGroup::render(RenderingConfiguration &renderingConfiguration) {
@@ -85,12 +170,36 @@ namespace opendlv {
                     // Scale the model.
                     glScaled(m_scaling.getX(), m_scaling.getY(), m_scaling.getZ());
 
-                    // Draw all existing children.
-                    vector<Node*>::const_iterator it = m_listOfChildren.begin();
-                    while (it != m_listOfChildren.end()) {
-                        Node *n = (*it++);
-                        if (n != NULL) {
-                            n->render(renderingConfiguration);
+                    // Display lists of discarded cached children can only be released while rendering.
+                    releaseCallLists();
+
+                    // A default frustum does not reject anything.
+                    const bool CULLING = renderingConfiguration.hasFrustumCulling();
+                    Frustum frustum;
+                    if (CULLING) {
+                        frustum.updateFromOpenGL();
+                    }
+
+                    if (m_isStatic) {
+                        renderStaticChildren(renderingConfiguration, frustum);
+                    }
+                    else {
+                        // Draw all existing children that might be visible.
+                        Point3 minimum;
+                        Point3 maximum;
+                        vector<Node*>::const_iterator it = m_listOfChildren.begin();
+                        while (it != m_listOfChildren.end()) {
+                            Node *n = (*it++);
+                            if (n != NULL) {
+                                // Bounding boxes of dynamic groups are not cached; thus, only leaves and static groups are culled.
+                                if (CULLING) {
+                                    TransformGroup *tg = dynamic_cast<TransformGroup*>(n);
+                                    if ( ((tg == NULL) || tg->isStatic()) && n->getBoundingBox(minimum, maximum) && !frustum.isVisible(minimum, maximum) ) {
+                                        continue;
+                                    }
+                                }
+                                n->render(renderingConfiguration);
+                            }
                         }
                     }
                 }
@@ -98,8 +207,191 @@ namespace opendlv {
             }
         }
 
+        void TransformGroup::renderStaticChildren(RenderingConfiguration &renderingConfiguration, const Frustum &frustum) {
+            if (m_listOfCachedChildren.size() != m_listOfChildren.size()) {
+                m_listOfCachedChildren.clear();
+                vector<Node*>::const_iterator it = m_listOfChildren.begin();
+                while (it != m_listOfChildren.end()) {
+                    CachedChild cachedChild;
+                    cachedChild.m_node = (*it++);
+                    if (cachedChild.m_node != NULL) {
+                        cachedChild.m_isRenderedDirectly = (dynamic_cast<TransformGroup*>(cachedChild.m_node) != NULL) || !cachedChild.m_node->isCompilable();
+                        cachedChild.m_hasBoundingBox = cachedChild.m_node->getBoundingBox(cachedChild.m_minimum, cachedChild.m_maximum);
+                    }
+                    m_listOfCachedChildren.push_back(cachedChild);
+                }
+            }
+
+            // Determine the children to be drawn.
+            const uint32_t SIZE = static_cast<uint32_t>(m_listOfCachedChildren.size());
+            m_visibleChildren.assign(SIZE, 1);
+            if (renderingConfiguration.hasFrustumCulling()) {
+                for (uint32_t i = 0; i < SIZE; i++) {
+                    const CachedChild &cachedChild = m_listOfCachedChildren[i];
+                    if (cachedChild.m_hasBoundingBox && !frustum.isVisible(cachedChild.m_minimum, cachedChild.m_maximum)) {
+                        m_visibleChildren[i] = 0;
+                    }
+                }
+            }
+
+            for (uint32_t i = 0; i < SIZE; i++) {
+                CachedChild &cachedChild = m_listOfCachedChildren[i];
+                if ( (cachedChild.m_node == NULL) || (0 == m_visibleChildren[i]) ) {
+                    continue;
+                }
+
+                if (cachedChild.m_isRenderedDirectly) {
+                    cachedChild.m_node->render(renderingConfiguration);
+                    continue;
+                }
+
+                // Skip disabled leaves as their render method would do.
+                const NodeDescriptor nd = cachedChild.m_node->getNodeDescriptor();
+                if ((nd.getName().size() > 0) && !(renderingConfiguration.getNodeRenderingConfiguration(nd).hasParameter(NodeRenderingConfiguration::ENABLED))) {
+                    continue;
+                }
+
+                if (!cachedChild.m_isPrepared) {
+                    // The first rendering creates the leaf's own display lists
+                    // and textures, which must not happen while compiling.
+                    cachedChild.m_node->render(renderingConfiguration);
+                    cachedChild.m_isPrepared = true;
+                }
+                else if ( (0 == cachedChild.m_callList) || (cachedChild.m_drawTextures != renderingConfiguration.hasDrawTextures()) ) {
+                    if (0 == cachedChild.m_callList) {
+                        cachedChild.m_callList = glGenLists(1);
+                    }
+                    cachedChild.m_drawTextures = renderingConfiguration.hasDrawTextures();
+
+                    // Replaying the list binds its textures without the TextureManager.
+                    TextureManager::getInstance().startRecordingBoundTextures();
+                    glNewList(cachedChild.m_callList, GL_COMPILE_AND_EXECUTE);
+                    cachedChild.m_node->render(renderingConfiguration);
+                    glEndList();
+                    TextureManager::getInstance().stopRecordingBoundTextures(cachedChild.m_textures);
+                }
+                else {
+                    if (!cachedChild.m_textures.empty()) {
+                        TextureManager::getInstance().markAsUsed(cachedChild.m_textures);
+                    }
+                    glCallList(cachedChild.m_callList);
+                }
+            }
+        }
+
+        bool TransformGroup::getBoundingBox(Point3 &minimum, Point3 &maximum) {
+            Lock l(m_listOfChildrenMutex);
+
+            if (!m_isBoundingBoxCached) {
+                m_hasBoundingBox = computeBoundingBox(m_minimum, m_maximum);
+                m_isBoundingBoxCached = m_isStatic;
+            }
+
+            minimum = m_minimum;
+            maximum = m_maximum;
+            return m_hasBoundingBox;
+        }
+
+        bool TransformGroup::computeBoundingBox(Point3 &minimum, Point3 &maximum) {
+            if (m_listOfChildren.empty()) {
+                return false;
+            }
+
+            // Union of the children's bounding boxes in this group's coordinate system.
+            Point3 childrenMinimum;
+            Point3 childrenMaximum;
+            bool first = true;
+            vector<Node*>::const_iterator it = m_listOfChildren.begin();
+            while (it != m_listOfChildren.end()) {
+                Node *n = (*it++);
+                Point3 childMinimum;
+                Point3 childMaximum;
+                if ( (n == NULL) || !n->getBoundingBox(childMinimum, childMaximum) ) {
+                    // The extent of this group is unknown.
+                    return false;
+                }
+
+                if (first) {
+                    childrenMinimum = childMinimum;
+                    childrenMaximum = childMaximum;
+                    first = false;
+                }
+                else {
+                    childrenMinimum = Point3(std::min(childrenMinimum.getX(), childMinimum.getX()), std::min(childrenMinimum.getY(), childMinimum.getY()), std::min(childrenMinimum.getZ(), childMinimum.getZ()));
+                    childrenMaximum = Point3(std::max(childrenMaximum.getX(), childMaximum.getX()), std::max(childrenMaximum.getY(), childMaximum.getY()), std::max(childrenMaximum.getZ(), childMaximum.getZ()));
+                }
+            }
+
+            // Transform all corners like render() does: translate * rotateX * rotateY * rotateZ * scale.
+            const double SIN_X = sin(m_rotation.getX()), COS_X = cos(m_rotation.getX());
+            const double SIN_Y = sin(m_rotation.getY()), COS_Y = cos(m_rotation.getY());
+            const double SIN_Z = sin(m_rotation.getZ()), COS_Z = cos(m_rotation.getZ());
+            for (uint32_t corner = 0; corner < 8; corner++) {
+                double x = ((corner & 1) ? childrenMaximum.getX() : childrenMinimum.getX()) * m_scaling.getX();
+                double y = ((corner & 2) ? childrenMaximum.getY() : childrenMinimum.getY()) * m_scaling.getY();
+                double z = ((corner & 4) ? childrenMaximum.getZ() : childrenMinimum.getZ()) * m_scaling.getZ();
+
+                double t = x * COS_Z - y * SIN_Z;
+                y = x * SIN_Z + y * COS_Z;
+                x = t;
+
+                t = x * COS_Y + z * SIN_Y;
+                z = -x * SIN_Y + z * COS_Y;
+                x = t;
+
+                t = y * COS_X - z * SIN_X;
+                z = y * SIN_X + z * COS_X;
+                y = t;
+
+                const Point3 p(x + m_translation.getX(), y + m_translation.getY(), z + m_translation.getZ());
+                if (0 == corner) {
+                    minimum = p;
+                    maximum = p;
+                }
+                else {
+                    minimum = Point3(std::min(minimum.getX(), p.getX()), std::min(minimum.getY(), p.getY()), std::min(minimum.getZ(), p.getZ()));
+                    maximum = Point3(std::max(maximum.getX(), p.getX()), std::max(maximum.getY(), p.getY()), std::max(maximum.getZ(), p.getZ()));
+                }
+            }
+
+            return true;
+        }
+
+        void TransformGroup::setStatic(const bool &isStatic) {
+            Lock l(m_listOfChildrenMutex);
+
+            m_isStatic = isStatic;
+            invalidateCache();
+
+            vector<Node*>::iterator it = m_listOfChildren.begin();
+            while (it != m_listOfChildren.end()) {
+                TransformGroup *tg = dynamic_cast<TransformGroup*>(*it++);
+                if (tg != NULL) {
+                    tg->setStatic(isStatic);
+                }
+            }
+        }
+
+        bool TransformGroup::isStatic() const {
+            return m_isStatic;
+        }
+
+        void TransformGroup::invalidateCache() {
+            m_isBoundingBoxCached = false;
+
+            vector<CachedChild>::const_iterator it = m_listOfCachedChildren.begin();
+            while (it != m_listOfCachedChildren.end()) {
+                if ((*it).m_callList > 0) {
+                    m_listOfReleasedCallLists.push_back((*it).m_callList);
+                }
+                it++;
+            }
+            m_listOfCachedChildren.clear();
+        }
+
         void TransformGroup::setTranslation(const Point3 &t) {
             m_translation = t;
+            m_isBoundingBoxCached = false;
         }
 
         Point3 TransformGroup::getTranslation() const {
@@ -108,6 +400,7 @@ namespace opendlv {
 
         void TransformGroup::setRotation(const Point3 &r) {
             m_rotation = r;
+            m_isBoundingBoxCached = false;
         }
 
         Point3 TransformGroup::getRotation() const {
@@ -116,6 +409,7 @@ namespace opendlv {
 
         void TransformGroup::setScaling(const Point3 &s) {
             m_scaling = s;
+            m_isBoundingBoxCached = false;
         }
 
         Point3 TransformGroup::getScaling() const {
@@ -144,6 +438,7 @@ namespace opendlv {
             Lock l(m_listOfChildrenMutex);
 
             m_listOfChildren.push_back(c);
+            invalidateCache();
         }
 
         void TransformGroup::removeChild(Node *c) {
@@ -155,6 +450,7 @@ namespace opendlv {
 //                    core::wrapper::DisposalService::getInstance().addDisposableForRegularRemoval((Disposable**)&(*result));
                     OPENDAVINCI_CORE_DELETE_POINTER(*result);
                     m_listOfChildren.erase(result);
+                    invalidateCache();
                 }
             }
         }
@@ -181,6 +477,7 @@ namespace opendlv {
 
             // Clear regular node list.
             m_listOfChildren.clear();
+            invalidateCache();
         }
 
     }
@@ -18,6 +18,7 @@
  */
 
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <map>
 #include <sstream>
@@ -28,6 +29,7 @@
 #include "opendavinci/odcore/strings/StringComparator.h"
 #include "automotivedata/generated/cartesian/Constants.h"
 #include "opendlv/data/environment/Point3.h"
+#include "opendlv/io/ArchiveCache.h"
 #include "opendlv/threeD/Material.h"
 #include "opendlv/threeD/NodeDescriptor.h"
 #include "opendlv/threeD/TextureManager.h"
@@ -43,13 +45,57 @@ namespace opendlv {
 
             using namespace odcore;
             using namespace opendlv::data::environment;
+            using namespace opendlv::io;
             using namespace threeD::models;
 
+            // Identification and version of the binary representation of triangle groups.
+            static const char CACHE_MAGIC[] = "OBJXTRI1";
+            static const uint32_t CACHE_MAGIC_LENGTH = 8;
+
+            // Size of a triangle without texture coordinates: Their number, three vertices, and the normal.
+            static const uint64_t MINIMUM_TRIANGLE_SIZE = sizeof(uint32_t) + 4 * 3 * sizeof(double);
+
+            static void writeToCache(string &out, const uint32_t &value) {
+                out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+            }
+
+            static void writeToCache(string &out, const Point3 &p) {
+                const double XYZ[] = { p.getX(), p.getY(), p.getZ() };
+                out.append(reinterpret_cast<const char*>(XYZ), sizeof(XYZ));
+            }
+
+            static bool readFromCache(const char *data, const uint64_t &size, uint64_t &position, uint32_t &value) {
+                if ((position + sizeof(value)) > size) {
+                    return false;
+                }
+                memcpy(&value, data + position, sizeof(value));
+                position += sizeof(value);
+                return true;
+            }
+
+            static bool readFromCache(const char *data, const uint64_t &size, uint64_t &position, Point3 &p) {
+                double xyz[3];
+                if ((position + sizeof(xyz)) > size) {
+                    return false;
+                }
+                memcpy(xyz, data + position, sizeof(xyz));
+                position += sizeof(xyz);
+                p = Point3(xyz[0], xyz[1], xyz[2]);
+                return true;
+            }
+
+            OBJXArchive::TriangleGroup::TriangleGroup() :
+                    m_hasMaterial(false),
+                    m_material(),
+                    m_triangles() {}
+
             OBJXArchive::OBJXArchive():
                     m_mapOfImages(),
                     m_mapOfMaterials(),
                     m_objFile(),
-                    m_mtlFile() {}
+                    m_mtlFile(),
+                    m_isParsed(false),
+                    m_listOfTriangleGroups() {}
 
             OBJXArchive::~OBJXArchive() {
                 map<string, core::wrapper::Image*, odcore::strings::StringComparator>::iterator it = m_mapOfImages.begin();
@@ -64,6 +110,7 @@ namespace opendlv {
 
             void OBJXArchive::setContentsOfObjFile(const string &objContents) {
                 m_objFile.str(objContents);
+                m_isParsed = false;
             }
 
             void OBJXArchive::setContentsOfMtlFile(const string &mtlContents) {
@@ -164,124 +211,193 @@ namespace opendlv {
                 }
             }
 
-            TransformGroup* OBJXArchive::createTransformGroup(const NodeDescriptor &nd) {
-                TransformGroup *returnableModel = NULL;
-                TransformGroup *rotatedModel = NULL;
-                uint32_t triangleCounter = 0;
-
-                // Read materials.
-                createMapOfMaterials();
-
-                // Set up textures.
-                setUpTextures();
+            void OBJXArchive::parse() {
+                if (m_isParsed) {
+                    return;
+                }
+                m_isParsed = true;
+                m_listOfTriangleGroups.clear();
 
                 if (m_objFile.str().length() > 0) {
-                    TransformGroup *model = new TransformGroup();
+                    // Try to use the already parsed triangles of an identical obj-file.
+                    const string KEY = ArchiveCache::getKey("objx-v1", m_objFile.str());
+                    std::shared_ptr<ArchiveCache::Entry> entry = ArchiveCache::getInstance().get(KEY);
+                    if ( (entry.get()) && (deserializeTriangleGroups(entry->getData(), entry->getSize())) ) {
+                        clog << "Using cached model " << KEY << endl;
+                        return;
+                    }
 
-                    // TODO: Why the heck are Wavefront objs rotated around the x axis?
-                    rotatedModel = new TransformGroup();
-                    rotatedModel->setRotation(Point3(cartesian::Constants::PI/2.0, 0, 0));
-                    rotatedModel->addChild(model);
-                    returnableModel = new TransformGroup(nd);
-                    returnableModel->addChild(rotatedModel);
+                    m_listOfTriangleGroups.clear();
+                    parseObjFile();
 
-                    // Parse all available vertices.
-                    vector<Point3> listOfVertices;
-                    vector<Point3> listOfNormals;
-                    vector<Point3> listOfTextureCoordinates;
+                    // Store the parsed triangles for all further processes.
+                    ArchiveCache::getInstance().put(KEY, serializeTriangleGroups());
+                }
+            }
 
-                    m_objFile.seekg(ios::beg);
-                    string line = "";
-                    while (getline(m_objFile, line)) {
-                        // Vertices.
-                        if (line.find("v ") != string::npos) {
-                            stringstream xyz(line.substr(2));
-                            double x;
-                            double y;
-                            double z;
-                            xyz >> x;
-                            xyz >> y;
-                            xyz >> z;
-                            listOfVertices.push_back(Point3(x, y, z));
-                        }
+            void OBJXArchive::parseObjFile() {
+                // Parse all available vertices.
+                vector<Point3> listOfVertices;
+                vector<Point3> listOfNormals;
+                vector<Point3> listOfTextureCoordinates;
+
+                m_objFile.seekg(ios::beg);
+                string line = "";
+                while (getline(m_objFile, line)) {
+                    // Vertices.
+                    if (line.find("v ") != string::npos) {
+                        stringstream xyz(line.substr(2));
+                        double x;
+                        double y;
+                        double z;
+                        xyz >> x;
+                        xyz >> y;
+                        xyz >> z;
+                        listOfVertices.push_back(Point3(x, y, z));
+                    }
 
-                        // Normals.
-                        if (line.find("vn") != string::npos) {
-                            stringstream xyz(line.substr(3));
-                            double x;
-                            double y;
-                            double z;
-                            xyz >> x;
-                            xyz >> y;
-                            xyz >> z;
-                            listOfNormals.push_back(Point3(x, y, z));
-                        }
+                    // Normals.
+                    if (line.find("vn") != string::npos) {
+                        stringstream xyz(line.substr(3));
+                        double x;
+                        double y;
+                        double z;
+                        xyz >> x;
+                        xyz >> y;
+                        xyz >> z;
+                        listOfNormals.push_back(Point3(x, y, z));
+                    }
 
-                        // TextureCoordinates.
-                        if (line.find("vt") != string::npos) {
-                            stringstream xy(line.substr(3));
-                            double x;
-                            double y;
-                            xy >> x;
-                            xy >> y;
-                            listOfTextureCoordinates.push_back(Point3(x, y, 0));
-                        }
+                    // TextureCoordinates.
+                    if (line.find("vt") != string::npos) {
+                        stringstream xy(line.substr(3));
+                        double x;
+                        double y;
+                        xy >> x;
+                        xy >> y;
+                        listOfTextureCoordinates.push_back(Point3(x, y, 0));
                     }
+                }
 
-                    // Rewind file to parse faces.
-                    m_objFile.clear();
-                    m_objFile.seekg(ios::beg);
-                    line = "";
-                    // Add root triangle set if no groups are defined.
-                    TriangleSet *triangleSet = new TriangleSet();
-                    model->addChild(triangleSet);
-                    bool has_g = false;
-                    while (getline(m_objFile, line)) {
-                        if (line.find("g ") != string::npos) {
-                            // Add new group.
-                            triangleSet = new TriangleSet(NodeDescriptor());
-                            model->addChild(triangleSet);
-                            has_g = true;
+                // Rewind file to parse faces.
+                m_objFile.clear();
+                m_objFile.seekg(ios::beg);
+                line = "";
+                // Add root group if no groups are defined.
+                m_listOfTriangleGroups.push_back(TriangleGroup());
+                bool has_g = false;
+                while (getline(m_objFile, line)) {
+                    if (line.find("g ") != string::npos) {
+                        // Add new group.
+                        m_listOfTriangleGroups.push_back(TriangleGroup());
+                        has_g = true;
+                    }
+
+                    if ( (line.find("usemtl ") != string::npos) && (line.length() > 8) ) {
+                        // Add new group.
+                        if (!has_g) {
+                            m_listOfTriangleGroups.push_back(TriangleGroup());
                         }
 
-                        if ( (line.find("usemtl ") != string::npos) && (line.length() > 8) ) {
-                            // Add new group.
-                            if (!has_g) {
-                                triangleSet = new TriangleSet(NodeDescriptor());
-                                model->addChild(triangleSet);
+                        m_listOfTriangleGroups.back().m_hasMaterial = true;
+                        m_listOfTriangleGroups.back().m_material = line.substr(7);
+                    }
+
+                    if (line.find("f ") != string::npos) {
+                        vector<Point3> vertices;
+                        vector<Point3> textureCoordinates;
+                        vector<Point3> normals;
+                        uint32_t numberOfVertices = 0;
+                        stringstream unknownFormat(line.substr(2));
+                        if (line.find("//") != string::npos) {
+                            // Format is v//n.
+                            stringstream vnStream(line.substr(2));
+                            while (vnStream.good() && (numberOfVertices < 3)) {
+                                string triangle;
+                                vnStream >> triangle;
+
+                                replace(triangle.begin(), triangle.end(), '/', ' ');
+                                stringstream triangleStream(triangle);
+                                numberOfVertices++;
+
+                                uint32_t v;
+                                uint32_t n;
+
+                                triangleStream >> v;
+                                triangleStream >> n;
+
+                                if ( (v > 0) && (n > 0) ) {
+                                    if ( (v - 1) < listOfVertices.size() ) {
+                                        vertices.push_back(listOfVertices[(v-1)]);
+                                    }
+                                    if ( (n - 1) < listOfNormals.size() ) {
+                                        normals.push_back(listOfNormals[(n-1)]);
+                                    }
+                                }
                             }
 
-                            Material m = m_mapOfMaterials[line.substr(7)];
-                            triangleSet->setMaterial(m);
-                        }
+                            // Add the result.
+                            if (vertices.size() == 3) {
+                                Triangle t;
+                                t.setVertices(vertices[0], vertices[1], vertices[2]);
+                                if (!normals.empty()) {
+                                    t.setNormal(normals[0]);
+                                }
+                                m_listOfTriangleGroups.back().m_triangles.push_back(t);
+                            }
+                        } else if (line.find("/") == string::npos) {
+                            // Format is v.
+                            stringstream vStream(line.substr(2));
+                            while (vStream.good() && (numberOfVertices < 3)) {
+                                uint32_t v;
+                                vStream >> v;
+                                numberOfVertices++;
+
+                                if (v > 0) {
+                                    if ( (v - 1) < listOfVertices.size() ) {
+                                        vertices.push_back(listOfVertices[(v-1)]);
+                                    }
+                                }
+                            }
 
-                        if (line.find("f ") != string::npos) {
-                            vector<Point3> vertices;
-                            vector<Point3> textureCoordinates;
-                            vector<Point3> normals;
-                            uint32_t numberOfVertices = 0;
-                            stringstream unknownFormat(line.substr(2));
-                            if (line.find("//") != string::npos) {
-                                // Format is v//n.
-                                stringstream vnStream(line.substr(2));
-                                while (vnStream.good() && (numberOfVertices < 3)) {
+                            // Add the result.
+                            if (vertices.size() == 3) {
+                                Triangle t;
+                                t.setVertices(vertices[0], vertices[1], vertices[2]);
+                                m_listOfTriangleGroups.back().m_triangles.push_back(t);
+                            }
+                        } else {
+                            // Format could be v/t/n or v/t.
+                            string s;
+                            unknownFormat >> s;
+
+                            uint32_t numberOfSlashes = count(s.begin(), s.end(), '/');
+                            if (numberOfSlashes == 2) {
+                                // Format is v/t/n.
+                                stringstream vtnStream(line.substr(2));
+                                while (vtnStream.good() && (numberOfVertices < 3)) {
                                     string triangle;
-                                    vnStream >> triangle;
+                                    vtnStream >> triangle;
 
                                     replace(triangle.begin(), triangle.end(), '/', ' ');
                                     stringstream triangleStream(triangle);
                                     numberOfVertices++;
 
                                     uint32_t v;
+                                    uint32_t t;
                                     uint32_t n;
 
                                     triangleStream >> v;
+                                    triangleStream >> t;
                                     triangleStream >> n;
 
-                                    if ( (v > 0) && (n > 0) ) {
+                                    if ( (v > 0) && (t > 0) && (n > 0) ) {
                                         if ( (v - 1) < listOfVertices.size() ) {
                                             vertices.push_back(listOfVertices[(v-1)]);
                                         }
+                                        if ( (t - 1) < listOfTextureCoordinates.size() ) {
+                                            textureCoordinates.push_back(listOfTextureCoordinates[(t-1)]);
+                                        }
                                         if ( (n - 1) < listOfNormals.size() ) {
                                             normals.push_back(listOfNormals[(n-1)]);
                                         }
@@ -289,131 +405,107 @@ namespace opendlv {
                                 }
 
                                 // Add the result.
-                                if ( (vertices.size() == 3) && (triangleSet != NULL) ) {
+                                if (vertices.size() == 3) {
                                     Triangle t;
                                     t.setVertices(vertices[0], vertices[1], vertices[2]);
                                     if (!normals.empty()) {
                                         t.setNormal(normals[0]);
                                     }
-                                    triangleSet->addTriangle(t);
-                                    triangleCounter++;
+                                    if (textureCoordinates.size() == 3) {
+                                        t.setTextureCoordinates(textureCoordinates[0], textureCoordinates[1], textureCoordinates[2]);
+                                    }
+                                    m_listOfTriangleGroups.back().m_triangles.push_back(t);
                                 }
-                            } else if (line.find("/") == string::npos) {
-                                // Format is v.
-                                stringstream vStream(line.substr(2));
-                                while (vStream.good() && (numberOfVertices < 3)) {
-                                    uint32_t v;
-                                    vStream >> v;
+                            } else if (numberOfSlashes == 1) {
+                                // Format is v/t.
+                                stringstream vtStream(line.substr(2));
+                                while (vtStream.good() && (numberOfVertices < 3)) {
+                                    string triangle;
+                                    vtStream >> triangle;
+
+                                    replace(triangle.begin(), triangle.end(), '/', ' ');
+                                    stringstream triangleStream(triangle);
                                     numberOfVertices++;
 
-                                    if (v > 0) {
+                                    uint32_t v;
+                                    uint32_t t;
+
+                                    triangleStream >> v;
+                                    triangleStream >> t;
+
+                                    if ( (v > 0) && (t > 0) ) {
                                         if ( (v - 1) < listOfVertices.size() ) {
                                             vertices.push_back(listOfVertices[(v-1)]);
                                         }
+                                        if ( (t - 1) < listOfTextureCoordinates.size() ) {
+                                            textureCoordinates.push_back(listOfTextureCoordinates[(t-1)]);
+                                        }
                                     }
                                 }
 
                                 // Add the result.
-                                if ( (vertices.size() == 3) && (triangleSet != NULL) ) {
+                                if (vertices.size() == 3) {
                                     Triangle t;
                                     t.setVertices(vertices[0], vertices[1], vertices[2]);
-                                    triangleSet->addTriangle(t);
-                                    triangleCounter++;
+                                    if (textureCoordinates.size() == 3) {
+                                        t.setTextureCoordinates(textureCoordinates[0], textureCoordinates[1], textureCoordinates[2]);
+                                    }
+                                    m_listOfTriangleGroups.back().m_triangles.push_back(t);
                                 }
                             } else {
-                                // Format could be v/t/n or v/t.
-                                string s;
-                                unknownFormat >> s;
-
-                                uint32_t numberOfSlashes = count(s.begin(), s.end(), '/');
-                                if (numberOfSlashes == 2) {
-                                    // Format is v/t/n.
-                                    stringstream vtnStream(line.substr(2));
-                                    while (vtnStream.good() && (numberOfVertices < 3)) {
-                                        string triangle;
-                                        vtnStream >> triangle;
-
-                                        replace(triangle.begin(), triangle.end(), '/', ' ');
-                                        stringstream triangleStream(triangle);
-                                        numberOfVertices++;
-
-                                        uint32_t v;
-                                        uint32_t t;
-                                        uint32_t n;
-
-                                        triangleStream >> v;
-                                        triangleStream >> t;
-                                        triangleStream >> n;
-
-                                        if ( (v > 0) && (t > 0) && (n > 0) ) {
-                                            if ( (v - 1) < listOfVertices.size() ) {
-                                                vertices.push_back(listOfVertices[(v-1)]);
-                                            }
-                                            if ( (t - 1) < listOfTextureCoordinates.size() ) {
-                                                textureCoordinates.push_back(listOfTextureCoordinates[(t-1)]);
-                                            }
-                                            if ( (n - 1) < listOfNormals.size() ) {
-                                                normals.push_back(listOfNormals[(n-1)]);
-                                            }
-                                        }
-                                    }
+                                clog << "Unknown format." << endl;
+                            }
+                        }
+                    }
 
-                                    // Add the result.
-                                    if ( (vertices.size() == 3) && (triangleSet != NULL) ) {
-                                        Triangle t;
-                                        t.setVertices(vertices[0], vertices[1], vertices[2]);
-                                        if (!normals.empty()) {
-                                            t.setNormal(normals[0]);
-                                        }
-                                        if (textureCoordinates.size() == 3) {
-                                            t.setTextureCoordinates(textureCoordinates[0], textureCoordinates[1], textureCoordinates[2]);
-                                        }
-                                        triangleSet->addTriangle(t);
-                                        triangleCounter++;
-                                    }
-                                } else if (numberOfSlashes == 1) {
-                                    // Format is v/t.
-                                    stringstream vtStream(line.substr(2));
-                                    while (vtStream.good() && (numberOfVertices < 3)) {
-                                        string triangle;
-                                        vtStream >> triangle;
-
-                                        replace(triangle.begin(), triangle.end(), '/', ' ');
-                                        stringstream triangleStream(triangle);
-                                        numberOfVertices++;
-
-                                        uint32_t v;
-                                        uint32_t t;
-
-                                        triangleStream >> v;
-                                        triangleStream >> t;
-
-                                        if ( (v > 0) && (t > 0) ) {
-                                            if ( (v - 1) < listOfVertices.size() ) {
-                                                vertices.push_back(listOfVertices[(v-1)]);
-                                            }
-                                            if ( (t - 1) < listOfTextureCoordinates.size() ) {
-                                                textureCoordinates.push_back(listOfTextureCoordinates[(t-1)]);
-                                            }
-                                        }
-                                    }
+                }
+            }
 
-                                    // Add the result.
-                                    if ( (vertices.size() == 3) && (triangleSet != NULL) ) {
-                                        Triangle t;
-                                        t.setVertices(vertices[0], vertices[1], vertices[2]);
-                                        if (textureCoordinates.size() == 3) {
-                                            t.setTextureCoordinates(textureCoordinates[0], textureCoordinates[1], textureCoordinates[2]);
-                                        }
-                                        triangleSet->addTriangle(t);
-                                        triangleCounter++;
-                                    }
-                                } else {
-                                    clog << "Unknown format." << endl;
-                                }
-                            }
+            TransformGroup* OBJXArchive::createTransformGroup(const NodeDescriptor &nd) {
+                TransformGroup *returnableModel = NULL;
+                TransformGroup *rotatedModel = NULL;
+                uint32_t triangleCounter = 0;
+
+                // Read materials.
+                createMapOfMaterials();
+
+                // Set up textures.
+                setUpTextures();
+
+                if (m_objFile.str().length() > 0) {
+                    // Read triangles unless they were already prepared.
+                    parse();
+
+                    TransformGroup *model = new TransformGroup();
+
+                    // TODO: Why the heck are Wavefront objs rotated around the x axis?
+                    rotatedModel = new TransformGroup();
+                    rotatedModel->setRotation(Point3(cartesian::Constants::PI/2.0, 0, 0));
+                    rotatedModel->addChild(model);
+                    returnableModel = new TransformGroup(nd);
+                    returnableModel->addChild(rotatedModel);
+
+                    vector<TriangleGroup>::const_iterator it = m_listOfTriangleGroups.begin();
+                    while (it != m_listOfTriangleGroups.end()) {
+                        const TriangleGroup &group = (*it++);
+
+                        // Empty groups would only prevent computing the model's bounding box.
+                        if (group.m_triangles.empty()) {
+                            continue;
+                        }
+
+                        TriangleSet *triangleSet = new TriangleSet();
+                        if (group.m_hasMaterial) {
+                            triangleSet->setMaterial(m_mapOfMaterials[group.m_material]);
                         }
 
+                        vector<Triangle>::const_iterator jt = group.m_triangles.begin();
+                        while (jt != group.m_triangles.end()) {
+                            triangleSet->addTriangle(*jt++);
+                            triangleCounter++;
+                        }
+
+                        model->addChild(triangleSet);
                     }
                 }
 
@@ -422,6 +514,109 @@ namespace opendlv {
                 return returnableModel;
             }
 
+            string OBJXArchive::serializeTriangleGroups() const {
+                string out(CACHE_MAGIC, CACHE_MAGIC_LENGTH);
+                writeToCache(out, static_cast<uint32_t>(m_listOfTriangleGroups.size()));
+
+                vector<TriangleGroup>::const_iterator it = m_listOfTriangleGroups.begin();
+                while (it != m_listOfTriangleGroups.end()) {
+                    const TriangleGroup &group = (*it++);
+                    writeToCache(out, static_cast<uint32_t>(group.m_hasMaterial ? 1 : 0));
+                    writeToCache(out, static_cast<uint32_t>(group.m_material.size()));
+                    out.append(group.m_material);
+                    writeToCache(out, static_cast<uint32_t>(group.m_triangles.size()));
+
+                    vector<Triangle>::const_iterator jt = group.m_triangles.begin();
+                    while (jt != group.m_triangles.end()) {
+                        const Triangle &t = (*jt++);
+                        const vector<Point3> VERTICES = t.getVertices();
+                        const vector<Point3> TEXTURE_COORDINATES = t.getTextureCoordinates();
+
+                        writeToCache(out, static_cast<uint32_t>(TEXTURE_COORDINATES.size()));
+                        for (uint32_t i = 0; i < 3; i++) {
+                            writeToCache(out, VERTICES.at(i));
+                        }
+                        writeToCache(out, t.getNormal());
+                        for (uint32_t i = 0; i < TEXTURE_COORDINATES.size(); i++) {
+                            writeToCache(out, TEXTURE_COORDINATES.at(i));
+                        }
+                    }
+                }
+
+                return out;
+            }
+
+            bool OBJXArchive::deserializeTriangleGroups(const char *data, const uint64_t &size) {
+                if ( (size < CACHE_MAGIC_LENGTH) || (string(data, CACHE_MAGIC_LENGTH) != string(CACHE_MAGIC, CACHE_MAGIC_LENGTH)) ) {
+                    return false;
+                }
+                uint64_t position = CACHE_MAGIC_LENGTH;
+
+                uint32_t numberOfGroups = 0;
+                if (!readFromCache(data, size, position, numberOfGroups)) {
+                    return false;
+                }
+
+                for (uint32_t i = 0; i < numberOfGroups; i++) {
+                    m_listOfTriangleGroups.push_back(TriangleGroup());
+                    TriangleGroup &group = m_listOfTriangleGroups.back();
+
+                    uint32_t hasMaterial = 0;
+                    uint32_t lengthOfMaterial = 0;
+                    if ( !readFromCache(data, size, position, hasMaterial) ||
+                         !readFromCache(data, size, position, lengthOfMaterial) ||
+                         ((position + lengthOfMaterial) > size) ) {
+                        return false;
+                    }
+                    group.m_hasMaterial = (hasMaterial != 0);
+                    group.m_material = string(data + position, lengthOfMaterial);
+                    position += lengthOfMaterial;
+
+                    uint32_t numberOfTriangles = 0;
+                    if (!readFromCache(data, size, position, numberOfTriangles)) {
+                        return false;
+                    }
+                    // The number is not trusted before all triangles were read.
+                    group.m_triangles.reserve(std::min<uint64_t>(numberOfTriangles, (size - position) / MINIMUM_TRIANGLE_SIZE));
+
+                    for (uint32_t j = 0; j < numberOfTriangles; j++) {
+                        uint32_t numberOfTextureCoordinates = 0;
+                        Point3 a;
+                        Point3 b;
+                        Point3 c;
+                        Point3 n;
+                        if ( !readFromCache(data, size, position, numberOfTextureCoordinates) ||
+                             !readFromCache(data, size, position, a) ||
+                             !readFromCache(data, size, position, b) ||
+                             !readFromCache(data, size, position, c) ||
+                             !readFromCache(data, size, position, n) ) {
+                            return false;
+                        }
+
+                        Triangle t;
+                        t.setVertices(a, b, c);
+                        t.setNormal(n);
+                        if (numberOfTextureCoordinates == 3) {
+                            Point3 ta;
+                            Point3 tb;
+                            Point3 tc;
+                            if ( !readFromCache(data, size, position, ta) ||
+                                 !readFromCache(data, size, position, tb) ||
+                                 !readFromCache(data, size, position, tc) ) {
+                                return false;
+                            }
+                            t.setTextureCoordinates(ta, tb, tc);
+                        }
+                        else if (numberOfTextureCoordinates != 0) {
+                            return false;
+                        }
+                        group.m_triangles.push_back(t);
+                    }
+                }
+
+                return (position == size);
+            }
+
             void OBJXArchive::addImage(const string &name, core::wrapper::Image *image) {
                 if ( (name.length() > 0) && (image != NULL) && (image->getWidth() > 0) && (image->getHeight() > 0) ) {
                     core::wrapper::Image *existingEntry = m_mapOfImages[name];
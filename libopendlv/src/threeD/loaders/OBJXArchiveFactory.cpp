@@ -17,6 +17,9 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
+#include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -48,7 +51,8 @@ namespace opendlv {
             Mutex OBJXArchiveFactory::m_singletonMutex;
             OBJXArchiveFactory* OBJXArchiveFactory::m_singleton = NULL;
 
-            OBJXArchiveFactory::OBJXArchiveFactory() {}
+            OBJXArchiveFactory::OBJXArchiveFactory() :
+                m_imageDecoders(0) {}
 
             OBJXArchiveFactory::~OBJXArchiveFactory() {}
 
@@ -100,10 +104,23 @@ namespace opendlv {
                     }
                 }
 
-                OBJXArchive *objxArchive = NULL;
-
                 // Use CompressionFactory to read the contents of the OBJXArchive.
-                std::shared_ptr<odcore::wrapper::DecompressedData> data = odcore::wrapper::CompressionFactory::getContents(in);
+                return getOBJXArchive(odcore::wrapper::CompressionFactory::getContents(in));
+            }
+
+            OBJXArchive* OBJXArchiveFactory::getOBJXArchive(const string &fileName) throw (InvalidArgumentException) {
+                ifstream fin(fileName.c_str(), ios::binary | ios::in);
+                if (!(fin.good())) {
+                    OPENDAVINCI_CORE_THROW_EXCEPTION(InvalidArgumentException, "Given file is invalid.");
+                }
+                fin.close();
+
+                // The archive is read in place.
+                return getOBJXArchive(odcore::wrapper::CompressionFactory::getContents(fileName));
+            }
+
+            OBJXArchive* OBJXArchiveFactory::getOBJXArchive(std::shared_ptr<odcore::wrapper::DecompressedData> data) {
+                OBJXArchive *objxArchive = NULL;
 
                 if (data.get()) {
                     // Create OBJXArchive.
@@ -112,6 +129,9 @@ namespace opendlv {
                     vector<string> listOfEntries = data->getListOfEntries();
                     vector<string>::iterator it = listOfEntries.begin();
 
+                    vector<string> listOfImageNames;
+                    vector<std::future<core::wrapper::Image*> > listOfImages;
+
                     while (it != listOfEntries.end()) {
                         string entry = (*it++);
 
@@ -144,29 +164,42 @@ namespace opendlv {
                             std::shared_ptr<istream> stream = data->getInputStreamFor(entry);
 
                             if (stream.get()) {
-                                core::wrapper::Image *image = core::wrapper::ImageFactory::getInstance().getImage(*stream);
-
-                                if (image != NULL) {
-                                    // TODO: Check where origin lies.
-                                    image->rotate(static_cast<float>(cartesian::Constants::PI));
-
-                                    // Remove any directory prefixes from the entry.
-                                    string name = entry;
-                                    if (name.rfind('/') != string::npos) {
-                                        name = name.substr(name.rfind('/') + 1);
-                                    }
-
-                                    objxArchive->addImage(name, image);
+                                // Remove any directory prefixes from the entry.
+                                string name = entry;
+                                if (name.rfind('/') != string::npos) {
+                                    name = name.substr(name.rfind('/') + 1);
                                 }
+
+                                // Images are decoded in parallel by the factory's workers.
+                                listOfImageNames.push_back(name);
+                                listOfImages.push_back(m_imageDecoders.submit(std::bind(&OBJXArchiveFactory::decodeImage, stream)));
                             }
                         }
 
                     }
+
+                    for (uint32_t i = 0; i < listOfImages.size(); i++) {
+                        core::wrapper::Image *image = listOfImages.at(i).get();
+                        if (image != NULL) {
+                            objxArchive->addImage(listOfImageNames.at(i), image);
+                        }
+                    }
                 }
 
                 return objxArchive;
             }
 
+            core::wrapper::Image* OBJXArchiveFactory::decodeImage(std::shared_ptr<istream> stream) {
+                core::wrapper::Image *image = core::wrapper::ImageFactory::getInstance().getImage(*stream);
+
+                if (image != NULL) {
+                    // TODO: Check where origin lies.
+                    image->rotate(static_cast<float>(cartesian::Constants::PI));
+                }
+
+                return image;
+            }
+
         }
     }
 } // opendlv::threeD::loaders
@@ -22,6 +22,7 @@
 #include <windows.h>
 #endif
 
+#include <cmath>
 #include <string>
 
 #ifdef __APPLE__
@@ -70,7 +71,7 @@ namespace opendlv {
                     {
                         if (renderingConfiguration.hasDrawTextures()) {
                             glEnable(GL_TEXTURE_2D);
-                            glBindTexture(GL_TEXTURE_2D, m_textureHandle);
+                            TextureManager::getInstance().bindTexture(m_textureHandle);
                             glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_DECAL);
                         }
 
@@ -209,6 +210,22 @@ namespace opendlv {
                 }
             }
 
+            bool AerialImage::getBoundingBox(Point3 &minimum, Point3 &maximum) {
+                if (m_image == NULL) {
+                    return false;
+                }
+
+                // The image is rotated around its center; thus, its extent is bounded by the circle around its corners.
+                const double WIDTH = m_image->getWidth() * m_scalingPixelXY.getX();
+                const double HEIGHT = m_image->getHeight() * m_scalingPixelXY.getY();
+                const double CENTER_X = -1 * m_originPixelXY.getX() * m_scalingPixelXY.getX() + WIDTH / 2.0;
+                const double CENTER_Y = -1 * (m_image->getHeight() - m_originPixelXY.getY()) * m_scalingPixelXY.getY() + HEIGHT / 2.0;
+                const double RADIUS = sqrt(WIDTH * WIDTH + HEIGHT * HEIGHT) / 2.0;
+
+                minimum = Point3(CENTER_X - RADIUS, CENTER_Y - RADIUS, 0);
+                maximum = Point3(CENTER_X + RADIUS, CENTER_Y + RADIUS, 0);
+                return true;
+            }
         }
     }
 } // opendlv::threeD::models
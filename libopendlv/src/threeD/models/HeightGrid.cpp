@@ -28,12 +28,16 @@
     #include <GL/gl.h>
 #endif
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendlv/core/wrapper/Image.h"
 #include "opendlv/data/environment/Point3.h"
+#include "opendlv/threeD/Frustum.h"
 #include "opendlv/threeD/Node.h"
 #include "opendlv/threeD/NodeDescriptor.h"
 #include "opendlv/threeD/NodeRenderingConfiguration.h"
@@ -47,32 +51,231 @@ namespace opendlv {
             using namespace odcore;
             using namespace opendlv::data::environment;
 
-            HeightGridRenderer::HeightGridRenderer(const NodeDescriptor &nodeDescriptor, const uint32_t &callList) :
+            template <class T>
+            class MyImage {
+                private:
+                    const core::wrapper::Image *m_image;
+                    T m_t;
+
+                    MyImage(const MyImage &obj);
+                    MyImage& operator=(const MyImage &obj);
+
+                public:
+                    MyImage(const core::wrapper::Image *image) :
+                            m_image(image),
+                            m_t() {}
+
+                    ~MyImage() {
+                        m_image = NULL;
+                    }
+
+                    inline T* getPixel(const uint32_t &col, const uint32_t &row) {
+                        const uint32_t bytesPerPixel = m_image->getWidthStep() / m_image->getWidth();
+                        if ( (   (m_image->getRawData() + row * m_image->getWidth() * bytesPerPixel + col * bytesPerPixel)
+                                 > (m_image->getRawData() + m_image->getHeight() * m_image->getWidth() * bytesPerPixel + m_image->getWidth() * bytesPerPixel )
+                                 ||
+                                 (   (m_image->getRawData() + row * m_image->getWidth() * bytesPerPixel + col * bytesPerPixel)
+                                     < (m_image->getRawData()) ) ) ) {
+                            return &m_t;
+                        }
+
+                        // TODO: Why the heck do I have sometime to add 1?
+//                        return (T*)(m_image->getRawData() + (bytesPerPixel * (row * (m_image->getWidth()+1) + col)));
+                        return (T*)(m_image->getRawData() + (bytesPerPixel * (row * (m_image->getWidth()) + col)));
+                    }
+            };
+            typedef class BGRPixel_T {
+                public:
+                    unsigned char b;
+                    unsigned char g;
+                    unsigned char r;
+                    BGRPixel_T() :
+                            b(0),
+                            g(0),
+                            r(0) {}
+
+            } BGRPixel;
+
+            HeightGridRenderer::HeightGridRenderer(const NodeDescriptor &nodeDescriptor, const core::wrapper::Image *heightImage, const float &ground, const float &scaleZ) :
                     Node(nodeDescriptor),
-                    m_callList(callList) {}
+                    m_heightImage(heightImage),
+                    m_ground(ground),
+                    m_scaleZ(scaleZ),
+                    m_numberOfTilesX(0),
+                    m_numberOfTilesY(0),
+                    m_callLists() {
+                if (m_heightImage != NULL) {
+                    m_numberOfTilesX = (max<uint32_t>(m_heightImage->getWidth(), 2) - 2) / TILE_SIZE + 1;
+                    m_numberOfTilesY = (max<uint32_t>(m_heightImage->getHeight(), 2) - 2) / TILE_SIZE + 1;
+                    m_callLists.resize(m_numberOfTilesX * m_numberOfTilesY * LEVELS_OF_DETAIL, 0);
+                }
+            }
 
             HeightGridRenderer::HeightGridRenderer(const HeightGridRenderer &obj) :
                     Node(obj.getNodeDescriptor()),
-                    m_callList(obj.m_callList) {}
+                    m_heightImage(obj.m_heightImage),
+                    m_ground(obj.m_ground),
+                    m_scaleZ(obj.m_scaleZ),
+                    m_numberOfTilesX(obj.m_numberOfTilesX),
+                    m_numberOfTilesY(obj.m_numberOfTilesY),
+                    m_callLists(obj.m_callLists) {}
 
             HeightGridRenderer& HeightGridRenderer::operator=(const HeightGridRenderer &obj) {
                 setNodeDescriptor(obj.getNodeDescriptor());
-                m_callList = obj.m_callList;
+                m_heightImage = obj.m_heightImage;
+                m_ground = obj.m_ground;
+                m_scaleZ = obj.m_scaleZ;
+                m_numberOfTilesX = obj.m_numberOfTilesX;
+                m_numberOfTilesY = obj.m_numberOfTilesY;
+                m_callLists = obj.m_callLists;
                 return (*this);
             }
 
             HeightGridRenderer::~HeightGridRenderer() {}
 
+            bool HeightGridRenderer::isCompilable() const {
+                // The level of detail depends on the current camera.
+                return false;
+            }
+
             void HeightGridRenderer::render(RenderingConfiguration &renderingConfiguration) {
+                if ( (m_heightImage == NULL) || (m_callLists.empty()) ) {
+                    return;
+                }
+
                 if ((getNodeDescriptor().getName().size() == 0) || (renderingConfiguration.getNodeRenderingConfiguration(getNodeDescriptor()).hasParameter(NodeRenderingConfiguration::ENABLED))) {
-                    glPushMatrix();
-                    {
-                        glCallList(m_callList);
+                    // A default frustum does not reject anything.
+                    Frustum frustum;
+                    if (renderingConfiguration.hasFrustumCulling()) {
+                        frustum.updateFromOpenGL();
+                    }
+
+                    double modelView[16];
+                    glGetDoublev(GL_MODELVIEW_MATRIX, modelView);
+
+                    // Edge length of a tile in eye coordinates.
+                    const double TILE_LENGTH = TILE_SIZE * sqrt(modelView[0] * modelView[0] + modelView[1] * modelView[1] + modelView[2] * modelView[2]);
+                    const uint32_t LAST_X = m_heightImage->getWidth() - 1;
+                    const uint32_t LAST_Y = m_heightImage->getHeight() - 1;
+
+                    uint32_t compiledVertices = 0;
+                    for (uint32_t tileY = 0; tileY < m_numberOfTilesY; tileY++) {
+                        for (uint32_t tileX = 0; tileX < m_numberOfTilesX; tileX++) {
+                            const double X0 = tileX * TILE_SIZE;
+                            const double Y0 = tileY * TILE_SIZE;
+                            const double X1 = min<uint32_t>((tileX + 1) * TILE_SIZE, LAST_X);
+                            const double Y1 = min<uint32_t>((tileY + 1) * TILE_SIZE, LAST_Y);
+
+                            if (!frustum.isVisible(Point3(X0, Y0, -m_ground * m_scaleZ), Point3(X1, Y1, (1 - m_ground) * m_scaleZ))) {
+                                continue;
+                            }
+
+                            // Distance from the camera to the tile's center in eye coordinates.
+                            const double CX = (X0 + X1) / 2.0;
+                            const double CY = (Y0 + Y1) / 2.0;
+                            const double CZ = (0.5 - m_ground) * m_scaleZ;
+                            double distance = 0;
+                            for (uint32_t row = 0; row < 3; row++) {
+                                const double E = modelView[row] * CX + modelView[4 + row] * CY + modelView[8 + row] * CZ + modelView[12 + row];
+                                distance += E * E;
+                            }
+                            distance = sqrt(distance);
+
+                            // Halve the resolution with each doubling of the distance beyond two tiles.
+                            uint32_t desiredLevel = 0;
+                            if ( (TILE_LENGTH > 0) && (distance > 2 * TILE_LENGTH) ) {
+                                desiredLevel = min<uint32_t>(static_cast<uint32_t>(floor(log2(distance / (2 * TILE_LENGTH)))), LEVELS_OF_DETAIL - 1);
+                            }
+
+                            const uint32_t TILE = (tileY * m_numberOfTilesX + tileX) * LEVELS_OF_DETAIL;
+
+                            // The coarsest level is always available; finer levels are compiled as long as the budget permits.
+                            if (m_callLists[TILE + LEVELS_OF_DETAIL - 1] == 0) {
+                                compiledVertices += compileTile(tileX, tileY, LEVELS_OF_DETAIL - 1);
+                            }
+                            if ( (m_callLists[TILE + desiredLevel] == 0) && (compiledVertices < VERTICES_PER_FRAME) ) {
+                                compiledVertices += compileTile(tileX, tileY, desiredLevel);
+                            }
+
+                            uint32_t level = desiredLevel;
+                            while (m_callLists[TILE + level] == 0) {
+                                level++;
+                            }
+                            glCallList(m_callLists[TILE + level]);
+                        }
                     }
-                    glPopMatrix();
                 }
             }
 
+            void HeightGridRenderer::vertex(const uint32_t &x, const uint32_t &y, const float &offsetZ) {
+                MyImage<BGRPixel> img(m_heightImage);
+                const float HEIGHT = static_cast<int>(img.getPixel(x, m_heightImage->getHeight() - 1 - y)->r) / 255.0f;
+
+                glColor3f(HEIGHT, HEIGHT, HEIGHT);
+                glVertex3f(static_cast<float>(x), static_cast<float>(y), (HEIGHT - m_ground) * m_scaleZ + offsetZ);
+            }
+
+            uint32_t HeightGridRenderer::compileTile(const uint32_t &tileX, const uint32_t &tileY, const uint32_t &level) {
+                const uint32_t STEP = 1 << level;
+                const uint32_t X0 = tileX * TILE_SIZE;
+                const uint32_t Y0 = tileY * TILE_SIZE;
+                const uint32_t X1 = min<uint32_t>((tileX + 1) * TILE_SIZE, m_heightImage->getWidth() - 1);
+                const uint32_t Y1 = min<uint32_t>((tileY + 1) * TILE_SIZE, m_heightImage->getHeight() - 1);
+
+                // Sample every STEP-th row and column but always include the tile's border.
+                vector<uint32_t> xs;
+                for (uint32_t x = X0; x < X1; x += STEP) {
+                    xs.push_back(x);
+                }
+                xs.push_back(X1);
+                vector<uint32_t> ys;
+                for (uint32_t y = Y0; y < Y1; y += STEP) {
+                    ys.push_back(y);
+                }
+                ys.push_back(Y1);
+
+                uint32_t numberOfVertices = 0;
+                const uint32_t CALL_LIST = glGenLists(1);
+                glNewList(CALL_LIST, GL_COMPILE);
+                {
+                    for (uint32_t j = 0; (j + 1) < ys.size(); j++) {
+                        glBegin(GL_TRIANGLE_STRIP);
+                        for (uint32_t i = 0; i < xs.size(); i++) {
+                            vertex(xs[i], ys[j], 0);
+                            vertex(xs[i], ys[j + 1], 0);
+                        }
+                        glEnd();
+                        numberOfVertices += 2 * xs.size();
+                    }
+
+                    // Skirts hanging down from borders to neighboring tiles hide the cracks between different levels.
+                    const float SKIRT = -0.1f * m_scaleZ * (level + 1);
+                    const bool BORDERS[] = { (tileY > 0), ((tileY + 1) < m_numberOfTilesY), (tileX > 0), ((tileX + 1) < m_numberOfTilesX) };
+                    for (uint32_t border = 0; border < 4; border++) {
+                        if (!BORDERS[border]) {
+                            continue;
+                        }
+                        const bool HORIZONTAL = (border < 2);
+                        const vector<uint32_t> &positions = (HORIZONTAL ? xs : ys);
+                        const uint32_t FIXED = (HORIZONTAL ? ((border == 0) ? Y0 : Y1) : ((border == 2) ? X0 : X1));
+
+                        glBegin(GL_TRIANGLE_STRIP);
+                        for (uint32_t i = 0; i < positions.size(); i++) {
+                            const uint32_t X = (HORIZONTAL ? positions[i] : FIXED);
+                            const uint32_t Y = (HORIZONTAL ? FIXED : positions[i]);
+                            vertex(X, Y, 0);
+                            vertex(X, Y, SKIRT);
+                        }
+                        glEnd();
+                        numberOfVertices += 2 * positions.size();
+                    }
+                }
+                glEndList();
+
+                m_callLists[(tileY * m_numberOfTilesX + tileX) * LEVELS_OF_DETAIL + level] = CALL_LIST;
+                return numberOfVertices;
+            }
+
             ////////////////////////////////////////////////////////////////////
 
             HeightGrid::HeightGrid(const NodeDescriptor &nodeDescriptor, const core::wrapper::Image *heightImage, const Point3 &originPixelXY, const Point3 &scalingPixelXY, const float &rotationZ, const float &ground, const float &min, const float &max) :
@@ -84,7 +287,6 @@ namespace opendlv {
                     m_ground(ground),
                     m_min(min),
                     m_max(max),
-                    m_callList(0),
                     m_heightImageNode(NULL),
                     m_heightImageRenderer(NULL) {
                 // Setup height grid renderer.
@@ -100,7 +302,6 @@ namespace opendlv {
                     m_ground(obj.m_ground),
                     m_min(obj.m_min),
                     m_max(obj.m_max),
-                    m_callList(obj.m_callList),
                     m_heightImageNode(NULL),
                     m_heightImageRenderer(NULL) {
                 // Setup height grid renderer.
@@ -125,57 +326,10 @@ namespace opendlv {
 
             HeightGrid::~HeightGrid() {}
 
-            template <class T>
-            class MyImage {
-                private:
-                    const core::wrapper::Image *m_image;
-                    T m_t;
-
-                    MyImage(const MyImage &obj);
-                    MyImage& operator=(const MyImage &obj);
-
-                public:
-                    MyImage(const core::wrapper::Image *image) :
-                            m_image(image),
-                            m_t() {}
-
-                    ~MyImage() {
-                        m_image = NULL;
-                    }
-
-                    inline T* getPixel(const uint32_t &col, const uint32_t &row) {
-                        const uint32_t bytesPerPixel = m_image->getWidthStep() / m_image->getWidth();
-                        if ( (   (m_image->getRawData() + row * m_image->getWidth() * bytesPerPixel + col * bytesPerPixel)
-                                 > (m_image->getRawData() + m_image->getHeight() * m_image->getWidth() * bytesPerPixel + m_image->getWidth() * bytesPerPixel )
-                                 ||
-                                 (   (m_image->getRawData() + row * m_image->getWidth() * bytesPerPixel + col * bytesPerPixel)
-                                     < (m_image->getRawData()) ) ) ) {
-                            return &m_t;
-                        }
-
-                        // TODO: Why the heck do I have sometime to add 1?
-//                        return (T*)(m_image->getRawData() + (bytesPerPixel * (row * (m_image->getWidth()+1) + col)));
-                        return (T*)(m_image->getRawData() + (bytesPerPixel * (row * (m_image->getWidth()) + col)));
-                    }
-            };
-            typedef class BGRPixel_T {
-                public:
-                    unsigned char b;
-                    unsigned char g;
-                    unsigned char r;
-                    BGRPixel_T() :
-                            b(0),
-                            g(0),
-                            r(0) {}
-
-            } BGRPixel;
-
             void HeightGrid::init() {
                 if (m_heightImage != NULL) {
                     clog << "Generate terrain data: " << m_heightImage->getWidth() << ", " << m_heightImage->getHeight() << ", Format: " << m_heightImage->getFormat() << ", width step: " << m_heightImage->getWidthStep() << endl;
 
-                    MyImage<BGRPixel> img(m_heightImage);
-
                     // TODO: Compute normals.
 
                     float scaleZ = m_max - m_min;
@@ -187,20 +341,6 @@ namespace opendlv {
                     }
                     clog << "Ground height: " << m_ground << ", scaling Z : " << scaleZ << ", translation for z-direction: " << (-1 * scaleZ * m_ground) << endl;
 
-                    m_callList = glGenLists(1);
-                    glNewList(m_callList, GL_COMPILE);
-                    for (uint32_t y = 0; y < m_heightImage->getHeight() - 2; y++) {
-                        glBegin(GL_TRIANGLE_STRIP);
-                        for (uint32_t x = 0; x < m_heightImage->getWidth(); x++) {
-                            glColor3f(static_cast<int>(img.getPixel(x, m_heightImage->getHeight() - 1 - y)->r) / 255.0f, static_cast<int>(img.getPixel(x, m_heightImage->getHeight() - 1 - y)->r) / 255.0f, static_cast<int>(img.getPixel(x, m_heightImage->getHeight() - 1 - y)->r) / 255.0f);
-
-                            glVertex3f(static_cast<float>(x), static_cast<float>(y), (static_cast<int>(img.getPixel(x, m_heightImage->getHeight() - 1 - y)->r) / 255.0f - m_ground) * scaleZ);
-                            glVertex3f(static_cast<float>(x), static_cast<float>(y + 1), (static_cast<int>(img.getPixel(x, m_heightImage->getHeight() - 1 - (y + 1))->r) / 255.0f - m_ground) * scaleZ);
-                        }
-                        glEnd();
-                    }
-                    glEndList();
-
                     // Compute translation.
                     Point3 translate;
                     translate.setX(-1 * m_originPixelXY.getX() * m_scalingPixelXY.getX());
@@ -211,7 +351,7 @@ namespace opendlv {
                     scale.setZ(1.0);
 
                     // Set up the actual renderer.
-                    m_heightImageRenderer = new HeightGridRenderer(getNodeDescriptor(), m_callList);
+                    m_heightImageRenderer = new HeightGridRenderer(getNodeDescriptor(), m_heightImage, m_ground, scaleZ);
 
                     // Set up transform group.
                     m_heightImageNode = new TransformGroup();
@@ -231,6 +371,27 @@ namespace opendlv {
                     m_heightImageNode->render(renderingConfiguration);
                 }
             }
+
+            bool HeightGrid::isCompilable() const {
+                return false;
+            }
+
+            bool HeightGrid::getBoundingBox(Point3 &minimum, Point3 &maximum) {
+                if (m_heightImage == NULL) {
+                    return false;
+                }
+
+                // Same transformation as set up in init(); the elevation is in [-ground, 1-ground] * scaleZ.
+                const float SCALE_Z = (m_max - m_min < 0) ? 1.0f : (m_max - m_min);
+                const double TRANSLATE_X = -1 * m_originPixelXY.getX() * m_scalingPixelXY.getX();
+                const double TRANSLATE_Y = -1 * (m_heightImage->getHeight() - m_originPixelXY.getY()) * m_scalingPixelXY.getY();
+                const double WIDTH = m_heightImage->getWidth() * m_scalingPixelXY.getX();
+                const double HEIGHT = m_heightImage->getHeight() * m_scalingPixelXY.getY();
+
+                minimum = Point3(min(TRANSLATE_X, TRANSLATE_X + WIDTH), min(TRANSLATE_Y, TRANSLATE_Y + HEIGHT), -m_ground * SCALE_Z);
+                maximum = Point3(max(TRANSLATE_X, TRANSLATE_X + WIDTH), max(TRANSLATE_Y, TRANSLATE_Y + HEIGHT), (1 - m_ground) * SCALE_Z);
+                return true;
+            }
         }
     }
 } // opendlv::threeD::models
@@ -28,6 +28,7 @@
     #include <GL/gl.h>
 #endif
 
+#include <algorithm>
 #include <string>
 
 #include "opendlv/data/environment/Point3.h"
@@ -88,6 +89,11 @@ namespace opendlv {
                 }
             }
 
+            bool Line::getBoundingBox(Point3 &minimum, Point3 &maximum) {
+                minimum = Point3(min(m_positionA.getX(), m_positionB.getX()), min(m_positionA.getY(), m_positionB.getY()), min(m_positionA.getZ(), m_positionB.getZ()));
+                maximum = Point3(max(m_positionA.getX(), m_positionB.getX()), max(m_positionA.getY(), m_positionB.getY()), max(m_positionA.getZ(), m_positionB.getZ()));
+                return true;
+            }
         }
     }
 } // opendlv::threeD::models
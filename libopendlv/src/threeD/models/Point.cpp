@@ -83,6 +83,11 @@ namespace opendlv {
                 }
             }
 
+            bool Point::getBoundingBox(Point3 &minimum, Point3 &maximum) {
+                minimum = m_position;
+                maximum = m_position;
+                return true;
+            }
         }
     }
 } // opendlv::threeD::models
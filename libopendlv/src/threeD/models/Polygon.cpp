@@ -28,6 +28,7 @@
     #include <GL/gl.h>
 #endif
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -118,6 +119,22 @@ namespace opendlv {
                 }
             }
 
+            bool Polygon::getBoundingBox(Point3 &minimum, Point3 &maximum) {
+                if (m_listOfGroundVertices.empty()) {
+                    return false;
+                }
+
+                minimum = Point3(m_listOfGroundVertices.front().getX(), m_listOfGroundVertices.front().getY(), min(0.0f, m_height));
+                maximum = Point3(m_listOfGroundVertices.front().getX(), m_listOfGroundVertices.front().getY(), max(0.0f, m_height));
+                for (uint32_t i = 1; i < m_listOfGroundVertices.size(); i++) {
+                    const Point3 &p = m_listOfGroundVertices[i];
+                    minimum.setX(min(minimum.getX(), p.getX()));
+                    minimum.setY(min(minimum.getY(), p.getY()));
+                    maximum.setX(max(maximum.getX(), p.getX()));
+                    maximum.setY(max(maximum.getY(), p.getY()));
+                }
+                return true;
+            }
         }
     }
 } // opendlv::threeD::models
@@ -28,6 +28,7 @@
     #include <GL/gl.h>
 #endif
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -38,6 +39,7 @@
 #include "opendlv/threeD/NodeDescriptor.h"
 #include "opendlv/threeD/NodeRenderingConfiguration.h"
 #include "opendlv/threeD/RenderingConfiguration.h"
+#include "opendlv/threeD/TextureManager.h"
 #include "opendlv/threeD/models/Triangle.h"
 #include "opendlv/threeD/models/TriangleSet.h"
 
@@ -54,7 +56,10 @@ namespace opendlv {
                     m_material(),
                     m_vertices(),
                     m_normals(),
-                    m_textureCoordinates() {}
+                    m_textureCoordinates(),
+                    m_hasBoundingBox(false),
+                    m_minimum(),
+                    m_maximum() {}
 
             TriangleSet::TriangleSet(const NodeDescriptor &nodeDescriptor) :
                     Node(nodeDescriptor),
@@ -63,7 +68,10 @@ namespace opendlv {
                     m_material(),
                     m_vertices(),
                     m_normals(),
-                    m_textureCoordinates() {}
+                    m_textureCoordinates(),
+                    m_hasBoundingBox(false),
+                    m_minimum(),
+                    m_maximum() {}
 
             TriangleSet::TriangleSet(const TriangleSet &obj) :
                     Node(obj.getNodeDescriptor()),
@@ -72,7 +80,10 @@ namespace opendlv {
                     m_material(obj.m_material),
                     m_vertices(obj.m_vertices),
                     m_normals(obj.m_normals),
-                    m_textureCoordinates(obj.m_textureCoordinates) {}
+                    m_textureCoordinates(obj.m_textureCoordinates),
+                    m_hasBoundingBox(obj.m_hasBoundingBox),
+                    m_minimum(obj.m_minimum),
+                    m_maximum(obj.m_maximum) {}
 
             TriangleSet::~TriangleSet() {}
 
@@ -84,6 +95,9 @@ namespace opendlv {
                 m_vertices = obj.m_vertices;
                 m_normals = obj.m_normals;
                 m_textureCoordinates = obj.m_textureCoordinates;
+                m_hasBoundingBox = obj.m_hasBoundingBox;
+                m_minimum = obj.m_minimum;
+                m_maximum = obj.m_maximum;
 
                 return (*this);
             }
@@ -96,6 +110,8 @@ namespace opendlv {
 
                 vector<Point3> textureCoordinates = triangle.getTextureCoordinates();
                 m_textureCoordinates.insert(m_textureCoordinates.end(), textureCoordinates.begin(), textureCoordinates.end());
+
+                m_hasBoundingBox = false;
             }
 
             void TriangleSet::setMaterial(const Material &material) {
@@ -138,7 +154,7 @@ namespace opendlv {
                         if (textureHandle > 0) {
                             if (renderingConfiguration.hasDrawTextures()) {
                                 glEnable(GL_TEXTURE_2D);
-                                glBindTexture(GL_TEXTURE_2D, static_cast<uint32_t>(textureHandle));
+                                TextureManager::getInstance().bindTexture(static_cast<uint32_t>(textureHandle));
                                 glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_DECAL);
                             }
                         }
@@ -189,6 +205,23 @@ namespace opendlv {
                     glPopMatrix();
                 }
             }
+
+            bool TriangleSet::getBoundingBox(Point3 &minimum, Point3 &maximum) {
+                if (!m_hasBoundingBox && !m_vertices.empty()) {
+                    m_minimum = m_vertices.front();
+                    m_maximum = m_vertices.front();
+                    for (uint32_t i = 1; i < m_vertices.size(); i++) {
+                        const Point3 &p = m_vertices[i];
+                        m_minimum = Point3(min(m_minimum.getX(), p.getX()), min(m_minimum.getY(), p.getY()), min(m_minimum.getZ(), p.getZ()));
+                        m_maximum = Point3(max(m_maximum.getX(), p.getX()), max(m_maximum.getY(), p.getY()), max(m_maximum.getZ(), p.getZ()));
+                    }
+                    m_hasBoundingBox = true;
+                }
+
+                minimum = m_minimum;
+                maximum = m_maximum;
+                return m_hasBoundingBox;
+            }
         }
     }
 } // opendlv::threeD::models
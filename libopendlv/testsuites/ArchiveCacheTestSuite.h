@@ -0,0 +1,258 @@
+/**
+ * OpenDLV - Simulation environment
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef HESPERIA_ARCHIVECACHETESTSUITE_H_
+#define HESPERIA_ARCHIVECACHETESTSUITE_H_
+
+#include <sys/stat.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "cxxtest/TestSuite.h"
+
+#include "opendlv/data/environment/Point3.h"
+#include "opendlv/io/ArchiveCache.h"
+#include "opendlv/threeD/NodeDescriptor.h"
+#include "opendlv/threeD/TransformGroup.h"
+#include "opendlv/threeD/loaders/OBJXArchive.h"
+#include "opendlv/threeD/loaders/OBJXArchiveFactory.h"
+
+using namespace std;
+using namespace opendlv::data::environment;
+using namespace opendlv::io;
+using namespace opendlv::threeD;
+using namespace opendlv::threeD::loaders;
+
+class ArchiveCacheTest : public CxxTest::TestSuite {
+    public:
+        ArchiveCache& getCache() {
+            // The cache's directory is determined when it is used first.
+            static bool initialized = false;
+            if (!initialized) {
+                char directory[] = "/tmp/ArchiveCacheTestSuiteXXXXXX";
+                TS_ASSERT(::mkdtemp(directory) != NULL);
+                ::setenv("OPENDLV_ARCHIVE_CACHE", directory, 1);
+                initialized = true;
+            }
+            return ArchiveCache::getInstance();
+        }
+
+        TransformGroup* loadModel(const string &obj, string &key) {
+            stringstream in(obj);
+            OBJXArchive *objxArchive = OBJXArchiveFactory::getInstance().getOBJXArchiveFromPlainOBJFile(in);
+            TS_ASSERT(objxArchive != NULL);
+            key = ArchiveCache::getKey("objx-v1", objxArchive->getContentsOfObjFile().str());
+
+            TransformGroup *model = objxArchive->createTransformGroup(NodeDescriptor("Model"));
+            delete objxArchive;
+            return model;
+        }
+
+        bool isClose(const Point3 &a, const Point3 &b) {
+            return (fabs(a.getX() - b.getX()) < 1e-9) && (fabs(a.getY() - b.getY()) < 1e-9) && (fabs(a.getZ() - b.getZ()) < 1e-9);
+        }
+
+        void testHashAndKey() {
+            TS_ASSERT(ArchiveCache::getHash("", 0) == 14695981039346656037ull);
+            TS_ASSERT(ArchiveCache::getHash("a", 1) == 0xaf63dc4c8601ec8cull);
+
+            TS_ASSERT(ArchiveCache::getKey("test-v1", "a") == "test-v1-af63dc4c8601ec8c-1");
+            TS_ASSERT(ArchiveCache::getKey("test-v1", "a") != ArchiveCache::getKey("test-v1", "b"));
+            TS_ASSERT(ArchiveCache::getKey("test-v1", "a") != ArchiveCache::getKey("test-v2", "a"));
+        }
+
+        void testPutAndGet() {
+            ArchiveCache &cache = getCache();
+            TS_ASSERT(cache.isEnabled());
+
+            TS_ASSERT(cache.get("test-missing").get() == NULL);
+
+            const string DATA("Hello\0World", 11);
+            cache.put("test-entry", DATA);
+
+            std::shared_ptr<ArchiveCache::Entry> entry = cache.get("test-entry");
+            TS_ASSERT(entry.get() != NULL);
+            if (entry.get() != NULL) {
+                TS_ASSERT(entry->isValid());
+                TS_ASSERT(entry->getSize() == 11);
+                TS_ASSERT(string(entry->getData(), entry->getSize()) == DATA);
+            }
+
+            // Existing entries are replaced.
+            cache.put("test-entry", "Replaced");
+            entry = cache.get("test-entry");
+            TS_ASSERT(entry.get() != NULL);
+            if (entry.get() != NULL) {
+                TS_ASSERT(string(entry->getData(), entry->getSize()) == "Replaced");
+            }
+        }
+
+        void testOBJXArchiveFromCache() {
+            ArchiveCache &cache = getCache();
+
+            const string OBJ = "v 0 0 0\n"
+                               "v 1 0 0\n"
+                               "v 0 2 0\n"
+                               "v 0 0 3\n"
+                               "vt 0 0\n"
+                               "vt 1 0\n"
+                               "vt 0 1\n"
+                               "vn 0 0 1\n"
+                               "g first\n"
+                               "usemtl red\n"
+                               "f 1/1/1 2/2/1 3/3/1\n"
+                               "g second\n"
+                               "f 1 2 4\n";
+
+            // Parse the obj-file and store the result.
+            string key;
+            TransformGroup *parsed = loadModel(OBJ, key);
+            TS_ASSERT(parsed != NULL);
+            TS_ASSERT(cache.get(key).get() != NULL);
+
+            // Read the result from the cache.
+            TransformGroup *cached = loadModel(OBJ, key);
+            TS_ASSERT(cached != NULL);
+
+            Point3 parsedMinimum;
+            Point3 parsedMaximum;
+            Point3 cachedMinimum;
+            Point3 cachedMaximum;
+            TS_ASSERT(parsed->getBoundingBox(parsedMinimum, parsedMaximum));
+            TS_ASSERT(cached->getBoundingBox(cachedMinimum, cachedMaximum));
+            TS_ASSERT(isClose(parsedMinimum, cachedMinimum));
+            TS_ASSERT(isClose(parsedMaximum, cachedMaximum));
+            TS_ASSERT(isClose(parsedMaximum - parsedMinimum, Point3(1, 3, 2)));
+
+            // Corrupt entries are replaced by parsing the obj-file again.
+            cache.put(key, "OBJXTRI1 truncated");
+            TransformGroup *reparsed = loadModel(OBJ, key);
+            TS_ASSERT(reparsed != NULL);
+
+            Point3 reparsedMinimum;
+            Point3 reparsedMaximum;
+            TS_ASSERT(reparsed->getBoundingBox(reparsedMinimum, reparsedMaximum));
+            TS_ASSERT(isClose(parsedMinimum, reparsedMinimum));
+            TS_ASSERT(isClose(parsedMaximum, reparsedMaximum));
+            TS_ASSERT(cache.get(key)->getSize() > 18);
+
+            // Implausible numbers of triangles are rejected without allocating memory for them.
+            string implausible("OBJXTRI1", 8);
+            const uint32_t GROUP[] = { 1, 0, 0, 0xFFFFFFFF };
+            implausible.append(reinterpret_cast<const char*>(GROUP), sizeof(GROUP));
+            cache.put(key, implausible);
+            TransformGroup *implausibleModel = loadModel(OBJ, key);
+            TS_ASSERT(implausibleModel != NULL);
+            TS_ASSERT(cache.get(key)->getSize() > implausible.size());
+
+            delete parsed;
+            delete cached;
+            delete reparsed;
+            delete implausibleModel;
+        }
+
+        void testEntriesAreChecked() {
+            ArchiveCache &cache = getCache();
+            const string FILE_NAME = string(::getenv("OPENDLV_ARCHIVE_CACHE")) + "/test-checked.bin";
+
+            cache.put("test-checked", "Checked contents");
+            TS_ASSERT(cache.get("test-checked").get() != NULL);
+
+            // Modify one byte of the contents.
+            {
+                fstream f(FILE_NAME.c_str(), ios::binary | ios::in | ios::out);
+                f.seekp(ArchiveCache::HEADER_SIZE + 3);
+                f.put('X');
+            }
+            TS_ASSERT(cache.get("test-checked").get() == NULL);
+
+            // Entries without header are ignored.
+            {
+                fstream f(FILE_NAME.c_str(), ios::binary | ios::out | ios::trunc);
+                f << "Checked contents";
+            }
+            TS_ASSERT(cache.get("test-checked").get() == NULL);
+        }
+
+        void testEntryStreamBuffer() {
+            ArchiveCache &cache = getCache();
+            cache.put("test-stream", "1 2.5 three");
+
+            std::shared_ptr<ArchiveCache::Entry> entry = cache.get("test-stream");
+            TS_ASSERT(entry.get() != NULL);
+            if (entry.get() != NULL) {
+                ArchiveCache::EntryStreamBuffer buffer(entry);
+                istream in(&buffer);
+                int a = 0;
+                double b = 0;
+                string c;
+                in >> a >> b >> c;
+                TS_ASSERT(a == 1);
+                TS_ASSERT(fabs(b - 2.5) < 1e-9);
+                TS_ASSERT(c == "three");
+
+                in.clear();
+                in.seekg(2);
+                in >> b;
+                TS_ASSERT(fabs(b - 2.5) < 1e-9);
+            }
+        }
+
+        void testKeyForFile() {
+            getCache();
+            const string FILE_NAME = string(::getenv("OPENDLV_ARCHIVE_CACHE")) + "/test-key-for-file.scnx";
+            TS_ASSERT(ArchiveCache::getKeyForFile("test-v1", FILE_NAME) == "");
+
+            {
+                fstream f(FILE_NAME.c_str(), ios::binary | ios::out | ios::trunc);
+                f << "Original";
+            }
+            const string KEY = ArchiveCache::getKeyForFile("test-v1", FILE_NAME);
+            TS_ASSERT(KEY.find("test-v1-") == 0);
+            TS_ASSERT(ArchiveCache::getKeyForFile("test-v1", FILE_NAME) == KEY);
+            TS_ASSERT(ArchiveCache::getKeyForFile("test-v2", FILE_NAME) != KEY);
+
+            {
+                fstream f(FILE_NAME.c_str(), ios::binary | ios::out | ios::trunc);
+                f << "Modified contents";
+            }
+            TS_ASSERT(ArchiveCache::getKeyForFile("test-v1", FILE_NAME) != KEY);
+        }
+
+        void testSharedDirectoryIsIgnored() {
+            ArchiveCache &cache = getCache();
+            const string DIRECTORY = ::getenv("OPENDLV_ARCHIVE_CACHE");
+
+            cache.put("test-shared", "Shared");
+            TS_ASSERT(cache.get("test-shared").get() != NULL);
+
+            // Entries in a directory writable by others might have been planted.
+            TS_ASSERT(::chmod(DIRECTORY.c_str(), 0777) == 0);
+            TS_ASSERT(cache.get("test-shared").get() == NULL);
+            TS_ASSERT(::chmod(DIRECTORY.c_str(), 0700) == 0);
+            TS_ASSERT(cache.get("test-shared").get() != NULL);
+        }
+};
+
+#endif /*HESPERIA_ARCHIVECACHETESTSUITE_H_*/
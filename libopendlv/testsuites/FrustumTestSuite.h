@@ -0,0 +1,107 @@
+/**
+ * OpenDLV - Simulation environment
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef HESPERIA_FRUSTUMTESTSUITE_H_
+#define HESPERIA_FRUSTUMTESTSUITE_H_
+
+#include <cmath>
+
+#include "cxxtest/TestSuite.h"
+
+#include "automotivedata/generated/cartesian/Constants.h"
+#include "opendlv/data/environment/Point3.h"
+#include "opendlv/threeD/Frustum.h"
+#include "opendlv/threeD/NodeDescriptor.h"
+#include "opendlv/threeD/TransformGroup.h"
+#include "opendlv/threeD/models/Point.h"
+
+using namespace std;
+using namespace opendlv::data::environment;
+using namespace opendlv::threeD;
+using namespace opendlv::threeD::models;
+
+class FrustumTest : public CxxTest::TestSuite {
+    public:
+        bool isClose(const Point3 &a, const Point3 &b) {
+            return (fabs(a.getX() - b.getX()) < 1e-9) && (fabs(a.getY() - b.getY()) < 1e-9) && (fabs(a.getZ() - b.getZ()) < 1e-9);
+        }
+
+        void testDefaultFrustumIsVisible() {
+            Frustum f;
+            TS_ASSERT(f.isVisible(Point3(1000, 1000, 1000), Point3(1001, 1001, 1001)));
+        }
+
+        void testIdentityFrustum() {
+            const double IDENTITY[16] = { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1 };
+            Frustum f;
+            f.update(IDENTITY, IDENTITY);
+
+            // The visible volume is the cube [-1, 1]^3.
+            TS_ASSERT(f.isVisible(Point3(-0.5, -0.5, -0.5), Point3(0.5, 0.5, 0.5)));
+            TS_ASSERT(f.isVisible(Point3(0.5, 0.5, 0.5), Point3(3, 3, 3)));
+            TS_ASSERT(f.isVisible(Point3(-3, -3, -3), Point3(3, 3, 3)));
+            TS_ASSERT(!f.isVisible(Point3(2, -0.5, -0.5), Point3(3, 0.5, 0.5)));
+            TS_ASSERT(!f.isVisible(Point3(-0.5, -3, -0.5), Point3(0.5, -2, 0.5)));
+            TS_ASSERT(!f.isVisible(Point3(-0.5, -0.5, 1.5), Point3(0.5, 0.5, 2)));
+        }
+
+        void testTranslatedFrustum() {
+            const double IDENTITY[16] = { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1 };
+            // Model view matrix translating by (10, 0, 0).
+            const double TRANSLATION[16] = { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  10, 0, 0, 1 };
+            Frustum f;
+            f.update(IDENTITY, TRANSLATION);
+
+            TS_ASSERT(!f.isVisible(Point3(-0.5, -0.5, -0.5), Point3(0.5, 0.5, 0.5)));
+            TS_ASSERT(f.isVisible(Point3(-10.5, -0.5, -0.5), Point3(-9.5, 0.5, 0.5)));
+        }
+
+        void testTransformGroupBoundingBox() {
+            TransformGroup tg;
+            Point3 minimum;
+            Point3 maximum;
+            TS_ASSERT(!tg.getBoundingBox(minimum, maximum));
+
+            tg.addChild(new Point(NodeDescriptor(), Point3(1, 0, 0), Point3(1, 1, 1), 1));
+            tg.addChild(new Point(NodeDescriptor(), Point3(2, 3, 0), Point3(1, 1, 1), 1));
+            TS_ASSERT(tg.getBoundingBox(minimum, maximum));
+            TS_ASSERT(isClose(minimum, Point3(1, 0, 0)));
+            TS_ASSERT(isClose(maximum, Point3(2, 3, 0)));
+
+            // Rotate by 90 degrees around the z-axis and translate afterwards.
+            tg.setRotation(Point3(0, 0, cartesian::Constants::PI / 2.0));
+            tg.setTranslation(Point3(10, 0, 0));
+            TS_ASSERT(tg.getBoundingBox(minimum, maximum));
+            TS_ASSERT(isClose(minimum, Point3(7, 1, 0)));
+            TS_ASSERT(isClose(maximum, Point3(10, 2, 0)));
+
+            tg.setStatic(true);
+            TS_ASSERT(tg.isStatic());
+            TS_ASSERT(tg.getBoundingBox(minimum, maximum));
+            TS_ASSERT(isClose(minimum, Point3(7, 1, 0)));
+
+            // Adding a child invalidates the cached bounding box.
+            tg.addChild(new Point(NodeDescriptor(), Point3(-1, -1, 5), Point3(1, 1, 1), 1));
+            TS_ASSERT(tg.getBoundingBox(minimum, maximum));
+            TS_ASSERT(isClose(minimum, Point3(7, -1, 0)));
+            TS_ASSERT(isClose(maximum, Point3(11, 2, 5)));
+        }
+};
+
+#endif /*HESPERIA_FRUSTUMTESTSUITE_H_*/
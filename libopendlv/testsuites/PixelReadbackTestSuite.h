@@ -0,0 +1,97 @@
+/**
+ * OpenDLV - Simulation environment
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef HESPERIA_PIXELREADBACKTESTSUITE_H_
+#define HESPERIA_PIXELREADBACKTESTSUITE_H_
+
+#include <vector>
+
+#include "cxxtest/TestSuite.h"
+
+#include "opendlv/threeD/PixelReadback.h"
+
+using namespace std;
+using namespace opendlv::threeD;
+
+class PixelReadbackTest : public CxxTest::TestSuite {
+    public:
+        vector<char> createFrame(const uint32_t &width, const uint32_t &height, const uint32_t &numberOfViews) {
+            // Every pixel encodes its view, row, and column.
+            vector<char> frame(width * numberOfViews * height * PixelReadback::BYTES_PER_PIXEL);
+            for (uint32_t y = 0; y < height; y++) {
+                for (uint32_t x = 0; x < width * numberOfViews; x++) {
+                    char *pixel = &frame[(y * width * numberOfViews + x) * PixelReadback::BYTES_PER_PIXEL];
+                    pixel[0] = static_cast<char>(x / width);
+                    pixel[1] = static_cast<char>(y);
+                    pixel[2] = static_cast<char>(x % width);
+                }
+            }
+            return frame;
+        }
+
+        bool isView(const vector<char> &image, const uint32_t &width, const uint32_t &height, const uint32_t &view) {
+            for (uint32_t y = 0; y < height; y++) {
+                for (uint32_t x = 0; x < width; x++) {
+                    const char *pixel = &image[(y * width + x) * PixelReadback::BYTES_PER_PIXEL];
+                    if ( (pixel[0] != static_cast<char>(view)) || (pixel[1] != static_cast<char>(y)) || (pixel[2] != static_cast<char>(x)) ) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        void testCopySingleView() {
+            const uint32_t WIDTH = 7;
+            const uint32_t HEIGHT = 5;
+            vector<char> frame = createFrame(WIDTH, HEIGHT, 1);
+            vector<char> image(WIDTH * HEIGHT * PixelReadback::BYTES_PER_PIXEL);
+
+            PixelReadback::copyView(&frame[0], WIDTH, HEIGHT, 1, 0, &image[0]);
+            TS_ASSERT(image == frame);
+            TS_ASSERT(isView(image, WIDTH, HEIGHT, 0));
+        }
+
+        void testCopyMultipleViews() {
+            const uint32_t WIDTH = 7;
+            const uint32_t HEIGHT = 5;
+            const uint32_t NUMBER_OF_VIEWS = 3;
+            vector<char> frame = createFrame(WIDTH, HEIGHT, NUMBER_OF_VIEWS);
+
+            for (uint32_t view = 0; view < NUMBER_OF_VIEWS; view++) {
+                vector<char> image(WIDTH * HEIGHT * PixelReadback::BYTES_PER_PIXEL);
+                PixelReadback::copyView(&frame[0], WIDTH, HEIGHT, NUMBER_OF_VIEWS, view, &image[0]);
+                TS_ASSERT(isView(image, WIDTH, HEIGHT, view));
+            }
+        }
+
+        void testNumberOfViews() {
+            // Creating the readback does not require an OpenGL context.
+            PixelReadback one(640, 480, 1, true);
+            TS_ASSERT(one.getNumberOfViews() == 1);
+
+            PixelReadback none(640, 480, 0, true);
+            TS_ASSERT(none.getNumberOfViews() == 1);
+
+            PixelReadback three(640, 480, 3, false);
+            TS_ASSERT(three.getNumberOfViews() == 3);
+        }
+};
+
+#endif /*HESPERIA_PIXELREADBACKTESTSUITE_H_*/
@@ -21,26 +21,81 @@
 #ifndef CONTAINEROBSERVER_H_
 #define CONTAINEROBSERVER_H_
 
+#include <string>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+
+namespace odcore { namespace data { class Container; } }
 namespace odcore { namespace io { namespace conference { class ContainerListener; } } }
 
 namespace cockpit {
 
+    using namespace std;
+
     /**
      * This interface manages multiple ContainerListeners.
      */
     class ContainerObserver {
+        public:
+            /**
+             * Policies how containers are delivered to a ContainerListener.
+             * The containers are delivered in batches once per UI frame;
+             * LATEST_VALUE and BOUNDED_HISTORY drop older containers per
+             * data type and sender stamp that were superseded within the
+             * same frame.
+             */
+            enum DELIVERYPOLICY {
+                EVERY_CONTAINER,
+                LATEST_VALUE,
+                BOUNDED_HISTORY
+            };
+
+            /**
+             * Function to distinguish containers of the same data type and
+             * sender stamp that come from different sources, e.g. shared
+             * images with different names. Containers with different source
+             * names do not supersede each other.
+             */
+            typedef string (*SOURCENAME)(odcore::data::Container &c);
+
         public:
             virtual ~ContainerObserver();
 
             /**
-             * This method adds a container listener.
+             * This method adds a container listener that receives every
+             * container.
              *
              * @param containerListener ContainerListener to be added.
              */
             virtual void addContainerListener(odcore::io::conference::ContainerListener *containerListener) = 0;
 
             /**
-             * This method removes a container listener.
+             * This method adds a container listener for the given data types.
+             *
+             * @param containerListener ContainerListener to be added.
+             * @param dataTypes Data types to deliver; all data types if empty.
+             * @param policy Delivery policy.
+             * @param historySize Maximum number of containers per data type and sender stamp and frame for BOUNDED_HISTORY.
+             */
+            virtual void addContainerListener(odcore::io::conference::ContainerListener *containerListener, const vector<int32_t> &dataTypes, const DELIVERYPOLICY &policy, const uint32_t &historySize) = 0;
+
+            /**
+             * This method adds a container listener for the given data types
+             * whose containers are distinguished by a source name in addition
+             * to their data type and sender stamp. A container listener can be
+             * added several times with different data types and policies.
+             *
+             * @param containerListener ContainerListener to be added.
+             * @param dataTypes Data types to deliver; all data types if empty.
+             * @param policy Delivery policy.
+             * @param historySize Maximum number of containers per source and frame for BOUNDED_HISTORY.
+             * @param sourceName Function returning the source name of a container or NULL.
+             */
+            virtual void addContainerListener(odcore::io::conference::ContainerListener *containerListener, const vector<int32_t> &dataTypes, const DELIVERYPOLICY &policy, const uint32_t &historySize, SOURCENAME sourceName) = 0;
+
+            /**
+             * This method removes all subscriptions of a container listener.
              *
              * @param containerListener ContainerListener to be removed.
              */
@@ -21,6 +21,7 @@
 #ifndef FIFOMULTIPLEXER_H_
 #define FIFOMULTIPLEXER_H_
 
+#include <memory>
 #include <vector>
 
 #include "opendavinci/odcore/opendavinci.h"
@@ -38,7 +39,12 @@ namespace cockpit {
     using namespace std;
 
     /**
-     * This class implements a simple FIFO for multiplexing incoming containers.
+     * This class implements a FIFO for multiplexing incoming containers.
+     * The FIFO is drained once per UI frame and the containers are
+     * delivered to each ContainerListener as one batch according to its
+     * subscription; thus, the load caused by the listeners is bounded by
+     * the frame rate for LATEST_VALUE and BOUNDED_HISTORY subscriptions
+     * regardless of the rate of incoming containers.
      */
     class FIFOMultiplexer : public odcore::base::Service, public ContainerObserver {
         private:
@@ -73,19 +79,66 @@ namespace cockpit {
 
             virtual void addContainerListener(odcore::io::conference::ContainerListener *containerListener);
 
+            virtual void addContainerListener(odcore::io::conference::ContainerListener *containerListener, const vector<int32_t> &dataTypes, const DELIVERYPOLICY &policy, const uint32_t &historySize);
+
+            virtual void addContainerListener(odcore::io::conference::ContainerListener *containerListener, const vector<int32_t> &dataTypes, const DELIVERYPOLICY &policy, const uint32_t &historySize, SOURCENAME sourceName);
+
             virtual void removeContainerListener(odcore::io::conference::ContainerListener *containerListener);
 
+            /**
+             * This method enqueues a container to be delivered with the
+             * next frame.
+             *
+             * @param c Container to distribute.
+             */
             virtual void distributeContainer(odcore::data::Container &c);
 
         protected:
-            virtual odcore::data::Container leaveContainer();
-            virtual uint32_t getFIFOSize();
             virtual void waitForData();
 
         private:
+            /**
+             * Internal class to describe the subscription of a ContainerListener.
+             */
+            class Subscription {
+                public:
+                    Subscription();
+                    Subscription(const Subscription &obj);
+                    Subscription& operator=(const Subscription &obj);
+
+                    bool isSubscribed(const int32_t &dataType) const;
+
+                public:
+                    odcore::io::conference::ContainerListener *m_containerListener;
+                    vector<int32_t> m_dataTypes;
+                    DELIVERYPOLICY m_policy;
+                    uint32_t m_historySize;
+                    SOURCENAME m_sourceName;
+            };
+
+            /**
+             * This method moves all containers from the FIFO into the given list.
+             *
+             * @param containers List to append the containers to.
+             */
+            void leaveContainers(vector<std::shared_ptr<odcore::data::Container> > &containers);
+
+            /**
+             * This method delivers the given containers to all
+             * ContainerListeners according to their subscriptions.
+             *
+             * @param containers Containers received during the last frame in the order of their arrival.
+             */
+            void distributeContainers(const vector<std::shared_ptr<odcore::data::Container> > &containers);
+
+        private:
+            enum {
+                FRAMES_PER_SECOND = 25
+            };
+
             odcore::base::DataStoreManager &m_dataStoreManager;
-            mutable odcore::base::Mutex m_fifoMutex;
-            vector<odcore::io::conference::ContainerListener*> m_listOfContainerListeners;
+            mutable odcore::base::Mutex m_listenersMutex;
+            vector<Subscription> m_listOfSubscriptions;
             odcore::base::FIFOQueue m_fifo;
 
             virtual void beforeStop();
@@ -28,6 +28,7 @@
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/base/Mutex.h"
 #include "opendlv/data/environment/Point3.h"
+#include "opendlv/threeD/FrameCounter.h"
 
 class QKeyEvent;
 class QMouseEvent;
@@ -42,7 +43,9 @@ class PlugIn;
 
         /**
          * This class is the main class for an OpenGL-based visualization.
-         * It provides free camera movements through the scene.
+         * It provides free camera movements through the scene. Pressing
+         * 'F' toggles an overlay with the frame rate and the time for
+         * drawing the scene.
          */
         class AbstractGLWidget : public QGLWidget {
 
@@ -159,6 +162,15 @@ class PlugIn;
                 odcore::base::Mutex m_backgroundColorMutex;
                 opendlv::data::environment::Point3 m_backgroundColor;
 
+                opendlv::threeD::FrameCounter m_frameCounter;
+                bool m_showFrameStatistics;
+
+                /**
+                 * This method draws the frame rate and the frame time
+                 * on top of the scene.
+                 */
+                void drawFrameStatistics();
+
                 virtual void initializeGL();
 
                 virtual void paintGL();
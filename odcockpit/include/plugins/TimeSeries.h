@@ -0,0 +1,205 @@
+/**
+ * cockpit - Visualization environment
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef COCKPIT_PLUGINS_TIMESERIES_H_
+#define COCKPIT_PLUGINS_TIMESERIES_H_
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+
+namespace cockpit {
+    namespace plugins {
+
+        using namespace std;
+
+        /**
+         * This class stores the most recent samples of one signal in
+         * a fixed-capacity ring with separate columns for time stamps
+         * and values. Additionally, it maintains a pyramid of min/max
+         * decimated levels where each bucket of level l summarizes
+         * DECIMATION^l consecutive samples by their minimum and maximum
+         * in the order of their appearance.
+         *
+         * Samples are appended by a single thread without any locks;
+         * any number of threads can read a decimated view or a copy
+         * of the samples concurrently. Readers detect samples that
+         * were overwritten while reading and retry.
+         *
+         * Samples are addressed by their running index, i.e. the
+         * n-th appended sample has the index n-1.
+         */
+        class TimeSeries {
+            private:
+                /**
+                 * "Forbidden" copy constructor. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the copy constructor.
+                 */
+                TimeSeries(const TimeSeries &/*obj*/);
+
+                /**
+                 * "Forbidden" assignment operator. Goal: The compiler should warn
+                 * already at compile time for unwanted bugs caused by any misuse
+                 * of the assignment operator.
+                 */
+                TimeSeries& operator=(const TimeSeries &/*obj*/);
+
+            public:
+                enum {
+                    DECIMATION = 8
+                };
+
+                /**
+                 * Constructor.
+                 *
+                 * @param capacity Number of most recent samples to keep.
+                 */
+                TimeSeries(const uint32_t &capacity);
+
+                virtual ~TimeSeries();
+
+                /**
+                 * This method appends a sample. It must only be called
+                 * from one thread at a time.
+                 *
+                 * @param timeStamp Time stamp of the sample.
+                 * @param value Value of the sample.
+                 */
+                void append(const int64_t &timeStamp, const double &value);
+
+                /**
+                 * @return Number of samples that can be kept.
+                 */
+                uint32_t getCapacity() const;
+
+                /**
+                 * @return Number of currently kept samples.
+                 */
+                uint32_t getSize() const;
+
+                /**
+                 * @return Number of decimated levels without the samples.
+                 */
+                uint32_t getNumberOfLevels() const;
+
+                /**
+                 * This method copies the currently kept samples.
+                 *
+                 * @param timeStamps Time stamps of the samples.
+                 * @param values Values of the samples.
+                 */
+                void getSamples(vector<int64_t> &timeStamps, vector<double> &values) const;
+
+                /**
+                 * This method computes a view on the most recent samples
+                 * from the coarsest decimated level that still provides
+                 * the requested resolution. The x coordinates are sample
+                 * indices relative to the first sample of the window.
+                 *
+                 * @param window Number of most recent samples to view.
+                 * @param maxPoints Maximum number of points that should be returned.
+                 * @param x x coordinates of the points.
+                 * @param y y coordinates of the points.
+                 */
+                void getView(const uint32_t &window, const uint32_t &maxPoints, vector<double> &x, vector<double> &y) const;
+
+            private:
+                /**
+                 * One level of the min/max pyramid.
+                 */
+                class Level {
+                    private:
+                        Level(const Level &/*obj*/);
+                        Level& operator=(const Level &/*obj*/);
+
+                    public:
+                        Level(const uint32_t &capacity, const uint64_t &bucketSize);
+
+                        /**
+                         * This method adds a value to the bucket currently
+                         * being accumulated.
+                         *
+                         * @param value Value.
+                         * @param order Key denoting the order of the value's appearance.
+                         */
+                        void accumulate(const double &value, const uint64_t &order);
+
+                        /**
+                         * This method publishes the accumulated bucket and
+                         * starts the next one.
+                         *
+                         * @param first Extreme that appeared first.
+                         * @param second Extreme that appeared second.
+                         */
+                        void publish(double &first, double &second);
+
+                    public:
+                        const uint32_t m_capacity;
+                        const uint64_t m_bucketSize;
+
+                        // Extremes of each bucket in the order of their appearance.
+                        vector<atomic<double> > m_first;
+                        vector<atomic<double> > m_second;
+                        atomic<uint64_t> m_written;
+
+                        // Bucket currently being accumulated (producer only).
+                        uint32_t m_count;
+                        bool m_isEmpty;
+                        double m_min;
+                        double m_max;
+                        uint64_t m_minOrder;
+                        uint64_t m_maxOrder;
+                };
+
+                /**
+                 * This method reads the points for the samples [from, to)
+                 * from the given level; parts of the range not covered by
+                 * complete buckets are read from the next finer level.
+                 *
+                 * @param level Level to read from (0 denotes the samples).
+                 * @param from First sample index.
+                 * @param to Sample index after the last sample.
+                 * @param origin Sample index mapped to x = 0.
+                 * @param lowestRead Lowest slot read per level.
+                 * @param x x coordinates of the points.
+                 * @param y y coordinates of the points.
+                 */
+                void readRange(const uint32_t &level, const uint64_t &from, const uint64_t &to, const uint64_t &origin, vector<uint64_t> &lowestRead, vector<double> &x, vector<double> &y) const;
+
+                /**
+                 * @return true if none of the slots read were overwritten in the meantime.
+                 */
+                bool isUnmodified(const vector<uint64_t> &lowestRead) const;
+
+            private:
+                const uint32_t m_capacity;
+                const uint32_t m_slots;
+                vector<atomic<int64_t> > m_timeStamps;
+                vector<atomic<double> > m_values;
+                atomic<uint64_t> m_written;
+                vector<unique_ptr<Level> > m_levels;
+        };
+
+    }
+} // cockpit::plugins
+
+#endif /*COCKPIT_PLUGINS_TIMESERIES_H_*/
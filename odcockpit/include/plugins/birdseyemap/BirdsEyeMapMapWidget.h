@@ -33,8 +33,10 @@
 #include "opendlv/data/environment/Point3.h"
 #include "opendlv/scenegraph/SceneNodeDescriptor.h"
 #include "opendlv/scenegraph/renderer/RenderingConfiguration.h"
+#include "opendlv/threeD/FrameCounter.h"
 #include "plugins/birdseyemap/SelectableNodeDescriptorTreeListener.h"
 
+class QKeyEvent;
 class QMouseEvent;
 class QPaintEvent;
 class QTimer;
@@ -51,7 +53,8 @@ namespace cockpit {
             using namespace std;
 
             /**
-             * This class is the widget for a 2D scene.
+             * This class is the widget for a 2D scene. Pressing 'F' toggles
+             * an overlay with the frame rate and the time for drawing the scene.
              */
 class CameraAssignableNodesListener;
 class SelectableNodeDescriptor;
@@ -116,6 +119,8 @@ class SelectableNodeDescriptor;
                     virtual void mouseMoveEvent(QMouseEvent *evnt);
                     virtual void mouseReleaseEvent(QMouseEvent *evnt);
 
+                    virtual void keyPressEvent(QKeyEvent *evnt);
+
                 private:
                     const plugins::PlugIn &m_plugIn;
 
@@ -154,6 +159,9 @@ class SelectableNodeDescriptor;
 
                     opendlv::scenegraph::SceneNode *m_plannedRoute;
 
+                    opendlv::threeD::FrameCounter m_frameCounter;
+                    bool m_showFrameStatistics;
+
                     void createSceneGraph();
 
                     void modifyRenderingConfiguration(odcore::base::TreeNode<SelectableNodeDescriptor> *node);
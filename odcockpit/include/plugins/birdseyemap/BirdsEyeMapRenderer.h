@@ -20,6 +20,8 @@
 #ifndef PLUGINS_BIRDSEYEMAP_BIRDSEYEMAPRENDERER_H_
 #define PLUGINS_BIRDSEYEMAP_BIRDSEYEMAPRENDERER_H_
 
+#include <QtCore>
+
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendlv/scenegraph/renderer/AbstractRenderer.h"
 
@@ -35,6 +37,7 @@ namespace cockpit {
 
             /**
              * This class is responsible for rendering scenegraph primitives.
+             * Primitives outside of the painter's visible area are skipped.
              */
             class BirdsEyeMapRenderer : public opendlv::scenegraph::renderer::AbstractRenderer {
                 private:
@@ -71,10 +74,25 @@ namespace cockpit {
 
                     virtual void render(opendlv::scenegraph::primitives::Polygon *p);
 
+                private:
+                    /**
+                     * This method checks whether a rectangle in the painter's
+                     * coordinates intersects the visible area.
+                     *
+                     * @param minX Minimum x.
+                     * @param minY Minimum y.
+                     * @param maxX Maximum x.
+                     * @param maxY Maximum y.
+                     * @param margin Additional margin, e.g. for the pen's width.
+                     * @return true if the rectangle might be visible.
+                     */
+                    bool isVisible(const double &minX, const double &minY, const double &maxX, const double &maxY, const double &margin) const;
+
                 private:
                     QPainter *m_painter;
                     opendlv::scenegraph::renderer::RenderingConfiguration &m_renderingConfiguration;
                     uint32_t m_pixelPerMeter;
+                    QRectF m_visibleArea;
             };
         }
     }
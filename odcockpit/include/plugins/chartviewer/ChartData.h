@@ -20,7 +20,7 @@
 #ifndef COCKPIT_PLUGINS_CHARTVIEWER_CHARTDATA_H_
 #define COCKPIT_PLUGINS_CHARTVIEWER_CHARTDATA_H_
 
-#include <deque>
+#include <vector>
 
 #if defined __GNUC__
 #pragma GCC system_header
@@ -37,6 +37,7 @@
 #endif
 
 #include "opendavinci/odcore/opendavinci.h"
+#include "plugins/TimeSeries.h"
 
 namespace cockpit {
     namespace plugins {
@@ -45,17 +46,12 @@ namespace cockpit {
             using namespace std;
 
             /**
-             * This class is the container of accessing previous signals.
+             * This class provides the points of a decimated view on a
+             * TimeSeries to Qwt. As Qwt copies its data for each curve,
+             * only the points of the view are held.
              */
             class ChartData : public QwtData {
                 private:
-                    /**
-                     * "Forbidden" copy constructor. Goal: The compiler should warn
-                     * already at compile time for unwanted bugs caused by any misuse
-                     * of the copy constructor.
-                     */
-                    ChartData(const ChartData &/*obj*/);
-
                     /**
                      * "Forbidden" assignment operator. Goal: The compiler should warn
                      * already at compile time for unwanted bugs caused by any misuse
@@ -64,16 +60,26 @@ namespace cockpit {
                     ChartData& operator=(const ChartData &/*obj*/);
 
                 public:
+                    ChartData();
+
                     /**
-                     * Constructor.
+                     * Copy constructor.
                      *
-                     * @param data Reference to the deque of received SensorBoardData.
-                     * @param dataSelection Select the type of data that is returned.
+                     * @param obj Reference to an object of this class.
                      */
-                    ChartData(deque<pair<uint64_t, double> > &data);
+                    ChartData(const ChartData &obj);
 
                     virtual ~ChartData();
 
+                    /**
+                     * This method updates the points from the given time series.
+                     *
+                     * @param timeSeries Time series to view.
+                     * @param window Number of most recent samples to view.
+                     * @param maxPoints Maximum number of points to display.
+                     */
+                    void update(const TimeSeries &timeSeries, const uint32_t &window, const uint32_t &maxPoints);
+
                     virtual QwtData *copy() const;
 
                     virtual size_t size() const;
@@ -83,7 +89,8 @@ namespace cockpit {
                     virtual double y(size_t i) const;
 
                 private:
-                    deque<pair<uint64_t, double> > &m_data;
+                    vector<double> m_x;
+                    vector<double> m_y;
             };
 
         }
@@ -23,16 +23,16 @@
 #include <QtCore>
 #include <QtGui>
 
-#include <deque>
 #include <map>
 #include <string>
 #include <vector>
 
 #include "opendavinci/odcore/opendavinci.h"
-#include "opendavinci/odcore/base/Mutex.h"
 #include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/reflection/FieldAccessor.h"
 #include "opendavinci/odcore/reflection/MessageResolver.h"
 #include "opendavinci/odcore/io/conference/ContainerListener.h"
+#include "plugins/TimeSeries.h"
 
 class QLabel;
 class QwtPlot;
@@ -74,6 +74,10 @@ class ChartData;
                     ChartWidget& operator=(const ChartWidget &/*obj*/);
 
                 public:
+                    enum {
+                        DEFAULT_BUFFER_SIZE = 10000
+                    };
+
                     /**
                      * Constructor.
                      *
@@ -99,6 +103,8 @@ class ChartData;
 
                 private:
                     unique_ptr<odcore::reflection::MessageResolver> m_messageResolver;
+                    odcore::reflection::FieldAccessor m_fieldAccessor;
+                    bool m_isFieldAccessorUnavailable;
 
                     int32_t m_dataType;
                     uint32_t m_senderStamp;
@@ -108,11 +114,19 @@ class ChartData;
                     QwtPlotCurve* m_plotCurve;
                     ChartData* m_chartData;
 
-                    odcore::base::Mutex m_dataMutex;
-                    deque<pair<uint64_t, double> > m_data;
                     uint32_t m_bufferMax;
+                    TimeSeries m_timeSeries;
 
                     QLabel *m_bufferFilling;
+
+                    /**
+                     * This method reads the number of samples to keep from
+                     * odcockpit.chartviewer.buffersize.
+                     *
+                     * @param kvc KeyValueConfiguration.
+                     * @return Configured number of samples or DEFAULT_BUFFER_SIZE.
+                     */
+                    static uint32_t getBufferSize(const odcore::base::KeyValueConfiguration &kvc);
             };
         }
     }
@@ -0,0 +1,163 @@
+/**
+ * cockpit - Visualization environment
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef PLUGINS_ENVIRONMENTVIEWER_POINTCLOUDRENDERER_H_
+#define PLUGINS_ENVIRONMENTVIEWER_POINTCLOUDRENDERER_H_
+
+#include <QtOpenGL>
+
+#include <memory>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Mutex.h"
+#include "opendavinci/odcore/data/CompactPointCloudDecoder.h"
+
+namespace odcore { namespace data { class SharedPointCloud; } }
+namespace odcore { namespace wrapper { class SharedMemory; } }
+
+namespace cockpit {
+    namespace plugins {
+        namespace environmentviewer {
+
+            using namespace std;
+
+            /**
+             * This class renders point clouds from a vertex buffer object.
+             * New point clouds are copied from the shared memory with a
+             * single memcpy while holding its lock, converted to Cartesian
+             * coordinates and colored in the thread delivering the data,
+             * and uploaded to the GPU once by the rendering thread; thus,
+             * repainting the scene does not depend on the arrival of new
+             * data and does not block the producer.
+             */
+            class PointCloudRenderer {
+                private:
+                    /**
+                     * "Forbidden" copy constructor. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the copy constructor.
+                     */
+                    PointCloudRenderer(const PointCloudRenderer &);
+
+                    /**
+                     * "Forbidden" assignment operator. Goal: The compiler should warn
+                     * already at compile time for unwanted bugs caused by any misuse
+                     * of the assignment operator.
+                     */
+                    PointCloudRenderer& operator=(const PointCloudRenderer &);
+
+                public:
+                    PointCloudRenderer();
+
+                    virtual ~PointCloudRenderer();
+
+                    /**
+                     * This method copies and converts a point cloud with four
+                     * float components per point (POLAR_INTENSITY: distance,
+                     * azimuth, vertical angle in DEG, intensity; XYZ_INTENSITY:
+                     * x, y, z, intensity).
+                     *
+                     * @param sharedMemory Shared memory containing the points.
+                     * @param spc Description of the points.
+                     */
+                    void update(std::shared_ptr<odcore::wrapper::SharedMemory> sharedMemory, const odcore::data::SharedPointCloud &spc);
+
+                    /**
+                     * This method copies points decoded from CompactPointClouds.
+                     *
+                     * @param points Decoded points.
+                     * @param hasIntensity true if the points shall be colored by their intensity; otherwise, they are drawn yellow.
+                     */
+                    void update(const odcore::data::CompactPointCloudDecoder::PointBuffer &points, const bool &hasIntensity);
+
+                    /**
+                     * This method uploads the most recent point cloud to the
+                     * GPU if it has changed and renders it. It must be called
+                     * with a current OpenGL context.
+                     */
+                    void render();
+
+                private:
+                    struct Vertex {
+                        float m_x;
+                        float m_y;
+                        float m_z;
+                        uint8_t m_color[4];
+                    };
+
+                    /**
+                     * This method converts the copied polar points into vertices
+                     * using precomputed sine and cosine values.
+                     *
+                     * @param numberOfPoints Number of points to convert.
+                     */
+                    void convertPolarPoints(const uint32_t &numberOfPoints);
+
+                    /**
+                     * This method copies the copied Cartesian points into vertices.
+                     *
+                     * @param numberOfPoints Number of points to copy.
+                     */
+                    void convertCartesianPoints(const uint32_t &numberOfPoints);
+
+                    /**
+                     * This method sets the colors of the vertices from the intensities.
+                     *
+                     * @param numberOfPoints Number of points.
+                     */
+                    void setColors(const uint32_t &numberOfPoints);
+
+                    /**
+                     * This method hands the converted vertices over to the
+                     * rendering thread.
+                     */
+                    void swapVertices();
+
+                private:
+                    // Points copied from the shared memory.
+                    vector<float> m_rawPoints;
+
+                    // Structure of arrays for the conversion.
+                    vector<float> m_distances;
+                    vector<float> m_sinAzimuths;
+                    vector<float> m_cosAzimuths;
+                    vector<float> m_sinVerticalAngles;
+                    vector<float> m_cosVerticalAngles;
+                    vector<float> m_x;
+                    vector<float> m_y;
+                    vector<float> m_z;
+
+                    vector<Vertex> m_vertices;
+
+                    odcore::base::Mutex m_nextVerticesMutex;
+                    vector<Vertex> m_nextVertices;
+                    bool m_hasNextVertices;
+
+                    QGLBuffer m_vertexBuffer;
+                    bool m_isVertexBufferCreated;
+                    bool m_useVertexBuffer;
+                    vector<Vertex> m_renderedVertices;
+                    uint32_t m_numberOfRenderedVertices;
+            };
+        }
+    }
+} // plugins::environmentviewer
+
+#endif /*PLUGINS_ENVIRONMENTVIEWER_POINTCLOUDRENDERER_H_*/
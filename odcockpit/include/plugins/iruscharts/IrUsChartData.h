@@ -21,7 +21,7 @@
 #ifndef COCKPIT_PLUGINS_IRUSCHARTS_IRUSCHARTDATA_H_
 #define COCKPIT_PLUGINS_IRUSCHARTS_IRUSCHARTDATA_H_
 
-#include <deque>
+#include <vector>
 
 #if defined __GNUC__
 #pragma GCC system_header
@@ -38,8 +38,7 @@
 #endif
 
 #include "opendavinci/odcore/opendavinci.h"
-
-namespace automotive { namespace miniature { class SensorBoardData; } }
+#include "plugins/TimeSeries.h"
 
 namespace cockpit {
     namespace plugins {
@@ -48,17 +47,12 @@ namespace cockpit {
             using namespace std;
 
             /**
-             * This class is the container of accessing previous SensorBoardData.
+             * This class provides the points of a decimated view on a
+             * TimeSeries to Qwt. As Qwt copies its data for each curve,
+             * only the points of the view are held.
              */
             class IrUsChartData : public QwtData {
                 private:
-                    /**
-                     * "Forbidden" copy constructor. Goal: The compiler should warn
-                     * already at compile time for unwanted bugs caused by any misuse
-                     * of the copy constructor.
-                     */
-                    IrUsChartData(const IrUsChartData &/*obj*/);
-
                     /**
                      * "Forbidden" assignment operator. Goal: The compiler should warn
                      * already at compile time for unwanted bugs caused by any misuse
@@ -67,16 +61,26 @@ namespace cockpit {
                     IrUsChartData& operator=(const IrUsChartData &/*obj*/);
 
                 public:
+                    IrUsChartData();
+
                     /**
-                     * Constructor.
+                     * Copy constructor.
                      *
-                     * @param data Reference to the deque of received SensorBoardData.
-                     * @param dataSelection Select the type of data that is returned.
+                     * @param obj Reference to an object of this class.
                      */
-                    IrUsChartData(deque<automotive::miniature::SensorBoardData> &data, const uint32_t &dataSelection);
+                    IrUsChartData(const IrUsChartData &obj);
 
                     virtual ~IrUsChartData();
 
+                    /**
+                     * This method updates the points from the given time series.
+                     *
+                     * @param timeSeries Time series to view.
+                     * @param window Number of most recent samples to view.
+                     * @param maxPoints Maximum number of points to display.
+                     */
+                    void update(const TimeSeries &timeSeries, const uint32_t &window, const uint32_t &maxPoints);
+
                     virtual QwtData *copy() const;
 
                     virtual size_t size() const;
@@ -86,8 +90,8 @@ namespace cockpit {
                     virtual double y(size_t i) const;
 
                 private:
-                    deque<automotive::miniature::SensorBoardData> &m_data;
-                    const uint32_t m_dataSelection;
+                    vector<double> m_x;
+                    vector<double> m_y;
             };
 
         }
@@ -26,6 +26,7 @@
 
 #include <deque>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -34,6 +35,7 @@
 #include "opendavinci/odcore/data/Container.h"
 #include "opendavinci/odcore/io/conference/ContainerListener.h"
 #include "automotivedata/generated/automotive/miniature/SensorBoardData.h"
+#include "plugins/TimeSeries.h"
 
 class QLabel;
 class QwtPlot;
@@ -97,8 +99,9 @@ class IrUsChartData;
                     vector<QwtPlot*> m_listOfPlots;
                     vector<QwtPlotCurve*> m_listOfPlotCurves;
                     vector<IrUsChartData*> m_listOfData;
+                    vector<std::shared_ptr<TimeSeries> > m_listOfTimeSeries;
                     map<uint32_t, string> m_mapOfSensors;
-                    deque<automotive::miniature::SensorBoardData> m_data;
+                    map<uint32_t, std::shared_ptr<TimeSeries> > m_mapOfTimeSeries;
                     uint32_t m_bufferMax;
                     odcore::base::Mutex m_receivedSensorBoardDataContainersMutex;
                     deque<odcore::data::Container> m_receivedSensorBoardDataContainers;
@@ -30,6 +30,7 @@
 
 #include "opendavinci/odcore/base/Mutex.h"
 #include "opendavinci/odcore/io/conference/ContainerListener.h"
+#include "opendavinci/odcore/reflection/FieldAccessor.h"
 #include "opendavinci/odcore/reflection/MessageResolver.h"
 
 class QTreeWidget;
@@ -97,6 +98,7 @@ namespace cockpit {
                     QTreeWidget* m_dataView;
                     map<string, QTreeWidgetItem* > m_dataToType;
                     map<int32_t, string> m_containerTypeToName;
+                    map<int32_t, vector<odcore::reflection::FieldAccessor> > m_containerTypeToFieldAccessors;
 
                     odcore::base::Mutex m_containerTypeResolvingMutex;
                     map<string, bool> m_containerTypeResolving;
@@ -30,9 +30,13 @@
 
 #include "opendavinci/odcore/opendavinci.h"
 #include <memory>
+#include "opendavinci/odcore/base/Mutex.h"
 #include "opendavinci/odcore/io/conference/ContainerListener.h"
+#include "opendavinci/generated/odcore/data/dmcp/ContainerStatistics.h"
 #include "opendavinci/generated/odcore/data/dmcp/ModuleStatistics.h"
 
+class QTreeWidget;
+
 namespace cockpit { namespace plugins { class PlugIn; } }
 namespace odcore { namespace data { class Container; } }
 
@@ -85,11 +89,24 @@ class LoadPlot;
           virtual void
           nextContainer(odcore::data::Container &c);
 
+        private:
+          /**
+           * This method updates the view of the container telemetry.
+           *
+           * @param cs Latest telemetry from one module.
+           */
+          void
+          updateContainerStatistics(const odcore::data::dmcp::ContainerStatistics &cs);
+
         private:
           LoadPlot *m_plot;
           deque<odcore::data::dmcp::ModuleStatistics> m_moduleStatistics;
           map<string, std::shared_ptr<LoadPerModule> > m_loadPerModule;
           uint32_t m_color;
+
+          odcore::base::Mutex m_containerStatisticsViewMutex;
+          QTreeWidget *m_containerStatisticsView;
+          map<string, odcore::data::dmcp::ContainerStatistics> m_containerStatistics;
         };
     }
   }
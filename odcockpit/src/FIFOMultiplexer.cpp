@@ -18,9 +18,16 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
+#include <deque>
+#include <map>
+#include <string>
+#include <utility>
+
 #include "opendavinci/odcore/base/DataStoreManager.h"
 #include "opendavinci/odcore/base/Lock.h"
+#include "opendavinci/odcore/base/Thread.h"
 #include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/data/TimeStamp.h"
 #include "opendavinci/odcore/io/conference/ContainerListener.h"
 
 #include "FIFOMultiplexer.h"
@@ -32,38 +39,86 @@ namespace cockpit {
     using namespace odcore::data;
     using namespace odcore::io::conference;
 
+    FIFOMultiplexer::Subscription::Subscription() :
+        m_containerListener(NULL),
+        m_dataTypes(),
+        m_policy(ContainerObserver::EVERY_CONTAINER),
+        m_historySize(0),
+        m_sourceName(NULL) {}
+
+    FIFOMultiplexer::Subscription::Subscription(const Subscription &obj) :
+        m_containerListener(obj.m_containerListener),
+        m_dataTypes(obj.m_dataTypes),
+        m_policy(obj.m_policy),
+        m_historySize(obj.m_historySize),
+        m_sourceName(obj.m_sourceName) {}
+
+    FIFOMultiplexer::Subscription& FIFOMultiplexer::Subscription::operator=(const Subscription &obj) {
+        m_containerListener = obj.m_containerListener;
+        m_dataTypes = obj.m_dataTypes;
+        m_policy = obj.m_policy;
+        m_historySize = obj.m_historySize;
+        m_sourceName = obj.m_sourceName;
+        return *this;
+    }
+
+    bool FIFOMultiplexer::Subscription::isSubscribed(const int32_t &dataType) const {
+        if (m_dataTypes.empty()) {
+            return true;
+        }
+        for (auto it = m_dataTypes.begin(); it != m_dataTypes.end(); ++it) {
+            if (*it == dataType) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     FIFOMultiplexer::FIFOMultiplexer(DataStoreManager &dsm) :
         m_dataStoreManager(dsm),
-        m_fifoMutex(),
-        m_listOfContainerListeners(),
+        m_listenersMutex(),
+        m_listOfSubscriptions(),
         m_fifo() {}
 
     FIFOMultiplexer::~FIFOMultiplexer() {
-        Lock l(m_fifoMutex);
-        m_listOfContainerListeners.clear();
+        Lock l(m_listenersMutex);
+        m_listOfSubscriptions.clear();
     }
 
     void FIFOMultiplexer::addContainerListener(odcore::io::conference::ContainerListener *containerListener) {
+        addContainerListener(containerListener, vector<int32_t>(), ContainerObserver::EVERY_CONTAINER, 0);
+    }
+
+    void FIFOMultiplexer::addContainerListener(odcore::io::conference::ContainerListener *containerListener, const vector<int32_t> &dataTypes, const DELIVERYPOLICY &policy, const uint32_t &historySize) {
+        addContainerListener(containerListener, dataTypes, policy, historySize, NULL);
+    }
+
+    void FIFOMultiplexer::addContainerListener(odcore::io::conference::ContainerListener *containerListener, const vector<int32_t> &dataTypes, const DELIVERYPOLICY &policy, const uint32_t &historySize, SOURCENAME sourceName) {
         if (containerListener != NULL) {
-            Lock l(m_fifoMutex);
-            m_listOfContainerListeners.push_back(containerListener);
+            Subscription s;
+            s.m_containerListener = containerListener;
+            s.m_dataTypes = dataTypes;
+            s.m_policy = policy;
+            s.m_historySize = ( (policy == ContainerObserver::LATEST_VALUE) || (historySize == 0) ) ? 1 : historySize;
+            s.m_sourceName = sourceName;
+
+            Lock l(m_listenersMutex);
+            m_listOfSubscriptions.push_back(s);
         }
     }
 
     void FIFOMultiplexer::removeContainerListener(odcore::io::conference::ContainerListener *containerListener) {
         if (containerListener != NULL) {
-            Lock l(m_fifoMutex);
-            vector<ContainerListener*>::iterator it = m_listOfContainerListeners.begin();
-            while (it != m_listOfContainerListeners.end()) {
-                if (*it == containerListener) {
-                    break;
+            Lock l(m_listenersMutex);
+            vector<Subscription>::iterator it = m_listOfSubscriptions.begin();
+            while (it != m_listOfSubscriptions.end()) {
+                // Actually remove all subscriptions of the container listener.
+                if (it->m_containerListener == containerListener) {
+                    it = m_listOfSubscriptions.erase(it);
+                }
+                else {
+                    it++;
                 }
-                it++;
-            }
-
-            // Actually remove the container listener.
-            if (it != m_listOfContainerListeners.end()) {
-                m_listOfContainerListeners.erase(it);
             }
         }
     }
@@ -78,54 +133,76 @@ namespace cockpit {
     }
 
     void FIFOMultiplexer::distributeContainer(Container &c){
-    	{
-    	  Lock l(m_fifoMutex);
-    	  vector<ContainerListener*>::iterator it = m_listOfContainerListeners.begin();
-    	  while (it != m_listOfContainerListeners.end()) {
-    		  ContainerListener *cl = (*it++);
-    		  if (cl != NULL) {
-    			 cl->nextContainer(c);
-    		  }
-    	  }
-    	}
+        m_fifo.add(c);
     }
 
-    Container FIFOMultiplexer::leaveContainer(){
-    	Container c;
-    	{
-    	   Lock l(m_fifoMutex);
-    	   c = m_fifo.leave();
-    	}
-    	return c;
+    void FIFOMultiplexer::leaveContainers(vector<std::shared_ptr<Container> > &containers) {
+        while (!m_fifo.isEmpty()) {
+            containers.push_back(std::shared_ptr<Container>(new Container(m_fifo.leave())));
+        }
     }
 
-    uint32_t FIFOMultiplexer::getFIFOSize(){
-    	uint32_t size = 0;
-    	{
-    	   Lock l(m_fifoMutex);
-    	   size = m_fifo.getSize();
-    	}
-    	return size;
+    void FIFOMultiplexer::distributeContainers(const vector<std::shared_ptr<Container> > &containers) {
+        Lock l(m_listenersMutex);
+
+        vector<std::shared_ptr<Container> > batch;
+        map<pair<pair<int32_t, uint32_t>, string>, deque<uint32_t> > positionsPerSource;
+        for (auto subscription = m_listOfSubscriptions.begin(); subscription != m_listOfSubscriptions.end(); ++subscription) {
+            ContainerListener *cl = subscription->m_containerListener;
+            if (cl == NULL) {
+                continue;
+            }
+
+            // Select the containers for this subscription in the order of their arrival.
+            batch.clear();
+            positionsPerSource.clear();
+            for (auto it = containers.begin(); it != containers.end(); ++it) {
+                if (subscription->isSubscribed((*it)->getDataType())) {
+                    if (subscription->m_policy != ContainerObserver::EVERY_CONTAINER) {
+                        // Drop the oldest container from the same source that exceeds the history.
+                        const string NAME = (subscription->m_sourceName != NULL) ? subscription->m_sourceName(*(*it)) : string();
+                        deque<uint32_t> &positions = positionsPerSource[make_pair(make_pair((*it)->getDataType(), (*it)->getSenderStamp()), NAME)];
+                        if (positions.size() >= subscription->m_historySize) {
+                            batch[positions.front()].reset();
+                            positions.pop_front();
+                        }
+                        positions.push_back(static_cast<uint32_t>(batch.size()));
+                    }
+                    batch.push_back(*it);
+                }
+            }
+
+            for (auto it = batch.begin(); it != batch.end(); ++it) {
+                if (it->get() != NULL) {
+                    cl->nextContainer(*(*it));
+                }
+            }
+        }
     }
 
     void FIFOMultiplexer::run() {
         // Register FIFO for receiving new data.
         m_dataStoreManager.addDataStoreFor(m_fifo);
 
+        const TimeStamp FRAME_DURATION(0, 1000 * 1000 / FRAMES_PER_SECOND);
+        vector<std::shared_ptr<Container> > containers;
+
         serviceReady();
         while (isRunning()) {
-        	waitForData();
+            waitForData();
 
             if (isRunning()) {
-                // Distribute new containers.
-                const uint32_t COUNT = getFIFOSize();
-                for (uint32_t i = 0; i < COUNT; i++) {
-                	Container c = leaveContainer();
-                    distributeContainer(c);
-                }
+                const TimeStamp frameStart;
+
+                // Distribute all containers received since the last frame at once.
+                containers.clear();
+                leaveContainers(containers);
+                distributeContainers(containers);
+
+                // Let new containers accumulate until the next frame.
+                Thread::usleepUntil(frameStart + FRAME_DURATION);
             }
         }
     }
 
 } // cockpit
-
@@ -33,11 +33,14 @@
 #include <QtOpenGL>
 
 #include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/base/Lock.h"
 #include "automotivedata/generated/cartesian/Constants.h"
+#include "opendlv/threeD/TextureManager.h"
 #include "plugins/AbstractGLWidget.h"
 
 class QWidget;
@@ -78,7 +81,9 @@ class PlugIn;
                 m_mouseY(0),
                 m_mouseButton(0),
                 m_backgroundColorMutex(),
-                m_backgroundColor() {
+                m_backgroundColor(),
+                m_frameCounter(),
+                m_showFrameStatistics(false) {
 
             // For using GLUT, the subsystem must be initialized.
             if (!AbstractGLWidget::m_isGLUTinitialized) {
@@ -154,7 +159,50 @@ class PlugIn;
                       m_translationX - m_rotationX, m_translationY - m_rotationY, m_translationZ - m_rotationZ,
                       m_pitchX, m_pitchY, m_pitchZ);
 
+            m_frameCounter.beginFrame();
+
+            // Continue uploading textures that were loaded in the background.
+            opendlv::threeD::TextureManager::getInstance().update();
+
             drawScene();
+            m_frameCounter.endFrame();
+
+            if (m_showFrameStatistics) {
+                drawFrameStatistics();
+            }
+        }
+
+        void AbstractGLWidget::drawFrameStatistics() {
+            stringstream sstr;
+            sstr << fixed << setprecision(1) << m_frameCounter.getFPS() << " fps, " << setprecision(2) << m_frameCounter.getFrameTime() << " ms/frame";
+            const string TEXT = sstr.str();
+
+            glMatrixMode(GL_PROJECTION);
+            glPushMatrix();
+            glLoadIdentity();
+            gluOrtho2D(0, width(), 0, height());
+            glMatrixMode(GL_MODELVIEW);
+            glPushMatrix();
+            glLoadIdentity();
+
+            glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT);
+            {
+                glDisable(GL_LIGHTING);
+                glDisable(GL_TEXTURE_2D);
+                glDisable(GL_DEPTH_TEST);
+
+                glColor3f(1, 1, 0);
+                glRasterPos2i(10, height() - 20);
+                for (uint32_t i = 0; i < TEXT.length(); i++) {
+                    glutBitmapCharacter(GLUT_BITMAP_HELVETICA_12, TEXT.at(i));
+                }
+            }
+            glPopAttrib();
+
+            glPopMatrix();
+            glMatrixMode(GL_PROJECTION);
+            glPopMatrix();
+            glMatrixMode(GL_MODELVIEW);
         }
 
         void AbstractGLWidget::resizeGL(int32_t w, int32_t h) {
@@ -212,6 +260,11 @@ class PlugIn;
                 m_translationZ += m_keySensitivity * m_rotationZ;
                 emit translationZChanged((double)m_translationZ);
                 break;
+
+            case Qt::Key_F:
+                m_showFrameStatistics = !m_showFrameStatistics;
+                m_frameCounter.reset();
+                break;
             }
 
             updateGL();
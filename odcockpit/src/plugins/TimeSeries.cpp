@@ -0,0 +1,261 @@
+/**
+ * cockpit - Visualization environment
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <algorithm>
+#include <limits>
+
+#include "plugins/TimeSeries.h"
+
+namespace cockpit {
+    namespace plugins {
+
+        using namespace std;
+
+        // Number of attempts to read a consistent view while samples are overwritten.
+        static const uint32_t MAX_READ_ATTEMPTS = 8;
+
+        TimeSeries::Level::Level(const uint32_t &capacity, const uint64_t &bucketSize) :
+            m_capacity(capacity),
+            m_bucketSize(bucketSize),
+            m_first(capacity),
+            m_second(capacity),
+            m_written(0),
+            m_count(0),
+            m_isEmpty(true),
+            m_min(0),
+            m_max(0),
+            m_minOrder(0),
+            m_maxOrder(0) {}
+
+        void TimeSeries::Level::accumulate(const double &value, const uint64_t &order) {
+            if (m_isEmpty || (value < m_min)) {
+                m_min = value;
+                m_minOrder = order;
+            }
+            if (m_isEmpty || (value > m_max)) {
+                m_max = value;
+                m_maxOrder = order;
+            }
+            m_isEmpty = false;
+        }
+
+        void TimeSeries::Level::publish(double &first, double &second) {
+            const bool MIN_FIRST = (m_minOrder <= m_maxOrder);
+            first = (MIN_FIRST ? m_min : m_max);
+            second = (MIN_FIRST ? m_max : m_min);
+
+            const uint64_t BUCKET = m_written.load(memory_order_relaxed);
+            const uint32_t SLOT = static_cast<uint32_t>(BUCKET % m_capacity);
+            m_first[SLOT].store(first, memory_order_relaxed);
+            m_second[SLOT].store(second, memory_order_relaxed);
+            m_written.store(BUCKET + 1, memory_order_release);
+
+            m_count = 0;
+            m_isEmpty = true;
+        }
+
+        TimeSeries::TimeSeries(const uint32_t &capacity) :
+            m_capacity((capacity > 0) ? capacity : 1),
+            // Additional slots give concurrent readers time before the oldest samples are overwritten.
+            m_slots(m_capacity + m_capacity/4 + DECIMATION),
+            m_timeStamps(m_slots),
+            m_values(m_slots),
+            m_written(0),
+            m_levels() {
+            uint64_t bucketSize = DECIMATION;
+            while ((m_slots / bucketSize) >= DECIMATION) {
+                // Two additional buckets cover partially kept buckets at both ends.
+                const uint32_t LEVEL_CAPACITY = static_cast<uint32_t>(m_slots / bucketSize) + 2;
+                m_levels.push_back(unique_ptr<Level>(new Level(LEVEL_CAPACITY, bucketSize)));
+                bucketSize *= DECIMATION;
+            }
+        }
+
+        TimeSeries::~TimeSeries() {}
+
+        void TimeSeries::append(const int64_t &timeStamp, const double &value) {
+            const uint64_t INDEX = m_written.load(memory_order_relaxed);
+            const uint32_t SLOT = static_cast<uint32_t>(INDEX % m_slots);
+            m_timeStamps[SLOT].store(timeStamp, memory_order_relaxed);
+            m_values[SLOT].store(value, memory_order_relaxed);
+            m_written.store(INDEX + 1, memory_order_release);
+
+            if (m_levels.empty()) {
+                return;
+            }
+
+            // Propagate completed buckets through the pyramid.
+            m_levels.front()->accumulate(value, INDEX);
+            if (++(m_levels.front()->m_count) < DECIMATION) {
+                return;
+            }
+
+            for (uint32_t i = 0; i < m_levels.size(); i++) {
+                Level &level = *m_levels.at(i);
+                const uint64_t BUCKET = level.m_written.load(memory_order_relaxed);
+                double first = 0;
+                double second = 0;
+                level.publish(first, second);
+
+                if ((i + 1) == m_levels.size()) {
+                    break;
+                }
+
+                Level &coarser = *m_levels.at(i + 1);
+                coarser.accumulate(first, 2 * BUCKET);
+                coarser.accumulate(second, 2 * BUCKET + 1);
+                if (++coarser.m_count < DECIMATION) {
+                    break;
+                }
+            }
+        }
+
+        uint32_t TimeSeries::getCapacity() const {
+            return m_capacity;
+        }
+
+        uint32_t TimeSeries::getSize() const {
+            const uint64_t WRITTEN = m_written.load(memory_order_acquire);
+            return static_cast<uint32_t>(min<uint64_t>(WRITTEN, m_capacity));
+        }
+
+        uint32_t TimeSeries::getNumberOfLevels() const {
+            return static_cast<uint32_t>(m_levels.size());
+        }
+
+        void TimeSeries::getSamples(vector<int64_t> &timeStamps, vector<double> &values) const {
+            for (uint32_t attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++) {
+                timeStamps.clear();
+                values.clear();
+
+                const uint64_t WRITTEN = m_written.load(memory_order_acquire);
+                const uint64_t FROM = WRITTEN - min<uint64_t>(WRITTEN, m_capacity);
+                timeStamps.reserve(WRITTEN - FROM);
+                values.reserve(WRITTEN - FROM);
+
+                for (uint64_t i = FROM; i < WRITTEN; i++) {
+                    const uint32_t SLOT = static_cast<uint32_t>(i % m_slots);
+                    timeStamps.push_back(m_timeStamps[SLOT].load(memory_order_relaxed));
+                    values.push_back(m_values[SLOT].load(memory_order_relaxed));
+                }
+
+                vector<uint64_t> lowestRead(m_levels.size() + 1, numeric_limits<uint64_t>::max());
+                lowestRead[0] = FROM;
+                if (isUnmodified(lowestRead)) {
+                    break;
+                }
+            }
+        }
+
+        void TimeSeries::getView(const uint32_t &window, const uint32_t &maxPoints, vector<double> &x, vector<double> &y) const {
+            for (uint32_t attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++) {
+                x.clear();
+                y.clear();
+
+                const uint64_t WRITTEN = m_written.load(memory_order_acquire);
+                const uint64_t NUMBER_OF_SAMPLES = min<uint64_t>(min<uint64_t>(window, m_capacity), WRITTEN);
+                if (0 == NUMBER_OF_SAMPLES) {
+                    break;
+                }
+                const uint64_t FROM = WRITTEN - NUMBER_OF_SAMPLES;
+
+                // Select the finest level that does not exceed the number of points.
+                uint32_t level = 0;
+                uint64_t numberOfPoints = NUMBER_OF_SAMPLES;
+                while ( (numberOfPoints > maxPoints) && (level < m_levels.size()) ) {
+                    numberOfPoints = 2 * NUMBER_OF_SAMPLES / m_levels.at(level)->m_bucketSize;
+                    level++;
+                }
+
+                x.reserve(numberOfPoints + 4 * DECIMATION * (level + 1));
+                y.reserve(numberOfPoints + 4 * DECIMATION * (level + 1));
+
+                vector<uint64_t> lowestRead(m_levels.size() + 1, numeric_limits<uint64_t>::max());
+                readRange(level, FROM, WRITTEN, FROM, lowestRead, x, y);
+
+                // If the view could not be read consistently, the last attempt is returned.
+                if (isUnmodified(lowestRead)) {
+                    break;
+                }
+            }
+        }
+
+        void TimeSeries::readRange(const uint32_t &level, const uint64_t &from, const uint64_t &to, const uint64_t &origin, vector<uint64_t> &lowestRead, vector<double> &x, vector<double> &y) const {
+            if (from >= to) {
+                return;
+            }
+
+            if (0 == level) {
+                for (uint64_t i = from; i < to; i++) {
+                    x.push_back(static_cast<double>(i - origin));
+                    y.push_back(m_values[static_cast<uint32_t>(i % m_slots)].load(memory_order_relaxed));
+                }
+                lowestRead[0] = min(lowestRead[0], from);
+                return;
+            }
+
+            const Level &l = *m_levels.at(level - 1);
+            const uint64_t WRITTEN = l.m_written.load(memory_order_acquire);
+            const uint64_t OLDEST = WRITTEN - min<uint64_t>(WRITTEN, l.m_capacity);
+            const uint64_t FIRST_BUCKET = max((from + l.m_bucketSize - 1) / l.m_bucketSize, OLDEST);
+            const uint64_t LAST_BUCKET = min(to / l.m_bucketSize, WRITTEN);
+
+            if (FIRST_BUCKET >= LAST_BUCKET) {
+                readRange(level - 1, from, to, origin, lowestRead, x, y);
+                return;
+            }
+
+            // Samples before the first complete bucket.
+            readRange(level - 1, from, FIRST_BUCKET * l.m_bucketSize, origin, lowestRead, x, y);
+
+            for (uint64_t bucket = FIRST_BUCKET; bucket < LAST_BUCKET; bucket++) {
+                const uint32_t SLOT = static_cast<uint32_t>(bucket % l.m_capacity);
+                const uint64_t BEGIN = bucket * l.m_bucketSize - origin;
+                x.push_back(static_cast<double>(BEGIN));
+                y.push_back(l.m_first[SLOT].load(memory_order_relaxed));
+                x.push_back(static_cast<double>(BEGIN + l.m_bucketSize/2));
+                y.push_back(l.m_second[SLOT].load(memory_order_relaxed));
+            }
+            lowestRead[level] = min(lowestRead[level], FIRST_BUCKET);
+
+            // Samples after the last complete bucket.
+            readRange(level - 1, LAST_BUCKET * l.m_bucketSize, to, origin, lowestRead, x, y);
+        }
+
+        bool TimeSeries::isUnmodified(const vector<uint64_t> &lowestRead) const {
+            // Order the preceding reads of the columns before re-reading the write positions.
+            atomic_thread_fence(memory_order_acquire);
+
+            // The producer might be writing the slot of the next sample already.
+            if ( (lowestRead[0] != numeric_limits<uint64_t>::max()) &&
+                 ((lowestRead[0] + m_slots) <= m_written.load(memory_order_relaxed)) ) {
+                return false;
+            }
+            for (uint32_t i = 0; i < m_levels.size(); i++) {
+                const Level &l = *m_levels.at(i);
+                if ( (lowestRead[i + 1] != numeric_limits<uint64_t>::max()) &&
+                     ((lowestRead[i + 1] + l.m_capacity) <= l.m_written.load(memory_order_relaxed)) ) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    }
+} // cockpit::plugins
@@ -21,6 +21,7 @@
 #include <QtGui>
 
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -98,7 +99,9 @@ namespace cockpit {
                 m_egoCarTrace(NULL),
                 m_obstaclesRoot(NULL),
                 m_mapOfObstacles(),
-                m_plannedRoute(NULL) {
+                m_plannedRoute(NULL),
+                m_frameCounter(),
+                m_showFrameStatistics(false) {
 
                 m_root->addChild(m_scales);
                 m_root->addChild(m_stationaryElements);
@@ -148,6 +151,9 @@ namespace cockpit {
                 m_timer = new QTimer(this);
                 connect(m_timer, SIGNAL(timeout()), this, SLOT(repaint()));
                 m_timer->start(50);
+
+                // Receive key events for toggling the frame statistics.
+                setFocusPolicy(Qt::StrongFocus);
             }
 
             BirdsEyeMapMapWidget::~BirdsEyeMapMapWidget() {
@@ -260,6 +266,17 @@ namespace cockpit {
                  }
             }
 
+            void BirdsEyeMapMapWidget::keyPressEvent(QKeyEvent *evnt) {
+                if ( (evnt != NULL) && (evnt->key() == Qt::Key_F) ) {
+                    Lock l(m_rootMutex);
+                    m_showFrameStatistics = !m_showFrameStatistics;
+                    m_frameCounter.reset();
+                }
+                else {
+                    QWidget::keyPressEvent(evnt);
+                }
+            }
+
             void BirdsEyeMapMapWidget::paintEvent(QPaintEvent *evt) {
                 Lock l(m_rootMutex);
                 const double scaleMax = 20;
@@ -319,7 +336,18 @@ namespace cockpit {
                     BirdsEyeMapRenderer renderer(&painter, m_renderingConfiguration);
 
                     // Render m_root and all its children.
+                    m_frameCounter.beginFrame();
                     m_root->accept(renderer);
+                    m_frameCounter.endFrame();
+                }
+
+                if (m_showFrameStatistics) {
+                    stringstream sstr;
+                    sstr << fixed << setprecision(1) << m_frameCounter.getFPS() << " fps, " << setprecision(2) << m_frameCounter.getFrameTime() << " ms/frame";
+
+                    painter.resetTransform();
+                    painter.setPen(QPen(Qt::yellow));
+                    painter.drawText(10, 20, QString(sstr.str().c_str()));
                 }
 
                 painter.end();
@@ -17,7 +17,12 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
+#include <vector>
+
 #include "opendavinci/odcore/opendavinci.h"
+#include "opendlv/data/environment/EgoState.h"
+#include "opendlv/data/environment/Obstacle.h"
+#include "opendlv/data/planning/Route.h"
 #include "ContainerObserver.h"
 #include "plugins/birdseyemap/BirdsEyeMapPlugIn.h"
 #include "plugins/birdseyemap/BirdsEyeMapWidget.h"
@@ -29,6 +34,7 @@ namespace cockpit {
     namespace plugins {
         namespace birdseyemap {
 
+            using namespace std;
             using namespace odcore::base;
 
             BirdsEyeMapPlugIn::BirdsEyeMapPlugIn(const string &name, const KeyValueConfiguration &kvc, QWidget* prnt) :
@@ -45,7 +51,14 @@ namespace cockpit {
 
                 cockpit::ContainerObserver *co = getContainerObserver();
                 if (co != NULL) {
-                    co->addContainerListener(m_widget);
+                    // Only the most recent states are displayed.
+                    vector<int32_t> latestValues;
+                    latestValues.push_back(opendlv::data::environment::EgoState::ID());
+                    latestValues.push_back(opendlv::data::planning::Route::ID());
+                    co->addContainerListener(m_widget, latestValues, ContainerObserver::LATEST_VALUE, 1);
+
+                    // Obstacles modify the scene incrementally.
+                    co->addContainerListener(m_widget, vector<int32_t>(1, opendlv::data::environment::Obstacle::ID()), ContainerObserver::BOUNDED_HISTORY, 100);
                 }
             }
 
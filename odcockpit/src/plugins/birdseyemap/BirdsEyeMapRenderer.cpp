@@ -20,6 +20,8 @@
 #include <QtCore>
 #include <QtGui>
 
+#include <algorithm>
+
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendlv/scenegraph/renderer/RenderingConfiguration.h"
 #include "opendlv/scenegraph/renderer/SceneNodeRenderingConfiguration.h"
@@ -41,12 +43,27 @@ namespace cockpit {
                 AbstractRenderer(),
                 m_painter(painter),
                 m_renderingConfiguration(rc),
-                m_pixelPerMeter(pixelPerMeter) {}
+                m_pixelPerMeter(pixelPerMeter),
+                // Map the painter's viewport back into the coordinates used for drawing.
+                m_visibleArea(painter->combinedTransform().inverted().mapRect(QRectF(painter->viewport()))) {}
 
             BirdsEyeMapRenderer::~BirdsEyeMapRenderer() {}
 
+            bool BirdsEyeMapRenderer::isVisible(const double &minX, const double &minY, const double &maxX, const double &maxY, const double &margin) const {
+                return !( ((maxX + margin) < m_visibleArea.left()) ||
+                          ((minX - margin) > m_visibleArea.right()) ||
+                          ((maxY + margin) < m_visibleArea.top()) ||
+                          ((minY - margin) > m_visibleArea.bottom()) );
+            }
+
             void BirdsEyeMapRenderer::render(opendlv::scenegraph::primitives::Point *p) {
                 if ( (p != NULL) && (m_renderingConfiguration.getSceneNodeRenderingConfiguration(p->getSceneNodeDescriptor()).hasParameter(SceneNodeRenderingConfiguration::ENABLED)) ) {
+                    const double X = p->getPosition().getX()*m_pixelPerMeter;
+                    const double Y = p->getPosition().getY()*m_pixelPerMeter;
+                    if (!isVisible(X, Y, X, Y, p->getWidth()*m_pixelPerMeter/10)) {
+                        return;
+                    }
+
                     QPen pen;
                     pen.setWidth(p->getWidth()*m_pixelPerMeter/10);
                     pen.setColor(QColor(255*p->getColor().getX(), 255*p->getColor().getY(), 255*p->getColor().getZ()));
@@ -59,6 +76,12 @@ namespace cockpit {
 
             void BirdsEyeMapRenderer::render(opendlv::scenegraph::primitives::Line *l) {
                 if ( (l != NULL) && (m_renderingConfiguration.getSceneNodeRenderingConfiguration(l->getSceneNodeDescriptor()).hasParameter(SceneNodeRenderingConfiguration::ENABLED)) ) {
+                    if (!isVisible(min(l->getA().getX(), l->getB().getX())*m_pixelPerMeter, min(l->getA().getY(), l->getB().getY())*m_pixelPerMeter,
+                                   max(l->getA().getX(), l->getB().getX())*m_pixelPerMeter, max(l->getA().getY(), l->getB().getY())*m_pixelPerMeter,
+                                   l->getWidth()*m_pixelPerMeter/10)) {
+                        return;
+                    }
+
                     QPen pen;
                     pen.setWidth(l->getWidth()*m_pixelPerMeter/10);
                     pen.setColor(QColor(255*l->getColor().getX(), 255*l->getColor().getY(), 255*l->getColor().getZ()));
@@ -72,15 +95,32 @@ namespace cockpit {
 
             void BirdsEyeMapRenderer::render(opendlv::scenegraph::primitives::Polygon *p) {
                 if ( (p != NULL) && (m_renderingConfiguration.getSceneNodeRenderingConfiguration(p->getSceneNodeDescriptor()).hasParameter(SceneNodeRenderingConfiguration::ENABLED)) ) {
+                    const vector<opendlv::data::environment::Point3>& listOfGroundVertices = p->getListOfGroundVertices();
+                    const uint32_t size = listOfGroundVertices.size();
+                    if (size == 0) {
+                        return;
+                    }
+
+                    double minX = listOfGroundVertices[0].getX();
+                    double minY = listOfGroundVertices[0].getY();
+                    double maxX = minX;
+                    double maxY = minY;
+                    for (uint32_t i = 1; i < size; i++) {
+                        minX = min(minX, listOfGroundVertices[i].getX());
+                        minY = min(minY, listOfGroundVertices[i].getY());
+                        maxX = max(maxX, listOfGroundVertices[i].getX());
+                        maxY = max(maxY, listOfGroundVertices[i].getY());
+                    }
+                    if (!isVisible(minX*m_pixelPerMeter, minY*m_pixelPerMeter, maxX*m_pixelPerMeter, maxY*m_pixelPerMeter, 1*m_pixelPerMeter/10)) {
+                        return;
+                    }
+
                     QPen pen;
                     pen.setWidth(1*m_pixelPerMeter/10);
                     pen.setColor(QColor(255*p->getColor().getX(), 255*p->getColor().getY(), 255*p->getColor().getZ()));
 
                     m_painter->setPen(pen);
 
-                    const vector<opendlv::data::environment::Point3>& listOfGroundVertices = p->getListOfGroundVertices();
-                    const uint32_t size = listOfGroundVertices.size();
-
                     for (uint32_t i = 0; i < size - 1; i++) {
                         const opendlv::data::environment::Point3 &p1 = listOfGroundVertices[i];
                         const opendlv::data::environment::Point3 &p2 = listOfGroundVertices[i+1];
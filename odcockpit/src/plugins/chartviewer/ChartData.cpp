@@ -27,26 +27,36 @@ namespace cockpit {
 
             using namespace std;
 
-            ChartData::ChartData(deque<pair<uint64_t, double> > &data) :
+            ChartData::ChartData() :
                 QwtData(),
-                m_data(data) {}
+                m_x(),
+                m_y() {}
+
+            ChartData::ChartData(const ChartData &obj) :
+                QwtData(),
+                m_x(obj.m_x),
+                m_y(obj.m_y) {}
 
             ChartData::~ChartData() {}
 
+            void ChartData::update(const TimeSeries &timeSeries, const uint32_t &window, const uint32_t &maxPoints) {
+                timeSeries.getView(window, maxPoints, m_x, m_y);
+            }
+
             QwtData* ChartData::copy() const {
-                return new ChartData(m_data);
+                return new ChartData(*this);
             }
 
             size_t ChartData::size() const {
-                return m_data.size();
+                return m_x.size();
             }
 
             double ChartData::x(size_t i) const {
-                return static_cast<double>(i);
+                return m_x.at(i);
             }
 
             double ChartData::y(size_t i) const {
-                return m_data.at(i).second;
+                return m_y.at(i);
             }
 
         }
@@ -49,7 +49,8 @@ namespace cockpit {
 
                 ContainerObserver *co = getContainerObserver();
                 if (co != NULL) {
-                    co->addContainerListener(m_chartWidget);
+                    // Keep up to 100 samples per frame for plotting.
+                    co->addContainerListener(m_chartWidget, vector<int32_t>(1, m_dataType), ContainerObserver::BOUNDED_HISTORY, 100);
                 }
 
             }
@@ -27,6 +27,7 @@
 # pragma GCC diagnostic ignored "-Weffc++"
 #endif
     #include <qwt_plot.h>
+    #include <qwt_plot_canvas.h>
     #include <qwt_plot_curve.h>
     #include <qwt_plot_item.h>
 #ifndef WIN32
@@ -36,6 +37,7 @@
 #endif
 
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <iomanip>
@@ -44,9 +46,9 @@
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/base/KeyValueConfiguration.h"
-#include "opendavinci/odcore/base/Lock.h"
 #include "opendavinci/odcore/data/Container.h"
 #include "opendavinci/odcore/reflection/Field.h"
+#include "opendavinci/odcore/reflection/FieldAccessor.h"
 #include "opendavinci/odcore/reflection/Message.h"
 #include "opendavinci/odcore/strings/StringToolbox.h"
 #include "opendavinci/generated/odcockpit/SimplePlot.h"
@@ -71,15 +73,16 @@ namespace cockpit {
             ChartWidget::ChartWidget(const PlugIn &/*plugIn*/, const string &title, const int32_t &dataType, const uint32_t &senderStamp, const string &fieldName, const odcore::base::KeyValueConfiguration &kvc, QWidget *prnt) :
                 QWidget(prnt),
                 m_messageResolver(),
+                m_fieldAccessor(),
+                m_isFieldAccessorUnavailable(false),
                 m_dataType(dataType),
                 m_senderStamp(senderStamp),
                 m_fieldName(fieldName),
                 m_plot(),
                 m_plotCurve(),
                 m_chartData(),
-                m_dataMutex(),
-                m_data(),
-                m_bufferMax(10000),
+                m_bufferMax(getBufferSize(kvc)),
+                m_timeSeries(m_bufferMax),
                 m_bufferFilling(NULL) {
 
                 // Set size.
@@ -102,7 +105,7 @@ namespace cockpit {
                     m_plot->setAxisTitle(QwtPlot::yLeft, title.c_str());
 
                     // Setup data interface.
-                    m_chartData = new ChartData(m_data);
+                    m_chartData = new ChartData();
 
                     // Setup data curve.
                     m_plotCurve = new QwtPlotCurve();
@@ -136,33 +139,44 @@ namespace cockpit {
 
             ChartWidget::~ChartWidget() {}
 
+            uint32_t ChartWidget::getBufferSize(const odcore::base::KeyValueConfiguration &kvc) {
+                uint32_t bufferSize = ChartWidget::DEFAULT_BUFFER_SIZE;
+                try {
+                    bufferSize = kvc.getValue<uint32_t>("odcockpit.chartviewer.buffersize");
+                }
+                catch(...) {}
+                return (bufferSize > 0) ? bufferSize : static_cast<uint32_t>(ChartWidget::DEFAULT_BUFFER_SIZE);
+            }
+
             void ChartWidget::TimerEvent() {
+                // Two points per pixel suffice to show the extremes of each column.
+                const uint32_t MAX_POINTS = 2 * static_cast<uint32_t>(max(m_plot->canvas()->width(), 1));
+                m_chartData->update(m_timeSeries, m_bufferMax, MAX_POINTS);
+                m_plotCurve->setData(*m_chartData);
                 m_plot->replot();
             }
 
             void ChartWidget::saveCSVFile() {
                 string fn = QFileDialog::getSaveFileName(this, tr("Save received data as .csv file"), "", tr("CSV files (*.csv)")).toStdString();
-                {
-                    Lock l(m_dataMutex);
+                if (!fn.empty()) {
+                    vector<int64_t> timeStamps;
+                    vector<double> values;
+                    m_timeSeries.getSamples(timeStamps, values);
 
-                    if (!fn.empty()) {
-                        fstream fout(fn, ios::out|ios::trunc);
+                    fstream fout(fn, ios::out|ios::trunc);
 
-                        // Write header.
-                        fout << "time stamp sample time [microseconds]" << ";" << "value" << endl;
+                    // Write header.
+                    fout << "time stamp sample time [microseconds]" << ";" << "value" << endl;
 
-                        for(auto it = m_data.begin(); it != m_data.end(); it++) {
-                            fout << setprecision(10) << it->first << ";" << setprecision(10) << it->second << endl;
-                        }
-
-                        fout.flush();
+                    for(uint32_t i = 0; i < timeStamps.size(); i++) {
+                        fout << setprecision(10) << timeStamps.at(i) << ";" << setprecision(10) << values.at(i) << endl;
                     }
+
+                    fout.flush();
                 }
             }
 
             void ChartWidget::nextContainer(Container &container) {
-                Lock l(m_dataMutex);
-
                 if ( (container.getDataType() == m_dataType) && (container.getSenderStamp() == m_senderStamp) ) {
                     double value = 0;
                     if ( container.getDataType() == odcockpit::SimplePlot::ID() ) {
@@ -172,31 +186,44 @@ namespace cockpit {
                         }
                     }
                     else {
-                        bool successfullyMapped = false;
-                        odcore::reflection::Message msg = m_messageResolver->resolve(container, successfullyMapped);
-                        if (successfullyMapped) {
-                            for(uint32_t i = 0; i < msg.getNumberOfFields(); i++) {
-                                bool found = false;
-                                std::shared_ptr<odcore::data::reflection::AbstractField> f = msg.getFieldByIdentifier(i, found);
-                                if (f.get() && found && (0 == f->getShortFieldName().find(m_fieldName)) ) {
-                                    if (f->getFieldDataType() <= odcore::data::reflection::AbstractField::DOUBLE_T) {
-                                        found = false; bool extracted = false;
-                                        value = msg.getValueFromScalarField<double>(i, found, extracted);
-                                        break;
+                        // Compile the field path once from the first resolvable container.
+                        if (!m_fieldAccessor.isCompiled() && !m_isFieldAccessorUnavailable) {
+                            bool successfullyMapped = false;
+                            odcore::reflection::Message msg = m_messageResolver->resolve(container, successfullyMapped);
+                            if (successfullyMapped) {
+                                m_isFieldAccessorUnavailable = !m_fieldAccessor.compile(msg, m_fieldName);
+                            }
+                        }
+
+                        if (m_fieldAccessor.isCompiled()) {
+                            bool extracted = false;
+                            value = m_fieldAccessor.getValue(container, extracted);
+                        }
+                        else if (m_isFieldAccessorUnavailable) {
+                            // Fall back to matching the beginning of the field names.
+                            bool successfullyMapped = false;
+                            odcore::reflection::Message msg = m_messageResolver->resolve(container, successfullyMapped);
+                            if (successfullyMapped) {
+                                for(uint32_t i = 0; i < msg.getNumberOfFields(); i++) {
+                                    bool found = false;
+                                    std::shared_ptr<odcore::data::reflection::AbstractField> f = msg.getFieldByIdentifier(i, found);
+                                    if (f.get() && found && (0 == f->getShortFieldName().find(m_fieldName)) ) {
+                                        if (f->getFieldDataType() <= odcore::data::reflection::AbstractField::DOUBLE_T) {
+                                            found = false; bool extracted = false;
+                                            value = msg.getValueFromScalarField<double>(i, found, extracted);
+                                            break;
+                                        }
                                     }
                                 }
                             }
                         }
                     }
 
-                    m_data.push_back(make_pair(container.getSampleTimeStamp().toMicroseconds(), value));
-                    if (m_data.size() > m_bufferMax) {
-                        m_data.pop_front();
-                    }
+                    m_timeSeries.append(container.getSampleTimeStamp().toMicroseconds(), value);
 
                     {
                         stringstream sstr;
-                        sstr << "Ringbuffer: " << m_data.size() << "/" << m_bufferMax << " entries received.";
+                        sstr << "Ringbuffer: " << m_timeSeries.getSize() << "/" << m_bufferMax << " entries received.";
                         const string str = sstr.str();
                         QString qs(str.c_str());
                         emit updateLabel(qs);
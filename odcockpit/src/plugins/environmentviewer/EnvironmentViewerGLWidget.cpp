@@ -32,9 +32,7 @@
 #include <iostream>
 #include <memory>
 #include <string>
-#include <sstream>
 #include <vector>
-#include <array>
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/base/KeyValueConfiguration.h"
@@ -127,54 +125,14 @@ namespace cockpit {
                     m_velodyneSharedMemory(NULL),
                     m_hasAttachedToSharedImageMemory(false),
                     m_velodyneFrame(),
-                    m_12_startingSensorID_32(0),//The first HDL-32E CPC starts from Layer 0
-                    m_11_startingSensorID_32(2),//The second HDL-32E CPC starts from Layer 2
-                    m_9_startingSensorID_32(5),//The third HDL-32E CPC starts from Layer 5
-                    m_12_verticalAngles(),
-                    m_11_verticalAngles(),
-                    m_9_verticalAngles(),
-                    m_12_cpcDistance_32(""),
-                    m_11_cpcDistance_32(""),
-                    m_9_cpcDistance_32(""),
+                    m_pointCloudRenderer(),
                     m_previousCPC32TimeStamp(0),
-                    m_cpcMask_32(0),
-                    m_cpc(),
-                    m_cpcMutex(),
+                    m_cpcDecoder(),
+                    m_cpcPoints(),
                     m_SPCReceived(false),
                     m_CPCReceived(false),
-                    m_recordingYear(0) {
-                    
-                std::array<float, 32>  sensorIDs_32;
-                bool use32IncrementA = true;
-                sensorIDs_32[0] = START_V_ANGLE_32;
-                //Derive the 32 vertical angles for HDL-32E based on the starting angle and the two increments
-                for (uint8_t counter = 1; counter < 31; counter++) {
-                    sensorIDs_32[counter] += use32IncrementA ?  V_INCREMENT_32_A : V_INCREMENT_32_B;
-                    use32IncrementA = !use32IncrementA;
-                }
-                //Derive the 12 vertical angles associated with the first part of CPC for HDL-32E
-                m_12_verticalAngles[0] = sensorIDs_32[m_12_startingSensorID_32];
-                uint8_t currentSensorID = m_12_startingSensorID_32 + 1;
-                m_12_verticalAngles[1] = sensorIDs_32[currentSensorID];
-                for (uint8_t counter = 2; counter < 11; counter++) {
-                    m_12_verticalAngles[counter] = sensorIDs_32[currentSensorID + 3];    
-                }
-                //Derive the 11 vertical angles associated with the second part of CPC for HDL-32E
-                m_11_verticalAngles[0] = sensorIDs_32[m_11_startingSensorID_32];
-                currentSensorID = m_11_startingSensorID_32 + 1;
-                m_11_verticalAngles[1] = sensorIDs_32[currentSensorID];
-                for (uint8_t counter = 2; counter < 10; counter++) {
-                    m_11_verticalAngles[counter] = sensorIDs_32[currentSensorID + 3];    
-                }
-                //Derive the 9 vertical angles associated with the third part of CPC for HDL-32E
-                m_9_verticalAngles[0] = sensorIDs_32[m_9_startingSensorID_32];
-                currentSensorID = m_9_startingSensorID_32 + 1;
-                m_9_verticalAngles[1] = sensorIDs_32[currentSensorID];
-                for (uint8_t counter = 2; counter < 8; counter++) {
-                    m_9_verticalAngles[counter] = sensorIDs_32[currentSensorID + 3];    
-                }
-            }
-        
+                    m_recordingYear(0) {}
+
             EnvironmentViewerGLWidget::~EnvironmentViewerGLWidget() {
                 OPENDAVINCI_CORE_DELETE_POINTER(m_root);
                 OPENDAVINCI_CORE_DELETE_POINTER(m_selectableNodeDescriptorTree);
@@ -224,6 +182,9 @@ namespace cockpit {
 
                         m_stationaryElements->addChild(new opendlv::threeD::models::XYZAxes(NodeDescriptor("XYZAxes"), 1, 10));
                         m_stationaryElements->addChild(new opendlv::threeD::models::Grid(NodeDescriptor("Grid"), 10, 1));
+
+                        // The surroundings do not change; thus, their bounding boxes and display lists can be cached.
+                        m_stationaryElements->setStatic(true);
                     }
                 }
 
@@ -246,7 +207,7 @@ namespace cockpit {
                         fstream fin(objxModel.c_str(), ios::in | ios::binary);
                         if (fin.good()) {
                             cout << "Loading car model" << endl;
-                            OBJXArchive *objxArchive = OBJXArchiveFactory::getInstance().getOBJXArchive(fin);
+                            OBJXArchive *objxArchive = OBJXArchiveFactory::getInstance().getOBJXArchive(objxModel);
 
                             fin.close();
                             if (objxArchive != NULL) {
@@ -347,305 +308,26 @@ namespace cockpit {
                 glLightfv(GL_LIGHT0, GL_SPECULAR, light0Specular);
             }
             
-            void EnvironmentViewerGLWidget::drawOneCPCPointNoIntensity(const uint16_t &distance_integer, const float &azimuth, const float &verticalAngle, const uint8_t &distanceEncoding) {
-                //Recordings before 2017 do not call hton() while storing CPC.
-                //Hence, we only call ntoh() for recordings from 2017.
-                uint16_t distanceCPCPoint = distance_integer;
-                if (m_recordingYear > 2016) {
-                    distanceCPCPoint = ntohs(distanceCPCPoint);
-                }
-                float distance = 0.0;
-                switch (distanceEncoding) {
-                    case CompactPointCloud::CM : distance = static_cast<float>(distanceCPCPoint / 100.0f); //convert to meter from resolution 1 cm
-                                                 break;
-                    case CompactPointCloud::MM : distance = static_cast<float>(distanceCPCPoint / 500.0f); //convert to meter from resolution 2 mm
-                                                 break;
-                }
-                if (distance > 1.0f) {//Only viualize the point when the distance is larger than 1m
-                    // Compute x, y, z coordinate based on distance, azimuth, and vertical angle
-                    float xyDistance = distance * cos(verticalAngle * static_cast<float>(cartesian::Constants::DEG2RAD));
-                    float xData = xyDistance * sin(azimuth * static_cast<float>(cartesian::Constants::DEG2RAD));
-                    float yData = xyDistance * cos(azimuth * static_cast<float>(cartesian::Constants::DEG2RAD));
-                    float zData = distance * sin(verticalAngle * static_cast<float>(cartesian::Constants::DEG2RAD));
-                    glVertex3f(xData, yData, zData);//Plot the point 
-                }
-            }
-
-            void EnvironmentViewerGLWidget::drawOneCPCPointWithIntensity(const uint16_t &distance_integer, const float &azimuth, const float &verticalAngle, const uint8_t &distanceEncoding, const uint8_t &numberOfBitsForIntensity, const uint8_t &intensityPlacement, const uint16_t &_mask, const float &intensityMaxValue) {
-                //Recordings before 2017 do not call hton() while storing CPC.
-                //Hence, we only call ntoh() for recordings from 2017.
-                uint16_t distanceCPCPoint = distance_integer;
-                if (m_recordingYear > 2016) {
-                    distanceCPCPoint = ntohs(distanceCPCPoint);
-                }
-                float distance = 0.0;
-                uint8_t intensity = 0;
-                uint16_t cappedDistance = distanceCPCPoint & _mask;
-                if (intensityPlacement == 0) {//higher bits for intensity
-                    intensity = distanceCPCPoint >> (16 - numberOfBitsForIntensity);
-                } else {//lower bits for intensity
-                    intensity = distanceCPCPoint - cappedDistance;
-                }
-                
-                switch (distanceEncoding) {
-                    case CompactPointCloud::CM : distance = static_cast<float>(cappedDistance / 100.0f); //convert to meter from resolution 1 cm
-                                                 break;
-                    case CompactPointCloud::MM : distance = static_cast<float>(cappedDistance / 500.0f); //convert to meter from resolution 2 mm
-                                                 break;
-                }
-                if (distance > 1.0f) {//Only viualize the point when the distance is larger than 1m
-                    // Compute x, y, z coordinate based on distance, azimuth, and vertical angle
-                    float xyDistance = distance * cos(verticalAngle * static_cast<float>(cartesian::Constants::DEG2RAD));
-                    float xData = xyDistance * sin(azimuth * static_cast<float>(cartesian::Constants::DEG2RAD));
-                    float yData = xyDistance * cos(azimuth * static_cast<float>(cartesian::Constants::DEG2RAD));
-                    float zData = distance * sin(verticalAngle * static_cast<float>(cartesian::Constants::DEG2RAD));
-                    
-                    //The number of intensity levels depends on number of bits for intensity. There are 2^n intensity levels for n bits
-                    float intensityLevel = intensity / intensityMaxValue;
-                    //Four color levels: blue, green, yellow, red from low intensity to high intensity
-                    if (intensityLevel < 0.25f + 1e-7) {
-                        glColor3f(0.0f, 0.5f + intensityLevel * 2.0f, 1.0f);
-                    } else if (intensityLevel > 0.25f && intensityLevel < 0.5f + 1e-7) {
-                        glColor3f(0.0f, 0.5f + intensityLevel * 2.0f, 0.5f);
-                    } else if (intensityLevel > 0.5f && intensityLevel < 0.75f + 1e-7) {
-                        glColor3f(1.0f, 0.75f + intensityLevel, 0.0f);
-                    } else {
-                        glColor3f(0.55f + intensityLevel, 0.0f, 0.0f);
-                    } 
-                    glVertex3f(xData, yData, zData);//Plot the point 
-                }
-            }
-            
-            void EnvironmentViewerGLWidget::drawCPC32noIntensity(const uint8_t &part, const uint8_t &entriesPerAzimuth, const float &startAzimuth, const float &endAzimuth, const uint8_t &distanceEncoding) {
-                float azimuth = startAzimuth;
-                uint32_t numberOfPoints;
-                stringstream sstr;
-                if (part == 1) {
-                    numberOfPoints = m_12_cpcDistance_32.size() / 2;
-                    sstr.str(m_12_cpcDistance_32);
-                } else if (part == 2) {
-                    numberOfPoints = m_11_cpcDistance_32.size() / 2;
-                    sstr.str(m_11_cpcDistance_32);
-                } else {
-                    numberOfPoints = m_9_cpcDistance_32.size() / 2;
-                    sstr.str(m_9_cpcDistance_32);
-                }
-                uint32_t numberOfAzimuths = numberOfPoints / entriesPerAzimuth;
-                float azimuthIncrement = (endAzimuth - startAzimuth) / numberOfAzimuths;//Calculate the azimuth increment
-                uint16_t distance = 0;
-
-                for (uint32_t azimuthIndex = 0; azimuthIndex < numberOfAzimuths; azimuthIndex++) {
-                    for (uint8_t sensorIndex = 0; sensorIndex < entriesPerAzimuth; sensorIndex++) {
-                        sstr.read((char*)(&distance), 2); // Read distance value from the string in a CPC container point by point
-                        if (part == 1) {
-                            drawOneCPCPointNoIntensity(distance, azimuth, m_12_verticalAngles[sensorIndex], distanceEncoding);
-                        } else if (part == 2) {
-                            drawOneCPCPointNoIntensity(distance, azimuth, m_11_verticalAngles[sensorIndex], distanceEncoding);
-                        } else {
-                            drawOneCPCPointNoIntensity(distance, azimuth, m_9_verticalAngles[sensorIndex], distanceEncoding);
-                        }
-                    }
-                    azimuth += azimuthIncrement;
-                }
-            }
-            
-            void EnvironmentViewerGLWidget::drawCPC32withIntensity(const uint8_t &part, const uint8_t &entriesPerAzimuth, const float &startAzimuth, const float &endAzimuth, const uint8_t &distanceEncoding, const uint8_t &numberOfBitsForIntensity, const uint8_t &intensityPlacement, const uint16_t &_mask, const float &intensityMaxValue) {
-                float azimuth = startAzimuth;
-                uint32_t numberOfPoints;
-                stringstream sstr;
-                if (part == 1) {
-                    numberOfPoints = m_12_cpcDistance_32.size() / 2;
-                    sstr.str(m_12_cpcDistance_32);
-                } else if (part == 2) {
-                    numberOfPoints = m_11_cpcDistance_32.size() / 2;
-                    sstr.str(m_11_cpcDistance_32);
-                } else {
-                    numberOfPoints = m_9_cpcDistance_32.size() / 2;
-                    sstr.str(m_9_cpcDistance_32);
-                }
-                uint32_t numberOfAzimuths = numberOfPoints / entriesPerAzimuth;
-                float azimuthIncrement = (endAzimuth - startAzimuth) / numberOfAzimuths;//Calculate the azimuth increment
-                uint16_t distance = 0;
-
-                for (uint32_t azimuthIndex = 0; azimuthIndex < numberOfAzimuths; azimuthIndex++) {
-                    for (uint8_t sensorIndex = 0; sensorIndex < entriesPerAzimuth; sensorIndex++) {
-                        sstr.read((char*)(&distance), 2); // Read distance value from the string in a CPC container point by point
-                        if (part == 1) {
-                            drawOneCPCPointWithIntensity(distance, azimuth, m_12_verticalAngles[sensorIndex], distanceEncoding, numberOfBitsForIntensity, intensityPlacement, _mask, intensityMaxValue);
-                        } else if (part == 2) {
-                            drawOneCPCPointWithIntensity(distance, azimuth, m_11_verticalAngles[sensorIndex], distanceEncoding, numberOfBitsForIntensity, intensityPlacement, _mask, intensityMaxValue);
-                        } else {
-                            drawOneCPCPointWithIntensity(distance, azimuth, m_9_verticalAngles[sensorIndex], distanceEncoding, numberOfBitsForIntensity, intensityPlacement, _mask, intensityMaxValue);
-                        }
-                    }
-                    azimuth += azimuthIncrement;
-                }
-            }
-
             void EnvironmentViewerGLWidget::drawSceneInternal() {
                 m_root->render(m_renderingConfiguration);
 
-                // Draw scene. Retrieve the point cloud from the shared memory and visualize it frame by frame when shared point cloud is received via the nextContainer method
-                if (m_velodyneSharedMemory.get() != NULL) {
-                    if (m_velodyneSharedMemory->isValid()) {
-                        // Using a scoped lock to lock and automatically unlock a shared memory segment.
-                        odcore::base::Lock lv(m_velodyneSharedMemory);
-                        if (m_velodyneFrame.getComponentDataType() == SharedPointCloud::FLOAT_T
-                            && (m_velodyneFrame.getNumberOfComponentsPerPoint() == 4)) {
-                            glPushMatrix();
-                            {
-                                // Translate the model.
-                                glTranslated(m_egoState.getPosition().getX(), m_egoState.getPosition().getY(), 0);
-
-                                // Rotate the model using DEG (m_rotation is in RAD!).
-                                glRotated(/*m_egoState.getRotation().getX()*180.0 / cartesian::Constants::PI*/0, 1, 0, 0);
-                                glRotated(/*m_egoState.getRotation().getY()*180.0 / cartesian::Constants::PI*/0, 0, 1, 0);
-                                // Rotate around z-axis and turn by 10 DEG.
-                                glRotated(/*m_egoState.getRotation().getZ()*/ (m_egoState.getRotation().getAngleXY() + M_PI/2.0)*180.0 / cartesian::Constants::PI + 13.0, 0, 0, 1);
-
-                                float *velodyneRawData = static_cast<float*>(m_velodyneSharedMemory->getSharedMemory());
-                                glPointSize(1.0f); //set point size to 1 pixel
-                                glBegin(GL_POINTS); //starts drawing of points
-                                {
-                                    if (m_velodyneFrame.getUserInfo() == SharedPointCloud::POLAR_INTENSITY) {
-                                        //Point color depends on the intensity value.
-                                        uint32_t startID = 0;
-                                        for (uint32_t counter = 0; counter < m_velodyneFrame.getWidth(); counter++) {
-                                            float intensityLevel = velodyneRawData[startID + 3] / 256;  //Normalize intensity to fit the range from 0 to 1
-                                            //Four color levels: blue, green, yellow, red from low intensity to high intensity
-                                            if (intensityLevel < 0.25f + 1e-7) {
-                                                glColor3f(0.0f, 0.5f + intensityLevel * 2.0f, 1.0f);
-                                            } else if (intensityLevel > 0.25f && intensityLevel < 0.5f + 1e-7) {
-                                                glColor3f(0.0f, 0.5f + intensityLevel * 2.0f, 0.5f);
-                                            } else if (intensityLevel > 0.5f && intensityLevel < 0.75f + 1e-7) {
-                                                glColor3f(1.0f, 0.75f + intensityLevel, 0.0f);
-                                            } else{
-                                                glColor3f(0.55f + intensityLevel, 0.0f, 0.0f);
-                                            }
-                                            float xyDistance = 0.0f, xData = 0.0f, yData = 0.0f, zData = 0.0f;
-                                            xyDistance = velodyneRawData[startID] * cos(velodyneRawData[startID + 2] * static_cast<float>(cartesian::Constants::DEG2RAD));
-                                            xData = xyDistance * sin(velodyneRawData[startID + 1] * static_cast<float>(cartesian::Constants::DEG2RAD));
-                                            yData = xyDistance * cos(velodyneRawData[startID + 1] * static_cast<float>(cartesian::Constants::DEG2RAD));
-                                            zData = velodyneRawData[startID] * sin(velodyneRawData[startID + 2] * static_cast<float>(cartesian::Constants::DEG2RAD));
-                                            glVertex3f(xData, yData, zData);
-                                            startID += m_velodyneFrame.getNumberOfComponentsPerPoint();
-                                        }
-                                    } else {//XYZ_INTENSITY instead of POLAR_INTENSITY
-                                        //Point color depends on the intensity value.
-                                        uint32_t startID = 0;
-                                        for (uint32_t counter = 0; counter < m_velodyneFrame.getWidth(); counter++) {
-                                            float intensityLevel = velodyneRawData[startID + 3] / 256;  //Normalize intensity to fit the range from 0 to 1
-                                            //Four color levels: blue, green, yellow, red from low intensity to high intensity
-                                            if (intensityLevel < 0.25f + 1e-7) {
-                                                glColor3f(0.0f, 0.5f + intensityLevel * 2.0f, 1.0f);
-                                            } else if (intensityLevel > 0.25f && intensityLevel < 0.5f + 1e-7) {
-                                                glColor3f(0.0f, 0.5f + intensityLevel * 2.0f, 0.5f);
-                                            } else if (intensityLevel > 0.5f && intensityLevel < 0.75f + 1e-7) {
-                                                glColor3f(1.0f, 0.75f + intensityLevel, 0.0f);
-                                            } else{
-                                                glColor3f(0.55f + intensityLevel, 0.0f, 0.0f);
-                                            }
-                                            glVertex3f(velodyneRawData[startID], velodyneRawData[startID + 1], velodyneRawData[startID+2]);
-                                            startID += m_velodyneFrame.getNumberOfComponentsPerPoint();
-                                        }
-                                    }
-                                }
-                                glEnd();//end drawing of points
-                            }
+                // Draw the most recent shared or compact point cloud that was converted in the nextContainer method.
+                if (m_SPCReceived || m_CPCReceived) {
+                    glPushMatrix();
+                    {
+                        // Translate the model.
+                        glTranslated(m_egoState.getPosition().getX(), m_egoState.getPosition().getY(), 0);
 
-                            glPopMatrix();
-                        }
-                    }
-                }
+                        // Rotate the model using DEG (m_rotation is in RAD!).
+                        glRotated(/*m_egoState.getRotation().getX()*180.0 / cartesian::Constants::PI*/0, 1, 0, 0);
+                        glRotated(/*m_egoState.getRotation().getY()*180.0 / cartesian::Constants::PI*/0, 0, 1, 0);
+                        // Rotate around z-axis and turn by 10 DEG.
+                        glRotated(/*m_egoState.getRotation().getZ()*/ (m_egoState.getRotation().getAngleXY() + M_PI/2.0)*180.0 / cartesian::Constants::PI + 13.0, 0, 0, 1);
 
-                /** Visualize compact point cloud, where points are sorted by increasing azimuth
-                 and vertical angle (VLP-16: from -15 to 15 with increment 2 for each 16 points;
-                 HDL-32E: from -30.67 to 10.67 degrees, with alternating increment 1.33 and 1.34).
-                 A compact point cloud contains: (1) the starting azimuth, (2) the ending azimuth,
-                 (3) number of points per azimuth, and (4) a string with the distance values of all
-                 points in the container */
-                if (m_CPCReceived && !m_SPCReceived) {
-                    Lock lockCPC(m_cpcMutex);
-                    const float startAzimuth = m_cpc.getStartAzimuth();
-                    const float endAzimuth = m_cpc.getEndAzimuth();
-                    const uint8_t entriesPerAzimuth = m_cpc.getEntriesPerAzimuth();
-                    const uint8_t numberOfBitsForIntensity = m_cpc.getNumberOfBitsForIntensity();
-                    const uint8_t intensityPlacement = m_cpc.getIntensityPlacement();
-                    uint16_t tmpMask = 0xFFFF;
-                    float intensityMaxValue = 0.0f;
-                    if (numberOfBitsForIntensity > 0) {
-                        if (intensityPlacement == 0) {
-                            tmpMask = tmpMask >> numberOfBitsForIntensity; //higher bits for intensity
-                        } else {
-                            tmpMask = tmpMask << numberOfBitsForIntensity; //lower bits for intensity
-                        }
-                        intensityMaxValue = pow(2.0f, static_cast<float>(numberOfBitsForIntensity)) - 1.0f;
-                    }
-                    const uint8_t distanceEncoding = m_cpc.getDistanceEncoding();
-                    
-                    glPushMatrix();
-                    // Translate the model.
-                    glTranslated(m_egoState.getPosition().getX(), m_egoState.getPosition().getY(), 0);
-
-                    // Rotate the model using DEG (m_rotation is in RAD!).
-                    glRotated(/*m_egoState.getRotation().getX()*180.0 / cartesian::Constants::PI*/0, 1, 0, 0);
-                    glRotated(/*m_egoState.getRotation().getY()*180.0 / cartesian::Constants::PI*/0, 0, 1, 0);
-                    // Rotate around z-axis and turn by 10 DEG.
-                    glRotated(/*m_egoState.getRotation().getZ()*/ (m_egoState.getRotation().getAngleXY() + M_PI/2.0)*180.0 / cartesian::Constants::PI + 13.0, 0, 0, 1);
-                    
-                    glPointSize(1.0f); //set point size to 1 pixel
-
-                    glBegin(GL_POINTS); //starts drawing of points
-                    glColor3f(1.0f, 1.0f, 0.0);//Yellow color
-
-                    uint16_t distance_integer = 0;
-                    if (entriesPerAzimuth == 16) {//A VLP-16 CPC
-                        float azimuth = startAzimuth;
-                        const string distances = m_cpc.getDistances();
-                        const uint32_t numberOfPoints = distances.size() / 2;
-                        const uint32_t numberOfAzimuths = numberOfPoints / entriesPerAzimuth;
-                        const float azimuthIncrement = (endAzimuth - startAzimuth) / numberOfAzimuths;//Calculate the azimuth increment
-                        stringstream sstr(distances);
-                        
-                        for (uint32_t azimuthIndex = 0; azimuthIndex < numberOfAzimuths; azimuthIndex++) {
-                            float verticalAngle = START_V_ANGLE;
-                            for (uint8_t sensorIndex = 0; sensorIndex < entriesPerAzimuth; sensorIndex++) {
-                                sstr.read((char*)(&distance_integer), 2); // Read distance value from the string in a CPC container point by point
-                                if (numberOfBitsForIntensity == 0) {
-                                    drawOneCPCPointNoIntensity(distance_integer, azimuth, verticalAngle, distanceEncoding);
-                                } else {
-                                    drawOneCPCPointWithIntensity(distance_integer, azimuth, verticalAngle, distanceEncoding, numberOfBitsForIntensity, intensityPlacement, tmpMask, intensityMaxValue);
-                                }
-                                verticalAngle += V_INCREMENT;
-                            }
-                            azimuth += azimuthIncrement;
-                        }
-                    } else {//A HDL-32E CPC, one of the three parts of a complete scan
-                        if ((m_cpcMask_32 & 0x04) > 0) {//The first part, 12 layers
-                            if (numberOfBitsForIntensity == 0) {
-                                drawCPC32noIntensity(1, entriesPerAzimuth, startAzimuth, endAzimuth, distanceEncoding);
-                            } else {
-                            drawCPC32withIntensity(1, entriesPerAzimuth, startAzimuth, endAzimuth, distanceEncoding, numberOfBitsForIntensity, intensityPlacement, tmpMask, intensityMaxValue);
-                            }
-                        }
-                        if ((m_cpcMask_32 & 0x02) > 0) {//The second part, 11 layers
-                            if (numberOfBitsForIntensity == 0) {
-                                drawCPC32noIntensity(2, entriesPerAzimuth, startAzimuth, endAzimuth, distanceEncoding);
-                            } else {
-                            drawCPC32withIntensity(2, entriesPerAzimuth, startAzimuth, endAzimuth, distanceEncoding, numberOfBitsForIntensity, intensityPlacement, tmpMask, intensityMaxValue);
-                            }
-                        }
-                        if ((m_cpcMask_32 & 0x01) > 0) {//The third part, 9 layers
-                            if (numberOfBitsForIntensity == 0) {
-                                drawCPC32noIntensity(3, entriesPerAzimuth, startAzimuth, endAzimuth, distanceEncoding);
-                            } else {
-                            drawCPC32withIntensity(3, entriesPerAzimuth, startAzimuth, endAzimuth, distanceEncoding, numberOfBitsForIntensity, intensityPlacement, tmpMask, intensityMaxValue);
-                            }
-                        }
+                        glPointSize(1.0f); //set point size to 1 pixel
+                        m_pointCloudRenderer.render();
                     }
-
-                    glEnd(); //end drawing of points
-                    glPopMatrix(); 
+                    glPopMatrix();
                 }
             }
 
@@ -787,6 +469,8 @@ namespace cockpit {
                         m_velodyneSharedMemory=SharedMemoryFactory::attachToSharedMemory(m_velodyneFrame.getName()); // Attach the shared point cloud to the shared memory.
                         m_hasAttachedToSharedImageMemory = true; 
                     }  
+                    // Copy and convert the point cloud here to not block the shared memory while rendering.
+                    m_pointCloudRenderer.update(m_velodyneSharedMemory, m_velodyneFrame);
                 }
                 
                 if(c.getDataType() == odcore::data::CompactPointCloud::ID()){
@@ -794,32 +478,30 @@ namespace cockpit {
                     TimeStamp ts = c.getSampleTimeStamp();
                     m_recordingYear = ts.getYear();
                     if (!m_SPCReceived) {
-                        Lock lockCPC(m_cpcMutex);
-                        m_cpc = c.getData<CompactPointCloud>();  
-                        uint8_t numberOfLayers = m_cpc.getEntriesPerAzimuth();
+                        /** Visualize compact point cloud, where points are sorted by increasing azimuth
+                         and vertical angle (VLP-16: from -15 to 15 with increment 2 for each 16 points;
+                         HDL-32E: from -30.67 to 10.67 degrees, with alternating increment 1.33 and 1.34).
+                         A compact point cloud contains: (1) the starting azimuth, (2) the ending azimuth,
+                         (3) number of points per azimuth, and (4) a string with the distance values of all
+                         points in the container */
+                        CompactPointCloud cpc = c.getData<CompactPointCloud>();
                         //Currently odcockpit supports the visualization of SPC for Velodyne 16/32/64 and the visualization of CPC for Velodyne 16/32.
-                        //If a CPC does not contain 16 layers, it is assumed to be a HDL-32E CPC
-                        if (numberOfLayers != 16) {
+                        //If a CPC does not contain 16 layers, it is assumed to be one of the three parts of a HDL-32E scan
+                        bool isNewScan = true;
+                        if (cpc.getEntriesPerAzimuth() != 16) {
                             const uint64_t currentTime = ts.toMicroseconds();
                             //Check if this HDL-32E CPC comes from a new scan. The interval between two scans is roughly 100ms. It is safe to assume that a new CPC comes from a new scan if the interval is longer than 50ms
                             const uint64_t deltaTime = (currentTime > m_previousCPC32TimeStamp) ? (currentTime - m_previousCPC32TimeStamp) : (m_previousCPC32TimeStamp - currentTime);
-                            if (deltaTime > 50000) {
-                                m_cpcMask_32 = 0;//Reset the mask that represents which HDL-32E CPC part has arrived
-                            }
+                            isNewScan = (deltaTime > 50000);
                             m_previousCPC32TimeStamp = currentTime;
-                            if (numberOfLayers == 12) {
-                                m_cpcMask_32 = m_cpcMask_32 | 0x04;
-                                m_12_cpcDistance_32 = m_cpc.getDistances();
-                            }
-                            if (numberOfLayers == 11) {
-                                m_cpcMask_32 = m_cpcMask_32 | 0x02;
-                                m_11_cpcDistance_32 = m_cpc.getDistances();
-                            }
-                            if (numberOfLayers == 9) {
-                                m_cpcMask_32 = m_cpcMask_32 | 0x01;
-                                m_9_cpcDistance_32 = m_cpc.getDistances();
-                            }
                         }
+                        if (isNewScan) {
+                            m_cpcPoints.clear();
+                        }
+                        //Recordings before 2017 do not call hton() while storing CPC.
+                        //Hence, we only call ntoh() for recordings from 2017.
+                        m_cpcDecoder.decode(cpc, m_cpcPoints, (m_recordingYear > 2016));
+                        m_pointCloudRenderer.update(m_cpcPoints, (cpc.getNumberOfBitsForIntensity() > 0));
                     }
                 }
                 
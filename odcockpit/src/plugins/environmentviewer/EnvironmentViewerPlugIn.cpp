@@ -18,7 +18,16 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
+#include <vector>
+
 #include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/generated/odcore/data/CompactPointCloud.h"
+#include "opendavinci/generated/odcore/data/SharedPointCloud.h"
+#include "opendlv/data/environment/EgoState.h"
+#include "opendlv/data/environment/Line.h"
+#include "opendlv/data/environment/Obstacle.h"
+#include "opendlv/data/planning/Route.h"
+#include "opendlv/data/sensor/ContouredObjects.h"
 #include "ContainerObserver.h"
 #include "plugins/environmentviewer/EnvironmentViewerPlugIn.h"
 #include "plugins/environmentviewer/EnvironmentViewerWidget.h"
@@ -30,6 +39,7 @@ namespace cockpit {
     namespace plugins {
         namespace environmentviewer {
 
+            using namespace std;
             using namespace odcore::base;
 
             EnvironmentViewerPlugIn::EnvironmentViewerPlugIn(const string &name, const KeyValueConfiguration &kvc, QWidget* prnt) :
@@ -46,7 +56,22 @@ namespace cockpit {
 
                 cockpit::ContainerObserver *co = getContainerObserver();
                 if (co != NULL) {
-                    co->addContainerListener(m_widget);
+                    // Only the most recent states are displayed.
+                    vector<int32_t> latestValues;
+                    latestValues.push_back(odcore::data::SharedPointCloud::ID());
+                    latestValues.push_back(opendlv::data::environment::EgoState::ID());
+                    latestValues.push_back(opendlv::data::sensor::ContouredObjects::ID());
+                    latestValues.push_back(opendlv::data::planning::Route::ID());
+                    co->addContainerListener(m_widget, latestValues, ContainerObserver::LATEST_VALUE, 1);
+
+                    // A scan of an HDL-32E is sent in three parts.
+                    co->addContainerListener(m_widget, vector<int32_t>(1, odcore::data::CompactPointCloud::ID()), ContainerObserver::BOUNDED_HISTORY, 3);
+
+                    // Lines and obstacles modify the scene incrementally.
+                    vector<int32_t> events;
+                    events.push_back(opendlv::data::environment::Line::ID());
+                    events.push_back(opendlv::data::environment::Obstacle::ID());
+                    co->addContainerListener(m_widget, events, ContainerObserver::BOUNDED_HISTORY, 100);
                 }
             }
 
@@ -0,0 +1,323 @@
+/**
+ * cockpit - Visualization environment
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifdef __APPLE__
+    #include <OpenGL/gl.h>
+#else
+    #include <GL/gl.h>
+#endif
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Lock.h"
+#include "opendavinci/odcore/wrapper/Eigen.h"
+#include "opendavinci/odcore/wrapper/SharedMemory.h"
+#include "opendavinci/generated/odcore/data/SharedPointCloud.h"
+#include "plugins/environmentviewer/PointCloudRenderer.h"
+
+namespace cockpit {
+    namespace plugins {
+        namespace environmentviewer {
+
+            using namespace std;
+            using namespace odcore::base;
+            using namespace odcore::data;
+
+            namespace {
+                // Resolution of the trigonometric lookup table: 0.01 DEG.
+                const uint32_t TRIGONOMETRIC_TABLE_STEPS_PER_DEG = 100;
+                const uint32_t TRIGONOMETRIC_TABLE_SIZE = 360 * TRIGONOMETRIC_TABLE_STEPS_PER_DEG;
+
+                struct TrigonometricTable {
+                    TrigonometricTable() :
+                        m_sin(TRIGONOMETRIC_TABLE_SIZE),
+                        m_cos(TRIGONOMETRIC_TABLE_SIZE) {
+                        for (uint32_t i = 0; i < TRIGONOMETRIC_TABLE_SIZE; i++) {
+                            const double angle = (static_cast<double>(i) / TRIGONOMETRIC_TABLE_STEPS_PER_DEG) * M_PI / 180.0;
+                            m_sin[i] = static_cast<float>(sin(angle));
+                            m_cos[i] = static_cast<float>(cos(angle));
+                        }
+                    }
+
+                    vector<float> m_sin;
+                    vector<float> m_cos;
+                };
+
+                const TrigonometricTable& getTrigonometricTable() {
+                    static const TrigonometricTable TABLE;
+                    return TABLE;
+                }
+
+                inline uint32_t getTrigonometricTableIndex(const float &angleInDEG) {
+                    int32_t index = static_cast<int32_t>(lround(angleInDEG * TRIGONOMETRIC_TABLE_STEPS_PER_DEG)) % static_cast<int32_t>(TRIGONOMETRIC_TABLE_SIZE);
+                    if (index < 0) {
+                        index += TRIGONOMETRIC_TABLE_SIZE;
+                    }
+                    return static_cast<uint32_t>(index);
+                }
+
+                // Colors for the intensities 0..255.
+                struct ColorMap {
+                    ColorMap() :
+                        m_colors(256 * 4) {
+                        for (uint32_t i = 0; i < 256; i++) {
+                            const float intensityLevel = i / 256.0f;
+                            float r = 0.0f, g = 0.0f, b = 0.0f;
+                            //Four color levels: blue, green, yellow, red from low intensity to high intensity
+                            if (intensityLevel < 0.25f + 1e-7) {
+                                r = 0.0f; g = 0.5f + intensityLevel * 2.0f; b = 1.0f;
+                            } else if (intensityLevel > 0.25f && intensityLevel < 0.5f + 1e-7) {
+                                r = 0.0f; g = 0.5f + intensityLevel * 2.0f; b = 0.5f;
+                            } else if (intensityLevel > 0.5f && intensityLevel < 0.75f + 1e-7) {
+                                r = 1.0f; g = 0.75f + intensityLevel; b = 0.0f;
+                            } else{
+                                r = 0.55f + intensityLevel; g = 0.0f; b = 0.0f;
+                            }
+                            m_colors[i * 4 + 0] = static_cast<uint8_t>(std::min(r, 1.0f) * 255.0f);
+                            m_colors[i * 4 + 1] = static_cast<uint8_t>(std::min(g, 1.0f) * 255.0f);
+                            m_colors[i * 4 + 2] = static_cast<uint8_t>(std::min(b, 1.0f) * 255.0f);
+                            m_colors[i * 4 + 3] = 255;
+                        }
+                    }
+
+                    vector<uint8_t> m_colors;
+                };
+
+                const ColorMap& getColorMap() {
+                    static const ColorMap COLORMAP;
+                    return COLORMAP;
+                }
+            }
+
+            PointCloudRenderer::PointCloudRenderer() :
+                m_rawPoints(),
+                m_distances(),
+                m_sinAzimuths(),
+                m_cosAzimuths(),
+                m_sinVerticalAngles(),
+                m_cosVerticalAngles(),
+                m_x(),
+                m_y(),
+                m_z(),
+                m_vertices(),
+                m_nextVerticesMutex(),
+                m_nextVertices(),
+                m_hasNextVertices(false),
+                m_vertexBuffer(QGLBuffer::VertexBuffer),
+                m_isVertexBufferCreated(false),
+                m_useVertexBuffer(true),
+                m_renderedVertices(),
+                m_numberOfRenderedVertices(0) {}
+
+            PointCloudRenderer::~PointCloudRenderer() {}
+
+            void PointCloudRenderer::update(std::shared_ptr<odcore::wrapper::SharedMemory> sharedMemory, const SharedPointCloud &spc) {
+                if ( (sharedMemory.get() == NULL) || (!sharedMemory->isValid()) ) {
+                    return;
+                }
+                if ( (spc.getComponentDataType() != SharedPointCloud::FLOAT_T)
+                  || (spc.getNumberOfComponentsPerPoint() != 4) ) {
+                    return;
+                }
+
+                const uint32_t NUMBER_OF_COMPONENTS = 4;
+                uint32_t numberOfPoints = 0;
+                {
+                    // Copy the points at once to release the shared memory as early as possible.
+                    Lock lv(sharedMemory);
+                    numberOfPoints = std::min(spc.getWidth(), static_cast<uint32_t>(sharedMemory->getSize() / (NUMBER_OF_COMPONENTS * sizeof(float))));
+                    m_rawPoints.resize(numberOfPoints * NUMBER_OF_COMPONENTS);
+                    if (numberOfPoints > 0) {
+                        memcpy(&m_rawPoints[0], sharedMemory->getSharedMemory(), numberOfPoints * NUMBER_OF_COMPONENTS * sizeof(float));
+                    }
+                }
+
+                m_vertices.resize(numberOfPoints);
+                if (numberOfPoints > 0) {
+                    if (spc.getUserInfo() == SharedPointCloud::POLAR_INTENSITY) {
+                        convertPolarPoints(numberOfPoints);
+                    }
+                    else {
+                        convertCartesianPoints(numberOfPoints);
+                    }
+                    setColors(numberOfPoints);
+                }
+
+                swapVertices();
+            }
+
+            void PointCloudRenderer::update(const odcore::data::CompactPointCloudDecoder::PointBuffer &points, const bool &hasIntensity) {
+                const uint8_t *COLORS = &(getColorMap().m_colors[0]);
+                const uint8_t YELLOW[4] = { 255, 255, 0, 255 };
+
+                const uint32_t NUMBER_OF_POINTS = points.size();
+                m_vertices.resize(NUMBER_OF_POINTS);
+                for (uint32_t i = 0; i < NUMBER_OF_POINTS; i++) {
+                    m_vertices[i].m_x = points.m_x[i];
+                    m_vertices[i].m_y = points.m_y[i];
+                    m_vertices[i].m_z = points.m_z[i];
+                    if (hasIntensity) {
+                        // Intensities are normalized to [0, 1].
+                        const int32_t INTENSITY = std::max(0, std::min(255, static_cast<int32_t>(points.m_intensity[i] * 256.0f)));
+                        memcpy(m_vertices[i].m_color, COLORS + INTENSITY * 4, 4);
+                    }
+                    else {
+                        memcpy(m_vertices[i].m_color, YELLOW, 4);
+                    }
+                }
+
+                swapVertices();
+            }
+
+            void PointCloudRenderer::swapVertices() {
+                Lock l(m_nextVerticesMutex);
+                m_nextVertices.swap(m_vertices);
+                m_hasNextVertices = true;
+            }
+
+            void PointCloudRenderer::convertPolarPoints(const uint32_t &numberOfPoints) {
+                const TrigonometricTable &TABLE = getTrigonometricTable();
+
+                m_distances.resize(numberOfPoints);
+                m_sinAzimuths.resize(numberOfPoints);
+                m_cosAzimuths.resize(numberOfPoints);
+                m_sinVerticalAngles.resize(numberOfPoints);
+                m_cosVerticalAngles.resize(numberOfPoints);
+                m_x.resize(numberOfPoints);
+                m_y.resize(numberOfPoints);
+                m_z.resize(numberOfPoints);
+
+                // Gather distances and angles into separate arrays.
+                const float *point = &m_rawPoints[0];
+                for (uint32_t i = 0; i < numberOfPoints; i++, point += 4) {
+                    const uint32_t AZIMUTH = getTrigonometricTableIndex(point[1]);
+                    const uint32_t VERTICAL_ANGLE = getTrigonometricTableIndex(point[2]);
+                    m_distances[i] = point[0];
+                    m_sinAzimuths[i] = TABLE.m_sin[AZIMUTH];
+                    m_cosAzimuths[i] = TABLE.m_cos[AZIMUTH];
+                    m_sinVerticalAngles[i] = TABLE.m_sin[VERTICAL_ANGLE];
+                    m_cosVerticalAngles[i] = TABLE.m_cos[VERTICAL_ANGLE];
+                }
+
+                // Vectorized conversion to Cartesian coordinates.
+                Map<ArrayXf> distance(&m_distances[0], numberOfPoints);
+                Map<ArrayXf> sinAzimuth(&m_sinAzimuths[0], numberOfPoints);
+                Map<ArrayXf> cosAzimuth(&m_cosAzimuths[0], numberOfPoints);
+                Map<ArrayXf> sinVerticalAngle(&m_sinVerticalAngles[0], numberOfPoints);
+                Map<ArrayXf> cosVerticalAngle(&m_cosVerticalAngles[0], numberOfPoints);
+                Map<ArrayXf> x(&m_x[0], numberOfPoints);
+                Map<ArrayXf> y(&m_y[0], numberOfPoints);
+                Map<ArrayXf> z(&m_z[0], numberOfPoints);
+
+                // Reuse the cosine of the vertical angle for the distance in the xy-plane.
+                cosVerticalAngle *= distance;
+                x = cosVerticalAngle * sinAzimuth;
+                y = cosVerticalAngle * cosAzimuth;
+                z = distance * sinVerticalAngle;
+
+                for (uint32_t i = 0; i < numberOfPoints; i++) {
+                    m_vertices[i].m_x = m_x[i];
+                    m_vertices[i].m_y = m_y[i];
+                    m_vertices[i].m_z = m_z[i];
+                }
+            }
+
+            void PointCloudRenderer::convertCartesianPoints(const uint32_t &numberOfPoints) {
+                const float *point = &m_rawPoints[0];
+                for (uint32_t i = 0; i < numberOfPoints; i++, point += 4) {
+                    m_vertices[i].m_x = point[0];
+                    m_vertices[i].m_y = point[1];
+                    m_vertices[i].m_z = point[2];
+                }
+            }
+
+            void PointCloudRenderer::setColors(const uint32_t &numberOfPoints) {
+                const uint8_t *COLORS = &(getColorMap().m_colors[0]);
+                const float *point = &m_rawPoints[0];
+                for (uint32_t i = 0; i < numberOfPoints; i++, point += 4) {
+                    const int32_t INTENSITY = std::max(0, std::min(255, static_cast<int32_t>(point[3])));
+                    memcpy(m_vertices[i].m_color, COLORS + INTENSITY * 4, 4);
+                }
+            }
+
+            void PointCloudRenderer::render() {
+                bool hasNewVertices = false;
+                {
+                    Lock l(m_nextVerticesMutex);
+                    if (m_hasNextVertices) {
+                        m_renderedVertices.swap(m_nextVertices);
+                        m_hasNextVertices = false;
+                        hasNewVertices = true;
+                    }
+                }
+
+                if (m_useVertexBuffer && !m_isVertexBufferCreated) {
+                    m_isVertexBufferCreated = m_vertexBuffer.create();
+                    if (m_isVertexBufferCreated) {
+                        m_vertexBuffer.setUsagePattern(QGLBuffer::StreamDraw);
+                    }
+                    else {
+                        // Fall back to client side vertex arrays.
+                        m_useVertexBuffer = false;
+                    }
+                }
+
+                if (hasNewVertices) {
+                    m_numberOfRenderedVertices = m_renderedVertices.size();
+                    if (m_useVertexBuffer) {
+                        m_vertexBuffer.bind();
+                        m_vertexBuffer.allocate((m_numberOfRenderedVertices > 0) ? &m_renderedVertices[0] : NULL, m_numberOfRenderedVertices * sizeof(Vertex));
+                        m_vertexBuffer.release();
+                    }
+                }
+
+                if (m_numberOfRenderedVertices == 0) {
+                    return;
+                }
+
+                const uint8_t *base = NULL;
+                if (m_useVertexBuffer) {
+                    m_vertexBuffer.bind();
+                }
+                else {
+                    base = reinterpret_cast<const uint8_t*>(&m_renderedVertices[0]);
+                }
+
+                glEnableClientState(GL_VERTEX_ARRAY);
+                glEnableClientState(GL_COLOR_ARRAY);
+                glVertexPointer(3, GL_FLOAT, sizeof(Vertex), base + offsetof(Vertex, m_x));
+                glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), base + offsetof(Vertex, m_color));
+                glDrawArrays(GL_POINTS, 0, m_numberOfRenderedVertices);
+                glDisableClientState(GL_COLOR_ARRAY);
+                glDisableClientState(GL_VERTEX_ARRAY);
+
+                if (m_useVertexBuffer) {
+                    m_vertexBuffer.release();
+                }
+            }
+
+        }
+    }
+} // plugins::environmentviewer
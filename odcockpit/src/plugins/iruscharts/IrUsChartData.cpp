@@ -18,7 +18,6 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
-#include "automotivedata/generated/automotive/miniature/SensorBoardData.h"
 #include "plugins/iruscharts/IrUsChartData.h"
 
 namespace cockpit {
@@ -29,28 +28,36 @@ namespace cockpit {
 
             using namespace std;
 
-            IrUsChartData::IrUsChartData(deque<automotive::miniature::SensorBoardData> &data, const uint32_t &dataSelection) :
+            IrUsChartData::IrUsChartData() :
                 QwtData(),
-                m_data(data),
-                m_dataSelection(dataSelection) {}
+                m_x(),
+                m_y() {}
+
+            IrUsChartData::IrUsChartData(const IrUsChartData &obj) :
+                QwtData(),
+                m_x(obj.m_x),
+                m_y(obj.m_y) {}
 
             IrUsChartData::~IrUsChartData() {}
 
+            void IrUsChartData::update(const TimeSeries &timeSeries, const uint32_t &window, const uint32_t &maxPoints) {
+                timeSeries.getView(window, maxPoints, m_x, m_y);
+            }
+
             QwtData* IrUsChartData::copy() const {
-                return new IrUsChartData(m_data, m_dataSelection);
+                return new IrUsChartData(*this);
             }
 
             size_t IrUsChartData::size() const {
-                return m_data.size();
+                return m_x.size();
             }
 
             double IrUsChartData::x(size_t i) const {
-                return (double)i;
+                return m_x.at(i);
             }
 
             double IrUsChartData::y(size_t i) const {
-                double value = m_data.at(i).getValueForKey_MapOfDistances(m_dataSelection);
-                return value;
+                return m_y.at(i);
             }
 
         }
@@ -19,6 +19,7 @@
  */
 
 #include "opendavinci/odcore/opendavinci.h"
+#include "automotivedata/generated/automotive/miniature/SensorBoardData.h"
 #include "ContainerObserver.h"
 #include "plugins/iruscharts/IrUsChartsPlugIn.h"
 #include "plugins/iruscharts/IrUsChartsWidget.h"
@@ -47,7 +48,7 @@ namespace cockpit {
 
                 ContainerObserver *co = getContainerObserver();
                 if (co != NULL) {
-                    co->addContainerListener(m_irusChartsWidget);
+                    co->addContainerListener(m_irusChartsWidget, vector<int32_t>(1, automotive::miniature::SensorBoardData::ID()), ContainerObserver::BOUNDED_HISTORY, 100);
                 }
 
             }
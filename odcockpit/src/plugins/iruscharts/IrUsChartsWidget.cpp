@@ -28,6 +28,7 @@
 # pragma GCC diagnostic ignored "-Weffc++"
 #endif
     #include <qwt_plot.h>
+    #include <qwt_plot_canvas.h>
     #include <qwt_plot_curve.h>
     #include <qwt_plot_item.h>
 #ifndef WIN32
@@ -37,6 +38,7 @@
 #endif
 
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
@@ -66,13 +68,17 @@ namespace cockpit {
             using namespace odcore::base;
             using namespace odcore::data;
 
+            // Number of most recent samples to display per sensor.
+            static const uint32_t NUMBER_OF_DISPLAYED_SAMPLES = 10*15;
+
             IrUsChartsWidget::IrUsChartsWidget(const PlugIn &/*plugIn*/, const odcore::base::KeyValueConfiguration &kvc, QWidget *prnt) :
                 QWidget(prnt),
                 m_listOfPlots(),
                 m_listOfPlotCurves(),
                 m_listOfData(),
+                m_listOfTimeSeries(),
                 m_mapOfSensors(),
-                m_data(),
+                m_mapOfTimeSeries(),
                 m_bufferMax(10000),
                 m_receivedSensorBoardDataContainersMutex(),
                 m_receivedSensorBoardDataContainers(),
@@ -112,7 +118,11 @@ namespace cockpit {
                     m_listOfPlots.push_back(plot);
 
                     // Setup data interface.
-                    IrUsChartData *dataInterface = new IrUsChartData(m_data, id);
+                    std::shared_ptr<TimeSeries> timeSeries(new TimeSeries(NUMBER_OF_DISPLAYED_SAMPLES));
+                    m_listOfTimeSeries.push_back(timeSeries);
+                    m_mapOfTimeSeries[id] = timeSeries;
+
+                    IrUsChartData *dataInterface = new IrUsChartData();
                     m_listOfData.push_back(dataInterface);
 
                     // Setup data curve.
@@ -120,6 +130,7 @@ namespace cockpit {
                     curve->setRenderHint(QwtPlotItem::RenderAntialiased);
                     curve->setData(*dataInterface);
                     curve->attach(plot);
+                    m_listOfPlotCurves.push_back(curve);
                 }
 
                 QScrollArea *scrollArea = new QScrollArea(this);
@@ -164,9 +175,12 @@ namespace cockpit {
             IrUsChartsWidget::~IrUsChartsWidget() {}
 
             void IrUsChartsWidget::TimerEvent() {
-                vector<QwtPlot*>::iterator it = m_listOfPlots.begin();
-                for(;it < m_listOfPlots.end(); it++) {
-                    (*it)->replot();
+                for(uint32_t i = 0; i < m_listOfPlots.size(); i++) {
+                    // Two points per pixel suffice to show the extremes of each column.
+                    const uint32_t MAX_POINTS = 2 * static_cast<uint32_t>(max(m_listOfPlots.at(i)->canvas()->width(), 1));
+                    m_listOfData.at(i)->update(*m_listOfTimeSeries.at(i), NUMBER_OF_DISPLAYED_SAMPLES, MAX_POINTS);
+                    m_listOfPlotCurves.at(i)->setData(*m_listOfData.at(i));
+                    m_listOfPlots.at(i)->replot();
                 }
                 {
                     Lock l(m_receivedSensorBoardDataContainersMutex);
@@ -261,10 +275,9 @@ namespace cockpit {
                 if (container.getDataType() == automotive::miniature::SensorBoardData::ID()) {
                     automotive::miniature::SensorBoardData sbd = container.getData<automotive::miniature::SensorBoardData>();
 
-                    m_data.push_back(sbd);
-
-                    if (m_data.size() > 10*15) {
-                        m_data.pop_front();
+                    const int64_t SAMPLE_TIME_STAMP = container.getSampleTimeStamp().toMicroseconds();
+                    for(map<uint32_t, std::shared_ptr<TimeSeries> >::iterator it = m_mapOfTimeSeries.begin(); it != m_mapOfTimeSeries.end(); it++) {
+                        it->second->append(SAMPLE_TIME_STAMP, sbd.getValueForKey_MapOfDistances(it->first));
                     }
 
                     {
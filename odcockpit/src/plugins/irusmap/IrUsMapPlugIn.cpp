@@ -19,6 +19,7 @@
  */
 
 #include "opendavinci/odcore/opendavinci.h"
+#include "automotivedata/generated/automotive/miniature/SensorBoardData.h"
 #include "ContainerObserver.h"
 #include "plugins/irusmap/IrUsMapPlugIn.h"
 #include "plugins/irusmap/IrUsMapWidgetControl.h"
@@ -48,7 +49,7 @@ namespace cockpit {
 
                 cockpit::ContainerObserver *co = getContainerObserver();
                 if (co != NULL) {
-                    co->addContainerListener(m_irusmapWidgetControl);
+                    co->addContainerListener(m_irusmapWidgetControl, vector<int32_t>(1, automotive::miniature::SensorBoardData::ID()), cockpit::ContainerObserver::LATEST_VALUE, 1);
                 }
             }
 
@@ -45,7 +45,8 @@ namespace cockpit {
 
                 ContainerObserver *co = getContainerObserver();
                 if (co != NULL) {
-                    co->addContainerListener(m_viewerWidget);
+                    // Only the most recent values are displayed.
+                    co->addContainerListener(m_viewerWidget, vector<int32_t>(), ContainerObserver::LATEST_VALUE, 1);
                 }
             }
 
@@ -28,6 +28,7 @@
 #include "opendavinci/odcore/base/Lock.h"
 #include "opendavinci/odcore/data/Container.h"
 #include "opendavinci/odcore/data/TimeStamp.h"
+#include "opendavinci/odcore/reflection/FieldAccessor.h"
 #include "opendavinci/odcore/reflection/Message.h"
 #include "opendavinci/odcore/strings/StringToolbox.h"
 
@@ -59,6 +60,7 @@ namespace cockpit {
                 m_dataView(),
                 m_dataToType(),
                 m_containerTypeToName(),
+                m_containerTypeToFieldAccessors(),
                 m_containerTypeResolvingMutex(),
                 m_containerTypeResolving() {
                 // Set size.
@@ -190,6 +192,13 @@ namespace cockpit {
                     if (successfullyMapped) {
                         m_containerTypeToName[container.getDataType()] = msg.getLongName();
 
+                        // Fixed arrays and raw data cannot be extracted directly; such data types are displayed from the resolved message.
+                        bool isComplete = false;
+                        const vector<FieldAccessor> ACCESSORS = FieldAccessor::compileAll(msg, isComplete);
+                        if (isComplete) {
+                            m_containerTypeToFieldAccessors[container.getDataType()] = ACCESSORS;
+                        }
+
                         Lock l(m_containerTypeResolvingMutex);
                         stringstream sstr;
                         sstr << m_containerTypeToName[container.getDataType()] << "/" << container.getSenderStamp();
@@ -239,10 +248,22 @@ namespace cockpit {
                                 }
                             }
                             else {
-                                msg = m_messageResolver->resolve(container, successfullyMapped);
-                                if (successfullyMapped) {
-                                    MessageToTupleVisitor mttv(entries, "");
-                                    msg.accept(mttv);
+                                map<int32_t, vector<FieldAccessor> >::const_iterator accessors = m_containerTypeToFieldAccessors.find(container.getDataType());
+                                if (accessors != m_containerTypeToFieldAccessors.end()) {
+                                    // Extract the fields directly from the serialized data.
+                                    const string PAYLOAD = container.getRawData();
+                                    for (auto it = accessors->second.begin(); it != accessors->second.end(); ++it) {
+                                        bool extracted = false;
+                                        const string value = it->getValueAsString(PAYLOAD, extracted);
+                                        entries.push_back(make_pair(it->getFieldPath(), value));
+                                    }
+                                }
+                                else {
+                                    msg = m_messageResolver->resolve(container, successfullyMapped);
+                                    if (successfullyMapped) {
+                                        MessageToTupleVisitor mttv(entries, "");
+                                        msg.accept(mttv);
+                                    }
                                 }
                             }
                         }
@@ -267,11 +288,17 @@ namespace cockpit {
                         }
                     }
 
-                    // Map tuples of <string, string> to the tree.
+                    // Map tuples of <string, string> to the tree; only changed texts are updated.
                     for (uint32_t i = 0; i < entries.size(); i++) {
                         QTreeWidgetItem *child = entry->child(i);
-                        child->setText(0, entries.at(i).first.c_str());
-                        child->setText(1, entries.at(i).second.c_str());
+                        const QString name(entries.at(i).first.c_str());
+                        const QString value(entries.at(i).second.c_str());
+                        if (child->text(0) != name) {
+                            child->setText(0, name);
+                        }
+                        if (child->text(1) != value) {
+                            child->setText(1, value);
+                        }
                     }
                 }
             }
@@ -21,8 +21,12 @@
 #include <QtCore>
 #include <QtGui>
 
+#include <sstream>
+
 #include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/base/Lock.h"
 #include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/generated/odcore/data/dmcp/ContainerStatistic.h"
 #include "opendavinci/generated/odcore/data/dmcp/ModuleDescriptor.h"
 #include "opendavinci/generated/odcore/data/dmcp/ModuleStatistic.h"
 #include "plugins/modulestatisticsviewer/LoadPerModule.h"
@@ -46,7 +50,10 @@ namespace cockpit {
                     m_plot(NULL),
                     m_moduleStatistics(),
                     m_loadPerModule(),
-                    m_color(0) {
+                    m_color(0),
+                    m_containerStatisticsViewMutex(),
+                    m_containerStatisticsView(NULL),
+                    m_containerStatistics() {
 
                 // Set size.
                 setMinimumSize(640, 480);
@@ -59,6 +66,19 @@ namespace cockpit {
                 QGridLayout* mainGrid = new QGridLayout(this);
                 mainGrid->addWidget(m_plot, 0, 0, 1, 3);
 
+                // Telemetry per data type and sender stamp as published with --telemetry.
+                m_containerStatisticsView = new QTreeWidget(this);
+                m_containerStatisticsView->setColumnCount(12);
+                QStringList headerLabel;
+                headerLabel << tr("module/data type") << tr("sender stamp")
+                            << tr("sent [Hz]") << tr("sent [B/s]")
+                            << tr("received [Hz]") << tr("received [B/s]")
+                            << tr("dropped")
+                            << tr("serialization [us]") << tr("deserialization [us]")
+                            << tr("latency p50 [us]") << tr("latency p99 [us]") << tr("latency max [us]");
+                m_containerStatisticsView->setHeaderLabels(headerLabel);
+                mainGrid->addWidget(m_containerStatisticsView, 1, 0, 1, 3);
+
                 QTimer *timer = new QTimer(this);
                 connect(timer, SIGNAL(timeout()), m_plot, SLOT(replot()));
                 const uint32_t fps = 5;
@@ -105,6 +125,45 @@ namespace cockpit {
                         it++;
                     }
                 }
+                else if (c.getDataType() == odcore::data::dmcp::ContainerStatistics::ID()) {
+                    updateContainerStatistics(c.getData<ContainerStatistics>());
+                }
+            }
+
+            void ModuleStatisticsViewerWidget::updateContainerStatistics(const ContainerStatistics &cs) {
+                Lock l(m_containerStatisticsViewMutex);
+
+                stringstream sstrModule;
+                sstrModule << cs.getModuleName() << ":" << cs.getIdentifier();
+                m_containerStatistics[sstrModule.str()] = cs;
+
+                m_containerStatisticsView->setEnabled(false);
+                m_containerStatisticsView->clear();
+
+                for (auto it = m_containerStatistics.begin(); it != m_containerStatistics.end(); ++it) {
+                    QTreeWidgetItem *moduleEntry = new QTreeWidgetItem(m_containerStatisticsView);
+                    moduleEntry->setText(0, it->first.c_str());
+
+                    vector<ContainerStatistic> list = it->second.getListOfContainerStatistics();
+                    for (auto jt = list.begin(); jt != list.end(); ++jt) {
+                        QTreeWidgetItem *entry = new QTreeWidgetItem(moduleEntry);
+                        entry->setText(0, QString::number(jt->getDataType()));
+                        entry->setText(1, QString::number(jt->getSenderStamp()));
+                        entry->setText(2, QString::number(jt->getSentRate(), 'f', 1));
+                        entry->setText(3, QString::number(jt->getSentBytesRate(), 'f', 0));
+                        entry->setText(4, QString::number(jt->getReceivedRate(), 'f', 1));
+                        entry->setText(5, QString::number(jt->getReceivedBytesRate(), 'f', 0));
+                        entry->setText(6, QString::number(jt->getNumberOfDroppedContainers()));
+                        entry->setText(7, QString::number(jt->getMeanSerializationTime(), 'f', 1));
+                        entry->setText(8, QString::number(jt->getMeanDeserializationTime(), 'f', 1));
+                        entry->setText(9, QString::number(jt->getLatencyP50(), 'f', 0));
+                        entry->setText(10, QString::number(jt->getLatencyP99(), 'f', 0));
+                        entry->setText(11, QString::number(jt->getLatencyMax(), 'f', 0));
+                    }
+                    moduleEntry->setExpanded(true);
+                }
+
+                m_containerStatisticsView->setEnabled(true);
             }
 
         }
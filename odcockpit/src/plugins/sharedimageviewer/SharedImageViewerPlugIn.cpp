@@ -18,7 +18,12 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
+#include <string>
+#include <vector>
+
 #include "opendavinci/odcore/opendavinci.h"
+#include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/generated/odcore/data/image/SharedImage.h"
 #include "ContainerObserver.h"
 #include "plugins/sharedimageviewer/SharedImageViewerPlugIn.h"
 #include "plugins/sharedimageviewer/SharedImageViewerWidget.h"
@@ -32,6 +37,16 @@ namespace cockpit {
 
         namespace sharedimageviewer {
 
+            using namespace std;
+
+            /**
+             * Shared images from different cameras might have the same
+             * sender stamp; thus, they are distinguished by their names.
+             */
+            static string getSharedImageName(odcore::data::Container &c) {
+                return c.getData<odcore::data::image::SharedImage>().getName();
+            }
+
             SharedImageViewerPlugIn::SharedImageViewerPlugIn(const string &name, const odcore::base::KeyValueConfiguration &kvc, QWidget *prnt) :
                     PlugIn(name, kvc, prnt),
                     m_imageViewerWidget(NULL) {
@@ -47,7 +62,8 @@ namespace cockpit {
 
                 cockpit::ContainerObserver *co = getContainerObserver();
                 if (co != NULL) {
-                    co->addContainerListener(m_imageViewerWidget);
+                    // Only the most recent announcement per shared image is needed.
+                    co->addContainerListener(m_imageViewerWidget, vector<int32_t>(1, odcore::data::image::SharedImage::ID()), cockpit::ContainerObserver::LATEST_VALUE, 1, &getSharedImageName);
                 }
             }
 
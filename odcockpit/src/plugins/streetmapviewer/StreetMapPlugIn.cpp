@@ -20,6 +20,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/strings/StringToolbox.h"
@@ -66,7 +67,8 @@ namespace cockpit {
 
                 cockpit::ContainerObserver *co = getContainerObserver();
                 if (co != NULL) {
-                    co->addContainerListener(m_widget);
+                    // Only the most recent position is displayed.
+                    co->addContainerListener(m_widget, vector<int32_t>(1, WGS84Coordinate::ID()), ContainerObserver::LATEST_VALUE, 1);
                 }
             }
 
@@ -19,6 +19,7 @@
  */
 
 #include "opendavinci/odcore/opendavinci.h"
+#include "odvdopendlv/generated/opendlv/perception/Environment.h"
 #include "ContainerObserver.h"
 #include "plugins/truckmap/TruckMapPlugIn.h"
 #include "plugins/truckmap/TruckMapWidgetControl.h"
@@ -48,7 +49,7 @@ namespace cockpit {
 
                 cockpit::ContainerObserver *co = getContainerObserver();
                 if (co != NULL) {
-                    co->addContainerListener(m_truckmapWidgetControl);
+                    co->addContainerListener(m_truckmapWidgetControl, vector<int32_t>(1, opendlv::perception::Environment::ID()), cockpit::ContainerObserver::LATEST_VALUE, 1);
                 }
             }
 
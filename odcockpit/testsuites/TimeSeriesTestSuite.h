@@ -0,0 +1,129 @@
+/**
+ * cockpit - Visualization environment
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef COCKPIT_TIMESERIESTESTSUITE_H_
+#define COCKPIT_TIMESERIESTESTSUITE_H_
+
+#include <algorithm>
+#include <cstdlib>
+#include <set>
+#include <vector>
+
+#include "cxxtest/TestSuite.h"
+
+#include "plugins/TimeSeries.h"
+
+using namespace std;
+using namespace cockpit::plugins;
+
+class TimeSeriesTest : public CxxTest::TestSuite {
+    public:
+        void appendRandomSamples(TimeSeries &ts, vector<double> &values, const uint32_t &numberOfSamples) {
+            for (uint32_t i = 0; i < numberOfSamples; i++) {
+                const double VALUE = static_cast<double>(::rand() % 20001 - 10000) / 100.0;
+                ts.append(static_cast<int64_t>(values.size()), VALUE);
+                values.push_back(VALUE);
+            }
+        }
+
+        void checkView(const TimeSeries &ts, const vector<double> &values, const uint32_t &window, const uint32_t &maxPoints) {
+            vector<double> x;
+            vector<double> y;
+            ts.getView(window, maxPoints, x, y);
+
+            // Brute force over the samples in the window.
+            const uint32_t NUMBER_OF_SAMPLES = min<uint32_t>(min<uint32_t>(window, ts.getCapacity()), static_cast<uint32_t>(values.size()));
+            TS_ASSERT_EQUALS(x.size(), y.size());
+            if (0 == NUMBER_OF_SAMPLES) {
+                TS_ASSERT(x.empty());
+                return;
+            }
+            TS_ASSERT(!x.empty());
+
+            const vector<double>::const_iterator FROM = values.end() - NUMBER_OF_SAMPLES;
+            const double MIN = *min_element(FROM, values.end());
+            const double MAX = *max_element(FROM, values.end());
+            const set<double> WINDOW(FROM, values.end());
+
+            TS_ASSERT_EQUALS(*min_element(y.begin(), y.end()), MIN);
+            TS_ASSERT_EQUALS(*max_element(y.begin(), y.end()), MAX);
+
+            for (uint32_t i = 0; i < x.size(); i++) {
+                TS_ASSERT(WINDOW.count(y.at(i)) == 1);
+                TS_ASSERT(x.at(i) >= 0);
+                TS_ASSERT(x.at(i) < NUMBER_OF_SAMPLES);
+                if (i > 0) {
+                    TS_ASSERT(x.at(i) >= x.at(i - 1));
+                }
+            }
+        }
+
+        void testGetViewWithoutDecimation() {
+            TimeSeries ts(1000);
+            vector<double> values;
+            appendRandomSamples(ts, values, 500);
+
+            vector<double> x;
+            vector<double> y;
+            ts.getView(1000, 1000, x, y);
+            TS_ASSERT_EQUALS(y.size(), 500u);
+            for (uint32_t i = 0; i < y.size(); i++) {
+                TS_ASSERT_EQUALS(x.at(i), static_cast<double>(i));
+                TS_ASSERT_EQUALS(y.at(i), values.at(i));
+            }
+        }
+
+        void testGetViewExtremesMatchBruteForce() {
+            ::srand(17);
+            TimeSeries ts(10000);
+            TS_ASSERT(ts.getNumberOfLevels() > 2);
+
+            vector<double> values;
+            const uint32_t WINDOWS[] = { 1, 7, 8, 9, 63, 64, 65, 513, 4097, 10000 };
+            const uint32_t MAX_POINTS[] = { 2, 16, 100, 1280 };
+
+            // Check the views while the ring fills up and after it wrapped around several times.
+            for (uint32_t round = 0; round < 8; round++) {
+                appendRandomSamples(ts, values, 3001 + round * 17);
+                for (uint32_t w = 0; w < sizeof(WINDOWS)/sizeof(WINDOWS[0]); w++) {
+                    for (uint32_t p = 0; p < sizeof(MAX_POINTS)/sizeof(MAX_POINTS[0]); p++) {
+                        checkView(ts, values, WINDOWS[w], MAX_POINTS[p]);
+                    }
+                }
+            }
+            TS_ASSERT_EQUALS(ts.getSize(), 10000u);
+        }
+
+        void testGetSamples() {
+            TimeSeries ts(100);
+            vector<double> values;
+            appendRandomSamples(ts, values, 250);
+
+            vector<int64_t> timeStamps;
+            vector<double> samples;
+            ts.getSamples(timeStamps, samples);
+            TS_ASSERT_EQUALS(samples.size(), 100u);
+            for (uint32_t i = 0; i < samples.size(); i++) {
+                TS_ASSERT_EQUALS(timeStamps.at(i), static_cast<int64_t>(150 + i));
+                TS_ASSERT_EQUALS(samples.at(i), values.at(150 + i));
+            }
+        }
+};
+
+#endif /*COCKPIT_TIMESERIESTESTSUITE_H_*/
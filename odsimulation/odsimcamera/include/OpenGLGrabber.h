@@ -29,6 +29,7 @@ namespace core { namespace wrapper { class Image; } }
 namespace odcore { namespace wrapper { class SharedMemory; } }
 namespace opendlv { namespace data { namespace camera { class ImageGrabberCalibration; } } }
 namespace opendlv { namespace data { namespace environment { class EgoState; } } }
+namespace opendlv { namespace threeD { class PixelReadback; } }
 namespace opendlv { namespace threeD { class TransformGroup; } }
 
 namespace camgen {
@@ -92,6 +93,7 @@ namespace camgen {
             odcore::base::KeyValueConfiguration m_kvc;
             std::shared_ptr<core::wrapper::Image> m_image;
             std::shared_ptr<odcore::wrapper::SharedMemory> m_sharedMemory;
+            std::shared_ptr<opendlv::threeD::PixelReadback> m_readback;
             std::shared_ptr<opendlv::threeD::TransformGroup> m_root;
             std::shared_ptr<opendlv::threeD::TransformGroup> m_extrinsicCalibrationRoot;
             std::shared_ptr<opendlv::threeD::TransformGroup> m_intrinsicCalibrationRoot;
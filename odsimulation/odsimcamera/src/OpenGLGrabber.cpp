@@ -37,7 +37,9 @@
 #include "opendavinci/odcore/wrapper/SharedMemory.h"
 #include "opendavinci/odcore/wrapper/SharedMemoryFactory.h"
 #include "opendlv/scenario/SCNXArchiveFactory.h"
+#include "opendlv/threeD/PixelReadback.h"
 #include "opendlv/threeD/RenderingConfiguration.h"
+#include "opendlv/threeD/TextureManager.h"
 #include "opendlv/threeD/TransformGroup.h"
 #include "opendlv/threeD/decorator/DecoratorFactory.h"
 #include "opendlv/threeD/models/CheckerBoard.h"
@@ -68,6 +70,7 @@ namespace camgen {
             m_kvc(kvc),
             m_image(),
             m_sharedMemory(),
+            m_readback(),
             m_root(),
             m_extrinsicCalibrationRoot(),
             m_intrinsicCalibrationRoot(),
@@ -91,6 +94,8 @@ namespace camgen {
 
             m_image = std::shared_ptr<core::wrapper::Image>(core::wrapper::ImageFactory::getInstance().getImage(640, 480, core::wrapper::Image::BGR_24BIT, static_cast<char*>(m_sharedMemory->getSharedMemory())));
 
+            m_readback = std::shared_ptr<PixelReadback>(new PixelReadback(640, 480, 1, true));
+
             if (m_image.get()) {
                 cerr << "OpenGLGrabber initialized." << endl;
             }
@@ -115,9 +120,14 @@ namespace camgen {
     }
 
     std::shared_ptr<core::wrapper::Image> OpenGLGrabber::getNextImage() {
+        std::shared_ptr<core::wrapper::Image> image;
+
         if ( (m_sharedMemory.get()) && (m_sharedMemory->isValid()) ) {
             m_sharedMemory->lock();
 
+            // Continue uploading textures that were loaded in the background.
+            TextureManager::getInstance().update();
+
             // Render the image right before grabbing it.
             switch (m_render) {
                 case  OpenGLGrabber::WORLD:
@@ -133,16 +143,20 @@ namespace camgen {
 
             // TODO Read pixels using BGRA!!!
             glReadBuffer(GL_BACK);
-            glPixelStorei(GL_PACK_ALIGNMENT, 1);
-            glReadPixels(0, 0, m_image->getWidth(), m_image->getHeight(), GL_BGR, GL_UNSIGNED_BYTE, m_sharedMemory->getSharedMemory());
 
-            // Flip the image horizontally.
-            m_image->flipHorizontally();
+            // The transfer is asynchronous; thus, the image shows the previously rendered frame.
+            // Without a newly completed frame, no image is returned to avoid sending the last one twice.
+            vector<char*> images(1, static_cast<char*>(m_sharedMemory->getSharedMemory()));
+            if (m_readback->read(images)) {
+                // Flip the image horizontally.
+                m_image->flipHorizontally();
+                image = m_image;
+            }
 
             m_sharedMemory->unlock();
         }
 
-        return m_image;
+        return image;
     }
 
     void OpenGLGrabber::renderNextImageFromRealWord() {
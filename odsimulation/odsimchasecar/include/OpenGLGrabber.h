@@ -29,6 +29,7 @@
 #include "opendavinci/odcore/wrapper/SharedMemory.h"
 #include "opendlv/data/camera/ImageGrabberID.h"
 #include "opendlv/io/camera/ImageGrabber.h"
+#include "opendlv/threeD/PixelReadback.h"
 #include "opendlv/threeD/TransformGroup.h"
 
 namespace odcore { namespace base { class FIFOQueue; } }
@@ -99,6 +100,7 @@ namespace chasecar {
             odcore::base::KeyValueConfiguration m_kvc;
             std::shared_ptr<core::wrapper::Image> m_image;
             std::shared_ptr<odcore::wrapper::SharedMemory> m_sharedMemory;
+            std::shared_ptr<opendlv::threeD::PixelReadback> m_readback;
             std::shared_ptr<opendlv::threeD::TransformGroup> m_root;
             std::shared_ptr<opendlv::threeD::TransformGroup> m_car;
             std::shared_ptr<opendlv::threeD::TransformGroup> m_sensors;
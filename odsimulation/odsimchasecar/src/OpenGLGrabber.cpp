@@ -45,7 +45,9 @@
 #include "opendlv/data/environment/Position.h"
 #include "opendlv/scenario/SCNXArchiveFactory.h"
 #include "opendlv/threeD/NodeDescriptor.h"
+#include "opendlv/threeD/PixelReadback.h"
 #include "opendlv/threeD/RenderingConfiguration.h"
+#include "opendlv/threeD/TextureManager.h"
 #include "opendlv/threeD/decorator/DecoratorFactory.h"
 #include "opendlv/threeD/loaders/OBJXArchive.h"
 #include "opendlv/threeD/loaders/OBJXArchiveFactory.h"
@@ -77,6 +79,7 @@ namespace chasecar {
             m_kvc(kvc),
             m_image(),
             m_sharedMemory(),
+            m_readback(),
             m_root(),
             m_car(),
             m_sensors(),
@@ -108,7 +111,7 @@ namespace chasecar {
                 fstream fin(objxModel.c_str(), ios::in | ios::binary);
                 if (fin.good()) {
                     cout << "Loading car model" << endl;
-                    OBJXArchive *objxArchive = OBJXArchiveFactory::getInstance().getOBJXArchive(fin);
+                    OBJXArchive *objxArchive = OBJXArchiveFactory::getInstance().getOBJXArchive(objxModel);
 
                     fin.close();
                     if (objxArchive != NULL) {
@@ -123,6 +126,8 @@ namespace chasecar {
 
             m_image = std::shared_ptr<core::wrapper::Image>(core::wrapper::ImageFactory::getInstance().getImage(640, 480, core::wrapper::Image::BGR_24BIT, static_cast<char*>(m_sharedMemory->getSharedMemory())));
 
+            m_readback = std::shared_ptr<PixelReadback>(new PixelReadback(640, 480, 1, true));
+
             if (m_image.get()) {
                 cerr << "OpenGLGrabber initialized." << endl;
             }
@@ -136,9 +141,14 @@ namespace chasecar {
     }
 
     std::shared_ptr<core::wrapper::Image> OpenGLGrabber::getNextImage() {
+        std::shared_ptr<core::wrapper::Image> image;
+
         if ( (m_sharedMemory.get()) && (m_sharedMemory->isValid()) ) {
             m_sharedMemory->lock();
 
+            // Continue uploading textures that were loaded in the background.
+            TextureManager::getInstance().update();
+
             // Render the image right before grabbing it.
             switch (m_render) {
                 case  OpenGLGrabber::IN_CAR:
@@ -215,16 +225,20 @@ namespace chasecar {
 
             // TODO Read pixels using BGRA!!!
             glReadBuffer(GL_BACK);
-            glPixelStorei(GL_PACK_ALIGNMENT, 1);
-            glReadPixels(0, 0, m_image->getWidth(), m_image->getHeight(), GL_BGR, GL_UNSIGNED_BYTE, m_sharedMemory->getSharedMemory());
 
-            // Flip the image horizontally.
-            m_image->flipHorizontally();
+            // The transfer is asynchronous; thus, the image shows the previously rendered frame.
+            // Without a newly completed frame, no image is returned to avoid sending the last one twice.
+            vector<char*> images(1, static_cast<char*>(m_sharedMemory->getSharedMemory()));
+            if (m_readback->read(images)) {
+                // Flip the image horizontally.
+                m_image->flipHorizontally();
+                image = m_image;
+            }
 
             m_sharedMemory->unlock();
         }
 
-        return m_image;
+        return image;
     }
 
     void OpenGLGrabber::renderNextImageInCar() {
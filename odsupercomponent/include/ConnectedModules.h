@@ -27,6 +27,7 @@
 
 #include "opendavinci/odcore/opendavinci.h"
 #include "opendavinci/odcore/base/Mutex.h"
+#include "opendavinci/odcore/data/ContainerBatch.h"
 
 namespace odcore { namespace data { namespace dmcp { class ModuleDescriptor; } } }
 namespace odcore { namespace data { namespace dmcp { class PulseMessage; } } }
@@ -88,7 +89,7 @@ class ConnectedModule;
              * @param modulesToIgnore Modules that are skipped when sending the pulse signal.
              * @return Containers to be transferred to supercomponent.
              */
-            vector<odcore::data::Container> pulse_ack_containers(const odcore::data::dmcp::PulseMessage &pm, const uint32_t &timeout, const uint32_t &yield, const vector<string> &modulesToIgnore);
+            odcore::data::ContainerBatch pulse_ack_containers(const odcore::data::dmcp::PulseMessage &pm, const uint32_t &timeout, const uint32_t &yield, const vector<string> &modulesToIgnore);
 
             void deleteAllModules();
 
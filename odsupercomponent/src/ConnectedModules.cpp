@@ -144,11 +144,14 @@ namespace odsupercomponent {
         }
     }
 
-    vector<Container> ConnectedModules::pulse_ack_containers(const odcore::data::dmcp::PulseMessage &pm, const uint32_t &timeout, const uint32_t &yield, const vector<string> &modulesToIgnore) {
+    ContainerBatch ConnectedModules::pulse_ack_containers(const odcore::data::dmcp::PulseMessage &pm, const uint32_t &timeout, const uint32_t &yield, const vector<string> &modulesToIgnore) {
         // Unfortunately, we cannot prevent code duplication here (cf. pulse_ack)
         // as in this case, the dependent client module will send all its containers
         // via this TCP link and NOT via the regular UDP multicast conference.
-        vector<Container> allContainersToBeDeliveredInNextCycle;
+        ContainerBatch allContainersToBeDeliveredInNextCycle;
+
+        // Serialize the pulse including the containers from the last cycle only once for all modules.
+        Container pulse(pm);
 
         Lock l(m_modulesMutex);
         map<string, ConnectedModule*>::iterator iter;
@@ -162,10 +165,10 @@ namespace odsupercomponent {
             vector<string>::const_iterator it = find(modulesToIgnore.begin(), modulesToIgnore.end(), s);
             if (it == modulesToIgnore.end()) {
                 // The following call blocks until the client has confirmed the processing of this pulse.
-                vector<Container> containersToBeDeliveredInNextCycle = iter->second->getConnection().pulse_ack_containers(pm, timeout);
+                const ContainerBatch containersToBeDeliveredInNextCycle = iter->second->getConnection().pulse_ack_containers(pulse, timeout);
 
-                // Add newly received containers to the overall list.
-                allContainersToBeDeliveredInNextCycle.insert(allContainersToBeDeliveredInNextCycle.end(), containersToBeDeliveredInNextCycle.begin(), containersToBeDeliveredInNextCycle.end());
+                // Add newly received containers to the overall list without deserializing them.
+                allContainersToBeDeliveredInNextCycle.append(containersToBeDeliveredInNextCycle);
 
                 // Allow delivery of packets on OS level.
                 Thread::usleepFor(yield);
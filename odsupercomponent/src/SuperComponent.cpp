@@ -36,6 +36,7 @@
 #include "opendavinci/odcore/base/Lock.h"
 #include "opendavinci/odcore/base/Thread.h"
 #include "opendavinci/odcore/data/Container.h"
+#include "opendavinci/odcore/data/ContainerBatch.h"
 #include "opendavinci/odcore/data/TimeStamp.h"
 #include "opendavinci/odcore/dmcp/connection/ModuleConnection.h"
 #include "opendavinci/odcore/dmcp/connection/Server.h"
@@ -45,6 +46,8 @@
 #include "opendavinci/odcore/io/conference/ContainerConference.h"
 #include "opendavinci/odcore/io/conference/ContainerConferenceFactory.h"
 #include "opendavinci/odcore/strings/StringToolbox.h"
+#include "opendavinci/generated/odcore/data/dmcp/ContainerStatistic.h"
+#include "opendavinci/generated/odcore/data/dmcp/ContainerStatistics.h"
 #include "opendavinci/generated/odcore/data/dmcp/ModuleDescriptor.h"
 #include "opendavinci/generated/odcore/data/dmcp/ModuleStatistic.h"
 
@@ -315,7 +318,7 @@ namespace odsupercomponent {
         uint32_t cumulatedTimeSlice = 0;
         const long ONE_SECOND_IN_MICROSECONDS = 1000 * 1000 * 1;
 
-        vector<Container> containersToBeDistributedToModules;
+        ContainerBatch containersToBeDistributedToModules;
 
         m_lastCycle = TimeStamp();
         while (getModuleStateAndWaitForRemainingTimeInTimeslice() == odcore::data::dmcp::ModuleStateMessage::RUNNING) {
@@ -360,7 +363,8 @@ namespace odsupercomponent {
 
                 const TimeStamp supercomponent_now;
                 const vector<Container> EMPTY_LIST_OF_CONTAINERS;
-                PulseMessage pm(supercomponent_now, NOMINAL_DURATION_OF_ONE_SLICE, cumulatedTimeSlice, EMPTY_LIST_OF_CONTAINERS);
+                const string EMPTY_CONTAINER_BATCH;
+                PulseMessage pm(supercomponent_now, NOMINAL_DURATION_OF_ONE_SLICE, cumulatedTimeSlice, EMPTY_LIST_OF_CONTAINERS, EMPTY_CONTAINER_BATCH);
 
                 if (m_managedLevel == odcore::data::dmcp::ServerInformation::ML_PULSE) {
                     m_modules.pulse(pm);
@@ -391,15 +395,18 @@ namespace odsupercomponent {
                     // we trigger the next module (send the pulse to it) to allow delivery of any packets
                     // on the OS level.
 
-                    // Set containers to be delivered to the connected modules.
-                    pm.setListOfContainers(containersToBeDistributedToModules);
+                    // Set containers to be delivered to the connected modules as they were received.
+                    pm.setContainerBatch(containersToBeDistributedToModules.getRawData());
 
                     // Replicate containers to real UDP conference for modules that are excluded from the ML.
-                    vector<Container>::iterator it = containersToBeDistributedToModules.begin();
-                    while (it != containersToBeDistributedToModules.end()) {
-                        m_conference->send(*it);
-                        it++;
-                        Thread::usleepFor(500);
+                    if (!m_modulesToIgnore.empty()) {
+                        vector<Container> listOfContainers = containersToBeDistributedToModules.getListOfContainers();
+                        vector<Container>::iterator it = listOfContainers.begin();
+                        while (it != listOfContainers.end()) {
+                            m_conference->send(*it);
+                            it++;
+                            Thread::usleepFor(500);
+                        }
                     }
 
                     // Clear containers from last cycle.
@@ -594,6 +601,19 @@ namespace odsupercomponent {
                 }
             }
         }
+        else if (container.getDataType() == odcore::data::dmcp::ContainerStatistics::ID()) {
+            odcore::data::dmcp::ContainerStatistics cs = container.getData<odcore::data::dmcp::ContainerStatistics>();
+
+            CLOG1 << "[odsupercomponent]: Telemetry from " << cs.getModuleName() << ":" << cs.getIdentifier() << " over " << cs.getPeriod() << "s:" << endl;
+            vector<odcore::data::dmcp::ContainerStatistic> list = cs.getListOfContainerStatistics();
+            for (auto it = list.begin(); it != list.end(); ++it) {
+                CLOG1 << "[odsupercomponent]:   " << it->getDataType() << "/" << it->getSenderStamp()
+                      << ": sent " << it->getSentRate() << " Hz (" << it->getSentBytesRate() << " B/s)"
+                      << ", received " << it->getReceivedRate() << " Hz (" << it->getReceivedBytesRate() << " B/s)"
+                      << ", dropped " << it->getNumberOfDroppedContainers()
+                      << ", latency p50/p99/max " << it->getLatencyP50() << "/" << it->getLatencyP99() << "/" << it->getLatencyMax() << " us" << endl;
+            }
+        }
     }
     
 } // odsupercomponent
@@ -29,6 +29,7 @@
 #include "opendavinci/odcore/base/module/TimeTriggeredConferenceClientModule.h"
 #include <opendavinci/odcore/opendavinci.h>
 #include <opendavinci/odcore/data/Container.h>
+#include "opendavinci/odcore/data/CompactPointCloudDecoder.h"
 #include "opendavinci/generated/odcore/data/CompactPointCloud.h"
 #include <opendavinci/generated/odcore/data/SharedPointCloud.h>
 #include "opendavinci/odcore/wrapper/SharedMemory.h"
@@ -86,6 +87,8 @@ namespace odcomparepointcloud {
             uint32_t m_frameNumber;
             odcore::data::SharedPointCloud m_spc;
             odcore::data::CompactPointCloud m_cpc;
+            odcore::data::CompactPointCloudDecoder m_cpcDecoder;
+            odcore::data::CompactPointCloudDecoder::PointBuffer m_cpcPoints;
             bool m_hasAttachedToSharedImageMemory;
             std::shared_ptr<odcore::wrapper::SharedMemory> m_spcSharedMemory;
             uint8_t m_compareOption; //0: compare azimuth and distance; 1: compare xyz
@@ -109,9 +112,6 @@ namespace odcomparepointcloud {
             std::ofstream m_outputData;
             std::ofstream m_cpcFrame;
             std::ofstream m_spcFrame;
-            float m_verticalAngles[16];
-            uint16_t m_sensorOrderIndex[16];
-            uint16_t m_16SortedDistances[16];
             std::string m_recordingFile;
             bool m_allFrames;
             uint64_t m_chosenFrame;
@@ -45,6 +45,8 @@ namespace odcomparepointcloud {
         m_frameNumber(0),
         m_spc(),
         m_cpc(),
+        m_cpcDecoder(),
+        m_cpcPoints(),
         m_hasAttachedToSharedImageMemory(false),
         m_spcSharedMemory(NULL),
         m_compareOption(0),
@@ -69,47 +71,7 @@ namespace odcomparepointcloud {
         m_recordingFile(""),
         m_allFrames(false),
         m_chosenFrame(0),
-        m_currentFrame(0) {
-            //The vertical angles sorted by sensor IDs from 0 to 15 according to the data sheet
-            m_verticalAngles[0] = -15.0;
-            m_verticalAngles[1] = 1.0;
-            m_verticalAngles[2] = -13.0;
-            m_verticalAngles[3] = 3.0;
-            m_verticalAngles[4] = -11.0;
-            m_verticalAngles[5] = 5.0;
-            m_verticalAngles[6] = -9.0;
-            m_verticalAngles[7] = 7.0;
-            m_verticalAngles[8] = -7.0;
-            m_verticalAngles[9] = 9.0;
-            m_verticalAngles[10] = -5.0;
-            m_verticalAngles[11] = 11.0;
-            m_verticalAngles[12] = -3.0;
-            m_verticalAngles[13] = 13.0;
-            m_verticalAngles[14] = -1.0;
-            m_verticalAngles[15] = 15.0;
-            
-            //Distance values are reordered with increasing vertical angles while storing CPC
-            m_sensorOrderIndex[0] = 0;
-            m_sensorOrderIndex[1] = 2;
-            m_sensorOrderIndex[2] = 4;
-            m_sensorOrderIndex[3] = 6;
-            m_sensorOrderIndex[4] = 8;
-            m_sensorOrderIndex[5] = 10;
-            m_sensorOrderIndex[6] = 12;
-            m_sensorOrderIndex[7] = 14;
-            m_sensorOrderIndex[8] = 1;
-            m_sensorOrderIndex[9] = 3;
-            m_sensorOrderIndex[10] = 5;
-            m_sensorOrderIndex[11] = 7;
-            m_sensorOrderIndex[12] = 9;
-            m_sensorOrderIndex[13] = 11;
-            m_sensorOrderIndex[14] = 13;
-            m_sensorOrderIndex[15] = 15;
-            
-            for (uint8_t counter = 0; counter < 16; counter++) {
-                m_16SortedDistances[counter] = 0.0;
-            }
-        }
+        m_currentFrame(0) {}
 
     ComparePointCloudModule::~ComparePointCloudModule() {}
     
@@ -123,70 +85,16 @@ namespace odcomparepointcloud {
     
     void ComparePointCloudModule::readCPC(Container &c, const uint8_t &comparisonOption) {
         m_cpc = c.getData<CompactPointCloud>();  
-        float startAzimuth = m_cpc.getStartAzimuth();
-        float endAzimuth = m_cpc.getEndAzimuth();
-        uint8_t entriesPerAzimuth = m_cpc.getEntriesPerAzimuth();
-        string distances = m_cpc.getDistances();
-        const uint8_t numberOfBitsForIntensity = m_cpc.getNumberOfBitsForIntensity();
-        const uint8_t intensityPlacement = m_cpc.getIntensityPlacement();
-        uint16_t mask = 0xFFFF;
-        if (numberOfBitsForIntensity > 0) {
-            if (intensityPlacement == 0) {
-                mask = mask << numberOfBitsForIntensity;
-            } else {
-                mask = mask >> numberOfBitsForIntensity;
-            }
-        }
-        uint16_t distanceEncoding = m_cpc.getDistanceEncoding();
-        uint16_t distanceThreshold = 0;
-        switch (distanceEncoding) {
-            case CompactPointCloud::CM : distanceThreshold = 100;
-                                        break;
-            case CompactPointCloud::MM : distanceThreshold = 500;
-                                        break;
-        } 
-        
-        uint32_t numberOfPoints = distances.size() / 2;
-        uint32_t numberOfAzimuths = numberOfPoints / entriesPerAzimuth;
-        float azimuthIncrement = (endAzimuth - startAzimuth) / numberOfAzimuths;//Calculate the azimuth increment
-        stringstream sstr(distances);
-        const float toRadian = static_cast< float >(M_PI) / 180.0f;
-        uint16_t distance_integer = 0;
-        float xyDistance = 0;
-        float azimuth = startAzimuth;
-        for (uint32_t azimuthIndex = 0; azimuthIndex < numberOfAzimuths; azimuthIndex++) {
-            for (uint8_t sensorIndex = 0; sensorIndex < entriesPerAzimuth; sensorIndex++) {
-                sstr.read((char*)(&m_16SortedDistances[m_sensorOrderIndex[sensorIndex]]), 2); // Read distance value from the string in a CPC container point by point
-                m_16SortedDistances[m_sensorOrderIndex[sensorIndex]] = ntohs(m_16SortedDistances[m_sensorOrderIndex[sensorIndex]]);
-            }
-            
-            for (uint8_t sensorIndex = 0; sensorIndex < entriesPerAzimuth; sensorIndex++) {
-                distance_integer = m_16SortedDistances[sensorIndex];
-                if (numberOfBitsForIntensity !=0) {
-                    distance_integer = distance_integer & mask;
-                }
-                if (distance_integer >= distanceThreshold) {
-                    float distance = 0.0f;
-                    switch (distanceEncoding) {
-                        case CompactPointCloud::CM : distance = static_cast< float >(distance_integer / 100.0f); //convert to meter from resolution 1 cm
-                                                    break;
-                        case CompactPointCloud::MM : distance = static_cast< float >(distance_integer / 500.0f); //convert to meter from resolution 2mm
-                                                    break;
-                    }
-                    if (comparisonOption == 0) {
-                        m_distanceCpc.push_back(distance);
-                        m_azimuthCpc.push_back(azimuth);
-                        m_verticalAngleCpc.push_back(m_verticalAngles[sensorIndex]);
-                    } else {
-                        // Compute x, y, z coordinate based on distance, azimuth, and vertical angle
-                        xyDistance = distance * cos(m_verticalAngles[sensorIndex] * toRadian);
-                        m_xCpc.push_back(xyDistance * sin(azimuth * toRadian));
-                        m_yCpc.push_back(xyDistance * cos(azimuth * toRadian));
-                        m_zCpc.push_back(distance * sin(m_verticalAngles[sensorIndex] * toRadian));
-                    }
-                }
-            }
-            azimuth += azimuthIncrement;
+        m_cpcPoints.clear();
+        m_cpcDecoder.decode(m_cpc, m_cpcPoints);
+        if (comparisonOption == 0) {
+            m_distanceCpc.insert(m_distanceCpc.end(), m_cpcPoints.m_distance.begin(), m_cpcPoints.m_distance.end());
+            m_azimuthCpc.insert(m_azimuthCpc.end(), m_cpcPoints.m_azimuth.begin(), m_cpcPoints.m_azimuth.end());
+            m_verticalAngleCpc.insert(m_verticalAngleCpc.end(), m_cpcPoints.m_verticalAngle.begin(), m_cpcPoints.m_verticalAngle.end());
+        } else {
+            m_xCpc.insert(m_xCpc.end(), m_cpcPoints.m_x.begin(), m_cpcPoints.m_x.end());
+            m_yCpc.insert(m_yCpc.end(), m_cpcPoints.m_y.begin(), m_cpcPoints.m_y.end());
+            m_zCpc.insert(m_zCpc.end(), m_cpcPoints.m_z.begin(), m_cpcPoints.m_z.end());
         }
     }
     
@@ -0,0 +1,108 @@
+/**
+ * odplayerh264 - Tool for replaying video streams encoded with h264.
+ * Copyright (C) 2016 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef H264FRAMEINDEX_H_
+#define H264FRAMEINDEX_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace odplayerh264 {
+
+    using namespace std;
+
+    /**
+     * This class describes one encoded frame (access unit) in an .h264 file.
+     */
+    class H264FrameIndexEntry {
+        public:
+            H264FrameIndexEntry();
+            H264FrameIndexEntry(const uint32_t &frameIdentifier, const uint64_t &offset, const uint32_t &size, const bool &isKeyFrame);
+
+        public:
+            uint32_t m_frameIdentifier;
+            uint64_t m_offset;
+            uint32_t m_size;
+            bool m_isKeyFrame;
+    };
+
+    /**
+     * This class maps the frame identifiers from H264Frame messages to the
+     * byte ranges in the corresponding .h264 file. It is either loaded from
+     * the .h264.idx file written by odrecorderh264 or reconstructed by
+     * scanning the Annex B byte stream for access unit boundaries.
+     */
+    class H264FrameIndex {
+        public:
+            H264FrameIndex();
+
+            /**
+             * This method loads the index for the given .h264 file. If no
+             * .h264.idx file is available, the .h264 file is scanned and the
+             * resulting index is stored for the next run.
+             *
+             * @param h264Filename Name of the .h264 file.
+             * @param firstFrameIdentifier Frame identifier to be assigned to the first access unit when scanning.
+             * @return true if the index contains at least one entry.
+             */
+            bool load(const string &h264Filename, const uint32_t &firstFrameIdentifier);
+
+            /**
+             * @return Number of entries in the index.
+             */
+            uint32_t size() const;
+
+            /**
+             * @param position Position in the index.
+             * @return Entry at the given position.
+             */
+            const H264FrameIndexEntry& getEntry(const uint32_t &position) const;
+
+            /**
+             * This method returns the position of the entry for the given
+             * frame identifier or of the next entry following it.
+             *
+             * @param frameIdentifier Frame identifier to find.
+             * @return Position in the index; size() if not found.
+             */
+            uint32_t findPosition(const uint32_t &frameIdentifier) const;
+
+            /**
+             * This method returns the position of the nearest keyframe
+             * (IDR) that precedes or equals the given frame identifier.
+             *
+             * @param frameIdentifier Frame identifier to seek to.
+             * @return Position in the index to start decoding from.
+             */
+            uint32_t findPositionOfPrecedingKeyFrame(const uint32_t &frameIdentifier) const;
+
+        private:
+            bool readIndexFile(const string &indexFilename);
+            bool scanH264File(const string &h264Filename, const uint32_t &firstFrameIdentifier);
+            void writeIndexFile(const string &indexFilename) const;
+
+        private:
+            vector<H264FrameIndexEntry> m_entries;
+            vector<uint32_t> m_keyFramePositions;
+    };
+
+} // odplayerh264
+
+#endif /*H264FRAMEINDEX_H_*/
@@ -42,6 +42,11 @@ namespace odplayerh264 {
      */
     class PlayerH264 : public odtools::player::Player,
                        public odtools::player::PlayerDelegate {
+        public:
+            enum {
+                DEFAULT_NUMBER_OF_FRAMES_TO_DECODE_AHEAD = 10,
+            };
+
         private:
             /**
              * "Forbidden" copy constructor. Goal: The compiler should warn
@@ -86,6 +91,19 @@ namespace odplayerh264 {
              */
             PlayerH264(const odcore::io::URL &url, const bool &autoRewind, const uint32_t &memorySegmentSize, const uint32_t &numberOfMemorySegments, const bool &threading, const uint32_t &basePort);
 
+            /**
+             * Constructor.
+             *
+             * @param url Resource to play.
+             * @param autoRewind True if the file should be rewind at EOF.
+             * @param memorySegmentSize Size of the memory segment to be used for buffering.
+             * @param numberOfMemorySegments Number of memory segments to be used for buffering.
+             * @param threading If set to true, player will load new containers from the files in background.
+             * @param basePort Base port for letting spawned children connect to the parent process.
+             * @param decodeAhead Number of frames to be decoded ahead in background per video stream (0 = decode on demand).
+             */
+            PlayerH264(const odcore::io::URL &url, const bool &autoRewind, const uint32_t &memorySegmentSize, const uint32_t &numberOfMemorySegments, const bool &threading, const uint32_t &basePort, const uint32_t &decodeAhead);
+
             virtual ~PlayerH264();
 
             virtual odcore::data::Container process(odcore::data::Container &c);
@@ -97,6 +115,7 @@ namespace odplayerh264 {
             shared_ptr<PlayerH264Decoder> m_singleDecoder;
 
             uint32_t m_basePort;
+            uint32_t m_decodeAhead;
 
             odcore::base::Mutex m_mapOfDecodersMutex;
             map<string, shared_ptr<PlayerH264ChildHandler> > m_mapOfDecoders;
@@ -29,9 +29,12 @@ extern "C" {
     #include <libswscale/swscale.h>
 }
 
+#include <deque>
 #include <memory>
+#include <thread>
 #include <vector>
 
+#include <opendavinci/odcore/base/Condition.h>
 #include <opendavinci/odcore/base/Mutex.h>
 #include <opendavinci/odcore/io/ConnectionListener.h>
 #include <opendavinci/odcore/io/StringListener.h>
@@ -42,10 +45,24 @@ extern "C" {
 
 #include <opendavinci/odtools/player/PlayerDelegate.h>
 
+#include "H264FrameIndex.h"
+
 namespace odplayerh264 {
 
     using namespace std;
 
+    /**
+     * This class holds one decoded frame in BGR24 format.
+     */
+    class DecodedFrame {
+        public:
+            DecodedFrame();
+
+        public:
+            uint32_t m_frameIdentifier;
+            vector<uint8_t> m_data;
+    };
+
     /**
      * This class can be used to replay previously recorded data using a
      * conference for distribution. In addition, this class is also
@@ -77,15 +94,18 @@ namespace odplayerh264 {
         public:
             /**
              * Constructor for H264 single decoder mode (one stream only!).
+             *
+             * @param decodeAhead Number of frames to be decoded ahead in background (0 = decode on demand).
              */
-            PlayerH264Decoder();
+            PlayerH264Decoder(const uint32_t &decodeAhead);
 
             /**
              * Constructor.
              *
              * @param Port to connect to the parent process.
+             * @param decodeAhead Number of frames to be decoded ahead in background (0 = decode on demand).
              */
-            PlayerH264Decoder(const uint32_t &port);
+            PlayerH264Decoder(const uint32_t &port, const uint32_t &decodeAhead);
 
             virtual ~PlayerH264Decoder();
 
@@ -108,9 +128,10 @@ namespace odplayerh264 {
              * This method initializes the h.264 decoder.
              *
              * @param filename Name of the file to read data from.
+             * @param firstFrameIdentifier Identifier of the first H264Frame in the recording.
              * @return true if initialization succeeded.
              */
-            bool initialize(const string &filename);
+            bool initialize(const string &filename, const uint32_t &firstFrameIdentifier);
 
             /**
              * This method is cleaning up the encoding.
@@ -118,35 +139,72 @@ namespace odplayerh264 {
             void stopAndCleanUpDecoding();
 
             /**
-             * This method returns the next frame from the given h264 file.
+             * This method copies the frame with the given identifier into
+             * the shared memory segment. If the requested frame is not
+             * next in the decoding order (for instance after a rewind),
+             * decoding is restarted from the nearest preceding keyframe.
              *
+             * @param frameIdentifier Identifier of the frame to be provided.
              * @return true if succeeded; the shared memory segment contains the decoded frame in BGR24 format.
              */
-            bool getNextFrame();
+            bool getFrame(const uint32_t &frameIdentifier);
 
             /**
-             * This method fills up the internal buffe with bytes.
+             * This method returns the next frame when decoding on demand.
              *
-             * @return The amount of bytes read into the internal buffer.
+             * @param frameIdentifier Identifier of the frame to be provided.
+             * @return true if succeeded.
              */
-            int fillBuffer();
+            bool getFrameOnDemand(const uint32_t &frameIdentifier);
 
             /**
-             * This method is called whenever more bytes in the internal buffer
-             * are needed.
+             * This method returns the next frame from the decode-ahead queue.
              *
-             * @param readMoreBytes indicate whether we need to read more bytes.
+             * @param frameIdentifier Identifier of the frame to be provided.
              * @return true if succeeded.
              */
-            bool update(bool &readMoreBytes);
+            bool getFrameFromQueue(const uint32_t &frameIdentifier);
+
+            /**
+             * This method checks whether reaching the given frame requires
+             * to seek instead of continuing to decode at m_nextPosition.
+             *
+             * @param frameIdentifier Identifier of the frame to be provided.
+             * @return true if seeking is required.
+             */
+            bool isSeekRequired(const uint32_t &frameIdentifier) const;
+
+            /**
+             * This method repositions the decoder to the nearest keyframe
+             * preceding the given frame identifier.
+             *
+             * @param frameIdentifier Identifier of the frame to seek to.
+             */
+            void seek(const uint32_t &frameIdentifier);
+
+            /**
+             * This method decodes the index entry at m_nextPosition or,
+             * after the last index entry, drains the pictures delayed
+             * by the decoder.
+             *
+             * @param frame Decoded frame in BGR24 format; its identifier is set for every picture returned by the decoder.
+             * @param minimumFrameIdentifier Pictures before this frame are decoded but not converted.
+             * @return true if the decoder returned a picture.
+             */
+            bool decodeNextFrame(DecodedFrame &frame, const uint32_t &minimumFrameIdentifier);
 
             /**
-             * This method does the actual decoding.
+             * This method copies a decoded frame into the shared memory.
              *
-             * @param data Raw h264-encoded data.
-             * @param size Size of encoded data.
+             * @param frame Decoded frame.
              */
-            void decodeFrame(uint8_t *data, uint32_t size);
+            void copyToSharedMemory(const DecodedFrame &frame);
+
+            /**
+             * This method is run by the decoding thread to keep the queue
+             * filled with the next frames.
+             */
+            void decodeAhead();
 
         private:
             shared_ptr<odcore::io::tcp::TCPConnection> m_connection;
@@ -167,11 +225,20 @@ namespace odplayerh264 {
             // Counter for successfully decoded frames.
             uint32_t m_frameCounter;
 
-            // Buffer to read from video file.
-            uint8_t *m_readFromFileBuffer;
+            // Byte ranges and keyframes of all frames in the .h264 file.
+            H264FrameIndex m_index;
+
+            // Position in m_index of the next frame to be decoded.
+            uint32_t m_nextPosition;
+
+            // Identifier following the last picture returned by the decoder.
+            uint32_t m_nextFrameIdentifier;
 
-            // Internal buffer to handle processed and unprocessed data.
-            vector<uint8_t> m_internalBuffer;
+            // The decoder returned all delayed pictures after the last index entry.
+            bool m_isDrained;
+
+            // Buffer holding the encoded frame read from the video file.
+            vector<uint8_t> m_encodedFrame;
 
             // Handle to input file.
             FILE *m_inputFile;
@@ -179,17 +246,25 @@ namespace odplayerh264 {
             // Decoder context.
             AVCodecContext *m_decodeContext;
 
-            // Parser for decoding.
-            AVCodecParserContext *m_parser;
-
             // Picture will hold the decoded picture.
             AVFrame* m_picture;
 
             // Image pixel transformation context.
             SwsContext *m_pixelTransformationContext;
 
-            // We return the image in BGR pixel format; thus, we need to transform the data from the decoder.
-            AVFrame *m_frameBGR;
+        private:
+            // Number of frames to be decoded ahead in background.
+            const uint32_t m_decodeAhead;
+
+            // Queue of frames decoded ahead; m_decodedFramesCondition protects all fields below.
+            odcore::base::Condition m_decodedFramesCondition;
+            deque<DecodedFrame> m_decodedFrames;
+            deque<vector<uint8_t> > m_recycledBuffers;
+            bool m_decodingThreadRunning;
+            bool m_endOfStream;
+            bool m_seekRequested;
+            uint32_t m_seekToFrameIdentifier;
+            std::thread m_decodingThread;
     };
 
 } // odplayerh264
@@ -0,0 +1,226 @@
+/**
+ * odplayerh264 - Tool for replaying video streams encoded with h264.
+ * Copyright (C) 2016 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "H264FrameIndex.h"
+
+namespace odplayerh264 {
+
+    using namespace std;
+
+    H264FrameIndexEntry::H264FrameIndexEntry() :
+        H264FrameIndexEntry(0, 0, 0, false) {}
+
+    H264FrameIndexEntry::H264FrameIndexEntry(const uint32_t &frameIdentifier, const uint64_t &offset, const uint32_t &size, const bool &isKeyFrame) :
+        m_frameIdentifier(frameIdentifier),
+        m_offset(offset),
+        m_size(size),
+        m_isKeyFrame(isKeyFrame) {}
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    H264FrameIndex::H264FrameIndex() :
+        m_entries(),
+        m_keyFramePositions() {}
+
+    bool H264FrameIndex::load(const string &h264Filename, const uint32_t &firstFrameIdentifier) {
+        m_entries.clear();
+        m_keyFramePositions.clear();
+
+        const string INDEX_FILENAME = h264Filename + ".idx";
+        if (!readIndexFile(INDEX_FILENAME)) {
+            m_entries.clear();
+            clog << "[odplayerh264] No usable " << INDEX_FILENAME << "; scanning " << h264Filename << "." << endl;
+            if (scanH264File(h264Filename, firstFrameIdentifier)) {
+                writeIndexFile(INDEX_FILENAME);
+            }
+        }
+
+        // The stream always starts with a decodable frame.
+        if ( (m_entries.size() > 0) && (!m_entries[0].m_isKeyFrame) ) {
+            m_entries[0].m_isKeyFrame = true;
+        }
+        for (uint32_t i = 0; i < m_entries.size(); i++) {
+            if (m_entries[i].m_isKeyFrame) {
+                m_keyFramePositions.push_back(i);
+            }
+        }
+
+        clog << "[odplayerh264] Index for " << h264Filename << " contains " << m_entries.size() << " frames and " << m_keyFramePositions.size() << " keyframes." << endl;
+        return (m_entries.size() > 0);
+    }
+
+    uint32_t H264FrameIndex::size() const {
+        return m_entries.size();
+    }
+
+    const H264FrameIndexEntry& H264FrameIndex::getEntry(const uint32_t &position) const {
+        return m_entries.at(position);
+    }
+
+    uint32_t H264FrameIndex::findPosition(const uint32_t &frameIdentifier) const {
+        auto it = std::lower_bound(m_entries.begin(), m_entries.end(), frameIdentifier,
+                                   [](const H264FrameIndexEntry &e, const uint32_t &id) { return e.m_frameIdentifier < id; });
+        return static_cast<uint32_t>(it - m_entries.begin());
+    }
+
+    uint32_t H264FrameIndex::findPositionOfPrecedingKeyFrame(const uint32_t &frameIdentifier) const {
+        uint32_t position = findPosition(frameIdentifier);
+        if ( (position < m_entries.size()) && (m_entries[position].m_frameIdentifier > frameIdentifier) && (position > 0) ) {
+            position--;
+        }
+
+        // Find the last keyframe at or before position.
+        auto it = std::upper_bound(m_keyFramePositions.begin(), m_keyFramePositions.end(), position);
+        return (it == m_keyFramePositions.begin()) ? 0 : *(--it);
+    }
+
+    bool H264FrameIndex::readIndexFile(const string &indexFilename) {
+        ifstream in(indexFilename.c_str());
+        if (!in.good()) {
+            return false;
+        }
+
+        string line;
+        while (getline(in, line)) {
+            if (line.empty()) {
+                continue;
+            }
+
+            stringstream sstr(line);
+            H264FrameIndexEntry e;
+            uint32_t isKeyFrame = 0;
+            sstr >> e.m_frameIdentifier >> e.m_offset >> e.m_size >> isKeyFrame;
+            if (sstr.fail()) {
+                cerr << "[odplayerh264] Ignoring corrupt " << indexFilename << "." << endl;
+                return false;
+            }
+            e.m_isKeyFrame = (isKeyFrame != 0);
+
+            // Frame identifiers need to be strictly increasing to allow binary search.
+            if ( (m_entries.size() > 0) && (m_entries.back().m_frameIdentifier >= e.m_frameIdentifier) ) {
+                cerr << "[odplayerh264] Ignoring unsorted " << indexFilename << "." << endl;
+                return false;
+            }
+            m_entries.push_back(e);
+        }
+
+        return (m_entries.size() > 0);
+    }
+
+    bool H264FrameIndex::scanH264File(const string &h264Filename, const uint32_t &firstFrameIdentifier) {
+        ifstream in(h264Filename.c_str(), ios::binary);
+        if (!in.good()) {
+            return false;
+        }
+
+        // NAL unit types according to ITU-T H.264, Table 7-1.
+        enum NAL_UNIT_TYPE {
+            NAL_SLICE = 1,
+            NAL_IDR_SLICE = 5,
+            NAL_SEI = 6,
+            NAL_SPS = 7,
+            NAL_PPS = 8,
+            NAL_AUD = 9,
+        };
+
+        const uint32_t CHUNK_SIZE = 1024 * 1024;
+        vector<char> chunk(CHUNK_SIZE);
+
+        uint32_t frameIdentifier = firstFrameIdentifier;
+        uint64_t offset = 0;
+        uint32_t zeros = 0;
+        uint32_t bytesAfterStartCode = 0;
+        bool collectingNalHeader = false;
+        uint8_t nalHeader = 0;
+        uint64_t nalStart = 0;
+
+        uint64_t accessUnitStart = 0;
+        bool accessUnitHasSlice = false;
+        bool accessUnitIsKeyFrame = false;
+
+        while (in.good()) {
+            in.read(&chunk[0], CHUNK_SIZE);
+            const uint32_t LENGTH = static_cast<uint32_t>(in.gcount());
+
+            for (uint32_t i = 0; i < LENGTH; i++, offset++) {
+                const uint8_t BYTE = static_cast<uint8_t>(chunk[i]);
+
+                if (collectingNalHeader) {
+                    if (0 == bytesAfterStartCode) {
+                        nalHeader = BYTE;
+                        bytesAfterStartCode++;
+                        continue;
+                    }
+
+                    // The second byte starts the slice header; first_mb_in_slice == 0 is encoded as a leading 1 bit.
+                    collectingNalHeader = false;
+                    const uint8_t TYPE = (nalHeader & 0x1F);
+                    const bool IS_SLICE = (NAL_SLICE <= TYPE) && (TYPE <= NAL_IDR_SLICE);
+                    const bool IS_FIRST_SLICE = IS_SLICE && ((BYTE & 0x80) != 0);
+                    const bool STARTS_NEW_ACCESS_UNIT = (TYPE == NAL_SEI) || (TYPE == NAL_SPS) || (TYPE == NAL_PPS) || (TYPE == NAL_AUD) || IS_FIRST_SLICE;
+
+                    if (STARTS_NEW_ACCESS_UNIT && accessUnitHasSlice) {
+                        m_entries.push_back(H264FrameIndexEntry(frameIdentifier++, accessUnitStart, static_cast<uint32_t>(nalStart - accessUnitStart), accessUnitIsKeyFrame));
+                        accessUnitStart = nalStart;
+                        accessUnitHasSlice = false;
+                        accessUnitIsKeyFrame = false;
+                    }
+                    if (IS_SLICE) {
+                        accessUnitHasSlice = true;
+                        accessUnitIsKeyFrame |= (TYPE == NAL_IDR_SLICE);
+                    }
+                }
+
+                // Detect start code 0x000001 (or 0x00000001).
+                if (0 == BYTE) {
+                    zeros++;
+                }
+                else {
+                    if ( (1 == BYTE) && (zeros >= 2) ) {
+                        nalStart = offset - std::min<uint32_t>(zeros, 3);
+                        collectingNalHeader = true;
+                        bytesAfterStartCode = 0;
+                    }
+                    zeros = 0;
+                }
+            }
+        }
+
+        if (accessUnitHasSlice) {
+            m_entries.push_back(H264FrameIndexEntry(frameIdentifier, accessUnitStart, static_cast<uint32_t>(offset - accessUnitStart), accessUnitIsKeyFrame));
+        }
+
+        return (m_entries.size() > 0);
+    }
+
+    void H264FrameIndex::writeIndexFile(const string &indexFilename) const {
+        ofstream out(indexFilename.c_str(), ios::out | ios::trunc);
+        if (out.good()) {
+            for (auto it = m_entries.begin(); it != m_entries.end(); it++) {
+                out << it->m_frameIdentifier << " " << it->m_offset << " " << it->m_size << " " << (it->m_isKeyFrame ? 1 : 0) << "\n";
+            }
+        }
+    }
+
+} // odplayerh264
@@ -46,10 +46,11 @@ namespace odplayerh264 {
     using namespace odtools::player;
 
     uint32_t basePortForChildProcesses = 1234;
+    uint32_t decodeAheadForChildProcesses = PlayerH264::DEFAULT_NUMBER_OF_FRAMES_TO_DECODE_AHEAD;
 
     __attribute__((noreturn))
     void handleInChild(int id) {
-        PlayerH264Decoder decoder(basePortForChildProcesses + id);
+        PlayerH264Decoder decoder(basePortForChildProcesses + id, decodeAheadForChildProcesses);
 
         const uint32_t ONE_SECOND = 1000 * 1000;
         while (decoder.hasConnection()) {
@@ -66,12 +67,17 @@ namespace odplayerh264 {
         PlayerH264(url, autoRewind, memorySegmentSize, numberOfMemorySegments, threading, 0) {}
 
     PlayerH264::PlayerH264(const odcore::io::URL &url, const bool &autoRewind, const uint32_t &memorySegmentSize, const uint32_t &numberOfMemorySegments, const bool &threading, const uint32_t &basePort) :
+        PlayerH264(url, autoRewind, memorySegmentSize, numberOfMemorySegments, threading, basePort, PlayerH264::DEFAULT_NUMBER_OF_FRAMES_TO_DECODE_AHEAD) {}
+
+    PlayerH264::PlayerH264(const odcore::io::URL &url, const bool &autoRewind, const uint32_t &memorySegmentSize, const uint32_t &numberOfMemorySegments, const bool &threading, const uint32_t &basePort, const uint32_t &decodeAhead) :
         Player(url, autoRewind, memorySegmentSize, numberOfMemorySegments, threading),
         m_singleDecoder(NULL),
         m_basePort(basePort),
+        m_decodeAhead(decodeAhead),
         m_mapOfDecodersMutex(),
         m_mapOfDecoders() {
         basePortForChildProcesses = basePort;
+        decodeAheadForChildProcesses = decodeAhead;
 
         // Register all codecs from FFMPEG.
         avcodec_register_all();
@@ -130,7 +136,7 @@ namespace odplayerh264 {
                 if (NULL == m_singleDecoder.get()) {
                     // Test if the mentioned .h264 file is existing.
                     if (checkIfH264FileExists(h264frame.getH264Filename())) {
-                        m_singleDecoder = shared_ptr<PlayerH264Decoder>(new PlayerH264Decoder());
+                        m_singleDecoder = shared_ptr<PlayerH264Decoder>(new PlayerH264Decoder(m_decodeAhead));
                     }
                 }
                 else {
@@ -17,6 +17,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <string>
@@ -55,12 +56,16 @@ namespace odplayerh264 {
     using namespace odcore::io::tcp;
     using namespace odtools::player;
 
-    const uint32_t BUFFER_SIZE = 16384;
+    DecodedFrame::DecodedFrame() :
+        m_frameIdentifier(0),
+        m_data() {}
 
-    PlayerH264Decoder::PlayerH264Decoder() :
-        PlayerH264Decoder(0) {}
+    ///////////////////////////////////////////////////////////////////////////
 
-    PlayerH264Decoder::PlayerH264Decoder(const uint32_t &port) :
+    PlayerH264Decoder::PlayerH264Decoder(const uint32_t &decodeAhead) :
+        PlayerH264Decoder(0, decodeAhead) {}
+
+    PlayerH264Decoder::PlayerH264Decoder(const uint32_t &port, const uint32_t &decodeAhead) :
         m_connection(),
         m_hasConnectionMutex(),
         m_hasConnection(false),
@@ -69,14 +74,24 @@ namespace odplayerh264 {
         m_mySharedMemory(NULL),
         m_mySharedImage(),
         m_frameCounter(0),
-        m_readFromFileBuffer(NULL),
-        m_internalBuffer(),
+        m_index(),
+        m_nextPosition(0),
+        m_nextFrameIdentifier(0),
+        m_isDrained(false),
+        m_encodedFrame(),
         m_inputFile(NULL),
         m_decodeContext(NULL),
-        m_parser(NULL),
         m_picture(NULL),
         m_pixelTransformationContext(NULL),
-        m_frameBGR(NULL) {
+        m_decodeAhead(decodeAhead),
+        m_decodedFramesCondition(),
+        m_decodedFrames(),
+        m_recycledBuffers(),
+        m_decodingThreadRunning(false),
+        m_endOfStream(false),
+        m_seekRequested(false),
+        m_seekToFrameIdentifier(0),
+        m_decodingThread() {
         if (0 < port) {
             // Try to connect to odrecorderh264 process to exchange Containers to encode.
             try {
@@ -93,9 +108,6 @@ namespace odplayerh264 {
                 cerr << "[odplayerh264] Could not connect to odplayerh264: " << exception << endl;
             }
         }
-
-        // Create a buffer to read from file.
-        m_readFromFileBuffer = new uint8_t[BUFFER_SIZE + FF_INPUT_BUFFER_PADDING_SIZE];
     }
 
     PlayerH264Decoder::~PlayerH264Decoder() {
@@ -116,30 +128,49 @@ namespace odplayerh264 {
 
     void PlayerH264Decoder::stopAndCleanUpDecoding() {
         if (m_ready) {
+            m_ready = false;
+
+            // Stop decoding thread before releasing the decoder.
+            {
+                Lock l(m_decodedFramesCondition);
+                m_decodingThreadRunning = false;
+                m_decodedFramesCondition.wakeAll();
+            }
+            if (m_decodingThread.joinable()) {
+                m_decodingThread.join();
+            }
+
             // Release shared memory.
             m_mySharedMemory.reset();
-            m_ready = false;
 
             // Close decoder.
-            av_parser_close(m_parser);
-            avcodec_close(m_decodeContext);
+            if (m_decodeContext != NULL) {
+                avcodec_close(m_decodeContext);
+                av_free(m_decodeContext);
+                m_decodeContext = NULL;
+            }
 
             // Free acquired memory.
-            av_free(m_decodeContext);
-            av_free(m_picture);
-            av_free(m_frameBGR);
+            if (m_picture != NULL) {
+                av_frame_free(&m_picture);
+            }
+            if (m_pixelTransformationContext != NULL) {
+                sws_freeContext(m_pixelTransformationContext);
+                m_pixelTransformationContext = NULL;
+            }
 
             // Close input file.
-            fclose(m_inputFile);
-
-            // Free buffer.
-            m_internalBuffer.clear();
-            if (m_readFromFileBuffer != NULL) {
-                delete [] m_readFromFileBuffer;
-                m_readFromFileBuffer = NULL;
+            if (m_inputFile != NULL) {
+                fclose(m_inputFile);
+                m_inputFile = NULL;
             }
 
-            cout << "[odplayerh264] Cleaned h264 decoding child." << endl;
+            // Free buffers.
+            m_encodedFrame.clear();
+            m_decodedFrames.clear();
+            m_recycledBuffers.clear();
+
+            cout << "[odplayerh264] Cleaned h264 decoding child after decoding " << m_frameCounter << " frames." << endl;
         }
     }
 
@@ -173,12 +204,12 @@ namespace odplayerh264 {
 
             // If not initialized, initialze the h.264 decoder structure.
             if (!m_initialized) {
-                m_initialized = initialize(h264frame.getH264Filename());
+                m_initialized = initialize(h264frame.getH264Filename(), h264frame.getFrameIdentifier());
             }
 
-            // If we have a valid shared memory segment, decode next frame.
-            if (m_mySharedMemory->isValid()) {
-                if (getNextFrame()) {
+            // If we have a valid shared memory segment, provide the requested frame.
+            if (m_initialized && m_mySharedMemory->isValid()) {
+                if (getFrame(h264frame.getFrameIdentifier())) {
                     replacementContainer = Container(m_mySharedImage);
                     replacementContainer.setSentTimeStamp(c.getSentTimeStamp());
                     replacementContainer.setReceivedTimeStamp(c.getReceivedTimeStamp());
@@ -190,7 +221,7 @@ namespace odplayerh264 {
         return replacementContainer;
     }
 
-    bool PlayerH264Decoder::initialize(const string &filename) {
+    bool PlayerH264Decoder::initialize(const string &filename, const uint32_t &firstFrameIdentifier) {
         bool retVal = false;
 
         // Acquire shared memory.
@@ -199,20 +230,6 @@ namespace odplayerh264 {
         }
 
         if (m_mySharedMemory->isValid()) {
-            // Allocating memory to hold resulting image.
-            m_frameBGR = av_frame_alloc();
-            if (!m_frameBGR) {
-                cerr << "[odplayerh264] Could not allocate buffer for resulting frame." << endl;
-                return false;
-            }
-
-            // Acquire memory for raw picture.
-            const uint32_t BYTES = avpicture_get_size(AVPixelFormat::AV_PIX_FMT_BGR24, m_mySharedImage.getWidth(), m_mySharedImage.getHeight());
-            uint8_t *myPixelBuffer = static_cast<uint8_t*>(av_malloc(BYTES * sizeof(uint8_t)));
-            avpicture_fill(reinterpret_cast<AVPicture*>(m_frameBGR),
-                           myPixelBuffer, AVPixelFormat::AV_PIX_FMT_BGR24,
-                           m_mySharedImage.getWidth(), m_mySharedImage.getHeight());
-
             // Image pixel transformation context to transform from YUV420p to BGR24.
             m_pixelTransformationContext = sws_getContext(m_mySharedImage.getWidth(), m_mySharedImage.getHeight(),
                                  AVPixelFormat::AV_PIX_FMT_YUV420P, m_mySharedImage.getWidth(), m_mySharedImage.getHeight(),
@@ -225,14 +242,9 @@ namespace odplayerh264 {
                 return false;
             }
 
-            // Configure decoding context.
+            // Configure decoding context; complete access units are handed over from the index.
             m_decodeContext = avcodec_alloc_context3(decodeCodec);
 
-            // Allow partial data handed over from file to decoder.
-            if (decodeCodec->capabilities & CODEC_CAP_TRUNCATED) {
-                m_decodeContext->flags |= CODEC_FLAG_TRUNCATED;
-            }
-
             // Open actual codec.
             if (avcodec_open2(m_decodeContext, decodeCodec, NULL) < 0) {
                 cerr << "[odplayerh264] Could not open codec h264 with given parameters." << endl;
@@ -249,116 +261,285 @@ namespace odplayerh264 {
             // Allocate picture buffer.
             m_picture = av_frame_alloc();
 
-            // Initialize decoding parser.
-            m_parser = av_parser_init(AV_CODEC_ID_H264);
-            if (!m_parser) {
-                cerr << "[odplayerh264] Could not create h264 parser." << endl;
+            // Load or build the index of frames and keyframes.
+            if (!m_index.load(filename, firstFrameIdentifier)) {
+                cerr << "[odplayerh264] Could not index " << filename << endl;
                 return false;
             }
+            m_nextPosition = 0;
+            m_nextFrameIdentifier = 0;
+            m_isDrained = false;
 
-            // Fill buffer from file.
-            fillBuffer();
+            // Start decoding ahead in background.
+            if (m_decodeAhead > 0) {
+                {
+                    Lock l(m_decodedFramesCondition);
+                    m_decodingThreadRunning = true;
+                    m_endOfStream = false;
+                }
+                m_decodingThread = std::thread(&PlayerH264Decoder::decodeAhead, this);
+            }
 
-            clog << "[odplayerh264] h264 decoder initialized." << endl;
+            clog << "[odplayerh264] h264 decoder initialized (decoding " << m_decodeAhead << " frames ahead)." << endl;
             retVal = true;
         }
         return retVal;
     }
 
-    bool PlayerH264Decoder::getNextFrame() {
-        bool readMore = false;
+    bool PlayerH264Decoder::getFrame(const uint32_t &frameIdentifier) {
+        return (m_decodeAhead > 0) ? getFrameFromQueue(frameIdentifier) : getFrameOnDemand(frameIdentifier);
+    }
 
-        // Decode next frame (or fill buffer if needed).
-        while (!update(readMore)) {
-            if (readMore) {
-                fillBuffer();
-            }
+    bool PlayerH264Decoder::isSeekRequired(const uint32_t &frameIdentifier) const {
+        // The requested frame was skipped by the decoder (for instance after a rewind).
+        if (!m_decodedFrames.empty()) {
+            return (m_decodedFrames.front().m_frameIdentifier > frameIdentifier);
+        }
+
+        // The requested frame was already returned by the decoder or a keyframe is closer than continuing.
+        return (frameIdentifier < m_nextFrameIdentifier)
+            || (m_index.findPositionOfPrecedingKeyFrame(frameIdentifier) > m_nextPosition);
+    }
+
+    void PlayerH264Decoder::seek(const uint32_t &frameIdentifier) {
+        m_nextPosition = m_index.findPositionOfPrecedingKeyFrame(frameIdentifier);
+        m_nextFrameIdentifier = 0;
+        m_isDrained = false;
+        m_seekToFrameIdentifier = frameIdentifier;
+        avcodec_flush_buffers(m_decodeContext);
+
+        clog << "[odplayerh264] Seeking to frame " << frameIdentifier << " starting at keyframe " << m_index.getEntry(m_nextPosition).m_frameIdentifier << "." << endl;
+    }
 
-            // Leave loop if EOF.
-            if (feof(m_inputFile)) {
+    bool PlayerH264Decoder::getFrameOnDemand(const uint32_t &frameIdentifier) {
+        if (isSeekRequired(frameIdentifier)) {
+            // Frame is not contained in the stream.
+            if (m_seekToFrameIdentifier == frameIdentifier) {
                 return false;
             }
+            seek(frameIdentifier);
         }
 
-        return true;
-    }
+        DecodedFrame frame;
+        if (!m_recycledBuffers.empty()) {
+            frame.m_data.swap(m_recycledBuffers.front());
+            m_recycledBuffers.pop_front();
+        }
+
+        bool retVal = false;
+        while ( (m_nextPosition < m_index.size()) || !m_isDrained ) {
+            const bool HAS_PICTURE = decodeNextFrame(frame, frameIdentifier);
+            if (m_nextPosition < m_index.size()) {
+                m_nextPosition++;
+            }
 
-    int PlayerH264Decoder::fillBuffer() {
-        int32_t nbytes = static_cast<int32_t>(fread(m_readFromFileBuffer, sizeof(uint8_t), BUFFER_SIZE, m_inputFile));
+            if (HAS_PICTURE) {
+                m_nextFrameIdentifier = frame.m_frameIdentifier + 1;
 
-        if (nbytes > 0) {
-            // Add bytes from file to our internal buffer.
-            copy(m_readFromFileBuffer, m_readFromFileBuffer + nbytes, back_inserter(m_internalBuffer));
+                // The decoder returns pictures delayed; continue until the requested or a later one is returned.
+                if (frame.m_frameIdentifier >= frameIdentifier) {
+                    if ((retVal = (frame.m_frameIdentifier == frameIdentifier))) {
+                        copyToSharedMemory(frame);
+                        m_seekToFrameIdentifier = 0;
+                    }
+                    break;
+                }
+            }
         }
 
-        return nbytes;
+        m_recycledBuffers.push_back(vector<uint8_t>());
+        m_recycledBuffers.back().swap(frame.m_data);
+        return retVal;
     }
 
-    bool PlayerH264Decoder::update(bool &readMoreBytes) {
-        readMoreBytes = false;
+    bool PlayerH264Decoder::getFrameFromQueue(const uint32_t &frameIdentifier) {
+        DecodedFrame frame;
+        bool found = false;
+        {
+            Lock l(m_decodedFramesCondition);
+            while (m_decodingThreadRunning && !found) {
+                // Drop frames that the Player has skipped.
+                while (!m_decodedFrames.empty() && (m_decodedFrames.front().m_frameIdentifier < frameIdentifier)) {
+                    m_recycledBuffers.push_back(vector<uint8_t>());
+                    m_recycledBuffers.back().swap(m_decodedFrames.front().m_data);
+                    m_decodedFrames.pop_front();
+                    m_decodedFramesCondition.wakeAll();
+                }
 
-        if (feof(m_inputFile)) {
-            return false;
-        }
+                if (!m_decodedFrames.empty() && (m_decodedFrames.front().m_frameIdentifier == frameIdentifier)) {
+                    frame = std::move(m_decodedFrames.front());
+                    m_decodedFrames.pop_front();
+                    m_seekToFrameIdentifier = 0;
+                    m_decodedFramesCondition.wakeAll();
+                    found = true;
+                    break;
+                }
 
-        if (!m_inputFile) {
-            cerr << "[odplayerh264] Cannot read from file." << endl;
-            return false;
-        }
+                if (!m_seekRequested) {
+                    if (isSeekRequired(frameIdentifier)) {
+                        // Frame is not contained in the stream.
+                        if (m_seekToFrameIdentifier == frameIdentifier) {
+                            break;
+                        }
+
+                        // Let the decoding thread restart from the nearest keyframe.
+                        while (!m_decodedFrames.empty()) {
+                            m_recycledBuffers.push_back(vector<uint8_t>());
+                            m_recycledBuffers.back().swap(m_decodedFrames.front().m_data);
+                            m_decodedFrames.pop_front();
+                        }
+                        m_seekRequested = true;
+                        m_seekToFrameIdentifier = frameIdentifier;
+                        m_endOfStream = false;
+                        m_decodedFramesCondition.wakeAll();
+                    }
+                    else if (m_endOfStream && m_decodedFrames.empty()) {
+                        break;
+                    }
+                }
 
-        if (m_internalBuffer.size() == 0) {
-            readMoreBytes = true;
-            return false;
+                m_decodedFramesCondition.waitOnSignal();
+            }
         }
 
-        uint8_t* data = NULL;
-        int size = 0;
-        int length = av_parser_parse2(m_parser, m_decodeContext, &data, &size,
-                                      &m_internalBuffer[0], m_internalBuffer.size(),
-                                      0, 0, AV_NOPTS_VALUE);
+        if (found) {
+            copyToSharedMemory(frame);
 
-        if ((size == 0) && (length >= 0)) {
-            readMoreBytes = true;
-            return false;
+            Lock l(m_decodedFramesCondition);
+            m_recycledBuffers.push_back(vector<uint8_t>());
+            m_recycledBuffers.back().swap(frame.m_data);
         }
 
-        if (length > 0) {
-            decodeFrame(&m_internalBuffer[0], size);
-            m_internalBuffer.erase(m_internalBuffer.begin(), m_internalBuffer.begin() + length);
-            return true;
-        }
+        return found;
+    }
+
+    void PlayerH264Decoder::decodeAhead() {
+        DecodedFrame frame;
+        uint32_t minimumFrameIdentifier = 0;
+
+        while (true) {
+            {
+                Lock l(m_decodedFramesCondition);
+                while ( m_decodingThreadRunning
+                    && !m_seekRequested
+                    && (m_endOfStream || (m_decodedFrames.size() >= m_decodeAhead)) ) {
+                    m_decodedFramesCondition.waitOnSignal();
+                }
+
+                if (!m_decodingThreadRunning) {
+                    break;
+                }
+
+                if (m_seekRequested) {
+                    seek(m_seekToFrameIdentifier);
+                    m_seekRequested = false;
+                }
 
-        return false;
+                if ( (m_nextPosition >= m_index.size()) && m_isDrained ) {
+                    m_endOfStream = true;
+                    m_decodedFramesCondition.wakeAll();
+                    continue;
+                }
+
+                if (!m_recycledBuffers.empty()) {
+                    frame.m_data.swap(m_recycledBuffers.front());
+                    m_recycledBuffers.pop_front();
+                }
+                minimumFrameIdentifier = m_seekToFrameIdentifier;
+            }
+
+            // Decode without holding the lock so that the Player can consume frames concurrently.
+            const bool HAS_PICTURE = decodeNextFrame(frame, minimumFrameIdentifier);
+
+            {
+                Lock l(m_decodedFramesCondition);
+                if (m_nextPosition < m_index.size()) {
+                    m_nextPosition++;
+                }
+                if (HAS_PICTURE) {
+                    m_nextFrameIdentifier = frame.m_frameIdentifier + 1;
+                }
+
+                // Discard the frame if it is only needed as reference or if the Player has requested to seek in the meantime.
+                if (HAS_PICTURE && (frame.m_frameIdentifier >= minimumFrameIdentifier) && !m_seekRequested) {
+                    m_decodedFrames.push_back(std::move(frame));
+                    frame = DecodedFrame();
+                    m_decodedFramesCondition.wakeAll();
+                }
+            }
+        }
     }
 
-    void PlayerH264Decoder::decodeFrame(uint8_t *data, uint32_t size) {
+    bool PlayerH264Decoder::decodeNextFrame(DecodedFrame &frame, const uint32_t &minimumFrameIdentifier) {
         AVPacket packet;
-        int gotPicture = 0;
-        int length = 0;
-
         av_init_packet(&packet);
-        packet.data = data;
-        packet.size = size;
+        packet.data = NULL;
+        packet.size = 0;
+
+        // After the last index entry, empty packets drain the pictures delayed by the decoder.
+        const bool IS_DRAINING = (m_nextPosition >= m_index.size());
+        uint32_t frameIdentifier = 0;
+
+        if (!IS_DRAINING) {
+            const H264FrameIndexEntry &ENTRY = m_index.getEntry(m_nextPosition);
+
+            // Read the encoded frame; the decoder requires zeroed padding at the end.
+            m_encodedFrame.resize(ENTRY.m_size + FF_INPUT_BUFFER_PADDING_SIZE);
+            memset(&m_encodedFrame[ENTRY.m_size], 0, FF_INPUT_BUFFER_PADDING_SIZE);
+            if ( (static_cast<uint64_t>(ftello(m_inputFile)) != ENTRY.m_offset)
+              && (0 != fseeko(m_inputFile, ENTRY.m_offset, SEEK_SET)) ) {
+                cerr << "[odplayerh264] Could not seek to frame " << ENTRY.m_frameIdentifier << "." << endl;
+                return false;
+            }
+            if (fread(&m_encodedFrame[0], sizeof(uint8_t), ENTRY.m_size, m_inputFile) != ENTRY.m_size) {
+                cerr << "[odplayerh264] Could not read frame " << ENTRY.m_frameIdentifier << "." << endl;
+                return false;
+            }
+
+            packet.data = &m_encodedFrame[0];
+            packet.size = ENTRY.m_size;
+            packet.pts = ENTRY.m_frameIdentifier;
+            if (ENTRY.m_isKeyFrame) {
+                packet.flags |= AV_PKT_FLAG_KEY;
+            }
+            frameIdentifier = ENTRY.m_frameIdentifier;
+        }
 
-        length = avcodec_decode_video2(m_decodeContext, m_picture, &gotPicture, &packet);
-        if (length < 0) {
+        int gotPicture = 0;
+        if (avcodec_decode_video2(m_decodeContext, m_picture, &gotPicture, &packet) < 0) {
             cerr << "[odplayerh264] Error while decoding a frame." << endl;
+            m_isDrained = IS_DRAINING;
+            return false;
         }
-        else {
-            if (gotPicture) {
-                m_frameCounter++;
+        if (!gotPicture) {
+            m_isDrained = IS_DRAINING;
+            return false;
+        }
+        m_frameCounter++;
 
-                // cout << "[odplayerh264] Read frame " << m_picture->pts << endl;
+        // The decoder might return pictures delayed; thus, use the pts from the originating packet.
+        frame.m_frameIdentifier = (m_picture->pkt_pts != AV_NOPTS_VALUE) ? static_cast<uint32_t>(m_picture->pkt_pts) : frameIdentifier;
 
-                // Transform from YUV420p into BGR24 format.
-                sws_scale(m_pixelTransformationContext, m_picture->data, m_picture->linesize, 0, m_mySharedImage.getHeight(), m_frameBGR->data, m_frameBGR->linesize);
+        // Frames before the seek target are only needed as references.
+        if (frame.m_frameIdentifier < minimumFrameIdentifier) {
+            return true;
+        }
 
-                // Copy resulting frame into the shared memory segment.
-                if (m_mySharedMemory->isValid()) {
-                    Lock l(m_mySharedMemory);
-                    memcpy(m_mySharedMemory->getSharedMemory(), m_frameBGR->data[0], m_mySharedImage.getWidth() * m_mySharedImage.getHeight() * m_mySharedImage.getBytesPerPixel());
-                }
-            }
+        // Transform from YUV420p into BGR24 format.
+        const uint32_t LINESIZE = m_mySharedImage.getWidth() * m_mySharedImage.getBytesPerPixel();
+        frame.m_data.resize(LINESIZE * m_mySharedImage.getHeight());
+        uint8_t *outData[1] = { &frame.m_data[0] };
+        int outLinesize[1] = { static_cast<int>(LINESIZE) };
+        sws_scale(m_pixelTransformationContext, m_picture->data, m_picture->linesize, 0, m_mySharedImage.getHeight(), outData, outLinesize);
+
+        return true;
+    }
+
+    void PlayerH264Decoder::copyToSharedMemory(const DecodedFrame &frame) {
+        // Copy resulting frame into the shared memory segment.
+        if (m_mySharedMemory->isValid()) {
+            Lock l(m_mySharedMemory);
+            memcpy(m_mySharedMemory->getSharedMemory(), &frame.m_data[0], std::min<uint32_t>(frame.m_data.size(), m_mySharedMemory->getSize()));
         }
     }
 
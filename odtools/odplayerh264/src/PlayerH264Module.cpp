@@ -68,8 +68,15 @@ namespace odplayerh264 {
         // Base port for letting spawned children connect to parent process.
         const uint32_t BASE_PORT = getKeyValueConfiguration().getValue<uint32_t>("odplayerh264.portbaseforchildprocesses");
 
+        // Number of frames to be decoded ahead per video stream.
+        bool decodeAheadFound = false;
+        uint32_t decodeAhead = getKeyValueConfiguration().getOptionalValue<uint32_t>("odplayerh264.decodeAhead", decodeAheadFound);
+        if (!decodeAheadFound) {
+            decodeAhead = PlayerH264::DEFAULT_NUMBER_OF_FRAMES_TO_DECODE_AHEAD;
+        }
+
         // Construct player.
-        PlayerH264 player(url, autoRewind, MEMORY_SEGMENT_SIZE, NUMBER_OF_SEGMENTS, THREADING, BASE_PORT);
+        PlayerH264 player(url, autoRewind, MEMORY_SEGMENT_SIZE, NUMBER_OF_SEGMENTS, THREADING, BASE_PORT, decodeAhead);
 
         // The next container to be sent.
         Container nextContainerToBeSent;
@@ -20,11 +20,16 @@
 #ifndef PLAYERh264TESTSUITE_H_
 #define PLAYERh264TESTSUITE_H_
 
+#include <cstdio>
+#include <fstream>
+#include <string>
+
 #include "cxxtest/TestSuite.h"
 
-//#include "../include/PlayerModule.h"
+#include "../include/H264FrameIndex.h"
 
 using namespace std;
+using namespace odplayerh264;
 
 class PlayerH264ModuleTest : public CxxTest::TestSuite {
     public:
@@ -32,6 +37,85 @@ class PlayerH264ModuleTest : public CxxTest::TestSuite {
             TS_ASSERT(true);
         }
 
+        void testScanH264FileForAccessUnitsAndKeyFrames() {
+            const string FILENAME = "PlayerH264TestSuite.h264";
+            ::remove((FILENAME + ".idx").c_str());
+
+            // Annex B byte stream: SPS, PPS, IDR slice, P slice, P slice, AUD, IDR slice, P slice.
+            const unsigned char STREAM[] = {
+                0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0x00, 0x1E,    // SPS at 0
+                0x00, 0x00, 0x00, 0x01, 0x68, 0xCE, 0x38, 0x80,    // PPS at 8
+                0x00, 0x00, 0x01, 0x65, 0x88, 0x84, 0x21,          // IDR at 16
+                0x00, 0x00, 0x01, 0x41, 0x9A, 0x02, 0x03,          // P at 23
+                0x00, 0x00, 0x01, 0x41, 0x9A, 0x04,                // P at 30
+                0x00, 0x00, 0x00, 0x01, 0x09, 0xF0,                // AUD at 36
+                0x00, 0x00, 0x01, 0x65, 0x88, 0x80,                // IDR at 42
+                0x00, 0x00, 0x01, 0x41, 0x9A, 0x05, 0x06, 0x07     // P at 48
+            };
+            {
+                fstream out(FILENAME.c_str(), ios::out | ios::binary | ios::trunc);
+                out.write(reinterpret_cast<const char*>(STREAM), sizeof(STREAM));
+            }
+
+            H264FrameIndex index;
+            TS_ASSERT(index.load(FILENAME, 10));
+            TS_ASSERT(index.size() == 5);
+
+            TS_ASSERT(index.getEntry(0).m_frameIdentifier == 10);
+            TS_ASSERT(index.getEntry(0).m_offset == 0);
+            TS_ASSERT(index.getEntry(0).m_size == 23);
+            TS_ASSERT(index.getEntry(0).m_isKeyFrame);
+
+            TS_ASSERT(index.getEntry(1).m_offset == 23);
+            TS_ASSERT(index.getEntry(1).m_size == 7);
+            TS_ASSERT(!index.getEntry(1).m_isKeyFrame);
+
+            TS_ASSERT(index.getEntry(2).m_offset == 30);
+            TS_ASSERT(index.getEntry(2).m_size == 6);
+
+            TS_ASSERT(index.getEntry(3).m_frameIdentifier == 13);
+            TS_ASSERT(index.getEntry(3).m_offset == 36);
+            TS_ASSERT(index.getEntry(3).m_size == 12);
+            TS_ASSERT(index.getEntry(3).m_isKeyFrame);
+
+            TS_ASSERT(index.getEntry(4).m_offset == 48);
+            TS_ASSERT(index.getEntry(4).m_size == 8);
+
+            TS_ASSERT(index.findPositionOfPrecedingKeyFrame(10) == 0);
+            TS_ASSERT(index.findPositionOfPrecedingKeyFrame(12) == 0);
+            TS_ASSERT(index.findPositionOfPrecedingKeyFrame(13) == 3);
+            TS_ASSERT(index.findPositionOfPrecedingKeyFrame(14) == 3);
+            TS_ASSERT(index.findPositionOfPrecedingKeyFrame(100) == 3);
+
+            // The scanned index is persisted and reloaded on the next run.
+            H264FrameIndex index2;
+            TS_ASSERT(index2.load(FILENAME, 1));
+            TS_ASSERT(index2.size() == 5);
+            TS_ASSERT(index2.getEntry(0).m_frameIdentifier == 10);
+            TS_ASSERT(index2.getEntry(3).m_isKeyFrame);
+
+            ::remove(FILENAME.c_str());
+            ::remove((FILENAME + ".idx").c_str());
+        }
+
+        void testLoadIndexFileWrittenByRecorder() {
+            const string FILENAME = "PlayerH264TestSuite2.h264";
+            {
+                fstream out((FILENAME + ".idx").c_str(), ios::out | ios::trunc);
+                out << "3 0 100 1" << "\n" << "4 100 20 0" << "\n" << "5 120 20 0" << "\n" << "6 140 90 1" << "\n" << "7 230 20 0" << "\n";
+            }
+
+            H264FrameIndex index;
+            TS_ASSERT(index.load(FILENAME, 1));
+            TS_ASSERT(index.size() == 5);
+            TS_ASSERT(index.findPosition(5) == 2);
+            TS_ASSERT(index.findPosition(8) == 5);
+            TS_ASSERT(index.findPositionOfPrecedingKeyFrame(5) == 0);
+            TS_ASSERT(index.findPositionOfPrecedingKeyFrame(7) == 3);
+            TS_ASSERT(index.getEntry(3).m_offset == 140);
+
+            ::remove((FILENAME + ".idx").c_str());
+        }
 };
 
 #endif /*PLAYERh264TESTSUITE_H_*/
@@ -0,0 +1,91 @@
+/**
+ * odprofileconverter - Tool to convert profiling traces
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef PROFILECONVERTER_H_
+#define PROFILECONVERTER_H_
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <opendavinci/odcore/opendavinci.h>
+#include <opendavinci/odcore/base/Profiler.h>
+
+namespace odprofileconverter {
+
+    /**
+     * This class converts binary traces written by odcore::base::Profiler
+     * into CSV or Chrome's trace event format (chrome://tracing).
+     */
+    class ProfileConverter {
+        private:
+            ProfileConverter(const ProfileConverter &/*obj*/);
+
+            ProfileConverter& operator=(const ProfileConverter &/*obj*/);
+
+        public:
+            ProfileConverter();
+
+            virtual ~ProfileConverter();
+
+            int32_t run(const int32_t &argc, char **argv);
+
+            /**
+             * This method reads a trace.
+             *
+             * @param in Stream to read from.
+             * @return true if the trace could be read.
+             */
+            bool read(std::istream &in);
+
+            /**
+             * This method writes one line per event.
+             */
+            void writeEvents(std::ostream &out) const;
+
+            /**
+             * This method writes one line per completed cycle with its
+             * computation and waiting time and the exchanged containers.
+             */
+            void writeCycles(std::ostream &out) const;
+
+            /**
+             * This method writes the trace in Chrome's JSON format.
+             */
+            void writeChromeTrace(std::ostream &out) const;
+
+        private:
+            /**
+             * @return Time of the given event in microseconds since the first event.
+             */
+            double toMicroseconds(const odcore::base::ProfilerEvent &e) const;
+
+            const std::string getName(const uint16_t &name) const;
+
+        private:
+            double m_ticksPerMicrosecond;
+            uint64_t m_firstTicks;
+            std::vector<odcore::base::ProfilerEvent> m_events;
+            std::map<uint16_t, std::string> m_names;
+    };
+
+} // odprofileconverter
+
+#endif /*PROFILECONVERTER_H_*/
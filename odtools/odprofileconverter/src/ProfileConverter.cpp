@@ -0,0 +1,259 @@
+/**
+ * odprofileconverter - Tool to convert profiling traces
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <cstring>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "ProfileConverter.h"
+
+namespace odprofileconverter {
+
+    using namespace std;
+    using namespace odcore::base;
+
+    static bool isEarlier(const ProfilerEvent &a, const ProfilerEvent &b) {
+        return a.m_ticks < b.m_ticks;
+    }
+
+    static const string toString(const uint16_t &type) {
+        switch (type) {
+            case ProfilerEvent::CYCLE_BEGIN: return "cycle_begin";
+            case ProfilerEvent::CYCLE_END: return "cycle_end";
+            case ProfilerEvent::CONTAINER_IN: return "container_in";
+            case ProfilerEvent::CONTAINER_OUT: return "container_out";
+            case ProfilerEvent::SPAN_BEGIN: return "span_begin";
+            case ProfilerEvent::SPAN_END: return "span_end";
+            case ProfilerEvent::DROPPED: return "dropped";
+        }
+        return "unknown";
+    }
+
+    static const string escapeJSON(const string &s) {
+        stringstream sstr;
+        for (auto c : s) {
+            if ( ('"' == c) || ('\\' == c) ) {
+                sstr << '\\' << c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20) {
+                sstr << "\\u" << hex << setw(4) << setfill('0') << static_cast<int>(c) << dec;
+            }
+            else {
+                sstr << c;
+            }
+        }
+        return sstr.str();
+    }
+
+    ProfileConverter::ProfileConverter() :
+        m_ticksPerMicrosecond(1000.0),
+        m_firstTicks(0),
+        m_events(),
+        m_names() {}
+
+    ProfileConverter::~ProfileConverter() {}
+
+    int32_t ProfileConverter::run(const int32_t &argc, char **argv) {
+        enum RETURN_CODE { CORRECT = 0,
+                           WRONG_USAGE = 1,
+                           FILE_COULD_NOT_BE_READ = 255 };
+
+        string format = "csv";
+        string fileName;
+        for (int32_t i = 1; i < argc; i++) {
+            const string ARG(argv[i]);
+            if (ARG.find("--format=") == 0) {
+                format = ARG.substr(strlen("--format="));
+            }
+            else {
+                fileName = ARG;
+            }
+        }
+
+        if (fileName.empty() || ( (format != "csv") && (format != "cycles") && (format != "chrome") )) {
+            cerr << "Usage: " << argv[0] << " [--format=csv|cycles|chrome] <FILENAME>" << endl;
+            return WRONG_USAGE;
+        }
+
+        fstream fin;
+        fin.open(fileName.c_str(), ios_base::in|ios_base::binary);
+        if (!fin.good() || !read(fin)) {
+            cerr << "[odprofileconverter]: Could not read profiling trace '" << fileName << "'." << endl;
+            return FILE_COULD_NOT_BE_READ;
+        }
+
+        if ("chrome" == format) {
+            writeChromeTrace(cout);
+        }
+        else if ("cycles" == format) {
+            writeCycles(cout);
+        }
+        else {
+            writeEvents(cout);
+        }
+
+        return CORRECT;
+    }
+
+    bool ProfileConverter::read(istream &in) {
+        ProfilerHeader header;
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!in.good() || (0 != memcmp(header.m_magic, Profiler::MAGIC, sizeof(header.m_magic))) || !(header.m_ticksPerMicrosecond > 0)) {
+            return false;
+        }
+        m_ticksPerMicrosecond = header.m_ticksPerMicrosecond;
+
+        m_events.clear();
+        m_names.clear();
+
+        ProfilerEvent e;
+        while (in.read(reinterpret_cast<char*>(&e), sizeof(e))) {
+            if (ProfilerEvent::NAME == e.m_type) {
+                string name(static_cast<size_t>(e.m_value), '\0');
+                if ( (e.m_value > 0) && !in.read(&name[0], e.m_value) ) {
+                    break;
+                }
+                m_names[e.m_name] = name;
+            }
+            else {
+                m_events.push_back(e);
+            }
+        }
+
+        // The writer drains the threads one after another.
+        stable_sort(m_events.begin(), m_events.end(), isEarlier);
+        m_firstTicks = m_events.empty() ? 0 : m_events.front().m_ticks;
+        return true;
+    }
+
+    double ProfileConverter::toMicroseconds(const ProfilerEvent &e) const {
+        return static_cast<double>(e.m_ticks - m_firstTicks) / m_ticksPerMicrosecond;
+    }
+
+    const string ProfileConverter::getName(const uint16_t &name) const {
+        auto it = m_names.find(name);
+        if (it != m_names.end()) {
+            return it->second;
+        }
+        return "";
+    }
+
+    void ProfileConverter::writeEvents(ostream &out) const {
+        out << "timestamp_us;thread;type;name;value" << endl;
+        for (auto e : m_events) {
+            out << fixed << setprecision(3) << toMicroseconds(e) << ";" << e.m_thread << ";" << toString(e.m_type) << ";" << getName(e.m_name) << ";" << e.m_value << endl;
+        }
+    }
+
+    void ProfileConverter::writeCycles(ostream &out) const {
+        class Cycle {
+            public:
+                Cycle() : m_begin(0), m_wait(0), m_containersIn(0), m_containersOut(0) {}
+
+                double m_begin;
+                double m_wait;
+                uint32_t m_containersIn;
+                uint32_t m_containersOut;
+        };
+
+        out << "timestamp_cycle_begin_us;thread;computation_us;waiting_us;containers_in;containers_out" << endl;
+
+        // Containers are received on other threads; they are counted for every running cycle.
+        map<uint32_t, Cycle> running;
+        for (auto e : m_events) {
+            if (ProfilerEvent::CYCLE_BEGIN == e.m_type) {
+                Cycle c;
+                c.m_begin = toMicroseconds(e);
+                c.m_wait = e.m_value / 1000.0;
+                running[e.m_thread] = c;
+            }
+            else if (ProfilerEvent::CYCLE_END == e.m_type) {
+                auto it = running.find(e.m_thread);
+                if (it != running.end()) {
+                    const Cycle &c = it->second;
+                    out << fixed << setprecision(3) << c.m_begin << ";" << e.m_thread << ";" << (toMicroseconds(e) - c.m_begin) << ";" << c.m_wait << ";" << c.m_containersIn << ";" << c.m_containersOut << endl;
+                    running.erase(it);
+                }
+            }
+            else if ( (ProfilerEvent::CONTAINER_IN == e.m_type) || (ProfilerEvent::CONTAINER_OUT == e.m_type) ) {
+                for (auto &r : running) {
+                    if (ProfilerEvent::CONTAINER_IN == e.m_type) {
+                        r.second.m_containersIn++;
+                    }
+                    else {
+                        r.second.m_containersOut++;
+                    }
+                }
+            }
+        }
+    }
+
+    void ProfileConverter::writeChromeTrace(ostream &out) const {
+        out << "{\"traceEvents\":[" << endl;
+
+        bool first = true;
+        map<uint32_t, bool> inCycle;
+        for (auto e : m_events) {
+            const double TS = toMicroseconds(e);
+            stringstream sstr;
+            sstr << fixed << setprecision(3);
+            switch (e.m_type) {
+                case ProfilerEvent::CYCLE_BEGIN:
+                    if (e.m_value > 0) {
+                        const double WAIT = e.m_value / 1000.0;
+                        sstr << "{\"name\":\"wait\",\"ph\":\"X\",\"ts\":" << (TS - WAIT) << ",\"dur\":" << WAIT << ",\"pid\":0,\"tid\":" << e.m_thread << "}," << endl;
+                    }
+                    sstr << "{\"name\":\"cycle\",\"ph\":\"B\",\"ts\":" << TS << ",\"pid\":0,\"tid\":" << e.m_thread << "}";
+                    inCycle[e.m_thread] = true;
+                break;
+                case ProfilerEvent::CYCLE_END:
+                    // Skip the end of a cycle whose beginning was not recorded.
+                    if (!inCycle[e.m_thread]) {
+                        continue;
+                    }
+                    sstr << "{\"name\":\"cycle\",\"ph\":\"E\",\"ts\":" << TS << ",\"pid\":0,\"tid\":" << e.m_thread << "}";
+                    inCycle[e.m_thread] = false;
+                break;
+                case ProfilerEvent::SPAN_BEGIN:
+                case ProfilerEvent::SPAN_END:
+                    sstr << "{\"name\":\"" << escapeJSON(getName(e.m_name)) << "\",\"ph\":\"" << ((ProfilerEvent::SPAN_BEGIN == e.m_type) ? "B" : "E") << "\",\"ts\":" << TS << ",\"pid\":0,\"tid\":" << e.m_thread << "}";
+                break;
+                case ProfilerEvent::CONTAINER_IN:
+                case ProfilerEvent::CONTAINER_OUT:
+                case ProfilerEvent::DROPPED:
+                    sstr << "{\"name\":\"" << toString(e.m_type) << "\",\"ph\":\"i\",\"s\":\"t\",\"ts\":" << TS << ",\"pid\":0,\"tid\":" << e.m_thread << ",\"args\":{\"value\":" << e.m_value << "}}";
+                break;
+                default:
+                    continue;
+            }
+
+            if (!first) {
+                out << "," << endl;
+            }
+            out << sstr.str();
+            first = false;
+        }
+
+        out << endl << "]}" << endl;
+    }
+
+} // odprofileconverter
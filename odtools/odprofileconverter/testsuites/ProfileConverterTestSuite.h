@@ -0,0 +1,131 @@
+/**
+ * odprofileconverter - Tool to convert profiling traces
+ * Copyright (C) 2017 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef PROFILECONVERTERTESTSUITE_H_
+#define PROFILECONVERTERTESTSUITE_H_
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#include "cxxtest/TestSuite.h"
+
+// Include local header files.
+#include "../include/ProfileConverter.h"
+
+using namespace std;
+using namespace odcore::base;
+using namespace odprofileconverter;
+
+class ProfileConverterTest : public CxxTest::TestSuite {
+    private:
+        void addEvent(stringstream &sstr, const uint64_t &ticks, const uint32_t &thread, const uint16_t &type, const uint16_t &name, const int64_t &value) {
+            ProfilerEvent e;
+            e.m_ticks = ticks;
+            e.m_value = value;
+            e.m_thread = thread;
+            e.m_type = type;
+            e.m_name = name;
+            sstr.write(reinterpret_cast<const char*>(&e), sizeof(e));
+        }
+
+        /**
+         * This method creates a trace with 2 ticks per microsecond: one
+         * cycle on thread 0 containing a span and sending a container and
+         * a received container on thread 1.
+         */
+        const string createTrace() {
+            stringstream sstr;
+            ProfilerHeader header;
+            memcpy(header.m_magic, Profiler::MAGIC, sizeof(header.m_magic));
+            header.m_ticksPerMicrosecond = 2.0;
+            sstr.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+            const string NAME("My \"span\"");
+            addEvent(sstr, 0, 0, ProfilerEvent::NAME, 1, NAME.size());
+            sstr.write(NAME.c_str(), NAME.size());
+
+            addEvent(sstr, 1000, 0, ProfilerEvent::CYCLE_BEGIN, 0, 250000);
+            addEvent(sstr, 1100, 0, ProfilerEvent::SPAN_BEGIN, 1, 0);
+            addEvent(sstr, 1200, 0, ProfilerEvent::CONTAINER_OUT, 0, 19);
+            addEvent(sstr, 1300, 0, ProfilerEvent::SPAN_END, 1, 0);
+            addEvent(sstr, 1400, 0, ProfilerEvent::CYCLE_END, 0, 1);
+            // Events of another thread are drained later.
+            addEvent(sstr, 1150, 1, ProfilerEvent::CONTAINER_IN, 0, 8);
+            return sstr.str();
+        }
+
+    public:
+        void testInvalidTrace() {
+            ProfileConverter pc;
+            stringstream sstr("ODREC001 not a trace");
+            TS_ASSERT(!pc.read(sstr));
+        }
+
+        void testEvents() {
+            ProfileConverter pc;
+            stringstream in(createTrace());
+            TS_ASSERT(pc.read(in));
+
+            stringstream out;
+            pc.writeEvents(out);
+
+            const string EXPECTED = "timestamp_us;thread;type;name;value\n"
+                                    "0.000;0;cycle_begin;;250000\n"
+                                    "50.000;0;span_begin;My \"span\";0\n"
+                                    "75.000;1;container_in;;8\n"
+                                    "100.000;0;container_out;;19\n"
+                                    "150.000;0;span_end;My \"span\";0\n"
+                                    "200.000;0;cycle_end;;1\n";
+            TS_ASSERT(out.str() == EXPECTED);
+        }
+
+        void testCycles() {
+            ProfileConverter pc;
+            stringstream in(createTrace());
+            TS_ASSERT(pc.read(in));
+
+            stringstream out;
+            pc.writeCycles(out);
+
+            const string EXPECTED = "timestamp_cycle_begin_us;thread;computation_us;waiting_us;containers_in;containers_out\n"
+                                    "0.000;0;200.000;250.000;1;1\n";
+            TS_ASSERT(out.str() == EXPECTED);
+        }
+
+        void testChromeTrace() {
+            ProfileConverter pc;
+            stringstream in(createTrace());
+            TS_ASSERT(pc.read(in));
+
+            stringstream out;
+            pc.writeChromeTrace(out);
+            const string TRACE = out.str();
+
+            TS_ASSERT(TRACE.find("{\"traceEvents\":[") == 0);
+            TS_ASSERT(TRACE.find("{\"name\":\"wait\",\"ph\":\"X\",\"ts\":-250.000,\"dur\":250.000,\"pid\":0,\"tid\":0}") != string::npos);
+            TS_ASSERT(TRACE.find("{\"name\":\"cycle\",\"ph\":\"B\",\"ts\":0.000,\"pid\":0,\"tid\":0}") != string::npos);
+            TS_ASSERT(TRACE.find("{\"name\":\"My \\\"span\\\"\",\"ph\":\"B\",\"ts\":50.000,\"pid\":0,\"tid\":0}") != string::npos);
+            TS_ASSERT(TRACE.find("{\"name\":\"container_in\",\"ph\":\"i\",\"s\":\"t\",\"ts\":75.000,\"pid\":0,\"tid\":1,\"args\":{\"value\":8}}") != string::npos);
+            TS_ASSERT(TRACE.find("{\"name\":\"cycle\",\"ph\":\"E\",\"ts\":200.000,\"pid\":0,\"tid\":0}") != string::npos);
+            TS_ASSERT(TRACE.find("]}") != string::npos);
+        }
+};
+
+#endif /*PROFILECONVERTERTESTSUITE_H_*/
@@ -0,0 +1,328 @@
+/**
+ * odrec2fuse - Mounting .rec files via Fuse into a directory.
+ * Copyright (C) 2016 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef CSVEXPORTER_H_
+#define CSVEXPORTER_H_
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <opendavinci/odcore/base/Mutex.h>
+#include <opendavinci/odcore/data/Container.h>
+#include <opendavinci/odcore/reflection/MessageResolver.h>
+
+namespace odrec2fuse {
+
+    using namespace std;
+
+    /**
+     * This class describes a contiguous byte range of a .rec file that
+     * starts and ends at container boundaries.
+     */
+    class RecordingRegion {
+        public:
+            RecordingRegion();
+            RecordingRegion(const uint64_t &begin, const uint64_t &end);
+
+        public:
+            uint64_t m_begin;
+            uint64_t m_end;
+    };
+
+    /**
+     * This class describes the part of a .csv file that is produced by
+     * the containers of one message type and sender stamp found in one
+     * RecordingRegion.
+     */
+    class CSVChunk {
+        public:
+            CSVChunk();
+            CSVChunk(const uint32_t &region, const uint32_t &firstContainer, const uint32_t &numberOfContainers);
+
+        public:
+            uint32_t m_region;
+            uint32_t m_firstContainer;
+            uint32_t m_numberOfContainers;
+            uint64_t m_offset;
+            uint64_t m_size;
+    };
+
+    /**
+     * This class describes one .csv file (i.e. one pair of message type
+     * and sender stamp); its content is only materialized on demand and
+     * its chunks are laid out in order as far as they were accessed.
+     */
+    class CSVFile {
+        public:
+            CSVFile();
+
+        public:
+            string m_filename;
+            string m_header;
+            vector<uint64_t> m_containers;
+            vector<CSVChunk> m_chunks;
+
+            // m_layoutMutex protects the layout of this file.
+            shared_ptr<odcore::base::Mutex> m_layoutMutex;
+            uint32_t m_numberOfLaidOutChunks;
+            uint64_t m_size;
+    };
+
+    /**
+     * This class converts a .rec file into one .csv file per message
+     * type and sender stamp without keeping the .csv files in memory:
+     * The recording is split into regions at container boundaries and
+     * worker threads collect the offsets of the containers per message
+     * type and sender stamp; only one container per .csv file is mapped
+     * to determine its name and header. The rows of a .csv file are
+     * formatted chunk by chunk from only its own containers when they
+     * are read for the first time; thereby, the file is laid out only up
+     * to the furthest offset read so far. Afterwards, any byte range
+     * within can be materialized by formatting only the chunks that
+     * cover it and a small LRU cache keeps the most recently formatted
+     * chunks.
+     */
+    class CSVExporter {
+        private:
+            /**
+             * "Forbidden" copy constructor. Goal: The compiler should warn
+             * already at compile time for unwanted bugs caused by any misuse
+             * of the copy constructor.
+             *
+             * @param obj Reference to an object of this class.
+             */
+            CSVExporter(const CSVExporter &/*obj*/);
+
+            /**
+             * "Forbidden" assignment operator. Goal: The compiler should warn
+             * already at compile time for unwanted bugs caused by any misuse
+             * of the assignment operator.
+             *
+             * @param obj Reference to an object of this class.
+             * @return Reference to this instance.
+             */
+            CSVExporter& operator=(const CSVExporter &/*obj*/);
+
+        public:
+            enum {
+                DEFAULT_REGION_SIZE = 8 * 1024 * 1024,
+                DEFAULT_NUMBER_OF_CACHED_REGIONS = 16,
+            };
+
+            /**
+             * Constructor.
+             *
+             * @param recFilename .rec file to export.
+             * @param messageResolver MessageResolver for types not known to OpenDaVINCI (might be NULL).
+             * @param numberOfWorkers Number of threads decoding regions in parallel.
+             * @param regionSize Minimum number of bytes per region.
+             * @param numberOfCachedRegions Maximum number of formatted chunks to keep.
+             */
+            CSVExporter(const string &recFilename, odcore::reflection::MessageResolver *messageResolver, const uint32_t &numberOfWorkers, const uint32_t &regionSize, const uint32_t &numberOfCachedRegions);
+
+            virtual ~CSVExporter();
+
+            /**
+             * This method splits the .rec file into regions, collects the
+             * offsets of all containers, and determines the names of all
+             * .csv files; no rows are formatted yet.
+             *
+             * @return true if the .rec file could be read.
+             */
+            bool index();
+
+            /**
+             * @return Names of all .csv files (available after index()).
+             */
+            vector<string> getFilenames() const;
+
+            /**
+             * This method returns the size of the part of a .csv file
+             * that is laid out; it is the size of the entire file once
+             * the file was read up to its end.
+             *
+             * @param filename Name of the .csv file.
+             * @param size Size of the laid-out part of the .csv file in bytes.
+             * @return true if the .csv file exists.
+             */
+            bool getSize(const string &filename, uint64_t &size);
+
+            /**
+             * This method copies a byte range from a .csv file.
+             *
+             * @param filename Name of the .csv file.
+             * @param buffer Buffer to fill.
+             * @param size Number of bytes to copy at most.
+             * @param offset Offset in the .csv file.
+             * @return Number of bytes copied or -1 if the file does not exist.
+             */
+            int64_t read(const string &filename, char *buffer, const uint64_t &size, const uint64_t &offset);
+
+            /**
+             * This method writes all .csv files into the given directory;
+             * regions are decoded in parallel and written in order.
+             *
+             * @param directory Directory to write the .csv files to.
+             * @return true if all files could be written.
+             */
+            bool exportToDirectory(const string &directory);
+
+            /**
+             * This method writes all messages into a columnar recording
+             * (.rec.col) to be queried with odtools::columnar::ColumnarReader.
+             *
+             * @param filename Name of the .rec.col file.
+             * @return true if the file could be written.
+             */
+            bool exportToColumnarFile(const string &filename);
+
+            /**
+             * @return Number of mapped containers (available after index()).
+             */
+            uint64_t getNumberOfMappedContainers() const;
+
+        private:
+            /**
+             * This method splits the .rec file into regions by only
+             * reading the container headers.
+             *
+             * @return true if the .rec file could be read.
+             */
+            bool findRegions();
+
+            /**
+             * This method calls f for all containers of one region that
+             * could be mapped to a message.
+             *
+             * @param region Region to decode.
+             * @param addTimeStamps true if the container's time stamps shall be inserted into the message.
+             * @param f Function to call per mapped container.
+             * @return Number of mapped containers.
+             */
+            uint64_t forEachMessage(const uint32_t &region, const bool &addTimeStamps, std::function<void(odcore::data::Container &, odcore::reflection::Message &)> f);
+
+            /**
+             * This method decodes all containers of one region into .csv rows.
+             *
+             * @param region Region to decode.
+             * @param content Map of key to .csv rows (without header) for this region.
+             * @param files Map of key to CSVFile for the message types found in this region (only filename and header are set).
+             * @return Number of mapped containers.
+             */
+            uint64_t decodeRegion(const uint32_t &region, map<string, string> &content, map<string, CSVFile> &files);
+
+            /**
+             * This method maps a container to a message and optionally
+             * inserts the container's time stamps in seconds as fields
+             * SentTimeStamp, ReceivedTimeStamp, and SampleTimeStamp.
+             *
+             * @param c Container to map.
+             * @param addTimeStamps true if the time stamps shall be inserted.
+             * @param successfullyMapped true if the container could be mapped.
+             * @return Message.
+             */
+            odcore::reflection::Message mapContainer(odcore::data::Container &c, const bool &addTimeStamps, bool &successfullyMapped);
+
+            /**
+             * This method collects the offsets of all containers of one
+             * region per message type and sender stamp.
+             *
+             * @param region Region to read.
+             * @param containers Map of key to offsets of the containers.
+             */
+            void findContainers(const uint32_t &region, map<string, vector<uint64_t> > &containers);
+
+            /**
+             * This method formats the rows of one chunk of a .csv file.
+             *
+             * @param f .csv file.
+             * @param chunk Chunk to format.
+             * @param rows .csv rows (without header).
+             */
+            void formatChunk(const CSVFile &f, const CSVChunk &chunk, string &rows);
+
+            /**
+             * This method determines the sizes of the chunks of a .csv
+             * file in order until the given offset is laid out or the
+             * end of the file is reached; m_numberOfWorkers chunks are
+             * formatted at a time and their rows are cached.
+             *
+             * @param key Key of the .csv file.
+             * @param offset Offset in the .csv file to be laid out.
+             * @param numberOfChunks Number of chunks laid out.
+             * @param size Size of the laid-out part of the .csv file in bytes.
+             */
+            void layOut(const string &key, const uint64_t &offset, uint32_t &numberOfChunks, uint64_t &size);
+
+            /**
+             * This method returns the rows of a laid-out chunk using
+             * the LRU cache.
+             *
+             * @param key Key of the .csv file.
+             * @param chunk Index of the chunk.
+             * @return .csv rows of this chunk.
+             */
+            shared_ptr<string> getChunk(const string &key, const uint32_t &chunk);
+
+            /**
+             * This method adds the rows of a chunk to the LRU cache.
+             *
+             * @param key Key of the .csv file.
+             * @param chunk Index of the chunk.
+             * @param rows .csv rows of this chunk.
+             */
+            void cacheChunk(const string &key, const uint32_t &chunk, shared_ptr<string> rows);
+
+            /**
+             * This method runs the given function for all regions using
+             * m_numberOfWorkers threads.
+             *
+             * @param first First region to process.
+             * @param last Region after the last one to process.
+             * @param f Function to call per region.
+             */
+            void forEachRegion(const uint32_t &first, const uint32_t &last, std::function<void(const uint32_t &)> f);
+
+        private:
+            const string m_recFilename;
+            odcore::reflection::MessageResolver *m_messageResolver;
+            odcore::base::Mutex m_messageResolverMutex;
+            const uint32_t m_numberOfWorkers;
+            const uint32_t m_regionSize;
+            const uint32_t m_numberOfCachedRegions;
+            uint64_t m_numberOfMappedContainers;
+
+            vector<RecordingRegion> m_regions;
+            map<string, CSVFile> m_files;
+            map<string, string> m_keyForFilename;
+
+            odcore::base::Mutex m_cacheMutex;
+            map<pair<string, uint32_t>, shared_ptr<string> > m_cache;
+            list<pair<string, uint32_t> > m_leastRecentlyUsedChunks;
+    };
+
+} // odrec2fuse
+
+#endif /*CSVEXPORTER_H_*/
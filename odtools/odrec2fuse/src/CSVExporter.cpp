@@ -0,0 +1,592 @@
+/**
+ * odrec2fuse - Mounting .rec files via Fuse into a directory.
+ * Copyright (C) 2016 Christian Berger
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include <opendavinci/odcore/opendavinci.h>
+#include <opendavinci/odcore/base/Lock.h>
+#include <opendavinci/odcore/reflection/Field.h>
+#include <opendavinci/odcore/reflection/Message.h>
+#include <opendavinci/odcore/reflection/CSVFromVisitableVisitor.h>
+
+#include <opendavinci/GeneratedHeaders_OpenDaVINCI_Helper.h>
+#include <opendavinci/generated/odcore/data/reflection/AbstractField.h>
+#include <opendavinci/odtools/columnar/ColumnarWriter.h>
+
+#include "CSVExporter.h"
+
+namespace odrec2fuse {
+
+    using namespace std;
+    using namespace odcore;
+    using namespace odcore::base;
+    using namespace odcore::data;
+    using namespace odcore::reflection;
+
+    RecordingRegion::RecordingRegion() :
+        RecordingRegion(0, 0) {}
+
+    RecordingRegion::RecordingRegion(const uint64_t &begin, const uint64_t &end) :
+        m_begin(begin),
+        m_end(end) {}
+
+    ////////////////////////////////////////////////////////////////////////////
+
+    CSVChunk::CSVChunk() :
+        CSVChunk(0, 0, 0) {}
+
+    CSVChunk::CSVChunk(const uint32_t &region, const uint32_t &firstContainer, const uint32_t &numberOfContainers) :
+        m_region(region),
+        m_firstContainer(firstContainer),
+        m_numberOfContainers(numberOfContainers),
+        m_offset(0),
+        m_size(0) {}
+
+    ////////////////////////////////////////////////////////////////////////////
+
+    CSVFile::CSVFile() :
+        m_filename(),
+        m_header(),
+        m_containers(),
+        m_chunks(),
+        m_layoutMutex(new Mutex()),
+        m_numberOfLaidOutChunks(0),
+        m_size(0) {}
+
+    ////////////////////////////////////////////////////////////////////////////
+
+    CSVExporter::CSVExporter(const string &recFilename, MessageResolver *messageResolver, const uint32_t &numberOfWorkers, const uint32_t &regionSize, const uint32_t &numberOfCachedRegions) :
+        m_recFilename(recFilename),
+        m_messageResolver(messageResolver),
+        m_messageResolverMutex(),
+        m_numberOfWorkers((numberOfWorkers > 0) ? numberOfWorkers : 1),
+        m_regionSize((regionSize > 0) ? regionSize : 1),
+        m_numberOfCachedRegions((numberOfCachedRegions > 0) ? numberOfCachedRegions : 1),
+        m_numberOfMappedContainers(0),
+        m_regions(),
+        m_files(),
+        m_keyForFilename(),
+        m_cacheMutex(),
+        m_cache(),
+        m_leastRecentlyUsedChunks() {}
+
+    CSVExporter::~CSVExporter() {}
+
+    bool CSVExporter::findRegions() {
+        m_regions.clear();
+
+        fstream fin;
+        fin.open(m_recFilename.c_str(), ios_base::in|ios_base::binary);
+        if (!fin.good()) {
+            return false;
+        }
+
+        fin.seekg(0, fin.end);
+        const uint64_t LENGTH = fin.tellg();
+        fin.seekg(0, fin.beg);
+
+        // Only the five bytes OpenDaVINCI Container header (0x0D 0xA4 A B C) are read per container.
+        const uint32_t OPENDAVINCI_CONTAINER_HEADER_SIZE = 5;
+        char header[OPENDAVINCI_CONTAINER_HEADER_SIZE];
+        uint64_t offset = 0;
+        uint64_t regionBegin = 0;
+        while ( (offset + OPENDAVINCI_CONTAINER_HEADER_SIZE) <= LENGTH ) {
+            fin.seekg(offset, fin.beg);
+            fin.read(header, OPENDAVINCI_CONTAINER_HEADER_SIZE);
+            if (fin.gcount() != OPENDAVINCI_CONTAINER_HEADER_SIZE) {
+                break;
+            }
+
+            uint32_t expectedBytes = 0;
+            memcpy(&expectedBytes, header + 1, sizeof(uint32_t));
+            expectedBytes = le32toh(expectedBytes);
+
+            if (!( (0x0D == static_cast<uint8_t>(header[0])) && (0xA4 == (expectedBytes & 0xFF)) )) {
+                cerr << "[Rec2Fuse] Failed to decode OpenDaVINCI container header at " << offset << "; ignoring remainder." << endl;
+                break;
+            }
+
+            const uint64_t NEXT = offset + OPENDAVINCI_CONTAINER_HEADER_SIZE + (expectedBytes >> 8);
+            if (NEXT > LENGTH) {
+                cerr << "[Rec2Fuse] Ignoring truncated container at " << offset << "." << endl;
+                break;
+            }
+            offset = NEXT;
+
+            if ( (offset - regionBegin) >= m_regionSize ) {
+                m_regions.push_back(RecordingRegion(regionBegin, offset));
+                regionBegin = offset;
+            }
+        }
+        if (offset > regionBegin) {
+            m_regions.push_back(RecordingRegion(regionBegin, offset));
+        }
+
+        return true;
+    }
+
+    Message CSVExporter::mapContainer(Container &c, const bool &addTimeStamps, bool &successfullyMapped) {
+        successfullyMapped = false;
+
+        // First, try to decode a regular OpenDaVINCI message.
+        Message msg = GeneratedHeaders_OpenDaVINCI_Helper::__map(c, successfullyMapped);
+
+        // Try dynamically loaded libraries next.
+        if ( (!successfullyMapped) && (NULL != m_messageResolver) ) {
+            Lock l(m_messageResolverMutex);
+            msg = m_messageResolver->resolve(c, successfullyMapped);
+        }
+
+        if (successfullyMapped && addTimeStamps) {
+            // Insert time stamps.
+            {
+                shared_ptr<Field<double> > f1 = shared_ptr<Field<double> >(new Field<double>());
+                f1->setFieldIdentifier(1002);
+                f1->setLongFieldName("ReceivedTimeStamp");
+                f1->setShortFieldName("ReceivedTimeStamp");
+                f1->setFieldDataType(odcore::data::reflection::AbstractField::DOUBLE_T);
+                const double v = c.getReceivedTimeStamp().getSeconds() + c.getReceivedTimeStamp().getMicroseconds()/(1000.0*1000.0);
+                f1->setValue(v);
+                f1->setSize(sizeof(double));
+                msg.insertField(f1);
+            }
+            {
+                shared_ptr<Field<double> > f2 = shared_ptr<Field<double> >(new Field<double>());
+                f2->setFieldIdentifier(1001);
+                f2->setLongFieldName("SentTimeStamp");
+                f2->setShortFieldName("SentTimeStamp");
+                f2->setFieldDataType(odcore::data::reflection::AbstractField::DOUBLE_T);
+                const double v = c.getSentTimeStamp().getSeconds() + c.getSentTimeStamp().getMicroseconds()/(1000.0*1000.0);
+                f2->setValue(v);
+                f2->setSize(sizeof(double));
+                msg.insertField(f2);
+            }
+            {
+                shared_ptr<Field<double> > f3 = shared_ptr<Field<double> >(new Field<double>());
+                f3->setFieldIdentifier(1003);
+                f3->setLongFieldName("SampleTimeStamp");
+                f3->setShortFieldName("SampleTimeStamp");
+                f3->setFieldDataType(odcore::data::reflection::AbstractField::DOUBLE_T);
+                const double v = c.getSampleTimeStamp().getSeconds() + c.getSampleTimeStamp().getMicroseconds()/(1000.0*1000.0);
+                f3->setValue(v);
+                f3->setSize(sizeof(double));
+                msg.insertField(f3);
+            }
+        }
+
+        return msg;
+    }
+
+    uint64_t CSVExporter::forEachMessage(const uint32_t &region, const bool &addTimeStamps, std::function<void(Container &, Message &)> f) {
+        uint64_t mappedContainers = 0;
+
+        const RecordingRegion R = m_regions.at(region);
+        fstream fin;
+        fin.open(m_recFilename.c_str(), ios_base::in|ios_base::binary);
+        fin.seekg(R.m_begin, fin.beg);
+
+        while (fin.good() && (static_cast<uint64_t>(fin.tellg()) < R.m_end)) {
+            Container c;
+            fin >> c;
+
+            if (fin.gcount() > 0) {
+                bool successfullyMapped = false;
+                Message msg = mapContainer(c, addTimeStamps, successfullyMapped);
+
+                if (successfullyMapped) {
+                    mappedContainers++;
+                    f(c, msg);
+                }
+            }
+        }
+
+        return mappedContainers;
+    }
+
+    uint64_t CSVExporter::decodeRegion(const uint32_t &region, map<string, string> &content, map<string, CSVFile> &files) {
+        const bool ADD_TIMESTAMPS = true;
+        return forEachMessage(region, ADD_TIMESTAMPS, [&content, &files](Container &c, Message &msg) {
+            stringstream sstrKey;
+            sstrKey << c.getDataType() << "/" << c.getSenderStamp();
+            const string KEY = sstrKey.str();
+
+            stringstream sstrCSVData;
+            const bool ADD_HEADER = (files.count(KEY) == 0);
+            const char DELIMITER = ';';
+            CSVFromVisitableVisitor csv(sstrCSVData, ADD_HEADER, DELIMITER);
+            msg.accept(csv);
+
+            if (ADD_HEADER) {
+                stringstream sstrFilename;
+                sstrFilename << msg.getLongName() << "-" << c.getSenderStamp() << ".csv";
+
+                CSVFile f;
+                f.m_filename = sstrFilename.str();
+                f.m_header = csv.getHeader() + "\n";
+                files[KEY] = f;
+            }
+
+            // The header is only added once per .csv file and hence, stored separately.
+            content[KEY] += csv.getEntry() + "\n";
+        });
+    }
+
+    void CSVExporter::forEachRegion(const uint32_t &first, const uint32_t &last, std::function<void(const uint32_t &)> f) {
+        std::atomic<uint32_t> nextRegion(first);
+        auto worker = [&nextRegion, &last, &f]() {
+            uint32_t region = 0;
+            while ((region = nextRegion++) < last) {
+                f(region);
+            }
+        };
+
+        vector<std::thread> workers;
+        const uint32_t NUMBER_OF_WORKERS = std::min(m_numberOfWorkers, (last > first) ? (last - first) : 1);
+        for (uint32_t i = 1; i < NUMBER_OF_WORKERS; i++) {
+            workers.push_back(std::thread(worker));
+        }
+        worker();
+        for (auto &t : workers) {
+            t.join();
+        }
+    }
+
+    void CSVExporter::findContainers(const uint32_t &region, map<string, vector<uint64_t> > &containers) {
+        const RecordingRegion R = m_regions.at(region);
+        fstream fin;
+        fin.open(m_recFilename.c_str(), ios_base::in|ios_base::binary);
+        fin.seekg(R.m_begin, fin.beg);
+
+        // Only the containers' envelopes are decoded; their payloads are not mapped to messages.
+        uint64_t offset = R.m_begin;
+        while (fin.good() && (offset < R.m_end)) {
+            Container c;
+            fin >> c;
+
+            if (fin.gcount() > 0) {
+                stringstream sstrKey;
+                sstrKey << c.getDataType() << "/" << c.getSenderStamp();
+                containers[sstrKey.str()].push_back(offset);
+            }
+            offset = fin.tellg();
+        }
+    }
+
+    bool CSVExporter::index() {
+        m_numberOfMappedContainers = 0;
+        m_files.clear();
+        m_keyForFilename.clear();
+        {
+            Lock l(m_cacheMutex);
+            m_cache.clear();
+            m_leastRecentlyUsedChunks.clear();
+        }
+
+        if (!findRegions()) {
+            return false;
+        }
+
+        vector<map<string, vector<uint64_t> > > containersPerRegion(m_regions.size());
+        forEachRegion(0, m_regions.size(), [this, &containersPerRegion](const uint32_t &region) {
+            findContainers(region, containersPerRegion[region]);
+        });
+
+        // One chunk per .csv file and region in the order of the regions.
+        map<string, CSVFile> files;
+        for (uint32_t region = 0; region < containersPerRegion.size(); region++) {
+            for (auto &entry : containersPerRegion[region]) {
+                CSVFile &f = files[entry.first];
+                f.m_chunks.push_back(CSVChunk(region, f.m_containers.size(), entry.second.size()));
+                f.m_containers.insert(f.m_containers.end(), entry.second.begin(), entry.second.end());
+            }
+            containersPerRegion[region].clear();
+        }
+
+        // Map the first container per .csv file to determine its name and header.
+        fstream fin;
+        fin.open(m_recFilename.c_str(), ios_base::in|ios_base::binary);
+        for (auto &entry : files) {
+            CSVFile &f = entry.second;
+
+            fin.clear();
+            fin.seekg(f.m_containers.front(), fin.beg);
+            Container c;
+            fin >> c;
+
+            bool successfullyMapped = false;
+            const bool ADD_TIMESTAMPS = true;
+            Message msg = mapContainer(c, ADD_TIMESTAMPS, successfullyMapped);
+            if (!successfullyMapped) {
+                continue;
+            }
+
+            stringstream sstrCSVData;
+            const bool ADD_HEADER = true;
+            const char DELIMITER = ';';
+            CSVFromVisitableVisitor csv(sstrCSVData, ADD_HEADER, DELIMITER);
+            msg.accept(csv);
+
+            stringstream sstrFilename;
+            sstrFilename << msg.getLongName() << "-" << c.getSenderStamp() << ".csv";
+            f.m_filename = sstrFilename.str();
+            f.m_header = csv.getHeader() + "\n";
+            f.m_size = f.m_header.size();
+
+            m_numberOfMappedContainers += f.m_containers.size();
+            m_keyForFilename[f.m_filename] = entry.first;
+            m_files[entry.first] = f;
+        }
+
+        return true;
+    }
+
+    void CSVExporter::formatChunk(const CSVFile &f, const CSVChunk &chunk, string &rows) {
+        fstream fin;
+        fin.open(m_recFilename.c_str(), ios_base::in|ios_base::binary);
+
+        const uint32_t LAST = chunk.m_firstContainer + chunk.m_numberOfContainers;
+        for (uint32_t i = chunk.m_firstContainer; (i < LAST) && fin.good(); i++) {
+            fin.seekg(f.m_containers.at(i), fin.beg);
+            Container c;
+            fin >> c;
+
+            bool successfullyMapped = false;
+            const bool ADD_TIMESTAMPS = true;
+            Message msg = mapContainer(c, ADD_TIMESTAMPS, successfullyMapped);
+            if (successfullyMapped) {
+                stringstream sstrCSVData;
+                const bool ADD_HEADER = false;
+                const char DELIMITER = ';';
+                CSVFromVisitableVisitor csv(sstrCSVData, ADD_HEADER, DELIMITER);
+                msg.accept(csv);
+
+                // The header is only added once per .csv file and hence, stored separately.
+                rows += csv.getEntry() + "\n";
+            }
+        }
+    }
+
+    void CSVExporter::layOut(const string &key, const uint64_t &offset, uint32_t &numberOfChunks, uint64_t &size) {
+        CSVFile &f = m_files.at(key);
+        Lock l(*f.m_layoutMutex);
+        while ( (f.m_numberOfLaidOutChunks < f.m_chunks.size()) && (f.m_size <= offset) ) {
+            // The next chunks are formatted in parallel; their rows are kept for the following reads.
+            const uint32_t FIRST = f.m_numberOfLaidOutChunks;
+            const uint32_t LAST = std::min<uint32_t>(FIRST + m_numberOfWorkers, f.m_chunks.size());
+            vector<shared_ptr<string> > rows(LAST - FIRST);
+            forEachRegion(FIRST, LAST, [this, &f, &rows, &FIRST](const uint32_t &chunk) {
+                rows[chunk - FIRST] = shared_ptr<string>(new string());
+                formatChunk(f, f.m_chunks[chunk], *rows[chunk - FIRST]);
+            });
+
+            for (uint32_t chunk = FIRST; chunk < LAST; chunk++) {
+                f.m_chunks[chunk].m_offset = f.m_size;
+                f.m_chunks[chunk].m_size = rows[chunk - FIRST]->size();
+                f.m_size += f.m_chunks[chunk].m_size;
+                cacheChunk(key, chunk, rows[chunk - FIRST]);
+            }
+            f.m_numberOfLaidOutChunks = LAST;
+        }
+        numberOfChunks = f.m_numberOfLaidOutChunks;
+        size = f.m_size;
+    }
+
+    vector<string> CSVExporter::getFilenames() const {
+        vector<string> filenames;
+        for (auto &entry : m_keyForFilename) {
+            filenames.push_back(entry.first);
+        }
+        return filenames;
+    }
+
+    bool CSVExporter::getSize(const string &filename, uint64_t &size) {
+        auto it = m_keyForFilename.find(filename);
+        if (it == m_keyForFilename.end()) {
+            return false;
+        }
+        const CSVFile &f = m_files.at(it->second);
+        Lock l(*f.m_layoutMutex);
+        size = f.m_size;
+        return true;
+    }
+
+    uint64_t CSVExporter::getNumberOfMappedContainers() const {
+        return m_numberOfMappedContainers;
+    }
+
+    shared_ptr<string> CSVExporter::getChunk(const string &key, const uint32_t &chunk) {
+        const pair<string, uint32_t> ID(key, chunk);
+        {
+            Lock l(m_cacheMutex);
+            auto it = m_cache.find(ID);
+            if (it != m_cache.end()) {
+                m_leastRecentlyUsedChunks.remove(ID);
+                m_leastRecentlyUsedChunks.push_front(ID);
+                return it->second;
+            }
+        }
+
+        // Format outside of the lock to allow parallel reads from different chunks.
+        const CSVFile &f = m_files.at(key);
+        shared_ptr<string> rows = shared_ptr<string>(new string());
+        formatChunk(f, f.m_chunks.at(chunk), *rows);
+        cacheChunk(key, chunk, rows);
+        return rows;
+    }
+
+    void CSVExporter::cacheChunk(const string &key, const uint32_t &chunk, shared_ptr<string> rows) {
+        const pair<string, uint32_t> ID(key, chunk);
+        Lock l(m_cacheMutex);
+        if (m_cache.count(ID) == 0) {
+            m_cache[ID] = rows;
+            m_leastRecentlyUsedChunks.push_front(ID);
+            while (m_cache.size() > m_numberOfCachedRegions) {
+                m_cache.erase(m_leastRecentlyUsedChunks.back());
+                m_leastRecentlyUsedChunks.pop_back();
+            }
+        }
+    }
+
+    int64_t CSVExporter::read(const string &filename, char *buffer, const uint64_t &size, const uint64_t &offset) {
+        auto it = m_keyForFilename.find(filename);
+        if (it == m_keyForFilename.end()) {
+            return -1;
+        }
+
+        const string KEY = it->second;
+        const CSVFile &f = m_files.at(KEY);
+        uint64_t copied = 0;
+        while (copied < size) {
+            const uint64_t POSITION = offset + copied;
+            uint64_t length = 0;
+
+            // Only the laid-out chunks are accessed as further chunks might be laid out concurrently.
+            uint32_t numberOfChunks = 0;
+            uint64_t laidOutSize = 0;
+            layOut(KEY, POSITION, numberOfChunks, laidOutSize);
+            if (POSITION >= laidOutSize) {
+                break;
+            }
+
+            if (POSITION < f.m_header.size()) {
+                length = std::min<uint64_t>(f.m_header.size() - POSITION, size - copied);
+                memcpy(buffer + copied, f.m_header.c_str() + POSITION, length);
+            }
+            else {
+                // Find the last non-empty chunk starting at or before POSITION.
+                auto chunk = std::upper_bound(f.m_chunks.begin(), f.m_chunks.begin() + numberOfChunks, POSITION,
+                                              [](const uint64_t &p, const CSVChunk &c) { return p < c.m_offset; });
+                chunk--;
+
+                shared_ptr<string> rows = getChunk(KEY, static_cast<uint32_t>(chunk - f.m_chunks.begin()));
+                if (rows->size() != chunk->m_size) {
+                    cerr << "[Rec2Fuse] " << m_recFilename << " has changed while being mounted." << endl;
+                    break;
+                }
+
+                const uint64_t POSITION_IN_CHUNK = POSITION - chunk->m_offset;
+                length = std::min(chunk->m_size - POSITION_IN_CHUNK, size - copied);
+                memcpy(buffer + copied, rows->c_str() + POSITION_IN_CHUNK, length);
+            }
+
+            copied += length;
+        }
+
+        return copied;
+    }
+
+    bool CSVExporter::exportToDirectory(const string &directory) {
+        m_numberOfMappedContainers = 0;
+
+        if (!findRegions()) {
+            return false;
+        }
+
+        bool retVal = true;
+        map<string, shared_ptr<fstream> > outputs;
+
+        // Decode m_numberOfWorkers regions in parallel and append them in order to keep the memory bounded.
+        for (uint32_t first = 0; first < m_regions.size(); first += m_numberOfWorkers) {
+            const uint32_t LAST = std::min<uint32_t>(first + m_numberOfWorkers, m_regions.size());
+
+            vector<map<string, string> > contents(LAST - first);
+            vector<map<string, CSVFile> > files(LAST - first);
+            vector<uint64_t> mappedContainers(LAST - first, 0);
+            forEachRegion(first, LAST, [this, &first, &contents, &files, &mappedContainers](const uint32_t &region) {
+                mappedContainers[region - first] = decodeRegion(region, contents[region - first], files[region - first]);
+            });
+
+            for (uint32_t i = 0; i < contents.size(); i++) {
+                m_numberOfMappedContainers += mappedContainers[i];
+
+                for (auto &entry : contents[i]) {
+                    if (outputs.count(entry.first) == 0) {
+                        const CSVFile &f = files[i][entry.first];
+                        const string FILENAME = directory + "/" + f.m_filename;
+                        shared_ptr<fstream> out = shared_ptr<fstream>(new fstream(FILENAME.c_str(), ios_base::out|ios_base::trunc));
+                        if (!out->good()) {
+                            cerr << "[Rec2Fuse] Could not create " << FILENAME << "." << endl;
+                            return false;
+                        }
+                        (*out) << f.m_header;
+                        outputs[entry.first] = out;
+                    }
+
+                    (*outputs[entry.first]) << entry.second;
+                    retVal &= outputs[entry.first]->good();
+                }
+            }
+        }
+
+        for (auto &entry : outputs) {
+            entry.second->flush();
+            retVal &= entry.second->good();
+        }
+
+        return retVal;
+    }
+
+    bool CSVExporter::exportToColumnarFile(const string &filename) {
+        m_numberOfMappedContainers = 0;
+
+        if (!findRegions()) {
+            return false;
+        }
+
+        // The ColumnarWriter stores the Container's time stamps as integer
+        // columns with the same names; thus, the time stamps are not
+        // inserted as additional fields into the messages.
+        const bool ADD_TIMESTAMPS = false;
+        odtools::columnar::ColumnarWriter writer(filename);
+        for (uint32_t region = 0; (region < m_regions.size()) && writer.isGood(); region++) {
+            m_numberOfMappedContainers += forEachMessage(region, ADD_TIMESTAMPS, [&writer](Container &c, Message &msg) {
+                writer.append(c, msg);
+            });
+        }
+
+        return writer.close();
+    }
+
+} // odrec2fuse
@@ -23,22 +23,16 @@
 #include <cstring>
 #include <cerrno>
 
-#include <fstream>
 #include <iostream>
-#include <map>
+#include <memory>
 #include <string>
 #include <sstream>
+#include <thread>
 #include <vector>
 
-#include <opendavinci/odcore/data/Container.h>
-#include <opendavinci/odcore/reflection/Field.h>
-#include <opendavinci/odcore/reflection/Message.h>
-#include <opendavinci/odcore/reflection/CSVFromVisitableVisitor.h>
 #include <opendavinci/odcore/strings/StringToolbox.h>
 
-#include <opendavinci/GeneratedHeaders_OpenDaVINCI_Helper.h>
-#include <opendavinci/generated/odcore/data/reflection/AbstractField.h>
-
+#include "CSVExporter.h"
 #include "Rec2Fuse.h"
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -66,10 +60,8 @@ $ sudo systemctl daemon-reload
 $ sudo systemctl restart docker
 */
 
-// Maps of container-ID & sender-stamp.
-std::map<std::string, std::string> mapOfFilenames;
-std::map<std::string, std::string> mapOfEntries;
-std::map<std::string, uint32_t> mapOfEntrySizes;
+// Exporter providing the .csv files on demand.
+std::shared_ptr<odrec2fuse::CSVExporter> csvExporter;
 
 static int getattr_callback(const char *path, struct stat *stbuf) {
     memset(stbuf, 0, sizeof(struct stat));
@@ -80,16 +72,13 @@ static int getattr_callback(const char *path, struct stat *stbuf) {
         return 0;
     }
 
-    for (auto entry : mapOfEntries) {
-        std::stringstream sstr;
-        sstr << "/" << mapOfFilenames[entry.first] << ".csv";
-        const std::string FQDN = sstr.str();
-        if (strcmp(path, FQDN.c_str()) == 0) {
-            stbuf->st_mode = S_IFREG | 0444;
-            stbuf->st_nlink = 1;
-            stbuf->st_size = mapOfEntrySizes[entry.first];
-            return 0;
-        }
+    // The size of a .csv file is only known as far as it was read; reads are not limited to it (cf. open_callback).
+    uint64_t size = 0;
+    if (csvExporter->getSize(std::string(path+1), size)) { // Omit leading '/'
+        stbuf->st_mode = S_IFREG | 0444;
+        stbuf->st_nlink = 1;
+        stbuf->st_size = size;
+        return 0;
     }
 
     return -ENOENT;
@@ -102,45 +91,26 @@ static int readdir_callback(const char */*path*/, void *buf, fuse_fill_dir_t fil
     filler(buf, ".", NULL, 0);
     filler(buf, "..", NULL, 0);
 
-    for (auto entry : mapOfEntries) {
-        std::stringstream sstr;
-        sstr << "/" << mapOfFilenames[entry.first] << ".csv";
-        const std::string FQDN = sstr.str();
-        filler(buf, FQDN.c_str()+1, NULL, 0); // Omit leading '/'
+    for (auto filename : csvExporter->getFilenames()) {
+        filler(buf, filename.c_str(), NULL, 0);
     }
 
     return 0;
 }
 
-static int open_callback(const char */*path*/, struct fuse_file_info */*fi*/) {
+static int open_callback(const char */*path*/, struct fuse_file_info *fi) {
+    // Read until the end of the .csv file rather than up to the size reported so far.
+    fi->direct_io = 1;
     return 0;
 }
 
 static int read_callback(const char *path, char *buf, size_t size, off_t offset, struct fuse_file_info */*fi*/) {
-    for (auto entry : mapOfEntries) {
-        std::stringstream sstr;
-        sstr << "/" << mapOfFilenames[entry.first] << ".csv";
-        const std::string FQDN = sstr.str();
-
-        if (strcmp(path, FQDN.c_str()) == 0) {
-            size_t len = mapOfEntrySizes[entry.first];
-            if (offset >= static_cast<int32_t>(len)) {
-                return 0;
-            }
-
-            const std::string filecontent = mapOfEntries[entry.first];
-
-            if (offset + size > len) {
-                memcpy(buf, filecontent.c_str() + offset, len - offset);
-                return len - offset;
-            }
-
-            memcpy(buf, filecontent.c_str() + offset, size);
-            return size;
-        }
+    // Only the chunks of the .csv file covering the requested range are formatted.
+    const int64_t BYTES_READ = csvExporter->read(std::string(path+1), buf, size, offset); // Omit leading '/'
+    if (BYTES_READ < 0) {
+        return -ENOENT;
     }
-
-    return -ENOENT;
+    return static_cast<int>(BYTES_READ);
 }
 
 
@@ -168,130 +138,77 @@ namespace odrec2fuse {
     Rec2Fuse::~Rec2Fuse() {}
 
     int32_t Rec2Fuse::run(const int32_t &argc, char **argv) {
-        uint32_t mappedContainers = 0;
-
-        ::mapOfFilenames.clear();
-        ::mapOfEntrySizes.clear();
-        ::mapOfEntries.clear();
-
         if (argc > 1) {
             const string FILENAME(argv[1]);
-            fstream fin;
-            fin.open(FILENAME.c_str(), ios_base::in|ios_base::binary);
-
-            if (fin.good()) {
-                // Determine file size.
-                fin.seekg(0, fin.end);
-                int32_t length = fin.tellg();
-                fin.seekg(0, fin.beg);
-
-                int32_t oldPercentage = -1;
-
-                while (fin.good()) {
-                    Container c;
-                    fin >> c;
-
-                    if (fin.gcount() > 0) {
-                        int32_t currPos = fin.tellg();
-                        float percentage = (float)(currPos*100.0)/(float)length;
-
-                        if ( ((int32_t)percentage % 5 == 0) && ((int32_t)percentage != oldPercentage) ) {
-                            cout << "[Rec2Fuse]: " << (int32_t)percentage << "% (" << currPos << "/" << length << " bytes processed)." << endl;
-                            oldPercentage = (int32_t)percentage;
-                        }
-
-                        bool successfullyMapped = false;
-
-                        // First, try to decode a regular OpenDaVINCI message.
-                        odcore::reflection::Message msg = GeneratedHeaders_OpenDaVINCI_Helper::__map(c, successfullyMapped);
-
-                        // Try dynamically loaded libraries next.
-                        if (!successfullyMapped) {
-                            msg = m_messageResolver->resolve(c, successfullyMapped);
-                        }
-
-                        if (successfullyMapped) {
-                            // Insert time stamps.
-                            {
-                                shared_ptr<Field<double> > f1 = shared_ptr<Field<double> >(new Field<double>());
-                                f1->setFieldIdentifier(1002);
-                                f1->setLongFieldName("ReceivedTimeStamp");
-                                f1->setShortFieldName("ReceivedTimeStamp");
-                                f1->setFieldDataType(odcore::data::reflection::AbstractField::DOUBLE_T);
-                                const double v = c.getReceivedTimeStamp().getSeconds() + c.getReceivedTimeStamp().getMicroseconds()/(1000.0*1000.0);
-                                f1->setValue(v);
-                                f1->setSize(sizeof(double));
-                                msg.insertField(f1);
-                            }
-                            {
-                                shared_ptr<Field<double> > f2 = shared_ptr<Field<double> >(new Field<double>());
-                                f2->setFieldIdentifier(1001);
-                                f2->setLongFieldName("SentTimeStamp");
-                                f2->setShortFieldName("SentTimeStamp");
-                                f2->setFieldDataType(odcore::data::reflection::AbstractField::DOUBLE_T);
-                                const double v = c.getSentTimeStamp().getSeconds() + c.getSentTimeStamp().getMicroseconds()/(1000.0*1000.0);
-                                f2->setValue(v);
-                                f2->setSize(sizeof(double));
-                                msg.insertField(f2);
-                            }
-                            {
-                                shared_ptr<Field<double> > f3 = shared_ptr<Field<double> >(new Field<double>());
-                                f3->setFieldIdentifier(1003);
-                                f3->setLongFieldName("SampleTimeStamp");
-                                f3->setShortFieldName("SampleTimeStamp");
-                                f3->setFieldDataType(odcore::data::reflection::AbstractField::DOUBLE_T);
-                                const double v = c.getSampleTimeStamp().getSeconds() + c.getSampleTimeStamp().getMicroseconds()/(1000.0*1000.0);
-                                f3->setValue(v);
-                                f3->setSize(sizeof(double));
-                                msg.insertField(f3);
-                            }
-
-                            mappedContainers++;
-
-                            stringstream sstrKey;
-                            sstrKey << c.getDataType() << "/" << c.getSenderStamp();
-                            const string KEY = sstrKey.str();
-
-                            stringstream sstrCSVData;
-                            const bool ADD_HEADER = (mapOfEntries.count(KEY) == 0);
-                            const char DELIMITER = ';';
-                            CSVFromVisitableVisitor csv(sstrCSVData, ADD_HEADER, DELIMITER);
-                            msg.accept(csv);
-
-                            stringstream sstrFilename;
-                            sstrFilename << msg.getLongName() << "-" << c.getSenderStamp();
-                            const string _FILENAME = sstrFilename.str();
-
-                            mapOfFilenames[KEY] = _FILENAME;
-                            mapOfEntries[KEY] +=  sstrCSVData.str();
-                            mapOfEntrySizes[KEY] = mapOfEntries[KEY].size();
-                        }
-
-                    }
+
+            uint32_t numberOfWorkers = std::thread::hardware_concurrency();
+            uint32_t regionSize = CSVExporter::DEFAULT_REGION_SIZE;
+            uint32_t numberOfCachedRegions = CSVExporter::DEFAULT_NUMBER_OF_CACHED_REGIONS;
+            string exportDirectory;
+            string columnarFilename;
+
+            // Remove .rec filename and odrec2fuse's options from list of args before calling FUSE.
+            vector<string> args;
+            for (int32_t i = 0; i < argc; i++) {
+                const string ARG(argv[i]);
+                if (i == 1) {
+                    continue;
+                }
+                else if (ARG.find("--workers=") == 0) {
+                    stringstream sstr(ARG.substr(string("--workers=").size()));
+                    sstr >> numberOfWorkers;
+                }
+                else if (ARG.find("--regionsize=") == 0) {
+                    stringstream sstr(ARG.substr(string("--regionsize=").size()));
+                    sstr >> regionSize;
+                }
+                else if (ARG.find("--cachedregions=") == 0) {
+                    stringstream sstr(ARG.substr(string("--cachedregions=").size()));
+                    sstr >> numberOfCachedRegions;
+                }
+                else if (ARG.find("--export=") == 0) {
+                    exportDirectory = ARG.substr(string("--export=").size());
+                }
+                else if (ARG.find("--columnar=") == 0) {
+                    columnarFilename = ARG.substr(string("--columnar=").size());
+                }
+                else {
+                    args.push_back(ARG);
                 }
             }
 
-            cout << "[Rec2Fuse] Mapped " << mappedContainers << " containers in total into " << mapOfEntries.size() << " files." << endl;
+            ::csvExporter = shared_ptr<CSVExporter>(new CSVExporter(FILENAME, m_messageResolver.get(), numberOfWorkers, regionSize, numberOfCachedRegions));
+
+            if (exportDirectory.size() > 0) {
+                const bool EXPORTED = ::csvExporter->exportToDirectory(exportDirectory);
+                cout << "[Rec2Fuse] Exported " << ::csvExporter->getNumberOfMappedContainers() << " containers in total to " << exportDirectory << "." << endl;
+                return (EXPORTED ? 0 : 1);
+            }
+
+            if (columnarFilename.size() > 0) {
+                const bool EXPORTED = ::csvExporter->exportToColumnarFile(columnarFilename);
+                cout << "[Rec2Fuse] Exported " << ::csvExporter->getNumberOfMappedContainers() << " containers in total to " << columnarFilename << "." << endl;
+                return (EXPORTED ? 0 : 1);
+            }
+
+            if (!::csvExporter->index()) {
+                cerr << "[Rec2Fuse] Could not open " << FILENAME << "." << endl;
+                return -1;
+            }
+
+            cout << "[Rec2Fuse] Mapped " << ::csvExporter->getNumberOfMappedContainers() << " containers in total into " << ::csvExporter->getFilenames().size() << " files." << endl;
 
             rec2fuse_operations.getattr = getattr_callback;
             rec2fuse_operations.open = open_callback;
             rec2fuse_operations.read = read_callback;
             rec2fuse_operations.readdir = readdir_callback;
 
-            // Remove .rec filename from list of args before calling FUSE.
-            vector<string> args;
-            for (int32_t i = 0; i < argc; i++) {
-                if (i != 1) {
-                    args.push_back(string(argv[i]));
-                }
-            }
-
             char **argv2 = new char*[args.size()];
             for (uint32_t i = 0; i < args.size(); i++) {
                 argv2[i] = const_cast<char*>(args[i].c_str());
             }
 
-            return fuse_main(argc-1, argv2, &rec2fuse_operations, NULL);
+            return fuse_main(args.size(), argv2, &rec2fuse_operations, NULL);
         }
 
         return -1;
@@ -20,13 +20,28 @@
 #ifndef REC2FUSETESTSUITE_H_
 #define REC2FUSETESTSUITE_H_
 
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include "cxxtest/TestSuite.h"
 
+#include <opendavinci/odcore/data/Container.h>
+#include <opendavinci/odcore/data/TimeStamp.h>
+#include <opendavinci/generated/odcore/data/TimePoint.h>
+#include <opendavinci/odtools/columnar/ColumnarFormat.h>
+#include <opendavinci/odtools/columnar/ColumnarReader.h>
+
 // Include local header files.
+#include "../include/CSVExporter.h"
 #include "../include/Rec2Fuse.h"
 
 using namespace std;
 using namespace odrec2fuse;
+using namespace odcore::data;
+using namespace odtools::columnar;
 
 /**
  * The actual testsuite starts here.
@@ -60,6 +75,130 @@ class Rec2FuseTest : public CxxTest::TestSuite {
             TS_ASSERT(dt != NULL);
         }
 
+        string readCompletely(CSVExporter &exporter, const string &filename, const uint32_t &bufferSize) {
+            string content;
+            vector<char> buffer(bufferSize);
+            int64_t bytesRead = 0;
+            while ((bytesRead = exporter.read(filename, &buffer[0], bufferSize, content.size())) > 0) {
+                content += string(&buffer[0], bytesRead);
+            }
+            return content;
+        }
+
+        void testCSVExporterWithRegionsMatchesSingleRegion() {
+            const string FILENAME = "Rec2FuseTestSuite.rec";
+            {
+                fstream fout(FILENAME.c_str(), ios::out | ios::binary | ios::trunc);
+                for (int32_t i = 0; i < 500; i++) {
+                    TimePoint tp(i, i * 1000);
+                    Container c(tp);
+                    c.setSenderStamp(i % 2);
+                    fout << c;
+                }
+            }
+
+            // Regions of a few containers each and a cache smaller than the number of regions.
+            CSVExporter small(FILENAME, NULL, 3, 512, 2);
+            TS_ASSERT(small.index());
+            TS_ASSERT_EQUALS(small.getNumberOfMappedContainers(), 500u);
+
+            CSVExporter single(FILENAME, NULL, 1, 1024 * 1024 * 1024, 1);
+            TS_ASSERT(single.index());
+
+            const vector<string> FILENAMES = small.getFilenames();
+            TS_ASSERT_EQUALS(FILENAMES.size(), 2u);
+            TS_ASSERT_EQUALS(single.getFilenames().size(), 2u);
+
+            for (auto filename : FILENAMES) {
+                // Only the header is laid out before the rows are read.
+                uint64_t headerSize = 0;
+                TS_ASSERT(small.getSize(filename, headerSize));
+                char row[10];
+                TS_ASSERT_EQUALS(small.read(filename, row, sizeof(row), headerSize), 10);
+                uint64_t laidOutSize = 0;
+                TS_ASSERT(small.getSize(filename, laidOutSize));
+                TS_ASSERT(laidOutSize > headerSize);
+
+                // Read with a buffer size that does not align with the chunks.
+                const string CONTENT = readCompletely(small, filename, 37);
+                uint64_t size = 0;
+                TS_ASSERT(small.getSize(filename, size));
+                TS_ASSERT_EQUALS(CONTENT.size(), size);
+                TS_ASSERT(laidOutSize < size);
+                TS_ASSERT_EQUALS(CONTENT, readCompletely(single, filename, 4096));
+
+                // Header plus one line per container.
+                uint32_t lines = 0;
+                for (auto c : CONTENT) {
+                    lines += ('\n' == c) ? 1 : 0;
+                }
+                TS_ASSERT_EQUALS(lines, 251u);
+            }
+
+            uint64_t size = 0;
+            char buffer[10];
+            TS_ASSERT(!small.getSize("Unknown.csv", size));
+            TS_ASSERT_EQUALS(small.read("Unknown.csv", buffer, sizeof(buffer), 0), -1);
+
+            // Export to disk yields the same content.
+            TS_ASSERT(small.exportToDirectory("."));
+            for (auto filename : FILENAMES) {
+                fstream fin(filename.c_str(), ios::in | ios::binary);
+                stringstream sstr;
+                sstr << fin.rdbuf();
+                TS_ASSERT_EQUALS(sstr.str(), readCompletely(single, filename, 4096));
+                UNLINK(filename.c_str());
+            }
+
+            UNLINK(FILENAME.c_str());
+        }
+
+        void testColumnarExportHasOneSetOfTimeStamps() {
+            const string FILENAME = "Rec2FuseTestSuiteColumnar.rec";
+            const string COLUMNAR_FILENAME = "Rec2FuseTestSuiteColumnar.rec.col";
+            {
+                fstream fout(FILENAME.c_str(), ios::out | ios::binary | ios::trunc);
+                for (int32_t i = 0; i < 100; i++) {
+                    TimePoint tp(i, i * 1000);
+                    Container c(tp);
+                    c.setSampleTimeStamp(TimeStamp(i, 0));
+                    fout << c;
+                }
+            }
+
+            CSVExporter exporter(FILENAME, NULL, 2, 512, 2);
+            TS_ASSERT(exporter.exportToColumnarFile(COLUMNAR_FILENAME));
+            TS_ASSERT_EQUALS(exporter.getNumberOfMappedContainers(), 100u);
+
+            ColumnarReader reader(COLUMNAR_FILENAME);
+            TS_ASSERT(reader.isValid());
+            TS_ASSERT_EQUALS(reader.getTables().size(), 1u);
+
+            // The Container's integer time stamps followed by the message's fields only.
+            const Table &T = reader.getTables()[0];
+            TS_ASSERT_EQUALS(T.m_numberOfRows, 100u);
+            TS_ASSERT_EQUALS(T.m_columns.size(), 5u);
+            const string NAMES[] = { ColumnarFormat::SENT_TIMESTAMP, ColumnarFormat::RECEIVED_TIMESTAMP, ColumnarFormat::SAMPLE_TIMESTAMP };
+            for (uint32_t i = 0; i < 3; i++) {
+                TS_ASSERT_EQUALS(T.m_columns[i].m_name, NAMES[i]);
+                TS_ASSERT_EQUALS(T.m_columns[i].m_type, ColumnarFormat::INTEGER);
+            }
+            TS_ASSERT_EQUALS(T.findColumn("seconds"), 3);
+            TS_ASSERT_EQUALS(T.findColumn("microseconds"), 4);
+
+            vector<int64_t> timeStamps;
+            vector<double> values;
+            TS_ASSERT(reader.query(T.m_name, 0, "microseconds", 10 * 1000000LL, 19 * 1000000LL, timeStamps, values));
+            TS_ASSERT_EQUALS(values.size(), 10u);
+            for (uint32_t i = 0; i < values.size(); i++) {
+                TS_ASSERT_EQUALS(timeStamps[i], (10 + i) * 1000000LL);
+                TS_ASSERT_DELTA(values[i], (10 + i) * 1000, 1e-9);
+            }
+
+            UNLINK(COLUMNAR_FILENAME.c_str());
+            UNLINK(FILENAME.c_str());
+        }
+
         ////////////////////////////////////////////////////////////////////////////////////
         // Below this line the necessary constructor for initializing the pointer variables,
         // and the forbidden copy constructor and assignment operator are declared.
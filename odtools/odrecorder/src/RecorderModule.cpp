@@ -73,9 +73,15 @@ namespace odrecorder {
         const bool THREADING = true;
         // Dump shared images and shared data?
         const bool DUMP_SHARED_DATA = getKeyValueConfiguration().getValue<uint32_t>("odrecorder.dumpshareddata") == 1;
+        // Size of compressed blocks (0 = store containers uncompressed).
+        bool compressionBlockSizeFound = false;
+        uint32_t compressionBlockSize = getKeyValueConfiguration().getOptionalValue<uint32_t>("odrecorder.compressionblocksize", compressionBlockSizeFound);
+        if (!compressionBlockSizeFound) {
+            compressionBlockSize = 0;
+        }
 
         // Actual "recording" interface.
-        Recorder r(recorderOutputURL, MEMORY_SEGMENT_SIZE, NUMBER_OF_SEGMENTS, THREADING, DUMP_SHARED_DATA);
+        Recorder r(recorderOutputURL, MEMORY_SEGMENT_SIZE, NUMBER_OF_SEGMENTS, THREADING, DUMP_SHARED_DATA, compressionBlockSize);
 
         // Connect recorder's FIFOQueue to record all containers except for shared images/shared data.
         addDataStoreFor(r.getFIFO());
@@ -27,6 +27,7 @@ extern "C" {
     #include <libswscale/swscale.h>
 }
 
+#include <fstream>
 #include <memory>
 #include <string>
 
@@ -109,6 +110,16 @@ namespace odrecorderh264 {
              */
             void stopAndCleanUpEncoding();
 
+            /**
+             * This method writes the given packet to the .h264 file and
+             * records its position in the accompanying .h264.idx file that
+             * is used by odplayerh264 to seek to the nearest keyframe.
+             *
+             * @param packet Encoded packet to be written.
+             * @param frameIdentifier Identifier of the frame contained in the packet.
+             */
+            void writePacket(const AVPacket &packet, const uint32_t &frameIdentifier);
+
         private:
             shared_ptr<odcore::io::tcp::TCPConnection> m_connection;
             odcore::base::Mutex m_hasConnectionMutex;
@@ -129,6 +140,7 @@ namespace odrecorderh264 {
             AVCodecContext *m_encodeContext;
             SwsContext *m_pixelTransformationContext;
             FILE *m_outputFile;
+            ofstream m_indexFile;
             AVFrame *m_frame;
     };
 
@@ -70,6 +70,7 @@ namespace odrecorderh264 {
         m_encodeContext(NULL),
         m_pixelTransformationContext(NULL),
         m_outputFile(NULL),
+        m_indexFile(),
         m_frame(NULL) {
         // Try to connect to odrecorderh264 process to exchange Containers to encode.
         try {
@@ -118,14 +119,15 @@ namespace odrecorderh264 {
                 break;
             }
             if (succeeded) {
-                cout << "[odrecorderh264] Delayed writing frame " << m_frameCounter++ << ", size = " << packet.size << endl;
-                fwrite(packet.data, 1, packet.size, m_outputFile);
+                cout << "[odrecorderh264] Delayed writing frame " << m_frameCounter << ", size = " << packet.size << endl;
+                writePacket(packet, m_frameCounter);
                 av_free_packet(&packet);
             }
         }
 
-        // Close file.
+        // Close files.
         fclose(m_outputFile);
+        m_indexFile.close();
 
         // Cleanup.
         avcodec_close(m_encodeContext);
@@ -186,6 +188,12 @@ namespace odrecorderh264 {
             return -4;
         }
 
+        // Setup index file to allow seeking to keyframes during playback.
+        m_indexFile.open((m_filename + ".idx").c_str(), ios::out | ios::trunc);
+        if (!m_indexFile.good()) {
+            cerr << "[odrecorderh264] Could not open " << m_filename << ".idx" << endl;
+        }
+
         // Allocate memory to transfer raw uncompressed image data to encoder.
         m_frame = av_frame_alloc();
         if (!m_frame) {
@@ -212,6 +220,16 @@ namespace odrecorderh264 {
         return 0;
     }
 
+    void RecorderH264Encoder::writePacket(const AVPacket &packet, const uint32_t &frameIdentifier) {
+        const long OFFSET = ftell(m_outputFile);
+        fwrite(packet.data, sizeof(uint8_t), packet.size, m_outputFile);
+
+        // Format: frameIdentifier offset size isKeyFrame
+        if (m_indexFile.good()) {
+            m_indexFile << frameIdentifier << " " << OFFSET << " " << packet.size << " " << (((packet.flags & AV_PKT_FLAG_KEY) != 0) ? 1 : 0) << "\n";
+        }
+    }
+
     Container RecorderH264Encoder::process(Container &c) {
         static bool isInitialized = false;
 
@@ -263,7 +281,7 @@ namespace odrecorderh264 {
                         return retVal;
                     }
                     if (succeeded) {
-                        fwrite(packet.data, sizeof(uint8_t), packet.size, m_outputFile);
+                        writePacket(packet, m_frameCounter);
 
                         odcore::data::image::H264Frame h264Frame;
                         h264Frame.setH264Filename(m_filename);